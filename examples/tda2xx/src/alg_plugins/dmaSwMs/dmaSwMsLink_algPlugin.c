@@ -543,6 +543,13 @@ Void AlgorithmLink_dmaSwMsCreateDmaCh(void * pObj,
     pDmaPrm->srcPitch[1]   = pDmaSwMsObj->dmaFillLineSize;
     pDmaPrm->srcStartX     = 0;
     pDmaPrm->srcStartY     = 0;
+
+    status = Utils_dmaTxListInit(
+                &pDmaSwMsObj->dmaTxList,
+                pDmaSwMsObj->dmaTxDesc,
+                UTILS_ARRAYSIZE(pDmaSwMsObj->dmaTxDesc)
+                );
+    UTILS_assert(status==SYSTEM_LINK_STATUS_SOK);
 }
 
 /**
@@ -677,6 +684,8 @@ Bool AlgorithmLink_dmaSwMsIsInputBufValid(void * pObj,
  *
  * \brief Check and fill output buffer with bank color is required
  *
+ *        Fill is added to the DMA transfer list, it is done when the list
+ *        is submitted
  * \param  pObj                     [IN] Algorithm link object handle
  * \param  pDmaSwMsObj              [IN] DMA SW Mosaic object handle
  * \param  pOutFrameBuffer          [IN] Output frame buffer
@@ -720,10 +729,10 @@ Int32 AlgorithmLink_dmaSwMsDoDmaFill(void * pObj,
         pDmaPrm->width         = pLayoutPrm->outBufWidth;
         pDmaPrm->height        = pLayoutPrm->outBufHeight;
 
-        status = Utils_dmaFill2D(
-                &pDmaSwMsObj->dmaChObj,
+        status = Utils_dmaTxListAdd2D(
+                &pDmaSwMsObj->dmaTxList,
                 &pDmaSwMsObj->dmaFillPrms,
-                1
+                TRUE
                 );
         UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
     }
@@ -736,6 +745,8 @@ Int32 AlgorithmLink_dmaSwMsDoDmaFill(void * pObj,
  *
  * \brief Copy data from input into output based on layout parameters
  *
+ *        Fill and copies of all windows are submitted as one DMA transfer
+ *        list, so there is a single completion wait per output frame
  * \param  pObj                     [IN] Algorithm link object handle
  * \param  pDmaSwMsObj              [IN] DMA SW Mosaic object handle
  * \param  pInFrameCompositeBuffer  [IN] Input composite buffer
@@ -758,6 +769,8 @@ Int32 AlgorithmLink_dmaSwMsDoDmaCopyFill(void * pObj,
     System_LinkChInfo *pInChInfo;
     UInt32 numDmaCopy, winId;
 
+    Utils_dmaTxListReset(&pDmaSwMsObj->dmaTxList);
+
     AlgorithmLink_dmaSwMsDoDmaFill(pObj, pDmaSwMsObj, pOutFrameBuffer);
 
     pLayoutPrm = &pDmaSwMsObj->curLayoutPrm;
@@ -800,17 +813,28 @@ Int32 AlgorithmLink_dmaSwMsDoDmaCopyFill(void * pObj,
         pDmaPrm->srcStartX   = pInChInfo->startX + pWinInfo->inStartX;
         pDmaPrm->srcStartY   = pInChInfo->startY + pWinInfo->inStartY;
 
+        status = Utils_dmaTxListAdd2D(
+                &pDmaSwMsObj->dmaTxList,
+                pDmaPrm,
+                FALSE
+                );
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
         numDmaCopy++;
     }
 
-    if(numDmaCopy)
+    if(pDmaSwMsObj->dmaTxList.numDesc)
     {
-        status = Utils_dmaCopy2D(
+        status = Utils_dmaTxListSubmit(
                 &pDmaSwMsObj->dmaChObj,
-                &pDmaSwMsObj->dmaCopyPrms[0],
-                numDmaCopy
+                &pDmaSwMsObj->dmaTxList,
+                NULL,
+                NULL
                 );
         UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+        status = Utils_dmaTxListWait(&pDmaSwMsObj->dmaChObj);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
     }
 
     return status;
@@ -95,6 +95,13 @@ typedef  struct
     Utils_DmaCopyFill2D dmaFillPrms;
     /**< DMA fill params    */
 
+    Utils_DmaTxList dmaTxList;
+    /**< Fill and copies of one output frame, submitted together */
+
+    Utils_DmaTxDesc dmaTxDesc[(ALGORITHM_LINK_DMA_SW_MS_MAX_WINDOWS+1)
+                                * UTILS_DMA_TXLIST_DESC_PER_2D];
+    /**< Descriptor memory for dmaTxList */
+
     AlgorithmLink_DmaSwMsCreateParams   createArgs;
     /**< Create time arguments */
 
@@ -397,6 +397,7 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
     Bool                         bufDropFlag;
     AlgorithmLink_CopyMode       copyMode;
     System_LinkStatistics      * linkStatsInfo;
+    UInt64                       startTs;
 
 
     pFrameCopyObj = (AlgorithmLink_FrameCopyObj *)
@@ -414,10 +415,14 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
     /*
      * Getting input buffers from previous link
      */
+    startTs = AlgorithmLink_phaseBegin(pObj);
+
     System_getLinksFullBuffers(pFrameCopyObj->inQueParams.prevLinkId,
                                pFrameCopyObj->inQueParams.prevLinkQueId,
                                &inputBufList);
 
+    AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_GET_BUF, startTs);
+
     if(inputBufList.numBuf)
     {
         if(pFrameCopyObj->isFirstFrameRecv==FALSE)
@@ -591,6 +596,8 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
             bufSize[0]  = ((pInputChInfo->height)*(pInputChInfo->pitch[0]));
             bufSize[1]  = ((pInputChInfo->height)*(pInputChInfo->pitch[1]));
 
+            startTs = AlgorithmLink_phaseBegin(pObj);
+
             for(bufCntr = 0; bufCntr < numBuffs; bufCntr++)
             {
                 Cache_inv(pSysVideoFrameBufferInput->bufAddr[bufCntr],
@@ -599,6 +606,8 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
                           TRUE
                          );
             }
+
+            AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_CACHE, startTs);
           }
 
           Alg_FrameCopyProcess(algHandle,
@@ -619,6 +628,9 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
           {
             bufSize[0]  = ((pOutputChInfo->height)*(outPitch[0]));
             bufSize[1]  = ((pOutputChInfo->height)*(outPitch[1]));
+
+            startTs = AlgorithmLink_phaseBegin(pObj);
+
             for(bufCntr = 0; bufCntr < numBuffs; bufCntr++)
             {
               Cache_wb(pSysVideoFrameBufferOutput->bufAddr[bufCntr],
@@ -627,6 +639,8 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
                        TRUE
                       );
             }
+
+            AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_CACHE, startTs);
           }
 
           Utils_updateLatency(&linkStatsInfo->linkLatency,
@@ -653,10 +667,14 @@ Int32 AlgorithmLink_frameCopyProcess(void * pObj)
            * Informing next link that a new data has peen put for its
            * processing
            */
+          startTs = AlgorithmLink_phaseBegin(pObj);
+
           System_sendLinkCmd(pFrameCopyObj->outQueParams.nextLink,
                              SYSTEM_CMD_NEW_DATA,
                              NULL);
 
+          AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_SEND, startTs);
+
           /*
            * Releasing (Free'ing) output buffer, since algorithm does not need
            * it for any future usage.
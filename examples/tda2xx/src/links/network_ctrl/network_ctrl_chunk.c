@@ -0,0 +1,207 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \file network_ctrl_chunk.c
+ *
+ * \brief Helpers for uploads done with "_chunk" commands
+ *
+ *        A handler calls NetworkCtrl_chunkRxStart() to read and validate
+ *        the chunk header. If it returns SOK the handler reads the chunk
+ *        data to its destination, calls NetworkCtrl_chunkRxCheck() and, if
+ *        the chunk is accepted, consumes it. It then calls
+ *        NetworkCtrl_chunkRxAck() to send the response. Query and invalid
+ *        chunks are ACK'ed within NetworkCtrl_chunkRxStart().
+ *
+ *******************************************************************************
+ */
+
+#include "network_ctrl_priv.h"
+
+#define NETWORK_CTRL_CHUNK_SKIP_BUF_SIZE    (256U)
+
+static UInt32 gNetworkCtrl_crcTable[256];
+static Bool   gNetworkCtrl_crcTableInit = FALSE;
+
+static UInt8  gNetworkCtrl_chunkSkipBuf[NETWORK_CTRL_CHUNK_SKIP_BUF_SIZE];
+
+/* CRC-32 (IEEE 802.3), same as computed by the PC tool */
+UInt32 NetworkCtrl_crc32(UInt8 *pData, UInt32 size)
+{
+    UInt32 crc, i, j;
+
+    if(gNetworkCtrl_crcTableInit == FALSE)
+    {
+        for(i=0; i<256U; i++)
+        {
+            crc = i;
+            for(j=0; j<8U; j++)
+            {
+                if(crc & 1U)
+                {
+                    crc = (crc >> 1) ^ 0xEDB88320U;
+                }
+                else
+                {
+                    crc = crc >> 1;
+                }
+            }
+            gNetworkCtrl_crcTable[i] = crc;
+        }
+        gNetworkCtrl_crcTableInit = TRUE;
+    }
+
+    crc = 0xFFFFFFFFU;
+    for(i=0; i<size; i++)
+    {
+        crc = gNetworkCtrl_crcTable[(crc ^ pData[i]) & 0xFFU] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFFU;
+}
+
+/* Read and drop parameters of a chunk which is not accepted */
+Void NetworkCtrl_chunkRxSkip(UInt32 size)
+{
+    UInt32 readSize;
+
+    while(size)
+    {
+        readSize = size;
+        if(readSize > sizeof(gNetworkCtrl_chunkSkipBuf))
+        {
+            readSize = sizeof(gNetworkCtrl_chunkSkipBuf);
+        }
+
+        if(NetworkCtrl_readParams(gNetworkCtrl_chunkSkipBuf, readSize) < 0)
+        {
+            break;
+        }
+
+        size -= readSize;
+    }
+}
+
+Int32 NetworkCtrl_chunkRxStart(NetworkCtrl_ChunkRxObj *pRx,
+                               NetworkCtrl_ChunkHeader *pChunk,
+                               char *cmd,
+                               UInt32 prmSize,
+                               UInt32 maxTotalSize,
+                               UInt32 offsetAlign)
+{
+    UInt32 dataSize;
+    Bool isValid;
+
+    if(prmSize < sizeof(*pChunk))
+    {
+        /* reads the parameters and ACK's with error */
+        NetworkCtrl_cmdHandlerUnsupportedCmd(cmd, prmSize);
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    NetworkCtrl_readParams((UInt8*)pChunk, sizeof(*pChunk));
+
+    dataSize = prmSize - sizeof(*pChunk);
+
+    if(pChunk->flags & NETWORK_CTRL_CHUNK_FLAG_QUERY)
+    {
+        NetworkCtrl_chunkRxSkip(dataSize);
+
+        /* resume only the same transfer */
+        if(pChunk->addr != pRx->addr || pChunk->totalSize != pRx->totalSize)
+        {
+            pRx->addr = pChunk->addr;
+            pRx->totalSize = pChunk->totalSize;
+            pRx->nextOffset = 0;
+        }
+
+        NetworkCtrl_chunkRxAck(pRx, pChunk, SYSTEM_LINK_STATUS_SOK);
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    isValid = TRUE;
+
+    if(pChunk->size != dataSize
+        || pChunk->size == 0
+        || pChunk->size > NETWORK_CTRL_CHUNK_SIZE_MAX
+        || pChunk->totalSize > maxTotalSize
+        || pChunk->size > pChunk->totalSize
+        || pChunk->offset > pChunk->totalSize - pChunk->size
+        || (pChunk->offset % offsetAlign) != 0
+        )
+    {
+        isValid = FALSE;
+    }
+    else
+    if(pChunk->offset == 0)
+    {
+        /* start of a new transfer */
+        pRx->addr = pChunk->addr;
+        pRx->totalSize = pChunk->totalSize;
+        pRx->nextOffset = 0;
+    }
+    else
+    if(pChunk->addr != pRx->addr
+        || pChunk->totalSize != pRx->totalSize
+        || pChunk->offset != pRx->nextOffset)
+    {
+        isValid = FALSE;
+    }
+
+    if(isValid == FALSE)
+    {
+        Vps_printf(" NETWORK_CTRL: %s: Chunk @ %d of %d bytes NOT accepted, expected offset is %d !!!\n",
+            cmd, pChunk->offset, pChunk->size, pRx->nextOffset);
+
+        NetworkCtrl_chunkRxSkip(dataSize);
+        NetworkCtrl_chunkRxAck(pRx, pChunk, SYSTEM_LINK_STATUS_EFAIL);
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 NetworkCtrl_chunkRxCheck(NetworkCtrl_ChunkRxObj *pRx,
+                               NetworkCtrl_ChunkHeader *pChunk,
+                               UInt8 *pData)
+{
+    if(pChunk->flags & NETWORK_CTRL_CHUNK_FLAG_CRC)
+    {
+        if(NetworkCtrl_crc32(pData, pChunk->size) != pChunk->crc)
+        {
+            Vps_printf(" NETWORK_CTRL: Chunk @ %d of %d bytes, CRC mismatch !!!\n",
+                pChunk->offset, pChunk->size);
+
+            return SYSTEM_LINK_STATUS_EFAIL;
+        }
+    }
+
+    pRx->nextOffset = pChunk->offset + pChunk->size;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 NetworkCtrl_chunkRxAck(NetworkCtrl_ChunkRxObj *pRx,
+                             NetworkCtrl_ChunkHeader *pChunk,
+                             Int32 status)
+{
+    pChunk->offset = pRx->nextOffset;
+    pChunk->size = 0;
+
+    return NetworkCtrl_writeChunk(
+                pChunk,
+                NULL,
+                (status == SYSTEM_LINK_STATUS_SOK) ? 0 : (UInt32)-1);
+}
+
+Bool NetworkCtrl_chunkRxIsDone(NetworkCtrl_ChunkRxObj *pRx)
+{
+    return (Bool)(pRx->totalSize != 0 && pRx->nextOffset == pRx->totalSize);
+}
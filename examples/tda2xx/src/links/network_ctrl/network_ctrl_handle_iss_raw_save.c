@@ -17,6 +17,10 @@
 
 #define NETWORKCTRL_ISS_DCC_FILE_SIZE           (100*1024U)
 
+/* State of "_chunk" DCC file uploads */
+static NetworkCtrl_ChunkRxObj gNetworkCtrl_dccSendRx;
+static NetworkCtrl_ChunkRxObj gNetworkCtrl_dccSaveRx;
+
 Void NetworkCtrl_cmdHandlerIssRawSave(char *cmd, UInt32 prmSize)
 {
     IssCaptureLink_GetSaveFrameStatus saveFrameStatus;
@@ -294,6 +298,115 @@ Void NetworkCtrl_cmdHandlerIssSaveDccFile(char *cmd, UInt32 prmSize)
     NetworkCtrl_writeParams(NULL, 0, 0);
 }
 
+/* Chunks are received directly in the DCC buffer of the AEWB algorithm,
+ * the DCC file is parsed or saved once all chunks are received
+ */
+static Void NetworkCtrl_issDccFileChunk(char *cmd, UInt32 prmSize,
+                                        NetworkCtrl_ChunkRxObj *pRx,
+                                        Bool isSave)
+{
+    Int32 status;
+    UInt32 linkId;
+    NetworkCtrl_ChunkHeader chunk;
+    AlgorithmLink_IssAewbDccControlParams dccCtrlPrms;
+
+    status = NetworkCtrl_chunkRxStart(
+                pRx,
+                &chunk,
+                cmd,
+                prmSize,
+                NETWORKCTRL_ISS_DCC_FILE_SIZE,
+                1U);
+    if(status != SYSTEM_LINK_STATUS_SOK)
+    {
+        /* query or chunk not accepted, ACK is already sent */
+        return;
+    }
+
+    linkId = IPU1_0_LINK (SYSTEM_LINK_ID_ALG_0);
+
+    dccCtrlPrms.baseClassControl.controlCmd =
+        ALGORITHM_AEWB_LINK_CMD_GET_DCC_BUF_PARAMS;
+    dccCtrlPrms.baseClassControl.size = sizeof(dccCtrlPrms);
+
+    /* get results */
+    status = System_linkControl(
+        linkId,
+        ALGORITHM_LINK_CMD_CONFIG,
+        &dccCtrlPrms,
+        sizeof(dccCtrlPrms),
+        TRUE);
+    UTILS_assert(0 == status);
+
+    if (NULL == dccCtrlPrms.dccBuf)
+    {
+        Vps_printf(" NETWORK_CTRL: DCC Buffer is NULL");
+
+        NetworkCtrl_chunkRxSkip(chunk.size);
+
+        /* send response */
+        NetworkCtrl_chunkRxAck(pRx, &chunk, SYSTEM_LINK_STATUS_EFAIL);
+
+        return ;
+    }
+
+    /* read chunk data */
+    NetworkCtrl_readParams(dccCtrlPrms.dccBuf + chunk.offset, chunk.size);
+
+    status = NetworkCtrl_chunkRxCheck(
+                pRx,
+                &chunk,
+                dccCtrlPrms.dccBuf + chunk.offset);
+
+    if(status == SYSTEM_LINK_STATUS_SOK && NetworkCtrl_chunkRxIsDone(pRx))
+    {
+        Vps_printf(" NETWORK_CTRL: %s: Received %d B of DCC file\n", cmd, chunk.totalSize);
+
+        dccCtrlPrms.dccBufSize = chunk.totalSize;
+
+        if(isSave)
+        {
+            linkId = SYSTEM_LINK_ID_IPU1_0;
+            System_linkControl(
+                linkId,
+                SYSTEM_LINK_CMD_SAVE_DCC_FILE,
+                &dccCtrlPrms,
+                sizeof(dccCtrlPrms),
+                TRUE
+            );
+        }
+        else
+        {
+            dccCtrlPrms.baseClassControl.controlCmd =
+                ALGORITHM_AEWB_LINK_CMD_PARSE_AND_SET_DCC_PARAMS;
+            dccCtrlPrms.baseClassControl.size = sizeof(dccCtrlPrms);
+            dccCtrlPrms.pIspCfg = NULL;
+            dccCtrlPrms.pSimcopCfg = NULL;
+
+            status = System_linkControl(
+                linkId,
+                ALGORITHM_LINK_CMD_CONFIG,
+                &dccCtrlPrms,
+                sizeof(dccCtrlPrms),
+                TRUE);
+            UTILS_assert(0 == status);
+        }
+    }
+
+    /* send response */
+    NetworkCtrl_chunkRxAck(pRx, &chunk, status);
+}
+
+Void NetworkCtrl_cmdHandlerIssDccSendFileChunk(char *cmd, UInt32 prmSize)
+{
+    NetworkCtrl_issDccFileChunk(cmd, prmSize, &gNetworkCtrl_dccSendRx, FALSE);
+}
+
+Void NetworkCtrl_cmdHandlerIssSaveDccFileChunk(char *cmd, UInt32 prmSize)
+{
+    NetworkCtrl_issDccFileChunk(cmd, prmSize, &gNetworkCtrl_dccSaveRx, TRUE);
+}
+
 Void NetworkCtrl_cmdHandlerIssClearDccQspiMem(char *cmd, UInt32 prmSize)
 {
     UInt32 linkId;
@@ -0,0 +1,187 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#include "network_ctrl_priv.h"
+#include <src/utils_common/include/utils_link_stats_if.h>
+
+/**
+ *******************************************************************************
+ * \brief Max time to wait for each core to copy its load into shared memory.
+ *        Load update interval is 500ms on each core.
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_LOAD_COPY_TIMEOUT_MS   (1000U)
+
+/**
+ *******************************************************************************
+ * \brief Interval at which cores are checked for the load copy ACK
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_LOAD_COPY_POLL_MS      (10U)
+
+/**
+ *******************************************************************************
+ * \brief TRUE for a core whose ACK did not come in time, the ACK is ours
+ *        when it comes later
+ *******************************************************************************
+ */
+static Bool gNetworkCtrl_linkStatsLoadAckLate[SYSTEM_PROC_MAX];
+
+/**
+ *******************************************************************************
+ *
+ * \brief Ask each core to copy its load to shared memory and wait for ACK
+ *
+ *        Command queues of a core are shared with other stats clients like
+ *        the link stats monitor. A core which has a command or ACK of
+ *        another client pending is skipped, its load is not marked valid.
+ *
+ * \param coreFlags [OUT] NETWORK_CTRL_LINK_STATS_CORE_FLAG_* for each core
+ *
+ *******************************************************************************
+ */
+static Void NetworkCtrl_linkStatsRefreshCoreLoad(UInt32 *coreFlags)
+{
+    System_LinkStatsCorePrfObj *pCoreLoadObj;
+    System_LinkStatsCmdObj *pCmdObj, *pAckObj;
+    Bool isIssued[SYSTEM_PROC_MAX];
+    UInt32 procId, cmd, elapsedMs, numPending = 0;
+    Int32 status;
+
+    for(procId=0; procId<SYSTEM_PROC_MAX; procId++)
+    {
+        isIssued[procId] = FALSE;
+
+        if(System_isProcEnabled(procId)==FALSE)
+            continue;
+
+        pCoreLoadObj = Utils_linkStatsGetPrfLoadInst(procId);
+        UTILS_assert(NULL != pCoreLoadObj);
+
+        pCmdObj = &pCoreLoadObj->srcToLinkCmdObj;
+        pAckObj = &pCoreLoadObj->linkToSrcCmdObj;
+
+        /* late ACK of an earlier refresh */
+        if(gNetworkCtrl_linkStatsLoadAckLate[procId]
+            && (pAckObj->rdIdx != pAckObj->wrIdx))
+        {
+            Utils_linkStatsRecvCommand(pAckObj, &cmd);
+            gNetworkCtrl_linkStatsLoadAckLate[procId] = FALSE;
+        }
+
+        if((pCmdObj->rdIdx != pCmdObj->wrIdx)
+            || (pAckObj->rdIdx != pAckObj->wrIdx))
+            continue;
+
+        status = Utils_linkStatsSendCommand(pCmdObj,
+                                            LINK_STATS_CMD_COPY_CORE_LOAD);
+        if(0 == status)
+        {
+            gNetworkCtrl_linkStatsLoadAckLate[procId] = FALSE;
+            isIssued[procId] = TRUE;
+            numPending++;
+        }
+    }
+
+    for(elapsedMs = 0;
+        (numPending > 0U)
+            && (elapsedMs < NETWORK_CTRL_LINK_STATS_LOAD_COPY_TIMEOUT_MS);
+        elapsedMs += NETWORK_CTRL_LINK_STATS_LOAD_COPY_POLL_MS)
+    {
+        Task_sleep(NETWORK_CTRL_LINK_STATS_LOAD_COPY_POLL_MS);
+
+        for(procId=0; procId<SYSTEM_PROC_MAX; procId++)
+        {
+            if(isIssued[procId]==FALSE)
+                continue;
+
+            pCoreLoadObj = Utils_linkStatsGetPrfLoadInst(procId);
+
+            status = Utils_linkStatsRecvCommand(
+                        &pCoreLoadObj->linkToSrcCmdObj, &cmd);
+            if(0 == status)
+            {
+                isIssued[procId] = FALSE;
+                numPending--;
+
+                if(LINK_STATS_CMD_COPY_CORE_LOAD_DONE == cmd)
+                {
+                    coreFlags[procId] |=
+                        NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID;
+                }
+            }
+        }
+    }
+
+    for(procId=0; procId<SYSTEM_PROC_MAX; procId++)
+    {
+        if(isIssued[procId])
+        {
+            gNetworkCtrl_linkStatsLoadAckLate[procId] = TRUE;
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Send binary snapshot of link, load and heap statistics
+ *
+ *        Parameter is a single UInt32, when non-zero the core load is
+ *        refreshed before taking the snapshot, this adds up to
+ *        NETWORK_CTRL_LINK_STATS_LOAD_COPY_TIMEOUT_MS to the response time.
+ *
+ *******************************************************************************
+ */
+Void NetworkCtrl_cmdHandlerLinkStats(char *cmd, UInt32 prmSize)
+{
+    UInt8 *pBuf;
+    UInt32 prm[1], bufSize, snapshotSize;
+    UInt32 coreFlags[SYSTEM_PROC_MAX];
+    Int32 status;
+
+    memset((void*) prm, 0U, sizeof(prm));
+    memset((void*) coreFlags, 0U, sizeof(coreFlags));
+
+    if(prmSize == sizeof(prm))
+    {
+        /* read parameters */
+        NetworkCtrl_readParams((UInt8*)prm, sizeof(prm));
+
+        if(prm[0])
+        {
+            NetworkCtrl_linkStatsRefreshCoreLoad(coreFlags);
+        }
+
+        bufSize = Utils_linkStatsCollectorGetSnapshotMaxSize();
+
+        pBuf = Utils_memAlloc( UTILS_HEAPID_DDR_CACHED_SR, bufSize, 32);
+        UTILS_assert(pBuf != NULL);
+
+        snapshotSize = Utils_linkStatsCollectorGetSnapshot(
+                            pBuf, bufSize, coreFlags);
+
+        if(snapshotSize)
+        {
+            /* send response */
+            NetworkCtrl_writeParams(pBuf, snapshotSize, 0);
+        }
+        else
+        {
+            NetworkCtrl_writeParams(NULL, 0, (UInt32)-1);
+        }
+
+        status = Utils_memFree( UTILS_HEAPID_DDR_CACHED_SR, pBuf, bufSize);
+        UTILS_assert(status==0);
+    }
+    else
+    {
+        Vps_printf(" NETWORK_CTRL: %s: Insufficient parameters (%d bytes) specified !!!\n", cmd, prmSize);
+    }
+}
@@ -39,3 +39,47 @@ Void NetworkCtrl_cmdHandlerMemSave(char *cmd, UInt32 prmSize)
         Vps_printf(" NETWORK_CTRL: %s: Insufficient parameters (%d bytes) specified !!!\n", cmd, prmSize);
     }
 }
+
+Void NetworkCtrl_cmdHandlerMemSaveChunk(char *cmd, UInt32 prmSize)
+{
+    NetworkCtrl_ChunkHeader chunk;
+    UInt32 pAddr;
+
+    if(prmSize == sizeof(chunk))
+    {
+        /* read parameters */
+        NetworkCtrl_readParams((UInt8*)&chunk, sizeof(chunk));
+
+        if(chunk.size > NETWORK_CTRL_CHUNK_SIZE_MAX
+            || chunk.size > chunk.totalSize
+            || chunk.offset > chunk.totalSize - chunk.size)
+        {
+            Vps_printf(" NETWORK_CTRL: %s: Invalid chunk @ %d of %d bytes !!!\n", cmd, chunk.offset, chunk.size);
+
+            chunk.size = 0;
+            NetworkCtrl_writeChunk(&chunk, NULL, (UInt32)-1);
+            return;
+        }
+
+        pAddr = chunk.addr + chunk.offset;
+
+        Cache_inv(
+            (xdc_Ptr)SystemUtils_floor(pAddr, 128),
+            SystemUtils_align(chunk.size+128, 128),
+            Cache_Type_ALLD, TRUE
+            );
+
+        if(chunk.flags & NETWORK_CTRL_CHUNK_FLAG_CRC)
+        {
+            chunk.crc = NetworkCtrl_crc32((UInt8*)pAddr, chunk.size);
+        }
+
+        /* send response, chunk data is sent from memory as it is */
+        NetworkCtrl_writeChunk(&chunk, (UInt8*)pAddr, 0);
+    }
+    else
+    {
+        /* reads the parameters and ACK's with error */
+        NetworkCtrl_cmdHandlerUnsupportedCmd(cmd, prmSize);
+    }
+}
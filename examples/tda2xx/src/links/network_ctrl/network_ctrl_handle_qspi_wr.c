@@ -14,6 +14,13 @@
 
 #define NETWORKCTRL_APP_IMAGE_FILE_SIZE     (32*1024*1024U)
 
+/* State of "qspi_wr_chunk" upload, chunk buffer is allocated on first chunk
+ * and kept till the upload is complete so that an interrupted upload can be
+ * resumed
+ */
+static NetworkCtrl_ChunkRxObj gNetworkCtrl_qspiRx;
+static UInt8 *gNetworkCtrl_qspiChunkBuf = NULL;
+
 
 Void NetworkCtrl_cmdHandlerQspiWrite(char *cmd, UInt32 prmSize)
 {
@@ -61,3 +68,76 @@ Void NetworkCtrl_cmdHandlerQspiWrite(char *cmd, UInt32 prmSize)
     UTILS_assert(status==0);
 
 }
+
+/* Each chunk is flashed as it is received, so only one chunk is buffered.
+ * Chunks start at a flash block boundary, the last chunk is padded to a
+ * block with 0xFF
+ */
+Void NetworkCtrl_cmdHandlerQspiWriteChunk(char *cmd, UInt32 prmSize)
+{
+    Int32 status;
+    NetworkCtrl_ChunkHeader chunk;
+    UInt32 alignedSize;
+
+    status = NetworkCtrl_chunkRxStart(
+                &gNetworkCtrl_qspiRx,
+                &chunk,
+                cmd,
+                prmSize,
+                NETWORKCTRL_APP_IMAGE_FILE_SIZE,
+                SYSTEM_QSPI_FLASH_BLOCK_SIZE);
+    if(status != SYSTEM_LINK_STATUS_SOK)
+    {
+        /* query or chunk not accepted, ACK is already sent */
+        return;
+    }
+
+    if(gNetworkCtrl_qspiChunkBuf == NULL)
+    {
+        gNetworkCtrl_qspiChunkBuf = Utils_memAlloc(
+                UTILS_HEAPID_DDR_CACHED_SR,
+                NETWORK_CTRL_CHUNK_SIZE_MAX,
+                8);
+        UTILS_assert(gNetworkCtrl_qspiChunkBuf != NULL);
+    }
+
+    /* read chunk data */
+    NetworkCtrl_readParams(gNetworkCtrl_qspiChunkBuf, chunk.size);
+
+    status = NetworkCtrl_chunkRxCheck(
+                &gNetworkCtrl_qspiRx,
+                &chunk,
+                gNetworkCtrl_qspiChunkBuf);
+
+    if(status == SYSTEM_LINK_STATUS_SOK)
+    {
+        alignedSize = SystemUtils_align(chunk.size, SYSTEM_QSPI_FLASH_BLOCK_SIZE);
+
+        memset(gNetworkCtrl_qspiChunkBuf + chunk.size, 0xFF, alignedSize - chunk.size);
+
+        Vps_printf(" NETWORK_CTRL: Flashing %d B of %d B to QSPI at offset 0x%08x ...\n",
+            chunk.size, chunk.totalSize, chunk.addr + chunk.offset);
+
+        /* QSPI Init is needed here otherwise erase/write will not happen even though we initialized during start  */
+        System_qspiInit();
+        System_qspiWriteSector(chunk.addr + chunk.offset,
+                               (UInt32)gNetworkCtrl_qspiChunkBuf,
+                               alignedSize);
+
+        if(NetworkCtrl_chunkRxIsDone(&gNetworkCtrl_qspiRx))
+        {
+            Vps_printf(" QSPI Flash Complete !!!\n");
+
+            status = Utils_memFree(
+                        UTILS_HEAPID_DDR_CACHED_SR,
+                        gNetworkCtrl_qspiChunkBuf,
+                        NETWORK_CTRL_CHUNK_SIZE_MAX);
+            UTILS_assert(status==0);
+
+            gNetworkCtrl_qspiChunkBuf = NULL;
+        }
+    }
+
+    /* send response */
+    NetworkCtrl_chunkRxAck(&gNetworkCtrl_qspiRx, &chunk, status);
+}
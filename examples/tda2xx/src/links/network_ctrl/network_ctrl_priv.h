@@ -62,6 +62,26 @@ typedef struct {
 } NetworkCtrl_CmdHandler;
 
 
+/**
+ *******************************************************************************
+ *
+ * \brief State of an upload done with "_chunk" commands, one per command
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    UInt32 addr;
+    /**< Command specific address of the transfer in progress */
+
+    UInt32 totalSize;
+    /**< Size of the transfer in progress */
+
+    UInt32 nextOffset;
+    /**< Data upto this offset is received and checked */
+
+} NetworkCtrl_ChunkRxObj;
+
 /**
  *******************************************************************************
  *
@@ -83,6 +103,9 @@ typedef struct {
     NetworkCtrl_CmdHeader cmdBuf;
     /**< Buffer for recevied command header */
 
+    Bool keepConnection;
+    /**< Client asked to keep the connection open after current command */
+
     Network_SockObj sockObj;
     /**< Networking socket */
 
@@ -94,15 +117,35 @@ typedef struct {
 Int32 NetworkCtrl_init();
 Int32 NetworkCtrl_deInit();
 
+Int32 NetworkCtrl_writeChunk(NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData, UInt32 returnStatus);
+UInt32 NetworkCtrl_crc32(UInt8 *pData, UInt32 size);
+Int32 NetworkCtrl_chunkRxStart(NetworkCtrl_ChunkRxObj *pRx,
+                               NetworkCtrl_ChunkHeader *pChunk,
+                               char *cmd,
+                               UInt32 prmSize,
+                               UInt32 maxTotalSize,
+                               UInt32 offsetAlign);
+Void NetworkCtrl_chunkRxSkip(UInt32 size);
+Int32 NetworkCtrl_chunkRxCheck(NetworkCtrl_ChunkRxObj *pRx,
+                               NetworkCtrl_ChunkHeader *pChunk,
+                               UInt8 *pData);
+Int32 NetworkCtrl_chunkRxAck(NetworkCtrl_ChunkRxObj *pRx,
+                             NetworkCtrl_ChunkHeader *pChunk,
+                             Int32 status);
+Bool NetworkCtrl_chunkRxIsDone(NetworkCtrl_ChunkRxObj *pRx);
+
 Void NetworkCtrl_cmdHandlerUnsupportedCmd(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerEcho(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerMemRd(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerMemWr(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerMemSave(char *cmd, UInt32 prmSize);
+Void NetworkCtrl_cmdHandlerMemSaveChunk(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerIssRawSave(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerIssYuvSave(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerIssDccSendFile(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerIssSaveDccFile(char *cmd, UInt32 prmSize);
+Void NetworkCtrl_cmdHandlerIssDccSendFileChunk(char *cmd, UInt32 prmSize);
+Void NetworkCtrl_cmdHandlerIssSaveDccFileChunk(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerIssClearDccQspiMem(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandleIssWriteSensorReg(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandleIssReadSensorReg(char *cmd, UInt32 prmSize);
@@ -113,7 +156,9 @@ Void NetworkCtrl_cmdHandlerStereoWriteCalibLUTToQSPI(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerStereoSetParams(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerStereoSetDynamicParams(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerQspiWrite(char *cmd, UInt32 prmSize);
+Void NetworkCtrl_cmdHandlerQspiWriteChunk(char *cmd, UInt32 prmSize);
 Void NetworkCtrl_cmdHandlerSysReset(char *cmd, UInt32 prmSize);
+Void NetworkCtrl_cmdHandlerLinkStats(char *cmd, UInt32 prmSize);
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
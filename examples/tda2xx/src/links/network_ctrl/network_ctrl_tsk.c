@@ -153,7 +153,7 @@ Int32 NetworkCtrl_readParams(UInt8 *pPrm, UInt32 prmSize)
     return status;
 }
 
-Int32 NetworkCtrl_writeParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
+static Int32 NetworkCtrl_writeAck(UInt32 prmSize, UInt32 returnStatus)
 {
     NetworkCtrl_Obj *pObj = &gNetworkCtrl_obj;
     Int32 status;
@@ -161,6 +161,10 @@ Int32 NetworkCtrl_writeParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
     pObj->cmdBuf.prmSize = prmSize;
     pObj->cmdBuf.returnValue = returnStatus;
     pObj->cmdBuf.flags = NETWORK_CTRL_FLAG_ACK;
+    if(pObj->keepConnection)
+    {
+        pObj->cmdBuf.flags |= NETWORK_CTRL_FLAG_KEEP_CONNECTION;
+    }
 
     status = Network_write(&pObj->sockObj, (UInt8*)&pObj->cmdBuf, sizeof(pObj->cmdBuf));
 
@@ -169,7 +173,19 @@ Int32 NetworkCtrl_writeParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
         Vps_printf(
             " NETWORK_CTRL: Network_write() failed to write response header (port=%d) !!!\n",
                 pObj->serverPort);
+    }
+
+    return status;
+}
+
+Int32 NetworkCtrl_writeParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
+{
+    NetworkCtrl_Obj *pObj = &gNetworkCtrl_obj;
+    Int32 status;
 
+    status = NetworkCtrl_writeAck(prmSize, returnStatus);
+    if(status<0)
+    {
         return status;
     }
 
@@ -188,11 +204,50 @@ Int32 NetworkCtrl_writeParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
     return status;
 }
 
+/* ACK with chunk header and, if pData is not NULL, pChunk->size bytes of
+ * chunk data as response parameters
+ */
+Int32 NetworkCtrl_writeChunk(NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData, UInt32 returnStatus)
+{
+    NetworkCtrl_Obj *pObj = &gNetworkCtrl_obj;
+    Int32 status;
+    UInt32 dataSize;
+
+    dataSize = 0;
+    if(pData)
+    {
+        dataSize = pChunk->size;
+    }
+
+    status = NetworkCtrl_writeAck(sizeof(*pChunk) + dataSize, returnStatus);
+    if(status<0)
+    {
+        return status;
+    }
+
+    status = Network_write(&pObj->sockObj, (UInt8*)pChunk, sizeof(*pChunk));
+
+    if(status==0 && dataSize)
+    {
+        status = Network_write(&pObj->sockObj, pData, dataSize);
+    }
+
+    if(status<0)
+    {
+        Vps_printf(
+            " NETWORK_CTRL: Network_write() failed to write chunk (port=%d) !!!\n",
+                pObj->serverPort);
+    }
+
+    return status;
+}
+
 Void NetworkCtrl_tskMain(UArg arg0, UArg arg1)
 {
     NetworkCtrl_Obj *pObj = (NetworkCtrl_Obj*)arg0;
     Int32 status;
     volatile UInt32 dataSize;
+    Bool isFirstCmd;
 
     Task_sleep(5*1000);
 
@@ -219,73 +274,99 @@ Void NetworkCtrl_tskMain(UArg arg0, UArg arg1)
         if(status==0)
             continue;
 
-        dataSize = sizeof(pObj->cmdBuf);
+        /* serve commands till client closes the connection, or till a
+         * command without NETWORK_CTRL_FLAG_KEEP_CONNECTION is handled
+         */
+        isFirstCmd = TRUE;
+        do
+        {
+            pObj->keepConnection = FALSE;
 
-        /* read command header */
-        status = Network_read(&pObj->sockObj, (UInt8*)&pObj->cmdBuf, (UInt32*)&dataSize);
+            dataSize = sizeof(pObj->cmdBuf);
 
-        if(status==SYSTEM_LINK_STATUS_SOK && dataSize==sizeof(pObj->cmdBuf))
-        {
-            /* handle command */
-            if(pObj->cmdBuf.header != NETWORK_CTRL_HEADER)
-            {
-                Vps_printf(" NETWORK_CTRL: Invalid header received (port=%d) !!!\n", pObj->serverPort);
-            }
-            else
-            {
-                Bool isCmdHandled;
-                int i;
+            /* read command header */
+            status = Network_read(&pObj->sockObj, (UInt8*)&pObj->cmdBuf, (UInt32*)&dataSize);
 
-                isCmdHandled = FALSE;
+            if(status==SYSTEM_LINK_STATUS_SOK && dataSize==sizeof(pObj->cmdBuf))
+            {
+                if(pObj->cmdBuf.flags & NETWORK_CTRL_FLAG_KEEP_CONNECTION)
+                {
+                    pObj->keepConnection = TRUE;
+                }
 
-                /* valid header received */
-                for(i=0; i<NETWORK_CTRL_MAX_CMDS; i++)
+                /* handle command */
+                if(pObj->cmdBuf.header != NETWORK_CTRL_HEADER)
                 {
-                    if(strncmp(
-                        pObj->cmdHandler[i].cmd,
-                        pObj->cmdBuf.cmd,
-                        NETWORK_CTRL_CMD_STRLEN_MAX)
-                        ==0)
-                    {
-                        /* matched a register command */
+                    Vps_printf(" NETWORK_CTRL: Invalid header received (port=%d) !!!\n", pObj->serverPort);
+                    pObj->keepConnection = FALSE;
+                }
+                else
+                {
+                    Bool isCmdHandled;
+                    int i;
 
-                        if(pObj->cmdHandler[i].handler)
+                    isCmdHandled = FALSE;
+
+                    /* valid header received */
+                    for(i=0; i<NETWORK_CTRL_MAX_CMDS; i++)
+                    {
+                        if(strncmp(
+                            pObj->cmdHandler[i].cmd,
+                            pObj->cmdBuf.cmd,
+                            NETWORK_CTRL_CMD_STRLEN_MAX)
+                            ==0)
                         {
-                            Vps_printf(" NETWORK_CTRL: Received command [%s], with %d bytes of parameters\n",
-                                pObj->cmdBuf.cmd,
-                                pObj->cmdBuf.prmSize
-                                );
-
-                            pObj->cmdHandler[i].handler(
-                                pObj->cmdBuf.cmd,
-                                pObj->cmdBuf.prmSize
-                                );
-
-                            Vps_printf(" NETWORK_CTRL: Sent response for command [%s], with %d bytes of parameters\n",
-                                pObj->cmdBuf.cmd,
-                                pObj->cmdBuf.prmSize
-                                );
-
-                            isCmdHandled = TRUE;
-                            break;
+                            /* matched a register command */
+
+                            if(pObj->cmdHandler[i].handler)
+                            {
+                                Vps_printf(" NETWORK_CTRL: Received command [%s], with %d bytes of parameters\n",
+                                    pObj->cmdBuf.cmd,
+                                    pObj->cmdBuf.prmSize
+                                    );
+
+                                pObj->cmdHandler[i].handler(
+                                    pObj->cmdBuf.cmd,
+                                    pObj->cmdBuf.prmSize
+                                    );
+
+                                Vps_printf(" NETWORK_CTRL: Sent response for command [%s], with %d bytes of parameters\n",
+                                    pObj->cmdBuf.cmd,
+                                    pObj->cmdBuf.prmSize
+                                    );
+
+                                isCmdHandled = TRUE;
+                                break;
+                            }
                         }
                     }
-                }
 
-                if(isCmdHandled == FALSE)
+                    if(isCmdHandled == FALSE)
+                    {
+                        /* if command is not handled, then read the params and ACK it with error */
+                        NetworkCtrl_cmdHandlerUnsupportedCmd(
+                            pObj->cmdBuf.cmd,
+                            pObj->cmdBuf.prmSize
+                            );
+                    }
+                }
+            }
+            else
+            {
+                /* client closing the connection after its last command is
+                 * not an error
+                 */
+                if(isFirstCmd)
                 {
-                    /* if command is not handled, then read the params and ACK it with error */
-                    NetworkCtrl_cmdHandlerUnsupportedCmd(
-                        pObj->cmdBuf.cmd,
-                        pObj->cmdBuf.prmSize
-                        );
+                    Vps_printf(" NETWORK_CTRL: recv() failed (port=%d) !!!\n", pObj->serverPort);
                 }
+                pObj->keepConnection = FALSE;
             }
-        }
-        else
-        {
-            Vps_printf(" NETWORK_CTRL: recv() failed (port=%d) !!!\n", pObj->serverPort);
-        }
+
+            isFirstCmd = FALSE;
+
+        } while(pObj->keepConnection && !gNetworkCtrl_obj.tskExit);
+
 
         /* close socket */
         Network_close(&pObj->sockObj, FALSE);
@@ -315,10 +396,13 @@ Int32 NetworkCtrl_init()
     NetworkCtrl_registerHandler("mem_rd", NetworkCtrl_cmdHandlerMemRd);
     NetworkCtrl_registerHandler("mem_wr", NetworkCtrl_cmdHandlerMemWr);
     NetworkCtrl_registerHandler("mem_save", NetworkCtrl_cmdHandlerMemSave);
+    NetworkCtrl_registerHandler("mem_save_chunk", NetworkCtrl_cmdHandlerMemSaveChunk);
     NetworkCtrl_registerHandler("iss_raw_save", NetworkCtrl_cmdHandlerIssRawSave);
     NetworkCtrl_registerHandler("iss_yuv_save", NetworkCtrl_cmdHandlerIssYuvSave);
     NetworkCtrl_registerHandler("iss_send_dcc_file", NetworkCtrl_cmdHandlerIssDccSendFile);
     NetworkCtrl_registerHandler("iss_save_dcc_file", NetworkCtrl_cmdHandlerIssSaveDccFile);
+    NetworkCtrl_registerHandler("iss_send_dcc_file_chunk", NetworkCtrl_cmdHandlerIssDccSendFileChunk);
+    NetworkCtrl_registerHandler("iss_save_dcc_file_chunk", NetworkCtrl_cmdHandlerIssSaveDccFileChunk);
     NetworkCtrl_registerHandler("iss_clear_dcc_qspi_mem", NetworkCtrl_cmdHandlerIssClearDccQspiMem);
     NetworkCtrl_registerHandler("iss_write_sensor_reg", NetworkCtrl_cmdHandleIssWriteSensorReg);
     NetworkCtrl_registerHandler("iss_read_sensor_reg", NetworkCtrl_cmdHandleIssReadSensorReg);
@@ -329,7 +413,9 @@ Int32 NetworkCtrl_init()
     NetworkCtrl_registerHandler("stereo_set_params", NetworkCtrl_cmdHandlerStereoSetParams);
     NetworkCtrl_registerHandler("stereo_set_dynamic_params", NetworkCtrl_cmdHandlerStereoSetDynamicParams);
     NetworkCtrl_registerHandler("qspi_wr", NetworkCtrl_cmdHandlerQspiWrite);
+    NetworkCtrl_registerHandler("qspi_wr_chunk", NetworkCtrl_cmdHandlerQspiWriteChunk);
     NetworkCtrl_registerHandler("sys_reset", NetworkCtrl_cmdHandlerSysReset);
+    NetworkCtrl_registerHandler("link_stats", NetworkCtrl_cmdHandlerLinkStats);
     /*
      * Create task
      */
@@ -483,6 +483,42 @@ Int32 AlgorithmLink_registerPutEmptyBuffersPlugin(void              *pObj,
 */
 UInt32 AlgorithmLink_getLinkId(void *pObj);
 
+/**
+ *******************************************************************************
+ *
+ *   \brief Algorithm link mark start of a phase
+ *
+ *          Plugins call this and AlgorithmLink_phaseEnd() around getting
+ *          input buffers, cache operations and notifying the next link, so
+ *          that this time is reported separately from the algorithm process
+ *          time in the link statistics. Releasing input buffers and putting
+ *          output buffers through the plugin support APIs is accounted by
+ *          the framework.
+ *
+ *          Time is accounted only if the plugin allocated its link
+ *          statistics instance with the link id of the algorithm link.
+ *
+ *   \param pObj               [IN] Current link object
+ *
+ *   \return Value to pass to AlgorithmLink_phaseEnd()
+ *
+ *******************************************************************************
+*/
+UInt64 AlgorithmLink_phaseBegin(void *pObj);
+
+/**
+ *******************************************************************************
+ *
+ *   \brief Algorithm link mark end of a phase
+ *
+ *   \param pObj               [IN] Current link object
+ *   \param phase              [IN] UTILS_LINK_PHASE_*
+ *   \param startTs            [IN] Value returned by AlgorithmLink_phaseBegin()
+ *
+ *******************************************************************************
+*/
+Void AlgorithmLink_phaseEnd(void *pObj, UInt32 phase, UInt64 startTs);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -153,6 +153,29 @@ extern "C" {
 
 /* @} */
 
+/**
+ *******************************************************************************
+ *
+ *   \brief Buffer descriptor modes of IPC IN link
+ *
+ *          IPC_LINK_DESC_MODE_COPY - payload descriptor is copied from the
+ *          IPC shared memory element to a link local System_Buffer
+ *
+ *          IPC_LINK_DESC_MODE_ZERO_COPY - payload of the link local
+ *          System_Buffer points to the payload descriptor in the IPC shared
+ *          memory element, only the element index is exchanged. The element
+ *          is owned by IPC IN until the buffer is released back to IPC OUT.
+ *          Shared memory is non-cached, so next links access the payload
+ *          descriptor without cache operations but at non-cached speed.
+ *
+ *          ZERO_COPY is supported by IPC IN on BIOS cores only, IPC IN on
+ *          Linux always copies since it translates payload addresses
+ *
+ *******************************************************************************
+ */
+#define IPC_LINK_DESC_MODE_COPY                  (0U)
+#define IPC_LINK_DESC_MODE_ZERO_COPY             (1U)
+
 /*******************************************************************************
  *  Enum's
  *******************************************************************************
@@ -201,6 +224,11 @@ typedef struct {
     /**< Output queue information
      */
 
+    UInt32 descMode;
+    /**< How IPC IN passes the buffer descriptor to its next link,
+     *   IPC_LINK_DESC_MODE_xxx. Used by IPC IN link only
+     */
+
 } IpcLink_CreateParams;
 
 /*******************************************************************************
@@ -288,6 +316,7 @@ static inline Void IpcLink_CreateParams_Init(IpcLink_CreateParams *prm)
 
     prm->inQueParams.prevLinkId = SYSTEM_LINK_ID_INVALID;
     prm->outQueParams.nextLink  = SYSTEM_LINK_ID_INVALID;
+    prm->descMode               = IPC_LINK_DESC_MODE_COPY;
 }
 
 #ifdef __cplusplus
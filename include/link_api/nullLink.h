@@ -62,8 +62,107 @@ extern "C" {
 */
 #define NULL_LINK_MAX_IN_QUE        (4)
 
+/**
+ *******************************************************************************
+ *
+ * \brief Max frames which can be queued for DMA in circular dump mode
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_DUMP_MAX_QUE_DEPTH        (8)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Default frames which can be queued for DMA in circular dump mode
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_DUMP_DEFAULT_QUE_DEPTH    (2)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Size of region header and of frame header in circular dump memory.
+ *        Frame data always starts at this alignment.
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_DUMP_HDR_SIZE             (128U)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Magic values of region and frame headers in circular dump memory
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_DUMP_REGION_MAGIC         (0x4E4C5247U)
+#define NULL_LINK_DUMP_FRAME_MAGIC          (0x4E4C4652U)
+
+/**
+ *******************************************************************************
+ *
+ * \brief State of circular dump, as stored in region header
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_DUMP_STATE_ARMED          (0U)
+#define NULL_LINK_DUMP_STATE_TRIGGERED      (1U)
+#define NULL_LINK_DUMP_STATE_FROZEN         (2U)
+
 /* @} */
 
+/*******************************************************************************
+ *  Null Link Commands
+ *******************************************************************************
+*/
+
+/**
+ *******************************************************************************
+ *
+ * \brief Trigger circular dump
+ *
+ *   Valid only when dumpDataType is NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR.
+ *   After the trigger dumpPostTriggerFrames more frames are dumped, then
+ *   dump memory is frozen so that it can be saved, for example from CCS.
+ *
+ *   Command is ignored when dump is already triggered or frozen.
+ *
+ *   \param None
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_CMD_DUMP_TRIGGER          (0x5000)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Re-arm frozen circular dump
+ *
+ *   Dump memory is discarded and frames are dumped again from the start of
+ *   each region, until next trigger.
+ *
+ *   \param None
+ *
+ * SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+*/
+#define NULL_LINK_CMD_DUMP_REARM            (0x5001)
+
 /**
  ******************************************************************************
  * \brief Null link data Copy types.
@@ -83,6 +182,11 @@ typedef enum {
     /**< For dumping bitstream to file. This uses CPU based memcpy */
     NULL_LINK_COPY_TYPE_NETWORK,
     /**< For dumping buffer data, frames/bitstream/meta data over network */
+    NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR,
+    /**< For dumping video frames to memory in a circular manner, each frame
+     *   with a NullLink_DumpFrameHeader, until frozen by
+     *   NULL_LINK_CMD_DUMP_TRIGGER. DMA is done in a separate task so that
+     *   input frames are not delayed by the copy. */
      NULL_LINK_COPY_TYPE_FORCE32BITS = 0x7FFFFFFF
     /**< To make sure enum is 32 bits */
 }NullLink_CopyType;
@@ -94,6 +198,107 @@ typedef enum {
 *******************************************************************************
 */
 
+/**
+ ******************************************************************************
+ * \brief Header at start of each channel region in circular dump memory
+ *
+ *   Newest frame is at lastFrameOffset, older frames are found by following
+ *   prevFrameOffset of each frame header, as long as frame sequence numbers
+ *   decrement by one.
+ *
+ *   All offsets are from start of region.
+ *
+ * SUPPORTED in ALL platforms
+ *
+*******************************************************************************
+*/
+typedef struct
+{
+    UInt32  magic;
+    /**< NULL_LINK_DUMP_REGION_MAGIC */
+
+    UInt32  regionSize;
+    /**< Size of region in bytes, including this header */
+
+    UInt32  inQueId;
+    /**< Input queue ID of channel */
+
+    UInt32  chId;
+    /**< Channel ID */
+
+    UInt32  state;
+    /**< NULL_LINK_DUMP_STATE_xxx, updated at freeze and re-arm */
+
+    UInt32  numFrames;
+    /**< Frames dumped since create or re-arm, including overwritten frames */
+
+    UInt32  wrapCount;
+    /**< Times dump wrapped to start of region */
+
+    UInt32  lastFrameOffset;
+    /**< Offset of newest frame header, 0 when no frame is dumped */
+
+    UInt32  triggerFrameSeq;
+    /**< Sequence number of first frame dumped after trigger,
+     *   valid when state is FROZEN */
+
+    UInt32  triggerTimestampLow;
+    UInt32  triggerTimestampHigh;
+    /**< Global time of trigger in usecs, valid when state is FROZEN */
+
+} NullLink_DumpRegionHeader;
+
+/**
+ ******************************************************************************
+ * \brief Header before each frame in circular dump memory
+ *
+ *   Frame data follows at NULL_LINK_DUMP_HDR_SIZE bytes from start of header.
+ *   magic is cleared before a frame is overwritten and set after its DMA is
+ *   complete, so a header with magic set always has complete frame data.
+ *
+ * SUPPORTED in ALL platforms
+ *
+*******************************************************************************
+*/
+typedef struct
+{
+    UInt32  magic;
+    /**< NULL_LINK_DUMP_FRAME_MAGIC */
+
+    UInt32  frameSeq;
+    /**< Sequence number of frame in region, starts from 0 */
+
+    UInt32  prevFrameOffset;
+    /**< Offset of previous frame header from start of region,
+     *   0 for first frame */
+
+    UInt32  frameSize;
+    /**< Size of frame in bytes, including this header */
+
+    UInt32  timestampLow;
+    UInt32  timestampHigh;
+    /**< Source timestamp of frame in usecs */
+
+    UInt32  chId;
+    /**< Channel ID */
+
+    UInt32  dataFormat;
+    /**< Data format, SYSTEM_DF_xxx */
+
+    UInt32  width;
+    /**< Width of frame in pixels */
+
+    UInt32  height;
+    /**< Height of frame in lines */
+
+    UInt32  pitch[2];
+    /**< Pitch of each plane in dump memory, in bytes */
+
+    UInt32  planeOffset[2];
+    /**< Offset of each plane from start of this header */
+
+} NullLink_DumpFrameHeader;
+
 /**
  ******************************************************************************
  * \brief Null link configuration parameters.
@@ -126,13 +331,20 @@ typedef struct
 
     UInt32  dumpFramesMemoryAddr;
     /**< Valid only when dumpDataType is
-     *   COPY_TYPE_2D_MEMORY or COPY_TYPE_BITSTREAM_MEMORY
-     *   Address in memory where the frames should be copied to
+     *   COPY_TYPE_2D_MEMORY, COPY_TYPE_2D_MEMORY_CIRCULAR or
+     *   COPY_TYPE_BITSTREAM_MEMORY
+     *   Address in memory where the frames should be copied to.
+     *   MUST be NULL_LINK_DUMP_HDR_SIZE aligned for
+     *   COPY_TYPE_2D_MEMORY_CIRCULAR
      */
     UInt32  dumpFramesMemorySize;
     /**< Valid only when dumpDataType is
-     *   COPY_TYPE_2D_MEMORY or COPY_TYPE_BITSTREAM_MEMORY
-     *   Size of memory into which the frames will be copied
+     *   COPY_TYPE_2D_MEMORY, COPY_TYPE_2D_MEMORY_CIRCULAR or
+     *   COPY_TYPE_BITSTREAM_MEMORY
+     *   Size of memory into which the frames will be copied.
+     *   For COPY_TYPE_2D_MEMORY_CIRCULAR memory is split equally between
+     *   all channels of all input queues, each part starts with a
+     *   NullLink_DumpRegionHeader
      */
 
     char  nameDataFile[260];
@@ -148,6 +360,28 @@ typedef struct
      *   NULL_LINK_COPY_TYPE_NETWORK
      */
 
+    Bool networkTxCompress;
+    /**< Valid only when dumpDataType is NULL_LINK_COPY_TYPE_NETWORK
+     *   TRUE: YUV420SP and YUV422I frames are sent losslessly compressed,
+     *   as NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED, when that is smaller.
+     *   Needs network_rx which supports it. Costs CPU time on this core,
+     *   use when the network is the bottleneck.
+     */
+
+    UInt32 dumpPostTriggerFrames;
+    /**< Valid only when dumpDataType is COPY_TYPE_2D_MEMORY_CIRCULAR
+     *   Frames dumped after NULL_LINK_CMD_DUMP_TRIGGER, counted over all
+     *   channels, before dump memory is frozen
+     */
+
+    UInt32 dumpQueDepth;
+    /**< Valid only when dumpDataType is COPY_TYPE_2D_MEMORY_CIRCULAR
+     *   Max input frames held while waiting for DMA,
+     *   1..NULL_LINK_DUMP_MAX_QUE_DEPTH. When all are in use further
+     *   frames are returned without dumping and counted as dropped.
+     *   Must be less than the number of buffers of the previous link.
+     */
+
 } NullLink_CreateParams;
 
 /******************************************************************************
@@ -202,6 +436,7 @@ static inline void NullLink_CreateParams_Init(NullLink_CreateParams *pPrm)
 
     pPrm->numInQue = 1;
     pPrm->networkServerPort = NETWORK_TX_SERVER_PORT;
+    pPrm->dumpQueDepth = NULL_LINK_DUMP_DEFAULT_QUE_DEPTH;
     return;
 }
 
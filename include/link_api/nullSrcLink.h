@@ -275,6 +275,14 @@ typedef struct
     NullSrcLink_DataRxMode dataRxMode;
     /**< Recevied data via File or network */
 
+    Bool networkRxDecompress;
+    /**< Valid only when dataRxMode is NULLSRC_LINK_DATA_RX_MODE_NETWORK
+     *   TRUE: YUV420SP and YUV422I frames may be received losslessly
+     *   compressed, as NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED, and are
+     *   decompressed on this core. Use with 'network_tx --compress' when
+     *   the network is the bottleneck.
+     */
+
 } NullSrcLink_CreateParams;
 
 /******************************************************************************
@@ -0,0 +1,170 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file remoteLogBin_if.h
+ *
+ * \brief Binary remote log record format
+ *
+ *        In binary mode a core does not format its logs. Each Vps_printf()
+ *        puts the format string id, time stamp and the raw arguments in a
+ *        ring of fixed size slots, the reader formats them.
+ *
+ *        The format string is copied once into a string table which is
+ *        part of the core's remote log memory, the format string id is the
+ *        offset of the string in this table. Formats with %s, floating point
+ *        or 64-bit arguments, or more than REMOTE_LOG_BIN_MAX_ARGS arguments,
+ *        are formatted by the writer and put as text records.
+ *
+ *        Layout of the remote log memory of a core in binary mode
+ *
+ *        | string table (strTableSize bytes) | ring (numSlots slots) |
+ *
+ *        A record is one or more consecutive slots, slots wrap around at
+ *        the end of the ring. The first word of a record is the header,
+ *        the writer writes the header last, the reader treats a record as
+ *        valid only when the sequence number in the header matches the
+ *        slot index it is reading.
+ *
+ *        This file is common between target, Linux and PC tools, hence it
+ *        should not include any target specific data types and include
+ *        files
+ *
+ *******************************************************************************
+ */
+
+#ifndef _REMOTE_LOG_BIN_IF_H_
+#define _REMOTE_LOG_BIN_IF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ *  Defines
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Value of RemoteLog_BinInfo.binMode when binary mode is enabled
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MODE_MAGIC       (0x524C4F47U)
+
+/**
+ *******************************************************************************
+ * \brief Size of a slot in bytes, a record takes one or more slots
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_SLOT_SIZE        (32U)
+
+/**
+ *******************************************************************************
+ * \brief Number of 32-bit words in a slot
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_SLOT_WORDS       (REMOTE_LOG_BIN_SLOT_SIZE/4U)
+
+/**
+ *******************************************************************************
+ * \brief Words at start of a record before arguments or text
+ *
+ *        word[0] - header
+ *        word[1] - time stamp in usecs, lower 32 bits of global time
+ *        word[2] - format string id (REMOTE_LOG_BIN_TYPE_FMT only)
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_FMT_HDR_WORDS    (3U)
+#define REMOTE_LOG_BIN_TEXT_HDR_WORDS   (2U)
+
+/**
+ *******************************************************************************
+ * \brief Max arguments in a binary record, arguments are 32-bit
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MAX_ARGS         (13U)
+
+/**
+ *******************************************************************************
+ * \brief Max slots in a record, text longer than this is truncated
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MAX_REC_SLOTS    (8U)
+
+/**
+ *******************************************************************************
+ * \brief Record types
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_TYPE_FMT         (1U)
+#define REMOTE_LOG_BIN_TYPE_TEXT        (2U)
+
+/**
+ *******************************************************************************
+ * \brief Record header
+ *
+ *        [31:16] sequence number, lower 16 bits of the index of first slot
+ *        [15:12] record type, REMOTE_LOG_BIN_TYPE_*
+ *        [11: 8] number of slots in record
+ *        [ 7: 0] number of arguments (REMOTE_LOG_BIN_TYPE_FMT only)
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MAKE_HEADER(seq, type, numSlots, numArgs) \
+    ((((unsigned int)(seq) & 0xFFFFU) << 16U) |                  \
+     (((unsigned int)(type) & 0xFU) << 12U) |                    \
+     (((unsigned int)(numSlots) & 0xFU) << 8U) |                 \
+     ((unsigned int)(numArgs) & 0xFFU))
+
+#define REMOTE_LOG_BIN_GET_SEQ(hdr)         (((hdr) >> 16U) & 0xFFFFU)
+#define REMOTE_LOG_BIN_GET_TYPE(hdr)        (((hdr) >> 12U) & 0xFU)
+#define REMOTE_LOG_BIN_GET_NUM_SLOTS(hdr)   (((hdr) >> 8U) & 0xFU)
+#define REMOTE_LOG_BIN_GET_NUM_ARGS(hdr)    ((hdr) & 0xFFU)
+
+/*******************************************************************************
+ *  Data structures
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ *  \brief Binary log state of a core, part of the core's shared memory info
+ *
+ *******************************************************************************
+ */
+typedef struct
+{
+    volatile unsigned int binMode;
+    /**< REMOTE_LOG_BIN_MODE_MAGIC when core logs in binary mode */
+    volatile unsigned int regionOffset;
+    /**< Offset of core's log memory from start of log buffer */
+    volatile unsigned int strTableSize;
+    /**< Size of string table in bytes, ring follows the string table */
+    volatile unsigned int strTableUsed;
+    /**< Bytes used in string table */
+    volatile unsigned int numSlots;
+    /**< Number of slots in ring, power of 2 */
+    volatile unsigned int wrIdx;
+    /**< Slots reserved by writer, free running */
+    volatile unsigned int rdIdx;
+    /**< Slots consumed by reader, free running */
+    volatile unsigned int overflowCount;
+    /**< Records dropped since ring was full */
+} RemoteLog_BinInfo;
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
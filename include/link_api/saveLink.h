@@ -1,37 +1,35 @@
 /*
  *******************************************************************************
- *
- * Copyright (C) 2013 Texas Instruments Incorporated - http://www.ti.com/
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
  * ALL RIGHTS RESERVED
- *
  *******************************************************************************
  */
 
 /**
  *******************************************************************************
- *
  *   \ingroup FRAMEWORK_MODULE_API
- *   \defgroup DUP_LINK_API Dup Link API
- *
- *
- *   Dup link is a connector link. What it all does is takes an input buffer
- *   and duplicate it across 'N' output links. Release buffers to its previous
- *   link only when all 'N' links connected to this link release the duplicated
- *   buffers
- *
+ *   \defgroup SAVE_LINK_API Save Link API
+ *   Save link is a sink link which records its input to files. Input buffers
+ *   are held, not copied, in a bounded ring until a writer task has written
+ *   them, then they are released to the previous link. When the ring is full
+ *   the input buffer is released right away and counted as dropped, so that
+ *   recording never stalls the previous link.
+ *
+ *   For every channel a data file and an index file are written. The data
+ *   file has the frames back to back, without pitch padding, the index file
+ *   has the size of each frame in bytes, one per line. Both files can be
+ *   given as is to the Null Source link for playback.
+ *
+ *   Files are written with stdio, i.e. CCS host file I/O.
  *   @{
  *******************************************************************************
  */
 
 /**
  *******************************************************************************
- *
- * \file dupLink.h
- *
- * \brief Dup link API public header file.
- *
- * \version 0.0 (Jul 2013) : [NN] First version
- *
+ * \file saveLink.h
+ * \brief Save link API public header file.
+ * \version 0.0 (Oct 2015) : First version
  *******************************************************************************
  */
 
@@ -53,15 +51,43 @@ extern "C" {
 
 /**
  *******************************************************************************
- *
- * \brief Max output queues supported by DUP Link
- *
+ * \brief Max channels which can be recorded
+ * SUPPORTED in ALL platforms
+ *******************************************************************************
+*/
+#define SAVE_LINK_MAX_CH                (4)
+
+/**
+ *******************************************************************************
+ * \brief Max input buffers which can be held for writing
+ * SUPPORTED in ALL platforms
+ *******************************************************************************
+*/
+#define SAVE_LINK_MAX_RING_DEPTH        (16)
+
+/**
+ *******************************************************************************
+ * \brief Max size of a file name, including path
+ * SUPPORTED in ALL platforms
+ *******************************************************************************
+*/
+#define SAVE_LINK_MAX_FILE_NAME         (260)
+
+/**
+ *******************************************************************************
+ * \brief Default input buffers held for writing
+ * SUPPORTED in ALL platforms
+ *******************************************************************************
+*/
+#define SAVE_LINK_DEFAULT_RING_DEPTH    (2)
+
+/**
+ *******************************************************************************
+ * \brief Default size of buffer used to gather lines into large writes
  * SUPPORTED in ALL platforms
- *
  *******************************************************************************
 */
-#define SAVE_LINK_MAX_OUT_QUE    (1)
-#define SAVE_LINK_MAX_IN_QUE	(1)
+#define SAVE_LINK_DEFAULT_WRITE_BUF_SIZE    (256*1024)
 
 /* @} */
 
@@ -71,26 +97,31 @@ extern "C" {
 */
 /**
  *******************************************************************************
- * \brief DUP link configuration parameters.
- *
- *
+ * \brief Save link configuration parameters.
  * SUPPORTED in ALL platforms
- *
  *******************************************************************************
 */
-typedef struct //ryuhs74@20151027 -  ؾ Ѵ.
+typedef struct
 {
     System_LinkInQueParams   inQueParams;
     /**< Input queue information */
 
-    //UInt32  numOutQue;
-    /**< Number of output queues */
+    UInt32  ringDepth;
+    /**< Max input buffers held while they are waiting to be written,
+     *   1..SAVE_LINK_MAX_RING_DEPTH. Must be less than the number of
+     *   buffers of the previous link, so that the previous link is never
+     *   left without buffers */
+
+    UInt32  writeBufSize;
+    /**< Size of buffer in bytes used to gather the lines of a plane, which
+     *   is not contiguous in memory, into large file writes */
 
-    //System_LinkOutQueParams   outQueParams[DUP_LINK_MAX_OUT_QUE]; //Save Link Next Link   OutQue ʿ 
-    /**< output queue information */
+    char    nameDataFile[SAVE_LINK_MAX_CH][SAVE_LINK_MAX_FILE_NAME];
+    /**< Data file of each channel, channel is not recorded when file
+     *   name is empty */
 
-    //UInt32  notifyNextLink;
-    /**< TRUE: send command to next link notifying that new data is ready in que */
+    char    nameIndexFile[SAVE_LINK_MAX_CH][SAVE_LINK_MAX_FILE_NAME];
+    /**< Index file of each channel, has size of each frame in bytes */
 
 } SaveLink_CreateParams;
 
@@ -102,8 +133,8 @@ typedef struct //ryuhs74@20151027 - 
 /**
 *******************************************************************************
 *
-* \brief Init function for DUP link. This function does the following for each
-*   DUP link,
+* \brief Init function for save link. This function does the following for each
+*   save link,
 *  - Creates a task for the link
 *  - Registers this link with the system
 *
@@ -115,31 +146,29 @@ Int32 SaveLink_init();
 
 /**
  *******************************************************************************
- *
- * \brief De-init function for DUP link. This function de-registers this link
+ * \brief De-init function for save link. This function de-registers this link
  *  from the system
- *
  * \return  SYSTEM_LINK_STATUS_SOK
- *
  *******************************************************************************
  */
 Int32 SaveLink_deInit();
 
 /**
  *******************************************************************************
- *
- * \brief Dup link set default parameters for create time params
+ * \brief Save link set default parameters for create time params
  *   This function does the following
  *      - memset create params object
- *      - Sets notifyNextLink as TRUE
- * \param  pPrm  [OUT]  DupLink Create time Params
- *
+ *      - Sets default ring depth and write buffer size
+ * \param  pPrm  [OUT]  SaveLink Create time Params
  *******************************************************************************
  */
 static inline void SaveLink_CreateParams_Init(SaveLink_CreateParams *pPrm)
 {
     memset(pPrm, 0, sizeof(*pPrm));
-    memset(&pPrm->inQueParams, 0, sizeof(pPrm->inQueParams));
+
+    pPrm->inQueParams.prevLinkId = SYSTEM_LINK_ID_INVALID;
+    pPrm->ringDepth    = SAVE_LINK_DEFAULT_RING_DEPTH;
+    pPrm->writeBufSize = SAVE_LINK_DEFAULT_WRITE_BUF_SIZE;
     return;
 }
 
@@ -151,4 +180,3 @@ static inline void SaveLink_CreateParams_Init(SaveLink_CreateParams *pPrm)
 
 
 /*@}*/
-
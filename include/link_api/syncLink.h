@@ -74,6 +74,67 @@ extern "C" {
  */
 #define SYNC_LINK_MAX_CHANNELS (8)
 
+/**
+ *******************************************************************************
+ *
+ *   \brief Max depth of the per channel queue in which sync link holds
+ *          buffers till they are matched or dropped
+ *
+ *   SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+ */
+#define SYNC_LINK_LOCAL_QUE_MAX_DEPTH (32)
+
+/**
+ *******************************************************************************
+ *
+ *   \brief Depth of the per channel queue when SyncLink_CreateParams.queDepth
+ *          is 0
+ *
+ *   SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+ */
+#define SYNC_LINK_LOCAL_QUE_DEFAULT_DEPTH (10)
+
+/**
+ *******************************************************************************
+ *
+ *   \brief Policies used by sync link to select the set of buffers which are
+ *          sent out as one composite buffer
+ *
+ *   HEAD_AVERAGE
+ *      Oldest buffer of every channel is compared against the average of
+ *      their timestamps. Buffers outside syncDelta of the average are
+ *      dropped. This is the default and original behaviour.
+ *
+ *   NEAREST_TO_MASTER
+ *      Oldest buffer of the master channel is the reference. From every
+ *      other channel the buffer nearest to it is picked, once the channel
+ *      has a buffer at or after the reference. Reference buffer is dropped
+ *      only when some channel has no buffer within syncDelta of it.
+ *
+ *   LATEST_COMPLETE_SET
+ *      Newest set in which every channel has a buffer within syncDelta is
+ *      sent out, older buffers are dropped. Gives lowest latency at the
+ *      cost of frame rate.
+ *
+ *   PARTIAL_SET
+ *      Same as NEAREST_TO_MASTER, but when a channel has no buffer for the
+ *      reference within partialSetTimeout msecs, or will never have one,
+ *      the set is sent out without it. Missing channels are filled with a
+ *      blank frame.
+ *
+ *   SUPPORTED in ALL platforms
+ *
+ *******************************************************************************
+ */
+#define SYNC_LINK_POLICY_HEAD_AVERAGE           (0U)
+#define SYNC_LINK_POLICY_NEAREST_TO_MASTER      (1U)
+#define SYNC_LINK_POLICY_LATEST_COMPLETE_SET    (2U)
+#define SYNC_LINK_POLICY_PARTIAL_SET            (3U)
+
 /* @} */
 
 /**
@@ -184,6 +245,25 @@ typedef struct
 
     System_LinkOutQueParams   outQueParams;
     /**< output queue information */
+
+    UInt32                    syncPolicy;
+    /**< Policy used to select buffers which are sent out together,
+     *   SYNC_LINK_POLICY_xxx */
+
+    Int32                     masterCh;
+    /**< Reference channel for SYNC_LINK_POLICY_NEAREST_TO_MASTER and
+     *   SYNC_LINK_POLICY_PARTIAL_SET. SYNC_LINK_MASTER_CH_AUTO selects the
+     *   active channel which receives the least buffers */
+
+    UInt32                    queDepth;
+    /**< Max buffers held per channel, 0 selects
+     *   SYNC_LINK_LOCAL_QUE_DEFAULT_DEPTH. Oldest buffer is dropped when a
+     *   buffer is received for a full queue */
+
+    UInt32                    partialSetTimeout;
+    /**< Time in msecs after which a set is sent out with missing channels,
+     *   used with SYNC_LINK_POLICY_PARTIAL_SET only. Should be more than the
+     *   frame interval of the slowest channel */
 } SyncLink_CreateParams;
 
 /**
@@ -260,6 +340,11 @@ static inline void SyncLink_CreateParams_Init(SyncLink_CreateParams *pPrm)
     {
         pPrm->chParams.channelSyncList[chId] = TRUE;
     }
+
+    pPrm->syncPolicy = SYNC_LINK_POLICY_HEAD_AVERAGE;
+    pPrm->masterCh = SYNC_LINK_MASTER_CH_AUTO;
+    pPrm->queDepth = SYNC_LINK_LOCAL_QUE_DEFAULT_DEPTH;
+    pPrm->partialSetTimeout = 100U;
     return;
 }
 
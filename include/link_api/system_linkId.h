@@ -691,8 +691,6 @@ typedef enum
      *   Supported CPUs: ipu1_0, ipu1_1        in TDA3xx
      */
 
-	//SYSTEM_LINT_SAVE_0, //ryuhs74@20151027 - Add Save Link
-
 	//SYSTEM_LINK_CAMMSYS_LUT, //ryuhs74@20151027 - Add CAMMSYS LUT Link
 
     SYSTEM_LINK_COMMON_LINKS_MAX_ID
@@ -848,6 +846,29 @@ typedef  enum
          Present only on A15 */
 } SYSTEM_A15_0_LINK_IDS;
 
+/**
+ *******************************************************************************
+ *
+ *  \brief Links Ids specific to IPU1_1.
+ *
+ *         These are valid Link Ids available in IPU1_1.
+ *         Few of the links create multiple instances with unique
+ *         identifier - like xxx_0, xxx_1
+ *
+ *******************************************************************************
+ */
+typedef  enum
+{
+    SYSTEM_LINK_ID_SAVE_0 =
+                                IPU1_1_LINK(SYSTEM_LINK_COMMON_LINKS_MAX_ID+1),
+    /**< Save Link - records input buffers to file,
+         Present only on IPU1_1 */
+    SYSTEM_LINK_ID_SAVE_1 =
+                                IPU1_1_LINK(SYSTEM_LINK_COMMON_LINKS_MAX_ID+2)
+    /**< Save Link - records input buffers to file,
+         Present only on IPU1_1 */
+} SYSTEM_IPU1_1_LINK_IDS;
+
 
 #ifdef  __cplusplus
 }
@@ -141,6 +141,146 @@ static Int32 RemoteLog_clientGetLine(UInt32 coreId, char * pString,
     return numBytes;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Get next record from binary log ring of a core and format it
+ *
+ *        See remoteLogBin_if.h for record format. Record is consumed only
+ *        after its header is written by the writer.
+ *
+ * \param  coreId    [IN] Id of the core
+ * \param  pString   [OUT] Formatted line
+ * \param  strSize   [OUT] Size of formatted line
+ *
+ * \return  returns 1 if a line was extracted, 0 if ring is empty
+ *
+ *******************************************************************************
+ */
+static Int32 RemoteLog_clientGetBinLine(UInt32 coreId, char * pString,
+                UInt32 *strSize)
+{
+    volatile RemoteLog_BinInfo *pBinInfo =
+                &gRemoteLog_clientObj.pMemInfo[coreId]->binInfo;
+    volatile UInt32 *pRing;
+    volatile char *pStrTable;
+    UInt32 rec[REMOTE_LOG_BIN_MAX_REC_SLOTS * REMOTE_LOG_BIN_SLOT_WORDS];
+    UInt32 rdIdx, numSlots, wordIdx, wordMask, hdr, recSlots, i;
+    UInt32 overflowCount, numArgs, fmtId, maxText;
+    Int32 len;
+    UInt32 *pArgs;
+
+    *pString = 0;
+    *strSize = 0;
+
+    numSlots = pBinInfo->numSlots;
+    if ((numSlots == 0U) || ((numSlots & (numSlots - 1U)) != 0U))
+        return 0;
+
+    pStrTable = (volatile char *)
+        &gRemoteLog_clientObj.pServerLogBuf[pBinInfo->regionOffset];
+    pRing = (volatile UInt32 *)(pStrTable + pBinInfo->strTableSize);
+
+    rdIdx    = pBinInfo->rdIdx;
+    wordIdx  = rdIdx * REMOTE_LOG_BIN_SLOT_WORDS;
+    wordMask = (numSlots * REMOTE_LOG_BIN_SLOT_WORDS) - 1U;
+
+    hdr = pRing[wordIdx & wordMask];
+    if ((REMOTE_LOG_BIN_GET_SEQ(hdr) != (rdIdx & 0xFFFFU)) ||
+        (REMOTE_LOG_BIN_GET_TYPE(hdr) == 0U))
+    {
+        /* records are dropped only when ring is full, report it after
+         * the records which were in the ring */
+        overflowCount = pBinInfo->overflowCount;
+        if (overflowCount < gRemoteLog_clientObj.binOverflowCount[coreId])
+        {
+            /* writer was re-initialized */
+            gRemoteLog_clientObj.binOverflowCount[coreId] = overflowCount;
+        }
+        if (overflowCount != gRemoteLog_clientObj.binOverflowCount[coreId])
+        {
+            snprintf(pString, REMOTE_LOG_LINE_BUF_SIZE,
+                " REMOTE_LOG: %d log records dropped, log buffer full !!!",
+                overflowCount - gRemoteLog_clientObj.binOverflowCount[coreId]);
+            gRemoteLog_clientObj.binOverflowCount[coreId] = overflowCount;
+            *strSize = strlen(pString);
+            return 1;
+        }
+        return 0;
+    }
+
+    /* record must be read after header */
+    __sync_synchronize();
+
+    recSlots = REMOTE_LOG_BIN_GET_NUM_SLOTS(hdr);
+    if ((recSlots == 0U) || (recSlots > REMOTE_LOG_BIN_MAX_REC_SLOTS))
+        recSlots = 1U;
+
+    for (i = 0U; i < (recSlots * REMOTE_LOG_BIN_SLOT_WORDS); i++)
+    {
+        rec[i] = pRing[(wordIdx + i) & wordMask];
+    }
+
+    pBinInfo->rdIdx = rdIdx + recSlots;
+
+    if (REMOTE_LOG_BIN_GET_TYPE(hdr) == REMOTE_LOG_BIN_TYPE_FMT)
+    {
+        len = snprintf(pString, REMOTE_LOG_LINE_BUF_SIZE, "%6d.%06u s: ",
+                (unsigned int)rec[1]/1000000U,
+                (unsigned int)rec[1]%1000000U);
+
+        numArgs = REMOTE_LOG_BIN_GET_NUM_ARGS(hdr);
+        fmtId   = rec[2];
+        pArgs   = &rec[REMOTE_LOG_BIN_FMT_HDR_WORDS];
+
+        if ((numArgs > REMOTE_LOG_BIN_MAX_ARGS) ||
+            ((REMOTE_LOG_BIN_FMT_HDR_WORDS + numArgs) >
+                (recSlots * REMOTE_LOG_BIN_SLOT_WORDS)) ||
+            (fmtId >= pBinInfo->strTableUsed))
+        {
+            snprintf(pString + len, REMOTE_LOG_LINE_BUF_SIZE - len,
+                " REMOTE_LOG: Invalid record (hdr 0x%08x) !!!", hdr);
+        }
+        else
+        {
+            /* unused arguments are ignored by snprintf */
+            for (i = numArgs; i < REMOTE_LOG_BIN_MAX_ARGS; i++)
+            {
+                pArgs[i] = 0U;
+            }
+            snprintf(pString + len, REMOTE_LOG_LINE_BUF_SIZE - len,
+                (const char *)&pStrTable[fmtId],
+                pArgs[0], pArgs[1], pArgs[2], pArgs[3], pArgs[4],
+                pArgs[5], pArgs[6], pArgs[7], pArgs[8], pArgs[9],
+                pArgs[10], pArgs[11], pArgs[12]);
+        }
+    }
+    else
+    {
+        /* text is formatted by writer including time stamp */
+        maxText = (recSlots * REMOTE_LOG_BIN_SLOT_SIZE) -
+                    (REMOTE_LOG_BIN_TEXT_HDR_WORDS * 4U);
+        if (maxText >= REMOTE_LOG_LINE_BUF_SIZE)
+            maxText = REMOTE_LOG_LINE_BUF_SIZE - 1U;
+
+        memcpy(pString, &rec[REMOTE_LOG_BIN_TEXT_HDR_WORDS], maxText);
+        pString[maxText] = 0;
+    }
+
+    /* line end is added when printing */
+    len = strlen(pString);
+    while ((len > 0) &&
+           ((pString[len - 1] == '\n') || (pString[len - 1] == '\r')))
+    {
+        len--;
+    }
+    pString[len] = 0;
+
+    *strSize = len;
+
+    return 1;
+}
+
 /**
  *******************************************************************************
  *
@@ -173,9 +313,19 @@ static void *RemoteLog_clientRun(void *pPrm)
                 sprintf(procName, "[%-6s] ", System_getProcName(coreId));
                 do {
                     strSize = 0;
-                    numBytes = RemoteLog_clientGetLine(coreId,
+                    if(gRemoteLog_clientObj.pMemInfo[coreId]->binInfo.binMode
+                        == REMOTE_LOG_BIN_MODE_MAGIC)
+                    {
+                        numBytes = RemoteLog_clientGetBinLine(coreId,
                             gRemoteLog_clientObj.lineBuf,
                             &strSize );
+                    }
+                    else
+                    {
+                        numBytes = RemoteLog_clientGetLine(coreId,
+                            gRemoteLog_clientObj.lineBuf,
+                            &strSize );
+                    }
                     if(strSize>0)
                     {
                         printf( "%s%s\r\n", procName, gRemoteLog_clientObj.lineBuf);
@@ -93,6 +93,8 @@ typedef struct {
 
     char lineBuf[REMOTE_LOG_LINE_BUF_SIZE];
     /**< Temporary buffer for print on uart from shared buffer */
+    UInt32 binOverflowCount[SYSTEM_PROC_MAX];
+    /**< Binary log overflow count already reported for each core */
 
     OSA_ThrHndl thrHndl;
     /**< Log print thread */
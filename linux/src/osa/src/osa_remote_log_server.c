@@ -94,6 +94,37 @@
     #error "Increase REMOTE_LOG_LOG_BUF_SIZE in file osa_remote_log_if.h"
 #endif
 
+/**
+ *******************************************************************************
+ *
+ * \brief Max different format strings logged in binary mode by a core,
+ *        must be power of 2. Formats beyond this are logged as text.
+ *
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MAX_FMT              (256U)
+
+/**
+ *******************************************************************************
+ *
+ * \brief RemoteLog_BinFmt.numArgs value for a format which is formatted
+ *        by the writer and logged as text
+ *
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_FMT_TEXT             (0xFFFFFFFFU)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Max text record payload in 32-bit words
+ *
+ *******************************************************************************
+ */
+#define REMOTE_LOG_BIN_MAX_TEXT_WORDS       ((REMOTE_LOG_BIN_MAX_REC_SLOTS * \
+                                              REMOTE_LOG_BIN_SLOT_WORDS) - \
+                                              REMOTE_LOG_BIN_TEXT_HDR_WORDS)
+
 
 /*******************************************************************************
  *  Data structures
@@ -110,6 +141,24 @@
  *
  *******************************************************************************
  */
+typedef struct
+{
+    const char *format;
+    /**< Format string address on this core, NULL when entry is free */
+    UInt32 fmtId;
+    /**< Offset of the format string in the shared string table */
+    UInt32 numArgs;
+    /**< Number of 32-bit arguments, REMOTE_LOG_BIN_FMT_TEXT when format
+     *   cannot be logged in binary */
+    UInt32 len;
+    /**< Format string length including '\0' */
+    UInt32 hash;
+    /**< Hash of the format string, see RemoteLog_binFmtHash() */
+    Bool fullCompare;
+    /**< TRUE when another format has the same length and hash, format is
+     *   then also compared with its copy in the string table */
+} RemoteLog_BinFmt;
+
 typedef struct
 {
     unsigned int coreId;
@@ -118,6 +167,18 @@ typedef struct
     /**< local buffer which can hold one line of log */
     OSA_MutexHndl lock;
     /**< Lock used to protect prints from multiple threads */
+    volatile RemoteLog_BinInfo *pBinInfo;
+    /**< Binary log state in shared memory, NULL when binary mode is off */
+    volatile char *pBinStrTable;
+    /**< Format string table in shared memory */
+    volatile UInt32 *pBinRing;
+    /**< Slot ring in shared memory */
+    volatile UInt32 binWrIdx;
+    /**< Slots reserved by writers, updated with atomic compare and swap */
+    volatile UInt32 binOverflowCount;
+    /**< Records dropped, updated atomically and copied to shared memory */
+    RemoteLog_BinFmt binFmt[REMOTE_LOG_BIN_MAX_FMT];
+    /**< Format strings seen by this process, hashed by address */
 } RemoteLog_ServerObj;
 
 /**
@@ -237,6 +298,466 @@ static int RemoteLog_serverPutString(unsigned int coreId, char *pString)
     return 0;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Find number of arguments of a format string
+ *
+ *        Only conversions whose argument is passed as a 32-bit int are
+ *        supported in binary mode.
+ *
+ * \param  format   [IN] Format string
+ *
+ * \return  number of arguments, REMOTE_LOG_BIN_FMT_TEXT if format must be
+ *          logged as text
+ *
+ *******************************************************************************
+ */
+static UInt32 RemoteLog_binParseFormat(const char *format)
+{
+    UInt32 numArgs = 0U;
+    const char *pChar = format;
+
+    while (*pChar != 0)
+    {
+        if (*pChar++ != '%')
+            continue;
+
+        if (*pChar == '%')
+        {
+            pChar++;
+            continue;
+        }
+
+        while ((*pChar == '-') || (*pChar == '+') || (*pChar == ' ') ||
+               (*pChar == '#') || (*pChar == '0'))
+            pChar++;
+
+        if (*pChar == '*')
+        {
+            numArgs++;
+            pChar++;
+        }
+        while ((*pChar >= '0') && (*pChar <= '9'))
+            pChar++;
+
+        if (*pChar == '.')
+        {
+            pChar++;
+            if (*pChar == '*')
+            {
+                numArgs++;
+                pChar++;
+            }
+            while ((*pChar >= '0') && (*pChar <= '9'))
+                pChar++;
+        }
+
+        /* 'h' and 'hh' arguments are promoted to int */
+        while (*pChar == 'h')
+            pChar++;
+
+        switch (*pChar)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c':
+            case 'p':
+                numArgs++;
+                pChar++;
+                break;
+            default:
+                /* %s, floating point, 'l', 'll' are formatted by writer */
+                return REMOTE_LOG_BIN_FMT_TEXT;
+        }
+    }
+
+    if (numArgs > REMOTE_LOG_BIN_MAX_ARGS)
+        return REMOTE_LOG_BIN_FMT_TEXT;
+
+    return numArgs;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Hash and length of a format string, FNV-1a
+ *
+ * \param  format   [IN]  Format string
+ * \param  pLen     [OUT] Length including '\0'
+ *
+ * \return  hash
+ *
+ *******************************************************************************
+ */
+static UInt32 RemoteLog_binFmtHash(const char *format, UInt32 *pLen)
+{
+    UInt32 hash = 2166136261U;
+    UInt32 i = 0U;
+
+    while (format[i] != '\0')
+    {
+        hash = (hash ^ (UInt8)format[i]) * 16777619U;
+        i++;
+    }
+
+    *pLen = i + 1U;
+
+    return hash;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Check if another format has the same length and hash
+ *
+ *        Called once per format, when it is added
+ *
+ * \param  len      [IN] Format string length including '\0'
+ * \param  hash     [IN] Format string hash
+ *
+ * \return  TRUE if found
+ *
+ *******************************************************************************
+ */
+static Bool RemoteLog_binFmtHashIsUsed(UInt32 len, UInt32 hash)
+{
+    RemoteLog_BinFmt *pFmt;
+    UInt32 i;
+
+    for (i = 0U; i < REMOTE_LOG_BIN_MAX_FMT; i++)
+    {
+        pFmt = &gRemoteLog_serverObj.binFmt[i];
+
+        if ((pFmt->format != NULL) &&
+            (pFmt->numArgs != REMOTE_LOG_BIN_FMT_TEXT) &&
+            (pFmt->len == len) && (pFmt->hash == hash))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Check format string is same as when it was added
+ *
+ *        Formats are looked up by address, a caller may pass a buffer which
+ *        is later filled with other text. Such a format is logged as text.
+ *
+ *        Length and hash kept in local memory are compared, so a lookup
+ *        reads only the caller's format. The copy in the string table is in
+ *        non-cached shared memory and is compared only for formats whose
+ *        length and hash are shared with another format.
+ *
+ * \param  pFmt     [IN] Format info with format in string table
+ * \param  format   [IN] Format string
+ *
+ * \return  TRUE if same
+ *
+ *******************************************************************************
+ */
+static Bool RemoteLog_binFmtIsSame(const RemoteLog_BinFmt *pFmt,
+                                   const char *format)
+{
+    volatile char *pStr;
+    UInt32 i = 0U, len, hash;
+
+    hash = RemoteLog_binFmtHash(format, &len);
+    if ((len != pFmt->len) || (hash != pFmt->hash))
+        return FALSE;
+
+    if (pFmt->fullCompare == FALSE)
+        return TRUE;
+
+    pStr = &gRemoteLog_serverObj.pBinStrTable[pFmt->fmtId];
+
+    while (pStr[i] == format[i])
+    {
+        if (format[i] == '\0')
+            return TRUE;
+        i++;
+    }
+
+    return FALSE;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get format string info, add it to the string table on first use
+ *
+ *        Lookup is lock free, insertion is done with the print lock held.
+ *        An entry is visible to lookup only after all its fields are set.
+ *
+ * \param  format   [IN] Format string
+ *
+ * \return  format info, NULL if format cannot be logged in binary or
+ *          is not same as when it was added
+ *
+ *******************************************************************************
+ */
+static RemoteLog_BinFmt *RemoteLog_binGetFmt(const char *format)
+{
+    RemoteLog_ServerObj *pObj = &gRemoteLog_serverObj;
+    volatile RemoteLog_BinInfo *pBinInfo = pObj->pBinInfo;
+    RemoteLog_BinFmt *pFmt = NULL;
+    UInt32 idx, i, len, hash, numArgs;
+
+    idx = ((UInt32)format >> 2U) & (REMOTE_LOG_BIN_MAX_FMT - 1U);
+
+    for (i = 0U; i < REMOTE_LOG_BIN_MAX_FMT; i++)
+    {
+        pFmt = &pObj->binFmt[(idx + i) & (REMOTE_LOG_BIN_MAX_FMT - 1U)];
+
+        if (pFmt->format == format)
+        {
+            if ((pFmt->numArgs != REMOTE_LOG_BIN_FMT_TEXT) &&
+                (RemoteLog_binFmtIsSame(pFmt, format) == FALSE))
+                return NULL;
+            return pFmt;
+        }
+
+        if (pFmt->format == NULL)
+            break;
+    }
+
+    /* first call with this format */
+    numArgs = RemoteLog_binParseFormat(format);
+    hash = RemoteLog_binFmtHash(format, &len);
+
+    OSA_mutexLock(&pObj->lock);
+
+    for (i = 0U; i < REMOTE_LOG_BIN_MAX_FMT; i++)
+    {
+        pFmt = &pObj->binFmt[(idx + i) & (REMOTE_LOG_BIN_MAX_FMT - 1U)];
+
+        /* another thread may have added it after the lookup above */
+        if ((pFmt->format == format) || (pFmt->format == NULL))
+            break;
+    }
+
+    if (i >= REMOTE_LOG_BIN_MAX_FMT)
+    {
+        pFmt = NULL;
+    }
+    else
+    if (pFmt->format == NULL)
+    {
+        if ((numArgs != REMOTE_LOG_BIN_FMT_TEXT) &&
+            ((pBinInfo->strTableUsed + len) <= pBinInfo->strTableSize))
+        {
+            pFmt->len = len;
+            pFmt->hash = hash;
+            pFmt->fullCompare = RemoteLog_binFmtHashIsUsed(len, hash);
+            pFmt->fmtId = pBinInfo->strTableUsed;
+            for (i = 0U; i < len; i++)
+            {
+                pObj->pBinStrTable[pFmt->fmtId + i] = format[i];
+            }
+            pBinInfo->strTableUsed = pFmt->fmtId + len;
+        }
+        else
+        {
+            numArgs = REMOTE_LOG_BIN_FMT_TEXT;
+        }
+        pFmt->numArgs = numArgs;
+        __sync_synchronize();
+        pFmt->format = format;
+    }
+
+    OSA_mutexUnlock(&pObj->lock);
+
+    /* found under lock, added by another thread with the same address */
+    if ((pFmt != NULL) && (pFmt->numArgs != REMOTE_LOG_BIN_FMT_TEXT) &&
+        (RemoteLog_binFmtIsSame(pFmt, format) == FALSE))
+        pFmt = NULL;
+
+    return pFmt;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Put a record into the binary log ring
+ *
+ *        Slots are reserved with an atomic compare and swap on a process
+ *        local index, no lock is taken. Header is written last, the reader
+ *        does not look at a record until its header is written.
+ *
+ * \param  type         [IN] REMOTE_LOG_BIN_TYPE_*
+ * \param  numArgs      [IN] Number of arguments for REMOTE_LOG_BIN_TYPE_FMT
+ * \param  pData        [IN] Record words after the time stamp
+ * \param  numDataWords [IN] Number of words in pData
+ *
+ * \return  returns 0 on success, -1 if ring is full
+ *
+ *******************************************************************************
+ */
+static Int32 RemoteLog_binPut(UInt32 type, UInt32 numArgs,
+                              const UInt32 *pData, UInt32 numDataWords)
+{
+    RemoteLog_ServerObj *pObj = &gRemoteLog_serverObj;
+    volatile RemoteLog_BinInfo *pBinInfo = pObj->pBinInfo;
+    volatile UInt32 *pRing = pObj->pBinRing;
+    UInt32 timeInUsec, numSlots, wrIdx, wordIdx, wordMask, i;
+
+    timeInUsec = (UInt32)OSA_getCurGlobalTimeInUsec();
+
+    numSlots = (REMOTE_LOG_BIN_TEXT_HDR_WORDS + numDataWords +
+                    REMOTE_LOG_BIN_SLOT_WORDS - 1U) / REMOTE_LOG_BIN_SLOT_WORDS;
+    wordMask = (pBinInfo->numSlots * REMOTE_LOG_BIN_SLOT_WORDS) - 1U;
+
+    do {
+        wrIdx = pObj->binWrIdx;
+        if (((wrIdx - pBinInfo->rdIdx) + numSlots) > pBinInfo->numSlots)
+        {
+            pBinInfo->overflowCount =
+                __sync_add_and_fetch(&pObj->binOverflowCount, 1U);
+            return -1;
+        }
+    } while (!__sync_bool_compare_and_swap(&pObj->binWrIdx,
+                    wrIdx, wrIdx + numSlots));
+
+    pBinInfo->wrIdx = wrIdx + numSlots;
+
+    wordIdx = wrIdx * REMOTE_LOG_BIN_SLOT_WORDS;
+
+    pRing[(wordIdx + 1U) & wordMask] = timeInUsec;
+    for (i = 0U; i < numDataWords; i++)
+    {
+        pRing[(wordIdx + REMOTE_LOG_BIN_TEXT_HDR_WORDS + i) & wordMask] =
+            pData[i];
+    }
+
+    /* record must be visible before header */
+    __sync_synchronize();
+
+    pRing[wordIdx & wordMask] =
+        REMOTE_LOG_BIN_MAKE_HEADER(wrIdx, type, numSlots, numArgs);
+
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Put a formatted string into the binary log ring as text record
+ *
+ * \param  pString  [IN] String, truncated if longer than a record
+ *
+ * \return  returns 0 on success
+ *
+ *******************************************************************************
+ */
+static Int32 RemoteLog_binPutText(const char *pString)
+{
+    UInt32 text[REMOTE_LOG_BIN_MAX_TEXT_WORDS];
+    UInt32 len;
+
+    len = strlen(pString);
+    if (len >= sizeof(text))
+        len = sizeof(text) - 1U;
+
+    memcpy(text, pString, len);
+    ((char *)text)[len] = 0;
+
+    return RemoteLog_binPut(REMOTE_LOG_BIN_TYPE_TEXT, 0U, text,
+                            (len + 1U + 3U) / 4U);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Put format string id and arguments into the binary log ring
+ *
+ * \param  pFmt      [IN] Format info
+ * \param  vaArgPtr  [IN] Arguments
+ *
+ * \return  returns 0 on success
+ *
+ *******************************************************************************
+ */
+static Int32 RemoteLog_binPutArgs(RemoteLog_BinFmt *pFmt, va_list vaArgPtr)
+{
+    UInt32 data[1U + REMOTE_LOG_BIN_MAX_ARGS];
+    UInt32 i;
+
+    data[0] = pFmt->fmtId;
+    for (i = 0U; i < pFmt->numArgs; i++)
+    {
+        data[1U + i] = va_arg(vaArgPtr, UInt32);
+    }
+
+    return RemoteLog_binPut(REMOTE_LOG_BIN_TYPE_FMT, pFmt->numArgs,
+                            data, 1U + pFmt->numArgs);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Switch the core's log memory to binary mode
+ *
+ *        A quarter to half of the memory is used as format string table,
+ *        rest is the slot ring whose size is a power of 2.
+ *
+ * \param  coreId   [IN] Id of the core
+ *
+ *******************************************************************************
+ */
+static void RemoteLog_binInit(UInt32 coreId)
+{
+    RemoteLog_ServerObj *pObj = &gRemoteLog_serverObj;
+    volatile RemoteLog_BinInfo *pBinInfo;
+    RemoteLog_ServerIndexInfo *pIdxInfo;
+    UInt32 numSlots, i;
+
+    pIdxInfo = &gRemoteLog_ServerIdxInfo[coreId];
+    pBinInfo = &gRemoteLog_coreObj->memInfo[coreId].binInfo;
+
+    numSlots = 1U;
+    while ((numSlots * 2U * REMOTE_LOG_BIN_SLOT_SIZE) <=
+                ((pIdxInfo->size * 3U) / 4U))
+    {
+        numSlots *= 2U;
+    }
+
+    pBinInfo->binMode       = 0U;
+    pBinInfo->regionOffset  = pIdxInfo->startIdx;
+    pBinInfo->strTableSize  = pIdxInfo->size -
+                                (numSlots * REMOTE_LOG_BIN_SLOT_SIZE);
+    pBinInfo->strTableUsed  = 0U;
+    pBinInfo->numSlots      = numSlots;
+    pBinInfo->wrIdx         = 0U;
+    pBinInfo->rdIdx         = 0U;
+    pBinInfo->overflowCount = 0U;
+
+    memset(pObj->binFmt, 0, sizeof(pObj->binFmt));
+    pObj->binWrIdx         = 0U;
+    pObj->binOverflowCount = 0U;
+    pObj->pBinStrTable = (volatile char *)
+        &gRemoteLog_coreObj->serverLogBuf[pIdxInfo->startIdx];
+    pObj->pBinRing     = (volatile UInt32 *)
+        &gRemoteLog_coreObj->serverLogBuf[pIdxInfo->startIdx +
+                                          pBinInfo->strTableSize];
+
+    /* clear stale headers */
+    for (i = 0U; i < (numSlots * REMOTE_LOG_BIN_SLOT_WORDS); i++)
+    {
+        pObj->pBinRing[i] = 0U;
+    }
+
+    __sync_synchronize();
+
+    pBinInfo->binMode = REMOTE_LOG_BIN_MODE_MAGIC;
+    pObj->pBinInfo = pBinInfo;
+}
+
 /**
  *******************************************************************************
  *
@@ -257,6 +778,20 @@ int Vps_printf(const char *format, ...)
     char *buf = NULL;
     UInt32 strnlen = 0;
     UInt64 timeInUsec;
+    RemoteLog_BinFmt *pFmt;
+
+    if (gRemoteLog_serverObj.pBinInfo != NULL)
+    {
+        pFmt = RemoteLog_binGetFmt(format);
+        if ((pFmt != NULL) && (pFmt->numArgs != REMOTE_LOG_BIN_FMT_TEXT))
+        {
+            va_start(vaArgPtr, format);
+            retVal = RemoteLog_binPutArgs(pFmt, vaArgPtr);
+            va_end(vaArgPtr);
+
+            return (retVal);
+        }
+    }
 
     OSA_mutexLock(&gRemoteLog_serverObj.lock);
 
@@ -274,7 +809,10 @@ int Vps_printf(const char *format, ...)
               format, vaArgPtr);
     va_end(vaArgPtr);
 
-    retVal = RemoteLog_serverPutString(gRemoteLog_serverObj.coreId, buf);
+    if (gRemoteLog_serverObj.pBinInfo != NULL)
+        retVal = RemoteLog_binPutText(buf);
+    else
+        retVal = RemoteLog_serverPutString(gRemoteLog_serverObj.coreId, buf);
 
     OSA_mutexUnlock(&gRemoteLog_serverObj.lock);
 
@@ -314,10 +852,17 @@ int RemoteLog_init()
     pMemInfo->clientIdx = 0;
     pMemInfo->appInitState = CORE_APP_INITSTATUS_PRE_INIT;
     gRemoteLog_serverObj.coreId = coreId;
+    gRemoteLog_serverObj.pBinInfo = NULL;
 
     status = OSA_mutexCreate(&gRemoteLog_serverObj.lock);
     OSA_assertSuccess(status);
 
+#if (REMOTE_LOG_BIN_ENABLE == 1U)
+    RemoteLog_binInit(coreId);
+#else
+    pMemInfo->binInfo.binMode = 0U;
+#endif
+
     return 0;
 }
 
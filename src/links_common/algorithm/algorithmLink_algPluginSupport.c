@@ -262,6 +262,55 @@ UInt32 AlgorithmLink_getLinkId(void *ptr)
     return (pObj->linkId);
 }
 
+/**
+ *******************************************************************************
+ *
+ *   \brief Algorithm link mark start of a phase
+ *
+ *   \param ptr                [IN] Current link object
+ *
+ *   \return Value to pass to AlgorithmLink_phaseEnd()
+ *
+ *******************************************************************************
+*/
+UInt64 AlgorithmLink_phaseBegin(void *ptr)
+{
+    AlgorithmLink_Obj *pObj;
+    UInt64 startTs = 0;
+
+    pObj = (AlgorithmLink_Obj *)ptr;
+
+    if(pObj->pPhaseStatsInfo != NULL)
+    {
+        startTs = Utils_linkPhaseBegin(&pObj->pPhaseStatsInfo->phaseStats);
+    }
+
+    return startTs;
+}
+
+/**
+ *******************************************************************************
+ *
+ *   \brief Algorithm link mark end of a phase
+ *
+ *   \param ptr                [IN] Current link object
+ *   \param phase              [IN] UTILS_LINK_PHASE_*
+ *   \param startTs            [IN] Value returned by AlgorithmLink_phaseBegin()
+ *
+ *******************************************************************************
+*/
+Void AlgorithmLink_phaseEnd(void *ptr, UInt32 phase, UInt64 startTs)
+{
+    AlgorithmLink_Obj *pObj;
+
+    pObj = (AlgorithmLink_Obj *)ptr;
+
+    if(pObj->pPhaseStatsInfo != NULL)
+    {
+        Utils_linkPhaseEnd(&pObj->pPhaseStatsInfo->phaseStats, phase, startTs);
+    }
+}
+
 /**
  *******************************************************************************
  *
@@ -373,14 +422,20 @@ Int32 AlgorithmLink_putFullOutputBuffer(void          *ptr,
     AlgorithmLink_Obj *pObj;
     Int32              status;
 
+    UInt64             startTs;
+
     pObj = (AlgorithmLink_Obj *)ptr;
 
     UTILS_assert(outputQId < pObj->numOutputQUsed);
 
+    startTs = AlgorithmLink_phaseBegin(pObj);
+
     status = Utils_quePut(&(pObj->fullOutputQ[outputQId].queHandle),
                           pSystemBuffer,
                           BSP_OSAL_NO_WAIT);
 
+    AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_SEND, startTs);
+
     UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
 
     return status;
@@ -432,12 +487,15 @@ Int32 AlgorithmLink_releaseInputBuffer(void              *ptr,
     System_BufferList  bufListRelease;
 
     AlgorithmLink_ReleaseStatus relStatus;
+    UInt64             startTs;
 
     AlgorithmLink_Obj * pObj;
     pObj = (AlgorithmLink_Obj*) ptr;
 
     UTILS_assert(inputQId < pObj->numInputQUsed);
 
+    startTs = AlgorithmLink_phaseBegin(pObj);
+
     if(pObj->inputQInfo[inputQId].qMode == ALGORITHM_LINK_QUEUEMODE_NOTINPLACE)
     {
         System_putLinksEmptyBuffers(prevLinkId, prevLinkQueId, pBufList);
@@ -484,6 +542,8 @@ Int32 AlgorithmLink_releaseInputBuffer(void              *ptr,
 
     }
 
+    AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_PUT_BUF, startTs);
+
     return status;
 }
 
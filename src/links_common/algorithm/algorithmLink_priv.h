@@ -226,6 +226,11 @@ typedef struct
     AlgorithmLink_AlgPluginPutEmptyBuffers callbackPutEmptyBuffers;
     /**< User specified callback to call before releasing buffers */
 
+    System_LinkStatistics *pPhaseStatsInfo;
+    /**< Link statistics allocated by the plugin, used to account time in
+     *   framework and process phases. NULL if plugin does not use link
+     *   statistics */
+
 } AlgorithmLink_Obj;
 
 /**
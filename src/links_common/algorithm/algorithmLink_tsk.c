@@ -62,6 +62,7 @@ Int32 AlgorithmLink_pluginCreate(AlgorithmLink_Obj *pObj, Utils_MsgHndl *pMsg)
     pCreateParams = (AlgorithmLink_CreateParams *)(Utils_msgGetPrm(pMsg));
     pObj->algId   = (pCreateParams->algId);
     pObj->callbackPutEmptyBuffers = NULL;
+    pObj->pPhaseStatsInfo = NULL;
     algId         =  pObj->algId;
 
     if(algId>=ALGORITHM_LINK_ALG_MAXNUM)
@@ -99,6 +100,12 @@ Int32 AlgorithmLink_pluginCreate(AlgorithmLink_Obj *pObj, Utils_MsgHndl *pMsg)
               pCreateParams);
 
         UTILS_MEMLOG_USED_END(pObj->memUsed);
+
+        if(status==SYSTEM_LINK_STATUS_SOK)
+        {
+            /* link stats are allocated by the plugin, if at all */
+            pObj->pPhaseStatsInfo = Utils_linkStatsGetLinkStatInst(pObj->linkId);
+        }
         UTILS_MEMLOG_PRINT("ALGORITHM:",
                        pObj->memUsed,
                        UTILS_ARRAYSIZE(pObj->memUsed));
@@ -172,6 +179,7 @@ Void AlgorithmLink_tskMain(struct Utils_TskHndl *pTsk, Utils_MsgHndl *pMsg)
     UInt32 cmd = Utils_msgGetCmd(pMsg);
     Int32 status = SYSTEM_LINK_STATUS_SOK;
     UInt32          flushCmds[1];
+    UInt64          startTs;
     //AlgorithmLink_SurroundViewCreateParams* pCreateParms;
 
     AlgorithmLink_Obj *pObj = (AlgorithmLink_Obj *) pTsk->appData;
@@ -216,10 +224,14 @@ Void AlgorithmLink_tskMain(struct Utils_TskHndl *pTsk, Utils_MsgHndl *pMsg)
 #if defined (BUILD_ARP32)
                   Utils_idleEnableEveDMA();
 #endif
+                  startTs = AlgorithmLink_phaseBegin(pObj);
+
                   status =
                (*(gAlgorithmLinkFuncTable[pObj->algId].AlgorithmLink_AlgPluginProcess))
                     ((void *) pObj);
 
+                  AlgorithmLink_phaseEnd(pObj, UTILS_LINK_PHASE_PROCESS, startTs);
+
 #if defined (BUILD_ARP32)
                   Utils_idleDisableEveDMA();
 #endif
@@ -289,6 +301,9 @@ Void AlgorithmLink_tskMain(struct Utils_TskHndl *pTsk, Utils_MsgHndl *pMsg)
                            " (algId = %d) !!!\n", pObj->algId);
               #endif
 
+              /* link stats are freed by the plugin on delete */
+              pObj->pPhaseStatsInfo = NULL;
+
               if(gAlgorithmLinkFuncTable[pObj->algId].AlgorithmLink_AlgPluginDelete
               != NULL)
               {
@@ -103,6 +103,9 @@ Int32 IpcInLink_drvCreate(IpcInLink_obj *pObj, IpcLink_CreateParams *pPrm)
     /* keep a copy of create args */
     memcpy(&pObj->createArgs, pPrm, sizeof(pObj->createArgs));
 
+    UTILS_assert(pObj->createArgs.descMode == IPC_LINK_DESC_MODE_COPY
+                || pObj->createArgs.descMode == IPC_LINK_DESC_MODE_ZERO_COPY);
+
     /* get previous link info */
     status = System_linkGetInfo(
                     pObj->createArgs.inQueParams.prevLinkId,
@@ -159,6 +162,8 @@ Int32 IpcInLink_drvCreate(IpcInLink_obj *pObj, IpcLink_CreateParams *pPrm)
     }
 
     pObj->isFirstFrameRecv = FALSE;
+    pObj->descTime = 0;
+    pObj->descCount = 0;
 
     sprintf(tskName, "IPC_IN_%u", (unsigned int)pObj->linkInstId);
 
@@ -255,10 +260,21 @@ Void  IpcInLink_drvCopyIpcBufferToSystemBuffer(
     pBuffer->ipcPrfTimestamp64[1] = pIpcBuffer->ipcPrfTimestamp64[1];
 
     UTILS_assert(pBuffer->payloadSize <= SYSTEM_MAX_PAYLOAD_SIZE );
-    UTILS_assert(pBuffer->payload != NULL );
     UTILS_assert(pIpcBuffer->payload != NULL );
 
-    memcpy(pBuffer->payload, pIpcBuffer->payload, pBuffer->payloadSize);
+    if(pObj->createArgs.descMode == IPC_LINK_DESC_MODE_ZERO_COPY)
+    {
+        /* IPC element is owned by this link until the buffer is released,
+         * see IpcInLink_drvPutEmptyBuffers()
+         */
+        pBuffer->payload = pIpcBuffer->payload;
+    }
+    else
+    {
+        UTILS_assert(pBuffer->payload != NULL );
+
+        memcpy(pBuffer->payload, pIpcBuffer->payload, pBuffer->payloadSize);
+    }
 }
 
 /**
@@ -297,6 +313,7 @@ Int32 IpcInLink_drvProcessBuffers(IpcInLink_obj *pObj)
     System_Buffer     *pSysBuffer;
     Bool sendNotifyToPrevLink = FALSE;
     UInt64 tmpTimestamp64;
+    UInt64 startTs;
     System_LinkStatistics *linkStatsInfo;
 
     linkStatsInfo = pObj->linkStatsInfo;
@@ -361,11 +378,16 @@ Int32 IpcInLink_drvProcessBuffers(IpcInLink_obj *pObj)
 
             pSysBuffer->linkLocalTimestamp = Utils_getCurGlobalTimeInUsec();
 
+            startTs = Utils_prfTsGet64();
+
             IpcInLink_drvCopyIpcBufferToSystemBuffer(
                 pObj,
                 pSysBuffer,
                 pIpcBuffer,
                 index);
+
+            pObj->descTime += Utils_prfTsGet64() - startTs;
+            pObj->descCount++;
         }
 
         linkStatsInfo->linkStats.chStats[pSysBuffer->chNum].inBufRecvCount++;
@@ -551,6 +573,29 @@ Int32 IpcInLink_drvPrintStatistics(IpcInLink_obj *pObj)
 
     IpcInLink_latencyStatsPrint(pObj, TRUE);
 
+    if(pObj->descCount)
+    {
+        Types_FreqHz freq;
+        UInt32 freqMhz;
+
+        Timestamp_getFreq(&freq);
+        freqMhz = freq.lo/1000000U;
+        if(freqMhz==0)
+        {
+            freqMhz = 1;
+        }
+
+        Vps_printf(" [%s] Descriptor mode = %s, Avg descriptor time = %d ns/buffer\n",
+                   tskName,
+                   (pObj->createArgs.descMode == IPC_LINK_DESC_MODE_ZERO_COPY)
+                        ? "ZERO_COPY" : "COPY",
+                   (UInt32)((pObj->descTime*1000U)/freqMhz/pObj->descCount));
+        Vps_printf(" \n");
+    }
+
+    pObj->descTime = 0;
+    pObj->descCount = 0;
+
     return status;
 }
 
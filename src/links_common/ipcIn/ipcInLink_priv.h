@@ -140,6 +140,13 @@ typedef struct {
     IpcInLink_LatencyStats ipcLatencyStats;
     /**< IPC specific latency stats */
 
+    UInt64 descTime;
+    /**< Time spent in getting buffer descriptor from IPC shared memory,
+     *   in Utils_prfTsGet64() ticks */
+
+    UInt32 descCount;
+    /**< Number of buffer descriptors accounted in descTime */
+
     UInt32 memUsed[UTILS_MEM_MAXHEAPS];
     /**< Memory used by this link */
 
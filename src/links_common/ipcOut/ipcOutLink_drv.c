@@ -388,9 +388,11 @@ Bool IpcOutLink_drvDoFrameSkip(IpcOutLink_Obj *pObj, UInt32 chNum)
  *               address space between the two cores is different
  *             - The original system buffer pointer is also set in the IPC
  *               shared memory buffer information structure
- *             - Insert the IPC shared memory buffer information structure
- *               pointer in the IPC queue (IPC OUT-> IPC IN Q)
  *             - continue to next buffer pointer
+ *        - Insert the IPC shared memory buffer information structure
+ *          pointers of all buffers in the IPC queue (IPC OUT-> IPC IN Q)
+ *          with a single update of the queue write index. Buffers which
+ *          do not fit in the queue are released to previous link
  *
  *        - If notify is enabled and at least one element was put into
  *          IPC queue then send a notify to the other processor with
@@ -411,7 +413,10 @@ Int32 IpcOutLink_drvProcessBuffers(IpcOutLink_Obj *pObj)
     System_BufferList bufList;
     System_BufferList freeBufList;
     Bool              sendNotify  = FALSE;
-    UInt32            bufId;
+    UInt32            bufId, numIpcBuf, numWritten;
+    UInt32            ipcBufIndex[SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST];
+    System_Buffer     *ipcBufSrc[SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST];
+    UInt64            startTs;
     System_LinkStatistics *linkStatsInfo;
 
     linkStatsInfo = pObj->linkStatsInfo;
@@ -440,6 +445,7 @@ Int32 IpcOutLink_drvProcessBuffers(IpcOutLink_Obj *pObj)
                     &bufList);
 
     freeBufList.numBuf = 0;
+    numIpcBuf = 0;
 
     if(bufList.numBuf)
     {
@@ -510,40 +516,76 @@ Int32 IpcOutLink_drvProcessBuffers(IpcOutLink_Obj *pObj)
                     continue;
                 }
 
+                startTs = Utils_prfTsGet64();
+
                 IpcOutLink_drvCopySystemBufferToIpcBuffer(
                     pObj,
                     pBuffer,
                     pIpcBuffer
                     );
 
+                pObj->descTime += Utils_prfTsGet64() - startTs;
+                pObj->descCount++;
+
                 pIpcBuffer->ipcPrfTimestamp64[1] = Utils_getCurGlobalTimeInUsec();
             }
 
-            status = Utils_ipcQueWrite(
+            /* written to IPC queue after all buffers are translated */
+            ipcBufIndex[numIpcBuf] = index;
+            ipcBufSrc[numIpcBuf]   = pBuffer;
+            numIpcBuf++;
+        }
+
+        if(numIpcBuf)
+        {
+            /* one write index update for the whole batch */
+            numWritten = numIpcBuf;
+
+            status = Utils_ipcQueWriteMulti(
                             &pObj->ipcOut2InQue,
-                            (UInt8*)&index,
-                            sizeof(UInt32)
+                            (UInt8*)ipcBufIndex,
+                            sizeof(UInt32),
+                            &numWritten
                             );
 
-            if(status!=SYSTEM_LINK_STATUS_SOK)
+            for (bufId = 0; bufId < numIpcBuf; bufId++)
             {
-                linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
+                pBuffer = ipcBufSrc[bufId];
 
-                /* if could not add element to queue, then free the
-                 * system buffer
-                 */
+                if(bufId >= numWritten)
+                {
+                    linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
 
-                UTILS_assert(freeBufList.numBuf <
-                                SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST);
+                    /* if could not add element to queue, then free the
+                     * system buffer and the IPC buffer
+                     */
 
-                freeBufList.buffers[freeBufList.numBuf] = pBuffer;
-                freeBufList.numBuf++;
+                    UTILS_assert(freeBufList.numBuf <
+                                    SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST);
+
+                    freeBufList.buffers[freeBufList.numBuf] = pBuffer;
+                    freeBufList.numBuf++;
+
+                    Utils_quePut(&pObj->localQue,
+                                 (Ptr)ipcBufIndex[bufId],
+                                 BSP_OSAL_NO_WAIT);
+                }
+                else
+                {
+                    linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufProcessCount++;
+
+                    linkStatsInfo->linkStats.chStats[pBuffer->chNum].outBufCount[0]++;
+                }
             }
-            else
-            {
-                linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufProcessCount++;
 
-                linkStatsInfo->linkStats.chStats[pBuffer->chNum].outBufCount[0]++;
+            if(numWritten)
+            {
+                pObj->batchCount++;
+                pObj->batchBufCount += numWritten;
+                if(numWritten > pObj->maxBatchSize)
+                {
+                    pObj->maxBatchSize = numWritten;
+                }
 
                 /* atleast one element successfuly inserted in the IPC que
                  * So send notify to next link
@@ -746,6 +788,41 @@ Int32 IpcOutLink_drvPrintStatistics(IpcOutLink_Obj *pObj)
                        &pObj->linkStatsInfo->srcToLinkLatency,
                        TRUE);
 
+    if(pObj->batchCount)
+    {
+        Vps_printf(" [%s] Batches = %d, Avg batch size = %d.%d, Max batch size = %d\n",
+                   tskName,
+                   pObj->batchCount,
+                   pObj->batchBufCount/pObj->batchCount,
+                   ((pObj->batchBufCount%pObj->batchCount)*10)/pObj->batchCount,
+                   pObj->maxBatchSize);
+        Vps_printf(" \n");
+    }
+
+    if(pObj->descCount)
+    {
+        Types_FreqHz freq;
+        UInt32 freqMhz;
+
+        Timestamp_getFreq(&freq);
+        freqMhz = freq.lo/1000000U;
+        if(freqMhz==0)
+        {
+            freqMhz = 1;
+        }
+
+        Vps_printf(" [%s] Avg descriptor time = %d ns/buffer\n",
+                   tskName,
+                   (UInt32)((pObj->descTime*1000U)/freqMhz/pObj->descCount));
+        Vps_printf(" \n");
+    }
+
+    pObj->batchCount = 0;
+    pObj->batchBufCount = 0;
+    pObj->maxBatchSize = 0;
+    pObj->descTime = 0;
+    pObj->descCount = 0;
+
     return status;
 }
 
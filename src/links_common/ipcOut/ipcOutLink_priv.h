@@ -147,6 +147,23 @@ typedef struct {
     UInt32 memUsed[UTILS_MEM_MAXHEAPS];
     /**< Memory used by this link */
 
+    UInt32 batchCount;
+    /**< Number of times buffers were written to the IPC queue */
+
+    UInt32 batchBufCount;
+    /**< Buffers written to the IPC queue, with batchCount gives the
+     *   average batch size */
+
+    UInt32 maxBatchSize;
+    /**< Max buffers written to the IPC queue at once */
+
+    UInt64 descTime;
+    /**< Time spent in copying buffer descriptor to IPC shared memory,
+     *   in Utils_prfTsGet64() ticks */
+
+    UInt32 descCount;
+    /**< Number of buffer descriptors accounted in descTime */
+
 } IpcOutLink_Obj;
 
 extern IpcOutLink_Obj gIpcOutLink_obj[];
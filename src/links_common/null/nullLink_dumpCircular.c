@@ -0,0 +1,780 @@
+/*
+ ******************************************************************************
+ *
+ * Copyright (C) 2013 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ ******************************************************************************
+ */
+
+/**
+  ******************************************************************************
+ * \file nullLink_dumpCircular.c
+ *
+ * \brief  Circular dump of video frames to memory
+ *
+ *         Memory is split in one region per channel. Frames are written one
+ *         after other in a region, each after a NullLink_DumpFrameHeader,
+ *         wrapping to start of region when region end is reached. On
+ *         trigger a few more frames are dumped and then memory is frozen,
+ *         so it has the frames just before and after the trigger.
+ *
+ *         DMA is done by a separate task so that the link task only queues
+ *         input frames and never waits for DMA.
+ *
+ *******************************************************************************
+ */
+
+ /*****************************************************************************
+  *  INCLUDE FILES
+  *****************************************************************************
+  */
+#include "nullLink_priv.h"
+
+/**
+ *******************************************************************************
+ * \brief Dump task stack
+ *******************************************************************************
+ */
+#pragma DATA_ALIGN(gNullLink_dumpTskStack, 32)
+#pragma DATA_SECTION(gNullLink_dumpTskStack, ".bss:taskStackSection")
+UInt8 gNullLink_dumpTskStack[NULL_LINK_OBJ_MAX][NULL_LINK_DUMP_TSK_STACK_SIZE];
+
+/**
+ *******************************************************************************
+ *
+ * \brief Write region header of a channel to start of its region
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularWriteRegionHdr(NullLink_DumpFramesObj *pDump)
+{
+    memcpy((Ptr)pDump->memAddr, &pDump->regionHdr, sizeof(pDump->regionHdr));
+
+    Cache_wbInv((Ptr)pDump->memAddr,
+                NULL_LINK_DUMP_HDR_SIZE,
+                Cache_Type_ALLD,
+                TRUE);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Reset region of a channel to empty, armed state
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularResetRegion(NullLink_DumpFramesObj *pDump)
+{
+    memset(&pDump->regionHdr, 0, sizeof(pDump->regionHdr));
+
+    pDump->regionHdr.magic      = NULL_LINK_DUMP_REGION_MAGIC;
+    pDump->regionHdr.regionSize = pDump->memSize;
+    pDump->regionHdr.inQueId    = pDump->inQueId;
+    pDump->regionHdr.chId       = pDump->chId;
+    pDump->regionHdr.state      = NULL_LINK_DUMP_STATE_ARMED;
+
+    pDump->numQueued = 0;
+    pDump->wrOffset  = NULL_LINK_DUMP_HDR_SIZE;
+
+    NullLink_dumpCircularWriteRegionHdr(pDump);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Set layout of a frame in dump memory for a channel
+ *
+ *        Planes are stored with pitch just large enough for width, so that
+ *        more frames fit in the region. frameSize is set to 0 when frames
+ *        of the channel cannot be dumped.
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularSetLayout(NullLink_DumpFramesObj *pDump,
+                                           System_LinkChInfo *pChInfo)
+{
+    UInt32 dataFormat, frameSize = 0;
+
+    dataFormat = SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(pChInfo->flags);
+
+    pDump->destPitch[0]   = 0;
+    pDump->destPitch[1]   = 0;
+    pDump->planeOffset[0] = NULL_LINK_DUMP_HDR_SIZE;
+    pDump->planeOffset[1] = 0;
+
+    if(dataFormat==SYSTEM_DF_YUV422I_YUYV
+        ||
+        dataFormat==SYSTEM_DF_YUV422I_UYVY
+        ||
+        dataFormat==SYSTEM_DF_RGB16_565
+        ||
+        dataFormat==SYSTEM_DF_BGR16_565
+        )
+    {
+        pDump->dmaDataFormat = SYSTEM_DF_RAW16;
+        pDump->destPitch[0]  = SystemUtils_align(pChInfo->width*2, 32);
+
+        frameSize = pDump->planeOffset[0]
+                    + pDump->destPitch[0]*pChInfo->height;
+    }
+    else
+    if(dataFormat==SYSTEM_DF_YUV420SP_UV)
+    {
+        pDump->dmaDataFormat  = SYSTEM_DF_YUV420SP_UV;
+        pDump->destPitch[0]   = SystemUtils_align(pChInfo->width, 32);
+        pDump->destPitch[1]   = pDump->destPitch[0];
+        pDump->planeOffset[1] = pDump->planeOffset[0]
+                                + pDump->destPitch[0]*pChInfo->height;
+
+        frameSize = pDump->planeOffset[1]
+                    + pDump->destPitch[1]*(pChInfo->height/2);
+    }
+
+    frameSize = SystemUtils_align(frameSize, NULL_LINK_DUMP_HDR_SIZE);
+
+    if(frameSize==0)
+    {
+        Vps_printf(
+            " NULL_SINK: Q%d: CH%d: Data format %d not supported"
+            " for circular dump !!!\n",
+                pDump->inQueId,
+                pDump->chId,
+                dataFormat
+        );
+    }
+    else
+    if(frameSize > pDump->memSize - NULL_LINK_DUMP_HDR_SIZE)
+    {
+        Vps_printf(
+            " NULL_SINK: Q%d: CH%d: Frame size of %d bytes does not fit"
+            " in dump region of %d bytes, frames NOT dumped !!!\n",
+                pDump->inQueId,
+                pDump->chId,
+                frameSize,
+                pDump->memSize
+        );
+        frameSize = 0;
+    }
+
+    pDump->frameSize = frameSize;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief DMA a frame to region of its channel, then write its header and
+ *        update region header. Called only from dump task.
+ *
+ *        Header of the slot is invalidated before DMA, so a header left from
+ *        a frame dumped earlier in the slot is never seen with new data.
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularCopyFrame(NullLink_Obj *pObj,
+                                           NullLink_DumpReq *pReq)
+{
+    NullLink_DumpFramesObj *pDump;
+    NullLink_DumpFrameHeader *pFrameHdr;
+    System_LinkChInfo *pChInfo;
+    System_VideoFrameBuffer *pVidFrame;
+    System_Buffer *pBuf = pReq->pBuf;
+    Utils_DmaCopyFill2D dmaPrm;
+    UInt32 frameAddr;
+    UInt64 startTime;
+    Int32 status;
+
+    pDump     = &pObj->dumpFramesObj[pReq->inQueId][pBuf->chNum];
+    pChInfo   = &pObj->inQueInfo[pReq->inQueId].chInfo[pBuf->chNum];
+    pVidFrame = (System_VideoFrameBuffer *)pBuf->payload;
+
+    if(pDump->wrOffset + pDump->frameSize > pDump->memSize)
+    {
+        pDump->wrOffset = NULL_LINK_DUMP_HDR_SIZE;
+        pDump->regionHdr.wrapCount++;
+    }
+
+    frameAddr = pDump->memAddr + pDump->wrOffset;
+    pFrameHdr = (NullLink_DumpFrameHeader *)frameAddr;
+
+    pFrameHdr->magic = 0;
+    Cache_wbInv(pFrameHdr, NULL_LINK_DUMP_HDR_SIZE, Cache_Type_ALLD, TRUE);
+
+    dmaPrm.dataFormat   = pDump->dmaDataFormat;
+    dmaPrm.destAddr[0]  = (Ptr)(frameAddr + pDump->planeOffset[0]);
+    dmaPrm.destAddr[1]  = (Ptr)(frameAddr + pDump->planeOffset[1]);
+    dmaPrm.destPitch[0] = pDump->destPitch[0];
+    dmaPrm.destPitch[1] = pDump->destPitch[1];
+    dmaPrm.destStartX   = 0;
+    dmaPrm.destStartY   = 0;
+    dmaPrm.width        = pChInfo->width;
+    dmaPrm.height       = pChInfo->height;
+    dmaPrm.srcAddr[0]   = pVidFrame->bufAddr[0];
+    dmaPrm.srcAddr[1]   = pVidFrame->bufAddr[1];
+    dmaPrm.srcPitch[0]  = pChInfo->pitch[0];
+    dmaPrm.srcPitch[1]  = pChInfo->pitch[1];
+    dmaPrm.srcStartX    = pChInfo->startX;
+    dmaPrm.srcStartY    = pChInfo->startY;
+
+    startTime = Utils_getCurGlobalTimeInUsec();
+
+    status = Utils_dmaCopy2D(&pObj->dumpFramesDmaObj, &dmaPrm, 1);
+    UTILS_assert(status==SYSTEM_LINK_STATUS_SOK);
+
+    pObj->dumpCircularObj.dmaTime += Utils_getCurGlobalTimeInUsec() - startTime;
+
+    /* header was invalidated before DMA and is written after DMA is
+     * complete, so a valid header always means valid frame data */
+    memset(pFrameHdr, 0, NULL_LINK_DUMP_HDR_SIZE);
+
+    pFrameHdr->magic           = NULL_LINK_DUMP_FRAME_MAGIC;
+    pFrameHdr->frameSeq        = pReq->frameSeq;
+    pFrameHdr->prevFrameOffset = pDump->regionHdr.lastFrameOffset;
+    pFrameHdr->frameSize       = pDump->frameSize;
+    pFrameHdr->timestampLow    = (UInt32)(pBuf->srcTimestamp & 0xFFFFFFFFU);
+    pFrameHdr->timestampHigh   = (UInt32)(pBuf->srcTimestamp >> 32);
+    pFrameHdr->chId            = pBuf->chNum;
+    pFrameHdr->dataFormat      =
+                    SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(pChInfo->flags);
+    pFrameHdr->width           = pChInfo->width;
+    pFrameHdr->height          = pChInfo->height;
+    pFrameHdr->pitch[0]        = pDump->destPitch[0];
+    pFrameHdr->pitch[1]        = pDump->destPitch[1];
+    pFrameHdr->planeOffset[0]  = pDump->planeOffset[0];
+    pFrameHdr->planeOffset[1]  = pDump->planeOffset[1];
+
+    Cache_wbInv(pFrameHdr, NULL_LINK_DUMP_HDR_SIZE, Cache_Type_ALLD, TRUE);
+
+    pDump->regionHdr.numFrames       = pReq->frameSeq + 1;
+    pDump->regionHdr.lastFrameOffset = pDump->wrOffset;
+
+    NullLink_dumpCircularWriteRegionHdr(pDump);
+
+    pDump->wrOffset += pDump->frameSize;
+
+    pObj->dumpCircularObj.dumpCount++;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Dump task, DMAs queued frames and releases them to previous link.
+ *        On delete, DMAs frames left in queue and exits.
+ *
+ * \param  arg1     [IN]  Null link instance handle
+ * \param  arg2     [IN]  Not used
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularTskMain(UArg arg1, UArg arg2)
+{
+    NullLink_Obj *pObj = (NullLink_Obj *)arg1;
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    System_LinkInQueParams *pInQueParams;
+    System_BufferList bufList;
+    NullLink_DumpReq *pReq;
+    Int32 status;
+
+    while(1)
+    {
+        status = Utils_queGet(&pDumpObj->reqQue, (Ptr *)&pReq, 1,
+                    pDumpObj->tskExit ? BSP_OSAL_NO_WAIT : BSP_OSAL_WAIT_FOREVER);
+
+        if(status != SYSTEM_LINK_STATUS_SOK)
+        {
+            if(pDumpObj->tskExit)
+            {
+                break;
+            }
+            continue;
+        }
+
+        NullLink_dumpCircularCopyFrame(pObj, pReq);
+
+        pInQueParams = &pObj->createArgs.inQueParams[pReq->inQueId];
+
+        bufList.numBuf = 1;
+        bufList.buffers[0] = pReq->pBuf;
+
+        System_putLinksEmptyBuffers(pInQueParams->prevLinkId,
+                                    pInQueParams->prevLinkQueId,
+                                    &bufList);
+
+        pReq->pBuf = NULL;
+
+        status = Utils_quePut(&pDumpObj->freeQue, pReq, BSP_OSAL_NO_WAIT);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    }
+
+    BspOsal_semPost(pDumpObj->doneSem);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Wait till dump task has completed all queued frames.
+ *        Called only from link task.
+ *
+ *******************************************************************************
+ */
+static Void NullLink_dumpCircularWaitIdle(NullLink_Obj *pObj)
+{
+    while(Utils_queGetQueuedCount(&pObj->dumpCircularObj.freeQue)
+            < pObj->createArgs.dumpQueDepth)
+    {
+        BspOsal_sleep(1);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Create resources for circular dump, split memory in one region per
+ *        channel, create DMA channel, queues and dump task
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success,
+ *                  SYSTEM_LINK_STATUS_EINVALID_PARAMS if there are no input
+ *                  queues or channels, or memory is too small to split
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularCreate(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    NullLink_CreateParams *pPrm = &pObj->createArgs;
+    NullLink_DumpFramesObj *pDump;
+    System_LinkQueInfo *pInQueInfo;
+    Utils_DmaChCreateParams dmaParams;
+    UInt32 inQue, chId, inQueMemSize, chMemSize, instId, i;
+    char tskName[32];
+    Int32 status;
+
+    UTILS_assert(pPrm->dumpQueDepth > 0);
+    UTILS_assert(pPrm->dumpQueDepth <= NULL_LINK_DUMP_MAX_QUE_DEPTH);
+    UTILS_assert(pPrm->dumpFramesMemoryAddr != 0);
+    UTILS_assert((pPrm->dumpFramesMemoryAddr % NULL_LINK_DUMP_HDR_SIZE) == 0);
+
+    memset(pDumpObj, 0, sizeof(*pDumpObj));
+
+    /* Check memory split before anything is created, so that a bad
+     * configuration fails create instead of dividing by zero */
+    if (pPrm->numInQue == 0)
+    {
+        Vps_printf(" NULL_SINK: Circular dump needs at least one input queue !!!\n");
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    inQueMemSize = pPrm->dumpFramesMemorySize/pPrm->numInQue;
+
+    for (inQue = 0; inQue < pPrm->numInQue; inQue++)
+    {
+        pInQueInfo = &pObj->inQueInfo[inQue];
+
+        if ((pInQueInfo->numCh == 0)
+            ||
+            (pInQueInfo->numCh > SYSTEM_MAX_CH_PER_OUT_QUE))
+        {
+            Vps_printf(" NULL_SINK: Q%d: Invalid number of channels (%d)"
+                       " for circular dump !!!\n",
+                       inQue, pInQueInfo->numCh);
+            return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+        }
+
+        chMemSize = SystemUtils_floor(inQueMemSize/pInQueInfo->numCh,
+                                      NULL_LINK_DUMP_HDR_SIZE);
+        if (chMemSize <= NULL_LINK_DUMP_HDR_SIZE)
+        {
+            Vps_printf(" NULL_SINK: Q%d: Circular dump memory of %d bytes"
+                       " too small for %d channels !!!\n",
+                       inQue, inQueMemSize, pInQueInfo->numCh);
+            return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+        }
+    }
+
+    Utils_DmaChCreateParams_Init(&dmaParams);
+
+    status = Utils_dmaCreateCh(&pObj->dumpFramesDmaObj, &dmaParams);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    for (inQue = 0; inQue < pPrm->numInQue; inQue++)
+    {
+        pInQueInfo = &pObj->inQueInfo[inQue];
+
+        chMemSize = SystemUtils_floor(inQueMemSize/pInQueInfo->numCh,
+                                      NULL_LINK_DUMP_HDR_SIZE);
+
+        for (chId = 0; chId < pInQueInfo->numCh; chId++)
+        {
+            pDump = &pObj->dumpFramesObj[inQue][chId];
+
+            pDump->inQueId   = inQue;
+            pDump->chId      = chId;
+            pDump->numFrames = 0;
+            pDump->memAddr   = pPrm->dumpFramesMemoryAddr
+                                + SystemUtils_floor(inQueMemSize*inQue,
+                                                    NULL_LINK_DUMP_HDR_SIZE)
+                                + chMemSize*chId;
+            pDump->memSize   = chMemSize;
+
+            NullLink_dumpCircularSetLayout(pDump, &pInQueInfo->chInfo[chId]);
+            NullLink_dumpCircularResetRegion(pDump);
+
+            Vps_printf(
+                " NULL_SINK: Q%d: CH%d: Circular dump @ 0x%08x, size: %d bytes,"
+                " %d frames !!!\n",
+                    inQue,
+                    chId,
+                    pDump->memAddr,
+                    pDump->memSize,
+                    pDump->frameSize ?
+                        (pDump->memSize - NULL_LINK_DUMP_HDR_SIZE)
+                            /pDump->frameSize : 0
+            );
+        }
+    }
+
+    status = Utils_queCreate(&pDumpObj->reqQue,
+                             pPrm->dumpQueDepth,
+                             pDumpObj->reqQueMem,
+                             UTILS_QUE_FLAG_SPSC | UTILS_QUE_FLAG_BLOCK_QUE_GET);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    status = Utils_queCreate(&pDumpObj->freeQue,
+                             pPrm->dumpQueDepth,
+                             pDumpObj->freeQueMem,
+                             UTILS_QUE_FLAG_SPSC | UTILS_QUE_FLAG_NO_BLOCK_QUE);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    for (i = 0; i < pPrm->dumpQueDepth; i++)
+    {
+        status = Utils_quePut(&pDumpObj->freeQue,
+                              &pDumpObj->reqMem[i],
+                              BSP_OSAL_NO_WAIT);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    }
+
+    pDumpObj->state = NULL_LINK_DUMP_STATE_ARMED;
+
+    pDumpObj->doneSem = BspOsal_semCreate(0, TRUE);
+    UTILS_assert(pDumpObj->doneSem != NULL);
+
+    pDumpObj->tskExit = FALSE;
+
+    instId = SYSTEM_GET_LINK_ID(pObj->tskId) - SYSTEM_LINK_ID_NULL_0;
+    UTILS_assert(instId < NULL_LINK_OBJ_MAX);
+
+    pDumpObj->tsk = BspOsal_taskCreate(
+                        (BspOsal_TaskFuncPtr)NullLink_dumpCircularTskMain,
+                        NULL_LINK_DUMP_TSK_PRI,
+                        gNullLink_dumpTskStack[instId],
+                        NULL_LINK_DUMP_TSK_STACK_SIZE,
+                        pObj);
+    UTILS_assert(pDumpObj->tsk != NULL);
+
+    sprintf(tskName, "NULL_DUMP%u", (unsigned int)instId);
+    Utils_prfLoadRegister(pDumpObj->tsk, tskName);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Delete resources for circular dump. Frames already queued are
+ *        dumped before dump task exits.
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularDelete(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+
+    pDumpObj->tskExit = TRUE;
+    Utils_queUnBlock(&pDumpObj->reqQue);
+
+    BspOsal_semWait(pDumpObj->doneSem, BSP_OSAL_WAIT_FOREVER);
+
+    Utils_prfLoadUnRegister(pDumpObj->tsk);
+    BspOsal_taskDelete(&pDumpObj->tsk);
+    pDumpObj->tsk = NULL;
+
+    BspOsal_semDelete(&pDumpObj->doneSem);
+
+    Utils_queDelete(&pDumpObj->reqQue);
+    Utils_queDelete(&pDumpObj->freeQue);
+
+    Utils_dmaDeleteCh(&pObj->dumpFramesDmaObj);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Queue an input frame for DMA. Called only from link task.
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ * \param  inQue    [IN]  Input queue of buffer
+ * \param  pBuf     [IN]  Input buffer
+ *
+ * \return SYSTEM_LINK_STATUS_SOK if frame is queued and is released later
+ *         by dump task, else caller should release the frame
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularQueueFrame(NullLink_Obj *pObj, UInt32 inQue,
+                                      System_Buffer *pBuf)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    NullLink_DumpFramesObj *pDump;
+    NullLink_DumpReq *pReq;
+    UInt32 queCount;
+    Int32 status;
+
+    if(pDumpObj->state == NULL_LINK_DUMP_STATE_FROZEN
+        ||
+       pBuf == NULL
+        ||
+       pBuf->bufType != SYSTEM_BUFFER_TYPE_VIDEO_FRAME
+        ||
+       inQue >= pObj->createArgs.numInQue
+        ||
+       pBuf->chNum >= pObj->inQueInfo[inQue].numCh
+        ||
+       pBuf->chNum >= SYSTEM_MAX_CH_PER_OUT_QUE
+      )
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    pDump = &pObj->dumpFramesObj[inQue][pBuf->chNum];
+
+    if(pDump->frameSize == 0)
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    status = Utils_queGet(&pDumpObj->freeQue, (Ptr *)&pReq, 1,
+                          BSP_OSAL_NO_WAIT);
+    if(status != SYSTEM_LINK_STATUS_SOK)
+    {
+        /* dump task is behind, do not hold up previous link */
+        pDumpObj->dropCount++;
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    pReq->pBuf     = pBuf;
+    pReq->inQueId  = inQue;
+    pReq->frameSeq = pDump->numQueued;
+
+    pDump->numQueued++;
+
+    status = Utils_quePut(&pDumpObj->reqQue, pReq, BSP_OSAL_NO_WAIT);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    pDumpObj->queuedCount++;
+
+    queCount = pObj->createArgs.dumpQueDepth
+                - Utils_queGetQueuedCount(&pDumpObj->freeQue);
+    if(queCount > pDumpObj->maxQueCount)
+    {
+        pDumpObj->maxQueCount = queCount;
+    }
+
+    if(pDumpObj->state == NULL_LINK_DUMP_STATE_TRIGGERED)
+    {
+        pDumpObj->postTriggerCount++;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Freeze dump memory once enough frames are dumped after trigger.
+ *        Called only from link task.
+ *
+ *        Waits for dump task to complete queued frames, then writes trigger
+ *        to region headers, marks them as frozen and prints where the
+ *        frames are.
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularCheckFreeze(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    NullLink_DumpFramesObj *pDump;
+    UInt32 inQue, chId;
+
+    if(pDumpObj->state != NULL_LINK_DUMP_STATE_TRIGGERED
+        ||
+       pDumpObj->postTriggerCount < pObj->createArgs.dumpPostTriggerFrames)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    pDumpObj->state = NULL_LINK_DUMP_STATE_FROZEN;
+
+    NullLink_dumpCircularWaitIdle(pObj);
+
+    for (inQue = 0; inQue < pObj->createArgs.numInQue; inQue++)
+    {
+        for (chId = 0; chId < pObj->inQueInfo[inQue].numCh; chId++)
+        {
+            pDump = &pObj->dumpFramesObj[inQue][chId];
+
+            pDump->regionHdr.triggerFrameSeq      = pDump->triggerFrameSeq;
+            pDump->regionHdr.triggerTimestampLow  =
+                        (UInt32)(pDumpObj->triggerTime & 0xFFFFFFFFU);
+            pDump->regionHdr.triggerTimestampHigh =
+                        (UInt32)(pDumpObj->triggerTime >> 32);
+            pDump->regionHdr.state = NULL_LINK_DUMP_STATE_FROZEN;
+
+            NullLink_dumpCircularWriteRegionHdr(pDump);
+
+            Vps_printf(
+                " NULL_SINK: Q%d: CH%d: Dump frozen, %d frames, trigger at frame %d,"
+                " last frame @ 0x%08x !!!\n",
+                    inQue,
+                    chId,
+                    pDump->regionHdr.numFrames,
+                    pDump->regionHdr.triggerFrameSeq,
+                    pDump->memAddr + pDump->regionHdr.lastFrameOffset
+            );
+        }
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Handle NULL_LINK_CMD_DUMP_TRIGGER. Called only from link task.
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularTrigger(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    NullLink_DumpFramesObj *pDump;
+    UInt32 inQue, chId;
+
+    if(pDumpObj->state != NULL_LINK_DUMP_STATE_ARMED)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    pDumpObj->triggerTime = Utils_getCurGlobalTimeInUsec();
+    pDumpObj->postTriggerCount = 0;
+
+    /* dump task may be writing region headers now, trigger is written to
+     * them at freeze when dump task is idle */
+    for (inQue = 0; inQue < pObj->createArgs.numInQue; inQue++)
+    {
+        for (chId = 0; chId < pObj->inQueInfo[inQue].numCh; chId++)
+        {
+            pDump = &pObj->dumpFramesObj[inQue][chId];
+
+            pDump->triggerFrameSeq = pDump->numQueued;
+        }
+    }
+
+    pDumpObj->state = NULL_LINK_DUMP_STATE_TRIGGERED;
+
+    Vps_printf(" NULL_SINK: Dump triggered, freezing after %d frames !!!\n",
+        pObj->createArgs.dumpPostTriggerFrames);
+
+    return NullLink_dumpCircularCheckFreeze(pObj);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Handle NULL_LINK_CMD_DUMP_REARM. Called only from link task.
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularRearm(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    UInt32 inQue, chId;
+
+    if(pDumpObj->state != NULL_LINK_DUMP_STATE_FROZEN)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    /* nothing is queued when frozen, dump task is idle */
+    NullLink_dumpCircularWaitIdle(pObj);
+
+    for (inQue = 0; inQue < pObj->createArgs.numInQue; inQue++)
+    {
+        for (chId = 0; chId < pObj->inQueInfo[inQue].numCh; chId++)
+        {
+            NullLink_dumpCircularResetRegion(
+                    &pObj->dumpFramesObj[inQue][chId]);
+        }
+    }
+
+    pDumpObj->state = NULL_LINK_DUMP_STATE_ARMED;
+
+    Vps_printf(" NULL_SINK: Dump re-armed !!!\n");
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Print circular dump statistics
+ *
+ * \param  pObj     [IN]  Null link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NullLink_dumpCircularPrintStatistics(NullLink_Obj *pObj)
+{
+    NullLink_DumpCircularObj *pDumpObj = &pObj->dumpCircularObj;
+    UInt32 dumpCount, avgDmaTime = 0;
+
+    dumpCount = pDumpObj->dumpCount;
+    if(dumpCount)
+    {
+        avgDmaTime = (UInt32)(pDumpObj->dmaTime/dumpCount);
+    }
+
+    Vps_printf(" [NULL_SINK] Dump state = %d, Queued = %d, Dumped = %d,"
+               " Dropped (queue full) = %d, Max queued = %d of %d,"
+               " Avg DMA time = %d us\n",
+               pDumpObj->state,
+               pDumpObj->queuedCount,
+               dumpCount,
+               pDumpObj->dropCount,
+               pDumpObj->maxQueCount,
+               pObj->createArgs.dumpQueDepth,
+               avgDmaTime);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
@@ -20,11 +20,77 @@
 
 #define NETWORK_TX_SERVER_POLL_TIMEOUT  (10)
 
+static UInt32 NullLink_networkTxGetPayloadType(System_LinkChInfo *pChInfo)
+{
+    System_VideoDataFormat dataFormat;
+
+    dataFormat = (System_VideoDataFormat)
+        SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(pChInfo->flags);
+
+    if(dataFormat == SYSTEM_DF_YUV420SP_UV)
+    {
+        return NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV;
+    }
+
+    return NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV;
+}
+
+/* Allocate buffer for compressed frame of largest input channel */
+static Void NullLink_networkTxCreateEncBuf(NullLink_Obj *pObj)
+{
+    NullLink_NetworkTxObj *pNetTxObj = &pObj->netTxObj;
+    System_LinkChInfo *pChInfo;
+    UInt32 inQue, chId, size;
+
+    pNetTxObj->encBuf = NULL;
+    pNetTxObj->encBufSize = 0;
+
+    for(inQue=0; inQue<pObj->createArgs.numInQue; inQue++)
+    {
+        for(chId=0; chId<pObj->inQueInfo[inQue].numCh; chId++)
+        {
+            pChInfo = &pObj->inQueInfo[inQue].chInfo[chId];
+
+            if(SYSTEM_LINK_CH_INFO_GET_FLAG_BUF_TYPE(pChInfo->flags)
+                    == SYSTEM_BUFFER_TYPE_VIDEO_FRAME)
+            {
+                size = NetworkCodec_getMaxSize(
+                            NullLink_networkTxGetPayloadType(pChInfo),
+                            pChInfo->width,
+                            pChInfo->height);
+
+                if(size > pNetTxObj->encBufSize)
+                {
+                    pNetTxObj->encBufSize = size;
+                }
+            }
+        }
+    }
+
+    if(pNetTxObj->encBufSize)
+    {
+        pNetTxObj->encBufSize = SystemUtils_align(pNetTxObj->encBufSize, 128);
+
+        pNetTxObj->encBuf = Utils_memAlloc(
+                                UTILS_HEAPID_DDR_CACHED_SR,
+                                pNetTxObj->encBufSize,
+                                128);
+        UTILS_assert(pNetTxObj->encBuf!=NULL);
+    }
+}
+
 Int32 NullLink_networkTxCreate(NullLink_Obj *pObj)
 {
     NullLink_NetworkTxObj *pNetTxObj = &pObj->netTxObj;
     Int32 status;
 
+    memset(pNetTxObj, 0, sizeof(*pNetTxObj));
+
+    if(pObj->createArgs.networkTxCompress)
+    {
+        NullLink_networkTxCreateEncBuf(pObj);
+    }
+
     Network_sessionOpen(NULL);
 
     status = Network_open(
@@ -51,6 +117,14 @@ Int32 NullLink_networkTxDelete(NullLink_Obj *pObj)
 
     Network_sessionClose(NULL);
 
+    if(pNetTxObj->encBuf)
+    {
+        Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR,
+                      pNetTxObj->encBuf,
+                      pNetTxObj->encBufSize);
+        pNetTxObj->encBuf = NULL;
+    }
+
     pNetTxObj->state = NETWORK_TX_SERVER_CLOSED;
 
     Vps_printf(" NULL: NETWORK_TX: Server Closed (port=%d) !!!\n",
@@ -165,6 +239,97 @@ Int32 NullLink_networkTxWritePayload(NullLink_Obj *pObj,
     return status;
 }
 
+/* Compress frame into encBuf, header is updated only when compressed frame
+ * is smaller than raw frame. Encoding is skipped while the channel backs off
+ * after frames which were not made smaller.
+ */
+static Bool NullLink_networkTxCompress(NullLink_NetworkTxObj *pNetTxObj,
+                        NetworkCodec_Backoff *pBackoff,
+                        NetworkRx_CmdHeader *pHeader,
+                        System_VideoFrameBuffer *videoFrame)
+{
+    UInt8 *srcAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 srcPitch[NETWORK_CODEC_MAX_PLANES];
+    UInt32 numPlanes, i, planeSize, encSize;
+    UInt64 startTime;
+    Int32 status;
+    Bool isCompressed = FALSE;
+
+    pNetTxObj->rawBytes += pHeader->dataSize;
+
+    if(NetworkCodec_backoffIsSkip(pBackoff))
+    {
+        pNetTxObj->encSkipFrameCount++;
+        pNetTxObj->encBytes += pHeader->dataSize;
+        return FALSE;
+    }
+
+    numPlanes = 1;
+    if(pHeader->payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        numPlanes = 2;
+    }
+
+    for(i=0; i<numPlanes; i++)
+    {
+        srcAddr[i] = videoFrame->bufAddr[i];
+        srcPitch[i] = pHeader->pitch[i];
+
+        planeSize = pHeader->pitch[i]*pHeader->height;
+        if(i==1)
+        {
+            planeSize /= 2;
+        }
+
+        Cache_inv(
+                  (Ptr)SystemUtils_floor((UInt32)srcAddr[i], 128),
+                  SystemUtils_align(planeSize+128, 128),
+                  Cache_Type_ALLD,
+                  TRUE
+                );
+    }
+
+    startTime = Utils_getCurGlobalTimeInUsec();
+
+    status = NetworkCodec_encode(
+                pHeader->payloadType,
+                pHeader->width,
+                pHeader->height,
+                srcAddr,
+                srcPitch,
+                pNetTxObj->encBuf,
+                pNetTxObj->encBufSize,
+                &encSize);
+
+    pNetTxObj->encTime += Utils_getCurGlobalTimeInUsec() - startTime;
+    pNetTxObj->encInBytes += pHeader->dataSize;
+
+    if(status==SYSTEM_LINK_STATUS_SOK && encSize < pHeader->dataSize)
+    {
+        /* payload is invalidated before it is sent */
+        Cache_wb(pNetTxObj->encBuf,
+                 SystemUtils_align(encSize, 128),
+                 Cache_Type_ALLD,
+                 TRUE);
+
+        pHeader->payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED;
+        pHeader->dataSize = encSize;
+
+        pNetTxObj->encFrameCount++;
+        isCompressed = TRUE;
+    }
+    else
+    {
+        pNetTxObj->encRawFrameCount++;
+    }
+
+    NetworkCodec_backoffUpdate(pBackoff, isCompressed);
+
+    pNetTxObj->encBytes += pHeader->dataSize;
+
+    return isCompressed;
+}
+
 Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 channelId,
                             System_Buffer *pBuffer)
 {
@@ -175,6 +340,7 @@ Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 chann
     System_BitstreamBuffer *bitstreamBuf;
     System_MetaDataBuffer *metaBuf;
     System_LinkChInfo *pChInfo;
+    Bool isCompressed = FALSE;
     UInt16 i;
 
     status = NullLink_networkTxWaitConnect(pObj, pNetTxObj);
@@ -243,6 +409,14 @@ Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 chann
                     cmdHeader.pitch[1] = pChInfo->pitch[1];
                 }
 
+                if(status==SYSTEM_LINK_STATUS_SOK && pNetTxObj->encBuf!=NULL)
+                {
+                    isCompressed = NullLink_networkTxCompress(
+                                        pNetTxObj,
+                                        &pNetTxObj->encBackoff[queId][channelId],
+                                        &cmdHeader, videoFrame);
+                }
+
                 break;
 
             default:
@@ -281,6 +455,13 @@ Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 chann
 
                 case SYSTEM_BUFFER_TYPE_VIDEO_FRAME:
 
+                    if(isCompressed)
+                    {
+                        numBuf = 1;
+                        dataAddr[0] = pNetTxObj->encBuf;
+                        dataSize[0] = cmdHeader.dataSize;
+                    }
+                    else
                     if(dataFormat == SYSTEM_DF_YUV420SP_UV)
                     {
                         numBuf = 2;
@@ -295,7 +476,7 @@ Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 chann
                     {
                         numBuf = 1;
                         dataAddr[0] = videoFrame->bufAddr[0];
-                        dataSize[0] = cmdHeader.pitch[0]*cmdHeader.height*2;
+                        dataSize[0] = cmdHeader.pitch[0]*cmdHeader.height;
                         UTILS_assert( dataSize[0] == cmdHeader.dataSize );
                     }
                     break;
@@ -313,3 +494,36 @@ Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 chann
 
     return status;
 }
+
+Int32 NullLink_networkTxPrintStatistics(NullLink_Obj *pObj)
+{
+    NullLink_NetworkTxObj *pNetTxObj = &pObj->netTxObj;
+    UInt32 ratio = 0, encRate = 0;
+
+    if(pNetTxObj->encBuf==NULL)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    if(pNetTxObj->encBytes)
+    {
+        /* x100 */
+        ratio = (UInt32)((pNetTxObj->rawBytes*100)/pNetTxObj->encBytes);
+    }
+    if(pNetTxObj->encTime)
+    {
+        /* bytes per usec is MB/s */
+        encRate = (UInt32)(pNetTxObj->encInBytes/pNetTxObj->encTime);
+    }
+
+    Vps_printf(" [NULL_SINK] Network TX compressed frames = %d, "
+               "sent uncompressed = %d, not encoded (backoff) = %d, "
+               "ratio = %d.%02d, compression rate = %d MB/s\n",
+               pNetTxObj->encFrameCount,
+               pNetTxObj->encRawFrameCount,
+               pNetTxObj->encSkipFrameCount,
+               ratio/100, ratio%100,
+               encRate);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
@@ -44,6 +44,7 @@ extern "C" {
 #include <src/links_ipu/system/system_priv_ipu1_0.h>
 #include <include/link_api/nullLink.h>
 #include <src/utils_common/include/network_api.h>
+#include <src/utils_common/include/network_codec.h>
 
 /*******************************************************************************
  *  Defines
@@ -61,6 +62,25 @@ extern "C" {
  */
 #define NULL_LINK_OBJ_MAX    (2)
 
+/**
+ *******************************************************************************
+ *
+ * \brief Circular dump task priority, lower than link task so that queuing
+ *        and releasing of input frames is never delayed by DMA
+ *
+ *******************************************************************************
+ */
+#define NULL_LINK_DUMP_TSK_PRI          (NULL_LINK_TSK_PRI-1)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Circular dump task stack size
+ *
+ *******************************************************************************
+ */
+#define NULL_LINK_DUMP_TSK_STACK_SIZE   (SYSTEM_TSK_STACK_SIZE_SMALL)
+
 /*******************************************************************************
  *  Data structure's
  *******************************************************************************
@@ -81,6 +101,36 @@ typedef struct {
     UInt32 state;
     /**< State of server socket */
 
+    UInt8 *encBuf;
+    /**< Compressed frame, allocated only when networkTxCompress is TRUE */
+
+    UInt32 encBufSize;
+
+    UInt32 encFrameCount;
+    /**< Frames compressed */
+
+    UInt32 encRawFrameCount;
+    /**< Frames sent uncompressed since compressed was not smaller */
+
+    UInt32 encSkipFrameCount;
+    /**< Frames sent uncompressed without encoding, see encBackoff */
+
+    NetworkCodec_Backoff encBackoff[NULL_LINK_MAX_IN_QUE]
+                                   [SYSTEM_MAX_CH_PER_OUT_QUE];
+    /**< Encode backoff of every channel */
+
+    UInt64 rawBytes;
+    /**< Size of frames before compression */
+
+    UInt64 encInBytes;
+    /**< Size of frames given to encoder, for compression rate */
+
+    UInt64 encBytes;
+    /**< Size of sent frames, compressed or not */
+
+    UInt64 encTime;
+    /**< Time taken by compression, in usecs */
+
 } NullLink_NetworkTxObj;
 
 /**
@@ -110,8 +160,127 @@ typedef struct {
     UInt32 numFrames;
     /**< Number of frames dumped to memory */
 
+    UInt32 frameSize;
+    /**< Circular dump, bytes taken by a frame in memory including header,
+     *   0 if frames of this channel cannot be dumped */
+
+    UInt32 dmaDataFormat;
+    /**< Circular dump, data format to use for DMA */
+
+    UInt32 destPitch[2];
+    /**< Circular dump, pitch of each plane in dump memory */
+
+    UInt32 planeOffset[2];
+    /**< Circular dump, offset of each plane from start of frame header */
+
+    UInt32 numQueued;
+    /**< Circular dump, frames queued for DMA, used as frame sequence number.
+     *   Updated by link task */
+
+    UInt32 wrOffset;
+    /**< Circular dump, offset where next frame header is written.
+     *   Updated by dump task */
+
+    UInt32 triggerFrameSeq;
+    /**< Circular dump, numQueued at trigger, copied to region header at
+     *   freeze. Updated by link task */
+
+    NullLink_DumpRegionHeader regionHdr;
+    /**< Circular dump, copy of region header written to start of region.
+     *   Updated by dump task while frames are queued, by link task only
+     *   when dump task is idle */
+
 } NullLink_DumpFramesObj;
 
+/**
+ *******************************************************************************
+ *
+ * \brief Frame queued for DMA in circular dump mode
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    System_Buffer *pBuf;
+    /**< Input buffer, released to previous link after DMA */
+
+    UInt32 inQueId;
+    /**< Input queue of buffer */
+
+    UInt32 frameSeq;
+    /**< Sequence number of frame in its channel region */
+
+} NullLink_DumpReq;
+
+/**
+ *******************************************************************************
+ *
+ * \brief Circular dump related information
+ *
+ *        Link task queues input frames on reqQue, dump task DMAs them to
+ *        dump memory, releases them to previous link and returns the
+ *        request on freeQue. Both are single producer, single consumer
+ *        queues.
+ *
+ *        state is changed only by link task. Region headers are changed by
+ *        link task only when all requests are back on freeQue, i.e. at
+ *        create, freeze and re-arm. Trigger is kept in link task fields and
+ *        copied to region headers at freeze.
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    UInt32 state;
+    /**< NULL_LINK_DUMP_STATE_xxx */
+
+    UInt32 postTriggerCount;
+    /**< Frames queued after trigger */
+
+    UInt64 triggerTime;
+    /**< Time of trigger in usecs */
+
+    NullLink_DumpReq reqMem[NULL_LINK_DUMP_MAX_QUE_DEPTH];
+    /**< Requests */
+
+    Utils_QueHandle reqQue;
+    /**< Requests queued for DMA */
+
+    Ptr reqQueMem[NULL_LINK_DUMP_MAX_QUE_DEPTH];
+    /**< Memory for reqQue */
+
+    Utils_QueHandle freeQue;
+    /**< Free requests */
+
+    Ptr freeQueMem[NULL_LINK_DUMP_MAX_QUE_DEPTH];
+    /**< Memory for freeQue */
+
+    BspOsal_TaskHandle tsk;
+    /**< Dump task handle */
+
+    BspOsal_SemHandle doneSem;
+    /**< Posted by dump task when it exits */
+
+    volatile Bool tskExit;
+    /**< Set at delete, dump task dumps what is queued and exits */
+
+    UInt32 queuedCount;
+    /**< Frames queued for DMA, link task */
+
+    UInt32 dropCount;
+    /**< Frames not dumped since all requests were in use, link task */
+
+    UInt32 maxQueCount;
+    /**< Max frames held by dump task, link task */
+
+    UInt32 dumpCount;
+    /**< Frames dumped, dump task */
+
+    UInt64 dmaTime;
+    /**< Time taken by DMA in usecs, dump task */
+
+} NullLink_DumpCircularObj;
+
 /**
  *******************************************************************************
  *
@@ -151,12 +320,25 @@ typedef struct {
     NullLink_NetworkTxObj netTxObj;
     /**< Information related to sending data over network */
 
+    NullLink_DumpCircularObj dumpCircularObj;
+    /**< Information related to circular dump of frames */
+
 } NullLink_Obj;
 
 Int32 NullLink_networkTxCreate(NullLink_Obj *pObj);
 Int32 NullLink_networkTxDelete(NullLink_Obj *pObj);
 Int32 NullLink_networkTxSendData(NullLink_Obj * pObj, UInt32 queId, UInt32 channelId,
                             System_Buffer *pBuffer);
+Int32 NullLink_networkTxPrintStatistics(NullLink_Obj *pObj);
+
+Int32 NullLink_dumpCircularCreate(NullLink_Obj *pObj);
+Int32 NullLink_dumpCircularDelete(NullLink_Obj *pObj);
+Int32 NullLink_dumpCircularQueueFrame(NullLink_Obj *pObj, UInt32 inQue,
+                            System_Buffer *pBuf);
+Int32 NullLink_dumpCircularCheckFreeze(NullLink_Obj *pObj);
+Int32 NullLink_dumpCircularTrigger(NullLink_Obj *pObj);
+Int32 NullLink_dumpCircularRearm(NullLink_Obj *pObj);
+Int32 NullLink_dumpCircularPrintStatistics(NullLink_Obj *pObj);
 
 #ifdef __cplusplus
 }
@@ -115,6 +115,10 @@ Int32 NullLink_drvCreateDumpFramesObj(NullLink_Obj * pObj)
     {
         NullLink_networkTxCreate(pObj);
     }
+    else if(pObj->createArgs.dumpDataType == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+    {
+        status = NullLink_dumpCircularCreate(pObj);
+    }
 
     return status;
 }
@@ -139,6 +143,10 @@ Int32 NullLink_drvDeleteDumpFramesObj(NullLink_Obj * pObj)
     {
         NullLink_networkTxDelete(pObj);
     }
+    else if(pObj->createArgs.dumpDataType == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+    {
+        NullLink_dumpCircularDelete(pObj);
+    }
 
     return SYSTEM_LINK_STATUS_SOK;
 }
@@ -330,9 +338,9 @@ Int32 NullLink_drvCreate(NullLink_Obj * pObj, NullLink_CreateParams * pPrm)
             [pPrm->inQueParams[inQue].prevLinkQueId];
     }
 
-    NullLink_drvCreateDumpFramesObj(pObj);
+    status = NullLink_drvCreateDumpFramesObj(pObj);
 
-    return SYSTEM_LINK_STATUS_SOK;
+    return status;
 }
 
 /**
@@ -340,6 +348,9 @@ Int32 NullLink_drvCreate(NullLink_Obj * pObj, NullLink_CreateParams * pPrm)
  * \brief Null Link just receives incoming buffers and returns back to the
  *   sending link. This function does the same
  *
+ *   In circular dump mode, frames queued for DMA are returned later by the
+ *   dump task.
+ *
  * \param  pObj     [IN]  Null link instance handle
  *
  * \return status   SYSTEM_LINK_STATUS_SOK on success
@@ -350,7 +361,7 @@ Int32 NullLink_drvProcessFrames(NullLink_Obj * pObj)
 {
     System_LinkInQueParams *pInQueParams;
     System_BufferList bufList;
-    UInt32 queId, bufId;
+    UInt32 queId, bufId, numFreeBuf;
 
     for (queId = 0; queId < pObj->createArgs.numInQue; queId++)
     {
@@ -363,16 +374,45 @@ Int32 NullLink_drvProcessFrames(NullLink_Obj * pObj)
         {
             pObj->recvCount += bufList.numBuf;
 
+            numFreeBuf = 0;
+
             for (bufId = 0; bufId < bufList.numBuf; bufId++)
             {
-                NullLink_drvDumpFrames(pObj, queId, bufList.buffers[bufId]);
+                if(pObj->createArgs.dumpDataType
+                        == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+                {
+                    if(NullLink_dumpCircularQueueFrame(pObj, queId,
+                            bufList.buffers[bufId])==SYSTEM_LINK_STATUS_SOK)
+                    {
+                        /* released by dump task after DMA */
+                        continue;
+                    }
+                }
+                else
+                {
+                    NullLink_drvDumpFrames(pObj, queId, bufList.buffers[bufId]);
+                }
+
+                bufList.buffers[numFreeBuf] = bufList.buffers[bufId];
+                numFreeBuf++;
             }
 
-            System_putLinksEmptyBuffers(pInQueParams->prevLinkId,
-                                       pInQueParams->prevLinkQueId, &bufList);
+            bufList.numBuf = numFreeBuf;
+
+            if (bufList.numBuf)
+            {
+                System_putLinksEmptyBuffers(pInQueParams->prevLinkId,
+                                           pInQueParams->prevLinkQueId, &bufList);
+            }
         }
 
     }
+
+    if(pObj->createArgs.dumpDataType == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+    {
+        NullLink_dumpCircularCheckFreeze(pObj);
+    }
+
     return SYSTEM_LINK_STATUS_SOK;
 }
 
@@ -441,6 +481,35 @@ Void NullLink_tskMain(struct Utils_TskHndl * pTsk, Utils_MsgHndl * pMsg)
 
                 NullLink_drvProcessFrames(pObj);
                 break;
+            case NULL_LINK_CMD_DUMP_TRIGGER:
+                if(pObj->createArgs.dumpDataType
+                        == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+                {
+                    NullLink_dumpCircularTrigger(pObj);
+                }
+                Utils_tskAckOrFreeMsg(pMsg, status);
+                break;
+            case NULL_LINK_CMD_DUMP_REARM:
+                if(pObj->createArgs.dumpDataType
+                        == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+                {
+                    NullLink_dumpCircularRearm(pObj);
+                }
+                Utils_tskAckOrFreeMsg(pMsg, status);
+                break;
+            case SYSTEM_CMD_PRINT_STATISTICS:
+                if(pObj->createArgs.dumpDataType
+                        == NULL_LINK_COPY_TYPE_2D_MEMORY_CIRCULAR)
+                {
+                    NullLink_dumpCircularPrintStatistics(pObj);
+                }
+                if(pObj->createArgs.dumpDataType
+                        == NULL_LINK_COPY_TYPE_NETWORK)
+                {
+                    NullLink_networkTxPrintStatistics(pObj);
+                }
+                Utils_tskAckOrFreeMsg(pMsg, status);
+                break;
             default:
                 Utils_tskAckOrFreeMsg(pMsg, status);
                 break;
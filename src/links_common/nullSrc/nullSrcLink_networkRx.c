@@ -20,11 +20,73 @@
 
 #define NETWORK_RX_SERVER_POLL_TIMEOUT  (10)
 
+/* Allocate buffer for compressed frame of largest output channel */
+static Void NullSrcLink_networkRxCreateDecBuf(NullSrcLink_Obj *pObj)
+{
+    NullSrcLink_NetworkRxObj *pNetRxObj = &pObj->netRxObj;
+    System_LinkChInfo *pChInfo;
+    System_VideoDataFormat dataFormat;
+    UInt32 chId, size, payloadType;
+
+    pNetRxObj->decBuf = NULL;
+    pNetRxObj->decBufSize = 0;
+
+    for(chId=0; chId<pObj->createArgs.outQueInfo.numCh; chId++)
+    {
+        pChInfo = &pObj->createArgs.outQueInfo.chInfo[chId];
+
+        if(SYSTEM_LINK_CH_INFO_GET_FLAG_BUF_TYPE(pChInfo->flags)
+                != SYSTEM_BUFFER_TYPE_VIDEO_FRAME)
+        {
+            continue;
+        }
+
+        dataFormat = (System_VideoDataFormat)
+            SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(pChInfo->flags);
+
+        if(dataFormat == SYSTEM_DF_YUV420SP_UV)
+        {
+            payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV;
+        }
+        else
+        {
+            payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV;
+        }
+
+        size = NetworkCodec_getMaxSize(payloadType,
+                                       pChInfo->width,
+                                       pChInfo->height);
+
+        if(size > pNetRxObj->decBufSize)
+        {
+            pNetRxObj->decBufSize = size;
+        }
+    }
+
+    if(pNetRxObj->decBufSize)
+    {
+        pNetRxObj->decBufSize = SystemUtils_align(pNetRxObj->decBufSize, 128);
+
+        pNetRxObj->decBuf = Utils_memAlloc(
+                                UTILS_HEAPID_DDR_CACHED_SR,
+                                pNetRxObj->decBufSize,
+                                128);
+        UTILS_assert(pNetRxObj->decBuf!=NULL);
+    }
+}
+
 Int32 NullSrcLink_networkRxCreate(NullSrcLink_Obj *pObj)
 {
     NullSrcLink_NetworkRxObj *pNetRxObj = &pObj->netRxObj;
     Int32 status;
 
+    memset(pNetRxObj, 0, sizeof(*pNetRxObj));
+
+    if(pObj->createArgs.networkRxDecompress)
+    {
+        NullSrcLink_networkRxCreateDecBuf(pObj);
+    }
+
     Network_sessionOpen(NULL);
 
     status = Network_open(
@@ -51,6 +113,14 @@ Int32 NullSrcLink_networkRxDelete(NullSrcLink_Obj *pObj)
 
     Network_sessionClose(NULL);
 
+    if(pNetRxObj->decBuf)
+    {
+        Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR,
+                      pNetRxObj->decBuf,
+                      pNetRxObj->decBufSize);
+        pNetRxObj->decBuf = NULL;
+    }
+
     pNetRxObj->state = NETWORK_RX_SERVER_CLOSED;
 
     Vps_printf(" NULL_SRC: NETWORK_RX: Server Closed (port=%d) !!!\n",
@@ -211,6 +281,134 @@ Int32 NullSrcLink_networkRxReadPayload(NullSrcLink_Obj *pObj,
     return status;
 }
 
+/* Read compressed frame to decBuf and decompress into the video frame */
+static Int32 NullSrcLink_networkRxReadCompressed(NullSrcLink_Obj *pObj,
+                        NullSrcLink_NetworkRxObj *pNetRxObj,
+                        NetworkRx_CmdHeader *pHeader,
+                        UInt32 payloadType,
+                        System_VideoFrameBuffer *videoFrame)
+{
+    Int32 status;
+    UInt8 *dataAddr[1];
+    UInt32 dataSize[1];
+    UInt8 *dstAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 dstPitch[NETWORK_CODEC_MAX_PLANES];
+    UInt32 numPlanes, i, planeSize;
+    UInt64 startTime;
+
+    if(pNetRxObj->decBuf==NULL || pHeader->dataSize > pNetRxObj->decBufSize)
+    {
+        /* payload cannot be read, so stream is out of sync */
+        Vps_printf(" NULL_SRC: NETWORK_RX: Compressed frame of %d bytes not"
+                   " supported, enable networkRxDecompress (port=%d)!!!\n",
+                    pHeader->dataSize,
+                    pObj->createArgs.networkServerPort
+                   );
+        Network_close(&pNetRxObj->sockObj, FALSE);
+        pNetRxObj->state = NETWORK_RX_SERVER_LISTEN;
+
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    dataAddr[0] = pNetRxObj->decBuf;
+    dataSize[0] = pHeader->dataSize;
+
+    status = NullSrcLink_networkRxReadPayload(
+                        pObj, pNetRxObj, 1, dataAddr, dataSize);
+    if(status!=SYSTEM_LINK_STATUS_SOK)
+    {
+        return status;
+    }
+
+    numPlanes = 1;
+    if(payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        numPlanes = 2;
+    }
+
+    for(i=0; i<numPlanes; i++)
+    {
+        dstAddr[i] = videoFrame->bufAddr[i];
+        dstPitch[i] = videoFrame->chInfo.pitch[i];
+    }
+
+    startTime = Utils_getCurGlobalTimeInUsec();
+
+    status = NetworkCodec_decode(
+                pNetRxObj->decBuf,
+                pHeader->dataSize,
+                payloadType,
+                videoFrame->chInfo.width,
+                videoFrame->chInfo.height,
+                dstAddr,
+                dstPitch);
+
+    pNetRxObj->decTime += Utils_getCurGlobalTimeInUsec() - startTime;
+
+    if(status!=SYSTEM_LINK_STATUS_SOK)
+    {
+        /* whole payload was read, so only this frame is dropped */
+        Vps_printf(" NULL_SRC: NETWORK_RX: Invalid compressed frame"
+                   " (port=%d)!!!\n",
+                    pObj->createArgs.networkServerPort
+                   );
+        return status;
+    }
+
+    for(i=0; i<numPlanes; i++)
+    {
+        planeSize = dstPitch[i]*videoFrame->chInfo.height;
+        if(i==1)
+        {
+            planeSize /= 2;
+        }
+
+        Cache_wb(
+                  (Ptr)SystemUtils_floor((UInt32)dstAddr[i], 128),
+                  SystemUtils_align(planeSize+128, 128),
+                  Cache_Type_ALLD,
+                  TRUE
+                );
+
+        pNetRxObj->rawBytes += planeSize;
+    }
+
+    pNetRxObj->decBytes += pHeader->dataSize;
+    pNetRxObj->decFrameCount++;
+
+    return status;
+}
+
+Int32 NullSrcLink_networkRxPrintStatistics(NullSrcLink_Obj *pObj)
+{
+    NullSrcLink_NetworkRxObj *pNetRxObj = &pObj->netRxObj;
+    UInt32 ratio = 0, decRate = 0;
+
+    if(pNetRxObj->decBuf==NULL)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    if(pNetRxObj->decBytes)
+    {
+        /* x100 */
+        ratio = (UInt32)((pNetRxObj->rawBytes*100)/pNetRxObj->decBytes);
+    }
+    if(pNetRxObj->decTime)
+    {
+        /* bytes per usec is MB/s */
+        decRate = (UInt32)(pNetRxObj->rawBytes/pNetRxObj->decTime);
+    }
+
+    Vps_printf(" [NULL_SRC] Network RX decompressed frames = %d,"
+               " ratio = %d.%02d, decompression rate = %d MB/s\n",
+               pNetRxObj->decFrameCount,
+               ratio/100, ratio%100,
+               decRate);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
 Int32 NullSrcLink_networkRxFillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                             System_Buffer *pBuffer)
 {
@@ -225,7 +423,7 @@ Int32 NullSrcLink_networkRxFillData(NullSrcLink_Obj * pObj, UInt32 channelId,
     if(pNetRxObj->state == NETWORK_RX_SERVER_CONNECTED)
     {
         NetworkRx_CmdHeader cmdHeader;
-        UInt32 bufSize;
+        UInt32 bufSize, reqPayloadType;
 
         memset(&cmdHeader, 0, sizeof(cmdHeader));
 
@@ -289,8 +487,21 @@ Int32 NullSrcLink_networkRxFillData(NullSrcLink_Obj * pObj, UInt32 channelId,
         }
         if(status==SYSTEM_LINK_STATUS_SOK)
         {
+            reqPayloadType = cmdHeader.payloadType;
+
             status = NullSrcLink_networkRxReadHeader(pObj, pNetRxObj, &cmdHeader);
         }
+        if(status==SYSTEM_LINK_STATUS_SOK
+            &&
+           pBuffer->bufType==SYSTEM_BUFFER_TYPE_VIDEO_FRAME
+            &&
+           cmdHeader.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED)
+        {
+            status = NullSrcLink_networkRxReadCompressed(
+                        pObj, pNetRxObj, &cmdHeader, reqPayloadType,
+                        videoFrame);
+        }
+        else
         if(status==SYSTEM_LINK_STATUS_SOK)
         {
             UInt32 numBuf;
@@ -313,7 +524,7 @@ Int32 NullSrcLink_networkRxFillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                     {
                         numBuf = 1;
                         dataAddr[0] = videoFrame->bufAddr[0];
-                        dataSize[0] = cmdHeader.pitch[0]*cmdHeader.height*2;
+                        dataSize[0] = cmdHeader.pitch[0]*cmdHeader.height;
                         UTILS_assert( dataSize[0] == cmdHeader.dataSize );
                     }
                     else
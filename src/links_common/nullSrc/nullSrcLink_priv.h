@@ -44,6 +44,7 @@ extern "C" {
 #include <src/links_ipu/system/system_priv_ipu1_0.h>
 #include <include/link_api/nullSrcLink.h>
 #include <src/utils_common/include/network_api.h>
+#include <src/utils_common/include/network_codec.h>
 
 /******************************************************************************
  *  Defines
@@ -82,8 +83,52 @@ typedef struct {
     UInt32 state;
     /**< State of server socket */
 
+    UInt8 *decBuf;
+    /**< Compressed frame, allocated only when networkRxDecompress is TRUE */
+
+    UInt32 decBufSize;
+
+    UInt32 decFrameCount;
+    /**< Frames decompressed */
+
+    UInt64 rawBytes;
+    /**< Size of frames after decompression */
+
+    UInt64 decBytes;
+    /**< Size of compressed frames */
+
+    UInt64 decTime;
+    /**< Time taken by decompression, in usecs */
+
 } NullSrcLink_NetworkRxObj;
 
+/**
+ ******************************************************************************
+ *
+ * \brief Structure to hold file read state of a channel
+ *
+ ******************************************************************************
+ */
+typedef struct {
+
+    UInt32 *pFrameSize;
+    /**< Frame sizes in bytes, parsed from index file at create */
+
+    UInt32 numFrames;
+    /**< Number of frames in index file */
+
+    UInt32 curFrame;
+    /**< Next frame to read */
+
+    UInt8 *pReadBuf;
+    /**< Used to read a full plane when plane is not contiguous in the
+     *   output buffer, NULL when not needed */
+
+    UInt32 readBufSize;
+    /**< Size of pReadBuf in bytes */
+
+} NullSrcLink_FileReadObj;
+
 /**
  ******************************************************************************
  *
@@ -136,10 +181,15 @@ typedef struct {
     FILE *fpDataStream[NULL_SRC_LINK_MAX_CH];
     /**< Binary File containing the stream data.*/
 
-    FILE *fpIndexFile[NULL_SRC_LINK_MAX_CH];
-    /**< File used to index into fpDataStream.
-    * It will contain frame sizes in bytes.
-    */
+    NullSrcLink_FileReadObj fileRead[NULL_SRC_LINK_MAX_CH];
+    /**< File read state of each channel */
+
+    UInt64 fileReadBytes;
+    /**< Bytes read from data files since last statistics print */
+
+    UInt64 fileReadTime;
+    /**< Time spent in reading data files since last statistics print,
+     *   in usecs */
 
     System_LinkStatistics   *linkStatsInfo;
     /**< Pointer to the Link statistics information,
@@ -164,6 +214,7 @@ typedef struct {
 
 Int32 NullSrcLink_networkRxCreate(NullSrcLink_Obj *pObj);
 Int32 NullSrcLink_networkRxDelete(NullSrcLink_Obj *pObj);
+Int32 NullSrcLink_networkRxPrintStatistics(NullSrcLink_Obj *pObj);
 Int32 NullSrcLink_networkRxFillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                             System_Buffer *pBuffer);
 
@@ -67,11 +67,214 @@ Void NullSrcLink_timerCallback(UArg arg)
     pObj->linkStatsInfo->linkStats.notifyEventCount++;
 }
 
+/**
+ ******************************************************************************
+ * \brief Open data file and parse index file of a channel
+ *
+ * Index file is read with a single fread() and all frame sizes are kept in
+ * memory, so that the index file is not accessed while running. A read
+ * buffer is allocated when a plane is not contiguous in the output buffer,
+ * so that a plane is read with a single fread() in all cases.
+ *
+ * \param  pObj [IN] NullSrcLink_Obj
+ * \param  chId [IN] Channel ID
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK on success
+ *
+ ******************************************************************************
+*/
+static Int32 NullSrcLink_fileReadCreate(NullSrcLink_Obj * pObj, UInt32 chId)
+{
+    NullSrcLink_FileReadObj *pFileRead = &pObj->fileRead[chId];
+    NullSrcLink_ChannelSpecificParams *pChPrm =
+                            &pObj->createArgs.channelParams[chId];
+    System_LinkChInfo *pChInfo = &pObj->createArgs.outQueInfo.chInfo[chId];
+    System_VideoDataFormat dataFormat;
+    FILE *fpIndexFile;
+    char *pIndex, *pCur, *pEnd;
+    UInt32 indexFileSize, indexSize, frameSize, numFrames, pass;
+    Int32 size;
+
+    UTILS_assert(*pChPrm->nameDataFile != '\0' &&
+                    *pChPrm->nameIndexFile!= '\0');
+
+    pObj->fpDataStream[chId] = fopen(pChPrm->nameDataFile, "rb");
+    UTILS_assert(pObj->fpDataStream[chId] != NULL);
+
+    fpIndexFile = fopen(pChPrm->nameIndexFile, "r");
+    UTILS_assert(fpIndexFile != NULL);
+
+    fseek(fpIndexFile, 0, SEEK_END);
+    size = ftell(fpIndexFile);
+    fseek(fpIndexFile, 0, SEEK_SET);
+    UTILS_assert(size > 0);
+
+    indexFileSize = (UInt32)size + 1U;
+    pIndex = Utils_memAlloc(UTILS_HEAPID_DDR_CACHED_SR, indexFileSize, 32);
+    UTILS_assert(pIndex != NULL);
+
+    indexSize = fread(pIndex, 1, (UInt32)size, fpIndexFile);
+    pIndex[indexSize] = '\0';
+
+    fclose(fpIndexFile);
+
+    /* first pass counts frames, second pass stores frame sizes */
+    numFrames = 0;
+    for(pass = 0; pass < 2; pass++)
+    {
+        numFrames = 0;
+        pCur = pIndex;
+        while(1)
+        {
+            frameSize = strtoul(pCur, &pEnd, 10);
+            if(pEnd == pCur)
+                break;
+
+            if(pass == 1)
+                pFileRead->pFrameSize[numFrames] = frameSize;
+
+            numFrames++;
+            pCur = pEnd;
+        }
+
+        if(pass == 0)
+        {
+            UTILS_assert(numFrames > 0);
+
+            pFileRead->pFrameSize = Utils_memAlloc(UTILS_HEAPID_DDR_CACHED_SR,
+                                        numFrames*sizeof(UInt32), 32);
+            UTILS_assert(pFileRead->pFrameSize != NULL);
+        }
+    }
+
+    Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR, pIndex, indexFileSize);
+
+    pFileRead->numFrames = numFrames;
+    pFileRead->curFrame = 0;
+
+    pFileRead->pReadBuf = NULL;
+    pFileRead->readBufSize = 0;
+
+    if(SYSTEM_LINK_CH_INFO_GET_FLAG_BUF_TYPE(pChInfo->flags)
+            == SYSTEM_BUFFER_TYPE_VIDEO_FRAME)
+    {
+        dataFormat = (System_VideoDataFormat)
+            SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(pChInfo->flags);
+
+        if(dataFormat == SYSTEM_DF_YUV420SP_UV)
+        {
+            if(pChInfo->pitch[0] != pChInfo->width
+                || pChInfo->pitch[1] != pChInfo->width)
+            {
+                pFileRead->readBufSize = pChInfo->width*pChInfo->height;
+            }
+        }
+        else
+        if(dataFormat == SYSTEM_DF_YUV422I_YUYV)
+        {
+            if(pChInfo->pitch[0] != pChInfo->width*2)
+            {
+                pFileRead->readBufSize = pChInfo->width*2*pChInfo->height;
+            }
+        }
+    }
+
+    if(pFileRead->readBufSize)
+    {
+        pFileRead->pReadBuf = Utils_memAlloc(UTILS_HEAPID_DDR_CACHED_SR,
+                                    pFileRead->readBufSize, 32);
+        UTILS_assert(pFileRead->pReadBuf != NULL);
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ ******************************************************************************
+ * \brief Close data file and free memory allocated for file read of a channel
+ *
+ * \param  pObj [IN] NullSrcLink_Obj
+ * \param  chId [IN] Channel ID
+ *
+ ******************************************************************************
+*/
+static Void NullSrcLink_fileReadDelete(NullSrcLink_Obj * pObj, UInt32 chId)
+{
+    NullSrcLink_FileReadObj *pFileRead = &pObj->fileRead[chId];
+
+    if(pObj->fpDataStream[chId])
+    {
+        fclose(pObj->fpDataStream[chId]);
+        pObj->fpDataStream[chId] = NULL;
+    }
+
+    if(pFileRead->pFrameSize)
+    {
+        Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR, pFileRead->pFrameSize,
+                      pFileRead->numFrames*sizeof(UInt32));
+        pFileRead->pFrameSize = NULL;
+    }
+
+    if(pFileRead->pReadBuf)
+    {
+        Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR, pFileRead->pReadBuf,
+                      pFileRead->readBufSize);
+        pFileRead->pReadBuf = NULL;
+    }
+}
+
+/**
+ ******************************************************************************
+ * \brief Read a plane from data file with a single fread()
+ *
+ * When lines are not contiguous in the output buffer the plane is read into
+ * the channel read buffer and then copied line by line.
+ *
+ * \param  pObj      [IN] NullSrcLink_Obj
+ * \param  chId      [IN] Channel ID
+ * \param  pDst      [IN] Start of plane in output buffer
+ * \param  lineSize  [IN] Bytes in a line
+ * \param  numLines  [IN] Lines in plane
+ * \param  pitch     [IN] Pitch of plane in output buffer
+ *
+ * \return  Number of bytes read from file
+ *
+ ******************************************************************************
+*/
+static UInt32 NullSrcLink_fileReadPlane(NullSrcLink_Obj * pObj, UInt32 chId,
+                            UInt8 *pDst, UInt32 lineSize, UInt32 numLines,
+                            UInt32 pitch)
+{
+    NullSrcLink_FileReadObj *pFileRead = &pObj->fileRead[chId];
+    UInt32 bytesRead, i;
+
+    if(pitch == lineSize)
+    {
+        return fread(pDst, 1, lineSize*numLines, pObj->fpDataStream[chId]);
+    }
+
+    UTILS_assert(pFileRead->pReadBuf != NULL);
+    UTILS_assert(lineSize*numLines <= pFileRead->readBufSize);
+
+    bytesRead = fread(pFileRead->pReadBuf, 1, lineSize*numLines,
+                      pObj->fpDataStream[chId]);
+
+    for(i = 0; i < numLines; i++)
+    {
+        memcpy(pDst + i*pitch, pFileRead->pReadBuf + i*lineSize, lineSize);
+    }
+
+    return bytesRead;
+}
+
 /**
  ******************************************************************************
  * \brief This function is called to fill data from file into System Buffer
  * It is used when file read option is enabled for debugging with CCS.
  *
+ * Each plane is read with a single fread(), since every file access goes
+ * to the host over the debugger.
+ *
  * \param  pObj [IN] NullSrcLink_Obj
  * \param  channelId [IN] Channel ID for which Fill data is called
  * \param  pBuffer [IN] System Buffer in which data has to be filled
@@ -82,18 +285,24 @@ Void NullSrcLink_timerCallback(UArg arg)
 Int32 NullSrcLink_fillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                             System_Buffer *pBuffer)
 {
-    UInt32  frameLength = 0, bufSize=0, i;
+    UInt32  frameLength = 0, bufSize=0, bytesRead = 0;
+    UInt64  startTime;
     System_VideoDataFormat dataFormat;
     System_VideoFrameBuffer *videoFrame;
     System_BitstreamBuffer *bitstreamBuf;
-    Int8 *bufPtr = NULL;
+    NullSrcLink_FileReadObj *pFileRead = &pObj->fileRead[channelId];
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
 
     /*If end of file is reached return error*/
-    if(feof(pObj->fpDataStream[channelId]) ||feof(pObj->fpIndexFile[channelId]))
+    if(feof(pObj->fpDataStream[channelId])
+        || pFileRead->curFrame >= pFileRead->numFrames)
         return SYSTEM_LINK_STATUS_ENO_MORE_BUFFERS;
 
-    /*Read length of current frame from Index file*/
-    fscanf(pObj->fpIndexFile[channelId], "%u", &frameLength);
+    /*Length of current frame from Index file*/
+    frameLength = pFileRead->pFrameSize[pFileRead->curFrame];
+    pFileRead->curFrame++;
+
+    startTime = Utils_getCurGlobalTimeInUsec();
 
     switch(pBuffer->bufType)
     {
@@ -106,6 +315,7 @@ Int32 NullSrcLink_fillData(NullSrcLink_Obj * pObj, UInt32 channelId,
             UTILS_assert(frameLength < bitstreamBuf->bufSize);
             bitstreamBuf->fillLength = fread(bitstreamBuf->bufAddr, 1,
                                     frameLength, pObj->fpDataStream[channelId]);
+            bytesRead = bitstreamBuf->fillLength;
             break;
 
         case SYSTEM_BUFFER_TYPE_VIDEO_FRAME:
@@ -123,21 +333,17 @@ Int32 NullSrcLink_fillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                 /*For YUV420sp data filedata needs to be read into 2 buffers
                 *corresponding to Y plane and UV plane.
                 */
-                bufPtr = videoFrame->bufAddr[0];
-                for(i = 0; i < videoFrame->chInfo.height; i++)
-                {
-                    fread(bufPtr, 1, videoFrame->chInfo.width,
-                         pObj->fpDataStream[channelId]);
-                    bufPtr += videoFrame->chInfo.pitch[0];
-                }
-
-                bufPtr = videoFrame->bufAddr[1];
-                for(i = 0; i < videoFrame->chInfo.height/2; i++)
-                {
-                    fread(bufPtr, 1, videoFrame->chInfo.width,
-                         pObj->fpDataStream[channelId]);
-                    bufPtr += videoFrame->chInfo.pitch[1];
-                }
+                bytesRead = NullSrcLink_fileReadPlane(pObj, channelId,
+                                videoFrame->bufAddr[0],
+                                videoFrame->chInfo.width,
+                                videoFrame->chInfo.height,
+                                videoFrame->chInfo.pitch[0]);
+
+                bytesRead += NullSrcLink_fileReadPlane(pObj, channelId,
+                                videoFrame->bufAddr[1],
+                                videoFrame->chInfo.width,
+                                videoFrame->chInfo.height/2,
+                                videoFrame->chInfo.pitch[1]);
             }
             else
             {
@@ -147,26 +353,27 @@ Int32 NullSrcLink_fillData(NullSrcLink_Obj * pObj, UInt32 channelId,
                         videoFrame->chInfo.pitch[0]*videoFrame->chInfo.height;
                     UTILS_assert(frameLength <= bufSize);
 
-                    bufPtr = videoFrame->bufAddr[0];
-                    for(i = 0; i < videoFrame->chInfo.height; i++)
-                    {
-                        fread(bufPtr, 1, videoFrame->chInfo.width*2,
-                            pObj->fpDataStream[channelId]);
-                        bufPtr += videoFrame->chInfo.pitch[0];
-                    }
+                    bytesRead = NullSrcLink_fileReadPlane(pObj, channelId,
+                                    videoFrame->bufAddr[0],
+                                    videoFrame->chInfo.width*2,
+                                    videoFrame->chInfo.height,
+                                    videoFrame->chInfo.pitch[0]);
                 }
                 else
-                    return SYSTEM_LINK_STATUS_EFAIL;
+                    status = SYSTEM_LINK_STATUS_EFAIL;
             }
             break;
 
         default:
             /*return error for unsupported format*/
-            return SYSTEM_LINK_STATUS_EFAIL;
-
+            status = SYSTEM_LINK_STATUS_EFAIL;
+            break;
     }
 
-    return SYSTEM_LINK_STATUS_SOK;
+    pObj->fileReadTime += Utils_getCurGlobalTimeInUsec() - startTime;
+    pObj->fileReadBytes += bytesRead;
+
+    return status;
 }
 
 /**
@@ -869,6 +1076,11 @@ Int32 NullSrcLink_create(NullSrcLink_Obj * pObj,
     */
     memcpy(&pObj->createArgs, pPrm, sizeof(pObj->createArgs));
 
+    memset(pObj->fpDataStream, 0, sizeof(pObj->fpDataStream));
+    memset(pObj->fileRead, 0, sizeof(pObj->fileRead));
+    pObj->fileReadBytes = 0;
+    pObj->fileReadTime = 0;
+
     status = Utils_queCreate(&pObj->fullOutBufQue,
          NULL_SRC_LINK_MAX_OUT_BUFFERS,
          pObj->pBufferOnFullQ,
@@ -898,16 +1110,8 @@ Int32 NullSrcLink_create(NullSrcLink_Obj * pObj,
             if(pPrm->channelParams[chId].fileReadMode!=
                         NULLSRC_LINK_FILEREAD_DISABLE)
             {
-                UTILS_assert(*pPrm->channelParams[chId].nameDataFile != '\0' &&
-                                *pPrm->channelParams[chId].nameIndexFile!= '\0');
-
-                pObj->fpDataStream[chId] =
-                                fopen(pPrm->channelParams[chId].nameDataFile, "rb");
-                UTILS_assert(pObj->fpDataStream[chId] != NULL);
-
-                pObj->fpIndexFile[chId] =
-                                fopen(pPrm->channelParams[chId].nameIndexFile, "r");
-                UTILS_assert(pObj->fpIndexFile[chId] != NULL);
+                status = NullSrcLink_fileReadCreate(pObj, chId);
+                UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
             }
         }
         UTILS_assert(pPrm->channelParams[chId].numBuffers<=
@@ -1052,10 +1256,10 @@ Int32 NullSrcLink_delete(NullSrcLink_Obj * pObj)
     if(pObj->createArgs.dataRxMode
         == NULLSRC_LINK_DATA_RX_MODE_FILE)
     {
-        if(pObj->fpDataStream[chId])
-            fclose(pObj->fpDataStream[chId]);
-        if(pObj->fpIndexFile[chId])
-            fclose(pObj->fpIndexFile[chId]);
+        for (chId = 0; chId < pObj->linkInfo.queInfo[queId].numCh; chId++)
+        {
+            NullSrcLink_fileReadDelete(pObj, chId);
+        }
     }
 
     return SYSTEM_LINK_STATUS_SOK;
@@ -1074,7 +1278,26 @@ Int32 NullSrcLink_delete(NullSrcLink_Obj * pObj)
  */
 Int32 NullSrcLink_printLinkStats(NullSrcLink_Obj * pObj)
 {
+    UInt32 readTimeMs;
+
     Utils_printLinkStatistics(&pObj->linkStatsInfo->linkStats, "NULL_SRC", TRUE);
+
+    if(pObj->fileReadBytes)
+    {
+        readTimeMs = (UInt32)(pObj->fileReadTime/1000U);
+        if(readTimeMs==0)
+            readTimeMs = 1;
+
+        Vps_printf(" [NULL_SRC] File read = %d KB in %d ms, %d KB/s\n",
+                   (UInt32)(pObj->fileReadBytes/1024U),
+                   readTimeMs,
+                   (UInt32)((pObj->fileReadBytes*1000U/1024U)/readTimeMs));
+        Vps_printf(" \n");
+    }
+
+    pObj->fileReadBytes = 0;
+    pObj->fileReadTime = 0;
+
     return SYSTEM_LINK_STATUS_SOK;
 }
 
@@ -1221,6 +1444,11 @@ Int32 NullSrcLink_tskRun(NullSrcLink_Obj * pObj, Utils_TskHndl * pTsk,
             case SYSTEM_CMD_PRINT_STATISTICS:
                 /* print the null source link statistics*/
                 NullSrcLink_printLinkStats(pObj);
+                if(pObj->createArgs.dataRxMode
+                    == NULLSRC_LINK_DATA_RX_MODE_NETWORK)
+                {
+                    NullSrcLink_networkRxPrintStatistics(pObj);
+                }
                 /* ACK or free message before proceding */
                 Utils_tskAckOrFreeMsg(pRunMsg, status);
                 break;
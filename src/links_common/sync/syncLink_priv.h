@@ -69,7 +69,32 @@
  * \brief Max number of elemtns in sync link local queue
  *******************************************************************************
  */
-#define SYNC_LINK_LOCAL_QUE_MAX_ELEMENTS        (10)
+#define SYNC_LINK_LOCAL_QUE_MAX_ELEMENTS        (SYNC_LINK_LOCAL_QUE_MAX_DEPTH)
+
+/**
+ *******************************************************************************
+ * \brief Link CMD sent by the sync link timer. Timer ticks only age the local
+ *         queues, matching is done when new data is received.
+ *******************************************************************************
+ */
+#define SYNC_LINK_CMD_TIMER_TICK                (0x6100)
+
+/**
+ *******************************************************************************
+ * \brief Auto selected master channel is changed only when another channel
+ *         has received these many buffers less than the current master
+ *******************************************************************************
+ */
+#define SYNC_LINK_AUTO_MASTER_HYSTERESIS        (4)
+
+/**
+ *******************************************************************************
+ * \brief Result of one matching step
+ *******************************************************************************
+ */
+#define SYNC_LINK_MATCH_WAIT                    (0)
+#define SYNC_LINK_MATCH_FOUND                   (1)
+#define SYNC_LINK_MATCH_DROPPED                 (2)
 
 /**
  *******************************************************************************
@@ -109,10 +134,21 @@
  *******************************************************************************
  */
 typedef struct {
-    Utils_QueHandle    localQueHandle;
-    /**< Handle to the queue for this channel */
     System_Buffer      *queMem[SYNC_LINK_LOCAL_QUE_MAX_ELEMENTS];
-    /**< Queue memory */
+    /**< Buffers held for this channel, ordered by srcTimestamp, oldest
+         first */
+    UInt32             queCount;
+    /**< Number of valid buffers in queMem */
+    UInt32             queDepth;
+    /**< Max buffers held for this channel */
+    UInt32             recvCount;
+    /**< Buffers received in this channel, reset when statistics are
+         printed */
+    UInt32             masterRecvCount;
+    /**< Buffers received in this channel since create, used to select the
+         master channel automatically. Not reset by statistics print */
+    UInt32             dropCountQueFull;
+    /**< Buffers dropped in this channel because its queue was full */
     UInt32             dropCountNoSync;
     /**< Buffers dropped in this channel because this channel is out of sync */
     UInt32             dropCountNoBuffers;
@@ -170,6 +206,18 @@ typedef struct
     UInt32 syncDeltaCount;
     /**< Used with totalSyncDelta to find avergae sync delta */
 
+    UInt32 setCount;
+    /**< Composite buffers sent out */
+    UInt32 partialSetCount;
+    /**< Composite buffers sent out with one or more channels missing */
+    UInt32 matchCallCount;
+    /**< Number of times matching was run */
+    UInt64 totalAddedLatency;
+    /**< Total of time in usecs from arrival of the oldest buffer of a set
+         to the set being sent out */
+    UInt32 maxAddedLatency;
+    /**< Max of above in usecs */
+
 } SyncLink_BufferStats;
 
 /**
@@ -246,6 +294,14 @@ typedef struct {
     /**< Current master timestamp, which may be the average of all timestamps
          of buffers in the channel or master channel timestamp */
 
+    UInt32 masterCh;
+    /**< Master channel used by SYNC_LINK_POLICY_NEAREST_TO_MASTER and
+         SYNC_LINK_POLICY_PARTIAL_SET */
+
+    UInt32 selectMask;
+    /**< Channels whose oldest buffer is part of the selected set, bit per
+         channel */
+
     SyncLink_ChDecisionParams chDecParams[SYNC_LINK_MAX_CHANNELS];
     /**< Structure which holds decision to retain or drop frame when
          buffers go out of sync */
@@ -283,6 +339,8 @@ Void SyncLink_tskMain(struct Utils_TskHndl * pTsk, Utils_MsgHndl * pMsg);
 
 Int32 SyncLink_tskCreate(UInt32 instId);
 
+Void SyncLink_dropBuffers(SyncLink_Obj * pObj);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -62,7 +62,7 @@ Void SyncLink_timerCallback(UArg arg)
 {
     SyncLink_Obj *pObj = (SyncLink_Obj *) arg;
 
-    Utils_tskSendCmd(&pObj->tsk, SYSTEM_CMD_NEW_DATA, NULL);
+    Utils_tskSendCmd(&pObj->tsk, SYNC_LINK_CMD_TIMER_TICK, NULL);
 
     pObj->linkStatsInfo->linkStats.notifyEventCount++;
 }
@@ -114,23 +114,56 @@ Int32 SyncLink_drvCreate(SyncLink_Obj * pObj, SyncLink_CreateParams *pPrm)
            pObj->prevLinkInfo.queInfo
                   [pObj->createArgs.inQueParams.prevLinkQueId].numCh;
     UTILS_assert(pObj->createArgs.chParams.numCh <= SYNC_LINK_MAX_CHANNELS);
+    UTILS_assert(pObj->createArgs.syncPolicy <= SYNC_LINK_POLICY_PARTIAL_SET);
+
+    if (pObj->createArgs.queDepth == 0)
+    {
+        pObj->createArgs.queDepth = SYNC_LINK_LOCAL_QUE_DEFAULT_DEPTH;
+    }
+    if (pObj->createArgs.queDepth > SYNC_LINK_LOCAL_QUE_MAX_ELEMENTS)
+    {
+        pObj->createArgs.queDepth = SYNC_LINK_LOCAL_QUE_MAX_ELEMENTS;
+    }
 
     /*
      *  Initialize each channel
     */
 
+    pObj->masterCh = SYNC_LINK_MAX_CHANNELS;
+
     for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
     {
         chObj = &pObj->chObj[chId];
         chObj->dropCountNoBuffers = 0;
         chObj->dropCountNoSync = 0;
+        chObj->dropCountQueFull = 0;
         chObj->forwardCount = 0;
+        chObj->recvCount = 0;
+        chObj->masterRecvCount = 0;
+        chObj->queCount = 0;
+        chObj->queDepth = pObj->createArgs.queDepth;
 
-        status = Utils_queCreate(&chObj->localQueHandle,
-                                  UTILS_ARRAYSIZE(chObj->queMem),
-                                  chObj->queMem,
-                                  UTILS_QUE_FLAG_NO_BLOCK_QUE);
-        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+        if (pObj->createArgs.chParams.channelSyncList[chId]
+            && (pObj->masterCh == SYNC_LINK_MAX_CHANNELS))
+        {
+            pObj->masterCh = chId;
+        }
+    }
+
+    if ((pObj->createArgs.syncPolicy == SYNC_LINK_POLICY_NEAREST_TO_MASTER)
+        || (pObj->createArgs.syncPolicy == SYNC_LINK_POLICY_PARTIAL_SET))
+    {
+        if (pObj->createArgs.masterCh != SYNC_LINK_MASTER_CH_AUTO)
+        {
+            UTILS_assert(pObj->createArgs.masterCh >= 0);
+            UTILS_assert(pObj->createArgs.masterCh <
+                                pObj->createArgs.chParams.numCh);
+            UTILS_assert(pObj->createArgs.chParams.channelSyncList
+                                [pObj->createArgs.masterCh]);
+
+            pObj->masterCh = (UInt32)pObj->createArgs.masterCh;
+        }
+        UTILS_assert(pObj->masterCh < pObj->createArgs.chParams.numCh);
     }
 
     /*
@@ -197,6 +230,198 @@ Int32 SyncLink_drvCreate(SyncLink_Obj * pObj, SyncLink_CreateParams *pPrm)
     return SYSTEM_LINK_STATUS_SOK;
 }
 
+/**
+ *******************************************************************************
+ * \brief Returns buffer at position 'idx' in the local queue of a channel,
+ *        position 0 is the oldest buffer
+ *
+ * \param  chObj    [IN]  Channel object
+ * \param  idx      [IN]  Position in the queue
+ *
+ * \return Buffer, NULL if queue has less than idx+1 buffers
+ *
+ *******************************************************************************
+*/
+static System_Buffer *SyncLink_chQuePeek(SyncLink_ChObj *chObj, UInt32 idx)
+{
+    System_Buffer *pBuffer = NULL;
+
+    if (idx < chObj->queCount)
+    {
+        pBuffer = chObj->queMem[idx];
+    }
+
+    return pBuffer;
+}
+
+/**
+ *******************************************************************************
+ * \brief Removes the oldest buffer from the local queue of a channel
+ *
+ * \param  chObj    [IN]  Channel object
+ *
+ * \return Buffer, NULL if queue is empty
+ *
+ *******************************************************************************
+*/
+static System_Buffer *SyncLink_chQueGet(SyncLink_ChObj *chObj)
+{
+    System_Buffer *pBuffer = NULL;
+    UInt32 idx;
+
+    if (chObj->queCount)
+    {
+        pBuffer = chObj->queMem[0];
+        chObj->queCount--;
+
+        for (idx = 0; idx < chObj->queCount; idx++)
+        {
+            chObj->queMem[idx] = chObj->queMem[idx + 1];
+        }
+    }
+
+    return pBuffer;
+}
+
+/**
+ *******************************************************************************
+ * \brief Adds a buffer to the drop list and logs it in the drop statistics.
+ *        Drop list is given back to the previous link when it is full.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ * \param  pBuffer  [IN]  Buffer to drop
+ *
+ *******************************************************************************
+*/
+static Void SyncLink_addToDropList(SyncLink_Obj * pObj, System_Buffer *pBuffer)
+{
+    UInt32 index;
+
+    if (pObj->dropBufList.numBuf >= SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST)
+    {
+        SyncLink_dropBuffers(pObj);
+    }
+
+    pObj->dropBufList.buffers[pObj->dropBufList.numBuf] = pBuffer;
+    pObj->dropBufList.numBuf++;
+
+    pObj->linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
+
+    index = pObj->stats.totalDropCount % SYNC_LINK_MAX_DROP_BUFFER_STATS;
+
+    pObj->stats.dropStats[index].curTimestamp    =
+                                    Utils_getCurGlobalTimeInUsec()/1000;
+    pObj->stats.dropStats[index].masterTimestamp = pObj->masterTimeStamp;
+    pObj->stats.dropStats[index].bufferTimestamp = pBuffer->srcTimestamp/1000;
+    pObj->stats.dropStats[index].chNum           = pBuffer->chNum;
+    pObj->stats.totalDropCount++;
+}
+
+/**
+ *******************************************************************************
+ * \brief Inserts a buffer in the local queue of a channel in srcTimestamp
+ *        order. Oldest buffer is dropped when the queue is full.
+ *
+ *        Buffers of a channel normally arrive in order, so the position is
+ *        searched starting from the newest buffer.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ * \param  chObj    [IN]  Channel object
+ * \param  pBuffer  [IN]  Buffer to insert
+ *
+ *******************************************************************************
+*/
+static Void SyncLink_chQuePut(SyncLink_Obj * pObj,
+                              SyncLink_ChObj *chObj,
+                              System_Buffer *pBuffer)
+{
+    UInt32 idx;
+
+    if (chObj->queCount >= chObj->queDepth)
+    {
+        chObj->dropCountQueFull++;
+        SyncLink_addToDropList(pObj, SyncLink_chQueGet(chObj));
+    }
+
+    idx = chObj->queCount;
+    while ((idx > 0)
+        && (chObj->queMem[idx - 1]->srcTimestamp > pBuffer->srcTimestamp))
+    {
+        chObj->queMem[idx] = chObj->queMem[idx - 1];
+        idx--;
+    }
+
+    chObj->queMem[idx] = pBuffer;
+    chObj->queCount++;
+}
+
+/**
+ *******************************************************************************
+ * \brief Drops buffers of a channel which are older than the given timestamp
+ *
+ * \param  pObj      [IN]  Sync link instance handle
+ * \param  chId      [IN]  Channel number
+ * \param  timestamp [IN]  srcTimestamp in usecs
+ *
+ *******************************************************************************
+*/
+static Void SyncLink_dropOlderThan(SyncLink_Obj * pObj,
+                                   UInt32 chId,
+                                   UInt64 timestamp)
+{
+    SyncLink_ChObj *chObj = &pObj->chObj[chId];
+    System_Buffer *pBuffer;
+
+    pBuffer = SyncLink_chQuePeek(chObj, 0);
+    while ((pBuffer != NULL) && (pBuffer->srcTimestamp < timestamp))
+    {
+        chObj->dropCountNoSync++;
+        SyncLink_addToDropList(pObj, SyncLink_chQueGet(chObj));
+        pBuffer = SyncLink_chQuePeek(chObj, 0);
+    }
+}
+
+/**
+ *******************************************************************************
+ * \brief Finds the buffer of a channel whose srcTimestamp is nearest to the
+ *        reference timestamp
+ *
+ * \param  chObj    [IN]  Channel object
+ * \param  refTs    [IN]  Reference timestamp in usecs
+ * \param  pDiff    [OUT] Absolute difference from reference in usecs
+ *
+ * \return Position of buffer in queue, -1 if queue is empty
+ *
+ *******************************************************************************
+*/
+static Int32 SyncLink_chQueFindNearest(SyncLink_ChObj *chObj,
+                                       UInt64 refTs,
+                                       UInt64 *pDiff)
+{
+    Int32 nearestIdx = -1;
+    UInt32 idx;
+    UInt64 ts, diff;
+
+    for (idx = 0; idx < chObj->queCount; idx++)
+    {
+        ts = chObj->queMem[idx]->srcTimestamp;
+        diff = (ts > refTs) ? (ts - refTs) : (refTs - ts);
+
+        if ((nearestIdx < 0) || (diff < *pDiff))
+        {
+            nearestIdx = (Int32)idx;
+            *pDiff = diff;
+        }
+        if (ts >= refTs)
+        {
+            /* queue is in timestamp order, later buffers are farther */
+            break;
+        }
+    }
+
+    return nearestIdx;
+}
+
 /**
  *******************************************************************************
  * \brief This function updates previous timestamp for each active channel and
@@ -278,7 +503,7 @@ Int32 SyncLink_addBuffersToDropListLesserThanThreshold(SyncLink_Obj * pObj)
         for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
         {
             chObj = &pObj->chObj[chId];
-            Utils_quePeek(&chObj->localQueHandle, (Ptr *) &pBuffer);
+            pBuffer = SyncLink_chQuePeek(chObj, 0);
             if (chPrms->channelSyncList[chId])
             {
                  if ( pBuffer != NULL )
@@ -298,24 +523,15 @@ Int32 SyncLink_addBuffersToDropListLesserThanThreshold(SyncLink_Obj * pObj)
 
                         if (diffTime > chPrms->syncThreshold)
                         {
-                            Utils_queGet(&chObj->localQueHandle,
-                                         (Ptr *) &pBuffer,
-                                         1,
-                                         BSP_OSAL_NO_WAIT);
-                            pObj->dropBufList.buffers[pObj->dropBufList.numBuf] =
-                                                                           pBuffer;
-                            pObj->dropBufList.numBuf++;
                             index = pObj->stats.totalDropCount %
                                           SYNC_LINK_MAX_DROP_BUFFER_STATS;
 
+                            SyncLink_addToDropList(pObj,
+                                                   SyncLink_chQueGet(chObj));
+
+                            /* dropped on threshold, not against master */
                             pObj->stats.dropStats[index].masterTimestamp =
                                                        SYNC_LINK_INVALID_TIMESTAMP;
-                            pObj->stats.dropStats[index].bufferTimestamp =
-                                                         pBuffer->srcTimestamp/1000;
-                            pObj->stats.dropStats[index].chNum = chId;
-                            pObj->stats.totalDropCount++;
-
-                            pObj->linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
                             dropedBuffer = TRUE;
                         }
                     }
@@ -329,9 +545,7 @@ Int32 SyncLink_addBuffersToDropListLesserThanThreshold(SyncLink_Obj * pObj)
                */
                if ( pBuffer != NULL)
                {
-                   pObj->dropBufList.buffers[pObj->dropBufList.numBuf] = pBuffer;
-                   pObj->dropBufList.numBuf++;
-                   pObj->linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
+                   SyncLink_addToDropList(pObj, SyncLink_chQueGet(chObj));
                }
             }
         }
@@ -355,7 +569,7 @@ Int32 SyncLink_computeDecisionParams(SyncLink_Obj * pObj,
                                                    UInt32 *syncDone)
 {
     UInt32 higherTimeStamp, lowerTimeStamp, chId;
-    Int32 higherFlag, status;
+    Int32 higherFlag;
     SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
     SyncLink_ChDecisionParams *chDecParams = pObj->chDecParams;
     System_Buffer *pBuffer;
@@ -400,11 +614,8 @@ Int32 SyncLink_computeDecisionParams(SyncLink_Obj * pObj,
         {
             if (chPrms->channelSyncList[chId])
             {
-                status = Utils_quePeek(
-                                &pObj->chObj[chId].localQueHandle,
-                                (Ptr *) &pBuffer
-                                );
-                UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+                pBuffer = SyncLink_chQuePeek(&pObj->chObj[chId], 0);
+                UTILS_assert(pBuffer != NULL);
                 chDecParams[chId].flag = INRANGE(
                                                lowerTimeStamp,
                                                higherTimeStamp,
@@ -454,8 +665,7 @@ Int32 SyncLink_computeDecisionParams(SyncLink_Obj * pObj,
 */
 Int32 SyncLink_addBuffersToDropListNotInSync(SyncLink_Obj * pObj)
 {
-    UInt32 chId, index;
-    Int32 status;
+    UInt32 chId;
     SyncLink_ChDecisionParams *chDecParams = pObj->chDecParams;
     System_Buffer *pBuffer;
 
@@ -463,27 +673,10 @@ Int32 SyncLink_addBuffersToDropListNotInSync(SyncLink_Obj * pObj)
     {
         if (chDecParams[chId].drop == TRUE)
         {
-            status = Utils_queGet(&pObj->chObj[chId].localQueHandle,
-                                   (Ptr *) &pBuffer,
-                                   1,
-                                   BSP_OSAL_NO_WAIT);
-            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-            pObj->dropBufList.buffers[pObj->dropBufList.numBuf] = pBuffer;
-            pObj->dropBufList.numBuf++;
-
-            pObj->linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
-
-            index = pObj->stats.totalDropCount %
-                                  SYNC_LINK_MAX_DROP_BUFFER_STATS;
-
-            pObj->stats.dropStats[index].curTimestamp    =
-                Utils_getCurGlobalTimeInUsec()/1000;
-
-            pObj->stats.dropStats[index].masterTimestamp =
-                                                 pObj->masterTimeStamp;
-            pObj->stats.dropStats[index].bufferTimestamp =
-                                                 pBuffer->srcTimestamp/1000;
-            pObj->stats.totalDropCount++;
+            pBuffer = SyncLink_chQueGet(&pObj->chObj[chId]);
+            UTILS_assert(pBuffer != NULL);
+            pObj->chObj[chId].dropCountNoSync++;
+            SyncLink_addToDropList(pObj, pBuffer);
         }
     }
     return SYSTEM_LINK_STATUS_SOK;
@@ -492,22 +685,25 @@ Int32 SyncLink_addBuffersToDropListNotInSync(SyncLink_Obj * pObj)
 /**
  *******************************************************************************
  * \brief This function dequeus buffers from previous link and puts in local
- *        queues based on the channel number.
+ *        queues based on the channel number. Buffers are kept in timestamp
+ *        order within a channel.
  *
- * \param  pObj     [IN]  Sync link instance handle
+ * \param  pObj       [IN]  Sync link instance handle
+ * \param  numNewBufs [OUT] Number of buffers put in local queues
  *
  * \return status   SYSTEM_LINK_STATUS_SOK on success
  *
  *******************************************************************************
 */
-Int32 SyncLink_fillLocalQueues(SyncLink_Obj * pObj)
+Int32 SyncLink_fillLocalQueues(SyncLink_Obj * pObj, UInt32 *numNewBufs)
 {
     Int32 bufId;
     System_BufferList inputBufList;
     System_Buffer *pBuffer;
     System_LinkInQueParams *pInQueParams = &pObj->createArgs.inQueParams;
     SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
-    Int32 status;
+
+    *numNewBufs = 0;
 
     System_getLinksFullBuffers(pInQueParams->prevLinkId,
                                pInQueParams->prevLinkQueId,
@@ -530,16 +726,14 @@ Int32 SyncLink_fillLocalQueues(SyncLink_Obj * pObj)
 
         if (chPrms->channelSyncList[pBuffer->chNum])
         {
-            status = Utils_quePut(&pObj->chObj[pBuffer->chNum].localQueHandle,
-                         pBuffer, BSP_OSAL_NO_WAIT);
-            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+            pObj->chObj[pBuffer->chNum].recvCount++;
+            pObj->chObj[pBuffer->chNum].masterRecvCount++;
+            SyncLink_chQuePut(pObj, &pObj->chObj[pBuffer->chNum], pBuffer);
+            (*numNewBufs)++;
         }
         else
         {
-            pObj->dropBufList.buffers[pObj->dropBufList.numBuf] = pBuffer;
-            pObj->dropBufList.numBuf++;
-            pObj->linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
-            pObj->stats.totalDropCount++;
+            SyncLink_addToDropList(pObj, pBuffer);
         }
     }
     return SYSTEM_LINK_STATUS_SOK;
@@ -558,8 +752,9 @@ Int32 SyncLink_fillLocalQueues(SyncLink_Obj * pObj)
 */
 Int32 SyncLink_makeCompositeBuffer(SyncLink_Obj * pObj, System_Buffer *pSysBuf)
 {
-    Int32 status, i, syncDelta;
-    UInt32 chId, firstSyncCh;
+    Int32 i, syncDelta;
+    UInt32 chId, firstSyncCh, addedLatency;
+    UInt64 curTime, firstArrivalTime;
     System_Buffer *chBuf;
     System_VideoFrameCompositeBuffer *pSysCompBuf;
     SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
@@ -579,17 +774,40 @@ Int32 SyncLink_makeCompositeBuffer(SyncLink_Obj * pObj, System_Buffer *pSysBuf)
 
     firstSyncCh = TRUE;
 
+    curTime = Utils_getCurGlobalTimeInUsec();
+    firstArrivalTime = curTime;
+
     for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
     {
         if (chPrms->channelSyncList[chId])
         {
-            status = Utils_queGet(&pObj->chObj[chId].localQueHandle,
-                                   (Ptr *) &chBuf,
-                                   1,
-                                   BSP_OSAL_NO_WAIT);
-            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+            if ((pObj->selectMask & ((UInt32)1U << chId)) == 0U)
+            {
+                /*
+                 * Channel is missing from a partial set, blank frame is
+                 * sent in its place
+                 */
+                for (i=0; i < SYSTEM_MAX_PLANES; i++)
+                {
+                    pSysCompBuf->bufAddr[i][pSysCompBuf->numFrames] =
+                                                            pObj->dummyBuf[i];
+                }
+                pSysCompBuf->metaBufAddr[pSysCompBuf->numFrames] = NULL;
+                pSysCompBuf->numFrames++;
+                pObj->latestSyncDelta.bufferTimestamp[chId] =
+                                                SYNC_LINK_INVALID_TIMESTAMP;
+                continue;
+            }
+
+            chBuf = SyncLink_chQueGet(&pObj->chObj[chId]);
             UTILS_assert(chBuf != NULL);
 
+            pObj->chObj[chId].forwardCount++;
+            if (chBuf->linkLocalTimestamp < firstArrivalTime)
+            {
+                firstArrivalTime = chBuf->linkLocalTimestamp;
+            }
+
             pObj->linkStatsInfo->linkStats.chStats[chBuf->chNum].inBufProcessCount++;
 
             if(chBuf->bufType==SYSTEM_BUFFER_TYPE_VIDEO_FRAME)
@@ -678,6 +896,16 @@ Int32 SyncLink_makeCompositeBuffer(SyncLink_Obj * pObj, System_Buffer *pSysBuf)
 
     pObj->latestSyncDelta.masterTimestamp = pObj->masterTimeStamp;
 
+    /* time the set waited for its last buffer */
+    addedLatency = (UInt32)(curTime - firstArrivalTime);
+
+    pObj->stats.setCount++;
+    pObj->stats.totalAddedLatency += addedLatency;
+    if (addedLatency > pObj->stats.maxAddedLatency)
+    {
+        pObj->stats.maxAddedLatency = addedLatency;
+    }
+
     return SYSTEM_LINK_STATUS_SOK;
 }
 
@@ -732,10 +960,7 @@ Int32 SyncLink_computeMasterTimeStamp(SyncLink_Obj * pObj)
     {
         if (chPrms->channelSyncList[chId])
         {
-             Utils_quePeek(
-                            &pObj->chObj[chId].localQueHandle,
-                            (Ptr *) &pBuffer
-                          );
+            pBuffer = SyncLink_chQuePeek(&pObj->chObj[chId], 0);
             if (pBuffer)
             {
                 chTimeStamps[chId] = pBuffer->srcTimestamp/1000;
@@ -772,17 +997,417 @@ Int32 SyncLink_computeMasterTimeStamp(SyncLink_Obj * pObj)
     return FALSE;
 }
 
+/**
+ *******************************************************************************
+ * \brief SYNC_LINK_POLICY_HEAD_AVERAGE matching. Oldest buffers of all
+ *        channels are checked against the average of their timestamps.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ *
+ * \return SYNC_LINK_MATCH_xxx
+ *
+ *******************************************************************************
+*/
+static Int32 SyncLink_matchHeadAverage(SyncLink_Obj * pObj)
+{
+    UInt32 syncDone, chId;
+    Int32 localQueEmptyFlag;
+    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+
+    localQueEmptyFlag = SyncLink_computeMasterTimeStamp(pObj);
+
+    if (localQueEmptyFlag)
+    {
+        return SYNC_LINK_MATCH_WAIT;
+    }
+
+    syncDone = TRUE;
+    SyncLink_computeDecisionParams(pObj, &syncDone);
+
+    if (syncDone == FALSE)
+    {
+        SyncLink_addBuffersToDropListNotInSync(pObj);
+        return SYNC_LINK_MATCH_DROPPED;
+    }
+
+    pObj->selectMask = 0;
+    for (chId = 0; chId < chPrms->numCh; chId++)
+    {
+        if (chPrms->channelSyncList[chId])
+        {
+            pObj->selectMask |= ((UInt32)1U << chId);
+        }
+    }
+
+    return SYNC_LINK_MATCH_FOUND;
+}
+
+/**
+ *******************************************************************************
+ * \brief Returns the master channel. With SYNC_LINK_MASTER_CH_AUTO this is
+ *        the active channel which receives the least buffers, so that a
+ *        buffer of every other channel is available for each master buffer.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ *
+ * \return Master channel number
+ *
+ *******************************************************************************
+*/
+static UInt32 SyncLink_getMasterCh(SyncLink_Obj * pObj)
+{
+    UInt32 chId, minCh;
+    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+
+    if (pObj->createArgs.masterCh == SYNC_LINK_MASTER_CH_AUTO)
+    {
+        /* counts are compared as a difference, so that wrap around of
+         * masterRecvCount does not change the master */
+        minCh = pObj->masterCh;
+        for (chId = 0; chId < chPrms->numCh; chId++)
+        {
+            if (chPrms->channelSyncList[chId]
+                && ((Int32)(pObj->chObj[chId].masterRecvCount
+                        - pObj->chObj[minCh].masterRecvCount) < 0))
+            {
+                minCh = chId;
+            }
+        }
+
+        if ((Int32)(pObj->chObj[pObj->masterCh].masterRecvCount
+                - pObj->chObj[minCh].masterRecvCount)
+                    > SYNC_LINK_AUTO_MASTER_HYSTERESIS)
+        {
+            pObj->masterCh = minCh;
+        }
+    }
+
+    return pObj->masterCh;
+}
+
+/**
+ *******************************************************************************
+ * \brief Returns syncDelta in usecs, all ones when sync delta is not
+ *        effective
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ *
+ *******************************************************************************
+*/
+static UInt64 SyncLink_getSyncDeltaUsec(SyncLink_Obj * pObj)
+{
+    UInt64 syncDelta = (UInt64)-1;
+
+    if (pObj->createArgs.chParams.syncDelta < SYNC_DROP_THRESHOLD_MAX)
+    {
+        syncDelta = (UInt64)pObj->createArgs.chParams.syncDelta*1000U;
+    }
+
+    return syncDelta;
+}
+
+/**
+ *******************************************************************************
+ * \brief SYNC_LINK_POLICY_NEAREST_TO_MASTER and SYNC_LINK_POLICY_PARTIAL_SET
+ *        matching.
+ *
+ *        Oldest buffer of the master channel is the reference. A channel is
+ *        resolved once it has a buffer at or after the reference, since
+ *        buffers are in timestamp order no nearer buffer can arrive after
+ *        this. Buffers before the sync window of the reference can not match
+ *        this or any later reference and are dropped.
+ *
+ *        For a partial set, channels which are not resolved after
+ *        partialSetTimeout are sent with the nearest buffer available, or
+ *        without a buffer. If the master channel has no buffer for that
+ *        long, the channel with the oldest buffer is used as reference.
+ *
+ * \param  pObj       [IN]  Sync link instance handle
+ * \param  partialSet [IN]  TRUE to allow sets with missing channels
+ *
+ * \return SYNC_LINK_MATCH_xxx
+ *
+ *******************************************************************************
+*/
+static Int32 SyncLink_matchNearestToMaster(SyncLink_Obj * pObj, Bool partialSet)
+{
+    UInt32 chId, masterCh;
+    Int32 idx;
+    Bool isWait, isMissing, isTimedOut, isResolved;
+    UInt64 refTs, lowerTs, syncDelta, diff, curTime, timeout;
+    System_Buffer *pMasterBuf, *pBuffer;
+    SyncLink_ChObj *chObj;
+    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+
+    masterCh   = SyncLink_getMasterCh(pObj);
+    pMasterBuf = SyncLink_chQuePeek(&pObj->chObj[masterCh], 0);
+    curTime    = Utils_getCurGlobalTimeInUsec();
+    timeout    = (UInt64)pObj->createArgs.partialSetTimeout*1000U;
+
+    if (pMasterBuf == NULL)
+    {
+        if (partialSet == FALSE)
+        {
+            return SYNC_LINK_MATCH_WAIT;
+        }
+
+        for (chId = 0; chId < chPrms->numCh; chId++)
+        {
+            pBuffer = SyncLink_chQuePeek(&pObj->chObj[chId], 0);
+            if (chPrms->channelSyncList[chId] && (pBuffer != NULL)
+                && ((pMasterBuf == NULL)
+                    || (pBuffer->srcTimestamp < pMasterBuf->srcTimestamp)))
+            {
+                pMasterBuf = pBuffer;
+                masterCh   = chId;
+            }
+        }
+
+        if ((pMasterBuf == NULL)
+            || (curTime - pMasterBuf->linkLocalTimestamp < timeout))
+        {
+            return SYNC_LINK_MATCH_WAIT;
+        }
+    }
+
+    refTs      = pMasterBuf->srcTimestamp;
+    syncDelta  = SyncLink_getSyncDeltaUsec(pObj);
+    lowerTs    = (refTs > syncDelta) ? (refTs - syncDelta) : 0;
+    isTimedOut = (Bool)(partialSet
+                    && (curTime - pMasterBuf->linkLocalTimestamp >= timeout));
+
+    pObj->masterTimeStamp = (UInt32)(refTs/1000U);
+    pObj->selectMask = ((UInt32)1U << masterCh);
+
+    isWait    = FALSE;
+    isMissing = FALSE;
+
+    for (chId = 0; chId < chPrms->numCh; chId++)
+    {
+        if ((chPrms->channelSyncList[chId] == FALSE) || (chId == masterCh))
+        {
+            continue;
+        }
+
+        chObj = &pObj->chObj[chId];
+
+        SyncLink_dropOlderThan(pObj, chId, lowerTs);
+
+        pBuffer    = SyncLink_chQuePeek(chObj, chObj->queCount - 1U);
+        isResolved = (Bool)((pBuffer != NULL)
+                        && (pBuffer->srcTimestamp >= refTs));
+
+        diff = 0;
+        idx  = SyncLink_chQueFindNearest(chObj, refTs, &diff);
+
+        if ((idx >= 0) && (diff <= syncDelta) && (isResolved || isTimedOut))
+        {
+            /* older buffers are farther from this and later references */
+            SyncLink_dropOlderThan(pObj, chId,
+                                   chObj->queMem[idx]->srcTimestamp);
+            pObj->selectMask |= ((UInt32)1U << chId);
+        }
+        else
+        if (isResolved || isTimedOut)
+        {
+            isMissing = TRUE;
+        }
+        else
+        {
+            isWait = TRUE;
+        }
+    }
+
+    if (isWait)
+    {
+        return SYNC_LINK_MATCH_WAIT;
+    }
+
+    if (isMissing && (partialSet == FALSE))
+    {
+        pObj->chObj[masterCh].dropCountNoSync++;
+        SyncLink_addToDropList(pObj, SyncLink_chQueGet(&pObj->chObj[masterCh]));
+        return SYNC_LINK_MATCH_DROPPED;
+    }
+
+    return SYNC_LINK_MATCH_FOUND;
+}
+
+/**
+ *******************************************************************************
+ * \brief SYNC_LINK_POLICY_LATEST_COMPLETE_SET matching.
+ *
+ *        Reference is the oldest of the newest buffers of all channels, this
+ *        is the latest time for which every channel can have a buffer. Set
+ *        is made of the buffers nearest to the reference, all older buffers
+ *        are dropped.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ *
+ * \return SYNC_LINK_MATCH_xxx
+ *
+ *******************************************************************************
+*/
+static Int32 SyncLink_matchLatestCompleteSet(SyncLink_Obj * pObj)
+{
+    UInt32 chId;
+    Int32 idx[SYNC_LINK_MAX_CHANNELS];
+    Bool isComplete;
+    UInt64 refTs, lowerTs, syncDelta, diff;
+    System_Buffer *pBuffer;
+    SyncLink_ChObj *chObj;
+    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+
+    refTs = (UInt64)-1;
+
+    for (chId = 0; chId < chPrms->numCh; chId++)
+    {
+        if (chPrms->channelSyncList[chId])
+        {
+            chObj = &pObj->chObj[chId];
+            if (chObj->queCount == 0)
+            {
+                return SYNC_LINK_MATCH_WAIT;
+            }
+
+            pBuffer = SyncLink_chQuePeek(chObj, chObj->queCount - 1U);
+            if (pBuffer->srcTimestamp < refTs)
+            {
+                refTs = pBuffer->srcTimestamp;
+            }
+        }
+    }
+
+    if (refTs == (UInt64)-1)
+    {
+        /* no active channel */
+        return SYNC_LINK_MATCH_WAIT;
+    }
+
+    syncDelta  = SyncLink_getSyncDeltaUsec(pObj);
+    lowerTs    = (refTs > syncDelta) ? (refTs - syncDelta) : 0;
+    isComplete = TRUE;
+
+    pObj->masterTimeStamp = (UInt32)(refTs/1000U);
+
+    for (chId = 0; chId < chPrms->numCh; chId++)
+    {
+        if (chPrms->channelSyncList[chId])
+        {
+            /* buffers before the window can not be part of this or a later set */
+            SyncLink_dropOlderThan(pObj, chId, lowerTs);
+
+            diff = 0;
+            idx[chId] = SyncLink_chQueFindNearest(&pObj->chObj[chId],
+                                                  refTs, &diff);
+            if ((idx[chId] < 0) || (diff > syncDelta))
+            {
+                isComplete = FALSE;
+            }
+        }
+    }
+
+    if (isComplete == FALSE)
+    {
+        return SYNC_LINK_MATCH_WAIT;
+    }
+
+    pObj->selectMask = 0;
+    for (chId = 0; chId < chPrms->numCh; chId++)
+    {
+        if (chPrms->channelSyncList[chId])
+        {
+            chObj = &pObj->chObj[chId];
+            SyncLink_dropOlderThan(pObj, chId,
+                                   chObj->queMem[idx[chId]]->srcTimestamp);
+            pObj->selectMask |= ((UInt32)1U << chId);
+        }
+    }
+
+    return SYNC_LINK_MATCH_FOUND;
+}
+
+/**
+ *******************************************************************************
+ * \brief Sends the selected set to the next link as a composite buffer. If
+ *        no output buffer is free the selected buffers are dropped.
+ *
+ * \param  pObj     [IN]  Sync link instance handle
+ *
+ *******************************************************************************
+*/
+static Void SyncLink_sendSet(SyncLink_Obj * pObj)
+{
+    Int32 status;
+    UInt32 chId;
+    System_Buffer *pBuffer;
+    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+    System_LinkStatistics *linkStatsInfo = pObj->linkStatsInfo;
+
+    status = Utils_bufGetEmptyBuffer(&pObj->outFrameQue,
+                                     &pBuffer, BSP_OSAL_NO_WAIT);
+
+    if(status == SYSTEM_LINK_STATUS_SOK)
+    {
+        UTILS_assert(pBuffer != NULL);
+
+        for (chId = 0; chId < chPrms->numCh; chId++)
+        {
+            if (chPrms->channelSyncList[chId]
+                && ((pObj->selectMask & ((UInt32)1U << chId)) == 0U))
+            {
+                pObj->stats.partialSetCount++;
+                break;
+            }
+        }
+
+        SyncLink_makeCompositeBuffer(pObj, pBuffer);
+
+        linkStatsInfo->linkStats.chStats[0].outBufCount[0]++;
+
+        Utils_updateLatency(&pObj->linkStatsInfo->srcToLinkLatency,
+                            pBuffer->srcTimestamp);
+
+        status = Utils_bufPutFullBuffer(&pObj->outFrameQue, pBuffer);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+        System_sendLinkCmd(pObj->createArgs.outQueParams.nextLink,
+                            SYSTEM_CMD_NEW_DATA, NULL);
+    }
+    else
+    {
+        /*
+         As output queue is not having any free the buffers,
+         We can free the input buffer at this stage.
+         Ideally this should hit this situation and sync link has more
+         buffers than the prior link.
+        */
+        for (chId = 0; chId < chPrms->numCh; chId++)
+        {
+            if (pObj->selectMask & ((UInt32)1U << chId))
+            {
+                pBuffer = SyncLink_chQueGet(&pObj->chObj[chId]);
+                UTILS_assert(pBuffer != NULL);
+
+                pObj->chObj[chId].dropCountNoBuffers++;
+                SyncLink_addToDropList(pObj, pBuffer);
+            }
+        }
+    }
+}
+
 /**
  *******************************************************************************
  * \brief This function does the following,
  *
- *     - For each local queue check buffers have become too old, based on the
- *       threshold
- *     - Fill each local queue with the buffers got from previous link
- *     - If all local queues have buffers, then
- *        - Dequeue from local queues
- *        - Apply sync logic
- *        - If sync logic is successful, construct a composite buffer
+ *     - On timer tick, for each local queue check buffers have become too
+ *       old, based on the threshold
+ *     - On new data, fill each local queue with the buffers got from
+ *       previous link, in timestamp order
+ *     - If local queues have changed, or a partial set may have timed out,
+ *       then till the selected policy needs more data
+ *        - Select a set of buffers, dropping buffers which can not be
+ *          part of a set
+ *        - If a set is selected, construct a composite buffer
  *            - Get a system buffer from Empty Queue
  *            - Get the composite buffer from the system buffer
  *            - Fill composite buffer with buffers dequeued from local queues
@@ -790,19 +1415,19 @@ Int32 SyncLink_computeMasterTimeStamp(SyncLink_Obj * pObj)
  *              with the addresses of dequeued buffers
  *        - Send next link that data is available
  *
- * \param  pObj     [IN]  DUP link instance handle
+ * \param  pObj        [IN]  Sync link instance handle
+ * \param  isTimerTick [IN]  TRUE when called for a timer tick, FALSE when
+ *                           called for new data
  *
  * \return status   SYSTEM_LINK_STATUS_SOK on success
  *
  *******************************************************************************
 */
-Int32 SyncLink_drvProcessData(SyncLink_Obj * pObj)
+Int32 SyncLink_drvProcessData(SyncLink_Obj * pObj, Bool isTimerTick)
 {
-    UInt32 syncDone;
-    Int32 localQueEmptyFlag;
-    System_Buffer *pBuffer;
-    UInt32 status, chId;
-    SyncLink_ChannelParams *chPrms = &pObj->createArgs.chParams;
+    Int32 matchStatus;
+    UInt32 numNewBufs, numDropBufs;
+    Bool doMatch;
 
     System_LinkStatistics *linkStatsInfo;
 
@@ -825,92 +1450,69 @@ Int32 SyncLink_drvProcessData(SyncLink_Obj * pObj)
                              );
     }
 
-    linkStatsInfo->linkStats.newDataCmdCount++;
     pObj->dropBufList.numBuf = 0;
 
-    SyncLink_addBuffersToDropListLesserThanThreshold(pObj);
+    if (isTimerTick)
+    {
+        numDropBufs = pObj->stats.totalDropCount;
 
-    SyncLink_dropBuffers(pObj);
+        SyncLink_addBuffersToDropListLesserThanThreshold(pObj);
 
-    SyncLink_fillLocalQueues(pObj);
+        SyncLink_dropBuffers(pObj);
 
-    SyncLink_dropBuffers(pObj);
+        doMatch = (Bool)((numDropBufs != pObj->stats.totalDropCount)
+            || (pObj->createArgs.syncPolicy == SYNC_LINK_POLICY_PARTIAL_SET));
+    }
+    else
+    {
+        linkStatsInfo->linkStats.newDataCmdCount++;
 
-    do{
-          localQueEmptyFlag = SyncLink_computeMasterTimeStamp(pObj);
+        SyncLink_fillLocalQueues(pObj, &numNewBufs);
 
-          if (localQueEmptyFlag)
-          {
-              break;
-          }
+        SyncLink_dropBuffers(pObj);
 
-          syncDone = TRUE;
-          SyncLink_computeDecisionParams(pObj, &syncDone);
+        doMatch = (Bool)(numNewBufs != 0);
+    }
 
-          if(syncDone == FALSE)
-          {
-              SyncLink_addBuffersToDropListNotInSync(pObj);
-              SyncLink_dropBuffers(pObj);
-          }
-          else
-          {
-              status = Utils_bufGetEmptyBuffer(&pObj->outFrameQue,
-                                                        &pBuffer, BSP_OSAL_NO_WAIT);
+    if (doMatch)
+    {
+        pObj->stats.matchCallCount++;
 
-            if(status == SYSTEM_LINK_STATUS_SOK)
+        do
+        {
+            switch (pObj->createArgs.syncPolicy)
             {
-                UTILS_assert(pBuffer != NULL);
-
-                SyncLink_makeCompositeBuffer(pObj, pBuffer);
-
-                linkStatsInfo->linkStats.chStats[0].outBufCount[0]++;
+                case SYNC_LINK_POLICY_NEAREST_TO_MASTER:
+                    matchStatus = SyncLink_matchNearestToMaster(pObj, FALSE);
+                    break;
+                case SYNC_LINK_POLICY_PARTIAL_SET:
+                    matchStatus = SyncLink_matchNearestToMaster(pObj, TRUE);
+                    break;
+                case SYNC_LINK_POLICY_LATEST_COMPLETE_SET:
+                    matchStatus = SyncLink_matchLatestCompleteSet(pObj);
+                    break;
+                default:
+                    matchStatus = SyncLink_matchHeadAverage(pObj);
+                    break;
+            }
 
-                Utils_updateLatency(&pObj->linkStatsInfo->srcToLinkLatency,
-                                    pBuffer->srcTimestamp);
+            if (matchStatus == SYNC_LINK_MATCH_FOUND)
+            {
+                SyncLink_sendSet(pObj);
+            }
 
-                status = Utils_bufPutFullBuffer(&pObj->outFrameQue, pBuffer);
-                UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-                System_sendLinkCmd(pObj->createArgs.outQueParams.nextLink,
-                                    SYSTEM_CMD_NEW_DATA, NULL);
+            if(pObj->dropBufList.numBuf)
+            {
+                SyncLink_dropBuffers(pObj);
             }
             else
             {
-                /*
-                 As output queue is not having any free the buffers,
-                 We can free the input buffer at this stage.
-                 Ideally this should hit this situation and sync link has more
-                 buffers than the prior link.
-                */
-                chPrms = &pObj->createArgs.chParams;
-                for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
-                {
-                    if (chPrms->channelSyncList[chId])
-                    {
-                        status = Utils_queGet(&pObj->chObj[chId].localQueHandle,
-                                            (Ptr *) &pBuffer,
-                                            1,
-                                            BSP_OSAL_NO_WAIT);
-                        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-                        UTILS_assert(pBuffer != NULL);
-
-                        pObj->dropBufList.buffers[pObj->dropBufList.numBuf] = pBuffer;
-                        pObj->dropBufList.numBuf++;
-                        linkStatsInfo->linkStats.chStats[pBuffer->chNum].inBufDropCount++;
-                    }
-                }
+                /* To avoid Misra Error */
             }
-          }
-          if(pObj->dropBufList.numBuf)
-          {
-            SyncLink_dropBuffers(pObj);
-          }
-          else
-          {
-            /* To avoid Misra Error */
-          }
-      }while(1);
-
-      return SYSTEM_LINK_STATUS_SOK;
+        } while (matchStatus != SYNC_LINK_MATCH_WAIT);
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
 }
 
 /**
@@ -1030,8 +1632,7 @@ Int32 SyncLink_getFullBuffers(Void * ptr, UInt16 queId,
 */
 Int32 SyncLink_drvDelete(SyncLink_Obj *pObj)
 {
-    Int32 status, chId;
-    SyncLink_ChObj *chObj;
+    Int32 status;
 
     status = Utils_bufDelete(&pObj->outFrameQue);
     UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
@@ -1039,13 +1640,6 @@ Int32 SyncLink_drvDelete(SyncLink_Obj *pObj)
     status = Utils_linkStatsCollectorDeAllocInst(pObj->linkStatsInfo);
     UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
 
-    for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
-    {
-        chObj = &pObj->chObj[chId];
-        status = Utils_queDelete(&chObj->localQueHandle);
-        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-    }
-
     BspOsal_clockDelete(&pObj->timer);
 
     return status;
@@ -1067,6 +1661,8 @@ Int32 SyncLink_drvPrintStatistics(SyncLink_Obj *pObj)
     Int32 status = SYSTEM_LINK_STATUS_SOK;
     char                 tskName[32];
     SyncLink_BufferStats *stats = &pObj->stats;
+    SyncLink_ChObj *chObj;
+    UInt32 chId;
 
     sprintf(tskName, "SYNC_LINK_%u", (unsigned int)pObj->linkInstId);
 
@@ -1081,17 +1677,59 @@ Int32 SyncLink_drvPrintStatistics(SyncLink_Obj *pObj)
     Vps_printf(" \n");
     Vps_printf(" [%s] Additional Statistics, \r\n", tskName);
     Vps_printf(" ******************************** \r\n");
+    Vps_printf(" Sync Policy            = %d (master CH%d, queue depth %d)\r\n",
+                pObj->createArgs.syncPolicy,
+                pObj->masterCh,
+                pObj->createArgs.queDepth);
     Vps_printf(" Total Frames Dropped   = %d frames\r\n", stats->totalDropCount);
     if(stats->syncDeltaCount)
     {
         Vps_printf(" Average Sync Diff      = %d ms\r\n",
                 stats->totalSyncDelta/stats->syncDeltaCount);
     }
+    Vps_printf(" Sets Sent              = %d (%d partial, %d match runs)\r\n",
+                stats->setCount,
+                stats->partialSetCount,
+                stats->matchCallCount);
+    if(stats->setCount)
+    {
+        Vps_printf(" Added Latency          = %d us avg, %d us max\r\n",
+                (UInt32)(stats->totalAddedLatency/stats->setCount),
+                stats->maxAddedLatency);
+    }
+    Vps_printf(" \r\n");
+    Vps_printf(" CH | Recv | Sent | Match %% | Drop NoSync | Drop NoBuf | Drop QueFull \r\n");
+    for (chId = 0; chId < pObj->createArgs.chParams.numCh; chId++)
+    {
+        chObj = &pObj->chObj[chId];
+        if (pObj->createArgs.chParams.channelSyncList[chId])
+        {
+            Vps_printf(" %2d | %4d | %4d | %7d | %11d | %10d | %12d \r\n",
+                chId,
+                chObj->recvCount,
+                chObj->forwardCount,
+                chObj->recvCount ?
+                    (chObj->forwardCount*100)/chObj->recvCount : 0,
+                chObj->dropCountNoSync,
+                chObj->dropCountNoBuffers,
+                chObj->dropCountQueFull);
+        }
+        chObj->recvCount = 0;
+        chObj->forwardCount = 0;
+        chObj->dropCountNoSync = 0;
+        chObj->dropCountNoBuffers = 0;
+        chObj->dropCountQueFull = 0;
+    }
     Vps_printf(" \r\n");
 
     stats->totalDropCount = 0;
     stats->totalSyncDelta = 0;
     stats->syncDeltaCount = 0;
+    stats->setCount = 0;
+    stats->partialSetCount = 0;
+    stats->matchCallCount = 0;
+    stats->totalAddedLatency = 0;
+    stats->maxAddedLatency = 0;
 
     #if 0
     {
@@ -1227,13 +1865,25 @@ Void SyncLink_tskMain(struct Utils_TskHndl * pTsk, Utils_MsgHndl * pMsg)
 
             if(pObj->state==SYSTEM_LINK_STATE_RUNNING)
             {
-                status = SyncLink_drvProcessData(pObj);
+                status = SyncLink_drvProcessData(pObj, FALSE);
             }
 //#ifdef SYSTEM_RT_STATS_LOG_CMD
 //    Vps_printf(" SYNC: tskMain SYSTEM_CMD_NEW_DATA end !!!\n");
 //#endif
             break;
 
+        case SYNC_LINK_CMD_TIMER_TICK:
+            Utils_tskAckOrFreeMsg(pMsg, status);
+
+            flushCmds[0] = SYNC_LINK_CMD_TIMER_TICK;
+            Utils_tskFlushMsg(pTsk, flushCmds, 1);
+
+            if(pObj->state==SYSTEM_LINK_STATE_RUNNING)
+            {
+                status = SyncLink_drvProcessData(pObj, TRUE);
+            }
+            break;
+
         case SYSTEM_CMD_START:
 //#ifdef SYSTEM_RT_STATS_LOG_CMD
 //    Vps_printf(" SYNC: tskMain SYSTEM_CMD_START start !!!\n");
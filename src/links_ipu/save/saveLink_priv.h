@@ -1,7 +1,7 @@
  /*
  *******************************************************************************
  *
- * Copyright (C) 2013 Texas Instruments Incorporated - http://www.ti.com/
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
  * ALL RIGHTS RESERVED
  *
  *******************************************************************************
@@ -10,8 +10,8 @@
 /**
  *******************************************************************************
  *
- * \ingroup Save_LINK_API
- * \defgroup Save_LINK_IMPL Save Link Implementation
+ * \ingroup SAVE_LINK_API
+ * \defgroup SAVE_LINK_IMPL Save Link Implementation
  *
  * @{
  */
@@ -19,19 +19,19 @@
 /**
  *******************************************************************************
  *
- * \file SaveLink_priv.h Save Link private API/Data structures
+ * \file saveLink_priv.h Save Link private API/Data structures
  *
- * \brief  This file is a private header file for Save link implementation
+ * \brief  This file is a private header file for save link implementation
  *         This file lists the data structures, function prototypes which are
- *         implemented and used as a part of Save link.
- *         Save Link is used in cases where the output buffers from one link is
- *         to be sent to multiple links. Save link simply Savelicates the buffers
- *         without actually Savelicating the video frame and send these buffers
- *         across all output queues. Save link implements the logic to release
- *         buffers to it's previous link only when every link connected to it's
- *         output queue release the buffers.
+ *         implemented and used as a part of save link.
  *
- * \version 0.0 (Jul 2013) : [NN] First version
+ *         Link task takes input buffers and puts them in a ring, a writer
+ *         task running at lower priority writes them to file and releases
+ *         them to the previous link. Ring is a single producer, single
+ *         consumer queue, link task is the only producer and writer task is
+ *         the only consumer.
+ *
+ * \version 0.0 (Oct 2015) : First version
  *
  *******************************************************************************
  */
@@ -58,103 +58,165 @@ extern "C" {
  /**
  *******************************************************************************
  *
- * \brief Maximum number of dup link objects
+ * \brief Maximum number of save link objects
  *
  * SUPPORTED in ALL platforms
  *
  *******************************************************************************
  */
-#define SAVE_LINK_OBJ_MAX    (5)
+#define SAVE_LINK_OBJ_MAX    (2)
 
-#if 0 // //ryuhs74@20151027 - Compile Test
 /**
  *******************************************************************************
  *
- * \brief Maximum frmaes an output queue can support
+ * \brief Save link task priority
  *
- * SUPPORTED in ALL platforms
+ *******************************************************************************
+ */
+#define SAVE_LINK_TSK_PRI               (4)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Save link writer task priority, lower than link task so that file
+ *        writes never delay taking and releasing of input buffers
  *
  *******************************************************************************
  */
-#define SAVE_LINK_MAX_FRAMES_PER_OUT_QUE    \
-                           (SYSTEM_LINK_FRAMES_PER_CH*SYSTEM_MAX_CH_PER_OUT_QUE)
+#define SAVE_LINK_WRITER_TSK_PRI        (2)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Save link task stack size
+ *
+ *******************************************************************************
+ */
+#define SAVE_LINK_TSK_STACK_SIZE        (SYSTEM_TSK_STACK_SIZE_SMALL)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Save link writer task stack size
+ *
+ *******************************************************************************
+ */
+#define SAVE_LINK_WRITER_TSK_STACK_SIZE (SYSTEM_TSK_STACK_SIZE_MEDIUM)
 
 /*******************************************************************************
  *  Data structure's
  *******************************************************************************
  */
 
-
 /**
  *******************************************************************************
  *
- * \brief Stat structure that stores information about the number of
- *  - Recevied buffers
- *  - Forwarded buffers ( Sent to next link )
- *  - Released buffers ( Sent back to the previous link )
+ * \brief Recorder statistics, printed with link statistics
+ *
+ *        Counts are from link create and are not reset on print, since
+ *        fields are updated either by link task or by writer task, never
+ *        by both
  *
  *******************************************************************************
  */
 typedef struct {
+
     UInt32 recvCount;
-    UInt32 forwardCount[DUP_LINK_MAX_OUT_QUE];
-    UInt32 releaseCount[DUP_LINK_MAX_OUT_QUE];
-} DupLink_StatsObj;
+    /**< Buffers received from previous link, link task */
+
+    UInt32 dropCountRingFull;
+    /**< Buffers released without writing since ring was full, link task */
+
+    UInt32 maxRingCount;
+    /**< Max buffers held in ring, link task */
+
+    UInt32 writeCount;
+    /**< Frames written, writer task */
+
+    UInt32 writeErrorCount;
+    /**< Frames not fully written or not supported, writer task */
+
+    UInt64 writeBytes;
+    /**< Bytes written to data files, writer task */
+
+    UInt64 writeTime;
+    /**< Time spent in writing frames in usecs, writer task */
+
+} SaveLink_StatsObj;
 
 /**
  *******************************************************************************
  *
- * \brief Structure to hold all Dup link related information
+ * \brief Structure to hold all save link related information
  *
  *******************************************************************************
  */
 typedef struct {
     UInt32 tskId;
-    /**< Placeholder to store dup link task id */
+    /**< Placeholder to store save link task id */
+
+    UInt32 instId;
+    /**< Instance index of this link */
 
     UInt32 state;
     /**< Link state, one of SYSTEM_LINK_STATE_xxx */
 
     Utils_TskHndl tsk;
-    /**< Handle to capture link task */
+    /**< Handle to save link task */
 
-    DupLink_CreateParams createArgs;
-    /**< Create params for dup link */
+    SaveLink_CreateParams createArgs;
+    /**< Create params for save link */
 
-    UInt32 getFrameCount;
-    /**< Count of incoming frames */
+    System_LinkQueInfo inQueInfo;
+    /**< Input queue information of previous link */
 
-    UInt32 putFrameCount;
-    /**< Count of outgoing frames */
+    Utils_QueHandle ringQue;
+    /**< Input buffers waiting to be written */
 
-    System_LinkInfo inTskInfo;
-    /**< Output queue information of previous link */
+    System_Buffer *ringQueMem[SAVE_LINK_MAX_RING_DEPTH];
+    /**< Memory for ringQue */
 
-    System_LinkInfo info;
-    /**< Output queue information of this link */
+    BspOsal_TaskHandle writerTsk;
+    /**< Writer task handle */
 
-    Utils_BufHndl outFrameQue[DUP_LINK_MAX_OUT_QUE];
-    /**< Handles to each of the output queues */
+    BspOsal_SemHandle writerDoneSem;
+    /**< Posted by writer task when it exits */
 
-    System_Buffer
-                sysBufs[DUP_LINK_MAX_OUT_QUE * DUP_LINK_MAX_FRAMES_PER_OUT_QUE];
-    /**< Placeholder to store the incoming buffers */
+    volatile Bool writerExit;
+    /**< Set at delete, writer task writes what is left in ring and exits */
 
-    System_BufferList inBufList;
+    FILE *fpData[SAVE_LINK_MAX_CH];
+    /**< Data file of each channel, NULL when channel is not recorded */
 
-    System_BufferList outBufList[DUP_LINK_MAX_OUT_QUE];
+    FILE *fpIndex[SAVE_LINK_MAX_CH];
+    /**< Index file of each channel */
 
-    BspOsal_SemHandle lock;
-    /**< Link level lock, used while updating the link params */
+    UInt8 *pWriteBuf;
+    /**< Used by writer task to gather lines into large writes */
 
-    DupLink_StatsObj stats;
-    /**< To store statistics of the buffers */
-} DupLink_Obj;
+    UInt32 writeBufFill;
+    /**< Bytes in pWriteBuf not yet written */
 
+    System_LinkStatistics   *linkStatsInfo;
+    /**< Pointer to the Link statistics information,
+         used to store below information
+            1, min, max and average latency of the link
+            2, min, max and average latency from source to this link
+            3, links statistics like frames captured, dropped etc
+        Pointer is assigned at the link create time from shared
+        memory maintained by utils_link_stats layer */
 
+    Bool isFirstFrameRecv;
+    /**< Flag to indicate if first frame is received, this is used as trigger
+     *   to start stats counting
+     */
 
-extern SaveLink_Obj gDupLink_obj[];
-#endif // //ryuhs74@20151027 - Compile Test
+    SaveLink_StatsObj stats;
+    /**< Recorder statistics */
+
+} SaveLink_Obj;
+
+extern SaveLink_Obj gSaveLink_obj[];
 
 Void SaveLink_tskMain(struct Utils_TskHndl * pTsk, Utils_MsgHndl * pMsg);
 
@@ -167,5 +229,3 @@ Int32 SaveLink_tskCreate(UInt32 instId);
 #endif
 
 /* @} */
-
-
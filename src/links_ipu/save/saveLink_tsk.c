@@ -1,7 +1,7 @@
 /*
  *******************************************************************************
  *
- * Copyright (C) 2013 Texas Instruments Incorporated - http://www.ti.com/
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
  * ALL RIGHTS RESERVED
  *
  *******************************************************************************
@@ -9,15 +9,20 @@
 
 /**
   ******************************************************************************
- * \file dupLink_tsk.c
+ * \file saveLink_tsk.c
  *
- * \brief  This file has the implementation of DUP Link API
- **
- *           This file implements the state machine logic for this link.
- *           A message command will cause the state machine
- *           to take some action and then move to a different state.
+ * \brief  This file has the implementation of Save Link API
  *
- * \version 0.0 (Jul 2013) : [NN] First version
+ *         Link task takes buffers from previous link and puts them in a
+ *         ring without waiting. Writer task takes buffers from the ring,
+ *         writes them to file and releases them to previous link. When ring
+ *         is full the buffer is released right away and counted as dropped.
+ *
+ *         Lines of a plane which are not contiguous in memory are gathered
+ *         into a large buffer so that the file is written in large
+ *         sequential chunks.
+ *
+ * \version 0.0 (Oct 2015) : First version
  *
  *******************************************************************************
  */
@@ -28,320 +33,626 @@
  */
 #include "saveLink_priv.h"
 
+/**
+ *******************************************************************************
+ * \brief Writer task stack
+ *******************************************************************************
+ */
+#pragma DATA_ALIGN(gSaveLink_writerTskStack, 32)
+#pragma DATA_SECTION(gSaveLink_writerTskStack, ".bss:taskStackSection")
+UInt8 gSaveLink_writerTskStack[SAVE_LINK_OBJ_MAX][SAVE_LINK_WRITER_TSK_STACK_SIZE];
 
 /**
  *******************************************************************************
  * \brief Link object, stores all link related information
  *******************************************************************************
  */
-//DupLink_Obj gDupLink_obj[DUP_LINK_OBJ_MAX];
+SaveLink_Obj gSaveLink_obj[SAVE_LINK_OBJ_MAX];
 
+/**
+ *******************************************************************************
+ *
+ * \brief Write out data gathered in write buffer. Called only from writer
+ *        task.
+ *
+ * \param  pObj     [IN]  Save link instance handle
+ * \param  fp       [IN]  Data file
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+static Int32 SaveLink_flushWriteBuf(SaveLink_Obj *pObj, FILE *fp)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
 
+    if(pObj->writeBufFill)
+    {
+        if(fwrite(pObj->pWriteBuf, 1, pObj->writeBufFill, fp)
+                != pObj->writeBufFill)
+        {
+            status = SYSTEM_LINK_STATUS_EFAIL;
+        }
+        pObj->writeBufFill = 0;
+    }
+
+    return status;
+}
 
 /**
  *******************************************************************************
- * \brief DUP Link just duplicates incoming buffers and sends across all output
- *     queues. There is no driver involved in duplicating the buffers. To keep
- *     code across all links consistent we use the same convention as
- *     DupLink_drvCreate. This function does the following,
  *
- *     - Copies the user passed create params into the link object create params
- *     - Prepares output queues
+ * \brief Write data to data file through write buffer
  *
- * \param  pObj     [IN]  DUP link instance handle
- * \param  pPrm     [IN]  Create params for DUP link
+ *        Data larger than write buffer is written directly after flushing
+ *        write buffer. Write buffer only ever has data of the frame being
+ *        written, since it is flushed at end of every frame. Called only
+ *        from writer task.
  *
- * \return status   SYSTEM_LINK_STATUS_SOK on success
+ * \param  pObj     [IN]  Save link instance handle
+ * \param  fp       [IN]  Data file
+ * \param  pData    [IN]  Data to write
+ * \param  size     [IN]  Size of data in bytes
+ *
+ * \return Bytes accepted, less than size on a write error
  *
  *******************************************************************************
-*/
-Int32 SaveLink_drvCreate(/*DupLink_Obj * pObj, DupLink_CreateParams * pPrm*/)
+ */
+static UInt32 SaveLink_writeData(SaveLink_Obj *pObj, FILE *fp,
+                                 UInt8 *pData, UInt32 size)
 {
-#if 0
-    UInt32 outId, bufId;
-    Int32 status;
-    System_Buffer *pSysBuf;
-
-    memcpy(&pObj->createArgs, pPrm, sizeof(pObj->createArgs));
-    UTILS_assert(pObj->createArgs.numOutQue <= DUP_LINK_MAX_OUT_QUE);
+    if(pObj->pWriteBuf==NULL || size > pObj->createArgs.writeBufSize)
+    {
+        if(SaveLink_flushWriteBuf(pObj, fp) != SYSTEM_LINK_STATUS_SOK)
+        {
+            return 0;
+        }
+        return fwrite(pData, 1, size, fp);
+    }
 
-    pObj->getFrameCount = 0;
-    pObj->putFrameCount = 0;
+    if(pObj->writeBufFill + size > pObj->createArgs.writeBufSize)
+    {
+        if(SaveLink_flushWriteBuf(pObj, fp) != SYSTEM_LINK_STATUS_SOK)
+        {
+            return 0;
+        }
+    }
 
-    status = System_linkGetInfo(
-                    pObj->createArgs.inQueParams.prevLinkId, &pObj->inTskInfo);
+    memcpy(pObj->pWriteBuf + pObj->writeBufFill, pData, size);
+    pObj->writeBufFill += size;
 
-    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-    UTILS_assert(pPrm->inQueParams.prevLinkQueId < pObj->inTskInfo.numQue);
+    return size;
+}
 
-    pObj->info.numQue = pObj->createArgs.numOutQue;
+/**
+ *******************************************************************************
+ *
+ * \brief Write a plane of a video frame without pitch padding
+ *
+ *        Plane which is contiguous in memory is written with a single write,
+ *        else its lines are gathered in write buffer
+ *
+ * \param  pObj      [IN]  Save link instance handle
+ * \param  fp        [IN]  Data file
+ * \param  pAddr     [IN]  Plane address
+ * \param  lineSize  [IN]  Bytes in a line
+ * \param  numLines  [IN]  Lines in plane
+ * \param  pitch     [IN]  Pitch of plane in bytes
+ *
+ * \return Bytes written
+ *
+ *******************************************************************************
+ */
+static UInt32 SaveLink_writePlane(SaveLink_Obj *pObj, FILE *fp,
+                                  UInt8 *pAddr, UInt32 lineSize,
+                                  UInt32 numLines, UInt32 pitch)
+{
+    UInt32 line, bytesWritten = 0;
 
-    /*
-     * Copy the output queue information of previous link into the DUP link
-     * output queues. Since DUP does not modify any information we need to
-     * have the same output queue information as the previous link that DUP
-     * link is connected to.
-    */
+    Cache_inv((Ptr)SystemUtils_floor((UInt32)pAddr, 128),
+              SystemUtils_align(pitch*numLines + 128, 128),
+              Cache_Type_ALLD, TRUE);
 
-    UTILS_assert(pObj->info.numQue <= SYSTEM_MAX_OUT_QUE);
-    for (outId = 0; outId < pObj->info.numQue; outId++)
+    if(pitch == lineSize)
     {
-        memcpy(&pObj->info.queInfo[outId],
-           &pObj->inTskInfo.queInfo[pPrm->inQueParams.prevLinkQueId],
-           sizeof(pObj->inTskInfo.queInfo[outId]));
+        return SaveLink_writeData(pObj, fp, pAddr, lineSize*numLines);
     }
 
-    pObj->lock = BspOsal_semCreate(1u, TRUE);
-
-    for (outId = 0; outId < DUP_LINK_MAX_OUT_QUE; outId++)
+    for(line = 0; line < numLines; line++)
     {
-        status = Utils_bufCreate(&pObj->outFrameQue[outId], FALSE, FALSE);
-        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-
-        for (bufId = 0; bufId < DUP_LINK_MAX_FRAMES_PER_OUT_QUE; bufId++)
-        {
-            pSysBuf = &pObj->sysBufs[DUP_LINK_MAX_FRAMES_PER_OUT_QUE * outId + bufId];
-            status = Utils_bufPutEmptyBuffer(&pObj->outFrameQue[outId],
-                                             pSysBuf);
-            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-        }
+        bytesWritten += SaveLink_writeData(pObj, fp, pAddr, lineSize);
+        pAddr += pitch;
     }
 
-    memset(&pObj->stats, 0, sizeof(pObj->stats));
-#endif
-    return SYSTEM_LINK_STATUS_SOK;
+    return bytesWritten;
 }
 
 /**
  *******************************************************************************
- * \brief DUP Link just duplicates incoming buffers and sends across all output
- *      queues. This function does the following,
  *
- *     - Duplicates buffers and sends across it's output queues
- *     - Send SYSTEM_CMD_NEW_DATA to all it's connected links
+ * \brief Write a buffer to data file of its channel and its size to index
+ *        file. Called only from writer task.
  *
- * \param  pObj     [IN]  DUP link instance handle
+ * \param  pObj     [IN]  Save link instance handle
+ * \param  pBuf     [IN]  Buffer to write
  *
- * \return status   SYSTEM_LINK_STATUS_SOK on success
+ * \return SYSTEM_LINK_STATUS_SOK on success
  *
  *******************************************************************************
-*/
-Int32 SaveLink_drvProcessData(/*DupLink_Obj * pObj*/)
+ */
+static Int32 SaveLink_writeFrame(SaveLink_Obj *pObj, System_Buffer *pBuf)
 {
-#if 0
-    UInt32 outId, bufId;
-    Int32 status;
-    DupLink_CreateParams *pCreateArgs;
-    System_Buffer *pBuf, *pOrgBuf;
+    System_VideoFrameBuffer *pVidFrame;
+    System_BitstreamBuffer *pBitstream;
+    System_LinkChInfo *pChInfo;
+    UInt32 dataFormat, frameSize = 0, bytesWritten = 0;
+    UInt64 startTime;
+    FILE *fp;
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+
+    if(pBuf->chNum >= SAVE_LINK_MAX_CH || pObj->fpData[pBuf->chNum]==NULL)
+    {
+        return SYSTEM_LINK_STATUS_SOK;
+    }
+
+    fp = pObj->fpData[pBuf->chNum];
 
-    pCreateArgs = &pObj->createArgs;
-    System_getLinksFullBuffers(pCreateArgs->inQueParams.prevLinkId,
-                               pCreateArgs->inQueParams.prevLinkQueId,
-                               &pObj->inBufList);
+    startTime = Utils_getCurGlobalTimeInUsec();
 
-    if (pObj->inBufList.numBuf)
+    switch(pBuf->bufType)
     {
-        pObj->getFrameCount += pObj->inBufList.numBuf;
-        pObj->stats.recvCount += pObj->inBufList.numBuf;
+        case SYSTEM_BUFFER_TYPE_BITSTREAM:
+            pBitstream = (System_BitstreamBuffer *)pBuf->payload;
 
-        for (outId = 0; outId < pCreateArgs->numOutQue; outId++)
-        {
-            pObj->outBufList[outId].numBuf = 0;
-        }
+            Cache_inv((Ptr)SystemUtils_floor((UInt32)pBitstream->bufAddr, 128),
+                      SystemUtils_align(pBitstream->fillLength + 128, 128),
+                      Cache_Type_ALLD, TRUE);
 
-        for (bufId = 0; bufId < pObj->inBufList.numBuf; bufId++)
-        {
-            pOrgBuf = pObj->inBufList.buffers[bufId];
+            frameSize = pBitstream->fillLength;
+            bytesWritten = SaveLink_writeData(pObj, fp,
+                                pBitstream->bufAddr, frameSize);
+            break;
+
+        case SYSTEM_BUFFER_TYPE_VIDEO_FRAME:
+            pVidFrame = (System_VideoFrameBuffer *)pBuf->payload;
+            pChInfo = &pObj->inQueInfo.chInfo[pBuf->chNum];
 
-            if(pOrgBuf == NULL)
-                continue;
+            /* frame chInfo is valid only when run time params are updated,
+             * else use channel info of input queue from create time
+             */
+            if(SYSTEM_LINK_CH_INFO_GET_FLAG_IS_RT_PRM_UPDATE(
+                    pVidFrame->chInfo.flags) == TRUE)
+            {
+                pChInfo->width    = pVidFrame->chInfo.width;
+                pChInfo->height   = pVidFrame->chInfo.height;
+                pChInfo->pitch[0] = pVidFrame->chInfo.pitch[0];
+                pChInfo->pitch[1] = pVidFrame->chInfo.pitch[1];
+                pChInfo->pitch[2] = pVidFrame->chInfo.pitch[2];
+                SYSTEM_LINK_CH_INFO_SET_FLAG_DATA_FORMAT(pChInfo->flags,
+                    SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(
+                        pVidFrame->chInfo.flags));
+            }
 
-            pOrgBuf->dupCount = pCreateArgs->numOutQue;
+            dataFormat = SYSTEM_LINK_CH_INFO_GET_FLAG_DATA_FORMAT(
+                            pChInfo->flags);
 
-            for (outId = 0; outId < pCreateArgs->numOutQue; outId++)
+            if(dataFormat == SYSTEM_DF_YUV420SP_UV)
             {
-                status = Utils_bufGetEmptyBuffer(&pObj->outFrameQue[outId],
-                                                           &pBuf, BSP_OSAL_NO_WAIT);
-                UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-                UTILS_assert(pBuf != NULL);
+                frameSize = pChInfo->width*pChInfo->height
+                          + pChInfo->width*(pChInfo->height/2);
+
+                bytesWritten = SaveLink_writePlane(pObj, fp,
+                                    pVidFrame->bufAddr[0],
+                                    pChInfo->width,
+                                    pChInfo->height,
+                                    pChInfo->pitch[0]);
+
+                bytesWritten += SaveLink_writePlane(pObj, fp,
+                                    pVidFrame->bufAddr[1],
+                                    pChInfo->width,
+                                    pChInfo->height/2,
+                                    pChInfo->pitch[1]);
+            }
+            else
+            if(dataFormat == SYSTEM_DF_YUV422I_YUYV)
+            {
+                frameSize = pChInfo->width*2*pChInfo->height;
 
-                memcpy(pBuf, pOrgBuf, sizeof(*pBuf));
+                bytesWritten = SaveLink_writePlane(pObj, fp,
+                                    pVidFrame->bufAddr[0],
+                                    pChInfo->width*2,
+                                    pChInfo->height,
+                                    pChInfo->pitch[0]);
+            }
+            else
+            {
+                status = SYSTEM_LINK_STATUS_EFAIL;
+            }
+            break;
 
-                pBuf->pDupOrgFrame = (struct System_Buffer *)pOrgBuf;
+        default:
+            status = SYSTEM_LINK_STATUS_EFAIL;
+            break;
+    }
 
-                pObj->outBufList[outId].buffers[pObj->outBufList[outId].
-                                                    numBuf] = pBuf;
+    if(SaveLink_flushWriteBuf(pObj, fp) != SYSTEM_LINK_STATUS_SOK)
+    {
+        status = SYSTEM_LINK_STATUS_EFAIL;
+    }
 
-                pObj->outBufList[outId].numBuf++;
-            }
-        }
+    if(status == SYSTEM_LINK_STATUS_SOK && bytesWritten != frameSize)
+    {
+        status = SYSTEM_LINK_STATUS_EFAIL;
+    }
 
-        for (outId = 0; outId < pCreateArgs->numOutQue; outId++)
-        {
-            status = Utils_bufPutFull(&pObj->outFrameQue[outId],
-                                     &pObj->outBufList[outId]);
-            UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    if(status == SYSTEM_LINK_STATUS_SOK)
+    {
+        /* index file lists bytes of each frame, as read by null source link */
+        fprintf(pObj->fpIndex[pBuf->chNum], "%u\n", (unsigned int)frameSize);
 
-            if (pCreateArgs->notifyNextLink)
-            {
-                System_sendLinkCmd(pCreateArgs->outQueParams[outId].nextLink,
-                                                        SYSTEM_CMD_NEW_DATA, NULL);
-            }
-        }
+        pObj->stats.writeCount++;
     }
-#endif
-    return SYSTEM_LINK_STATUS_SOK;
+    else
+    {
+        pObj->stats.writeErrorCount++;
+    }
+
+    pObj->stats.writeBytes += bytesWritten;
+    pObj->stats.writeTime  += Utils_getCurGlobalTimeInUsec() - startTime;
+
+    return status;
 }
 
 /**
  *******************************************************************************
- * \brief Function called by links connected to DUP link to get data from
- *    the output queue of DUP link
  *
- * \param  ptr      [IN]  Handle to task
- * \param  queId    [IN]  output queue Id
- * \param  pBufList [OUT] A List of buffers needed for the next link
+ * \brief Writer task, writes buffers in ring and releases them to previous
+ *        link. On delete, writes buffers left in ring and exits.
+ *
+ * \param  arg1     [IN]  Save link instance handle
+ * \param  arg2     [IN]  Not used
  *
- * \return SYSTEM_LINK_STATUS_SOK on success
  *******************************************************************************
-*/
-Int32 SaveLink_getFullBuffers(Void * ptr, UInt16 queId,
-                            System_BufferList * pBufList)
+ */
+static Void SaveLink_writerTskMain(UArg arg1, UArg arg2)
 {
+    SaveLink_Obj *pObj = (SaveLink_Obj *)arg1;
+    System_LinkInQueParams *pInQueParams = &pObj->createArgs.inQueParams;
+    System_BufferList bufList;
+    System_Buffer *pBuf;
     Int32 status;
-    status = 0;
-#if 0
-    DupLink_Obj *pObj;
-    Utils_TskHndl *pTsk = (Utils_TskHndl *) ptr;
 
-    pObj = (DupLink_Obj *) pTsk->appData;
-    UTILS_assert(queId < DUP_LINK_MAX_OUT_QUE);
+    while(1)
+    {
+        status = Utils_queGet(&pObj->ringQue, (Ptr *)&pBuf, 1,
+                    pObj->writerExit ? BSP_OSAL_NO_WAIT : BSP_OSAL_WAIT_FOREVER);
 
-    status = Utils_bufGetFull(&pObj->outFrameQue[queId], pBufList,
-                              BSP_OSAL_NO_WAIT);
+        if(status != SYSTEM_LINK_STATUS_SOK)
+        {
+            if(pObj->writerExit)
+            {
+                break;
+            }
+            continue;
+        }
 
-    if(status == SYSTEM_LINK_STATUS_SOK)
-    {
-        pObj->stats.forwardCount[queId] += pBufList->numBuf;
+        SaveLink_writeFrame(pObj, pBuf);
+
+        bufList.numBuf = 1;
+        bufList.buffers[0] = pBuf;
+
+        System_putLinksEmptyBuffers(pInQueParams->prevLinkId,
+                                    pInQueParams->prevLinkQueId,
+                                    &bufList);
     }
-#endif
-    return status;
+
+    BspOsal_semPost(pObj->writerDoneSem);
 }
 
 /**
  *******************************************************************************
- * \brief Function called by links connected to DUP link to get output queue
- *    Information of DUP link
  *
- * \param  ptr      [IN]  Handle to task
- * \param  info     [OUT] output queues information of DUP link
+ * \brief Create save link, opens files, creates ring and writer task
+ *
+ * \param  pObj     [IN]  Save link instance handle
+ * \param  pPrm     [IN]  Create params for save link
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
  *
- * \return SYSTEM_LINK_STATUS_SOK on success
  *******************************************************************************
-*/
-Int32 SaveLink_getLinkInfo(Void * ptr, System_LinkInfo * info)
+ */
+Int32 SaveLink_drvCreate(SaveLink_Obj *pObj, SaveLink_CreateParams *pPrm)
 {
-#if 0
-    Utils_TskHndl *pTsk = (Utils_TskHndl *) ptr;
+    Int32 status;
+    UInt32 chId;
+    System_LinkInfo inTskInfo;
+    char tskName[32];
+
+    memcpy(&pObj->createArgs, pPrm, sizeof(pObj->createArgs));
+
+    UTILS_assert(pObj->createArgs.ringDepth > 0);
+    UTILS_assert(pObj->createArgs.ringDepth <= SAVE_LINK_MAX_RING_DEPTH);
+
+    status = System_linkGetInfo(pPrm->inQueParams.prevLinkId, &inTskInfo);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    UTILS_assert(pPrm->inQueParams.prevLinkQueId < inTskInfo.numQue);
+
+    pObj->inQueInfo = inTskInfo.queInfo[pPrm->inQueParams.prevLinkQueId];
+
+    memset(&pObj->stats, 0, sizeof(pObj->stats));
+    memset(pObj->fpData, 0, sizeof(pObj->fpData));
+    memset(pObj->fpIndex, 0, sizeof(pObj->fpIndex));
+
+    for(chId = 0; chId < SAVE_LINK_MAX_CH; chId++)
+    {
+        if(pObj->createArgs.nameDataFile[chId][0] == 0)
+        {
+            continue;
+        }
+
+        pObj->createArgs.nameDataFile[chId][SAVE_LINK_MAX_FILE_NAME-1] = 0;
+        pObj->createArgs.nameIndexFile[chId][SAVE_LINK_MAX_FILE_NAME-1] = 0;
 
-    DupLink_Obj *pObj = (DupLink_Obj *) pTsk->appData;
+        pObj->fpData[chId] = fopen(pObj->createArgs.nameDataFile[chId], "wb");
+        UTILS_assert(pObj->fpData[chId] != NULL);
+
+        pObj->fpIndex[chId] = fopen(pObj->createArgs.nameIndexFile[chId], "w");
+        UTILS_assert(pObj->fpIndex[chId] != NULL);
+    }
+
+    pObj->writeBufFill = 0;
+    pObj->pWriteBuf = NULL;
+    if(pObj->createArgs.writeBufSize)
+    {
+        pObj->pWriteBuf = Utils_memAlloc(UTILS_HEAPID_DDR_CACHED_SR,
+                                         pObj->createArgs.writeBufSize,
+                                         128);
+        UTILS_assert(pObj->pWriteBuf != NULL);
+    }
+
+    status = Utils_queCreate(&pObj->ringQue,
+                             pObj->createArgs.ringDepth,
+                             pObj->ringQueMem,
+                             UTILS_QUE_FLAG_SPSC | UTILS_QUE_FLAG_BLOCK_QUE_GET);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    pObj->writerDoneSem = BspOsal_semCreate(0, TRUE);
+    UTILS_assert(pObj->writerDoneSem != NULL);
+
+    pObj->writerExit = FALSE;
+
+    pObj->writerTsk = BspOsal_taskCreate(
+                        (BspOsal_TaskFuncPtr)SaveLink_writerTskMain,
+                        SAVE_LINK_WRITER_TSK_PRI,
+                        gSaveLink_writerTskStack[pObj->instId],
+                        SAVE_LINK_WRITER_TSK_STACK_SIZE,
+                        pObj);
+    UTILS_assert(pObj->writerTsk != NULL);
+
+    sprintf(tskName, "SAVE_WRITER_%u", (unsigned int)pObj->instId);
+    Utils_prfLoadRegister(pObj->writerTsk, tskName);
+
+    sprintf(tskName, "SAVE_%u", (unsigned int)pObj->instId);
+
+    pObj->linkStatsInfo = Utils_linkStatsCollectorAllocInst(pObj->tskId,
+                                                            tskName);
+    UTILS_assert(NULL != pObj->linkStatsInfo);
+
+    pObj->isFirstFrameRecv = FALSE;
 
-    memcpy(info, &pObj->info, sizeof(*info));
-#endif
     return SYSTEM_LINK_STATUS_SOK;
 }
 
 /**
  *******************************************************************************
- * \brief Function called by links connected to DUP link to return back
- *    buffers
  *
- * \param  ptr      [IN]  Handle to task
- * \param  queId    [IN]  output queue Id
- * \param  pBufList [IN]  A List of buffers returned back to DUP link
+ * \brief Takes buffers from previous link and queues them for writing. When
+ *        ring is full buffer is released to previous link without writing.
+ *
+ * \param  pObj     [IN]  Save link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
  *
- * \return SYSTEM_LINK_STATUS_SOK on success
  *******************************************************************************
-*/
-Int32 SaveLink_putEmptyBuffers(Void * ptr, UInt16 queId,
-                              System_BufferList * pBufList)
+ */
+Int32 SaveLink_drvProcessFrames(SaveLink_Obj *pObj)
 {
-	Int32 status;
-	status = 0;
-#if 0
-    UInt32 bufId;
+    System_LinkInQueParams *pInQueParams = &pObj->createArgs.inQueParams;
+    System_LinkStatistics *linkStatsInfo;
+    System_BufferList bufList;
+    System_BufferList dropBufList;
+    System_Buffer *pBuf;
+    UInt32 bufId, ringCount;
+    Int32 status;
+
+    linkStatsInfo = pObj->linkStatsInfo;
+    UTILS_assert(NULL != linkStatsInfo);
 
-    System_BufferList freeBufferList;
-    System_Buffer *pBuf, *pOrgBuf;
-    Utils_TskHndl *pTsk = (Utils_TskHndl *) ptr;
-    DupLink_Obj *pObj = (DupLink_Obj *) pTsk->appData;
+    Utils_linkStatsCollectorProcessCmd(linkStatsInfo);
 
-    UTILS_assert(queId < DUP_LINK_MAX_OUT_QUE);
-    UTILS_assert(queId < pObj->createArgs.numOutQue);
+    if(pObj->isFirstFrameRecv == FALSE)
+    {
+        Utils_resetLatency(&linkStatsInfo->linkLatency);
+        Utils_resetLatency(&linkStatsInfo->srcToLinkLatency);
+
+        Utils_resetLinkStatistics(&linkStatsInfo->linkStats,
+                                  pObj->inQueInfo.numCh, 0);
+
+        pObj->isFirstFrameRecv = TRUE;
+    }
 
-    freeBufferList.numBuf = 0;
+    linkStatsInfo->linkStats.newDataCmdCount++;
 
-    BspOsal_semWait(pObj->lock, BSP_OSAL_WAIT_FOREVER);
+    System_getLinksFullBuffers(pInQueParams->prevLinkId,
+                               pInQueParams->prevLinkQueId, &bufList);
 
-    pObj->stats.releaseCount[queId] += pBufList->numBuf;
+    dropBufList.numBuf = 0;
 
-    for (bufId = 0; bufId < pBufList->numBuf; bufId++)
+    for(bufId = 0; bufId < bufList.numBuf; bufId++)
     {
-        pBuf = pBufList->buffers[bufId];
+        pBuf = bufList.buffers[bufId];
+        if(pBuf == NULL)
+        {
+            linkStatsInfo->linkStats.inBufErrorCount++;
+            continue;
+        }
 
-        if (pBuf == NULL)
-           continue;
+        pObj->stats.recvCount++;
 
-        pOrgBuf = (System_Buffer *)pBuf->pDupOrgFrame;
-        UTILS_assert(pOrgBuf != NULL);
+        if(pBuf->chNum < SYSTEM_MAX_CH_PER_OUT_QUE)
+        {
+            linkStatsInfo->linkStats.chStats[pBuf->chNum].inBufRecvCount++;
+        }
 
-        pOrgBuf->dupCount--;
+        Utils_updateLatency(&linkStatsInfo->srcToLinkLatency,
+                            pBuf->srcTimestamp);
 
-        if (pOrgBuf->dupCount == 0)
+        status = Utils_quePut(&pObj->ringQue, pBuf, BSP_OSAL_NO_WAIT);
+        if(status != SYSTEM_LINK_STATUS_SOK)
         {
-            freeBufferList.buffers[freeBufferList.numBuf] = pOrgBuf;
-            freeBufferList.numBuf++;
+            /* writer is behind, do not hold up previous link */
+            pObj->stats.dropCountRingFull++;
+            if(pBuf->chNum < SYSTEM_MAX_CH_PER_OUT_QUE)
+            {
+                linkStatsInfo->linkStats.chStats[pBuf->chNum].inBufDropCount++;
+            }
+            dropBufList.buffers[dropBufList.numBuf] = pBuf;
+            dropBufList.numBuf++;
+        }
+        else
+        {
+            if(pBuf->chNum < SYSTEM_MAX_CH_PER_OUT_QUE)
+            {
+                linkStatsInfo->linkStats.chStats[pBuf->chNum].inBufProcessCount++;
+            }
         }
     }
-    pObj->putFrameCount += freeBufferList.numBuf;
 
-    System_putLinksEmptyBuffers(pObj->createArgs.inQueParams.prevLinkId,
-                               pObj->createArgs.inQueParams.prevLinkQueId,
-                               &freeBufferList);
-    BspOsal_semPost(pObj->lock);
+    ringCount = Utils_queGetQueuedCount(&pObj->ringQue);
+    if(ringCount > pObj->stats.maxRingCount)
+    {
+        pObj->stats.maxRingCount = ringCount;
+    }
 
-    status = Utils_bufPutEmpty(&pObj->outFrameQue[queId], pBufList);
-    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-#endif
-    return status;
+    if(dropBufList.numBuf)
+    {
+        System_putLinksEmptyBuffers(pInQueParams->prevLinkId,
+                                    pInQueParams->prevLinkQueId,
+                                    &dropBufList);
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
 }
 
 /**
  *******************************************************************************
- * \brief Function to delete DUP link. This will simply delete all output
- *    queues and the semaphore
  *
- * \param  pObj     [IN]  DUP link instance handle
+ * \brief Print link and recorder statistics
+ *
+ * \param  pObj     [IN]  Save link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
  *
- * \return SYSTEM_LINK_STATUS_SOK on success
  *******************************************************************************
-*/
-Int32 SaveLink_drvDelete(/*DupLink_Obj * pObj*/)
+ */
+Int32 SaveLink_drvPrintStatistics(SaveLink_Obj *pObj)
 {
-	Int32 status;
-	status = 0;
-#if 0
-    UInt32 outId;
+    char tskName[32];
+    UInt32 writeKBps = 0;
+
+    sprintf(tskName, "SAVE_%u", (unsigned int)pObj->instId);
 
+    UTILS_assert(NULL != pObj->linkStatsInfo);
 
-    for (outId = 0; outId < DUP_LINK_MAX_OUT_QUE; outId++)
+    Utils_printLinkStatistics(&pObj->linkStatsInfo->linkStats, tskName, TRUE);
+
+    Utils_printLatency(tskName,
+                       &pObj->linkStatsInfo->linkLatency,
+                       &pObj->linkStatsInfo->srcToLinkLatency,
+                       TRUE);
+
+    if(pObj->stats.writeTime)
     {
-        status = Utils_bufDelete(&pObj->outFrameQue[outId]);
-        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+        writeKBps = (UInt32)((pObj->stats.writeBytes*1000)
+                                /pObj->stats.writeTime);
     }
-    BspOsal_semDelete(&pObj->lock);
-#endif
-    return status;
+
+    Vps_printf(" [%s] Recv = %d, Written = %d, Write errors = %d,"
+               " Dropped (ring full) = %d, Max ring = %d of %d\n",
+               tskName,
+               pObj->stats.recvCount,
+               pObj->stats.writeCount,
+               pObj->stats.writeErrorCount,
+               pObj->stats.dropCountRingFull,
+               pObj->stats.maxRingCount,
+               pObj->createArgs.ringDepth);
+
+    Vps_printf(" [%s] File write = %d KB in %d ms, %d KB/s\n",
+               tskName,
+               (UInt32)(pObj->stats.writeBytes/1024),
+               (UInt32)(pObj->stats.writeTime/1000),
+               writeKBps);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Delete save link, writes buffers left in ring, stops writer task and
+ *        closes files
+ *
+ * \param  pObj     [IN]  Save link instance handle
+ *
+ * \return status   SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 SaveLink_drvDelete(SaveLink_Obj *pObj)
+{
+    Int32 status;
+    UInt32 chId;
+
+    pObj->writerExit = TRUE;
+    Utils_queUnBlock(&pObj->ringQue);
+
+    BspOsal_semWait(pObj->writerDoneSem, BSP_OSAL_WAIT_FOREVER);
+
+    Utils_prfLoadUnRegister(pObj->writerTsk);
+    BspOsal_taskDelete(&pObj->writerTsk);
+    pObj->writerTsk = NULL;
+
+    BspOsal_semDelete(&pObj->writerDoneSem);
+
+    status = Utils_queDelete(&pObj->ringQue);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    for(chId = 0; chId < SAVE_LINK_MAX_CH; chId++)
+    {
+        if(pObj->fpData[chId])
+        {
+            fclose(pObj->fpData[chId]);
+            pObj->fpData[chId] = NULL;
+        }
+        if(pObj->fpIndex[chId])
+        {
+            fclose(pObj->fpIndex[chId]);
+            pObj->fpIndex[chId] = NULL;
+        }
+    }
+
+    if(pObj->pWriteBuf)
+    {
+        Utils_memFree(UTILS_HEAPID_DDR_CACHED_SR,
+                      pObj->pWriteBuf,
+                      pObj->createArgs.writeBufSize);
+        pObj->pWriteBuf = NULL;
+    }
+
+    status = Utils_linkStatsCollectorDeAllocInst(pObj->linkStatsInfo);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    return SYSTEM_LINK_STATUS_SOK;
 }
 
 /**
@@ -349,9 +660,10 @@ Int32 SaveLink_drvDelete(/*DupLink_Obj * pObj*/)
  *
  * \brief This function implements the following.
  *    Accepts commands for
- *     - Creating DUP link
+ *     - Creating Save link
  *     - Arrival of new data
- *     - Deleting DUP link
+ *     - Printing statistics
+ *     - Deleting Save link
  * \param  pTsk [IN] Task Handle
  * \param  pMsg [IN] Message Handle
  *
@@ -359,91 +671,116 @@ Int32 SaveLink_drvDelete(/*DupLink_Obj * pObj*/)
  */
 Void SaveLink_tskMain(struct Utils_TskHndl * pTsk, Utils_MsgHndl * pMsg)
 {
-
-#if 0
     UInt32 cmd = Utils_msgGetCmd(pMsg);
-    Int32 status = 0;
-
-    DupLink_Obj *pObj = (DupLink_Obj*) pTsk->appData;
+    Bool ackMsg, done;
+    Int32 status;
+    SaveLink_Obj *pObj = (SaveLink_Obj *) pTsk->appData;
 
-    switch (cmd)
+    if (cmd != SYSTEM_CMD_CREATE)
     {
-        case SYSTEM_CMD_CREATE:
-            if(pObj->state==SYSTEM_LINK_STATE_IDLE)
-            {
-                status = DupLink_drvCreate(pObj, Utils_msgGetPrm(pMsg));
-                if(status==SYSTEM_LINK_STATUS_SOK)
-                {
-                    pObj->state = SYSTEM_LINK_STATE_RUNNING;
-                }
-            }
-            Utils_tskAckOrFreeMsg(pMsg, status);
-            break;
+        Utils_tskAckOrFreeMsg(pMsg, FVID2_EFAIL);
+        return;
+    }
 
-        case SYSTEM_CMD_NEW_DATA:
-            if(pObj->state==SYSTEM_LINK_STATE_RUNNING)
-            {
-                status = DupLink_drvProcessData(pObj);
-            }
-            Utils_tskAckOrFreeMsg(pMsg, status);
-            break;
+    status = SaveLink_drvCreate(pObj, Utils_msgGetPrm(pMsg));
 
-        case SYSTEM_CMD_DELETE:
-            if(pObj->state==SYSTEM_LINK_STATE_RUNNING)
-            {
-                DupLink_drvDelete(pObj);
-                pObj->state = SYSTEM_LINK_STATE_IDLE;
-            }
-            Utils_tskAckOrFreeMsg(pMsg, status);
-            break;
+    Utils_tskAckOrFreeMsg(pMsg, status);
 
-        default:
-            Utils_tskAckOrFreeMsg(pMsg, status);
+    if (status != SYSTEM_LINK_STATUS_SOK)
+        return;
+
+    pObj->state = SYSTEM_LINK_STATE_CREATED;
+
+    done = FALSE;
+    ackMsg = FALSE;
+
+    while (!done)
+    {
+        status = Utils_tskRecvMsg(pTsk, &pMsg, BSP_OSAL_WAIT_FOREVER);
+        if (status != SYSTEM_LINK_STATUS_SOK)
             break;
+
+        cmd = Utils_msgGetCmd(pMsg);
+
+        switch (cmd)
+        {
+            case SYSTEM_CMD_DELETE:
+                done = TRUE;
+                ackMsg = TRUE;
+                break;
+            case SYSTEM_CMD_NEW_DATA:
+                Utils_tskAckOrFreeMsg(pMsg, status);
+
+                SaveLink_drvProcessFrames(pObj);
+                break;
+            case SYSTEM_CMD_PRINT_STATISTICS:
+                SaveLink_drvPrintStatistics(pObj);
+                Utils_tskAckOrFreeMsg(pMsg, status);
+                break;
+            default:
+                Utils_tskAckOrFreeMsg(pMsg, status);
+                break;
+        }
     }
-#endif
+
+    SaveLink_drvDelete(pObj);
+
+    pObj->state = SYSTEM_LINK_STATE_IDLE;
+
+    if (ackMsg && pMsg != NULL)
+        Utils_tskAckOrFreeMsg(pMsg, status);
+
     return;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Init function for Save link. This function does the following for each
+ *   Save link,
+ *  - Creates a task for the link
+ *  - Registers this link with the system
+ *
+ * \return  SYSTEM_LINK_STATUS_SOK
+ *
+ *******************************************************************************
+ */
 Int32 SaveLink_init()
 {
-	Int32 status;
-	status = 0;
-#if 0
-	System_LinkObj linkObj;
-	UInt32 saveId;
-	DupLink_Obj *pObj;
-	UInt32 procId = System_getSelfProcId();
+    Int32 status;
+    System_LinkObj linkObj;
+    UInt32 saveId;
+    SaveLink_Obj *pObj;
 
-	for(dupId = 0; dupId < DUP_LINK_OBJ_MAX; dupId++)
-	{
-		pObj = &gDupLink_obj[dupId];
+    for (saveId = 0; saveId < SAVE_LINK_OBJ_MAX; saveId++)
+    {
+        pObj = &gSaveLink_obj[saveId];
 
-		memset(pObj, 0, sizeof(*pObj));
+        memset(pObj, 0, sizeof(*pObj));
 
-		pObj->tskId = SYSTEM_MAKE_LINK_ID(procId,
-										  SYSTEM_LINK_ID_DUP_0 + dupId);
+        pObj->instId = saveId;
+        pObj->tskId = SYSTEM_LINK_ID_SAVE_0 + saveId;
+        pObj->state = SYSTEM_LINK_STATE_IDLE;
 
-		pObj->state = SYSTEM_LINK_STATE_IDLE;
+        memset(&linkObj, 0, sizeof(linkObj));
+        linkObj.pTsk = &pObj->tsk;
+        linkObj.linkGetFullBuffers= NULL;
+        linkObj.linkPutEmptyBuffers= NULL;
+        linkObj.getLinkInfo = NULL;
 
-		linkObj.pTsk = &pObj->tsk;
-		linkObj.linkGetFullBuffers = DupLink_getFullBuffers;
-		linkObj.linkPutEmptyBuffers = DupLink_putEmptyBuffers;
-		linkObj.getLinkInfo = DupLink_getLinkInfo;
+        System_registerLink(pObj->tskId, &linkObj);
 
-		System_registerLink(pObj->tskId, &linkObj);
+        status = SaveLink_tskCreate(saveId);
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+    }
 
-		status = DupLink_tskCreate(dupId);
-		UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-	}
-#endif
-	return status;
+    return status;
 }
 
 /**
  *******************************************************************************
  *
- * \brief De-init function for DUP link. This function de-registers this link
+ * \brief De-init function for Save link. This function de-registers this link
  *  from the system
  *
  * \return  SYSTEM_LINK_STATUS_SOK
@@ -451,14 +788,12 @@ Int32 SaveLink_init()
  *******************************************************************************
  */
 Int32 SaveLink_deInit()
- {
-#if 0
-    UInt32 dupId;
+{
+    UInt32 saveId;
 
-    for(dupId = 0; dupId < DUP_LINK_OBJ_MAX; dupId++)
+    for (saveId = 0; saveId < SAVE_LINK_OBJ_MAX; saveId++)
     {
-        Utils_tskDelete(&gDupLink_obj[dupId].tsk);
+        Utils_tskDelete(&gSaveLink_obj[saveId].tsk);
     }
-#endif
     return SYSTEM_LINK_STATUS_SOK;
- }
+}
@@ -1,7 +1,7 @@
 /*
  *******************************************************************************
  *
- * Copyright (C) 2013 Texas Instruments Incorporated - http://www.ti.com/
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
  * ALL RIGHTS RESERVED
  *
  *******************************************************************************
@@ -11,7 +11,7 @@
  *  INCLUDE FILES
  *******************************************************************************
  */
-//#include "saveLink_priv.h"
+#include "saveLink_priv.h"
 
 /**
  *******************************************************************************
@@ -22,31 +22,26 @@
  *
  *******************************************************************************
 */
-Int32 SaveLink_tskMain(UInt32 instId)
+Int32 SaveLink_tskCreate(UInt32 instId)
 {
-	Int32 status;
-
-	status = 0;
-#if 0
-
-    DupLink_Obj        *pObj;
+    Int32                status;
+    SaveLink_Obj        *pObj;
     Utils_TskMultiMbxHndl *pMultiMbxHndl;
 
-    pObj = &gDupLink_obj[instId];
+    pObj = &gSaveLink_obj[instId];
 
     pMultiMbxHndl = System_getTskMultiMbxHndl();
 
     /*
      * Create link task, task remains in IDLE state.
-     * DupLink_tskMain is called when a message command is received.
+     * SaveLink_tskMain is called when a message command is received.
      */
     status = Utils_tskMultiMbxCreate(&pObj->tsk,
                              pMultiMbxHndl,
-                             DupLink_tskMain,
+                             SaveLink_tskMain,
                              UTILS_TASK_MULTI_MBX_PRI_HIGHEST,
                              pObj);
     UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
-#endif
+
     return status;
 }
-
@@ -52,7 +52,7 @@ extern "C"
 #include <include/link_api/nullLink.h>
 #include <include/link_api/nullSrcLink.h>
 #include <include/link_api/avbRxLink.h>
-#include <include/link_api/saveLink.h> //ryuhs74@20151027 - Add Save Link Header File Include
+#include <include/link_api/saveLink.h>
 
 
 /*******************************************************************************
@@ -0,0 +1,186 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file network_codec.h Lossless codec of
+ *       NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED payload
+ *
+ *       See networkCtrl_if.h for the format. Same code is used by the
+ *       network tools on PC, see tools/network_tools/common/src/network_codec.c
+ *
+ *******************************************************************************
+ */
+
+#ifndef _NETWORK_CODEC_H_
+#define _NETWORK_CODEC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ *  Include files
+ *******************************************************************************
+ */
+
+#include <include/link_api/system.h>
+#include <include/link_api/networkCtrl_if.h>
+
+/*******************************************************************************
+ *  Defines
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \brief Consecutive frames not made smaller after which encoding is skipped
+ *
+ *******************************************************************************
+ */
+#define NETWORK_CODEC_BACKOFF_RAW_FRAMES    (4U)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Frames sent without trying to encode, after
+ *        NETWORK_CODEC_BACKOFF_RAW_FRAMES frames were not made smaller
+ *
+ *******************************************************************************
+ */
+#define NETWORK_CODEC_BACKOFF_SKIP_FRAMES   (60U)
+
+/*******************************************************************************
+ *  Data structures
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \brief Encode backoff state of a channel
+ *
+ *        Encoding takes as long on content that does not compress, e.g
+ *        noise, as on content that does. After a few such frames a channel
+ *        skips encoding for a while, then tries again.
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    UInt32 rawCount;
+    /**< Consecutive frames which were not made smaller */
+
+    UInt32 skipCount;
+    /**< Frames still to be sent without trying to encode */
+
+} NetworkCodec_Backoff;
+
+/*******************************************************************************
+ *  Functions
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \brief Max size of compressed payload, including NetworkCodec_Header
+ *
+ * \param payloadType  [IN] NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV or
+ *                          NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV
+ * \param width        [IN] Frame width in pixels
+ * \param height       [IN] Frame height in lines
+ *
+ * \return Size in bytes, 0 if format is not supported
+ *
+ *******************************************************************************
+ */
+UInt32 NetworkCodec_getMaxSize(UInt32 payloadType, UInt32 width, UInt32 height);
+
+/**
+ *******************************************************************************
+ *
+ * \brief Compress a frame
+ *
+ * \param payloadType  [IN] Format of the frame
+ * \param width        [IN] Frame width in pixels
+ * \param height       [IN] Frame height in lines
+ * \param srcAddr      [IN] Address of each plane
+ * \param srcPitch     [IN] Pitch of each plane
+ * \param pDst         [IN] Output buffer
+ * \param dstSize      [IN] Output buffer size, must be at least
+ *                          NetworkCodec_getMaxSize()
+ * \param pEncSize     [OUT] Size of compressed payload
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NetworkCodec_encode(UInt32 payloadType, UInt32 width, UInt32 height,
+                          UInt8 *srcAddr[], UInt32 srcPitch[],
+                          UInt8 *pDst, UInt32 dstSize, UInt32 *pEncSize);
+
+/**
+ *******************************************************************************
+ *
+ * \brief Decompress a frame
+ *
+ *        Fails if the payload is of another format or size than expected
+ *        or is corrupted
+ *
+ * \param pSrc         [IN] Compressed payload
+ * \param srcSize      [IN] Size of compressed payload
+ * \param payloadType  [IN] Expected format of the frame
+ * \param width        [IN] Expected frame width in pixels
+ * \param height       [IN] Expected frame height in lines
+ * \param dstAddr      [IN] Address of each plane
+ * \param dstPitch     [IN] Pitch of each plane
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success
+ *
+ *******************************************************************************
+ */
+Int32 NetworkCodec_decode(UInt8 *pSrc, UInt32 srcSize,
+                          UInt32 payloadType, UInt32 width, UInt32 height,
+                          UInt8 *dstAddr[], UInt32 dstPitch[]);
+
+/**
+ *******************************************************************************
+ *
+ * \brief Check if encoding of the next frame of a channel is to be skipped
+ *
+ * \param pBackoff     [IN] Backoff state of the channel, zero to start
+ *
+ * \return TRUE if frame is to be sent without encoding
+ *
+ *******************************************************************************
+ */
+Bool NetworkCodec_backoffIsSkip(NetworkCodec_Backoff *pBackoff);
+
+/**
+ *******************************************************************************
+ *
+ * \brief Update backoff state with result of encoding a frame
+ *
+ * \param pBackoff     [IN] Backoff state of the channel
+ * \param isSmaller    [IN] TRUE if encoded frame was smaller and was sent
+ *
+ *******************************************************************************
+ */
+Void NetworkCodec_backoffUpdate(NetworkCodec_Backoff *pBackoff, Bool isSmaller);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/* @} */
@@ -137,6 +137,7 @@
 #include <ti/sdo/edma3/drv/edma3_drv.h>
 #include <ti/sdo/edma3/rm/edma3_rm.h>
 #include <ti/sdo/edma3/rm/src/edma3resmgr.h>
+#include <src/utils_common/include/utils_dma_txlist.h>
 
 /*******************************************************************************
  *  Defines
@@ -150,20 +151,6 @@
  */
 #define UTILS_DMA_DEFAULT_EVENT_Q   (1)
 
-/**
- *******************************************************************************
- * \brief Max pitch that is possible with EDMA
- *******************************************************************************
- */
-#define UTILS_DMA_MAX_PITCH         (32767)
-
-/**
- *******************************************************************************
- * \brief Max planes that can be used DMA's via these DMA APIs
- *******************************************************************************
- */
-#define UTILS_DMA_MAX_PLANES        (2)
-
 /**
  *******************************************************************************
  * \brief Macro to generate YUV422I pattern for a 32-bit value
@@ -241,106 +228,16 @@ typedef struct
 
 /**
  *******************************************************************************
- * \brief Copy/Fill 2D API parameters
+ *
+ * \brief Callback called when all transfers of a list submitted with
+ *        Utils_dmaTxListSubmit() are complete
+ *
+ *        Called from EDMA completion interrupt context, it should only do
+ *        things like posting a semaphore or sending a command to a task
+ *
  *******************************************************************************
  */
-typedef struct
-{
-    UInt32 dataFormat;
-    /**< Following data formats are supported,
-     *   - SYSTEM_DF_RAW08 - can be used any 8-bit data format DMA copy
-     *   - SYSTEM_DF_RAW16 - can be used any 16-bit data format DMA copy
-     *                       like YUV422I or RGB565
-     *   - SYSTEM_DF_RAW24 - can be used for RGB24-bit data format DMA copy
-     *                       like RGB888
-     *   - SYSTEM_DF_YUV420SP_UV
-     */
-
-    Ptr    destAddr[UTILS_DMA_MAX_PLANES];
-    /**< Physical address of destination buffer
-     *   - For max efficiency recommended to be 32-byte aligned
-     */
-
-    UInt32 destPitch[UTILS_DMA_MAX_PLANES];
-    /**< Pitch in bytes of the destination buffer
-     *   - For max efficiency recommended to be 32-byte aligned
-     */
-
-    UInt32 destStartX;
-    /**< Start position, X-direction in destination buffer
-     *   - Specfied in unit of pixels
-     *   - MUST be multiple of 2 for YUV420SP
-     *   - For max efficiency recommended to be 32-byte aligned
-     */
-
-    UInt32 destStartY;
-    /**< Start position, Y-direction in destination buffer
-     *   - Specfied in unit of lines
-     *   - MUST be multiple of 2 of YUV420SP data format
-     */
-
-    UInt32 width;
-    /**< Width of data to fill in destination buffer
-     *   - Specfied in unit of pixels
-     *   - MUST be multiple of 2 for YUV420SP
-     *   - For max efficiency recommended to be 32-byte aligned
-     */
-
-    UInt32 height;
-    /**< height of data to fill in destination buffer
-     *   - Specfied in unit of lines
-     *   - MUST be multiple of 2 for YUV420SP
-     */
-
-    Ptr    srcAddr[UTILS_DMA_MAX_PLANES];
-    /**<
-     *   For Utils_dmaCopy2D(),
-     *   Physical address of a source buffer
-     *   - For max efficiency recommended to be 32-byte aligned
-     *
-     *   For Utils_dmaFill2D(),
-     *   Physical address of a source line buffer
-     *   - User should make sure the buffer pointed to by srcAddr[]
-     *     can hold one line of size 'width' pixels
-     *   - User should pre-fill this buffer with the value he wants to fill
-     *     across the buffer
-     *   - For max efficiency recommended to be 32-byte aligned
-     */
-
-    UInt32 srcPitch[UTILS_DMA_MAX_PLANES];
-    /**<
-     *   For Utils_dmaCopy2D(),
-     *   Pitch in bytes of the source buffer
-     *   - For max efficiency recommended to be 32-byte aligned
-     *
-     *   For Utils_dmaFill2D(),
-     *   - NOT USED
-     */
-
-    UInt32 srcStartX;
-    /**<
-     *   For Utils_dmaCopy2D(),
-     *   Start position, X-direction in source buffer
-     *   - Specfied in unit of pixels
-     *   - MUST be multiple of 2 for YUV420SP
-     *   - For max efficiency recommended to be 32-byte aligned
-     *
-     *   For Utils_dmaFill2D(),
-     *   - NOT USED
-     */
-
-    UInt32 srcStartY;
-    /**<
-     *   For Utils_dmaCopy2D(),
-     *   Start position, Y-direction in source buffer
-     *   - Specfied in unit of lines
-     *   - MUST be multiple of 2 of YUV420SP data format
-     *
-     *   For Utils_dmaFill2D(),
-     *   - NOT USED
-     */
-
-} Utils_DmaCopyFill2D;
+typedef Void (*Utils_DmaTxListDoneCb)(Ptr appData);
 
 /**
  *******************************************************************************
@@ -397,6 +294,16 @@ typedef struct {
     EDMA3_DRV_Handle hEdma;
     /**< Handle to EDMA controller associated with this logical DMA channel */
 
+    Bool   txListPending;
+    /**< A transfer list is submitted and Utils_dmaTxListWait() is yet to
+     *   be called */
+
+    volatile Utils_DmaTxListDoneCb txListDoneCb;
+    /**< Callback for the transfer list in flight, NULL when none */
+
+    Ptr    txListDoneCbAppData;
+    /**< Argument for txListDoneCb */
+
 } Utils_DmaChObj;
 
 /**
@@ -479,6 +386,13 @@ Int32 Utils_dmaCopy2D(Utils_DmaChObj *pObj, Utils_DmaCopyFill2D *pPrm,
 
 Int32 Utils_dmaCopy1D(Utils_DmaChObj *pObj, Utils_DmaCopy1D *pPrm);
 
+Int32 Utils_dmaTxListSubmit(Utils_DmaChObj *pObj,
+                            const Utils_DmaTxList *pList,
+                            Utils_DmaTxListDoneCb doneCb,
+                            Ptr appData);
+
+Int32 Utils_dmaTxListWait(Utils_DmaChObj *pObj);
+
 Int32 Utils_dmaDeleteCh(Utils_DmaChObj *pObj);
 
 EDMA3_DRV_Handle Utils_dmaGetEdma3Hndl(UInt32 edmaInstId);
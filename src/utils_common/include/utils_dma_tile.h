@@ -0,0 +1,283 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \ingroup UTILS_API
+ * \defgroup UTILS_DMA_TILE_API DMA ping-pong tiling APIs
+ *
+ * \brief  APIs to stream a frame region tile by tile through small buffers,
+ *         e.g in L2 or OCMC, with the DMA of the next tile running while the
+ *         current tile is processed
+ *
+ *         Tile geometry and the frames to read and write are described once
+ *         in Utils_DmaTilePrm. Each stream is either read from a frame into
+ *         tile buffers (UTILS_DMA_TILE_DIR_IN) or written from tile buffers
+ *         into a frame (UTILS_DMA_TILE_DIR_OUT). All streams share the same
+ *         tile grid. Every stream has two tile buffers, used as ping and
+ *         pong.
+ *
+ *         Typical use in a kernel,
+ *         \code
+ *         Utils_dmaTileStart(&tileObj);
+ *         while(Utils_dmaTileNext(&tileObj, &tile))
+ *         {
+ *             kernel(tile.bufAddr[0][0], tile.bufAddr[1][0],
+ *                    tile.width, tile.height);
+ *         }
+ *         status = tileObj.status;
+ *         \endcode
+ *
+ *         When Utils_dmaTileNext() returns tile 'n', input of tile 'n+1' and
+ *         output of tile 'n-1' are in flight. Output of the last tile is
+ *         written before Utils_dmaTileNext() returns FALSE.
+ *
+ *         Transfers are done as one DMA transfer list per step on the
+ *         logical DMA channel given by user. When no channel is given, or
+ *         when UTILS_DMA_TILE_HOST_EMULATION is defined at build time,
+ *         transfers are done with memcpy via Utils_dmaTxListCpuRun(), so
+ *         that kernels using this API can be built and tested on a host PC.
+ *
+ * @{
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file utils_dma_tile.h
+ *
+ * \brief DMA ping-pong tiling API
+ *
+ * \version 0.0 (Oct 2015) : First version
+ *
+ *******************************************************************************
+ */
+
+#ifndef _UTILS_DMA_TILE_H_
+#define _UTILS_DMA_TILE_H_
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <src/utils_common/include/utils_dma_txlist.h>
+
+/*******************************************************************************
+ *  Defines
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Max streams, i.e inputs plus outputs, of a tile object
+ *******************************************************************************
+ */
+#define UTILS_DMA_TILE_MAX_STREAMS      (4)
+
+/**
+ *******************************************************************************
+ * \brief Number of tile buffers per stream, ping and pong
+ *******************************************************************************
+ */
+#define UTILS_DMA_TILE_NUM_BUF          (2)
+
+/**
+ *******************************************************************************
+ * \brief Max descriptors in one step, create the DMA channel with
+ *        Utils_DmaChCreateParams.maxTransfers set to the descriptors needed
+ *        by the streams in use, at most this value, so that every step is a
+ *        single chained transfer
+ *******************************************************************************
+ */
+#define UTILS_DMA_TILE_MAX_DESC         (UTILS_DMA_TILE_MAX_STREAMS \
+                                            * UTILS_DMA_TXLIST_DESC_PER_2D)
+
+/*******************************************************************************
+ *  Enum's
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Direction of a tile stream
+ *******************************************************************************
+ */
+typedef enum {
+
+    UTILS_DMA_TILE_DIR_IN = 0,
+    /**< Frame to tile buffer, done before tile is processed */
+
+    UTILS_DMA_TILE_DIR_OUT,
+    /**< Tile buffer to frame, done after tile is processed */
+
+    UTILS_DMA_TILE_DIR_FORCE32BITS = 0x7FFFFFFF
+    /**< To make sure enum is 32 bits */
+
+} Utils_DmaTileDir;
+
+/*******************************************************************************
+ *  Data structure's
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief One input or output of a tile object
+ *******************************************************************************
+ */
+typedef struct {
+
+    UInt32 dir;
+    /**< Direction, see Utils_DmaTileDir */
+
+    UInt32 dataFormat;
+    /**< SYSTEM_DF_RAW08, SYSTEM_DF_RAW16, SYSTEM_DF_RAW24 or
+     *   SYSTEM_DF_YUV420SP_UV, see Utils_DmaCopyFill2D */
+
+    Ptr    frameAddr[UTILS_DMA_MAX_PLANES];
+    /**< Frame buffer, can be changed for every frame with
+     *   Utils_dmaTileSetFrame() */
+
+    UInt32 framePitch[UTILS_DMA_MAX_PLANES];
+    /**< Pitch in bytes of frame buffer */
+
+    UInt32 frameStartX;
+    /**< Position of region in frame, in pixels */
+
+    UInt32 frameStartY;
+    /**< Position of region in frame, in lines */
+
+    Ptr    tileBufAddr[UTILS_DMA_TILE_NUM_BUF][UTILS_DMA_MAX_PLANES];
+    /**< Ping and pong tile buffers */
+
+    UInt32 tileBufPitch[UTILS_DMA_MAX_PLANES];
+    /**< Pitch in bytes of tile buffers, atleast tileWidth pixels */
+
+} Utils_DmaTileStreamPrm;
+
+/**
+ *******************************************************************************
+ * \brief Tile object parameters
+ *******************************************************************************
+ */
+typedef struct {
+
+    Ptr    hDmaCh;
+    /**< Utils_DmaChObj to use, created by user. Channel is kept locked from
+     *   Utils_dmaTileStart() till Utils_dmaTileNext() returns FALSE, so it
+     *   MUST NOT be used for anything else in between.
+     *   NULL: copy with CPU */
+
+    UInt32 width;
+    /**< Width of region to process, in pixels */
+
+    UInt32 height;
+    /**< Height of region to process, in lines */
+
+    UInt32 tileWidth;
+    /**< Tile width in pixels, tiles in last column can be narrower */
+
+    UInt32 tileHeight;
+    /**< Tile height in lines, tiles in last row can be shorter.
+     *   MUST be multiple of 2 for SYSTEM_DF_YUV420SP_UV */
+
+    UInt32 numStreams;
+    /**< Valid entries in stream[] */
+
+    Utils_DmaTileStreamPrm stream[UTILS_DMA_TILE_MAX_STREAMS];
+    /**< Inputs and outputs */
+
+} Utils_DmaTilePrm;
+
+/**
+ *******************************************************************************
+ * \brief Tile returned by Utils_dmaTileNext()
+ *******************************************************************************
+ */
+typedef struct {
+
+    UInt32 tileId;
+    /**< Tile index in raster order */
+
+    UInt32 startX;
+    /**< Position of tile in region, in pixels */
+
+    UInt32 startY;
+    /**< Position of tile in region, in lines */
+
+    UInt32 width;
+    /**< Tile width in pixels */
+
+    UInt32 height;
+    /**< Tile height in lines */
+
+    Ptr    bufAddr[UTILS_DMA_TILE_MAX_STREAMS][UTILS_DMA_MAX_PLANES];
+    /**< Tile buffer of each stream. For input streams it has the input
+     *   tile, for output streams the output tile is to be written here */
+
+} Utils_DmaTileInfo;
+
+/**
+ *******************************************************************************
+ *
+ * \brief Tile object
+ *
+ *        - User should not set or modify any of the fields in this structure
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    Utils_DmaTilePrm prm;
+    /**< Parameters */
+
+    UInt32 numTilesX;
+    /**< Tiles in a row */
+
+    UInt32 numTiles;
+    /**< Tiles in region */
+
+    UInt32 curTile;
+    /**< Tile to return next */
+
+    Bool   isPending;
+    /**< A transfer list is in flight on the DMA channel */
+
+    Int32  status;
+    /**< SYSTEM_LINK_STATUS_SOK or first error since Utils_dmaTileStart() */
+
+    Utils_DmaTxList txList;
+    /**< Transfers of current step */
+
+    Utils_DmaTxDesc txDesc[UTILS_DMA_TILE_MAX_DESC];
+    /**< Descriptor memory for txList */
+
+} Utils_DmaTileObj;
+
+/*******************************************************************************
+ *  Functions
+ *******************************************************************************
+ */
+
+Int32 Utils_dmaTileInit(Utils_DmaTileObj *pObj, const Utils_DmaTilePrm *pPrm);
+
+Int32 Utils_dmaTileSetFrame(Utils_DmaTileObj *pObj,
+                            UInt32 streamId,
+                            Ptr frameAddr[UTILS_DMA_MAX_PLANES]);
+
+Int32 Utils_dmaTileStart(Utils_DmaTileObj *pObj);
+
+Bool  Utils_dmaTileNext(Utils_DmaTileObj *pObj, Utils_DmaTileInfo *pTile);
+
+#endif
+
+/* @} */
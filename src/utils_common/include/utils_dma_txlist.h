@@ -0,0 +1,268 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \ingroup UTILS_API
+ * \defgroup UTILS_DMA_TXLIST_API DMA transfer list APIs
+ *
+ * \brief  APIs to build a list of 2D copy/fill transfers
+ *
+ *         A transfer list is an array of descriptors, one per EDMA PaRAM,
+ *         built from Utils_DmaCopyFill2D parameters. The list is submitted
+ *         in one go with Utils_dmaTxListSubmit(), which links and chains the
+ *         PaRAMs so that there is a single completion wait, or a single
+ *         completion callback, for the whole list.
+ *
+ *         This file does not depend on EDMA driver and has a CPU model of
+ *         the transfer list, Utils_dmaTxListCpuRun(). Descriptor generation
+ *         can hence be compiled, checked and benchmarked on a host PC by
+ *         comparing the result of the CPU model against a reference copy.
+ *
+ * @{
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file utils_dma_txlist.h
+ *
+ * \brief DMA transfer list API
+ *
+ * \version 0.0 (Oct 2015) : First version
+ *
+ *******************************************************************************
+ */
+
+#ifndef _UTILS_DMA_TXLIST_H_
+#define _UTILS_DMA_TXLIST_H_
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <include/link_api/system.h>
+
+/*******************************************************************************
+ *  Defines
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Max pitch that is possible with EDMA
+ *******************************************************************************
+ */
+#define UTILS_DMA_MAX_PITCH         (32767)
+
+/**
+ *******************************************************************************
+ * \brief Max planes that can be used DMA's via these DMA APIs
+ *******************************************************************************
+ */
+#define UTILS_DMA_MAX_PLANES        (2)
+
+/**
+ *******************************************************************************
+ * \brief Max descriptors generated for one Utils_DmaCopyFill2D, use this to
+ *        size the descriptor array of a transfer list
+ *******************************************************************************
+ */
+#define UTILS_DMA_TXLIST_DESC_PER_2D    (UTILS_DMA_MAX_PLANES)
+
+/*******************************************************************************
+ *  Data structure's
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Copy/Fill 2D API parameters
+ *******************************************************************************
+ */
+typedef struct
+{
+    UInt32 dataFormat;
+    /**< Following data formats are supported,
+     *   - SYSTEM_DF_RAW08 - can be used any 8-bit data format DMA copy
+     *   - SYSTEM_DF_RAW16 - can be used any 16-bit data format DMA copy
+     *                       like YUV422I or RGB565
+     *   - SYSTEM_DF_RAW24 - can be used for RGB24-bit data format DMA copy
+     *                       like RGB888
+     *   - SYSTEM_DF_YUV420SP_UV
+     */
+
+    Ptr    destAddr[UTILS_DMA_MAX_PLANES];
+    /**< Physical address of destination buffer
+     *   - For max efficiency recommended to be 32-byte aligned
+     */
+
+    UInt32 destPitch[UTILS_DMA_MAX_PLANES];
+    /**< Pitch in bytes of the destination buffer
+     *   - For max efficiency recommended to be 32-byte aligned
+     */
+
+    UInt32 destStartX;
+    /**< Start position, X-direction in destination buffer
+     *   - Specfied in unit of pixels
+     *   - MUST be multiple of 2 for YUV420SP
+     *   - For max efficiency recommended to be 32-byte aligned
+     */
+
+    UInt32 destStartY;
+    /**< Start position, Y-direction in destination buffer
+     *   - Specfied in unit of lines
+     *   - MUST be multiple of 2 of YUV420SP data format
+     */
+
+    UInt32 width;
+    /**< Width of data to fill in destination buffer
+     *   - Specfied in unit of pixels
+     *   - MUST be multiple of 2 for YUV420SP
+     *   - For max efficiency recommended to be 32-byte aligned
+     */
+
+    UInt32 height;
+    /**< height of data to fill in destination buffer
+     *   - Specfied in unit of lines
+     *   - MUST be multiple of 2 for YUV420SP
+     */
+
+    Ptr    srcAddr[UTILS_DMA_MAX_PLANES];
+    /**<
+     *   For Utils_dmaCopy2D(),
+     *   Physical address of a source buffer
+     *   - For max efficiency recommended to be 32-byte aligned
+     *
+     *   For Utils_dmaFill2D(),
+     *   Physical address of a source line buffer
+     *   - User should make sure the buffer pointed to by srcAddr[]
+     *     can hold one line of size 'width' pixels
+     *   - User should pre-fill this buffer with the value he wants to fill
+     *     across the buffer
+     *   - For max efficiency recommended to be 32-byte aligned
+     */
+
+    UInt32 srcPitch[UTILS_DMA_MAX_PLANES];
+    /**<
+     *   For Utils_dmaCopy2D(),
+     *   Pitch in bytes of the source buffer
+     *   - For max efficiency recommended to be 32-byte aligned
+     *
+     *   For Utils_dmaFill2D(),
+     *   - NOT USED
+     */
+
+    UInt32 srcStartX;
+    /**<
+     *   For Utils_dmaCopy2D(),
+     *   Start position, X-direction in source buffer
+     *   - Specfied in unit of pixels
+     *   - MUST be multiple of 2 for YUV420SP
+     *   - For max efficiency recommended to be 32-byte aligned
+     *
+     *   For Utils_dmaFill2D(),
+     *   - NOT USED
+     */
+
+    UInt32 srcStartY;
+    /**<
+     *   For Utils_dmaCopy2D(),
+     *   Start position, Y-direction in source buffer
+     *   - Specfied in unit of lines
+     *   - MUST be multiple of 2 of YUV420SP data format
+     *
+     *   For Utils_dmaFill2D(),
+     *   - NOT USED
+     */
+
+} Utils_DmaCopyFill2D;
+
+/**
+ *******************************************************************************
+ *
+ * \brief One transfer of a transfer list, maps to one EDMA PaRAM
+ *
+ *        Transfer is AB-synchronized with CCNT = 1, i.e 'bCnt' lines of
+ *        'aCnt' bytes. Line pitch is signed, as in EDMA, and is interpreted
+ *        as a 16-bit value.
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    Ptr    srcAddr;
+    /**< Address of first byte of first line to read */
+
+    Ptr    destAddr;
+    /**< Address of first byte of first line to write */
+
+    Int32  srcBIdx;
+    /**< Source line pitch in bytes, 0 to read same line again for fill */
+
+    Int32  destBIdx;
+    /**< Destination line pitch in bytes */
+
+    UInt32 aCnt;
+    /**< Bytes per line */
+
+    UInt32 bCnt;
+    /**< Number of lines */
+
+} Utils_DmaTxDesc;
+
+/**
+ *******************************************************************************
+ *
+ * \brief Transfer list
+ *
+ *        Descriptor memory is given by user in Utils_dmaTxListInit(), list
+ *        can be reset and built again for every frame without any memory
+ *        allocation
+ *
+ *******************************************************************************
+ */
+typedef struct {
+
+    Utils_DmaTxDesc *pDesc;
+    /**< Descriptor array */
+
+    UInt32 maxDesc;
+    /**< Number of elements in pDesc[] */
+
+    UInt32 numDesc;
+    /**< Number of valid descriptors in pDesc[] */
+
+} Utils_DmaTxList;
+
+/*******************************************************************************
+ *  Functions
+ *******************************************************************************
+ */
+
+Int32 Utils_dmaTxListInit(Utils_DmaTxList *pList,
+                          Utils_DmaTxDesc *pDesc,
+                          UInt32 maxDesc);
+
+Void Utils_dmaTxListReset(Utils_DmaTxList *pList);
+
+Int32 Utils_dmaTxListAdd2D(Utils_DmaTxList *pList,
+                           const Utils_DmaCopyFill2D *pInfo,
+                           Bool fillData);
+
+UInt32 Utils_dmaTxListGetBytes(const Utils_DmaTxList *pList);
+
+Int32 Utils_dmaTxListCpuRun(const Utils_DmaTxList *pList);
+
+#endif
+
+/* @} */
@@ -118,6 +118,11 @@ Int32  Utils_ipcQueWrite(Utils_IpcQueHandle * handle,
                             volatile UInt8 *data,
                             volatile UInt32 dataSize);
 
+Int32  Utils_ipcQueWriteMulti(Utils_IpcQueHandle * handle,
+                            volatile UInt8 *data,
+                            UInt32 dataSize,
+                            UInt32 *numElements);
+
 Int32  Utils_ipcQueRead(Utils_IpcQueHandle * handle,
                             volatile UInt8 *data,
                             volatile UInt32 dataSize);
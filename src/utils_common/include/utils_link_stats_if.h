@@ -45,6 +45,7 @@ extern "C" {
 #include <include/link_api/system.h>
 #include <src/utils_common/include/utils_stat_collector.h>
 #include <src/utils_common/include/utils_mem.h>
+#include <include/link_api/networkCtrl_if.h>
 
 /*******************************************************************************
  *  Defines
@@ -236,6 +237,8 @@ typedef struct
     /**< Structure to find out min, max and average latency from
      *   source to this link
      */
+    Utils_LinkPhaseStats phaseStats;
+    /**< CPU time spent by the link in framework and processing phases */
     System_LinkStatsCmdObj srcToLinkCmdObj;
     /**< Link Stats Command Queue, used to send/receive command from
          monitor thread to Link */
@@ -460,6 +463,41 @@ System_LinkStatsPrfLoadObj *Utils_linkStatsGetGetMaxPrfLoadInst(
     uint32_t coreId,
     uint32_t *maxLoadInst);
 
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function to take a binary snapshot of all statistics.
+ *
+ *          Copies the link statistics, latency, task load, core load and
+ *          heap information of all cores from the shared memory into
+ *          the format defined by NetworkCtrl_LinkStatsHeader in
+ *          networkCtrl_if.h. Statistics are not reset by this API.
+ *
+ *          Core load is copied as last updated by each core, the caller
+ *          should send LINK_STATS_CMD_COPY_CORE_LOAD before this API
+ *          if fresh load values are needed.
+ *
+ *  \param  pBuf        Buffer into which snapshot is written
+ *  \param  bufSize     Size of pBuf in bytes
+ *  \param  coreFlags   NETWORK_CTRL_LINK_STATS_CORE_FLAG_* for each core,
+ *                      can be NULL
+ *
+ *  \return Size of snapshot in bytes, 0 if pBuf is too small
+ *
+ *******************************************************************************
+ */
+UInt32 Utils_linkStatsCollectorGetSnapshot(UInt8 *pBuf, UInt32 bufSize,
+                                           UInt32 *coreFlags);
+
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function returns max size of a snapshot in bytes
+ *
+ *******************************************************************************
+ */
+UInt32 Utils_linkStatsCollectorGetSnapshotMaxSize(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
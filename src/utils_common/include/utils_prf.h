@@ -90,28 +90,98 @@ typedef Void(*Utils_loadUpdate) (Utils_PrfLoad *);
  *
  *  \brief  Structure containing latency information for a task.
  *
+ *          Values are kept as 32-bit word pairs so that the layout is same
+ *          on all cores, the structure is read by other cores from link
+ *          statistics shared memory. Lower word comes first, so a pair is
+ *          also a little endian 64-bit value, which cores with 64-bit
+ *          loads and stores update as one.
+ *
+ *          The link updating the stats is the only writer. seqCount is odd
+ *          while an update is in progress, readers on other cores should use
+ *          Utils_getLatency() to get a consistent copy.
+ *
  *******************************************************************************
  */
 typedef struct
 {
-    uint32_t maxLatencyHi;
-    /**< Upper 32 bits of Maximum latency for this link */
     uint32_t maxLatencyLo;
     /**< Lower 32 bits of Maximum latency for this link */
-    uint32_t minLatencyHi;
-    /**< Upper 32 bits of Minimum latency for this link */
+    uint32_t maxLatencyHi;
+    /**< Upper 32 bits of Maximum latency for this link */
     uint32_t minLatencyLo;
     /**< Lower 32 bits of Minimum latency for this link */
-    uint32_t accumulatedLatencyHi;
-    /**< Upper 32 bis of Accumulated latency added for every frame */
+    uint32_t minLatencyHi;
+    /**< Upper 32 bits of Minimum latency for this link */
     uint32_t accumulatedLatencyLo;
     /**< Lower 32 bis of Accumulated latency added for every frame */
-    uint32_t countHi;
-    /**< Upper 32 bits of Number of times latency update is called */
+    uint32_t accumulatedLatencyHi;
+    /**< Upper 32 bis of Accumulated latency added for every frame */
     uint32_t countLo;
     /**< Lower 32 bits of Number of times latency update is called */
+    uint32_t countHi;
+    /**< Upper 32 bits of Number of times latency update is called */
+    volatile uint32_t seqCount;
+    /**< Incremented before and after every update */
 } Utils_LatencyStats;
 
+/**
+ *******************************************************************************
+ *
+ *  \brief  Phases of a link in which CPU time is accounted
+ *
+ *          Time of a phase does not include time of phases nested inside
+ *          it, for example UTILS_LINK_PHASE_PROCESS of an algorithm link
+ *          does not include the cache operations done by the plugin.
+ *
+ *******************************************************************************
+ */
+#define UTILS_LINK_PHASE_GET_BUF    (0U)
+/**< Getting input buffers from previous link */
+#define UTILS_LINK_PHASE_PUT_BUF    (1U)
+/**< Releasing input buffers to previous link */
+#define UTILS_LINK_PHASE_CACHE      (2U)
+/**< Cache invalidate and write back of buffers */
+#define UTILS_LINK_PHASE_PROCESS    (3U)
+/**< Algorithm or driver processing */
+#define UTILS_LINK_PHASE_SEND       (4U)
+/**< Putting output buffers and notifying next link */
+#define UTILS_LINK_PHASE_MAX        (5U)
+/**< Number of phases */
+
+/**
+ *******************************************************************************
+ *
+ *  \brief  CPU time spent by a link in each phase
+ *
+ *          Time is in Utils_prfTsGet64() ticks, which is the same time base
+ *          as the task and core load times of the core running the link.
+ *          Cores run the timestamp at different rates, so the rate of the
+ *          core running the link is kept with the stats.
+ *
+ *          Same as Utils_LatencyStats, the link is the only writer and
+ *          seqCount is odd while an update is in progress. Use
+ *          Utils_getLinkPhaseStats() to get a consistent copy.
+ *
+ *******************************************************************************
+ */
+typedef struct
+{
+    uint32_t timeHi[UTILS_LINK_PHASE_MAX];
+    /**< Upper 32 bits of time spent in each phase */
+    uint32_t timeLo[UTILS_LINK_PHASE_MAX];
+    /**< Lower 32 bits of time spent in each phase */
+    uint32_t count[UTILS_LINK_PHASE_MAX];
+    /**< Number of times each phase was entered */
+    uint32_t nestedTime;
+    /**< Free running lower 32 bits of time accounted in all phases, used to
+     *   exclude nested phases from the time of the enclosing phase */
+    uint32_t tsFreqMhz;
+    /**< Timestamp ticks per usec on the core running the link, set on
+     *   reset */
+    volatile uint32_t seqCount;
+    /**< Incremented before and after every update */
+} Utils_LinkPhaseStats;
+
 /**
  *******************************************************************************
  *
@@ -236,6 +306,8 @@ Void   Utils_prfLoadCalcReset();
 
 
 Void Utils_resetLatency(Utils_LatencyStats *lStats);
+Int32 Utils_getLatency(Utils_LatencyStats *pDst,
+                       const volatile Utils_LatencyStats *pSrc);
 Void Utils_updateLatency(Utils_LatencyStats *lStats,
                          uint64_t linkLocalTime);
 Void Utils_printLatency(char *name,
@@ -244,6 +316,16 @@ Void Utils_printLatency(char *name,
                         Bool resetStats
                         );
 
+Void Utils_resetLinkPhaseStats(Utils_LinkPhaseStats *pStats);
+Void Utils_getLinkPhaseStats(Utils_LinkPhaseStats *pDst,
+                             const volatile Utils_LinkPhaseStats *pSrc);
+uint64_t Utils_linkPhaseBegin(const Utils_LinkPhaseStats *pStats);
+Void Utils_linkPhaseEnd(Utils_LinkPhaseStats *pStats,
+                        uint32_t phase,
+                        uint64_t startTs);
+Void Utils_printLinkPhaseStats(char *name,
+                               const Utils_LinkPhaseStats *pStats);
+
 Void Utils_resetLinkStatistics(Utils_LinkStatistics *pPrm,
                                 uint32_t numCh,
                                 uint32_t numOut);
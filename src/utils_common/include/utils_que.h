@@ -85,6 +85,19 @@
  */
 #define UTILS_QUE_FLAG_BLOCK_QUE       (0x00000003)
 
+/**
+ *******************************************************************************
+ * \brief Queue Flag: Single producer, single consumer queue
+ *
+ *        Can be OR'ed with other flags. Put and get do not disable
+ *        interrupts, hence only one task or ISR may put and only one task
+ *        or ISR may get. Peek and get must be called by the consumer.
+ *        Semaphores are posted only when the other side is blocked.
+ *        Queue must not be shared across cores.
+ *******************************************************************************
+ */
+#define UTILS_QUE_FLAG_SPSC            (0x00000004)
+
 /* @} */
 
 /*******************************************************************************
@@ -108,13 +121,15 @@
 typedef struct {
 
   UInt32 curRd;
-  /**< Current read index */
+  /**< Current read index, with UTILS_QUE_FLAG_SPSC runs from
+   *   0 to 2*maxElements-1 and is updated by consumer only */
 
   UInt32 curWr;
-  /**< Current write index  */
+  /**< Current write index, with UTILS_QUE_FLAG_SPSC runs from
+   *   0 to 2*maxElements-1 and is updated by producer only */
 
   UInt32 count;
-  /**< Count of element in queue  */
+  /**< Count of element in queue, not used with UTILS_QUE_FLAG_SPSC  */
 
   UInt32 maxElements;
   /**< Max elements that be present in the queue  */
@@ -42,6 +42,7 @@ extern "C" {
  *******************************************************************************
  */
 #include <include/link_api/system.h>
+#include <include/link_api/remoteLogBin_if.h>
 
 /*******************************************************************************
  *  Defines
@@ -94,6 +95,22 @@ extern "C" {
 */
 #define REMOTE_LOG_FLAG_TYPE_STRING  (0x10000000)
 
+/**
+ *******************************************************************************
+ *
+ * \brief Set to 1 to put binary records in the log buffer instead of
+ *        formatted text, see remoteLogBin_if.h
+ *
+ *        Off by default. Binary records save formatting on the logging core,
+ *        but each call then compares its format with the copy in the string
+ *        table, and formats from reused buffers are logged as text.
+ *
+ *******************************************************************************
+*/
+#ifndef REMOTE_LOG_BIN_ENABLE
+#define REMOTE_LOG_BIN_ENABLE        (0U)
+#endif
+
 /*******************************************************************************
  *  Enum's
  *******************************************************************************
@@ -136,6 +153,9 @@ typedef struct
     /**< Read pointer. As other core reads the log this keeps incrementing */
     volatile unsigned int appInitState;
     /** < Flag indicating application initialization status */
+    RemoteLog_BinInfo binInfo;
+    /**< Binary log state, used in place of serverIdx/clientIdx when
+     *   binInfo.binMode is REMOTE_LOG_BIN_MODE_MAGIC */
 } RemoteLog_MemInfo;
 
  /**
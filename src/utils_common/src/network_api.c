@@ -171,6 +171,14 @@ int Network_waitConnect(Network_SockObj *pObj, UInt32 timeout)
 
         if( pObj->connectedSockFd != INVALID_SOCKET )
         {
+            int option = 1;
+
+            /* header and payload are sent with separate writes, without
+             * this the second write waits for the ACK of the first one
+             * when the connection is kept open across commands
+             */
+            setsockopt ( pObj->connectedSockFd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof( option ) );
+
             return 1;
         }
     }
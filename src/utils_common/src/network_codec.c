@@ -0,0 +1,443 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Lossless codec of NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED payload, see
+ * networkCtrl_if.h for the format. Same as
+ * tools/network_tools/common/src/network_codec.c on PC, keep both in sync.
+ */
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <src/utils_common/include/network_codec.h>
+/* Max distance to left neighbour of same component in any format */
+#define NETWORK_CODEC_MAX_DIST      (4)
+
+typedef struct {
+
+    UInt32 lineSize;
+    /**< Bytes coded per line */
+
+    UInt32 numLines;
+
+    UInt32 dist[2];
+    /**< Distance in bytes to left neighbour of same component, for even
+     *   and odd bytes of a line */
+
+} NetworkCodec_PlaneInfo;
+
+static UInt32 NetworkCodec_getPlaneInfo(UInt32 payloadType, UInt32 width, UInt32 height,
+                                        NetworkCodec_PlaneInfo *pPlane)
+{
+    UInt32 numPlanes = 0;
+
+    if(payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        /* Y */
+        pPlane[0].lineSize = width;
+        pPlane[0].numLines = height;
+        pPlane[0].dist[0]  = 1;
+        pPlane[0].dist[1]  = 1;
+
+        /* UV interleaved */
+        pPlane[1].lineSize = width;
+        pPlane[1].numLines = height/2;
+        pPlane[1].dist[0]  = 2;
+        pPlane[1].dist[1]  = 2;
+
+        numPlanes = 2;
+    }
+    else
+    if(payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV)
+    {
+        /* Y at even bytes, U and V alternate at odd bytes */
+        pPlane[0].lineSize = width*2;
+        pPlane[0].numLines = height;
+        pPlane[0].dist[0]  = 2;
+        pPlane[0].dist[1]  = 4;
+
+        numPlanes = 1;
+    }
+
+    return numPlanes;
+}
+
+/* LOCO-I median predictor from left (a), top (b) and top-left (c) */
+static inline UInt8 NetworkCodec_med(UInt32 a, UInt32 b, UInt32 c)
+{
+    UInt32 minAB, maxAB;
+
+    minAB = a < b ? a : b;
+    maxAB = a < b ? b : a;
+
+    if(c >= maxAB)
+        return (UInt8)minAB;
+    if(c <= minAB)
+        return (UInt8)maxAB;
+
+    return (UInt8)(a + b - c);
+}
+
+/* Prediction at first line and first bytes of a line, where not all
+ * neighbours are present
+ */
+static inline UInt8 NetworkCodec_predictEdge(UInt8 *pCur, UInt8 *pUp, UInt32 x, UInt32 d)
+{
+    if(pUp==NULL)
+    {
+        return x>=d ? pCur[x-d] : 0;
+    }
+    if(x<d)
+    {
+        return pUp[x];
+    }
+
+    return NetworkCodec_med(pCur[x-d], pUp[x], pUp[x-d]);
+}
+
+static UInt8 *NetworkCodec_packBlock(UInt8 *pBlock, UInt8 *pDst)
+{
+    UInt32 i, j, orBits, w;
+    UInt64 acc;
+
+    orBits = 0;
+    for(i=0; i<NETWORK_CODEC_BLOCK_SIZE; i++)
+    {
+        orBits |= pBlock[i];
+    }
+
+    w = 0;
+    while(orBits >> w)
+    {
+        w++;
+    }
+
+    *pDst++ = (UInt8)w;
+
+    if(w==8)
+    {
+        memcpy(pDst, pBlock, NETWORK_CODEC_BLOCK_SIZE);
+        pDst += NETWORK_CODEC_BLOCK_SIZE;
+    }
+    else
+    if(w)
+    {
+        /* 8 residuals of w bits are w bytes */
+        for(i=0; i<NETWORK_CODEC_BLOCK_SIZE; i+=8)
+        {
+            acc = 0;
+            for(j=0; j<8; j++)
+            {
+                acc |= (UInt64)pBlock[i+j] << (j*w);
+            }
+            for(j=0; j<w; j++)
+            {
+                *pDst++ = (UInt8)acc;
+                acc >>= 8;
+            }
+        }
+    }
+
+    return pDst;
+}
+
+/* Returns bytes read, 0 on invalid block */
+static UInt32 NetworkCodec_unpackBlock(UInt8 *pSrc, UInt8 *pEnd, UInt8 *pBlock)
+{
+    UInt32 i, j, w, mask;
+    UInt64 acc;
+    UInt8 *pStart = pSrc;
+
+    if(pSrc >= pEnd)
+        return 0;
+
+    w = *pSrc++;
+    if(w > 8 || (UInt32)(pEnd - pSrc) < NETWORK_CODEC_BLOCK_SIZE*w/8)
+        return 0;
+
+    if(w==8)
+    {
+        memcpy(pBlock, pSrc, NETWORK_CODEC_BLOCK_SIZE);
+        pSrc += NETWORK_CODEC_BLOCK_SIZE;
+    }
+    else
+    if(w==0)
+    {
+        memset(pBlock, 0, NETWORK_CODEC_BLOCK_SIZE);
+    }
+    else
+    {
+        mask = (1U << w) - 1;
+        for(i=0; i<NETWORK_CODEC_BLOCK_SIZE; i+=8)
+        {
+            acc = 0;
+            for(j=0; j<w; j++)
+            {
+                acc |= (UInt64)pSrc[j] << (j*8);
+            }
+            pSrc += w;
+            for(j=0; j<8; j++)
+            {
+                pBlock[i+j] = (UInt8)(acc & mask);
+                acc >>= w;
+            }
+        }
+    }
+
+    return pSrc - pStart;
+}
+
+static UInt8 *NetworkCodec_encodePlane(NetworkCodec_PlaneInfo *pPlane,
+                                       UInt8 *pSrc, UInt32 srcPitch,
+                                       UInt8 *pDst)
+{
+    UInt8 block[NETWORK_CODEC_BLOCK_SIZE];
+    UInt8 *pCur, *pUp, r, pred;
+    UInt32 x, y, n, d;
+
+    n = 0;
+    pUp = NULL;
+
+    for(y=0; y<pPlane->numLines; y++)
+    {
+        pCur = pSrc + y*srcPitch;
+
+        for(x=0; x<pPlane->lineSize; x++)
+        {
+            d = pPlane->dist[x & 1];
+            if(pUp==NULL || x<NETWORK_CODEC_MAX_DIST)
+                pred = NetworkCodec_predictEdge(pCur, pUp, x, d);
+            else
+                pred = NetworkCodec_med(pCur[x-d], pUp[x], pUp[x-d]);
+
+            r = pCur[x] - pred;
+
+            /* zig-zag, small negative and positive residuals are small */
+            block[n++] = (r & 0x80) ? (UInt8)(((~r & 0x7F) << 1) | 1) : (UInt8)(r << 1);
+
+            if(n==NETWORK_CODEC_BLOCK_SIZE)
+            {
+                pDst = NetworkCodec_packBlock(block, pDst);
+                n = 0;
+            }
+        }
+
+        pUp = pCur;
+    }
+
+    if(n)
+    {
+        memset(&block[n], 0, NETWORK_CODEC_BLOCK_SIZE - n);
+        pDst = NetworkCodec_packBlock(block, pDst);
+    }
+
+    return pDst;
+}
+
+/* Returns SYSTEM_LINK_STATUS_EFAIL if data is not exactly srcSize bytes of valid blocks */
+static Int32 NetworkCodec_decodePlane(NetworkCodec_PlaneInfo *pPlane,
+                                    UInt8 *pSrc, UInt32 srcSize,
+                                    UInt8 *pDst, UInt32 dstPitch)
+{
+    UInt8 block[NETWORK_CODEC_BLOCK_SIZE];
+    UInt8 *pCur, *pUp, *pEnd, z, pred;
+    UInt32 x, y, n, d, size;
+
+    pEnd = pSrc + srcSize;
+    n = NETWORK_CODEC_BLOCK_SIZE;
+    pUp = NULL;
+
+    for(y=0; y<pPlane->numLines; y++)
+    {
+        pCur = pDst + y*dstPitch;
+
+        for(x=0; x<pPlane->lineSize; x++)
+        {
+            if(n==NETWORK_CODEC_BLOCK_SIZE)
+            {
+                size = NetworkCodec_unpackBlock(pSrc, pEnd, block);
+                if(size==0)
+                    return SYSTEM_LINK_STATUS_EFAIL;
+                pSrc += size;
+                n = 0;
+            }
+
+            z = block[n++];
+
+            d = pPlane->dist[x & 1];
+            if(pUp==NULL || x<NETWORK_CODEC_MAX_DIST)
+                pred = NetworkCodec_predictEdge(pCur, pUp, x, d);
+            else
+                pred = NetworkCodec_med(pCur[x-d], pUp[x], pUp[x-d]);
+
+            pCur[x] = pred + ((z & 1) ? (UInt8)~(z >> 1) : (UInt8)(z >> 1));
+        }
+
+        pUp = pCur;
+    }
+
+    if(pSrc != pEnd)
+        return SYSTEM_LINK_STATUS_EFAIL;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/* Max size of compressed payload including header, 0 if format is not
+ * supported
+ */
+UInt32 NetworkCodec_getMaxSize(UInt32 payloadType, UInt32 width, UInt32 height)
+{
+    NetworkCodec_PlaneInfo plane[NETWORK_CODEC_MAX_PLANES];
+    UInt32 numPlanes, i, numBlocks, maxSize;
+
+    numPlanes = NetworkCodec_getPlaneInfo(payloadType, width, height, plane);
+    if(numPlanes==0)
+        return 0;
+
+    maxSize = sizeof(NetworkCodec_Header);
+    for(i=0; i<numPlanes; i++)
+    {
+        numBlocks = (plane[i].lineSize*plane[i].numLines + NETWORK_CODEC_BLOCK_SIZE - 1)
+                        / NETWORK_CODEC_BLOCK_SIZE;
+
+        maxSize += numBlocks*(1 + NETWORK_CODEC_BLOCK_SIZE);
+    }
+
+    return maxSize;
+}
+
+Int32 NetworkCodec_encode(UInt32 payloadType, UInt32 width, UInt32 height,
+                        UInt8 *srcAddr[], UInt32 srcPitch[],
+                        UInt8 *pDst, UInt32 dstSize, UInt32 *pEncSize)
+{
+    NetworkCodec_PlaneInfo plane[NETWORK_CODEC_MAX_PLANES];
+    NetworkCodec_Header *pHeader;
+    UInt32 numPlanes, i;
+    UInt8 *pCur;
+
+    *pEncSize = 0;
+
+    numPlanes = NetworkCodec_getPlaneInfo(payloadType, width, height, plane);
+    if(numPlanes==0
+        ||
+       dstSize < NetworkCodec_getMaxSize(payloadType, width, height))
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    pHeader = (NetworkCodec_Header*)pDst;
+    memset(pHeader, 0, sizeof(*pHeader));
+
+    pHeader->magic = NETWORK_CODEC_MAGIC;
+    pHeader->payloadType = payloadType;
+    pHeader->width = width;
+    pHeader->height = height;
+
+    pCur = pDst + sizeof(*pHeader);
+
+    for(i=0; i<numPlanes; i++)
+    {
+        pHeader->planeSize[i] = NetworkCodec_encodePlane(&plane[i], srcAddr[i], srcPitch[i], pCur) - pCur;
+        pCur += pHeader->planeSize[i];
+    }
+
+    *pEncSize = pCur - pDst;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/* Decodes to frame of given format and size, fails if payload is of
+ * another format or size, or is corrupted
+ */
+Int32 NetworkCodec_decode(UInt8 *pSrc, UInt32 srcSize,
+                        UInt32 payloadType, UInt32 width, UInt32 height,
+                        UInt8 *dstAddr[], UInt32 dstPitch[])
+{
+    NetworkCodec_PlaneInfo plane[NETWORK_CODEC_MAX_PLANES];
+    NetworkCodec_Header header;
+    UInt32 numPlanes, i, size;
+    Int32 status;
+
+    if(srcSize < sizeof(header))
+        return SYSTEM_LINK_STATUS_EFAIL;
+
+    memcpy(&header, pSrc, sizeof(header));
+
+    numPlanes = NetworkCodec_getPlaneInfo(payloadType, width, height, plane);
+
+    if(numPlanes==0
+        ||
+       header.magic!=NETWORK_CODEC_MAGIC
+        ||
+       header.payloadType!=payloadType
+        ||
+       header.width!=width
+        ||
+       header.height!=height)
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    size = sizeof(header);
+    for(i=0; i<numPlanes; i++)
+    {
+        if(header.planeSize[i] > srcSize - size)
+            return SYSTEM_LINK_STATUS_EFAIL;
+
+        size += header.planeSize[i];
+    }
+
+    if(size!=srcSize)
+        return SYSTEM_LINK_STATUS_EFAIL;
+
+    pSrc += sizeof(header);
+
+    for(i=0; i<numPlanes; i++)
+    {
+        status = NetworkCodec_decodePlane(&plane[i], pSrc, header.planeSize[i], dstAddr[i], dstPitch[i]);
+        if(status!=SYSTEM_LINK_STATUS_SOK)
+            return status;
+
+        pSrc += header.planeSize[i];
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/* Called once per frame, frames skipped here are not passed to
+ * NetworkCodec_backoffUpdate()
+ */
+Bool NetworkCodec_backoffIsSkip(NetworkCodec_Backoff *pBackoff)
+{
+    if(pBackoff->skipCount)
+    {
+        pBackoff->skipCount--;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+Void NetworkCodec_backoffUpdate(NetworkCodec_Backoff *pBackoff, Bool isSmaller)
+{
+    if(isSmaller)
+    {
+        pBackoff->rawCount = 0;
+        return;
+    }
+
+    pBackoff->rawCount++;
+    if(pBackoff->rawCount >= NETWORK_CODEC_BACKOFF_RAW_FRAMES)
+    {
+        pBackoff->rawCount = 0;
+        pBackoff->skipCount = NETWORK_CODEC_BACKOFF_SKIP_FRAMES;
+    }
+}
@@ -222,7 +222,21 @@ void Utils_dmaCallback(uint32_t tcc, EDMA3_RM_TccStatus status,
     switch (status)
     {
         case EDMA3_RM_XFER_COMPLETE:
-            BspOsal_semPost(pObj->semComplete);
+            if(pObj->txListDoneCb != NULL)
+            {
+                Utils_DmaTxListDoneCb doneCb = pObj->txListDoneCb;
+
+                /* last transfers of a list submitted with callback, lock
+                 * was held by Utils_dmaTxListSubmit() till now
+                 */
+                pObj->txListDoneCb = NULL;
+                doneCb(pObj->txListDoneCbAppData);
+                BspOsal_semPost(pObj->semLock);
+            }
+            else
+            {
+                BspOsal_semPost(pObj->semComplete);
+            }
             break;
         case EDMA3_RM_E_CC_DMA_EVT_MISS:
 
@@ -521,7 +535,7 @@ Int32 Utils_dmaPollWaitComplete(Utils_DmaChObj *pObj)
 /**
  *******************************************************************************
  *
- * \brief Trigger EDMA channel and wait for completion
+ * \brief Trigger EDMA channel, does not wait for completion
  *
  * \param pObj      [IN] Logical DMA channel handle
  *
@@ -529,7 +543,7 @@ Int32 Utils_dmaPollWaitComplete(Utils_DmaChObj *pObj)
  *
  *******************************************************************************
  */
-Int32 Utils_dmaTriggerAndWait(Utils_DmaChObj *pObj)
+Int32 Utils_dmaTrigger(Utils_DmaChObj *pObj)
 {
     EDMA3_DRV_Result edma3Result = EDMA3_DRV_SOK;
     uint16_t tccStatus;
@@ -551,16 +565,54 @@ Int32 Utils_dmaTriggerAndWait(Utils_DmaChObj *pObj)
             );
     }
 
+    return edma3Result;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Wait for completion of transfers triggered by Utils_dmaTrigger()
+ *
+ * \param pObj      [IN] Logical DMA channel handle
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaWaitComplete(Utils_DmaChObj *pObj)
+{
+    if(pObj->enableIntCb)
+    {
+        BspOsal_semWait(pObj->semComplete, BSP_OSAL_WAIT_FOREVER);
+    }
+    else
+    {
+        Utils_dmaPollWaitComplete(pObj);
+    }
+
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Trigger EDMA channel and wait for completion
+ *
+ * \param pObj      [IN] Logical DMA channel handle
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTriggerAndWait(Utils_DmaChObj *pObj)
+{
+    EDMA3_DRV_Result edma3Result;
+
+    edma3Result = Utils_dmaTrigger(pObj);
+
     if (edma3Result == EDMA3_DRV_SOK)
     {
-        if(pObj->enableIntCb)
-        {
-            BspOsal_semWait(pObj->semComplete, BSP_OSAL_WAIT_FOREVER);
-        }
-        else
-        {
-            Utils_dmaPollWaitComplete(pObj);
-        }
+        Utils_dmaWaitComplete(pObj);
     }
 
     return edma3Result;
@@ -598,6 +650,38 @@ Int32 Utils_dmaParamSetCheck(EDMA3_DRV_PaRAMRegs *pParamSet)
     return FVID2_SOK;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Program a PaRAM entry from a transfer list descriptor
+ *
+ *        OPT and link address are set later by Utils_dmaLinkDma()
+ *
+ * \param pParamSet      [IN] PaRAM set pointer
+ * \param pDesc          [IN] Transfer descriptor
+ *
+ *******************************************************************************
+ */
+static Void Utils_dmaSetParam(EDMA3_DRV_PaRAMRegs *pParamSet,
+                              const Utils_DmaTxDesc *pDesc)
+{
+    pParamSet->destAddr   = (UInt32)pDesc->destAddr;
+    pParamSet->srcAddr    = (UInt32)pDesc->srcAddr;
+    pParamSet->srcBIdx    = pDesc->srcBIdx;
+    pParamSet->destBIdx   = pDesc->destBIdx;
+    pParamSet->aCnt       = pDesc->aCnt;
+    pParamSet->bCnt       = pDesc->bCnt;
+    pParamSet->cCnt       = 1;
+
+    pParamSet->bCntReload = pParamSet->bCnt;
+
+    #ifdef SYSTEM_UTILS_DMA_PARAM_CHECK
+    UTILS_assert(
+        Utils_dmaParamSetCheck(pParamSet) == FVID2_SOK
+    );
+    #endif
+}
+
 /**
  *******************************************************************************
  *
@@ -820,9 +904,10 @@ Int32 Utils_dmaCopyFill2D(Utils_DmaChObj *pObj, Utils_DmaCopyFill2D *pInfo,
                         UInt32 numTransfers, Bool fillData)
 {
     EDMA3_DRV_Result edma3Result = EDMA3_DRV_SOK;
-    EDMA3_DRV_PaRAMRegs *pParamSet;
-    UInt32 bpp; /* bytes per pixel */
-    UInt32 i, numTx;
+    Utils_DmaTxList txList;
+    Utils_DmaTxDesc txDesc[UTILS_DMA_TXLIST_DESC_PER_2D];
+    UInt32 i, descId, numTx;
+    Int32 status, txStatus = SYSTEM_LINK_STATUS_SOK;
 
     BspOsal_semWait(pObj->semLock, BSP_OSAL_WAIT_FOREVER);
 
@@ -830,130 +915,184 @@ Int32 Utils_dmaCopyFill2D(Utils_DmaChObj *pObj, Utils_DmaCopyFill2D *pInfo,
 
     for(i=0; i<numTransfers; i++)
     {
-        pParamSet   = pObj->txObj[numTx].pParamSet;
+        Utils_dmaTxListInit(&txList, txDesc, UTILS_DMA_TXLIST_DESC_PER_2D);
 
-        if(pInfo->dataFormat==SYSTEM_DF_RAW24)
-            bpp = 3;
-        else
-        if(pInfo->dataFormat==SYSTEM_DF_RAW16)
-            bpp = 2;
-        else
-        if(pInfo->dataFormat==SYSTEM_DF_RAW08)
-            bpp = 1;
-        else
-        if(pInfo->dataFormat==SYSTEM_DF_YUV420SP_UV)
-            bpp = 1;
-        else
-            bpp = 1;
+        status = Utils_dmaTxListAdd2D(&txList, pInfo, fillData);
 
-        pParamSet->destAddr   = (UInt32)pInfo->destAddr[0]
-                              + pInfo->destPitch[0]*pInfo->destStartY
-                              + pInfo->destStartX * bpp;
+        #ifdef SYSTEM_UTILS_DMA_PARAM_CHECK
+        UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+        #endif
 
-        if(fillData)
-        {
-            pParamSet->srcAddr   = (UInt32)pInfo->srcAddr[0];
-            pParamSet->srcBIdx   = 0;
-        }
-        else
+        if(status != SYSTEM_LINK_STATUS_SOK)
         {
-            pParamSet->srcAddr   = (UInt32)pInfo->srcAddr[0]
-                                  + pInfo->srcPitch[0]*pInfo->srcStartY
-                                  + pInfo->srcStartX * bpp;
-            pParamSet->srcBIdx    = pInfo->srcPitch[0];
+            /* list is left empty on failure, so only this transfer is
+             * skipped, error is returned after the other transfers are done
+             */
+            Vps_printf(
+                " UTILS: DMA: Invalid 2D transfer %d ... SKIPPED (CH=%d) \n",
+                    i, pObj->edmaChId
+                );
+            txStatus = status;
         }
 
-        pParamSet->destBIdx   = pInfo->destPitch[0];
-
-        pParamSet->aCnt       = (pInfo->width*bpp);
-        pParamSet->bCnt       = pInfo->height;
-        pParamSet->cCnt       = 1;
-
-        pParamSet->bCntReload = pParamSet->bCnt;
-
-        #ifdef SYSTEM_UTILS_DMA_PARAM_CHECK
-        UTILS_assert(
-            Utils_dmaParamSetCheck(pParamSet) == FVID2_SOK
-        );
-        #endif
-
-        if(pInfo->dataFormat==SYSTEM_DF_YUV420SP_UV)
+        for(descId=0; descId<txList.numDesc; descId++)
         {
+            Utils_dmaSetParam(pObj->txObj[numTx].pParamSet, &txDesc[descId]);
+
             numTx++;
 
             if(numTx>=pObj->maxTransfers)
             {
                 edma3Result |= Utils_dmaRun(pObj, &numTx);
             }
+        }
 
-            /* setup PaRAM for UV plane */
-            pParamSet   = pObj->txObj[numTx].pParamSet;
+        /* goto next tranfer information */
+        pInfo++;
+    }
 
-            bpp = 1;
+    if(numTx)
+    {
+        edma3Result |= Utils_dmaRun(pObj, &numTx);
+    }
 
-            /*
-             * For chroma plane when input or output is tiled we need to set
-             * pitch as -32KB since other wise pitch value will overflow
-             * the 16-bit register in EDMA.
-             * Hence all for all Chroma TX's we set pitch as -pitch and DMA
-             * from last line to first line
-             *
-             */
+    BspOsal_semPost(pObj->semLock);
 
-            pParamSet->destAddr   = (UInt32)pInfo->destAddr[1]
-                                  + pInfo->destPitch[1]
-                                    *((pInfo->destStartY+pInfo->height)/2-1)
-                                  + pInfo->destStartX * bpp;
+    if(edma3Result != EDMA3_DRV_SOK)
+    {
+        return edma3Result;
+    }
 
-            if(fillData)
-            {
-                pParamSet->srcAddr   = (UInt32)pInfo->srcAddr[1];
-                pParamSet->srcBIdx   = 0;
-            }
-            else
-            {
-                pParamSet->srcAddr   = (UInt32)pInfo->srcAddr[1]
-                                      + pInfo->srcPitch[1]
-                                        *((pInfo->srcStartY+pInfo->height)/2-1)
-                                      + pInfo->srcStartX * bpp;
-                pParamSet->srcBIdx   = -pInfo->srcPitch[1];
-            }
+    return txStatus;
+}
 
-            pParamSet->destBIdx   = -pInfo->destPitch[1];
+/**
+ *******************************************************************************
+ *
+ * \brief Submit a transfer list to EDMA
+ *
+ *        PaRAMs of the logical channel are linked and chained so that the
+ *        descriptors of the list run back to back with a completion
+ *        interrupt only after the last one. When the list has more
+ *        descriptors than Utils_DmaChCreateParams.maxTransfers, all but the
+ *        last Utils_DmaChCreateParams.maxTransfers descriptors are run and
+ *        waited for inside this API.
+ *
+ *        The API returns once the last transfers are triggered. Completion
+ *        is then known in one of two ways,
+ *        - doneCb is NULL: user MUST call Utils_dmaTxListWait()
+ *        - doneCb is not NULL: doneCb is called from EDMA completion
+ *          interrupt, Utils_dmaTxListWait() MUST NOT be called. Needs a
+ *          channel created with enableIntCb as TRUE.
+ *
+ *        The channel lock is held till completion, other DMA APIs on the
+ *        same logical channel block till then. The descriptor array can be
+ *        reused as soon as this API returns.
+ *
+ * \param pObj      [IN] Logical DMA channel handle
+ * \param pList     [IN] Transfer list
+ * \param doneCb    [IN] Completion callback, can be NULL
+ * \param appData   [IN] Argument for doneCb
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure. On failure
+ *         nothing is in flight and doneCb is not called
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTxListSubmit(Utils_DmaChObj *pObj,
+                            const Utils_DmaTxList *pList,
+                            Utils_DmaTxListDoneCb doneCb,
+                            Ptr appData)
+{
+    EDMA3_DRV_Result edma3Result = EDMA3_DRV_SOK;
+    UInt32 descId, numTx;
 
-            pParamSet->aCnt       = (pInfo->width*bpp);
-            pParamSet->bCnt       = pInfo->height/2;
-            pParamSet->cCnt       = 1;
+    if(doneCb != NULL && !pObj->enableIntCb)
+    {
+        Vps_printf(" UTILS: DMA: Completion callback needs interrupt mode"
+                   " (CH=%d) \n", pObj->edmaChId);
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
 
-            pParamSet->bCntReload = pParamSet->bCnt;
+    BspOsal_semWait(pObj->semLock, BSP_OSAL_WAIT_FOREVER);
 
-            #ifdef SYSTEM_UTILS_DMA_PARAM_CHECK
-            UTILS_assert(
-                Utils_dmaParamSetCheck(pParamSet) == FVID2_SOK
-            );
-            #endif
-        }
+    numTx = 0;
+
+    for(descId=0; descId<pList->numDesc; descId++)
+    {
+        Utils_dmaSetParam(pObj->txObj[numTx].pParamSet,
+                          &pList->pDesc[descId]);
 
-        /* goto next tranfer information */
-        pInfo++;
         numTx++;
 
-        if(numTx>=pObj->maxTransfers)
+        if(numTx>=pObj->maxTransfers && descId<(pList->numDesc-1))
         {
+            /* not the last transfers, run them and wait */
             edma3Result |= Utils_dmaRun(pObj, &numTx);
+            if(edma3Result != EDMA3_DRV_SOK)
+                break;
         }
     }
 
-    if(numTx)
+    if(edma3Result == EDMA3_DRV_SOK && numTx)
     {
-        edma3Result |= Utils_dmaRun(pObj, &numTx);
+        Utils_dmaLinkDma(pObj, numTx);
+
+        pObj->txListDoneCbAppData = appData;
+        pObj->txListDoneCb  = doneCb;
+        pObj->txListPending = (Bool)(doneCb == NULL);
+
+        edma3Result = Utils_dmaTrigger(pObj);
+        if(edma3Result == EDMA3_DRV_SOK)
+        {
+            /* lock is released on completion */
+            return SYSTEM_LINK_STATUS_SOK;
+        }
+
+        pObj->txListDoneCb  = NULL;
+        pObj->txListPending = FALSE;
     }
 
+    /* nothing in flight */
     BspOsal_semPost(pObj->semLock);
 
+    if(edma3Result == EDMA3_DRV_SOK && doneCb != NULL)
+    {
+        doneCb(appData);
+    }
+
     return edma3Result;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Wait for completion of a transfer list submitted without callback
+ *
+ *        Returns right away if nothing is in flight, e.g list was empty
+ *
+ * \param pObj      [IN] Logical DMA channel handle
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTxListWait(Utils_DmaChObj *pObj)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+
+    if(pObj->txListPending)
+    {
+        status = Utils_dmaWaitComplete(pObj);
+
+        pObj->txListPending = FALSE;
+
+        BspOsal_semPost(pObj->semLock);
+    }
+
+    return status;
+}
+
 /**
  *******************************************************************************
  *
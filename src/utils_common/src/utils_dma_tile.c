@@ -0,0 +1,479 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file utils_dma_tile.c
+ *
+ * \brief This file has the implementation of DMA ping-pong tiling APIs
+ *
+ *        Build with UTILS_DMA_TILE_HOST_EMULATION defined to use without
+ *        EDMA driver, all transfers are then done with CPU
+ *
+ * \version 0.0 (Oct 2015) : First version
+ *
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <src/utils_common/include/utils_dma_tile.h>
+#ifndef UTILS_DMA_TILE_HOST_EMULATION
+#include <src/utils_common/include/utils_dma.h>
+#endif
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get bytes per pixel of first plane of a stream
+ *
+ * \param dataFormat    [IN] Stream data format
+ *
+ * \return Bytes per pixel
+ *
+ *******************************************************************************
+ */
+static UInt32 Utils_dmaTileGetBpp(UInt32 dataFormat)
+{
+    UInt32 bpp;
+
+    if(dataFormat==SYSTEM_DF_RAW24)
+        bpp = 3;
+    else
+    if(dataFormat==SYSTEM_DF_RAW16)
+        bpp = 2;
+    else
+        bpp = 1;
+
+    return bpp;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get position and size of a tile
+ *
+ * \param pObj      [IN]  Tile object
+ * \param tileId    [IN]  Tile index
+ * \param pTile     [OUT] Tile information, buffer addresses are not set
+ *
+ *******************************************************************************
+ */
+static Void Utils_dmaTileGetGeometry(Utils_DmaTileObj *pObj,
+                                     UInt32 tileId,
+                                     Utils_DmaTileInfo *pTile)
+{
+    Utils_DmaTilePrm *pPrm = &pObj->prm;
+
+    pTile->tileId = tileId;
+    pTile->startX = (tileId % pObj->numTilesX) * pPrm->tileWidth;
+    pTile->startY = (tileId / pObj->numTilesX) * pPrm->tileHeight;
+
+    pTile->width  = pPrm->width - pTile->startX;
+    if(pTile->width > pPrm->tileWidth)
+        pTile->width = pPrm->tileWidth;
+
+    pTile->height = pPrm->height - pTile->startY;
+    if(pTile->height > pPrm->tileHeight)
+        pTile->height = pPrm->tileHeight;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Add transfers of one tile, for streams of one direction, to the
+ *        transfer list of current step
+ *
+ * \param pObj      [IN] Tile object
+ * \param tileId    [IN] Tile index
+ * \param dir       [IN] UTILS_DMA_TILE_DIR_IN or UTILS_DMA_TILE_DIR_OUT
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_dmaTileAddTransfers(Utils_DmaTileObj *pObj,
+                                       UInt32 tileId,
+                                       UInt32 dir)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+    Utils_DmaTileStreamPrm *pStream;
+    Utils_DmaTileInfo tile;
+    Utils_DmaCopyFill2D dmaPrm;
+    UInt32 streamId, planeId, bufId;
+    Ptr   *pFrameAddr, *pTileAddr;
+    UInt32 *pFramePitch, *pTilePitch;
+    UInt32 frameX, frameY;
+
+    Utils_dmaTileGetGeometry(pObj, tileId, &tile);
+
+    bufId = tileId % UTILS_DMA_TILE_NUM_BUF;
+
+    for(streamId=0; streamId<pObj->prm.numStreams; streamId++)
+    {
+        pStream = &pObj->prm.stream[streamId];
+
+        if(pStream->dir != dir)
+            continue;
+
+        frameX = pStream->frameStartX + tile.startX;
+        frameY = pStream->frameStartY + tile.startY;
+
+        memset(&dmaPrm, 0, sizeof(dmaPrm));
+
+        dmaPrm.dataFormat = pStream->dataFormat;
+        dmaPrm.width      = tile.width;
+        dmaPrm.height     = tile.height;
+
+        if(dir == UTILS_DMA_TILE_DIR_IN)
+        {
+            pFrameAddr  = dmaPrm.srcAddr;
+            pFramePitch = dmaPrm.srcPitch;
+            pTileAddr   = dmaPrm.destAddr;
+            pTilePitch  = dmaPrm.destPitch;
+
+            dmaPrm.srcStartX = frameX;
+            dmaPrm.srcStartY = frameY;
+        }
+        else
+        {
+            pFrameAddr  = dmaPrm.destAddr;
+            pFramePitch = dmaPrm.destPitch;
+            pTileAddr   = dmaPrm.srcAddr;
+            pTilePitch  = dmaPrm.srcPitch;
+
+            dmaPrm.destStartX = frameX;
+            dmaPrm.destStartY = frameY;
+        }
+
+        for(planeId=0; planeId<UTILS_DMA_MAX_PLANES; planeId++)
+        {
+            pFrameAddr[planeId]  = pStream->frameAddr[planeId];
+            pFramePitch[planeId] = pStream->framePitch[planeId];
+            pTileAddr[planeId]   = pStream->tileBufAddr[bufId][planeId];
+            pTilePitch[planeId]  = pStream->tileBufPitch[planeId];
+        }
+
+        status = Utils_dmaTxListAdd2D(&pObj->txList, &dmaPrm, FALSE);
+        if(status != SYSTEM_LINK_STATUS_SOK)
+            break;
+    }
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Start transfers of current step
+ *
+ * \param pObj      [IN] Tile object
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_dmaTileSubmit(Utils_DmaTileObj *pObj)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+
+    if(pObj->txList.numDesc == 0)
+        return status;
+
+#ifndef UTILS_DMA_TILE_HOST_EMULATION
+    if(pObj->prm.hDmaCh != NULL)
+    {
+        status = Utils_dmaTxListSubmit(
+                    (Utils_DmaChObj *)pObj->prm.hDmaCh,
+                    &pObj->txList,
+                    NULL,
+                    NULL);
+
+        if(status == SYSTEM_LINK_STATUS_SOK)
+            pObj->isPending = TRUE;
+
+        return status;
+    }
+#endif
+
+    status = Utils_dmaTxListCpuRun(&pObj->txList);
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Wait for transfers of previous step
+ *
+ * \param pObj      [IN] Tile object
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_dmaTileWait(Utils_DmaTileObj *pObj)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+
+    if(pObj->isPending)
+    {
+        pObj->isPending = FALSE;
+
+#ifndef UTILS_DMA_TILE_HOST_EMULATION
+        status = Utils_dmaTxListWait((Utils_DmaChObj *)pObj->prm.hDmaCh);
+#endif
+    }
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Init a tile object
+ *
+ *        Tile buffers and frames are not accessed here
+ *
+ * \param pObj      [OUT] Tile object
+ * \param pPrm      [IN]  Parameters
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTileInit(Utils_DmaTileObj *pObj, const Utils_DmaTilePrm *pPrm)
+{
+    const Utils_DmaTileStreamPrm *pStream;
+    UInt32 streamId, numPlanes, planeId, lineSize;
+
+    memset(pObj, 0, sizeof(*pObj));
+
+    if(pPrm->numStreams == 0
+        ||
+       pPrm->numStreams > UTILS_DMA_TILE_MAX_STREAMS
+        ||
+       pPrm->width == 0 || pPrm->height == 0
+        ||
+       pPrm->tileWidth == 0 || pPrm->tileHeight == 0
+    )
+    {
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    for(streamId=0; streamId<pPrm->numStreams; streamId++)
+    {
+        pStream = &pPrm->stream[streamId];
+
+        if(pStream->dir != UTILS_DMA_TILE_DIR_IN
+            &&
+           pStream->dir != UTILS_DMA_TILE_DIR_OUT)
+        {
+            return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+        }
+
+        numPlanes = 1;
+
+        if(pStream->dataFormat == SYSTEM_DF_YUV420SP_UV)
+        {
+            numPlanes = 2;
+
+            /* chroma is at half height, tiles must start at even lines */
+            if((pPrm->tileHeight & 1U) || (pPrm->height & 1U)
+                ||
+               (pStream->frameStartY & 1U))
+            {
+                return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+            }
+        }
+
+        lineSize = pPrm->tileWidth * Utils_dmaTileGetBpp(pStream->dataFormat);
+
+        for(planeId=0; planeId<numPlanes; planeId++)
+        {
+            if(pStream->tileBufPitch[planeId] < lineSize
+                ||
+               pStream->tileBufAddr[0][planeId] == NULL
+                ||
+               pStream->tileBufAddr[1][planeId] == NULL
+            )
+            {
+                return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+            }
+        }
+    }
+
+    pObj->prm       = *pPrm;
+    pObj->numTilesX = (pPrm->width + pPrm->tileWidth - 1) / pPrm->tileWidth;
+    pObj->numTiles  = pObj->numTilesX
+                    * ((pPrm->height + pPrm->tileHeight - 1) / pPrm->tileHeight);
+
+    /* nothing to return till Utils_dmaTileStart() is called */
+    pObj->curTile   = pObj->numTiles + 1;
+    pObj->status    = SYSTEM_LINK_STATUS_SOK;
+
+    return Utils_dmaTxListInit(&pObj->txList,
+                               pObj->txDesc,
+                               UTILS_DMA_TILE_MAX_DESC);
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Set frame of a stream, to be called before Utils_dmaTileStart()
+ *
+ * \param pObj      [IN] Tile object
+ * \param streamId  [IN] Stream index
+ * \param frameAddr [IN] Frame buffer of each plane
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTileSetFrame(Utils_DmaTileObj *pObj,
+                            UInt32 streamId,
+                            Ptr frameAddr[UTILS_DMA_MAX_PLANES])
+{
+    UInt32 planeId;
+
+    if(streamId >= pObj->prm.numStreams)
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+
+    for(planeId=0; planeId<UTILS_DMA_MAX_PLANES; planeId++)
+    {
+        pObj->prm.stream[streamId].frameAddr[planeId] = frameAddr[planeId];
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Start processing a frame, input of first tile is started
+ *
+ *        Any step left in flight from previous frame is completed first
+ *
+ * \param pObj      [IN] Tile object
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTileStart(Utils_DmaTileObj *pObj)
+{
+    Int32 status;
+
+    status = Utils_dmaTileWait(pObj);
+
+    pObj->curTile = 0;
+
+    Utils_dmaTxListReset(&pObj->txList);
+
+    if(status == SYSTEM_LINK_STATUS_SOK)
+        status = Utils_dmaTileAddTransfers(pObj, 0, UTILS_DMA_TILE_DIR_IN);
+
+    if(status == SYSTEM_LINK_STATUS_SOK)
+        status = Utils_dmaTileSubmit(pObj);
+
+    pObj->status = status;
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get next tile to process
+ *
+ *        Waits for input of the tile to be returned, then starts input of
+ *        the tile after it and output of the tile before it. Tile returned
+ *        by previous call MUST be processed when this is called.
+ *
+ * \param pObj      [IN]  Tile object
+ * \param pTile     [OUT] Tile to process
+ *
+ * \return TRUE: pTile is valid. FALSE: all tiles are done and written, or
+ *         a transfer failed, see Utils_DmaTileObj.status
+ *
+ *******************************************************************************
+ */
+Bool Utils_dmaTileNext(Utils_DmaTileObj *pObj, Utils_DmaTileInfo *pTile)
+{
+    Int32 status;
+    UInt32 curTile, streamId, planeId, bufId;
+
+    curTile = pObj->curTile;
+
+    if(pObj->status != SYSTEM_LINK_STATUS_SOK || curTile > pObj->numTiles)
+        return FALSE;
+
+    /* input of curTile and output of curTile-2 */
+    status = Utils_dmaTileWait(pObj);
+
+    Utils_dmaTxListReset(&pObj->txList);
+
+    if(status == SYSTEM_LINK_STATUS_SOK && curTile + 1 < pObj->numTiles)
+    {
+        status = Utils_dmaTileAddTransfers(pObj, curTile + 1,
+                                           UTILS_DMA_TILE_DIR_IN);
+    }
+
+    if(status == SYSTEM_LINK_STATUS_SOK && curTile > 0)
+    {
+        status = Utils_dmaTileAddTransfers(pObj, curTile - 1,
+                                           UTILS_DMA_TILE_DIR_OUT);
+    }
+
+    if(status == SYSTEM_LINK_STATUS_SOK)
+        status = Utils_dmaTileSubmit(pObj);
+
+    pObj->curTile++;
+
+    if(curTile == pObj->numTiles)
+    {
+        /* only output of last tile was submitted, complete it */
+        if(status == SYSTEM_LINK_STATUS_SOK)
+            status = Utils_dmaTileWait(pObj);
+
+        pObj->status = status;
+
+        return FALSE;
+    }
+
+    pObj->status = status;
+
+    if(status != SYSTEM_LINK_STATUS_SOK)
+        return FALSE;
+
+    Utils_dmaTileGetGeometry(pObj, curTile, pTile);
+
+    bufId = curTile % UTILS_DMA_TILE_NUM_BUF;
+
+    for(streamId=0; streamId<UTILS_DMA_TILE_MAX_STREAMS; streamId++)
+    {
+        for(planeId=0; planeId<UTILS_DMA_MAX_PLANES; planeId++)
+        {
+            if(streamId < pObj->prm.numStreams)
+            {
+                pTile->bufAddr[streamId][planeId]
+                    = pObj->prm.stream[streamId].tileBufAddr[bufId][planeId];
+            }
+            else
+            {
+                pTile->bufAddr[streamId][planeId] = NULL;
+            }
+        }
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,309 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *
+ * \file utils_dma_txlist.c
+ *
+ * \brief This file has the implementation of DMA transfer list APIs which
+ *        do not depend on EDMA driver
+ *
+ *        Submitting a list to EDMA is implemented in utils_dma.c
+ *
+ * \version 0.0 (Oct 2015) : First version
+ *
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <src/utils_common/include/utils_dma_txlist.h>
+
+/*******************************************************************************
+ *  Defines - private to DMA transfer list implementation
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ * \brief Max value of EDMA ACNT and BCNT, these are 16-bit fields in PaRAM
+ *******************************************************************************
+ */
+#define UTILS_DMA_TXLIST_MAX_CNT        (0xFFFFU)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Check if descriptor can be programmed in a PaRAM
+ *
+ * \param pDesc     [IN] Descriptor
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_dmaTxListCheckDesc(const Utils_DmaTxDesc *pDesc)
+{
+    if(pDesc->aCnt == 0
+        ||
+       pDesc->bCnt == 0
+        ||
+       pDesc->aCnt > UTILS_DMA_TXLIST_MAX_CNT
+        ||
+       pDesc->bCnt > UTILS_DMA_TXLIST_MAX_CNT
+        ||
+       pDesc->srcAddr == NULL
+        ||
+       pDesc->destAddr == NULL
+    )
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Init a transfer list
+ *
+ * \param pList     [OUT] Transfer list
+ * \param pDesc     [IN]  Descriptor memory, must stay valid till list is used
+ * \param maxDesc   [IN]  Number of elements in pDesc[]
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTxListInit(Utils_DmaTxList *pList,
+                          Utils_DmaTxDesc *pDesc,
+                          UInt32 maxDesc)
+{
+    if(pList == NULL || pDesc == NULL || maxDesc == 0)
+    {
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    pList->pDesc   = pDesc;
+    pList->maxDesc = maxDesc;
+    pList->numDesc = 0;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Remove all descriptors from a transfer list
+ *
+ * \param pList     [IN] Transfer list
+ *
+ *******************************************************************************
+ */
+Void Utils_dmaTxListReset(Utils_DmaTxList *pList)
+{
+    pList->numDesc = 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Add descriptors for a 2D copy or fill to a transfer list
+ *
+ *        One descriptor is added for single plane data formats and two
+ *        descriptors are added for SYSTEM_DF_YUV420SP_UV.
+ *
+ *        For chroma plane when input or output is tiled we need to set
+ *        pitch as -32KB since other wise pitch value will overflow
+ *        the 16-bit register in EDMA.
+ *        Hence all for all Chroma TX's we set pitch as -pitch and DMA
+ *        from last line to first line
+ *
+ *        List is not modified when the function fails.
+ *
+ * \param pList         [IN] Transfer list
+ * \param pInfo         [IN] DMA transfer parameters
+ * \param fillData      [IN] TRUE: Fill data in destination buffer, \n
+ *                           FALSE: Copy data to destination buffer
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success,
+ *         SYSTEM_LINK_STATUS_EFAIL if list is full or parameters are not valid
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTxListAdd2D(Utils_DmaTxList *pList,
+                           const Utils_DmaCopyFill2D *pInfo,
+                           Bool fillData)
+{
+    Utils_DmaTxDesc *pDesc;
+    UInt32 bpp; /* bytes per pixel */
+    UInt32 numDesc;
+
+    if(pInfo->dataFormat==SYSTEM_DF_YUV420SP_UV)
+        numDesc = 2;
+    else
+        numDesc = 1;
+
+    if(pList->numDesc + numDesc > pList->maxDesc)
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    if(pInfo->dataFormat==SYSTEM_DF_RAW24)
+        bpp = 3;
+    else
+    if(pInfo->dataFormat==SYSTEM_DF_RAW16)
+        bpp = 2;
+    else
+        bpp = 1;
+
+    pDesc = &pList->pDesc[pList->numDesc];
+
+    pDesc->destAddr   = (UInt8*)pInfo->destAddr[0]
+                      + pInfo->destPitch[0]*pInfo->destStartY
+                      + pInfo->destStartX * bpp;
+
+    if(fillData)
+    {
+        pDesc->srcAddr   = pInfo->srcAddr[0];
+        pDesc->srcBIdx   = 0;
+    }
+    else
+    {
+        pDesc->srcAddr   = (UInt8*)pInfo->srcAddr[0]
+                         + pInfo->srcPitch[0]*pInfo->srcStartY
+                         + pInfo->srcStartX * bpp;
+        pDesc->srcBIdx   = pInfo->srcPitch[0];
+    }
+
+    pDesc->destBIdx   = pInfo->destPitch[0];
+    pDesc->aCnt       = pInfo->width*bpp;
+    pDesc->bCnt       = pInfo->height;
+
+    if(Utils_dmaTxListCheckDesc(pDesc) != SYSTEM_LINK_STATUS_SOK)
+    {
+        return SYSTEM_LINK_STATUS_EFAIL;
+    }
+
+    if(pInfo->dataFormat==SYSTEM_DF_YUV420SP_UV)
+    {
+        /* setup descriptor for UV plane */
+        pDesc++;
+
+        bpp = 1;
+
+        pDesc->destAddr   = (UInt8*)pInfo->destAddr[1]
+                          + pInfo->destPitch[1]
+                            *((pInfo->destStartY+pInfo->height)/2-1)
+                          + pInfo->destStartX * bpp;
+
+        if(fillData)
+        {
+            pDesc->srcAddr   = pInfo->srcAddr[1];
+            pDesc->srcBIdx   = 0;
+        }
+        else
+        {
+            pDesc->srcAddr   = (UInt8*)pInfo->srcAddr[1]
+                             + pInfo->srcPitch[1]
+                               *((pInfo->srcStartY+pInfo->height)/2-1)
+                             + pInfo->srcStartX * bpp;
+            pDesc->srcBIdx   = -(Int32)pInfo->srcPitch[1];
+        }
+
+        pDesc->destBIdx   = -(Int32)pInfo->destPitch[1];
+        pDesc->aCnt       = pInfo->width*bpp;
+        pDesc->bCnt       = pInfo->height/2;
+
+        if(Utils_dmaTxListCheckDesc(pDesc) != SYSTEM_LINK_STATUS_SOK)
+        {
+            return SYSTEM_LINK_STATUS_EFAIL;
+        }
+    }
+
+    pList->numDesc += numDesc;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get total bytes moved by a transfer list
+ *
+ * \param pList     [IN] Transfer list
+ *
+ * \return Bytes written to destination by all descriptors
+ *
+ *******************************************************************************
+ */
+UInt32 Utils_dmaTxListGetBytes(const Utils_DmaTxList *pList)
+{
+    UInt32 i, bytes = 0;
+
+    for(i=0; i<pList->numDesc; i++)
+    {
+        bytes += pList->pDesc[i].aCnt * pList->pDesc[i].bCnt;
+    }
+
+    return bytes;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Execute a transfer list with CPU
+ *
+ *        Functional model of EDMA for the descriptors in the list,
+ *        descriptors are executed in order and line pitch is taken as a
+ *        signed 16-bit value, like EDMA does. Result is same as submitting
+ *        the list to EDMA, so this can be used to check descriptor
+ *        generation, or as a fallback when no DMA channel is available.
+ *
+ *        Caches are not maintained by this function.
+ *
+ * \param pList     [IN] Transfer list
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+Int32 Utils_dmaTxListCpuRun(const Utils_DmaTxList *pList)
+{
+    const Utils_DmaTxDesc *pDesc;
+    UInt8 *pSrc, *pDest;
+    UInt32 i, line;
+
+    for(i=0; i<pList->numDesc; i++)
+    {
+        pDesc = &pList->pDesc[i];
+
+        if(Utils_dmaTxListCheckDesc(pDesc) != SYSTEM_LINK_STATUS_SOK)
+        {
+            return SYSTEM_LINK_STATUS_EFAIL;
+        }
+
+        pSrc  = (UInt8*)pDesc->srcAddr;
+        pDest = (UInt8*)pDesc->destAddr;
+
+        for(line=0; line<pDesc->bCnt; line++)
+        {
+            memcpy(pDest, pSrc, pDesc->aCnt);
+
+            pSrc  += (Int16)pDesc->srcBIdx;
+            pDest += (Int16)pDesc->destBIdx;
+        }
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
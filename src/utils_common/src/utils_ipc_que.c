@@ -277,6 +277,113 @@ Int32  Utils_ipcQueWrite(Utils_IpcQueHandle * handle,
 
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Write multiple elements into the queue
+ *
+ *        Elements are copied one after the other and the write index is
+ *        updated once after all of them are copied, so the reader sees the
+ *        whole batch at once. Compared to calling Utils_ipcQueWrite() for
+ *        each element, the queue header in shared memory is read and the
+ *        write index is written and read back only once per batch.
+ *
+ *        If the queue does not have space for all elements, only the first
+ *        elements which fit are written. One element is always left unused
+ *        so that a full queue is not seen as empty by the reader.
+ *
+ * \param handle             [IN]  queue handle
+ * \param data               [IN]  local buffer with '*numElements' elements
+ *                                 of 'dataSize' bytes each, back to back
+ * \param dataSize           [IN]  size of each element, MUST be <= to
+ *                                 elementSize set during queue create
+ * \param numElements        [IN]  number of elements to write
+ *                           [OUT] number of elements written
+ *
+ * \return SYSTEM_LINK_STATUS_SOK if all elements are written
+ *         SYSTEM_LINK_STATUS_EAGAIN if queue did not have space for all
+ *         elements
+ *
+ *******************************************************************************
+ */
+Int32  Utils_ipcQueWriteMulti(Utils_IpcQueHandle * handle,
+                            volatile UInt8 *data,
+                            UInt32 dataSize,
+                            UInt32 *numElements)
+{
+    volatile UInt32 oldIntState;
+    volatile System_IpcQueHeader *pShm;
+    volatile UInt8 *pWrite;
+    volatile UInt32 writeIdx;
+    UInt32 readIdx, numFull, numFree, numWrite, i;
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+
+    if(    handle == NULL
+        || handle->sharedMemBaseAddr == NULL
+        || dataSize > handle->elementSize
+        || numElements == NULL
+      )
+    {
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    numWrite = *numElements;
+    *numElements = 0;
+
+    pShm = (System_IpcQueHeader*)handle->sharedMemBaseAddr;
+
+    if(     pShm->maxElements != handle->maxElements
+        ||  pShm->elementSize != handle->elementSize
+        )
+    {
+        return SYSTEM_LINK_STATUS_EINVALID_PARAMS;
+    }
+
+    oldIntState = Hwi_disable();
+
+    readIdx  = pShm->curRd;
+    writeIdx = pShm->curWr;
+
+    if(readIdx <= writeIdx)
+        numFull = writeIdx - readIdx;
+    else
+        numFull = (handle->maxElements - readIdx) + writeIdx;
+
+    numFree = handle->maxElements - 1U - numFull;
+
+    if(numWrite > numFree)
+    {
+        numWrite = numFree;
+        status = SYSTEM_LINK_STATUS_EAGAIN;
+    }
+
+    for(i=0; i<numWrite; i++)
+    {
+        pWrite =  (UInt8*)handle->sharedMemBaseAddr
+                + sizeof(System_IpcQueHeader)
+                + writeIdx*handle->elementSize;
+
+        memcpy((void*)pWrite, (void*)(data + i*dataSize), dataSize);
+
+        writeIdx = (writeIdx+1)%handle->maxElements;
+    }
+
+    if(numWrite)
+    {
+        /* move writeIdx, once for all elements */
+        pShm->curWr = writeIdx;
+
+        /* dummy readback to ensure idx is written to memory */
+        writeIdx = pShm->curWr;
+    }
+
+    Hwi_restore(oldIntState);
+
+    *numElements = numWrite;
+
+    return status;
+}
+
 /**
  *******************************************************************************
  *
@@ -278,6 +278,7 @@ System_LinkStatistics *Utils_linkStatsCollectorAllocInst(uint32_t linkId, char *
 
             Utils_resetLatency(&linkStats->linkLatency);
             Utils_resetLatency(&linkStats->srcToLinkLatency);
+            Utils_resetLinkPhaseStats(&linkStats->phaseStats);
 
             strncpy(linkStats->linkName, linkName,
                 (sizeof(linkStats->linkName) - 1U));
@@ -578,7 +579,9 @@ Void Utils_linkStatsPrintLinkStatistics(uint32_t linkId)
     Utils_LinkStatistics linkStats;
     Utils_LatencyStats   linkLatency;
     Utils_LatencyStats   srcToLinkLatency;
+    Utils_LinkPhaseStats phaseStats;
     UInt32 cmd;
+    Int32 latencyStatus;
 
     pLinkStats = Utils_linkStatsGetLinkStatInst(linkId);
     if(pLinkStats==NULL)
@@ -592,8 +595,14 @@ Void Utils_linkStatsPrintLinkStatistics(uint32_t linkId)
     {
         /* take a local copy */
         linkStats = pLinkStats->linkStats;
-        linkLatency = pLinkStats->linkLatency;
-        srcToLinkLatency = pLinkStats->srcToLinkLatency;
+        latencyStatus = Utils_getLatency(&linkLatency,
+                                         &pLinkStats->linkLatency);
+        if (latencyStatus == SYSTEM_LINK_STATUS_SOK)
+        {
+            latencyStatus = Utils_getLatency(&srcToLinkLatency,
+                                             &pLinkStats->srcToLinkLatency);
+        }
+        Utils_getLinkPhaseStats(&phaseStats, &pLinkStats->phaseStats);
 
         Vps_printf(" \n");
         Vps_printf(" ### CPU [%6s], LinkID [%3d],\n",
@@ -602,10 +611,20 @@ Void Utils_linkStatsPrintLinkStatistics(uint32_t linkId)
             );
         Utils_printLinkStatistics(&linkStats, pLinkStats->linkName, FALSE);
 
-        Utils_printLatency(pLinkStats->linkName,
-                           &linkLatency,
-                           &srcToLinkLatency,
-                           FALSE);
+        if (latencyStatus == SYSTEM_LINK_STATUS_SOK)
+        {
+            Utils_printLatency(pLinkStats->linkName,
+                               &linkLatency,
+                               &srcToLinkLatency,
+                               FALSE);
+        }
+        else
+        {
+            Vps_printf(" [ %s ] Latency stats changing, not printed !!!\n",
+                       pLinkStats->linkName);
+        }
+
+        Utils_printLinkPhaseStats(pLinkStats->linkName, &phaseStats);
 
         /* reset link stats */
         Utils_linkStatsSendCommand(
@@ -640,6 +659,7 @@ Void  Utils_linkStatsCollectorProcessCmd(System_LinkStatistics *linkStatsInfo)
 
                 Utils_resetLatency(&linkStatsInfo->linkLatency);
                 Utils_resetLatency(&linkStatsInfo->srcToLinkLatency);
+                Utils_resetLinkPhaseStats(&linkStatsInfo->phaseStats);
 
                 /* Reset is done so send reset_done command to monitor thread */
                 cmd = LINK_STATS_CMD_RESET_STATS_DONE;
@@ -650,6 +670,300 @@ Void  Utils_linkStatsCollectorProcessCmd(System_LinkStatistics *linkStatsInfo)
     }
 }
 
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function to copy latency stats into snapshot format
+ *
+ *******************************************************************************
+ */
+static Void Utils_linkStatsCopyLatency(NetworkCtrl_LinkStatsLatency *pDst,
+                                       Utils_LatencyStats *pSrc)
+{
+    Utils_LatencyStats latency;
+
+    /* link may be updating the stats on its own core */
+    if (Utils_getLatency(&latency, pSrc) != SYSTEM_LINK_STATUS_SOK)
+    {
+        memset(pDst, 0, sizeof(*pDst));
+        return;
+    }
+
+    pDst->count = latency.countLo;
+    pDst->accHi = latency.accumulatedLatencyHi;
+    pDst->accLo = latency.accumulatedLatencyLo;
+    pDst->min   = latency.minLatencyLo;
+    pDst->max   = latency.maxLatencyLo;
+}
+
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function to copy link phase stats into snapshot format
+ *
+ *******************************************************************************
+ */
+static Void Utils_linkStatsCopyPhase(NetworkCtrl_LinkStatsPhase *pDst,
+                                     Utils_LinkPhaseStats *pSrc)
+{
+    Utils_LinkPhaseStats phaseStats;
+    UInt32 phase;
+
+    Utils_getLinkPhaseStats(&phaseStats, pSrc);
+
+    for (phase = 0; phase < UTILS_LINK_PHASE_MAX; phase++)
+    {
+        pDst[phase].count  = phaseStats.count[phase];
+        pDst[phase].timeHi = phaseStats.timeHi[phase];
+        pDst[phase].timeLo = phaseStats.timeLo[phase];
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function returns max size of a snapshot in bytes
+ *
+ *******************************************************************************
+ */
+UInt32 Utils_linkStatsCollectorGetSnapshotMaxSize(void)
+{
+    return sizeof(NetworkCtrl_LinkStatsHeader)
+        + (SYSTEM_PROC_MAX * sizeof(NetworkCtrl_LinkStatsCore))
+        + (LINK_STATS_PRF_MAX_TSK * sizeof(NetworkCtrl_LinkStatsTask))
+        + (SYSTEM_PROC_MAX * UTILS_HEAPID_MAXNUMHEAPS
+                * sizeof(NetworkCtrl_LinkStatsHeap))
+        + (LINK_STATS_MAX_STATS_INST *
+            (sizeof(NetworkCtrl_LinkStatsLink) +
+                (SYSTEM_MAX_CH_PER_OUT_QUE * sizeof(NetworkCtrl_LinkStatsCh))));
+}
+
+/**
+ *******************************************************************************
+ *
+ *  \brief  Function to take a binary snapshot of all statistics.
+ *
+ *          Only allocated link and task instances and heaps with non-zero
+ *          size are included, so the snapshot size is proportional to the
+ *          number of links in the running use-case.
+ *
+ *  \param  pBuf        Buffer into which snapshot is written
+ *  \param  bufSize     Size of pBuf in bytes
+ *  \param  coreFlags   NETWORK_CTRL_LINK_STATS_CORE_FLAG_* for each core,
+ *                      can be NULL
+ *
+ *  \return Size of snapshot in bytes, 0 if pBuf is too small
+ *
+ *******************************************************************************
+ */
+UInt32 Utils_linkStatsCollectorGetSnapshot(UInt8 *pBuf, UInt32 bufSize,
+                                           UInt32 *coreFlags)
+{
+    NetworkCtrl_LinkStatsHeader *pHeader;
+    NetworkCtrl_LinkStatsCore *pCore;
+    NetworkCtrl_LinkStatsTask *pTask;
+    NetworkCtrl_LinkStatsHeap *pHeap;
+    NetworkCtrl_LinkStatsLink *pLink;
+    NetworkCtrl_LinkStatsCh *pCh;
+    System_LinkStatsCorePrfObj *pCorePrfObj;
+    System_LinkStatsPrfLoadObj *pPrfLoadObj;
+    System_LinkStatistics *pLinkStats;
+    Utils_LinkChStatistics *pChStats;
+    Utils_MemHeapStats *pHeapStats;
+    Utils_LinkStatsIndexInfo_t *idxInfo;
+    UInt32 procId, cnt, heapId, chId, outId, numCh, numOut;
+    UInt32 curTime;
+    UInt8 *pCur;
+
+    if ((NULL == pBuf) ||
+        (bufSize < Utils_linkStatsCollectorGetSnapshotMaxSize()))
+    {
+        return 0U;
+    }
+
+    curTime = (UInt32)Utils_getCurGlobalTimeInMsec();
+
+    pHeader = (NetworkCtrl_LinkStatsHeader *)pBuf;
+    memset(pHeader, 0, sizeof(NetworkCtrl_LinkStatsHeader));
+    pHeader->magic      = NETWORK_CTRL_LINK_STATS_MAGIC;
+    pHeader->version    = NETWORK_CTRL_LINK_STATS_VERSION;
+    pHeader->timeInMsec = curTime;
+
+    pCur = pBuf + sizeof(NetworkCtrl_LinkStatsHeader);
+
+    for (procId = 0; procId < SYSTEM_PROC_MAX; procId++)
+    {
+        if (System_isProcEnabled(procId) == FALSE)
+        {
+            continue;
+        }
+
+        pCorePrfObj = &gSystemLinkStatsCoreObj.corePrfObj[procId];
+        pCore = (NetworkCtrl_LinkStatsCore *)pCur;
+
+        pCore->procId      = procId;
+        pCore->flags       = (NULL != coreFlags) ? coreFlags[procId] : 0U;
+        pCore->totalTimeHi = pCorePrfObj->accPrfLoadObj.totalTimeHi;
+        pCore->totalTimeLo = pCorePrfObj->accPrfLoadObj.totalTimeLo;
+        pCore->idleTimeHi  = pCorePrfObj->accPrfLoadObj.totalIdlTskTimeHi;
+        pCore->idleTimeLo  = pCorePrfObj->accPrfLoadObj.totalIdlTskTimeLo;
+        pCore->hwiTimeHi   = pCorePrfObj->accPrfLoadObj.totalHwiThreadTimeHi;
+        pCore->hwiTimeLo   = pCorePrfObj->accPrfLoadObj.totalHwiThreadTimeLo;
+        pCore->swiTimeHi   = pCorePrfObj->accPrfLoadObj.totalSwiThreadTimeHi;
+        pCore->swiTimeLo   = pCorePrfObj->accPrfLoadObj.totalSwiThreadTimeLo;
+        pCore->maxSemaphoreObjs  = pCorePrfObj->maxSemaphoreObjs;
+        pCore->freeSemaphoreObjs = pCorePrfObj->freeSemaphoreObjs;
+        pCore->maxTaskObjs       = pCorePrfObj->maxTaskObjs;
+        pCore->freeTaskObjs      = pCorePrfObj->freeTaskObjs;
+        pCore->maxClockObjs      = pCorePrfObj->maxClockObjs;
+        pCore->freeClockObjs     = pCorePrfObj->freeClockObjs;
+        pCore->maxHwiObjs        = pCorePrfObj->maxHwiObjs;
+        pCore->freeHwiObjs       = pCorePrfObj->freeHwiObjs;
+
+        pCur += sizeof(NetworkCtrl_LinkStatsCore);
+        pHeader->numCores++;
+    }
+
+    for (procId = 0; procId < SYSTEM_PROC_MAX; procId++)
+    {
+        if (System_isProcEnabled(procId) == FALSE)
+        {
+            continue;
+        }
+
+        idxInfo = &gUtilsLinkStateCollectorObj.prfLoadInstIdxInfo[procId];
+
+        for (cnt = idxInfo->startIdx;
+                cnt < (idxInfo->numInst + idxInfo->startIdx); cnt ++)
+        {
+            pPrfLoadObj = &gSystemLinkStatsCoreObj.prfLoadObj[cnt];
+
+            if (TRUE == pPrfLoadObj->isAlloc)
+            {
+                pTask = (NetworkCtrl_LinkStatsTask *)pCur;
+
+                pTask->procId = procId;
+                strncpy(pTask->name, pPrfLoadObj->name,
+                    (sizeof(pTask->name) - 1U));
+                pTask->name[sizeof(pTask->name) - 1U] = '\0';
+                pTask->totalTimeHi = pPrfLoadObj->totalTskThreadTimeHi;
+                pTask->totalTimeLo = pPrfLoadObj->totalTskThreadTimeLo;
+
+                pCur += sizeof(NetworkCtrl_LinkStatsTask);
+                pHeader->numTasks++;
+            }
+        }
+    }
+
+    for (procId = 0; procId < SYSTEM_PROC_MAX; procId++)
+    {
+        if (System_isProcEnabled(procId) == FALSE)
+        {
+            continue;
+        }
+
+        pCorePrfObj = &gSystemLinkStatsCoreObj.corePrfObj[procId];
+
+        for (heapId = 0; heapId < UTILS_HEAPID_MAXNUMHEAPS; heapId++)
+        {
+            pHeapStats = &pCorePrfObj->heapStats[heapId];
+
+            if (0U != pHeapStats->heapSize)
+            {
+                pHeap = (NetworkCtrl_LinkStatsHeap *)pCur;
+
+                pHeap->procId = procId;
+                pHeap->heapId = heapId;
+                strncpy(pHeap->name, pHeapStats->heapName,
+                    (sizeof(pHeap->name) - 1U));
+                pHeap->name[sizeof(pHeap->name) - 1U] = '\0';
+                pHeap->heapAddr = pHeapStats->heapAddr;
+                pHeap->heapSize = pHeapStats->heapSize;
+                pHeap->freeSize = pHeapStats->freeSize;
+
+                pCur += sizeof(NetworkCtrl_LinkStatsHeap);
+                pHeader->numHeaps++;
+            }
+        }
+    }
+
+    for (cnt = 0; cnt < LINK_STATS_MAX_STATS_INST; cnt++)
+    {
+        pLinkStats = &gSystemLinkStatsCoreObj.linkStats[cnt];
+
+        if (TRUE != pLinkStats->isAlloc)
+        {
+            continue;
+        }
+
+        pLink = (NetworkCtrl_LinkStatsLink *)pCur;
+
+        numCh = pLinkStats->linkStats.numCh;
+        if (numCh > SYSTEM_MAX_CH_PER_OUT_QUE)
+        {
+            numCh = SYSTEM_MAX_CH_PER_OUT_QUE;
+        }
+
+        pLink->linkId = pLinkStats->linkId;
+        strncpy(pLink->name, pLinkStats->linkName, (sizeof(pLink->name) - 1U));
+        pLink->name[sizeof(pLink->name) - 1U] = '\0';
+        pLink->elapsedTimeInMsec =
+            curTime - pLinkStats->linkStats.statsStartTime;
+        pLink->numCh = numCh;
+        pLink->inBufErrorCount     = pLinkStats->linkStats.inBufErrorCount;
+        pLink->outBufErrorCount    = pLinkStats->linkStats.outBufErrorCount;
+        pLink->newDataCmdCount     = pLinkStats->linkStats.newDataCmdCount;
+        pLink->releaseDataCmdCount = pLinkStats->linkStats.releaseDataCmdCount;
+        pLink->getFullBufCount     = pLinkStats->linkStats.getFullBufCount;
+        pLink->putEmptyBufCount    = pLinkStats->linkStats.putEmptyBufCount;
+        pLink->notifyEventCount    = pLinkStats->linkStats.notifyEventCount;
+
+        Utils_linkStatsCopyLatency(&pLink->linkLatency,
+                                   &pLinkStats->linkLatency);
+        Utils_linkStatsCopyLatency(&pLink->srcToLinkLatency,
+                                   &pLinkStats->srcToLinkLatency);
+        Utils_linkStatsCopyPhase(pLink->phase, &pLinkStats->phaseStats);
+
+        pCur += sizeof(NetworkCtrl_LinkStatsLink);
+
+        for (chId = 0; chId < numCh; chId++)
+        {
+            pChStats = &pLinkStats->linkStats.chStats[chId];
+            pCh = (NetworkCtrl_LinkStatsCh *)pCur;
+
+            memset(pCh, 0, sizeof(NetworkCtrl_LinkStatsCh));
+
+            numOut = pChStats->numOut;
+            if (numOut > NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE)
+            {
+                numOut = NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE;
+            }
+
+            pCh->inBufRecvCount     = pChStats->inBufRecvCount;
+            pCh->inBufDropCount     = pChStats->inBufDropCount;
+            pCh->inBufUserDropCount = pChStats->inBufUserDropCount;
+            pCh->inBufProcessCount  = pChStats->inBufProcessCount;
+            pCh->numOut = numOut;
+
+            for (outId = 0; outId < numOut; outId++)
+            {
+                pCh->outBufCount[outId] = pChStats->outBufCount[outId];
+                pCh->outBufDropCount[outId] = pChStats->outBufDropCount[outId];
+                pCh->outBufUserDropCount[outId] =
+                    pChStats->outBufUserDropCount[outId];
+            }
+
+            pCur += sizeof(NetworkCtrl_LinkStatsCh);
+        }
+
+        pHeader->numLinks++;
+    }
+
+    pHeader->totalSize = (UInt32)(pCur - pBuf);
+
+    return pHeader->totalSize;
+}
+
 
 /*******************************************************************************
  *  Local Functions
@@ -142,6 +142,11 @@
     #error "Increase LINK_STATS_PRF_MAX_TSK in file utils_link_stats_if.h"
 #endif
 
+/** \brief Guard macro, snapshot format in networkCtrl_if.h must match */
+#if (SYSTEM_MAX_OUT_QUE != NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE)
+    #error "Update NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE in networkCtrl_if.h"
+#endif
+
 
 /**
  *******************************************************************************
@@ -836,71 +836,210 @@ Void Utils_prfLoadUpdate()
 /**
  *******************************************************************************
  *
- * \brief Reset latency stats
+ * \brief Names of link phases, used when printing
  *
- * \param  lStats    [OUT] latency statistics
+ *******************************************************************************
+ */
+static char *gUtils_linkPhaseName[UTILS_LINK_PHASE_MAX] =
+{
+    "Get Buffers", "Put Buffers", "Cache Ops", "Process", "Send Output"
+};
+
+/**
+ *******************************************************************************
+ *
+ * \brief Reset link phase stats
+ *
+ * \param  pStats    [OUT] link phase statistics
  *
  *******************************************************************************
  */
-Void Utils_resetLatency(Utils_LatencyStats *lStats)
+Void Utils_resetLinkPhaseStats(Utils_LinkPhaseStats *pStats)
 {
-    lStats->accumulatedLatencyHi = lStats->accumulatedLatencyLo = 0;
-    lStats->minLatencyHi = lStats->minLatencyLo = 0xFFFFFFFF;
-    lStats->maxLatencyHi = lStats->maxLatencyLo = 0x0;
-    lStats->countHi = lStats->countLo = 0;
+    volatile Utils_LinkPhaseStats *pPhaseStats = pStats;
+    uint32_t phase;
+    Types_FreqHz freq;
+
+    /* reset is done on the core running the link */
+    Timestamp_getFreq(&freq);
+
+    pPhaseStats->seqCount = (pPhaseStats->seqCount + 1U) | 1U;
+
+    pPhaseStats->tsFreqMhz = freq.lo / 1000000U;
+
+    for (phase = 0U; phase < UTILS_LINK_PHASE_MAX; phase++)
+    {
+        pPhaseStats->timeHi[phase] = 0U;
+        pPhaseStats->timeLo[phase] = 0U;
+        pPhaseStats->count[phase]  = 0U;
+    }
+
+    /* nestedTime is free running, it must not be reset when a phase could
+     * be in progress */
+
+    pPhaseStats->seqCount++;
 }
 
 /**
  *******************************************************************************
  *
- * \brief Calculate latency
+ * \brief Get a consistent copy of link phase stats updated by another task
+ *        or core
  *
- * \param  lStats    [OUT] latency statistics
- * \param  linkLocalTime     [IN]  time at which frame was received at the link
+ * \param  pDst    [OUT] copy of link phase statistics
+ * \param  pSrc    [IN]  link phase statistics
  *
  *******************************************************************************
  */
-Void Utils_updateLatency(Utils_LatencyStats *lStats,
-                         uint64_t linkLocalTime)
+Void Utils_getLinkPhaseStats(Utils_LinkPhaseStats *pDst,
+                             const volatile Utils_LinkPhaseStats *pSrc)
 {
-    uint64_t latency;
-    uint64_t curTime = Utils_getCurGlobalTimeInUsec();
-    uint64_t time64, temp;
+    uint32_t seqCount, phase;
+    uint32_t retry = 0;
 
-    latency = curTime - linkLocalTime;
+    do
+    {
+        seqCount = pSrc->seqCount;
 
-    time64 = lStats->minLatencyLo & 0xFFFFFFFFU;
-    temp = lStats->minLatencyHi & 0xFFFFFFFFU;
-    time64 |= (temp << 32);
-    if (time64 > latency)
+        for (phase = 0U; phase < UTILS_LINK_PHASE_MAX; phase++)
+        {
+            pDst->timeHi[phase] = pSrc->timeHi[phase];
+            pDst->timeLo[phase] = pSrc->timeLo[phase];
+            pDst->count[phase]  = pSrc->count[phase];
+        }
+        pDst->nestedTime = pSrc->nestedTime;
+        pDst->tsFreqMhz  = pSrc->tsFreqMhz;
+
+        retry++;
+
+    } while ((((seqCount & 1U) != 0U) || (seqCount != pSrc->seqCount))
+             && (retry < UTILS_LATENCY_READ_MAX_RETRY));
+
+    pDst->seqCount = seqCount;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Mark start of a link phase
+ *
+ *        The returned value is passed to Utils_linkPhaseEnd(). It is the
+ *        current time minus the time accounted so far, so that time of
+ *        phases ending in between is excluded from this phase.
+ *
+ * \param  pStats    [IN] link phase statistics
+ *
+ * \return value to pass to Utils_linkPhaseEnd()
+ *
+ *******************************************************************************
+ */
+uint64_t Utils_linkPhaseBegin(const Utils_LinkPhaseStats *pStats)
+{
+    return Utils_prfTsGet64() - (uint64_t)pStats->nestedTime;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Mark end of a link phase and account its time
+ *
+ *        A single phase must take less than 2^32 timestamp ticks
+ *
+ * \param  pStats    [OUT] link phase statistics
+ * \param  phase     [IN]  UTILS_LINK_PHASE_*
+ * \param  startTs   [IN]  value returned by Utils_linkPhaseBegin()
+ *
+ *******************************************************************************
+ */
+Void Utils_linkPhaseEnd(Utils_LinkPhaseStats *pStats,
+                        uint32_t phase,
+                        uint64_t startTs)
+{
+    volatile Utils_LinkPhaseStats *pPhaseStats = pStats;
+    uint32_t elapsed, timeLo;
+
+    UTILS_assert(phase < UTILS_LINK_PHASE_MAX);
+
+    /* modulo 2^32: (now - start) - (nested time since start) */
+    elapsed = (uint32_t)(Utils_prfTsGet64() - startTs)
+                - pPhaseStats->nestedTime;
+
+    pPhaseStats->seqCount++;
+
+    timeLo = pPhaseStats->timeLo[phase] + elapsed;
+    pPhaseStats->timeLo[phase] = timeLo;
+    if (timeLo < elapsed)
     {
-        lStats->minLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
-        lStats->minLatencyLo = (latency) & 0xFFFFFFFFU;
+        pPhaseStats->timeHi[phase]++;
     }
+    pPhaseStats->count[phase]++;
 
-    time64 = lStats->maxLatencyLo & 0xFFFFFFFFU;
-    temp = lStats->maxLatencyHi & 0xFFFFFFFFU;
-    time64 |= (temp << 32);
-    if (latency > time64)
+    pPhaseStats->nestedTime += elapsed;
+
+    pPhaseStats->seqCount++;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Print time spent by a link in each phase
+ *
+ * \param  name      [IN] Name of module
+ * \param  pStats    [IN] link phase statistics, local copy
+ *
+ *******************************************************************************
+ */
+Void Utils_printLinkPhaseStats(char *name,
+                               const Utils_LinkPhaseStats *pStats)
+{
+    uint64_t time64, total64, temp;
+    uint32_t phase;
+    uint32_t freqMhz;
+
+    total64 = 0;
+    for (phase = 0U; phase < UTILS_LINK_PHASE_MAX; phase++)
     {
-        lStats->maxLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
-        lStats->maxLatencyLo = (latency) & 0xFFFFFFFFU;
+        time64 = pStats->timeLo[phase];
+        temp = pStats->timeHi[phase];
+        total64 += time64 | (temp << 32);
     }
 
-    time64 = lStats->accumulatedLatencyLo & 0xFFFFFFFFU;
-    temp = lStats->accumulatedLatencyHi & 0xFFFFFFFFU;
-    time64 |= (temp << 32);
-    time64 += latency;
-    lStats->accumulatedLatencyHi = (time64 >> 32) & 0xFFFFFFFFU;
-    lStats->accumulatedLatencyLo = (time64) & 0xFFFFFFFFU;
+    if (total64 == 0U)
+    {
+        return;
+    }
 
-    time64 = lStats->countLo & 0xFFFFFFFFU;
-    temp = lStats->countHi & 0xFFFFFFFFU;
-    time64 |= (temp << 32);
-    time64 ++;
-    lStats->countHi = (time64 >> 32) & 0xFFFFFFFFU;
-    lStats->countLo = (time64) & 0xFFFFFFFFU;
+    /* time is in ticks of the core running the link, which may not be
+     * this core */
+    freqMhz = pStats->tsFreqMhz;
+    if (freqMhz == 0U)
+    {
+        freqMhz = 1U;
+    }
 
+    Vps_printf( " \n");
+    Vps_printf( " [ %s ] CPU TIME PER PHASE,\n", name);
+    Vps_printf( " ********************\n");
+
+    for (phase = 0U; phase < UTILS_LINK_PHASE_MAX; phase++)
+    {
+        if (pStats->count[phase] == 0U)
+        {
+            continue;
+        }
+
+        time64 = pStats->timeLo[phase];
+        temp = pStats->timeHi[phase];
+        time64 |= (temp << 32);
+
+        Vps_printf( " %-12s : %3d.%d %%, Avg = %8d us, Count = %8d\r\n",
+            gUtils_linkPhaseName[phase],
+            (uint32_t)((time64*100U)/total64),
+            (uint32_t)(((time64*1000U)/total64)%10U),
+            (uint32_t)((time64/pStats->count[phase])/freqMhz),
+            pStats->count[phase]);
+    }
+    Vps_printf( " \n");
 }
 
 /**
@@ -0,0 +1,258 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ *  \file utils_prf_latency.c
+ *
+ *  \brief Latency statistics update and read APIs of UTILS PERF
+ *
+ *          Kept apart from utils_prf.c since these do not depend on BIOS,
+ *          so they can be built and benchmarked on a host PC.
+ *
+ *  \version 0.0 (Oct 2015) : First version
+ *******************************************************************************
+*/
+
+/*******************************************************************************
+ *  INCLUDE FILES
+ *******************************************************************************
+ */
+#include <src/utils_common/include/utils_prf.h>
+
+/**
+ *******************************************************************************
+ *
+ * \brief Max attempts to get a consistent copy of latency stats, after this
+ *        Utils_getLatency() returns SYSTEM_LINK_STATUS_EAGAIN. This avoids
+ *        spinning when the writer is pre-empted on the same core by the
+ *        reader.
+ *
+ *******************************************************************************
+ */
+#define UTILS_LATENCY_READ_MAX_RETRY    (8U)
+
+/**
+ *******************************************************************************
+ *
+ * \brief Barriers between seqCount and stats fields
+ *
+ *        A15 (and host) may reorder accesses to non-cached shared memory,
+ *        release and acquire fences are used, which is DMB on ARM. Stats
+ *        fields are plain accesses between the fences and Hi/Lo pairs are
+ *        accessed as native 64-bit values, see Utils_latencyGet64().
+ *
+ *        TI compilers keep volatile accesses in program order and DSP, M4
+ *        and EVE issue them in order to non-cached memory. There the stats
+ *        fields are accessed as volatile 32-bit words and no barrier
+ *        instruction is needed.
+ *
+ *******************************************************************************
+ */
+#if defined (__GNUC__)
+#define UTILS_LATENCY_WR_BARRIER()      __atomic_thread_fence(__ATOMIC_RELEASE)
+#define UTILS_LATENCY_RD_BARRIER()      __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define UTILS_LATENCY_NATIVE_64BIT
+typedef Utils_LatencyStats Utils_LatencyStatsWr;
+#else
+#define UTILS_LATENCY_WR_BARRIER()
+#define UTILS_LATENCY_RD_BARRIER()
+typedef volatile Utils_LatencyStats Utils_LatencyStatsWr;
+#endif
+
+#ifdef UTILS_LATENCY_NATIVE_64BIT
+/**
+ *******************************************************************************
+ *
+ * \brief Get a Lo/Hi word pair as 64-bit value, pairs are only 32-bit aligned
+ *
+ *******************************************************************************
+ */
+static inline uint64_t Utils_latencyGet64(const uint32_t *pLo)
+{
+    uint64_t value;
+
+    memcpy(&value, pLo, sizeof(value));
+
+    return value;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Set a Lo/Hi word pair from 64-bit value
+ *
+ *******************************************************************************
+ */
+static inline Void Utils_latencySet64(uint32_t *pLo, uint64_t value)
+{
+    memcpy(pLo, &value, sizeof(value));
+}
+#endif
+
+/**
+ *******************************************************************************
+ *
+ * \brief Reset latency stats
+ *
+ * \param  lStats    [OUT] latency statistics
+ *
+ *******************************************************************************
+ */
+Void Utils_resetLatency(Utils_LatencyStats *lStats)
+{
+    Utils_LatencyStatsWr *pStats = lStats;
+
+    /* make sequence odd, whatever its value was before */
+    pStats->seqCount = (pStats->seqCount + 1U) | 1U;
+    UTILS_LATENCY_WR_BARRIER();
+
+    pStats->accumulatedLatencyHi = pStats->accumulatedLatencyLo = 0;
+    pStats->minLatencyHi = pStats->minLatencyLo = 0xFFFFFFFF;
+    pStats->maxLatencyHi = pStats->maxLatencyLo = 0x0;
+    pStats->countHi = pStats->countLo = 0;
+
+    UTILS_LATENCY_WR_BARRIER();
+    pStats->seqCount++;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get a consistent copy of latency stats updated by another task or
+ *        core
+ *
+ * \param  pDst    [OUT] copy of latency statistics
+ * \param  pSrc    [IN]  latency statistics
+ *
+ * \return SYSTEM_LINK_STATUS_SOK if copy is consistent,
+ *         SYSTEM_LINK_STATUS_EAGAIN if stats kept changing while they were
+ *         copied, pDst may then be inconsistent
+ *
+ *******************************************************************************
+ */
+Int32 Utils_getLatency(Utils_LatencyStats *pDst,
+                       const volatile Utils_LatencyStats *pSrc)
+{
+    uint32_t seqCount;
+    uint32_t retry = 0;
+    Bool isSame;
+
+    do
+    {
+        seqCount = pSrc->seqCount;
+        UTILS_LATENCY_RD_BARRIER();
+
+        pDst->maxLatencyHi         = pSrc->maxLatencyHi;
+        pDst->maxLatencyLo         = pSrc->maxLatencyLo;
+        pDst->minLatencyHi         = pSrc->minLatencyHi;
+        pDst->minLatencyLo         = pSrc->minLatencyLo;
+        pDst->accumulatedLatencyHi = pSrc->accumulatedLatencyHi;
+        pDst->accumulatedLatencyLo = pSrc->accumulatedLatencyLo;
+        pDst->countHi              = pSrc->countHi;
+        pDst->countLo              = pSrc->countLo;
+
+        UTILS_LATENCY_RD_BARRIER();
+        isSame = (((seqCount & 1U) == 0U) && (seqCount == pSrc->seqCount)) ?
+                    TRUE : FALSE;
+        retry++;
+
+    } while ((isSame == FALSE) && (retry < UTILS_LATENCY_READ_MAX_RETRY));
+
+    pDst->seqCount = seqCount;
+
+    return (isSame == TRUE) ? SYSTEM_LINK_STATUS_SOK :
+                              SYSTEM_LINK_STATUS_EAGAIN;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Calculate latency
+ *
+ *        seqCount is odd while fields are updated, see Utils_getLatency().
+ *        On cores with 64-bit loads and stores each Hi/Lo pair is updated
+ *        as one 64-bit value.
+ *
+ * \param  lStats    [OUT] latency statistics
+ * \param  linkLocalTime     [IN]  time at which frame was received at the link
+ *
+ *******************************************************************************
+ */
+Void Utils_updateLatency(Utils_LatencyStats *lStats,
+                         uint64_t linkLocalTime)
+{
+    Utils_LatencyStatsWr *pStats = lStats;
+    uint64_t latency;
+    uint64_t curTime = Utils_getCurGlobalTimeInUsec();
+#ifndef UTILS_LATENCY_NATIVE_64BIT
+    uint64_t time64, temp;
+#endif
+    uint32_t seqCount;
+
+    latency = curTime - linkLocalTime;
+
+    seqCount = pStats->seqCount;
+    pStats->seqCount = seqCount + 1U;
+    UTILS_LATENCY_WR_BARRIER();
+
+#ifdef UTILS_LATENCY_NATIVE_64BIT
+    if (Utils_latencyGet64(&pStats->minLatencyLo) > latency)
+    {
+        Utils_latencySet64(&pStats->minLatencyLo, latency);
+    }
+
+    if (latency > Utils_latencyGet64(&pStats->maxLatencyLo))
+    {
+        Utils_latencySet64(&pStats->maxLatencyLo, latency);
+    }
+
+    Utils_latencySet64(&pStats->accumulatedLatencyLo,
+                       Utils_latencyGet64(&pStats->accumulatedLatencyLo)
+                            + latency);
+
+    Utils_latencySet64(&pStats->countLo,
+                       Utils_latencyGet64(&pStats->countLo) + 1U);
+#else
+    time64 = pStats->minLatencyLo & 0xFFFFFFFFU;
+    temp = pStats->minLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    if (time64 > latency)
+    {
+        pStats->minLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
+        pStats->minLatencyLo = (latency) & 0xFFFFFFFFU;
+    }
+
+    time64 = pStats->maxLatencyLo & 0xFFFFFFFFU;
+    temp = pStats->maxLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    if (latency > time64)
+    {
+        pStats->maxLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
+        pStats->maxLatencyLo = (latency) & 0xFFFFFFFFU;
+    }
+
+    time64 = pStats->accumulatedLatencyLo & 0xFFFFFFFFU;
+    temp = pStats->accumulatedLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    time64 += latency;
+    pStats->accumulatedLatencyHi = (time64 >> 32) & 0xFFFFFFFFU;
+    pStats->accumulatedLatencyLo = (time64) & 0xFFFFFFFFU;
+
+    time64 = pStats->countLo & 0xFFFFFFFFU;
+    temp = pStats->countHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    time64 ++;
+    pStats->countHi = (time64 >> 32) & 0xFFFFFFFFU;
+    pStats->countLo = (time64) & 0xFFFFFFFFU;
+#endif
+
+    UTILS_LATENCY_WR_BARRIER();
+    pStats->seqCount = seqCount + 2U;
+}
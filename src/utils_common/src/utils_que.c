@@ -21,6 +21,14 @@
  *        exclusion protection via interuupt locks. The API optionally support
  *        blocking 'get' and 'put' APIs
  *
+ *        With UTILS_QUE_FLAG_SPSC interrupt locks are not used. Producer
+ *        only updates write index, consumer only updates read index and
+ *        the element is written before the write index is published.
+ *        Indices run from 0 to 2*maxElements-1 so that a full queue can be
+ *        told apart from an empty queue without a shared count. All shared
+ *        fields are accessed as volatile, which keeps their order on the
+ *        local core, queue is not meant to be shared across cores.
+ *
  * \version 0.0 (Jun 2013) : [SS] First version
  * \version 0.1 (Jul 2013) : [SS] Updates as per code review comments
  *
@@ -76,6 +84,11 @@ Int32 Utils_queCreate(Utils_QueHandle * handle,
 
     handle->queue = queueMem;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        UTILS_assert(maxElements > 0);
+    }
+
     if (handle->flags & UTILS_QUE_FLAG_BLOCK_QUE_GET)
     {
         /*
@@ -154,6 +167,247 @@ Int32 Utils_queDelete(Utils_QueHandle * handle)
     return SYSTEM_LINK_STATUS_SOK;
 }
 
+/**
+ *******************************************************************************
+ *
+ * \brief Advance a SPSC queue index
+ *
+ * \param handle   [IN] Queue Handle
+ * \param idx      [IN] Read or write index
+ *
+ * \return Next index
+ *
+ *******************************************************************************
+ */
+static inline UInt32 Utils_queSpscNextIdx(const Utils_QueHandle * handle,
+                                          UInt32 idx)
+{
+    idx++;
+    if (idx >= 2U*handle->maxElements)
+    {
+        idx = 0;
+    }
+    return idx;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Element position of a SPSC queue index
+ *
+ * \param handle   [IN] Queue Handle
+ * \param idx      [IN] Read or write index
+ *
+ * \return Position in queue element data area
+ *
+ *******************************************************************************
+ */
+static inline UInt32 Utils_queSpscElemIdx(const Utils_QueHandle * handle,
+                                          UInt32 idx)
+{
+    if (idx >= handle->maxElements)
+    {
+        idx -= handle->maxElements;
+    }
+    return idx;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Number of elements in a SPSC queue
+ *
+ *        Value is exact for producer and consumer, for any other caller
+ *        it may be old by the time it is used
+ *
+ * \param handle   [IN] Queue Handle
+ *
+ * \return Number of elements in queue
+ *
+ *******************************************************************************
+ */
+static inline UInt32 Utils_queSpscCount(const Utils_QueHandle * handle)
+{
+    UInt32 curWr, curRd;
+
+    curWr = *(volatile const UInt32 *)&handle->curWr;
+    curRd = *(volatile const UInt32 *)&handle->curRd;
+
+    if (curWr >= curRd)
+    {
+        return curWr - curRd;
+    }
+
+    return curWr + 2U*handle->maxElements - curRd;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Add a element into a SPSC queue, see Utils_quePut()
+ *
+ *        Called by producer only. Semaphore is posted only if consumer
+ *        is blocked on get.
+ *
+ * \param handle   [IN] Queue Handle
+ * \param data     [IN] data element to insert
+ * \param timeout  [IN] see Utils_quePut()
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_queSpscPut(Utils_QueHandle * handle, Ptr data,
+                              Int32 timeout)
+{
+    Int32 status = SYSTEM_LINK_STATUS_EFAIL;
+    UInt32 curWr;
+
+    do
+    {
+        if (Utils_queSpscCount(handle) < handle->maxElements)
+        {
+            curWr = handle->curWr;
+
+            /*
+             * write element, then publish it to consumer
+             */
+            ((volatile Ptr *)handle->queue)[Utils_queSpscElemIdx(handle, curWr)]
+                = data;
+
+            *(volatile UInt32 *)&handle->curWr =
+                Utils_queSpscNextIdx(handle, curWr);
+
+            status = SYSTEM_LINK_STATUS_SOK;
+
+            if ((handle->flags & UTILS_QUE_FLAG_BLOCK_QUE_GET)
+                &&
+                handle->blockedOnGet)
+            {
+                BspOsal_semPost(handle->semRd);
+            }
+            break;
+        }
+
+        if ((timeout == BSP_OSAL_NO_WAIT)
+            ||
+            ((handle->flags & UTILS_QUE_FLAG_BLOCK_QUE_PUT) == 0))
+        {
+            break;
+        }
+
+        handle->blockedOnPut = TRUE;
+
+        /*
+         * consumer posts only after it sees blockedOnPut, so check again
+         * for a get which happened before blockedOnPut was set
+         */
+        if (Utils_queSpscCount(handle) < handle->maxElements)
+        {
+            handle->blockedOnPut = FALSE;
+        }
+        else
+        {
+            Bool semPendStatus;
+
+            semPendStatus = BspOsal_semWait(handle->semWr, timeout);
+            handle->blockedOnPut = FALSE;
+            if (!semPendStatus || handle->forceUnblockPut)
+            {
+                handle->forceUnblockPut = FALSE;
+                break;
+            }
+        }
+    }
+    while (1);
+
+    return status;
+}
+
+/**
+ *******************************************************************************
+ *
+ * \brief Get a element from a SPSC queue, see Utils_queGet()
+ *
+ *        Called by consumer only. Semaphore is posted only if producer
+ *        is blocked on put.
+ *
+ * \param handle   [IN]  Queue Handle
+ * \param data     [OUT] Extracted data element from the queue
+ * \param minCount [IN]  see Utils_queGet(), already adjusted by caller
+ * \param timeout  [IN]  see Utils_queGet()
+ *
+ * \return SYSTEM_LINK_STATUS_SOK on success, else failure
+ *
+ *******************************************************************************
+ */
+static Int32 Utils_queSpscGet(Utils_QueHandle * handle, Ptr * data,
+                              UInt32 minCount, Int32 timeout)
+{
+    Int32 status = SYSTEM_LINK_STATUS_EFAIL;
+    UInt32 curRd;
+
+    do
+    {
+        if (Utils_queSpscCount(handle) >= minCount)
+        {
+            curRd = handle->curRd;
+
+            /*
+             * read element, then release its slot to producer
+             */
+            *data = ((volatile Ptr *)handle->queue)
+                        [Utils_queSpscElemIdx(handle, curRd)];
+
+            *(volatile UInt32 *)&handle->curRd =
+                Utils_queSpscNextIdx(handle, curRd);
+
+            status = SYSTEM_LINK_STATUS_SOK;
+
+            if ((handle->flags & UTILS_QUE_FLAG_BLOCK_QUE_PUT)
+                &&
+                handle->blockedOnPut)
+            {
+                BspOsal_semPost(handle->semWr);
+            }
+            break;
+        }
+
+        if ((timeout == BSP_OSAL_NO_WAIT)
+            ||
+            ((handle->flags & UTILS_QUE_FLAG_BLOCK_QUE_GET) == 0))
+        {
+            break;
+        }
+
+        handle->blockedOnGet = TRUE;
+
+        /*
+         * producer posts only after it sees blockedOnGet, so check again
+         * for a put which happened before blockedOnGet was set
+         */
+        if (Utils_queSpscCount(handle) >= minCount)
+        {
+            handle->blockedOnGet = FALSE;
+        }
+        else
+        {
+            Bool semPendStatus;
+
+            semPendStatus = BspOsal_semWait(handle->semRd, timeout);
+            handle->blockedOnGet = FALSE;
+            if (!semPendStatus || (handle->forceUnblockGet == TRUE))
+            {
+                handle->forceUnblockGet = FALSE;
+                break;
+            }
+        }
+    }
+    while (1);
+
+    return status;
+}
+
 /**
  *******************************************************************************
  *
@@ -179,6 +433,11 @@ Int32 Utils_quePut(Utils_QueHandle * handle, Ptr data, Int32 timeout)
     Int32 status = SYSTEM_LINK_STATUS_EFAIL;/* init status to error */
     UInt32 cookie;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        return Utils_queSpscPut(handle, data, timeout);
+    }
+
     do
     {
         /*
@@ -332,6 +591,11 @@ Int32 Utils_queGet(Utils_QueHandle * handle, Ptr * data,
     if (minCount > handle->maxElements)
         minCount = handle->maxElements;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        return Utils_queSpscGet(handle, data, minCount, timeout);
+    }
+
     do
     {
         /*
@@ -468,6 +732,11 @@ UInt32 Utils_queIsEmpty(Utils_QueHandle * handle)
     UInt32 isEmpty;
     UInt32 cookie;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        return (Utils_queSpscCount(handle) == 0) ? TRUE : FALSE;
+    }
+
     /*
      * disable interrupts
      */
@@ -508,6 +777,17 @@ Int32 Utils_quePeek(Utils_QueHandle * handle, Ptr * data)
 
     *data = NULL;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        if (Utils_queSpscCount(handle))
+        {
+            *data = ((volatile Ptr *)handle->queue)
+                        [Utils_queSpscElemIdx(handle, handle->curRd)];
+            status = SYSTEM_LINK_STATUS_SOK;
+        }
+        return status;
+    }
+
     /*
      * disable interrupts
      */
@@ -554,6 +834,11 @@ UInt32 Utils_queGetQueuedCount(Utils_QueHandle * handle)
     UInt32 count;
     UInt32 cookie;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        return Utils_queSpscCount(handle);
+    }
+
     /*
      * disable interrupts
      */
@@ -628,6 +913,12 @@ UInt32 Utils_queIsFull(Utils_QueHandle * handle)
     UInt32 isFull;
     UInt32 cookie;
 
+    if (handle->flags & UTILS_QUE_FLAG_SPSC)
+    {
+        return (Utils_queSpscCount(handle) < handle->maxElements)
+                    ? FALSE : TRUE;
+    }
+
     /*
      * disable interrupts
      */
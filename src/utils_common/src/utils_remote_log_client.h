@@ -119,6 +119,8 @@ typedef struct {
 
     char lineBuf[REMOTE_LOG_LINE_BUF_SIZE];
     /**< Temporary buffer for print on uart from shared buffer */
+    UInt32 binOverflowCount[SYSTEM_PROC_MAX];
+    /**< Binary log overflow count already reported for each core */
     RemoteLog_PeriodicObj prd;
     /**< Remote log client periodic object */
     BspOsal_SemHandle lock;
@@ -75,6 +75,15 @@ extern "C" {
  */
 #define NETWORK_CTRL_FLAG_ACK            (0x00000001)
 
+/*******************************************************************************
+ *  \brief Flag that is set in the 'flags' field of a command to ask the
+ *         target to keep the connection open for further commands. Target
+ *         sets the same flag in the ACK when it does so, else it closes the
+ *         connection after the ACK
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_FLAG_KEEP_CONNECTION   (0x00000002)
+
 
 
 /*******************************************************************************
@@ -103,6 +112,77 @@ typedef struct {
 
 } NetworkCtrl_CmdHeader;
 
+/**
+ *******************************************************************************
+ *
+ * \brief Chunked transfer of large memory dumps and files
+ *
+ *        Commands with the "_chunk" suffix move one chunk of a larger
+ *        transfer per command, so that neither side needs a buffer for
+ *        the complete transfer and an interrupted transfer can be resumed.
+ *
+ *        Download (target to PC, e.g "mem_save_chunk"): parameters are a
+ *        NetworkCtrl_ChunkHeader with 'offset' and 'size' of the requested
+ *        chunk. Response parameters are a NetworkCtrl_ChunkHeader followed
+ *        by 'size' bytes of data.
+ *
+ *        Upload (PC to target, e.g "qspi_wr_chunk"): parameters are a
+ *        NetworkCtrl_ChunkHeader followed by 'size' bytes of data. Response
+ *        parameters are a NetworkCtrl_ChunkHeader with 'offset' set to the
+ *        offset target expects next. A chunk at offset 0 starts a new
+ *        transfer, any other chunk must start at the offset target expects,
+ *        else it is rejected with a non-zero return value.
+ *
+ *        Targets which do not support a "_chunk" command return
+ *        (unsigned int)-1 with no parameters, the PC then falls back to
+ *        the single command transfer.
+ *
+ *******************************************************************************
+ */
+
+/*******************************************************************************
+ *  \brief Max bytes of data in one chunk
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_CHUNK_SIZE_MAX         (4*1024*1024)
+
+/*******************************************************************************
+ *  \brief 'crc' field is valid. In a download request this asks target to
+ *         compute CRC of the chunk, in an upload it asks target to check it
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_CHUNK_FLAG_CRC         (0x00000001)
+
+/*******************************************************************************
+ *  \brief Upload chunk with no data, target only returns the offset it
+ *         expects next if 'addr' and 'totalSize' match the transfer in
+ *         progress, else 0. Used to resume an interrupted upload.
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_CHUNK_FLAG_QUERY       (0x00000002)
+
+typedef struct {
+
+    unsigned int addr;
+    /**< Command specific address, e.g memory address or QSPI offset */
+
+    unsigned int totalSize;
+    /**< Size of the complete transfer in bytes */
+
+    unsigned int offset;
+    /**< Offset of this chunk within the transfer */
+
+    unsigned int size;
+    /**< Bytes of data in this chunk */
+
+    unsigned int crc;
+    /**< CRC-32 (IEEE 802.3) of data in this chunk */
+
+    unsigned int flags;
+    /**< NETWORK_CTRL_CHUNK_FLAG_* */
+
+} NetworkCtrl_ChunkHeader;
+
 /**
  *******************************************************************************
  *
@@ -114,6 +194,7 @@ typedef struct {
 #define NETWORK_RX_TYPE_BITSTREAM_MJPEG              (0x2)
 #define NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV     (0x8)
 #define NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV      (0x9)
+#define NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED       (0x10)
 
 
 typedef struct {
@@ -141,6 +222,272 @@ typedef struct {
 
 } NetworkRx_CmdHeader;
 
+/**
+ *******************************************************************************
+ *
+ * \brief Lossless compressed video frame
+ *
+ *        Payload of NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED is a
+ *        NetworkCodec_Header followed by the compressed planes. Width,
+ *        height and pitch in NetworkRx_CmdHeader are of the decoded frame,
+ *        dataSize is the compressed size.
+ *
+ *        Every plane, only 'width' bytes of each line, is coded line by
+ *        line. A byte is predicted from its left, top and top-left
+ *        neighbours of the same component (LOCO-I median predictor), the
+ *        residual is zig-zag mapped and residuals are bit packed in blocks
+ *        of NETWORK_CODEC_BLOCK_SIZE. A block is one byte with the bit
+ *        width of its largest residual followed by
+ *        NETWORK_CODEC_BLOCK_SIZE*width/8 bytes, LSB first.
+ *
+ *        A sender which receives a request for YUV420SP or YUV422I may
+ *        reply with a compressed frame of that format only when it knows
+ *        that the receiver supports it.
+ *
+ *******************************************************************************
+ */
+#define NETWORK_CODEC_MAGIC         (0x434C5A31)
+#define NETWORK_CODEC_BLOCK_SIZE    (32)
+#define NETWORK_CODEC_MAX_PLANES    (2)
+
+typedef struct {
+
+    unsigned int magic;
+    /**< NETWORK_CODEC_MAGIC */
+
+    unsigned int payloadType;
+    /**< Format of the decoded frame, NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV
+     *   or NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV */
+
+    unsigned int width;
+
+    unsigned int height;
+
+    unsigned int planeSize[NETWORK_CODEC_MAX_PLANES];
+    /**< Compressed size of each plane in bytes, 0 for unused plane */
+
+} NetworkCodec_Header;
+
+/**
+ *******************************************************************************
+ *
+ * \brief Binary link statistics snapshot
+ *
+ *        Returned by the "link_stats" command. A snapshot is a
+ *        NetworkCtrl_LinkStatsHeader followed by numCores core records,
+ *        numTasks task records, numHeaps heap records and numLinks link
+ *        records. Each link record is followed by numCh channel records.
+ *
+ *        All counters are cumulative since the last link statistics reset,
+ *        the host computes rates from the elapsed time or from the delta
+ *        between two snapshots. 64-bit values are split into Hi/Lo words
+ *        so that the layout is identical on the target and the PC.
+ *
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_MAGIC           (0x4C535453)
+#define NETWORK_CTRL_LINK_STATS_VERSION         (0x00020000)
+
+/*******************************************************************************
+ *  \brief Max length of link, task and heap names in the snapshot
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_NAME_MAX        (32)
+
+/*******************************************************************************
+ *  \brief Max output queues per channel, same as SYSTEM_MAX_OUT_QUE
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE     (6)
+
+/*******************************************************************************
+ *  \brief Flag set in NetworkCtrl_LinkStatsCore.flags when the core load
+ *         was refreshed for this snapshot. If not set the load values are
+ *         the ones from the previous refresh.
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID   (0x00000001)
+
+/*******************************************************************************
+ *  \brief Phases in NetworkCtrl_LinkStatsLink.phase[], same order as
+ *         UTILS_LINK_PHASE_* on target
+ *******************************************************************************
+ */
+#define NETWORK_CTRL_LINK_STATS_PHASE_GET_BUF   (0)
+#define NETWORK_CTRL_LINK_STATS_PHASE_PUT_BUF   (1)
+#define NETWORK_CTRL_LINK_STATS_PHASE_CACHE     (2)
+#define NETWORK_CTRL_LINK_STATS_PHASE_PROCESS   (3)
+#define NETWORK_CTRL_LINK_STATS_PHASE_SEND      (4)
+#define NETWORK_CTRL_LINK_STATS_PHASE_MAX       (5)
+
+typedef struct {
+
+    unsigned int magic;
+    /**< NETWORK_CTRL_LINK_STATS_MAGIC */
+
+    unsigned int version;
+    /**< NETWORK_CTRL_LINK_STATS_VERSION */
+
+    unsigned int totalSize;
+    /**< Size of the snapshot in bytes including this header */
+
+    unsigned int timeInMsec;
+    /**< Global time on target when the snapshot was taken */
+
+    unsigned int numCores;
+    /**< Number of NetworkCtrl_LinkStatsCore records */
+
+    unsigned int numTasks;
+    /**< Number of NetworkCtrl_LinkStatsTask records */
+
+    unsigned int numHeaps;
+    /**< Number of NetworkCtrl_LinkStatsHeap records */
+
+    unsigned int numLinks;
+    /**< Number of NetworkCtrl_LinkStatsLink records */
+
+} NetworkCtrl_LinkStatsHeader;
+
+typedef struct {
+
+    unsigned int procId;
+    /**< SYSTEM_PROC_xxx */
+
+    unsigned int flags;
+    /**< NETWORK_CTRL_LINK_STATS_CORE_FLAG_* */
+
+    unsigned int totalTimeHi;
+    unsigned int totalTimeLo;
+    /**< Total time over which load is accumulated */
+
+    unsigned int idleTimeHi;
+    unsigned int idleTimeLo;
+    /**< Time spent in idle task */
+
+    unsigned int hwiTimeHi;
+    unsigned int hwiTimeLo;
+    /**< Time spent in Hwi */
+
+    unsigned int swiTimeHi;
+    unsigned int swiTimeLo;
+    /**< Time spent in Swi */
+
+    unsigned int maxSemaphoreObjs;
+    unsigned int freeSemaphoreObjs;
+    unsigned int maxTaskObjs;
+    unsigned int freeTaskObjs;
+    unsigned int maxClockObjs;
+    unsigned int freeClockObjs;
+    unsigned int maxHwiObjs;
+    unsigned int freeHwiObjs;
+    /**< OS object usage */
+
+} NetworkCtrl_LinkStatsCore;
+
+typedef struct {
+
+    unsigned int procId;
+    /**< Core on which the task runs */
+
+    char name[NETWORK_CTRL_LINK_STATS_NAME_MAX];
+    /**< Task name */
+
+    unsigned int totalTimeHi;
+    unsigned int totalTimeLo;
+    /**< Time spent in this task, same time base as core totalTime */
+
+} NetworkCtrl_LinkStatsTask;
+
+typedef struct {
+
+    unsigned int procId;
+    /**< Core which reported the heap */
+
+    unsigned int heapId;
+    /**< Utils heap ID */
+
+    char name[NETWORK_CTRL_LINK_STATS_NAME_MAX];
+    /**< Heap name */
+
+    unsigned int heapAddr;
+    unsigned int heapSize;
+    unsigned int freeSize;
+
+} NetworkCtrl_LinkStatsHeap;
+
+typedef struct {
+
+    unsigned int count;
+    /**< Number of latency samples */
+
+    unsigned int accHi;
+    unsigned int accLo;
+    /**< Accumulated latency in usecs */
+
+    unsigned int min;
+    unsigned int max;
+    /**< Min and max latency in usecs */
+
+} NetworkCtrl_LinkStatsLatency;
+
+typedef struct {
+
+    unsigned int count;
+    /**< Number of times the phase was entered */
+
+    unsigned int timeHi;
+    unsigned int timeLo;
+    /**< CPU time in the phase, same time base as core totalTime */
+
+} NetworkCtrl_LinkStatsPhase;
+
+typedef struct {
+
+    unsigned int linkId;
+    /**< Link ID including the processor ID */
+
+    char name[NETWORK_CTRL_LINK_STATS_NAME_MAX];
+    /**< Link name */
+
+    unsigned int elapsedTimeInMsec;
+    /**< Time since link statistics were last reset */
+
+    unsigned int numCh;
+    /**< Number of NetworkCtrl_LinkStatsCh records following this record */
+
+    unsigned int inBufErrorCount;
+    unsigned int outBufErrorCount;
+    unsigned int newDataCmdCount;
+    unsigned int releaseDataCmdCount;
+    unsigned int getFullBufCount;
+    unsigned int putEmptyBufCount;
+    unsigned int notifyEventCount;
+
+    NetworkCtrl_LinkStatsLatency linkLatency;
+    /**< Latency within the link */
+
+    NetworkCtrl_LinkStatsLatency srcToLinkLatency;
+    /**< Latency from source to this link */
+
+    NetworkCtrl_LinkStatsPhase phase[NETWORK_CTRL_LINK_STATS_PHASE_MAX];
+    /**< CPU time per phase, all 0 for links which do not account phases */
+
+} NetworkCtrl_LinkStatsLink;
+
+typedef struct {
+
+    unsigned int inBufRecvCount;
+    unsigned int inBufDropCount;
+    unsigned int inBufUserDropCount;
+    unsigned int inBufProcessCount;
+
+    unsigned int numOut;
+    unsigned int outBufCount[NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE];
+    unsigned int outBufDropCount[NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE];
+    unsigned int outBufUserDropCount[NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE];
+
+} NetworkCtrl_LinkStatsCh;
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -4,9 +4,28 @@
 
 #include <osa.h>
 #include <unistd.h>
-#include <winsock.h>
 #include <strings.h>
 
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <signal.h>
+
+typedef int SOCKET;
+
+#define INVALID_SOCKET  (-1)
+#endif
+
+/* Max buffers in one Network_writev() call */
+#define NETWORK_MAX_WRITEV_BUF  (8)
+
 typedef struct {
 
     SOCKET clientSocketId;
@@ -21,9 +40,14 @@ typedef struct {
  */
 
 int Network_connect(Network_SockObj *pObj, char *ipAddr, UInt32 port);
+int Network_listen(Network_SockObj *pObj, UInt32 port);
+int Network_accept(Network_SockObj *pListenObj, Network_SockObj *pObj);
 int Network_close(Network_SockObj *pObj);
 int Network_read(Network_SockObj *pObj, UInt8 *dataBuf, UInt32 *dataSize);
 int Network_write(Network_SockObj *pObj, UInt8 *dataBuf, UInt32 dataSize);
+int Network_writev(Network_SockObj *pObj, UInt8 *dataBuf[], UInt32 dataSize[], UInt32 numBuf);
+int Network_setRecvBufSize(Network_SockObj *pObj, UInt32 bufSize);
+int Network_setNoDelay(Network_SockObj *pObj);
 
 int Network_init();
 int Network_deInit();
@@ -0,0 +1,39 @@
+
+#ifndef _NETWORK_CODEC_H_
+#define _NETWORK_CODEC_H_
+
+#include <osa.h>
+#include <networkCtrl_if.h>
+
+/* Lossless codec of NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED payload, same as
+ * src/utils_common/src/network_codec.c on target
+ */
+
+/* After NETWORK_CODEC_BACKOFF_RAW_FRAMES consecutive frames of a channel
+ * were not made smaller, the next NETWORK_CODEC_BACKOFF_SKIP_FRAMES frames
+ * are sent without trying to encode
+ */
+#define NETWORK_CODEC_BACKOFF_RAW_FRAMES    (4U)
+#define NETWORK_CODEC_BACKOFF_SKIP_FRAMES   (60U)
+
+typedef struct {
+
+    UInt32 rawCount;
+    /**< Consecutive frames which were not made smaller */
+
+    UInt32 skipCount;
+    /**< Frames still to be sent without trying to encode */
+
+} NetworkCodec_Backoff;
+
+UInt32 NetworkCodec_getMaxSize(UInt32 payloadType, UInt32 width, UInt32 height);
+int NetworkCodec_encode(UInt32 payloadType, UInt32 width, UInt32 height,
+                        UInt8 *srcAddr[], UInt32 srcPitch[],
+                        UInt8 *pDst, UInt32 dstSize, UInt32 *pEncSize);
+int NetworkCodec_decode(UInt8 *pSrc, UInt32 srcSize,
+                        UInt32 payloadType, UInt32 width, UInt32 height,
+                        UInt8 *dstAddr[], UInt32 dstPitch[]);
+Bool NetworkCodec_backoffIsSkip(NetworkCodec_Backoff *pBackoff);
+void NetworkCodec_backoffUpdate(NetworkCodec_Backoff *pBackoff, Bool isSmaller);
+
+#endif
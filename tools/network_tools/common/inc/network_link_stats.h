@@ -0,0 +1,66 @@
+
+#ifndef _NETWORK_LINK_STATS_H_
+#define _NETWORK_LINK_STATS_H_
+
+#include <osa.h>
+#include <networkCtrl_if.h>
+
+/*******************************************************************************
+ *  Defines
+ *******************************************************************************
+ */
+
+/* Max link records in one snapshot, same as LINK_STATS_MAX_STATS_INST on target */
+#define NETWORK_LINK_STATS_MAX_LINKS     (130)
+
+/* Max channel records per link, same as SYSTEM_MAX_CH_PER_OUT_QUE on target */
+#define NETWORK_LINK_STATS_MAX_CH        (8)
+
+#define NETWORK_LINK_STATS_FORMAT_CSV    (0)
+#define NETWORK_LINK_STATS_FORMAT_PROM   (1)
+
+/*******************************************************************************
+ *  Data structure's
+ *******************************************************************************
+ */
+
+/* Parsed view of a snapshot, all pointers point into the snapshot buffer */
+typedef struct {
+
+    NetworkCtrl_LinkStatsHeader *pHeader;
+
+    NetworkCtrl_LinkStatsCore   *pCore;
+    /* numCores records */
+
+    NetworkCtrl_LinkStatsTask   *pTask;
+    /* numTasks records */
+
+    NetworkCtrl_LinkStatsHeap   *pHeap;
+    /* numHeaps records */
+
+    NetworkCtrl_LinkStatsLink   *pLink[NETWORK_LINK_STATS_MAX_LINKS];
+    /* numLinks records */
+
+    NetworkCtrl_LinkStatsCh     *pCh[NETWORK_LINK_STATS_MAX_LINKS];
+    /* pLink[i]->numCh channel records for each link */
+
+} NetworkLinkStats_Snapshot;
+
+/*******************************************************************************
+ *  Function's
+ *******************************************************************************
+ */
+
+int  NetworkLinkStats_parse(NetworkLinkStats_Snapshot *pSnap, UInt8 *pBuf, UInt32 size);
+int  NetworkLinkStats_readSnapshot(FILE *fp, UInt8 *pBuf, UInt32 bufSize);
+void NetworkLinkStats_write(FILE *fp, NetworkLinkStats_Snapshot *pSnap, int format);
+void NetworkLinkStats_writeCsvHeader(FILE *fp);
+
+char  *NetworkLinkStats_getProcName(UInt32 procId);
+char  *NetworkLinkStats_getPhaseName(UInt32 phase);
+UInt64 NetworkLinkStats_get64(UInt32 hi, UInt32 lo);
+UInt32 NetworkLinkStats_getCoreLoad(NetworkCtrl_LinkStatsCore *pCore);
+UInt32 NetworkLinkStats_getTaskLoad(NetworkLinkStats_Snapshot *pSnap, NetworkCtrl_LinkStatsTask *pTask);
+NetworkCtrl_LinkStatsCore *NetworkLinkStats_findCore(NetworkLinkStats_Snapshot *pSnap, UInt32 procId);
+
+#endif
@@ -70,10 +70,13 @@ typedef char Int8;                     ///< Signed  8-bit integer
 #include <osa_debug.h>
 
 Uint32 OSA_getCurTimeInMsec();
+Uint64 OSA_getCurTimeInUsec();
 void   OSA_waitMsecs(Uint32 msecs);
 
 int xstrtoi(char *hex);
 
+Uint32 OSA_crc32(Uint8 *pData, Uint32 size);
+
 #endif /* _OSA_H_ */
 
 
@@ -7,6 +7,22 @@
 
 int OSA_fileReadFile(char *fileName, Uint8 *addr, Uint32 readSize, Uint32 *actualReadSize);
 int OSA_fileWriteFile(char *fileName, Uint8 *addr, Uint32 size);
+int OSA_fileGetSize(char *fileName, Uint64 *size);
+
+/* Read only mapping of a complete file */
+typedef struct {
+
+  Uint8 *addr;
+  Uint64 size;
+
+  void  *hFile;
+  void  *hMap;
+  /**< OS handles, used on Windows only */
+
+} OSA_FileMapHndl;
+
+int OSA_fileMap(OSA_FileMapHndl *hndl, char *fileName);
+int OSA_fileUnmap(OSA_FileMapHndl *hndl);
 
 #endif /* _OSA_FILE_H_ */
 
@@ -0,0 +1,36 @@
+
+
+#ifndef _OSA_QUE_H_
+#define _OSA_QUE_H_
+
+#include <osa.h>
+#include <pthread.h>
+
+/* Bounded queue of pointers, safe to use from multiple threads.
+ * Timeout can be OSA_TIMEOUT_NONE or OSA_TIMEOUT_FOREVER only.
+ */
+typedef struct {
+
+  Uint32 curRd;
+  Uint32 curWr;
+  Uint32 len;
+  Uint32 count;
+
+  void **queue;
+
+  pthread_mutex_t lock;
+  pthread_cond_t  condRd;
+  pthread_cond_t  condWr;
+
+} OSA_QueHndl;
+
+int OSA_queCreate(OSA_QueHndl *hndl, Uint32 maxLen);
+int OSA_queDelete(OSA_QueHndl *hndl);
+int OSA_quePut(OSA_QueHndl *hndl, void *value, Uint32 timeout);
+int OSA_queGet(OSA_QueHndl *hndl, void **value, Uint32 timeout);
+Uint32 OSA_queGetQueuedCount(OSA_QueHndl *hndl);
+
+#endif /* _OSA_QUE_H_ */
+
+
+
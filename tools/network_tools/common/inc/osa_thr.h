@@ -0,0 +1,23 @@
+
+
+#ifndef _OSA_THR_H_
+#define _OSA_THR_H_
+
+#include <osa.h>
+#include <pthread.h>
+
+typedef void * (*OSA_ThrEntryFunc)(void *);
+
+typedef struct {
+
+  pthread_t hndl;
+
+} OSA_ThrHndl;
+
+int OSA_thrCreate(OSA_ThrHndl *hndl, OSA_ThrEntryFunc entryFunc, void *prm);
+int OSA_thrJoin(OSA_ThrHndl *hndl);
+
+#endif /* _OSA_THR_H_ */
+
+
+
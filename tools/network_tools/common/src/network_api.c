@@ -3,21 +3,28 @@
 
 int Network_init()
 {
+#ifdef _WIN32
     WORD         wVersionRequested;
     WSADATA      wsaData;
 
-    wVersionRequested = MAKEWORD(1, 1);
+    wVersionRequested = MAKEWORD(2, 2);
     if (WSAStartup(wVersionRequested, &wsaData)) {
         printf("# ERROR: Unable to initialize WinSock for host info");
         exit(EXIT_FAILURE);
     }
+#else
+    /* send() to a closed connection should return error, not kill the tool */
+    signal(SIGPIPE, SIG_IGN);
+#endif
 
     return 0;
 }
 
 int Network_deInit()
 {
+#ifdef _WIN32
     WSACleanup();
+#endif
 
     return 0;
 }
@@ -58,6 +65,64 @@ int Network_connect(Network_SockObj *pObj, char *ipAddr, UInt32 port)
   return OSA_SOK;
 }
 
+/* Server side, used by tools which emulate the target */
+int Network_listen(Network_SockObj *pObj, UInt32 port)
+{
+  struct sockaddr_in server;
+  int option = 1;
+
+  strcpy(pObj->ipAddr, "0.0.0.0");
+
+  pObj->serverPort = port;
+
+  pObj->clientSocketId = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (pObj->clientSocketId == INVALID_SOCKET ) {
+    printf("# ERROR: NETWORK: Socket open failed (port=%d)!!!\n", pObj->serverPort);
+    return OSA_EFAIL;
+  }
+
+  setsockopt(pObj->clientSocketId, SOL_SOCKET, SO_REUSEADDR,
+        (const char*)&option, sizeof(option));
+
+  memset(&server, 0, sizeof(server));
+  server.sin_family = AF_INET;
+  server.sin_port = htons(port);
+  server.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if (bind(pObj->clientSocketId, (struct sockaddr *)&server, sizeof(server)) == -1
+        ||
+      listen(pObj->clientSocketId, 5) == -1)
+  {
+    printf("# ERROR: NETWORK: Unable to listen (port=%d)!!!\n", pObj->serverPort);
+    Network_close(pObj);
+    return OSA_EFAIL;
+  }
+
+  return OSA_SOK;
+}
+
+/* Blocks till a client connects, pObj is then used to talk to the client */
+int Network_accept(Network_SockObj *pListenObj, Network_SockObj *pObj)
+{
+  struct sockaddr_in client;
+  socklen_t sin_size;
+
+  sin_size = sizeof(client);
+
+  pObj->clientSocketId = accept(pListenObj->clientSocketId, (struct sockaddr *)&client, &sin_size);
+  if (pObj->clientSocketId == INVALID_SOCKET ) {
+    printf("# ERROR: NETWORK: accept() failed (port=%d)!!!\n", pListenObj->serverPort);
+    return OSA_EFAIL;
+  }
+
+  strcpy(pObj->ipAddr, inet_ntoa(client.sin_addr));
+  pObj->serverPort = pListenObj->serverPort;
+
+  OSA_printf("# NETWORK: Client connected (%s:%d)!!!\n", pObj->ipAddr, pObj->serverPort);
+
+  return OSA_SOK;
+}
+
 int Network_close(Network_SockObj *pObj)
 {
   int ret;
@@ -112,3 +177,119 @@ int Network_write(Network_SockObj *pObj, UInt8 *dataBuf, UInt32 dataSize)
     return 0;
 }
 
+/* Single gather send, returns bytes sent or -1 on error */
+static int Network_sendv(Network_SockObj *pObj, UInt8 *dataBuf[], UInt32 dataSize[], UInt32 numBuf)
+{
+    UInt32 i;
+#ifdef _WIN32
+    WSABUF iov[NETWORK_MAX_WRITEV_BUF];
+    DWORD actDataSize;
+
+    for(i=0; i<numBuf; i++)
+    {
+        iov[i].buf = (char*)dataBuf[i];
+        iov[i].len = dataSize[i];
+    }
+
+    if(WSASend(pObj->clientSocketId, iov, numBuf, &actDataSize, 0, NULL, NULL)!=0)
+        return -1;
+
+    return (int)actDataSize;
+#else
+    struct iovec iov[NETWORK_MAX_WRITEV_BUF];
+
+    for(i=0; i<numBuf; i++)
+    {
+        iov[i].iov_base = dataBuf[i];
+        iov[i].iov_len  = dataSize[i];
+    }
+
+    return (int)writev(pObj->clientSocketId, iov, numBuf);
+#endif
+}
+
+/* Write multiple buffers, e.g header and payload, with a single system call
+ * so that they go out back to back without copying them into one buffer
+ */
+int Network_writev(Network_SockObj *pObj, UInt8 *dataBuf[], UInt32 dataSize[], UInt32 numBuf)
+{
+    UInt8 *curBuf[NETWORK_MAX_WRITEV_BUF];
+    UInt32 curSize[NETWORK_MAX_WRITEV_BUF];
+    UInt32 i, bufId;
+    int actDataSize;
+
+    if(numBuf > NETWORK_MAX_WRITEV_BUF)
+        return -1;
+
+    for(i=0; i<numBuf; i++)
+    {
+        curBuf[i]  = dataBuf[i];
+        curSize[i] = dataSize[i];
+    }
+
+    bufId = 0;
+    while(1)
+    {
+        while(bufId < numBuf && curSize[bufId]==0)
+            bufId++;
+
+        if(bufId >= numBuf)
+            break;
+
+        actDataSize = Network_sendv(pObj, &curBuf[bufId], &curSize[bufId], numBuf-bufId);
+        if(actDataSize<=0)
+            return -1;
+
+        /* partial send, continue from where it stopped */
+        for(i=bufId; i<numBuf && actDataSize>0; i++)
+        {
+            if((UInt32)actDataSize >= curSize[i])
+            {
+                actDataSize -= curSize[i];
+                curSize[i] = 0;
+            }
+            else
+            {
+                curBuf[i]  += actDataSize;
+                curSize[i] -= actDataSize;
+                actDataSize = 0;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int Network_setRecvBufSize(Network_SockObj *pObj, UInt32 bufSize)
+{
+    int ret;
+
+    ret = setsockopt(pObj->clientSocketId, SOL_SOCKET, SO_RCVBUF,
+                (const char*)&bufSize, sizeof(bufSize));
+    if(ret!=0)
+    {
+        printf("# WARNING: NETWORK: Unable to set receive buffer size to %d bytes\n", bufSize);
+        return OSA_EFAIL;
+    }
+
+    return OSA_SOK;
+}
+
+/* Disable Nagle, use only when every message is sent with one write call,
+ * else small messages go out as separate packets
+ */
+int Network_setNoDelay(Network_SockObj *pObj)
+{
+    int ret;
+    int noDelay = 1;
+
+    ret = setsockopt(pObj->clientSocketId, IPPROTO_TCP, TCP_NODELAY,
+                (const char*)&noDelay, sizeof(noDelay));
+    if(ret!=0)
+    {
+        printf("# WARNING: NETWORK: Unable to disable Nagle algorithm\n");
+        return OSA_EFAIL;
+    }
+
+    return OSA_SOK;
+}
@@ -0,0 +1,364 @@
+
+#include <network_link_stats.h>
+
+/* Same as SYSTEM_GET_PROC_ID() on target */
+#define NETWORK_LINK_STATS_GET_PROC_ID(linkId)  (((linkId) >> 8) & 0xF)
+
+static char *gNetworkLinkStats_procName[] =
+{
+    "IPU1_0", "IPU1_1", "A15_0", "DSP1", "DSP2", "EVE1", "EVE2", "EVE3", "EVE4"
+};
+
+/* Same order as NETWORK_CTRL_LINK_STATS_PHASE_* */
+static char *gNetworkLinkStats_phaseName[NETWORK_CTRL_LINK_STATS_PHASE_MAX] =
+{
+    "get_buf", "put_buf", "cache", "process", "send"
+};
+
+typedef struct {
+
+    FILE  *fp;
+    int    format;
+    UInt32 timeInMsec;
+
+} NetworkLinkStats_Writer;
+
+char *NetworkLinkStats_getProcName(UInt32 procId)
+{
+    if(procId < sizeof(gNetworkLinkStats_procName)/sizeof(gNetworkLinkStats_procName[0]))
+        return gNetworkLinkStats_procName[procId];
+
+    return "INVALID";
+}
+
+UInt64 NetworkLinkStats_get64(UInt32 hi, UInt32 lo)
+{
+    return ((UInt64)hi << 32) | (UInt64)lo;
+}
+
+/* returns load in units of 0.1% */
+UInt32 NetworkLinkStats_getCoreLoad(NetworkCtrl_LinkStatsCore *pCore)
+{
+    UInt64 totalTime, idleTime;
+
+    totalTime = NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo);
+    idleTime  = NetworkLinkStats_get64(pCore->idleTimeHi, pCore->idleTimeLo);
+
+    if(totalTime==0 || idleTime > totalTime)
+        return 0;
+
+    return (UInt32)(1000 - (idleTime*1000)/totalTime);
+}
+
+NetworkCtrl_LinkStatsCore *NetworkLinkStats_findCore(NetworkLinkStats_Snapshot *pSnap, UInt32 procId)
+{
+    UInt32 i;
+
+    for(i=0; i<pSnap->pHeader->numCores; i++)
+    {
+        if(pSnap->pCore[i].procId == procId)
+            return &pSnap->pCore[i];
+    }
+
+    return NULL;
+}
+
+/* returns load in units of 0.1% */
+UInt32 NetworkLinkStats_getTaskLoad(NetworkLinkStats_Snapshot *pSnap, NetworkCtrl_LinkStatsTask *pTask)
+{
+    NetworkCtrl_LinkStatsCore *pCore;
+    UInt64 totalTime, tskTime;
+
+    pCore = NetworkLinkStats_findCore(pSnap, pTask->procId);
+    if(pCore==NULL)
+        return 0;
+
+    totalTime = NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo);
+    tskTime   = NetworkLinkStats_get64(pTask->totalTimeHi, pTask->totalTimeLo);
+
+    if(totalTime==0)
+        return 0;
+
+    return (UInt32)((tskTime*1000)/totalTime);
+}
+
+int NetworkLinkStats_parse(NetworkLinkStats_Snapshot *pSnap, UInt8 *pBuf, UInt32 size)
+{
+    NetworkCtrl_LinkStatsHeader *pHeader;
+    UInt8 *pCur, *pEnd;
+    UInt32 i;
+
+    memset(pSnap, 0, sizeof(*pSnap));
+
+    if(size < sizeof(NetworkCtrl_LinkStatsHeader))
+        return OSA_EFAIL;
+
+    pHeader = (NetworkCtrl_LinkStatsHeader*)pBuf;
+
+    if(pHeader->magic != NETWORK_CTRL_LINK_STATS_MAGIC)
+    {
+        printf("# ERROR: LINK STATS: Invalid snapshot magic (0x%08x)\n", pHeader->magic);
+        return OSA_EFAIL;
+    }
+
+    if((pHeader->version >> 16) != (NETWORK_CTRL_LINK_STATS_VERSION >> 16))
+    {
+        printf("# ERROR: LINK STATS: Unsupported snapshot version (0x%08x)\n", pHeader->version);
+        return OSA_EFAIL;
+    }
+
+    if(pHeader->totalSize > size
+        || pHeader->numLinks > NETWORK_LINK_STATS_MAX_LINKS)
+    {
+        printf("# ERROR: LINK STATS: Corrupted snapshot (size = %d bytes, links = %d)\n",
+            pHeader->totalSize, pHeader->numLinks);
+        return OSA_EFAIL;
+    }
+
+    pEnd = pBuf + pHeader->totalSize;
+    pCur = pBuf + sizeof(NetworkCtrl_LinkStatsHeader);
+
+    pSnap->pHeader = pHeader;
+
+    pSnap->pCore = (NetworkCtrl_LinkStatsCore*)pCur;
+    pCur += pHeader->numCores*sizeof(NetworkCtrl_LinkStatsCore);
+
+    pSnap->pTask = (NetworkCtrl_LinkStatsTask*)pCur;
+    pCur += pHeader->numTasks*sizeof(NetworkCtrl_LinkStatsTask);
+
+    pSnap->pHeap = (NetworkCtrl_LinkStatsHeap*)pCur;
+    pCur += pHeader->numHeaps*sizeof(NetworkCtrl_LinkStatsHeap);
+
+    for(i=0; i<pHeader->numLinks; i++)
+    {
+        if(pCur + sizeof(NetworkCtrl_LinkStatsLink) > pEnd)
+            break;
+
+        pSnap->pLink[i] = (NetworkCtrl_LinkStatsLink*)pCur;
+        pCur += sizeof(NetworkCtrl_LinkStatsLink);
+
+        if(pSnap->pLink[i]->numCh > NETWORK_LINK_STATS_MAX_CH)
+            break;
+
+        pSnap->pCh[i] = (NetworkCtrl_LinkStatsCh*)pCur;
+        pCur += pSnap->pLink[i]->numCh*sizeof(NetworkCtrl_LinkStatsCh);
+    }
+
+    if(i != pHeader->numLinks || pCur != pEnd)
+    {
+        printf("# ERROR: LINK STATS: Snapshot size does not match record count\n");
+        return OSA_EFAIL;
+    }
+
+    return OSA_SOK;
+}
+
+/* reads one snapshot from a file of back to back snapshots, returns size or 0 at end of file */
+int NetworkLinkStats_readSnapshot(FILE *fp, UInt8 *pBuf, UInt32 bufSize)
+{
+    NetworkCtrl_LinkStatsHeader *pHeader;
+    UInt32 size;
+
+    pHeader = (NetworkCtrl_LinkStatsHeader*)pBuf;
+
+    if(fread(pHeader, 1, sizeof(*pHeader), fp) != sizeof(*pHeader))
+        return 0;
+
+    if(pHeader->magic != NETWORK_CTRL_LINK_STATS_MAGIC
+        || pHeader->totalSize < sizeof(*pHeader)
+        || pHeader->totalSize > bufSize)
+    {
+        printf("# ERROR: LINK STATS: Invalid snapshot in file\n");
+        return 0;
+    }
+
+    size = pHeader->totalSize - sizeof(*pHeader);
+
+    if(fread(pBuf + sizeof(*pHeader), 1, size, fp) != size)
+        return 0;
+
+    return pHeader->totalSize;
+}
+
+static void NetworkLinkStats_emit(NetworkLinkStats_Writer *pWr,
+    char *record, char *metric, UInt32 procId, char *name, int ch, int out, UInt64 value)
+{
+    if(pWr->format == NETWORK_LINK_STATS_FORMAT_PROM)
+    {
+        fprintf(pWr->fp, "vsdk_%s_%s{cpu=\"%s\"", record, metric, NetworkLinkStats_getProcName(procId));
+        if(name)
+            fprintf(pWr->fp, ",name=\"%s\"", name);
+        if(ch>=0)
+            fprintf(pWr->fp, ",ch=\"%d\"", ch);
+        if(out>=0)
+            fprintf(pWr->fp, ",out=\"%d\"", out);
+        fprintf(pWr->fp, "} %llu\n", (unsigned long long)value);
+    }
+    else
+    {
+        fprintf(pWr->fp, "%u,%s,%s,%s,",
+            pWr->timeInMsec, record, NetworkLinkStats_getProcName(procId), name ? name : "");
+        if(ch>=0)
+            fprintf(pWr->fp, "%d", ch);
+        fprintf(pWr->fp, ",");
+        if(out>=0)
+            fprintf(pWr->fp, "%d", out);
+        fprintf(pWr->fp, ",%s,%llu\n", metric, (unsigned long long)value);
+    }
+}
+
+static void NetworkLinkStats_emitLatency(NetworkLinkStats_Writer *pWr,
+    char *prefix, UInt32 procId, char *name, NetworkCtrl_LinkStatsLatency *pLat)
+{
+    char metric[64];
+    UInt64 acc;
+
+    if(pLat->count==0)
+        return;
+
+    acc = NetworkLinkStats_get64(pLat->accHi, pLat->accLo);
+
+    snprintf(metric, sizeof(metric), "%s_count", prefix);
+    NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1, pLat->count);
+    snprintf(metric, sizeof(metric), "%s_avg_us", prefix);
+    NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1, acc/pLat->count);
+    snprintf(metric, sizeof(metric), "%s_min_us", prefix);
+    NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1, pLat->min);
+    snprintf(metric, sizeof(metric), "%s_max_us", prefix);
+    NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1, pLat->max);
+}
+
+static void NetworkLinkStats_emitPhase(NetworkLinkStats_Writer *pWr,
+    UInt32 procId, char *name, NetworkCtrl_LinkStatsPhase *pPhase)
+{
+    char metric[64];
+    UInt32 i;
+
+    for(i=0; i<NETWORK_CTRL_LINK_STATS_PHASE_MAX; i++)
+    {
+        if(pPhase[i].count==0)
+            continue;
+
+        snprintf(metric, sizeof(metric), "phase_%s_total", gNetworkLinkStats_phaseName[i]);
+        NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1, pPhase[i].count);
+        snprintf(metric, sizeof(metric), "phase_%s_time", gNetworkLinkStats_phaseName[i]);
+        NetworkLinkStats_emit(pWr, "link", metric, procId, name, -1, -1,
+            NetworkLinkStats_get64(pPhase[i].timeHi, pPhase[i].timeLo));
+    }
+}
+
+char *NetworkLinkStats_getPhaseName(UInt32 phase)
+{
+    if(phase < NETWORK_CTRL_LINK_STATS_PHASE_MAX)
+        return gNetworkLinkStats_phaseName[phase];
+
+    return "INVALID";
+}
+
+void NetworkLinkStats_writeCsvHeader(FILE *fp)
+{
+    fprintf(fp, "time_ms,record,cpu,name,ch,out,metric,value\n");
+}
+
+void NetworkLinkStats_write(FILE *fp, NetworkLinkStats_Snapshot *pSnap, int format)
+{
+    NetworkLinkStats_Writer wr;
+    NetworkCtrl_LinkStatsHeader *pHeader = pSnap->pHeader;
+    NetworkCtrl_LinkStatsCore *pCore;
+    NetworkCtrl_LinkStatsTask *pTask;
+    NetworkCtrl_LinkStatsHeap *pHeap;
+    NetworkCtrl_LinkStatsLink *pLink;
+    NetworkCtrl_LinkStatsCh *pCh;
+    UInt32 i, chId, outId, procId;
+
+    wr.fp = fp;
+    wr.format = format;
+    wr.timeInMsec = pHeader->timeInMsec;
+
+    for(i=0; i<pHeader->numCores; i++)
+    {
+        pCore = &pSnap->pCore[i];
+        procId = pCore->procId;
+
+        NetworkLinkStats_emit(&wr, "core", "load_valid", procId, NULL, -1, -1,
+            (pCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID) ? 1 : 0);
+        NetworkLinkStats_emit(&wr, "core", "total_time", procId, NULL, -1, -1,
+            NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo));
+        NetworkLinkStats_emit(&wr, "core", "idle_time", procId, NULL, -1, -1,
+            NetworkLinkStats_get64(pCore->idleTimeHi, pCore->idleTimeLo));
+        NetworkLinkStats_emit(&wr, "core", "hwi_time", procId, NULL, -1, -1,
+            NetworkLinkStats_get64(pCore->hwiTimeHi, pCore->hwiTimeLo));
+        NetworkLinkStats_emit(&wr, "core", "swi_time", procId, NULL, -1, -1,
+            NetworkLinkStats_get64(pCore->swiTimeHi, pCore->swiTimeLo));
+        NetworkLinkStats_emit(&wr, "core", "load_permille", procId, NULL, -1, -1,
+            NetworkLinkStats_getCoreLoad(pCore));
+        NetworkLinkStats_emit(&wr, "core", "free_sem_objs", procId, NULL, -1, -1, pCore->freeSemaphoreObjs);
+        NetworkLinkStats_emit(&wr, "core", "free_task_objs", procId, NULL, -1, -1, pCore->freeTaskObjs);
+        NetworkLinkStats_emit(&wr, "core", "free_clock_objs", procId, NULL, -1, -1, pCore->freeClockObjs);
+        NetworkLinkStats_emit(&wr, "core", "free_hwi_objs", procId, NULL, -1, -1, pCore->freeHwiObjs);
+    }
+
+    for(i=0; i<pHeader->numTasks; i++)
+    {
+        pTask = &pSnap->pTask[i];
+
+        NetworkLinkStats_emit(&wr, "task", "total_time", pTask->procId, pTask->name, -1, -1,
+            NetworkLinkStats_get64(pTask->totalTimeHi, pTask->totalTimeLo));
+        NetworkLinkStats_emit(&wr, "task", "load_permille", pTask->procId, pTask->name, -1, -1,
+            NetworkLinkStats_getTaskLoad(pSnap, pTask));
+    }
+
+    for(i=0; i<pHeader->numHeaps; i++)
+    {
+        pHeap = &pSnap->pHeap[i];
+
+        NetworkLinkStats_emit(&wr, "heap", "size_bytes", pHeap->procId, pHeap->name, -1, -1, pHeap->heapSize);
+        NetworkLinkStats_emit(&wr, "heap", "free_bytes", pHeap->procId, pHeap->name, -1, -1, pHeap->freeSize);
+    }
+
+    for(i=0; i<pHeader->numLinks; i++)
+    {
+        pLink = pSnap->pLink[i];
+        procId = NETWORK_LINK_STATS_GET_PROC_ID(pLink->linkId);
+
+        NetworkLinkStats_emit(&wr, "link", "elapsed_ms", procId, pLink->name, -1, -1, pLink->elapsedTimeInMsec);
+        NetworkLinkStats_emit(&wr, "link", "in_buf_error_total", procId, pLink->name, -1, -1, pLink->inBufErrorCount);
+        NetworkLinkStats_emit(&wr, "link", "out_buf_error_total", procId, pLink->name, -1, -1, pLink->outBufErrorCount);
+        NetworkLinkStats_emit(&wr, "link", "new_data_cmd_total", procId, pLink->name, -1, -1, pLink->newDataCmdCount);
+        NetworkLinkStats_emit(&wr, "link", "release_data_cmd_total", procId, pLink->name, -1, -1, pLink->releaseDataCmdCount);
+        NetworkLinkStats_emit(&wr, "link", "get_full_buf_total", procId, pLink->name, -1, -1, pLink->getFullBufCount);
+        NetworkLinkStats_emit(&wr, "link", "put_empty_buf_total", procId, pLink->name, -1, -1, pLink->putEmptyBufCount);
+        NetworkLinkStats_emit(&wr, "link", "notify_event_total", procId, pLink->name, -1, -1, pLink->notifyEventCount);
+
+        NetworkLinkStats_emitLatency(&wr, "latency", procId, pLink->name, &pLink->linkLatency);
+        NetworkLinkStats_emitLatency(&wr, "src_latency", procId, pLink->name, &pLink->srcToLinkLatency);
+        NetworkLinkStats_emitPhase(&wr, procId, pLink->name, pLink->phase);
+
+        for(chId=0; chId<pLink->numCh; chId++)
+        {
+            pCh = &pSnap->pCh[i][chId];
+
+            if(pCh->inBufRecvCount==0 && pCh->inBufProcessCount==0
+                && pCh->inBufDropCount==0 && pCh->inBufUserDropCount==0
+                && (pCh->numOut==0 || pCh->outBufCount[0]==0))
+            {
+                /* skip unused channels */
+                continue;
+            }
+
+            NetworkLinkStats_emit(&wr, "ch", "in_buf_recv_total", procId, pLink->name, chId, -1, pCh->inBufRecvCount);
+            NetworkLinkStats_emit(&wr, "ch", "in_buf_drop_total", procId, pLink->name, chId, -1, pCh->inBufDropCount);
+            NetworkLinkStats_emit(&wr, "ch", "in_buf_user_drop_total", procId, pLink->name, chId, -1, pCh->inBufUserDropCount);
+            NetworkLinkStats_emit(&wr, "ch", "in_buf_process_total", procId, pLink->name, chId, -1, pCh->inBufProcessCount);
+
+            for(outId=0; outId<pCh->numOut && outId<NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE; outId++)
+            {
+                NetworkLinkStats_emit(&wr, "ch", "out_buf_total", procId, pLink->name, chId, outId, pCh->outBufCount[outId]);
+                NetworkLinkStats_emit(&wr, "ch", "out_buf_drop_total", procId, pLink->name, chId, outId, pCh->outBufDropCount[outId]);
+                NetworkLinkStats_emit(&wr, "ch", "out_buf_user_drop_total", procId, pLink->name, chId, outId, pCh->outBufUserDropCount[outId]);
+            }
+        }
+    }
+
+    fflush(fp);
+}
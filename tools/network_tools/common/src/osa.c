@@ -2,6 +2,7 @@
 
 #include <osa.h>
 #include <sys/time.h>
+#include <time.h>
 
 Uint32 OSA_getCurTimeInMsec()
 {
@@ -13,6 +14,29 @@ Uint32 OSA_getCurTimeInMsec()
   return tv.tv_sec * 1000 + tv.tv_usec/1000;
 }
 
+/* Monotonic, for measuring intervals and pacing */
+Uint64 OSA_getCurTimeInUsec()
+{
+  struct timespec ts;
+
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+    return 0;
+
+  return (Uint64)ts.tv_sec * 1000000 + ts.tv_nsec/1000;
+}
+
+void OSA_waitMsecs(Uint32 msecs)
+{
+  while(msecs >= 1000)
+  {
+    usleep(999*1000);
+    msecs -= 999;
+  }
+
+  if(msecs)
+    usleep(msecs*1000);
+}
+
 static char xtod(char c) {
   if (c>='0' && c<='9') return c-'0';
   if (c>='A' && c<='F') return c-'A'+10;
@@ -32,3 +56,29 @@ int xstrtoi(char *hex)      // hex string to integer
 {
   return HextoDec(hex,0);
 }
+
+/* CRC-32 (IEEE 802.3), same as computed by target for chunked transfers */
+Uint32 OSA_crc32(Uint8 *pData, Uint32 size)
+{
+  static Uint32 crcTable[256];
+  static int isCrcTableInit = 0;
+  Uint32 crc, i, j;
+
+  if(!isCrcTableInit)
+  {
+    for(i=0; i<256; i++)
+    {
+      crc = i;
+      for(j=0; j<8; j++)
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+      crcTable[i] = crc;
+    }
+    isCrcTableInit = 1;
+  }
+
+  crc = 0xFFFFFFFF;
+  for(i=0; i<size; i++)
+    crc = crcTable[(crc ^ pData[i]) & 0xFF] ^ (crc >> 8);
+
+  return crc ^ 0xFFFFFFFF;
+}
@@ -2,6 +2,12 @@
 
 #include <osa_file.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
 #define OSA_DEBUG_FILE
 
 int OSA_fileReadFile(char *fileName, Uint8 *addr, Uint32 readSize, Uint32 *actualReadSize)
@@ -68,6 +74,20 @@ exit:
   return retVal;
 }
 
+int OSA_fileGetSize(char *fileName, Uint64 *size)
+{
+  struct stat fileStat;
+
+  *size = 0;
+
+  if(stat(fileName, &fileStat) != 0)
+    return OSA_EFAIL;
+
+  *size = (Uint64)fileStat.st_size;
+
+  return OSA_SOK;
+}
+
 int OSA_fileWriteFile(char *fileName, Uint8 *addr, Uint32 size)
 {
   int retVal = OSA_SOK;
@@ -129,3 +149,82 @@ exit:
 
 }
 
+int OSA_fileMap(OSA_FileMapHndl *hndl, char *fileName)
+{
+#ifdef _WIN32
+  LARGE_INTEGER fileSize;
+#else
+  struct stat fileStat;
+  int fd;
+#endif
+
+  memset(hndl, 0, sizeof(*hndl));
+
+#ifdef _WIN32
+  hndl->hFile = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if(hndl->hFile == INVALID_HANDLE_VALUE) {
+    hndl->hFile = NULL;
+    return OSA_EFAIL;
+  }
+
+  if(!GetFileSizeEx(hndl->hFile, &fileSize) || fileSize.QuadPart == 0) {
+    OSA_fileUnmap(hndl);
+    return OSA_EFAIL;
+  }
+  hndl->size = fileSize.QuadPart;
+
+  hndl->hMap = CreateFileMappingA(hndl->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  if(hndl->hMap == NULL) {
+    OSA_fileUnmap(hndl);
+    return OSA_EFAIL;
+  }
+
+  hndl->addr = MapViewOfFile(hndl->hMap, FILE_MAP_READ, 0, 0, 0);
+  if(hndl->addr == NULL) {
+    OSA_fileUnmap(hndl);
+    return OSA_EFAIL;
+  }
+#else
+  fd = open(fileName, O_RDONLY);
+  if(fd < 0)
+    return OSA_EFAIL;
+
+  if(fstat(fd, &fileStat) < 0 || fileStat.st_size == 0) {
+    close(fd);
+    return OSA_EFAIL;
+  }
+  hndl->size = fileStat.st_size;
+
+  hndl->addr = mmap(NULL, hndl->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(hndl->addr == MAP_FAILED) {
+    hndl->addr = NULL;
+    return OSA_EFAIL;
+  }
+
+  madvise(hndl->addr, hndl->size, MADV_SEQUENTIAL);
+#endif
+
+  return OSA_SOK;
+}
+
+int OSA_fileUnmap(OSA_FileMapHndl *hndl)
+{
+#ifdef _WIN32
+  if(hndl->addr)
+    UnmapViewOfFile(hndl->addr);
+  if(hndl->hMap)
+    CloseHandle(hndl->hMap);
+  if(hndl->hFile)
+    CloseHandle(hndl->hFile);
+#else
+  if(hndl->addr)
+    munmap(hndl->addr, hndl->size);
+#endif
+
+  memset(hndl, 0, sizeof(*hndl));
+
+  return OSA_SOK;
+}
@@ -0,0 +1,108 @@
+
+
+#include <osa_que.h>
+
+int OSA_queCreate(OSA_QueHndl *hndl, Uint32 maxLen)
+{
+  hndl->curRd = hndl->curWr = 0;
+  hndl->count = 0;
+  hndl->len   = maxLen;
+  hndl->queue = OSA_memAlloc(sizeof(void*)*maxLen);
+
+  if(hndl->queue==NULL) {
+    OSA_ERROR("OSA_queCreate() = %d \r\n", OSA_EFAIL);
+    return OSA_EFAIL;
+  }
+
+  pthread_mutex_init(&hndl->lock, NULL);
+  pthread_cond_init(&hndl->condRd, NULL);
+  pthread_cond_init(&hndl->condWr, NULL);
+
+  return OSA_SOK;
+}
+
+int OSA_queDelete(OSA_QueHndl *hndl)
+{
+  if(hndl->queue!=NULL)
+    OSA_memFree(hndl->queue);
+
+  hndl->queue = NULL;
+
+  pthread_cond_destroy(&hndl->condRd);
+  pthread_cond_destroy(&hndl->condWr);
+  pthread_mutex_destroy(&hndl->lock);
+
+  return OSA_SOK;
+}
+
+int OSA_quePut(OSA_QueHndl *hndl, void *value, Uint32 timeout)
+{
+  int status = OSA_EFAIL;
+
+  pthread_mutex_lock(&hndl->lock);
+
+  while(1) {
+    if( hndl->count < hndl->len ) {
+      hndl->queue[hndl->curWr] = value;
+      hndl->curWr = (hndl->curWr+1)%hndl->len;
+      hndl->count++;
+      status = OSA_SOK;
+      pthread_cond_signal(&hndl->condRd);
+      break;
+    } else {
+      if(timeout == OSA_TIMEOUT_NONE)
+        break;
+
+      pthread_cond_wait(&hndl->condWr, &hndl->lock);
+    }
+  }
+
+  pthread_mutex_unlock(&hndl->lock);
+
+  return status;
+}
+
+int OSA_queGet(OSA_QueHndl *hndl, void **value, Uint32 timeout)
+{
+  int status = OSA_EFAIL;
+
+  pthread_mutex_lock(&hndl->lock);
+
+  while(1) {
+    if(hndl->count > 0 ) {
+
+      if(value!=NULL) {
+        *value = hndl->queue[hndl->curRd];
+      }
+
+      hndl->curRd = (hndl->curRd+1)%hndl->len;
+      hndl->count--;
+      status = OSA_SOK;
+      pthread_cond_signal(&hndl->condWr);
+      break;
+    } else {
+      if(timeout == OSA_TIMEOUT_NONE)
+        break;
+
+      pthread_cond_wait(&hndl->condRd, &hndl->lock);
+    }
+  }
+
+  pthread_mutex_unlock(&hndl->lock);
+
+  return status;
+}
+
+Uint32 OSA_queGetQueuedCount(OSA_QueHndl *hndl)
+{
+  Uint32 queuedCount;
+
+  pthread_mutex_lock(&hndl->lock);
+  queuedCount = hndl->count;
+  pthread_mutex_unlock(&hndl->lock);
+
+  return queuedCount;
+}
+
+
+
@@ -0,0 +1,30 @@
+
+
+#include <osa_thr.h>
+
+int OSA_thrCreate(OSA_ThrHndl *hndl, OSA_ThrEntryFunc entryFunc, void *prm)
+{
+  int status;
+
+  status = pthread_create(&hndl->hndl, NULL, entryFunc, prm);
+
+  if(status!=0) {
+    OSA_ERROR("OSA_thrCreate() - Could not create thread [%d]\n", status);
+    return OSA_EFAIL;
+  }
+
+  return OSA_SOK;
+}
+
+int OSA_thrJoin(OSA_ThrHndl *hndl)
+{
+  void *returnVal;
+
+  if(pthread_join(hndl->hndl, &returnVal)!=0)
+    return OSA_EFAIL;
+
+  return OSA_SOK;
+}
+
+
+
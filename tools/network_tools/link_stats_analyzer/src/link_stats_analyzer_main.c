@@ -0,0 +1,1216 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#include "link_stats_analyzer_priv.h"
+#include <ctype.h>
+
+/* Same as SYSTEM_GET_PROC_ID() on target */
+#define LSA_GET_PROC_ID(linkId)  (((linkId) >> 8) & 0xF)
+
+LinkStatsAnalyzer_Obj gLinkStatsAnalyzer_obj;
+
+/* cores of same class can run the same links */
+static int gLinkStatsAnalyzer_coreClass[LSA_MAX_CORES] =
+{
+    0, 0, 1, 2, 2, 3, 3, 3, 3
+};
+
+static char *gLinkStatsAnalyzer_coreClassName[] =
+{
+    "IPU", "A15", "DSP", "EVE"
+};
+
+static char *gLinkStatsAnalyzer_causeName[] =
+{
+    "-", "LINK", "CORE", "DOWNSTREAM"
+};
+
+void ShowUsage()
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# link_stats_analyzer --stats <snapshot file> [--topology <topology file>] [--target-fps <fps>]\n");
+    printf("# \n");
+    printf("#   --stats      : binary snapshots saved using network_ctrl, \n");
+    printf("#                  'network_ctrl --ipaddr <ipaddr> --cmd link_stats bin <snapshot file> <interval> <count>'\n");
+    printf("#                  statistics are computed between first and last snapshot in the file\n");
+    printf("#   --topology   : link connections, one chain per line, '#' or '//' starts a comment\n");
+    printf("#                    CAPTURE@IPU1_0 -> IPC_OUT_0@IPU1_0 -> IPC_IN_0@DSP1 -> ALG_0@DSP1\n");
+    printf("#                  number of output buffers of a link can be given as\n");
+    printf("#                    bufs CAPTURE@IPU1_0 6\n");
+    printf("#                  '@<cpu>' can be skipped when link name is unique\n");
+    printf("#   --target-fps : links which cannot sustain this frame rate are flagged\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2016\n");
+    printf("# \n");
+    exit(0);
+}
+
+static double GetFps(UInt32 count, UInt32 timeInMsec)
+{
+    if(timeInMsec==0)
+        return 0;
+
+    return ((double)count*1000.0)/timeInMsec;
+}
+
+static int IsCoreValid(UInt32 procId)
+{
+    return procId < LSA_MAX_CORES && gLinkStatsAnalyzer_obj.core[procId].isValid;
+}
+
+static int StrCmpNoCase(char *a, char *b)
+{
+    while(*a && *b)
+    {
+        if(toupper((unsigned char)*a)!=toupper((unsigned char)*b))
+            return 1;
+        a++;
+        b++;
+    }
+
+    return *a != *b;
+}
+
+static char *TrimSpace(char *str)
+{
+    char *end;
+
+    while(isspace((unsigned char)*str))
+        str++;
+
+    end = str + strlen(str);
+    while(end > str && isspace((unsigned char)end[-1]))
+        end--;
+
+    *end = 0;
+
+    return str;
+}
+
+void ParseCmdLineArgs(int argc, char *argv[])
+{
+    int i;
+
+    memset(&gLinkStatsAnalyzer_obj, 0, sizeof(gLinkStatsAnalyzer_obj));
+
+    for(i=0; i<argc; i++)
+    {
+        if(strcmp(argv[i], "--stats")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            strcpy(gLinkStatsAnalyzer_obj.statsFile, argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--topology")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            strcpy(gLinkStatsAnalyzer_obj.topologyFile, argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--target-fps")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gLinkStatsAnalyzer_obj.targetFps = atof(argv[i]);
+        }
+    }
+
+    if(gLinkStatsAnalyzer_obj.statsFile[0]==0)
+    {
+        printf("# ERROR: Snapshot file MUST be specified\n");
+        ShowUsage();
+    }
+}
+
+int ReadSnapshots()
+{
+    FILE *fp;
+    UInt8 *pCurBuf, *pTmp;
+    int size;
+
+    fp = fopen(gLinkStatsAnalyzer_obj.statsFile, "rb");
+    if(fp==NULL)
+    {
+        printf("# ERROR: Unable to open file [%s]\n", gLinkStatsAnalyzer_obj.statsFile);
+        return -1;
+    }
+
+    gLinkStatsAnalyzer_obj.pFirstBuf = malloc(LSA_MAX_SNAPSHOT_SIZE);
+    gLinkStatsAnalyzer_obj.pLastBuf  = malloc(LSA_MAX_SNAPSHOT_SIZE);
+    pCurBuf = malloc(LSA_MAX_SNAPSHOT_SIZE);
+
+    if(gLinkStatsAnalyzer_obj.pFirstBuf==NULL
+        || gLinkStatsAnalyzer_obj.pLastBuf==NULL
+        || pCurBuf==NULL)
+    {
+        printf("# ERROR: Unable to allocate memory for snapshots\n");
+        exit(0);
+    }
+
+    gLinkStatsAnalyzer_obj.numSnapshots = 0;
+
+    while(1)
+    {
+        size = NetworkLinkStats_readSnapshot(fp, pCurBuf, LSA_MAX_SNAPSHOT_SIZE);
+        if(size<=0)
+            break;
+
+        /* keep first and latest snapshot, swap buffers to avoid a copy */
+        if(gLinkStatsAnalyzer_obj.numSnapshots==0)
+        {
+            pTmp = gLinkStatsAnalyzer_obj.pFirstBuf;
+            gLinkStatsAnalyzer_obj.pFirstBuf = pCurBuf;
+        }
+        else
+        {
+            pTmp = gLinkStatsAnalyzer_obj.pLastBuf;
+            gLinkStatsAnalyzer_obj.pLastBuf = pCurBuf;
+        }
+        pCurBuf = pTmp;
+
+        gLinkStatsAnalyzer_obj.numSnapshots++;
+    }
+
+    fclose(fp);
+    free(pCurBuf);
+
+    if(gLinkStatsAnalyzer_obj.numSnapshots==0)
+    {
+        printf("# ERROR: No valid snapshot in file [%s]\n", gLinkStatsAnalyzer_obj.statsFile);
+        return -1;
+    }
+
+    if(gLinkStatsAnalyzer_obj.numSnapshots==1)
+    {
+        /* only cumulative statistics are available */
+        memcpy(gLinkStatsAnalyzer_obj.pLastBuf,
+               gLinkStatsAnalyzer_obj.pFirstBuf,
+               ((NetworkCtrl_LinkStatsHeader*)gLinkStatsAnalyzer_obj.pFirstBuf)->totalSize);
+    }
+
+    if(NetworkLinkStats_parse(&gLinkStatsAnalyzer_obj.first,
+            gLinkStatsAnalyzer_obj.pFirstBuf,
+            ((NetworkCtrl_LinkStatsHeader*)gLinkStatsAnalyzer_obj.pFirstBuf)->totalSize)!=OSA_SOK
+        ||
+       NetworkLinkStats_parse(&gLinkStatsAnalyzer_obj.last,
+            gLinkStatsAnalyzer_obj.pLastBuf,
+            ((NetworkCtrl_LinkStatsHeader*)gLinkStatsAnalyzer_obj.pLastBuf)->totalSize)!=OSA_SOK)
+    {
+        printf("# ERROR: Unable to parse snapshots in file [%s]\n", gLinkStatsAnalyzer_obj.statsFile);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Delta of a 64-bit counter between first and last snapshot */
+static UInt64 GetDelta64(UInt64 last, UInt64 first)
+{
+    if(gLinkStatsAnalyzer_obj.numSnapshots < 2 || first > last)
+        return last;
+
+    return last - first;
+}
+
+static void ComputeCoreLoad()
+{
+    NetworkLinkStats_Snapshot *pLast = &gLinkStatsAnalyzer_obj.last;
+    NetworkCtrl_LinkStatsCore *pCore, *pPrevCore;
+    UInt64 totalTime, idleTime;
+    UInt32 i;
+
+    for(i=0; i<pLast->pHeader->numCores; i++)
+    {
+        pCore = &pLast->pCore[i];
+
+        if(pCore->procId >= LSA_MAX_CORES
+            || !(pCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID))
+            continue;
+
+        totalTime = NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo);
+        idleTime  = NetworkLinkStats_get64(pCore->idleTimeHi, pCore->idleTimeLo);
+
+        pPrevCore = NetworkLinkStats_findCore(&gLinkStatsAnalyzer_obj.first, pCore->procId);
+        if(pPrevCore && (pPrevCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID)
+            && NetworkLinkStats_get64(pPrevCore->totalTimeHi, pPrevCore->totalTimeLo) < totalTime)
+        {
+            totalTime = GetDelta64(totalTime,
+                NetworkLinkStats_get64(pPrevCore->totalTimeHi, pPrevCore->totalTimeLo));
+            idleTime = GetDelta64(idleTime,
+                NetworkLinkStats_get64(pPrevCore->idleTimeHi, pPrevCore->idleTimeLo));
+        }
+
+        if(totalTime==0 || idleTime > totalTime)
+            continue;
+
+        gLinkStatsAnalyzer_obj.core[pCore->procId].isValid = 1;
+        gLinkStatsAnalyzer_obj.core[pCore->procId].load =
+            1.0 - (double)idleTime/(double)totalTime;
+    }
+}
+
+static NetworkCtrl_LinkStatsTask *FindTask(NetworkLinkStats_Snapshot *pSnap, UInt32 procId, char *name)
+{
+    UInt32 i;
+
+    for(i=0; i<pSnap->pHeader->numTasks; i++)
+    {
+        if(pSnap->pTask[i].procId==procId
+            && strcmp(pSnap->pTask[i].name, name)==0)
+            return &pSnap->pTask[i];
+    }
+
+    return NULL;
+}
+
+static int FindLinkIdx(NetworkLinkStats_Snapshot *pSnap, UInt32 linkId, char *name)
+{
+    UInt32 i;
+
+    for(i=0; i<pSnap->pHeader->numLinks; i++)
+    {
+        if(pSnap->pLink[i]->linkId==linkId
+            && strcmp(pSnap->pLink[i]->name, name)==0)
+            return i;
+    }
+
+    return -1;
+}
+
+/* Fraction of core time used by the link task between first and last snapshot */
+static double GetTaskBusy(UInt32 procId, char *name)
+{
+    NetworkCtrl_LinkStatsTask *pTask, *pPrevTask;
+    NetworkCtrl_LinkStatsCore *pCore, *pPrevCore;
+    UInt64 tskTime, totalTime, prevTotalTime;
+
+    pTask = FindTask(&gLinkStatsAnalyzer_obj.last, procId, name);
+    pCore = NetworkLinkStats_findCore(&gLinkStatsAnalyzer_obj.last, procId);
+
+    if(pTask==NULL || pCore==NULL
+        || !(pCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID))
+        return -1;
+
+    tskTime   = NetworkLinkStats_get64(pTask->totalTimeHi, pTask->totalTimeLo);
+    totalTime = NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo);
+
+    pPrevTask = FindTask(&gLinkStatsAnalyzer_obj.first, procId, name);
+    pPrevCore = NetworkLinkStats_findCore(&gLinkStatsAnalyzer_obj.first, procId);
+
+    if(pPrevTask && pPrevCore
+        && (pPrevCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID))
+    {
+        prevTotalTime = NetworkLinkStats_get64(pPrevCore->totalTimeHi, pPrevCore->totalTimeLo);
+        if(prevTotalTime < totalTime)
+        {
+            totalTime = GetDelta64(totalTime, prevTotalTime);
+            tskTime   = GetDelta64(tskTime,
+                NetworkLinkStats_get64(pPrevTask->totalTimeHi, pPrevTask->totalTimeLo));
+        }
+    }
+
+    if(totalTime==0)
+        return -1;
+
+    return (double)tskTime/(double)totalTime;
+}
+
+/* Core total time between first and last snapshot, 0 if not known */
+static UInt64 GetCoreTotalTime(UInt32 procId)
+{
+    NetworkCtrl_LinkStatsCore *pCore, *pPrevCore;
+    UInt64 totalTime, prevTotalTime;
+
+    pCore = NetworkLinkStats_findCore(&gLinkStatsAnalyzer_obj.last, procId);
+
+    if(pCore==NULL
+        || !(pCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID))
+        return 0;
+
+    totalTime = NetworkLinkStats_get64(pCore->totalTimeHi, pCore->totalTimeLo);
+
+    pPrevCore = NetworkLinkStats_findCore(&gLinkStatsAnalyzer_obj.first, procId);
+
+    if(pPrevCore
+        && (pPrevCore->flags & NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID))
+    {
+        prevTotalTime = NetworkLinkStats_get64(pPrevCore->totalTimeHi, pPrevCore->totalTimeLo);
+        if(prevTotalTime < totalTime)
+            totalTime = GetDelta64(totalTime, prevTotalTime);
+    }
+
+    return totalTime;
+}
+
+/*
+ * Fraction of core time spent by the link in each phase. Phase times are
+ * not cleared by a link statistics reset done by the plugin, so the delta
+ * is used whenever the times did not go backwards.
+ */
+static void ComputePhaseShare(LinkStatsAnalyzer_Link *pObj,
+    NetworkCtrl_LinkStatsLink *pLink, NetworkCtrl_LinkStatsLink *pPrevLink)
+{
+    UInt64 totalTime, phaseTime, prevPhaseTime;
+    UInt32 i;
+
+    pObj->hasPhase = 0;
+
+    for(i=0; i<NETWORK_CTRL_LINK_STATS_PHASE_MAX; i++)
+    {
+        if(pLink->phase[i].count)
+            pObj->hasPhase = 1;
+    }
+
+    totalTime = GetCoreTotalTime(pObj->procId);
+
+    if(!pObj->hasPhase || totalTime==0)
+    {
+        pObj->hasPhase = 0;
+        return;
+    }
+
+    for(i=0; i<NETWORK_CTRL_LINK_STATS_PHASE_MAX; i++)
+    {
+        phaseTime = NetworkLinkStats_get64(pLink->phase[i].timeHi, pLink->phase[i].timeLo);
+
+        if(pPrevLink)
+        {
+            prevPhaseTime = NetworkLinkStats_get64(pPrevLink->phase[i].timeHi, pPrevLink->phase[i].timeLo);
+            phaseTime = GetDelta64(phaseTime, prevPhaseTime);
+        }
+
+        pObj->phaseShare[i] = (double)phaseTime/(double)totalTime;
+    }
+}
+
+static void SumChCounts(NetworkLinkStats_Snapshot *pSnap, int linkIdx,
+    UInt32 *recv, UInt32 *drop, UInt32 *userDrop, UInt32 *process, UInt32 *out)
+{
+    NetworkCtrl_LinkStatsCh *pCh;
+    UInt32 ch, q;
+
+    *recv = *drop = *userDrop = *process = *out = 0;
+
+    for(ch=0; ch<pSnap->pLink[linkIdx]->numCh; ch++)
+    {
+        pCh = &pSnap->pCh[linkIdx][ch];
+
+        *recv     += pCh->inBufRecvCount;
+        *drop     += pCh->inBufDropCount;
+        *userDrop += pCh->inBufUserDropCount;
+        *process  += pCh->inBufProcessCount;
+
+        for(q=0; q<pCh->numOut && q<NETWORK_CTRL_LINK_STATS_MAX_OUT_QUE; q++)
+        {
+            *out += pCh->outBufCount[q];
+        }
+    }
+}
+
+void ComputeLinkStats()
+{
+    NetworkLinkStats_Snapshot *pLast = &gLinkStatsAnalyzer_obj.last;
+    NetworkLinkStats_Snapshot *pFirst = &gLinkStatsAnalyzer_obj.first;
+    NetworkCtrl_LinkStatsLink *pLink, *pPrevLink;
+    LinkStatsAnalyzer_Link *pObj;
+    UInt32 recv, drop, userDrop, process, out;
+    UInt32 pRecv, pDrop, pUserDrop, pProcess, pOut;
+    UInt32 timeInMsec, latCount, phase;
+    UInt64 latAcc;
+    LinkStatsAnalyzer_Core *pCore;
+    int i, prevIdx;
+
+    ComputeCoreLoad();
+
+    gLinkStatsAnalyzer_obj.numLinks = 0;
+
+    for(i=0; i<(int)pLast->pHeader->numLinks && i<LSA_MAX_LINKS; i++)
+    {
+        pLink = pLast->pLink[i];
+        pObj  = &gLinkStatsAnalyzer_obj.link[gLinkStatsAnalyzer_obj.numLinks];
+
+        memset(pObj, 0, sizeof(*pObj));
+
+        memcpy(pObj->name, pLink->name, sizeof(pObj->name));
+        pObj->name[sizeof(pObj->name)-1] = 0;
+        pObj->linkId    = pLink->linkId;
+        pObj->procId    = LSA_GET_PROC_ID(pLink->linkId);
+        pObj->numBufs   = 0;
+        pObj->causeLink = -1;
+
+        SumChCounts(pLast, i, &recv, &drop, &userDrop, &process, &out);
+
+        timeInMsec = pLink->elapsedTimeInMsec;
+        latCount   = pLink->linkLatency.count;
+        latAcc     = NetworkLinkStats_get64(pLink->linkLatency.accHi, pLink->linkLatency.accLo);
+
+        prevIdx = -1;
+        if(gLinkStatsAnalyzer_obj.numSnapshots > 1)
+            prevIdx = FindLinkIdx(pFirst, pLink->linkId, pLink->name);
+
+        ComputePhaseShare(pObj, pLink, prevIdx >= 0 ? pFirst->pLink[prevIdx] : NULL);
+
+        /* use delta only when stats were not reset in between */
+        if(prevIdx >= 0
+            && pFirst->pLink[prevIdx]->elapsedTimeInMsec < timeInMsec)
+        {
+            pPrevLink = pFirst->pLink[prevIdx];
+
+            SumChCounts(pFirst, prevIdx, &pRecv, &pDrop, &pUserDrop, &pProcess, &pOut);
+
+            timeInMsec -= pPrevLink->elapsedTimeInMsec;
+            recv       -= pRecv;
+            drop       -= pDrop;
+            userDrop   -= pUserDrop;
+            process    -= pProcess;
+            out        -= pOut;
+
+            if(pPrevLink->linkLatency.count <= latCount)
+            {
+                latCount -= pPrevLink->linkLatency.count;
+                latAcc    = GetDelta64(latAcc,
+                    NetworkLinkStats_get64(pPrevLink->linkLatency.accHi, pPrevLink->linkLatency.accLo));
+            }
+        }
+
+        pObj->inFps       = GetFps(recv, timeInMsec);
+        pObj->dropFps     = GetFps(drop, timeInMsec);
+        pObj->userDropFps = GetFps(userDrop, timeInMsec);
+        pObj->procFps     = GetFps(process, timeInMsec);
+        pObj->outFps      = GetFps(out, timeInMsec);
+
+        pObj->offeredFps = pObj->inFps;
+        if(pObj->procFps + pObj->dropFps > pObj->offeredFps)
+            pObj->offeredFps = pObj->procFps + pObj->dropFps;
+
+        pObj->latencyUs = 0;
+        if(latCount)
+            pObj->latencyUs = (double)latAcc/latCount;
+
+        /* Little's law, frames in link = arrival rate x time in link */
+        pObj->occupancy = pObj->procFps * pObj->latencyUs / 1000000.0;
+
+        pObj->busy = GetTaskBusy(pObj->procId, pObj->name);
+
+        pObj->capacityFps = -1;
+        if(pObj->busy > 0.01 && pObj->procFps > 0)
+            pObj->capacityFps = pObj->procFps / pObj->busy;
+
+        if(pObj->hasPhase && pObj->procId < LSA_MAX_CORES)
+        {
+            pCore = &gLinkStatsAnalyzer_obj.core[pObj->procId];
+
+            for(phase=0; phase<NETWORK_CTRL_LINK_STATS_PHASE_MAX; phase++)
+            {
+                if(phase==NETWORK_CTRL_LINK_STATS_PHASE_PROCESS)
+                    pCore->processShare += pObj->phaseShare[phase];
+                else
+                    pCore->frameworkShare += pObj->phaseShare[phase];
+            }
+        }
+
+        gLinkStatsAnalyzer_obj.numLinks++;
+    }
+}
+
+static int FindLinkByName(char *token)
+{
+    char name[NETWORK_CTRL_LINK_STATS_NAME_MAX*2];
+    char *cpu;
+    int i, found = -1;
+
+    strncpy(name, token, sizeof(name)-1);
+    name[sizeof(name)-1] = 0;
+
+    cpu = strchr(name, '@');
+    if(cpu)
+    {
+        *cpu = 0;
+        cpu++;
+    }
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numLinks; i++)
+    {
+        if(strcmp(gLinkStatsAnalyzer_obj.link[i].name, name)!=0)
+            continue;
+
+        if(cpu && StrCmpNoCase(NetworkLinkStats_getProcName(gLinkStatsAnalyzer_obj.link[i].procId), cpu)!=0)
+            continue;
+
+        if(found >= 0)
+        {
+            printf("# WARNING: Link [%s] present on multiple CPUs, specify as %s@<cpu>\n", name, name);
+            return -1;
+        }
+        found = i;
+    }
+
+    if(found < 0)
+    {
+        printf("# WARNING: Link [%s] not found in snapshot\n", token);
+    }
+
+    return found;
+}
+
+static void AddEdge(int src, int dst)
+{
+    LinkStatsAnalyzer_Link *pSrc, *pDst;
+    int i;
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numEdges; i++)
+    {
+        if(gLinkStatsAnalyzer_obj.edgeSrc[i]==src && gLinkStatsAnalyzer_obj.edgeDst[i]==dst)
+            return;
+    }
+
+    pSrc = &gLinkStatsAnalyzer_obj.link[src];
+    pDst = &gLinkStatsAnalyzer_obj.link[dst];
+
+    if(gLinkStatsAnalyzer_obj.numEdges >= LSA_MAX_EDGES
+        || pSrc->numOutEdges >= LSA_MAX_EDGES
+        || pDst->numInEdges >= LSA_MAX_EDGES)
+    {
+        printf("# WARNING: Max connections (%d) exceeded, ignoring %s -> %s\n",
+            LSA_MAX_EDGES, pSrc->name, pDst->name);
+        return;
+    }
+
+    gLinkStatsAnalyzer_obj.edgeSrc[gLinkStatsAnalyzer_obj.numEdges] = src;
+    gLinkStatsAnalyzer_obj.edgeDst[gLinkStatsAnalyzer_obj.numEdges] = dst;
+    gLinkStatsAnalyzer_obj.numEdges++;
+
+    pSrc->outEdge[pSrc->numOutEdges++] = dst;
+    pDst->inEdge[pDst->numInEdges++] = src;
+}
+
+int ReadTopology()
+{
+    FILE *fp;
+    char line[4096], *pStr, *pToken, *pNext, *pComment;
+    char linkName[256];
+    int lineNum = 0, prev, cur, numBufs;
+
+    if(gLinkStatsAnalyzer_obj.topologyFile[0]==0)
+        return 0;
+
+    fp = fopen(gLinkStatsAnalyzer_obj.topologyFile, "r");
+    if(fp==NULL)
+    {
+        printf("# ERROR: Unable to open file [%s]\n", gLinkStatsAnalyzer_obj.topologyFile);
+        return -1;
+    }
+
+    while(fgets(line, sizeof(line), fp))
+    {
+        lineNum++;
+
+        pComment = strchr(line, '#');
+        if(pComment)
+            *pComment = 0;
+        pComment = strstr(line, "//");
+        if(pComment)
+            *pComment = 0;
+
+        pStr = TrimSpace(line);
+        if(*pStr==0)
+            continue;
+
+        if(strncmp(pStr, "bufs", 4)==0 && isspace((unsigned char)pStr[4]))
+        {
+            if(sscanf(pStr+4, "%255s %d", linkName, &numBufs)!=2 || numBufs<=0)
+            {
+                printf("# WARNING: %s:%d: Invalid line, expected 'bufs <link> <count>'\n",
+                    gLinkStatsAnalyzer_obj.topologyFile, lineNum);
+                continue;
+            }
+            cur = FindLinkByName(linkName);
+            if(cur>=0)
+                gLinkStatsAnalyzer_obj.link[cur].numBufs = numBufs;
+            continue;
+        }
+
+        prev = -1;
+        pToken = pStr;
+        while(pToken)
+        {
+            pNext = strstr(pToken, "->");
+            if(pNext)
+            {
+                *pNext = 0;
+                pNext += 2;
+            }
+
+            pToken = TrimSpace(pToken);
+            cur = -1;
+            if(*pToken)
+                cur = FindLinkByName(pToken);
+
+            if(prev>=0 && cur>=0)
+                AddEdge(prev, cur);
+
+            prev = cur;
+            pToken = pNext;
+        }
+    }
+
+    fclose(fp);
+
+    return 0;
+}
+
+static double GetCoreLoad(UInt32 procId)
+{
+    if(!IsCoreValid(procId))
+        return -1;
+
+    return gLinkStatsAnalyzer_obj.core[procId].load;
+}
+
+/* How close the link is to its limit, 1.0 means it is at its limit */
+static double GetPressure(LinkStatsAnalyzer_Link *pObj)
+{
+    double pressure = 0, coreLoad;
+
+    if(pObj->capacityFps > 0)
+        pressure = pObj->offeredFps / pObj->capacityFps;
+
+    coreLoad = GetCoreLoad(pObj->procId);
+    if(coreLoad > pressure)
+        pressure = coreLoad;
+
+    return pressure;
+}
+
+/*
+ * Among links reachable from 'linkIdx' find the one which is closest to its
+ * limit, buffers of 'linkIdx' are most likely held up by this link.
+ * 'pPathLatencyUs' is the sum of link latencies up to this link.
+ */
+static int FindDownstreamBottleneck(int linkIdx, double *pPathLatencyUs)
+{
+    int stack[LSA_MAX_LINKS], visited[LSA_MAX_LINKS], parent[LSA_MAX_LINKS];
+    int top = 0, cur, next, i, best = -1;
+    double pressure, bestPressure = -1;
+
+    memset(visited, 0, sizeof(visited));
+
+    stack[top++] = linkIdx;
+    visited[linkIdx] = 1;
+    parent[linkIdx] = -1;
+
+    while(top > 0)
+    {
+        cur = stack[--top];
+
+        if(cur!=linkIdx)
+        {
+            pressure = GetPressure(&gLinkStatsAnalyzer_obj.link[cur]);
+            if(pressure > bestPressure)
+            {
+                bestPressure = pressure;
+                best = cur;
+            }
+        }
+
+        for(i=0; i<gLinkStatsAnalyzer_obj.link[cur].numOutEdges; i++)
+        {
+            next = gLinkStatsAnalyzer_obj.link[cur].outEdge[i];
+            if(!visited[next])
+            {
+                visited[next] = 1;
+                parent[next] = cur;
+                stack[top++] = next;
+            }
+        }
+    }
+
+    *pPathLatencyUs = 0;
+    for(cur=best; cur>=0; cur=parent[cur])
+    {
+        *pPathLatencyUs += gLinkStatsAnalyzer_obj.link[cur].latencyUs;
+    }
+
+    return best;
+}
+
+void Analyze()
+{
+    LinkStatsAnalyzer_Link *pObj;
+    double dropFrac, util, pathLatencyUs;
+    int i;
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numLinks; i++)
+    {
+        pObj = &gLinkStatsAnalyzer_obj.link[i];
+
+        dropFrac = 0;
+        if(pObj->offeredFps > 0)
+            dropFrac = pObj->dropFps / pObj->offeredFps;
+
+        util = -1;
+        if(pObj->capacityFps > 0)
+            util = pObj->offeredFps / pObj->capacityFps;
+
+        pObj->score = GetPressure(pObj);
+        pObj->cause = LSA_CAUSE_NONE;
+
+        if(dropFrac < LSA_DROP_THRESHOLD
+            && pObj->busy < LSA_LINK_BUSY_LIMIT
+            && util < 0.95)
+            continue;
+
+        if(pObj->busy >= LSA_LINK_BUSY_LIMIT || util >= 0.95)
+        {
+            pObj->cause = LSA_CAUSE_SELF;
+        }
+        else
+        if(GetCoreLoad(pObj->procId) >= LSA_CORE_LOAD_LIMIT)
+        {
+            pObj->cause = LSA_CAUSE_CORE;
+        }
+        else
+        if(pObj->numOutEdges > 0 || gLinkStatsAnalyzer_obj.numEdges==0)
+        {
+            /* without topology downstream link is not known, causeLink is -1 */
+            pObj->cause = LSA_CAUSE_DOWNSTREAM;
+            pObj->causeLink = FindDownstreamBottleneck(i, &pathLatencyUs);
+
+            /* buffers needed to cover time they are held downstream */
+            pObj->occupancy = pObj->offeredFps * (pObj->latencyUs + pathLatencyUs) / 1000000.0;
+        }
+        else
+        {
+            /* sink link, drops are its own */
+            pObj->cause = LSA_CAUSE_SELF;
+        }
+
+        pObj->score += dropFrac;
+    }
+
+    /* blame downstream link for drops upstream */
+    for(i=0; i<gLinkStatsAnalyzer_obj.numLinks; i++)
+    {
+        pObj = &gLinkStatsAnalyzer_obj.link[i];
+
+        if(pObj->cause==LSA_CAUSE_DOWNSTREAM && pObj->causeLink >= 0)
+        {
+            gLinkStatsAnalyzer_obj.link[pObj->causeLink].score +=
+                pObj->dropFps / pObj->offeredFps;
+        }
+    }
+}
+
+/* Least loaded core of same class as procId, -1 if none */
+static int FindLeastLoadedCore(UInt32 procId)
+{
+    int i, best = -1;
+
+    for(i=0; i<LSA_MAX_CORES; i++)
+    {
+        if(i==(int)procId || !IsCoreValid(i)
+            || gLinkStatsAnalyzer_coreClass[i]!=gLinkStatsAnalyzer_coreClass[procId])
+            continue;
+
+        if(best<0 || gLinkStatsAnalyzer_obj.core[i].load < gLinkStatsAnalyzer_obj.core[best].load)
+            best = i;
+    }
+
+    return best;
+}
+
+/* Busiest link on a core, this is the best candidate to move */
+static int FindBusiestLink(UInt32 procId)
+{
+    int i, best = -1;
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numLinks; i++)
+    {
+        if(gLinkStatsAnalyzer_obj.link[i].procId!=procId)
+            continue;
+
+        if(best<0 || gLinkStatsAnalyzer_obj.link[i].busy > gLinkStatsAnalyzer_obj.link[best].busy)
+            best = i;
+    }
+
+    return best;
+}
+
+static void SuggestMove(LinkStatsAnalyzer_Link *pObj)
+{
+    int dstCore;
+    double busy;
+
+    busy = pObj->busy > 0 ? pObj->busy : 0;
+
+    dstCore = FindLeastLoadedCore(pObj->procId);
+    if(dstCore >= 0
+        && gLinkStatsAnalyzer_obj.core[dstCore].load + busy < LSA_CORE_LOAD_LIMIT)
+    {
+        printf("#   Move %s from %s to %s (load %.1f%%, link needs ~%.1f%%)\n",
+            pObj->name,
+            NetworkLinkStats_getProcName(pObj->procId),
+            NetworkLinkStats_getProcName(dstCore),
+            gLinkStatsAnalyzer_obj.core[dstCore].load*100,
+            busy*100);
+    }
+    else
+    {
+        printf("#   Reduce processing in %s on %s (optimize, lower resolution or frame rate), no other %s core has %.1f%% free load\n",
+            pObj->name,
+            NetworkLinkStats_getProcName(pObj->procId),
+            pObj->procId < LSA_MAX_CORES ?
+                gLinkStatsAnalyzer_coreClassName[gLinkStatsAnalyzer_coreClass[pObj->procId]] : "-",
+            busy*100);
+    }
+}
+
+/* Point out when a compute bound link spends its time outside processing */
+static void SuggestFramework(LinkStatsAnalyzer_Link *pObj)
+{
+    double total, framework;
+    UInt32 phase, maxPhase;
+
+    if(!pObj->hasPhase)
+        return;
+
+    total     = 0;
+    framework = 0;
+    maxPhase  = NETWORK_CTRL_LINK_STATS_PHASE_GET_BUF;
+
+    for(phase=0; phase<NETWORK_CTRL_LINK_STATS_PHASE_MAX; phase++)
+    {
+        total += pObj->phaseShare[phase];
+
+        if(phase==NETWORK_CTRL_LINK_STATS_PHASE_PROCESS)
+            continue;
+
+        framework += pObj->phaseShare[phase];
+        if(pObj->phaseShare[phase] > pObj->phaseShare[maxPhase])
+            maxPhase = phase;
+    }
+
+    if(total <= 0 || framework < total*LSA_FRAMEWORK_SHARE_LIMIT/2)
+        return;
+
+    printf("#   %.1f%% of %s time is outside processing, mostly in %s\n",
+        framework*100/total,
+        pObj->name,
+        NetworkLinkStats_getPhaseName(maxPhase));
+}
+
+static void Suggest(LinkStatsAnalyzer_Link *pObj)
+{
+    LinkStatsAnalyzer_Link *pCause;
+    int numBufs, recBufs, busiest;
+
+    switch(pObj->cause)
+    {
+        case LSA_CAUSE_SELF:
+            SuggestFramework(pObj);
+            SuggestMove(pObj);
+            break;
+
+        case LSA_CAUSE_CORE:
+            busiest = FindBusiestLink(pObj->procId);
+            if(busiest >= 0)
+            {
+                printf("#   %s is overloaded (%.1f%%), busiest link on it is %s\n",
+                    NetworkLinkStats_getProcName(pObj->procId),
+                    GetCoreLoad(pObj->procId)*100,
+                    gLinkStatsAnalyzer_obj.link[busiest].name);
+                SuggestMove(&gLinkStatsAnalyzer_obj.link[busiest]);
+            }
+            break;
+
+        case LSA_CAUSE_DOWNSTREAM:
+            numBufs = pObj->numBufs ? pObj->numBufs : LSA_DEFAULT_NUM_BUFS;
+            recBufs = (int)(pObj->occupancy*1.5 + 0.999) + 1;
+            if(recBufs <= numBufs)
+                recBufs = numBufs + 1;
+
+            if(pObj->causeLink >= 0)
+            {
+                pCause = &gLinkStatsAnalyzer_obj.link[pObj->causeLink];
+                printf("#   Buffers of %s are held by downstream %s@%s (%.1f%% of its limit)\n",
+                    pObj->name,
+                    pCause->name,
+                    NetworkLinkStats_getProcName(pCause->procId),
+                    GetPressure(pCause)*100);
+            }
+            else
+            {
+                printf("#   Buffers of %s are held downstream, specify --topology to find the link holding them\n",
+                    pObj->name);
+            }
+            printf("#   Increase output buffers of %s from %d%s to %d (%.1f buffers in flight)\n",
+                pObj->name,
+                numBufs,
+                pObj->numBufs ? "" : " (assumed)",
+                recBufs,
+                pObj->occupancy);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Links with same score keep snapshot order, so that report does not depend on qsort */
+static int CompareScore(const void *a, const void *b)
+{
+    double sa = gLinkStatsAnalyzer_obj.link[*(int*)a].score;
+    double sb = gLinkStatsAnalyzer_obj.link[*(int*)b].score;
+
+    if(sa > sb)
+        return -1;
+    if(sa < sb)
+        return 1;
+    return *(int*)a - *(int*)b;
+}
+
+/* CPU time of links which account phases, as % of their core */
+static void PrintPhaseReport(int *order)
+{
+    LinkStatsAnalyzer_Link *pObj;
+    double framework, total;
+    int rank, numLinks;
+    UInt32 phase;
+
+    numLinks = 0;
+
+    for(rank=0; rank<gLinkStatsAnalyzer_obj.numLinks; rank++)
+    {
+        pObj = &gLinkStatsAnalyzer_obj.link[order[rank]];
+
+        if(!pObj->hasPhase)
+            continue;
+
+        if(numLinks==0)
+        {
+            printf("# LINK                 CPU      ");
+            for(phase=0; phase<NETWORK_CTRL_LINK_STATS_PHASE_MAX; phase++)
+                printf("%8s ", NetworkLinkStats_getPhaseName(phase));
+            printf("FRAMEWORK\n");
+        }
+
+        framework = 0;
+        total     = 0;
+
+        printf("# %-20s %-8s ", pObj->name, NetworkLinkStats_getProcName(pObj->procId));
+        for(phase=0; phase<NETWORK_CTRL_LINK_STATS_PHASE_MAX; phase++)
+        {
+            printf("%7.2f%% ", pObj->phaseShare[phase]*100);
+
+            total += pObj->phaseShare[phase];
+            if(phase!=NETWORK_CTRL_LINK_STATS_PHASE_PROCESS)
+                framework += pObj->phaseShare[phase];
+        }
+
+        /* framework share of the time accounted for the link */
+        printf("%8.1f%%%s\n",
+            total > 0 ? framework*100/total : 0,
+            total > 0 && framework > total*LSA_FRAMEWORK_SHARE_LIMIT ? "  <-- MOSTLY MOVING BUFFERS" : "");
+
+        numLinks++;
+    }
+
+    if(numLinks)
+        printf("# \n");
+}
+
+void PrintReport()
+{
+    LinkStatsAnalyzer_Link *pObj, *pSrc, *pDst;
+    NetworkCtrl_LinkStatsHeader *pFirstHdr, *pLastHdr;
+    int order[LSA_MAX_LINKS];
+    int i, rank, numIssues;
+    char capStr[32], busyStr[32], bufStr[32], phaseStr[64];
+    LinkStatsAnalyzer_Core *pCore;
+
+    pFirstHdr = gLinkStatsAnalyzer_obj.first.pHeader;
+    pLastHdr  = gLinkStatsAnalyzer_obj.last.pHeader;
+
+    printf("# \n");
+    printf("# %d snapshots, analysis window %d ms%s\n",
+        gLinkStatsAnalyzer_obj.numSnapshots,
+        gLinkStatsAnalyzer_obj.numSnapshots > 1 ?
+            pLastHdr->timeInMsec - pFirstHdr->timeInMsec : pLastHdr->timeInMsec,
+        gLinkStatsAnalyzer_obj.numSnapshots > 1 ? "" : " (cumulative since stats reset)");
+    printf("# \n");
+
+    printf("# CORE     LOAD   PROCESS FRAMEWORK\n");
+    for(i=0; i<LSA_MAX_CORES; i++)
+    {
+        if(!IsCoreValid(i))
+            continue;
+
+        pCore = &gLinkStatsAnalyzer_obj.core[i];
+
+        if(pCore->processShare > 0 || pCore->frameworkShare > 0)
+            snprintf(phaseStr, sizeof(phaseStr), "%6.1f%% %8.1f%%",
+                pCore->processShare*100, pCore->frameworkShare*100);
+        else
+            snprintf(phaseStr, sizeof(phaseStr), "%7s %9s", "-", "-");
+
+        printf("# %-8s %5.1f%% %s%s\n",
+            NetworkLinkStats_getProcName(i),
+            pCore->load*100,
+            phaseStr,
+            pCore->load >= LSA_CORE_LOAD_LIMIT ? "  <-- SATURATED" : "");
+    }
+    printf("# \n");
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numLinks; i++)
+        order[i] = i;
+
+    qsort(order, gLinkStatsAnalyzer_obj.numLinks, sizeof(order[0]), CompareScore);
+
+    printf("# RANK LINK                 CPU      IN_FPS PROC_FPS DROP_FPS UDROP_FPS OUT_FPS  BUSY   CAP_FPS LAT_MS  BUFS       CAUSE\n");
+    for(rank=0; rank<gLinkStatsAnalyzer_obj.numLinks; rank++)
+    {
+        pObj = &gLinkStatsAnalyzer_obj.link[order[rank]];
+
+        if(pObj->busy >= 0)
+            snprintf(busyStr, sizeof(busyStr), "%5.1f%%", pObj->busy*100);
+        else
+            snprintf(busyStr, sizeof(busyStr), "%6s", "-");
+
+        if(pObj->capacityFps > 0)
+            snprintf(capStr, sizeof(capStr), "%8.1f", pObj->capacityFps);
+        else
+            snprintf(capStr, sizeof(capStr), "%8s", "-");
+
+        if(pObj->numBufs)
+            snprintf(bufStr, sizeof(bufStr), "%4.1f/%-4d", pObj->occupancy, pObj->numBufs);
+        else
+            snprintf(bufStr, sizeof(bufStr), "%4.1f/-   ", pObj->occupancy);
+
+        printf("# %4d %-20s %-8s %6.1f %8.1f %8.1f %9.1f %7.1f %s %s %6.2f %s %s%s\n",
+            rank+1,
+            pObj->name,
+            NetworkLinkStats_getProcName(pObj->procId),
+            pObj->inFps,
+            pObj->procFps,
+            pObj->dropFps,
+            pObj->userDropFps,
+            pObj->outFps,
+            busyStr,
+            capStr,
+            pObj->latencyUs/1000.0,
+            bufStr,
+            gLinkStatsAnalyzer_causeName[pObj->cause],
+            (gLinkStatsAnalyzer_obj.targetFps > 0 && pObj->capacityFps > 0
+                && pObj->capacityFps < gLinkStatsAnalyzer_obj.targetFps) ? " BELOW_TARGET" : "");
+    }
+    printf("# \n");
+
+    PrintPhaseReport(order);
+
+    numIssues = 0;
+
+    for(i=0; i<gLinkStatsAnalyzer_obj.numEdges; i++)
+    {
+        pSrc = &gLinkStatsAnalyzer_obj.link[gLinkStatsAnalyzer_obj.edgeSrc[i]];
+        pDst = &gLinkStatsAnalyzer_obj.link[gLinkStatsAnalyzer_obj.edgeDst[i]];
+
+        /* frames sent but not seen by the next link, for example lost in IPC */
+        if(pSrc->numOutEdges==1 && pDst->numInEdges==1
+            && pSrc->outFps > pDst->inFps*1.02 + 0.5)
+        {
+            printf("# %s@%s -> %s@%s: %.1f fps sent but only %.1f fps received\n",
+                pSrc->name, NetworkLinkStats_getProcName(pSrc->procId),
+                pDst->name, NetworkLinkStats_getProcName(pDst->procId),
+                pSrc->outFps, pDst->inFps);
+            numIssues++;
+        }
+    }
+
+    for(rank=0; rank<gLinkStatsAnalyzer_obj.numLinks; rank++)
+    {
+        pObj = &gLinkStatsAnalyzer_obj.link[order[rank]];
+
+        if(pObj->cause==LSA_CAUSE_NONE)
+            continue;
+
+        printf("# %s@%s: %.1f%% frames dropped, limited by %s\n",
+            pObj->name,
+            NetworkLinkStats_getProcName(pObj->procId),
+            pObj->offeredFps > 0 ? pObj->dropFps*100/pObj->offeredFps : 0,
+            gLinkStatsAnalyzer_causeName[pObj->cause]);
+
+        Suggest(pObj);
+        numIssues++;
+    }
+
+    if(gLinkStatsAnalyzer_obj.targetFps > 0)
+    {
+        for(rank=0; rank<gLinkStatsAnalyzer_obj.numLinks; rank++)
+        {
+            pObj = &gLinkStatsAnalyzer_obj.link[order[rank]];
+
+            if(pObj->cause!=LSA_CAUSE_NONE
+                || pObj->capacityFps <= 0
+                || pObj->capacityFps >= gLinkStatsAnalyzer_obj.targetFps)
+                continue;
+
+            printf("# %s@%s: can sustain ~%.1f fps, target is %.1f fps\n",
+                pObj->name,
+                NetworkLinkStats_getProcName(pObj->procId),
+                pObj->capacityFps,
+                gLinkStatsAnalyzer_obj.targetFps);
+            pObj->cause = LSA_CAUSE_SELF;
+            Suggest(pObj);
+            numIssues++;
+        }
+    }
+
+    if(numIssues==0)
+    {
+        printf("# No bottleneck found, most loaded link is %s@%s (%.1f%% of its limit)\n",
+            gLinkStatsAnalyzer_obj.numLinks ? gLinkStatsAnalyzer_obj.link[order[0]].name : "-",
+            gLinkStatsAnalyzer_obj.numLinks ?
+                NetworkLinkStats_getProcName(gLinkStatsAnalyzer_obj.link[order[0]].procId) : "-",
+            gLinkStatsAnalyzer_obj.numLinks ? gLinkStatsAnalyzer_obj.link[order[0]].score*100 : 0);
+    }
+    printf("# \n");
+}
+
+int main(int argc, char *argv[])
+{
+    ParseCmdLineArgs(argc, argv);
+
+    if(ReadSnapshots()!=0)
+        exit(0);
+
+    ComputeLinkStats();
+
+    if(ReadTopology()!=0)
+        exit(0);
+
+    Analyze();
+    PrintReport();
+
+    free(gLinkStatsAnalyzer_obj.pFirstBuf);
+    free(gLinkStatsAnalyzer_obj.pLastBuf);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#ifndef _LINK_STATS_ANALYZER_PRIV_H_
+#define _LINK_STATS_ANALYZER_PRIV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <osa.h>
+#include <networkCtrl_if.h>
+#include <network_link_stats.h>
+
+#define LSA_MAX_LINKS           (NETWORK_LINK_STATS_MAX_LINKS)
+#define LSA_MAX_EDGES           (256)
+#define LSA_MAX_CORES           (9)
+#define LSA_MAX_SNAPSHOT_SIZE   (512*KB)
+
+/* Link is considered compute bound above this fraction of its core */
+#define LSA_LINK_BUSY_LIMIT     (0.85)
+
+/* Core is considered saturated above this load */
+#define LSA_CORE_LOAD_LIMIT     (0.90)
+
+/* Drops below this fraction of input are ignored */
+#define LSA_DROP_THRESHOLD      (0.01)
+
+/* Link is flagged when framework phases take more than this fraction of its time */
+#define LSA_FRAMEWORK_SHARE_LIMIT   (0.50)
+
+/* Default number of output buffers assumed for a link when not specified */
+#define LSA_DEFAULT_NUM_BUFS    (4)
+
+typedef enum {
+
+    LSA_CAUSE_NONE = 0,
+    /* link is not limiting */
+
+    LSA_CAUSE_SELF,
+    /* link does not have enough compute time for its input rate */
+
+    LSA_CAUSE_CORE,
+    /* core on which link runs is saturated */
+
+    LSA_CAUSE_DOWNSTREAM
+    /* link drops because buffers are held by a downstream link */
+
+} LinkStatsAnalyzer_Cause;
+
+typedef struct {
+
+    char   name[NETWORK_CTRL_LINK_STATS_NAME_MAX];
+    UInt32 procId;
+    UInt32 linkId;
+
+    double inFps;
+    double procFps;
+    double dropFps;
+    double userDropFps;
+    double outFps;
+    double offeredFps;
+
+    double busy;
+    /* fraction of core time used by the link task, -1 if not known */
+
+    double capacityFps;
+    /* estimated max input rate the link can service, -1 if not known */
+
+    double latencyUs;
+    /* average time a frame spends in the link */
+
+    double occupancy;
+    /* average number of buffers held by the link, Little's law */
+
+    int    numBufs;
+    /* output buffers of the link, from topology file */
+
+    int    hasPhase;
+    double phaseShare[NETWORK_CTRL_LINK_STATS_PHASE_MAX];
+    /* fraction of core time spent in each phase, valid when hasPhase is set */
+
+    int    numOutEdges;
+    int    outEdge[LSA_MAX_EDGES];
+
+    int    numInEdges;
+    int    inEdge[LSA_MAX_EDGES];
+
+    LinkStatsAnalyzer_Cause cause;
+    int    causeLink;
+    /* link which is blamed for drops at this link */
+
+    double score;
+    /* higher score means more limiting */
+
+} LinkStatsAnalyzer_Link;
+
+typedef struct {
+
+    int    isValid;
+    double load;
+    /* 0..1, measured over same interval as link statistics */
+
+    double processShare;
+    double frameworkShare;
+    /* fraction of core time in process and in framework phases of links
+     * which account phases */
+
+} LinkStatsAnalyzer_Core;
+
+typedef struct {
+
+    char statsFile[1024];
+    char topologyFile[1024];
+
+    double targetFps;
+    /* 0 if not specified */
+
+    int numSnapshots;
+
+    UInt8 *pFirstBuf;
+    UInt8 *pLastBuf;
+
+    NetworkLinkStats_Snapshot first;
+    NetworkLinkStats_Snapshot last;
+
+    int numLinks;
+    LinkStatsAnalyzer_Link link[LSA_MAX_LINKS];
+
+    LinkStatsAnalyzer_Core core[LSA_MAX_CORES];
+
+    int numEdges;
+    int edgeSrc[LSA_MAX_EDGES];
+    int edgeDst[LSA_MAX_EDGES];
+
+} LinkStatsAnalyzer_Obj;
+
+extern LinkStatsAnalyzer_Obj gLinkStatsAnalyzer_obj;
+
+void ShowUsage();
+void ParseCmdLineArgs(int argc, char *argv[]);
+int  ReadSnapshots();
+void ComputeLinkStats();
+int  ReadTopology();
+void Analyze();
+void PrintReport();
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
+
@@ -0,0 +1,281 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Generates synthetic link statistics snapshots of the usecase in
+ * link_stats_pipeline.topo, in the format saved by
+ * 'network_ctrl --cmd link_stats bin'.
+ *
+ *   CAPTURE -> DUP -> IPC -> ALG_EDGE (DSP1)    -> IPC -> DISPLAY
+ *              DUP -> IPC -> ALG_FEATURE (EVE1) -> IPC -> NULL (A15)
+ *
+ * - CAPTURE drops as its buffers are held downstream
+ * - ALG_EDGE drops as DSP1 is saturated, DSP2 has room for it
+ * - ALG_FEATURE drops as it is compute bound, mostly in cache operations
+ * - IPC_OUT_1 -> IPC_IN_1 loses frames
+ * - NULL drops frames on purpose and is below 30 fps, its statistics are
+ *   reset between first and last snapshot
+ *
+ * link_stats_pipeline.bin has snapshots at 10, 15 and 20 secs,
+ * link_stats_single.bin only the one at 10 secs.
+ *
+ * gen_link_stats <output dir>
+ */
+
+#include <network_link_stats.h>
+
+#define GEN_MAX_CH          (2)
+#define GEN_BUF_SIZE        (64*KB)
+
+typedef struct {
+
+    UInt32 procId;
+    double load;
+    UInt32 flags;
+
+} Gen_Core;
+
+typedef struct {
+
+    char  *name;
+    UInt32 linkId;
+    UInt32 numCh;
+
+    double inFps;
+    double dropFps;
+    double userDropFps;
+    double procFps;
+    UInt32 numOut;
+    double outFps;
+    /* per channel and output queue */
+
+    double busy;
+    /* fraction of core time of link task, < 0 when link has no task */
+
+    double latencyMs;
+
+    double phase[NETWORK_CTRL_LINK_STATS_PHASE_MAX];
+    /* fraction of core time in each phase, all 0 when not accounted */
+
+    UInt32 resetTimeInMsec;
+    /* time when link statistics were reset */
+
+} Gen_Link;
+
+static Gen_Core gGen_core[] =
+{
+    { 0, 0.45, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* IPU1_0 */
+    { 1, 0.10, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* IPU1_1 */
+    { 2, 0.70, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* A15_0 */
+    { 3, 0.95, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* DSP1 */
+    { 4, 0.35, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* DSP2 */
+    { 5, 0.97, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* EVE1 */
+    { 6, 0.20, NETWORK_CTRL_LINK_STATS_CORE_FLAG_LOAD_VALID }, /* EVE2 */
+    { 7, 0.50, 0                                            }, /* EVE3, load not refreshed */
+};
+
+static Gen_Link gGen_link[] =
+{
+    /* name          linkId  ch  in    drop udrop proc  out outFps busy  lat   phases                            reset */
+    { "CAPTURE",     0x000,  2,  15.0, 1.5, 0.0,  13.5, 1,  13.5,  0.08,  1.0, { 0 },                             0     },
+    { "DUP",         0x001,  1,  27.0, 0.0, 0.0,  27.0, 2,  27.0,  0.03,  0.2, { 0 },                             0     },
+    { "IPC_OUT_0",   0x002,  1,  27.0, 0.0, 0.0,  27.0, 1,  27.0,  -1,    0.1, { 0 },                             0     },
+    { "IPC_IN_0",    0x300,  1,  27.0, 0.0, 0.0,  27.0, 1,  27.0,  -1,    0.1, { 0 },                             0     },
+    { "ALG_EDGE",    0x301,  1,  27.0, 2.0, 0.0,  25.0, 1,  25.0,  0.40, 30.0, { 0.01, 0.01, 0.04, 0.33, 0.01 },  0     },
+    { "IPC_OUT_1",   0x302,  1,  25.0, 0.0, 0.0,  25.0, 1,  25.0,  -1,    0.1, { 0 },                             0     },
+    { "IPC_IN_1",    0x003,  1,  23.0, 0.0, 0.0,  23.0, 1,  23.0,  -1,    0.1, { 0 },                             0     },
+    { "DISPLAY",     0x004,  1,  23.0, 0.0, 0.0,  23.0, 0,   0.0,  0.12, 16.0, { 0 },                             0     },
+    { "IPC_OUT_2",   0x005,  1,  27.0, 0.0, 0.0,  27.0, 1,  27.0,  -1,    0.1, { 0 },                             0     },
+    { "IPC_IN_2",    0x500,  1,  27.0, 0.0, 0.0,  27.0, 1,  27.0,  -1,    0.1, { 0 },                             0     },
+    { "ALG_FEATURE", 0x501,  1,  27.0, 7.0, 0.0,  20.0, 1,  20.0,  0.93, 45.0, { 0.03, 0.02, 0.40, 0.45, 0.03 },  0     },
+    { "IPC_OUT_3",   0x502,  1,  20.0, 0.0, 0.0,  20.0, 1,  20.0,  -1,    0.1, { 0 },                             0     },
+    { "IPC_IN_3",    0x200,  1,  20.0, 0.0, 0.0,  20.0, 1,  20.0,  -1,    0.1, { 0 },                             0     },
+    { "NULL",        0x201,  1,  20.0, 0.0, 5.0,  15.0, 0,   0.0,  0.55,  2.0, { 0 },                             16000 },
+};
+
+static UInt32 Gen_count(double fps, UInt32 timeInMsec)
+{
+    return (UInt32)(fps*timeInMsec/1000.0 + 0.5);
+}
+
+static void Gen_set64(UInt32 *pHi, UInt32 *pLo, UInt64 value)
+{
+    *pHi = (UInt32)(value >> 32);
+    *pLo = (UInt32)(value & 0xFFFFFFFFU);
+}
+
+/* Core and task times are in usecs since boot, link counters since reset */
+static UInt32 Gen_snapshot(UInt8 *pBuf, UInt32 timeInMsec)
+{
+    NetworkCtrl_LinkStatsHeader *pHeader;
+    NetworkCtrl_LinkStatsCore *pCore;
+    NetworkCtrl_LinkStatsTask *pTask;
+    NetworkCtrl_LinkStatsLink *pLink;
+    NetworkCtrl_LinkStatsCh *pCh;
+    Gen_Link *pGen;
+    UInt64 totalTime = (UInt64)timeInMsec*1000;
+    UInt32 i, ch, q, phase, elapsed, procCount;
+    UInt8 *pCur;
+
+    memset(pBuf, 0, GEN_BUF_SIZE);
+
+    pHeader = (NetworkCtrl_LinkStatsHeader *)pBuf;
+    pCur    = pBuf + sizeof(*pHeader);
+
+    pHeader->magic      = NETWORK_CTRL_LINK_STATS_MAGIC;
+    pHeader->version    = NETWORK_CTRL_LINK_STATS_VERSION;
+    pHeader->timeInMsec = timeInMsec;
+
+    for(i=0; i<sizeof(gGen_core)/sizeof(gGen_core[0]); i++)
+    {
+        pCore = (NetworkCtrl_LinkStatsCore *)pCur;
+
+        pCore->procId = gGen_core[i].procId;
+        pCore->flags  = gGen_core[i].flags;
+        Gen_set64(&pCore->totalTimeHi, &pCore->totalTimeLo, totalTime);
+        Gen_set64(&pCore->idleTimeHi, &pCore->idleTimeLo,
+            (UInt64)(totalTime*(1.0 - gGen_core[i].load)));
+
+        pCur += sizeof(*pCore);
+        pHeader->numCores++;
+    }
+
+    for(i=0; i<sizeof(gGen_link)/sizeof(gGen_link[0]); i++)
+    {
+        pGen = &gGen_link[i];
+
+        if(pGen->busy < 0)
+            continue;
+
+        pTask = (NetworkCtrl_LinkStatsTask *)pCur;
+
+        pTask->procId = (pGen->linkId >> 8) & 0xF;
+        strcpy(pTask->name, pGen->name);
+        Gen_set64(&pTask->totalTimeHi, &pTask->totalTimeLo,
+            (UInt64)(totalTime*pGen->busy));
+
+        pCur += sizeof(*pTask);
+        pHeader->numTasks++;
+    }
+
+    for(i=0; i<sizeof(gGen_link)/sizeof(gGen_link[0]); i++)
+    {
+        pGen = &gGen_link[i];
+        pLink = (NetworkCtrl_LinkStatsLink *)pCur;
+
+        elapsed = timeInMsec;
+        if(pGen->resetTimeInMsec && timeInMsec > pGen->resetTimeInMsec)
+            elapsed = timeInMsec - pGen->resetTimeInMsec;
+
+        procCount = Gen_count(pGen->procFps, elapsed)*pGen->numCh;
+
+        pLink->linkId            = pGen->linkId;
+        strcpy(pLink->name, pGen->name);
+        pLink->elapsedTimeInMsec = elapsed;
+        pLink->numCh             = pGen->numCh;
+
+        pLink->linkLatency.count = procCount;
+        Gen_set64(&pLink->linkLatency.accHi, &pLink->linkLatency.accLo,
+            (UInt64)(procCount*pGen->latencyMs*1000));
+        pLink->linkLatency.min   = (UInt32)(pGen->latencyMs*1000/2);
+        pLink->linkLatency.max   = (UInt32)(pGen->latencyMs*1000*2);
+
+        /* phase times are not cleared by statistics reset */
+        for(phase=0; phase<NETWORK_CTRL_LINK_STATS_PHASE_MAX; phase++)
+        {
+            if(pGen->phase[phase] <= 0)
+                continue;
+
+            pLink->phase[phase].count = Gen_count(pGen->procFps, timeInMsec);
+            Gen_set64(&pLink->phase[phase].timeHi, &pLink->phase[phase].timeLo,
+                (UInt64)(totalTime*pGen->phase[phase]));
+        }
+
+        pCur += sizeof(*pLink);
+
+        for(ch=0; ch<pGen->numCh; ch++)
+        {
+            pCh = (NetworkCtrl_LinkStatsCh *)pCur;
+
+            pCh->inBufRecvCount     = Gen_count(pGen->inFps, elapsed);
+            pCh->inBufDropCount     = Gen_count(pGen->dropFps, elapsed);
+            pCh->inBufUserDropCount = Gen_count(pGen->userDropFps, elapsed);
+            pCh->inBufProcessCount  = Gen_count(pGen->procFps, elapsed);
+            pCh->numOut             = pGen->numOut;
+
+            for(q=0; q<pGen->numOut; q++)
+                pCh->outBufCount[q] = Gen_count(pGen->outFps, elapsed);
+
+            pCur += sizeof(*pCh);
+        }
+
+        pHeader->numLinks++;
+    }
+
+    pHeader->totalSize = pCur - pBuf;
+
+    return pHeader->totalSize;
+}
+
+static int Gen_writeFile(char *dir, char *name, UInt32 *timeInMsec, int numSnapshots)
+{
+    static UInt8 buf[GEN_BUF_SIZE];
+    NetworkLinkStats_Snapshot snap;
+    char path[1024];
+    FILE *fp;
+    UInt32 size;
+    int i;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    fp = fopen(path, "wb");
+    if(fp==NULL)
+    {
+        printf("# ERROR: Unable to open file [%s]\n", path);
+        return -1;
+    }
+
+    for(i=0; i<numSnapshots; i++)
+    {
+        size = Gen_snapshot(buf, timeInMsec[i]);
+
+        /* same check as the analyzer does when reading the file */
+        if(NetworkLinkStats_parse(&snap, buf, size)!=OSA_SOK)
+        {
+            printf("# ERROR: Generated snapshot is not valid\n");
+            fclose(fp);
+            return -1;
+        }
+
+        fwrite(buf, 1, size, fp);
+    }
+
+    fclose(fp);
+
+    printf("# %s: %d snapshots\n", path, numSnapshots);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    UInt32 timeInMsec[] = { 10000, 15000, 20000 };
+
+    if(argc < 2)
+    {
+        printf("# gen_link_stats <output dir>\n");
+        return 1;
+    }
+
+    if(Gen_writeFile(argv[1], "link_stats_pipeline.bin", timeInMsec, 3)!=0
+        || Gen_writeFile(argv[1], "link_stats_single.bin", timeInMsec, 1)!=0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#!/bin/bash
+#
+# (c) Texas Instruments 2016
+#
+# Regression test of link_stats_analyzer on synthetic snapshots.
+#
+# run_testcases.sh [-b <dir with link_stats_analyzer>] [-u]
+#
+# Each case runs the analyzer on snapshots generated by gen_link_stats.c and
+# compares its report with <case>.expected. -u writes the reports to
+# <case>.expected instead, after an intended change of the report.
+#
+# To regenerate the snapshots after a change of the snapshot format
+#   gcc -I../../common/inc gen_link_stats.c ../../common/src/*.c -lpthread -o gen_link_stats
+#   ./gen_link_stats .
+#
+
+TEST_DIR=$(cd "$(dirname "$0")" && pwd)
+BIN_DIR=$TEST_DIR/../../bin
+UPDATE=0
+
+while getopts "b:u" opt; do
+    case $opt in
+        b) BIN_DIR=$OPTARG ;;
+        u) UPDATE=1 ;;
+        *) sed -n '2,16p' "$0"; exit 1 ;;
+    esac
+done
+
+LSA=
+for f in "$BIN_DIR/link_stats_analyzer" "$BIN_DIR/link_stats_analyzer.out" "$BIN_DIR/link_stats_analyzer.exe"; do
+    if [ -x "$f" ]; then
+        LSA=$f
+        break
+    fi
+done
+if [ -z "$LSA" ]; then
+    echo "# ERROR: link_stats_analyzer not found in $BIN_DIR, use -b <dir>"
+    exit 1
+fi
+
+FAILED=0
+
+run_case()
+{
+    NAME=$1
+    shift
+
+    OUT=$(cd "$TEST_DIR" && "$LSA" "$@")
+
+    if [ $UPDATE -eq 1 ]; then
+        echo "$OUT" > "$TEST_DIR/$NAME.expected"
+        echo "# $NAME: UPDATED"
+    elif echo "$OUT" | diff "$TEST_DIR/$NAME.expected" - ; then
+        echo "# $NAME: PASSED"
+    else
+        echo "# $NAME: FAILED"
+        FAILED=1
+    fi
+}
+
+run_case link_stats_pipeline --stats link_stats_pipeline.bin --topology link_stats_pipeline.topo --target-fps 30
+run_case link_stats_single   --stats link_stats_single.bin
+
+exit $FAILED
@@ -0,0 +1,371 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Benchmark of the NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED codec on recorded
+ * frames, e.g files saved by network_rx. Every frame is encoded and decoded,
+ * the decoded frame is checked to be same as the input and compression
+ * ratio and encode/decode throughput are reported.
+ */
+
+#include "network_codec_bench_priv.h"
+
+NetworkCodecBench_Obj gNetworkCodecBench_obj;
+
+void ShowUsage()
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# network_codec_bench --format <yuv420sp|yuv422i> --width <width> --height <height> [--pitch <pitch>]\n");
+    printf("#                     [--frames <frames per file>] [--iter <iterations>] --files <file> ...\n");
+    printf("# \n");
+    printf("#   --pitch   Pitch of lines in the file, default width for yuv420sp, 2*width for yuv422i\n");
+    printf("#   --frames  Frames to use from every file, 0: all (default 0)\n");
+    printf("#   --iter    Times every frame is encoded and decoded (default 1)\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2016\n");
+    printf("# \n");
+    exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    ParseCmdLineArgs(argc, argv);
+    Init();
+
+    for(i=0; i<gNetworkCodecBench_obj.numFiles; i++)
+    {
+        BenchFile(gNetworkCodecBench_obj.fileName[i]);
+    }
+
+    PrintStatistics();
+
+    DeInit();
+    return gNetworkCodecBench_obj.errorCount ? 1 : 0;
+}
+
+void Init()
+{
+    gNetworkCodecBench_obj.encBufSize = NetworkCodec_getMaxSize(
+                                    gNetworkCodecBench_obj.payloadType,
+                                    gNetworkCodecBench_obj.width,
+                                    gNetworkCodecBench_obj.height);
+
+    gNetworkCodecBench_obj.encBuf = malloc(gNetworkCodecBench_obj.encBufSize);
+    gNetworkCodecBench_obj.decBuf = malloc(gNetworkCodecBench_obj.frameSize);
+
+    if(gNetworkCodecBench_obj.encBuf==NULL || gNetworkCodecBench_obj.decBuf==NULL)
+    {
+        printf("# ERROR: Unable to allocate memory for buffers !!! \n");
+        exit(0);
+    }
+
+    gNetworkCodecBench_obj.minEncSize = (UInt32)-1;
+}
+
+void DeInit()
+{
+    free(gNetworkCodecBench_obj.encBuf);
+    free(gNetworkCodecBench_obj.decBuf);
+}
+
+int BenchFile(char *fileName)
+{
+    OSA_FileMapHndl fileMap;
+    Uint64 offset;
+    int frames;
+
+    if(OSA_fileMap(&fileMap, fileName)!=OSA_SOK)
+    {
+        printf("# ERROR: Unable to open file [%s]\n", fileName);
+        gNetworkCodecBench_obj.errorCount++;
+        return -1;
+    }
+
+    frames = 0;
+    for(offset=0;
+        offset + gNetworkCodecBench_obj.frameSize <= fileMap.size;
+        offset += gNetworkCodecBench_obj.frameSize)
+    {
+        if(gNetworkCodecBench_obj.maxFrames
+            &&
+           frames >= gNetworkCodecBench_obj.maxFrames)
+        {
+            break;
+        }
+
+        if(BenchFrame(fileMap.addr + offset)!=0)
+        {
+            printf("# ERROR: [%s] Frame%d: Decoded frame is not same as input !!!\n",
+                fileName, frames);
+            gNetworkCodecBench_obj.errorCount++;
+        }
+
+        frames++;
+    }
+
+    printf("# INFO: [%s] %d frames\n", fileName, frames);
+
+    OSA_fileUnmap(&fileMap);
+
+    return 0;
+}
+
+/* Planes of a frame are one after other in file and decode buffer */
+static void GetPlaneAddr(UInt8 *pFrame, UInt8 *addr[])
+{
+    addr[0] = pFrame;
+    addr[1] = pFrame + gNetworkCodecBench_obj.pitch[0]*gNetworkCodecBench_obj.height;
+}
+
+static int CompareFrame(UInt8 *pFrame, UInt8 *pDecFrame)
+{
+    UInt8 *srcAddr[NETWORK_CODEC_MAX_PLANES], *decAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 y, lineSize, numLines, plane, numPlanes;
+
+    GetPlaneAddr(pFrame, srcAddr);
+    GetPlaneAddr(pDecFrame, decAddr);
+
+    numPlanes = 1;
+    lineSize = gNetworkCodecBench_obj.width*2;
+    if(gNetworkCodecBench_obj.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        numPlanes = 2;
+        lineSize = gNetworkCodecBench_obj.width;
+    }
+
+    /* only 'width' of every line is coded, padding is not compared */
+    for(plane=0; plane<numPlanes; plane++)
+    {
+        numLines = plane==0 ? gNetworkCodecBench_obj.height : gNetworkCodecBench_obj.height/2;
+
+        for(y=0; y<numLines; y++)
+        {
+            if(memcmp(srcAddr[plane] + y*gNetworkCodecBench_obj.pitch[plane],
+                      decAddr[plane] + y*gNetworkCodecBench_obj.pitch[plane],
+                      lineSize)!=0)
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int BenchFrame(UInt8 *pFrame)
+{
+    UInt8 *srcAddr[NETWORK_CODEC_MAX_PLANES], *decAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 encSize;
+    Uint64 startTime;
+    int i, status;
+
+    GetPlaneAddr(pFrame, srcAddr);
+    GetPlaneAddr(gNetworkCodecBench_obj.decBuf, decAddr);
+
+    status = 0;
+
+    for(i=0; i<gNetworkCodecBench_obj.numIter && status==0; i++)
+    {
+        startTime = OSA_getCurTimeInUsec();
+
+        status = NetworkCodec_encode(
+                    gNetworkCodecBench_obj.payloadType,
+                    gNetworkCodecBench_obj.width,
+                    gNetworkCodecBench_obj.height,
+                    srcAddr,
+                    gNetworkCodecBench_obj.pitch,
+                    gNetworkCodecBench_obj.encBuf,
+                    gNetworkCodecBench_obj.encBufSize,
+                    &encSize);
+
+        gNetworkCodecBench_obj.encTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+        if(status!=0)
+            break;
+
+        startTime = OSA_getCurTimeInUsec();
+
+        status = NetworkCodec_decode(
+                    gNetworkCodecBench_obj.encBuf,
+                    encSize,
+                    gNetworkCodecBench_obj.payloadType,
+                    gNetworkCodecBench_obj.width,
+                    gNetworkCodecBench_obj.height,
+                    decAddr,
+                    gNetworkCodecBench_obj.pitch);
+
+        gNetworkCodecBench_obj.decTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+    }
+
+    if(status==0)
+    {
+        status = CompareFrame(pFrame, gNetworkCodecBench_obj.decBuf);
+    }
+
+    if(status==0)
+    {
+        gNetworkCodecBench_obj.totalFrames++;
+        gNetworkCodecBench_obj.rawSize += gNetworkCodecBench_obj.frameSize;
+        gNetworkCodecBench_obj.encSize += encSize;
+
+        if(encSize < gNetworkCodecBench_obj.minEncSize)
+            gNetworkCodecBench_obj.minEncSize = encSize;
+        if(encSize > gNetworkCodecBench_obj.maxEncSize)
+            gNetworkCodecBench_obj.maxEncSize = encSize;
+    }
+
+    return status;
+}
+
+void PrintStatistics()
+{
+    double rawMB, iterMB;
+
+    rawMB  = gNetworkCodecBench_obj.rawSize/(1024.0*1024);
+    iterMB = rawMB*gNetworkCodecBench_obj.numIter;
+
+    printf("# \n");
+    printf("# INFO: %d frames of %dx%d, %d errors\n",
+        gNetworkCodecBench_obj.totalFrames,
+        gNetworkCodecBench_obj.width,
+        gNetworkCodecBench_obj.height,
+        gNetworkCodecBench_obj.errorCount);
+
+    if(gNetworkCodecBench_obj.totalFrames==0)
+        return;
+
+    printf("# INFO: Raw %10.2f MB, compressed %10.2f MB, ratio %5.2f (frame %d .. %d bytes)\n",
+        rawMB,
+        gNetworkCodecBench_obj.encSize/(1024.0*1024),
+        gNetworkCodecBench_obj.encSize ? (double)gNetworkCodecBench_obj.rawSize/gNetworkCodecBench_obj.encSize : 0.0,
+        gNetworkCodecBench_obj.minEncSize,
+        gNetworkCodecBench_obj.maxEncSize);
+
+    printf("# INFO: Encode %8.2f MB/s, %8.2f fps\n",
+        gNetworkCodecBench_obj.encTimeInUsec ? iterMB/(gNetworkCodecBench_obj.encTimeInUsec/1000000.0) : 0.0,
+        gNetworkCodecBench_obj.encTimeInUsec ?
+            gNetworkCodecBench_obj.totalFrames*gNetworkCodecBench_obj.numIter/(gNetworkCodecBench_obj.encTimeInUsec/1000000.0)
+            : 0.0);
+
+    printf("# INFO: Decode %8.2f MB/s, %8.2f fps\n",
+        gNetworkCodecBench_obj.decTimeInUsec ? iterMB/(gNetworkCodecBench_obj.decTimeInUsec/1000000.0) : 0.0,
+        gNetworkCodecBench_obj.decTimeInUsec ?
+            gNetworkCodecBench_obj.totalFrames*gNetworkCodecBench_obj.numIter/(gNetworkCodecBench_obj.decTimeInUsec/1000000.0)
+            : 0.0);
+}
+
+void ParseCmdLineArgs(int argc, char *argv[])
+{
+    int i;
+    char *format = NULL;
+    UInt32 pitch = 0;
+
+    memset(&gNetworkCodecBench_obj, 0, sizeof(gNetworkCodecBench_obj));
+
+    gNetworkCodecBench_obj.numIter = 1;
+
+    for(i=1; i<argc; i++)
+    {
+        if(strcmp(argv[i], "--format")==0 && i+1<argc)
+        {
+            i++;
+            format = argv[i];
+        }
+        else
+        if(strcmp(argv[i], "--width")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCodecBench_obj.width = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--height")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCodecBench_obj.height = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--pitch")==0 && i+1<argc)
+        {
+            i++;
+            pitch = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--frames")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCodecBench_obj.maxFrames = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--iter")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCodecBench_obj.numIter = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--files")==0)
+        {
+            for(i++; i<argc && gNetworkCodecBench_obj.numFiles<MAX_FILES; i++)
+            {
+                gNetworkCodecBench_obj.fileName[gNetworkCodecBench_obj.numFiles] = argv[i];
+                gNetworkCodecBench_obj.numFiles++;
+            }
+        }
+        else
+        {
+            ShowUsage();
+        }
+    }
+
+    if(format && strcmp(format, "yuv420sp")==0)
+    {
+        gNetworkCodecBench_obj.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV;
+        if(pitch==0)
+            pitch = gNetworkCodecBench_obj.width;
+        if(pitch < gNetworkCodecBench_obj.width)
+            pitch = 0;
+    }
+    else
+    if(format && strcmp(format, "yuv422i")==0)
+    {
+        gNetworkCodecBench_obj.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV;
+        if(pitch==0)
+            pitch = gNetworkCodecBench_obj.width*2;
+        if(pitch < gNetworkCodecBench_obj.width*2)
+            pitch = 0;
+    }
+
+    if(gNetworkCodecBench_obj.payloadType==0
+        ||
+       gNetworkCodecBench_obj.width==0
+        ||
+       gNetworkCodecBench_obj.height==0
+        ||
+       pitch==0
+        ||
+       gNetworkCodecBench_obj.numIter<=0
+        ||
+       gNetworkCodecBench_obj.numFiles==0)
+    {
+        printf("# ERROR: Invalid or missing arguments\n");
+        ShowUsage();
+    }
+
+    /* same layout as network_rx writes, planes one after other */
+    gNetworkCodecBench_obj.pitch[0] = pitch;
+    gNetworkCodecBench_obj.pitch[1] = pitch;
+
+    gNetworkCodecBench_obj.frameSize = pitch*gNetworkCodecBench_obj.height;
+    if(gNetworkCodecBench_obj.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        gNetworkCodecBench_obj.frameSize += pitch*gNetworkCodecBench_obj.height/2;
+    }
+}
@@ -0,0 +1,90 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#ifndef _NETWORK_CODEC_BENCH_PRIV_H_
+#define _NETWORK_CODEC_BENCH_PRIV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <osa.h>
+#include <osa_file.h>
+#include <networkCtrl_if.h>
+#include <network_codec.h>
+
+#define MAX_FILES   (8)
+
+typedef struct {
+
+    UInt32 payloadType;
+    /**< NETWORK_RX_TYPE_VIDEO_FRAME_xxx of frames in the files */
+
+    UInt32 width;
+
+    UInt32 height;
+
+    UInt32 pitch[NETWORK_CODEC_MAX_PLANES];
+
+    UInt32 frameSize;
+    /**< Size of a frame in file, planes one after other */
+
+    int maxFrames;
+    /**< Frames to use from each file, 0: all */
+
+    int numIter;
+    /**< Times every frame is encoded and decoded */
+
+    int numFiles;
+
+    char *fileName[MAX_FILES];
+
+    UInt8 *encBuf;
+
+    UInt32 encBufSize;
+
+    UInt8 *decBuf;
+
+    int totalFrames;
+
+    int errorCount;
+
+    unsigned long long rawSize;
+
+    unsigned long long encSize;
+
+    UInt32 minEncSize;
+
+    UInt32 maxEncSize;
+
+    unsigned long long encTimeInUsec;
+
+    unsigned long long decTimeInUsec;
+
+} NetworkCodecBench_Obj;
+
+extern NetworkCodecBench_Obj gNetworkCodecBench_obj;
+
+void ShowUsage();
+void ParseCmdLineArgs(int argc, char *argv[]);
+void Init();
+void DeInit();
+
+int  BenchFile(char *fileName);
+int  BenchFrame(UInt8 *pFrame);
+void PrintStatistics();
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
@@ -0,0 +1,429 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Chunked transfers, see NetworkCtrl_ChunkHeader. Data is streamed to or
+ * from file one chunk at a time, so memory needed is one chunk irrespective
+ * of transfer size. Every chunk is a separate command on the same connection,
+ * a chunk with CRC mismatch is requested or sent again.
+ *
+ * An interrupted transfer is continued with --resume, downloads continue
+ * after the data already in the output file, uploads continue from the
+ * offset target reports for the same transfer.
+ */
+
+#include "network_ctrl_priv.h"
+#include <osa_file.h>
+
+typedef struct {
+
+    char *command;
+
+    UInt32 startOffset;
+
+    UInt32 totalSize;
+
+    Uint64 startTime;
+
+    Uint64 lastPrintTime;
+
+} ChunkProgress;
+
+static void ChunkProgressStart(ChunkProgress *pProgress, char *command, UInt32 startOffset, UInt32 totalSize)
+{
+    pProgress->command = command;
+    pProgress->startOffset = startOffset;
+    pProgress->totalSize = totalSize;
+    pProgress->startTime = OSA_getCurTimeInUsec();
+    pProgress->lastPrintTime = pProgress->startTime;
+
+    if(startOffset)
+    {
+        printf("# Command %s: Resuming at %d of %d bytes\n", command, startOffset, totalSize);
+    }
+}
+
+static void ChunkProgressUpdate(ChunkProgress *pProgress, UInt32 offset, Bool isFinal)
+{
+    Uint64 curTime, elapsed;
+    double mbps;
+
+    curTime = OSA_getCurTimeInUsec();
+
+    if(!isFinal
+        &&
+       curTime - pProgress->lastPrintTime < NETWORK_CTRL_PROGRESS_INTERVAL_MSEC*1000)
+    {
+        return;
+    }
+
+    pProgress->lastPrintTime = curTime;
+
+    elapsed = curTime - pProgress->startTime;
+
+    mbps = 0;
+    if(elapsed)
+    {
+        mbps = (double)(offset - pProgress->startOffset)/elapsed;
+    }
+
+    printf("# Command %s: %8.2f of %8.2f MB (%3d%%), %7.2f MB/s%s\n",
+        pProgress->command,
+        (double)offset/MB,
+        (double)pProgress->totalSize/MB,
+        pProgress->totalSize ? (int)(((Uint64)offset*100)/pProgress->totalSize) : 100,
+        mbps*1000000/MB,
+        isFinal ? ", DONE" : ""
+        );
+    fflush(stdout);
+}
+
+static void ChunkDropData(char *command, UInt8 *pBuf, UInt32 bufSize, UInt32 dataSize)
+{
+    UInt32 readSize;
+
+    while(dataSize)
+    {
+        readSize = dataSize < bufSize ? dataSize : bufSize;
+
+        RecvResponseParams(command, pBuf, readSize);
+
+        dataSize -= readSize;
+    }
+}
+
+/* Sends chunk command and receives the chunk header of the response.
+ * Returns command return value, *pDataSize is set to the data bytes which
+ * follow the chunk header. Returns -1 with *pDataSize as 0 when target does
+ * not support the command.
+ */
+static int ChunkCommand(char *command,
+                        void *pPrm, UInt32 prmSize,
+                        NetworkCtrl_ChunkHeader *pRsp,
+                        UInt32 *pDataSize)
+{
+    int status;
+    UInt32 rspSize = 0;
+
+    *pDataSize = 0;
+
+    SendCommand(command, pPrm, prmSize);
+    status = RecvResponse(command, &rspSize);
+
+    if(rspSize < sizeof(*pRsp))
+    {
+        /* unsupported command or invalid response, no chunk header */
+        memset(pRsp, 0, sizeof(*pRsp));
+        if(rspSize)
+        {
+            RecvResponseParams(command, (UInt8*)pRsp, rspSize);
+        }
+        return -1;
+    }
+
+    RecvResponseParams(command, (UInt8*)pRsp, sizeof(*pRsp));
+
+    *pDataSize = rspSize - sizeof(*pRsp);
+
+    return status;
+}
+
+/* Returns 0 on success, -1 if target does not support 'command' */
+int ChunkDownload(char *command, UInt32 addr, UInt32 totalSize, char *fileName)
+{
+    NetworkCtrl_ChunkHeader req, rsp;
+    ChunkProgress progress;
+    FILE *fd = NULL;
+    UInt8 *pBuf;
+    UInt32 offset, dataSize;
+    Uint64 fileSize;
+    int status, retry;
+
+    offset = 0;
+
+    if(gNetworkCtrl_obj.isResume
+        &&
+       OSA_fileGetSize(fileName, &fileSize)==OSA_SOK)
+    {
+        fd = fopen(fileName, "r+b");
+        if(fd)
+        {
+            offset = fileSize < totalSize ? (UInt32)fileSize : totalSize;
+            fseek(fd, offset, SEEK_SET);
+        }
+    }
+
+    if(fd==NULL)
+    {
+        fd = fopen(fileName, "wb");
+    }
+
+    if(fd==NULL)
+    {
+        printf("# ERROR: Command %s: Unable to open file [%s]\n", command, fileName);
+        exit(0);
+    }
+
+    pBuf = malloc(gNetworkCtrl_obj.chunkSize);
+    if(pBuf==NULL)
+    {
+        printf("# ERROR: Command %s: Unable to allocate memory for chunk\n", command);
+        exit(0);
+    }
+
+    gNetworkCtrl_obj.isKeepConnection = TRUE;
+    gNetworkCtrl_obj.isQuiet = TRUE;
+
+    ChunkProgressStart(&progress, command, offset, totalSize);
+
+    status = 0;
+    retry = 0;
+
+    while(offset < totalSize)
+    {
+        req.addr = addr;
+        req.totalSize = totalSize;
+        req.offset = offset;
+        req.size = totalSize - offset;
+        if(req.size > gNetworkCtrl_obj.chunkSize)
+            req.size = gNetworkCtrl_obj.chunkSize;
+        req.crc = 0;
+        req.flags = gNetworkCtrl_obj.isChunkCrc ? NETWORK_CTRL_CHUNK_FLAG_CRC : 0;
+
+        status = ChunkCommand(command, &req, sizeof(req), &rsp, &dataSize);
+
+        if(status != 0 || dataSize != req.size)
+        {
+            ChunkDropData(command, pBuf, gNetworkCtrl_obj.chunkSize, dataSize);
+
+            if(status == -1 && dataSize == 0 && rsp.totalSize == 0)
+            {
+                /* not supported, caller falls back to single command */
+                break;
+            }
+
+            printf("# ERROR: Command %s: Target failed to send chunk @ %d of %d bytes\n",
+                command, req.offset, req.size);
+            exit(0);
+        }
+
+        RecvResponseParams(command, pBuf, dataSize);
+
+        if(gNetworkCtrl_obj.isChunkCrc && OSA_crc32(pBuf, dataSize) != rsp.crc)
+        {
+            printf("# WARNING: Command %s: CRC mismatch for chunk @ %d of %d bytes\n",
+                command, req.offset, req.size);
+
+            retry++;
+            if(retry > NETWORK_CTRL_CHUNK_MAX_RETRY)
+            {
+                printf("# ERROR: Command %s: Giving up after %d retries, continue with --resume\n",
+                    command, NETWORK_CTRL_CHUNK_MAX_RETRY);
+                exit(0);
+            }
+
+            ReconnectIfClosed();
+            continue;
+        }
+
+        if(fwrite(pBuf, 1, dataSize, fd) != dataSize)
+        {
+            printf("# ERROR: Command %s: Unable to write file [%s]\n", command, fileName);
+            exit(0);
+        }
+
+        /* data upto offset is on disk, even if the transfer is interrupted */
+        fflush(fd);
+
+        offset += dataSize;
+        retry = 0;
+
+        ChunkProgressUpdate(&progress, offset, FALSE);
+
+        ReconnectIfClosed();
+    }
+
+    gNetworkCtrl_obj.isKeepConnection = FALSE;
+    gNetworkCtrl_obj.isQuiet = FALSE;
+
+    fclose(fd);
+    free(pBuf);
+
+    if(offset < totalSize)
+    {
+        ReconnectIfClosed();
+        return -1;
+    }
+
+    ChunkProgressUpdate(&progress, offset, TRUE);
+
+    return 0;
+}
+
+/* Data sent is pPrefix followed by contents of fileName. Chunks other than
+ * the last one are multiple of chunkAlign bytes.
+ *
+ * Returns 0 on success, -1 if target does not support 'command'
+ */
+int ChunkUpload(char *command, UInt32 addr, UInt8 *pPrefix, UInt32 prefixSize, char *fileName, UInt32 chunkAlign)
+{
+    NetworkCtrl_ChunkHeader req, rsp, *pReq;
+    ChunkProgress progress;
+    FILE *fd;
+    UInt8 *pBuf, *pData;
+    UInt32 offset, totalSize, chunkSize, dataSize, copySize;
+    Uint64 fileSize;
+    int status, retry;
+
+    if(OSA_fileGetSize(fileName, &fileSize)!=OSA_SOK
+        ||
+       fileSize + prefixSize > (UInt32)-1)
+    {
+        printf("# ERROR: Command %s: Unable to read file [%s]\n", command, fileName);
+        exit(0);
+    }
+
+    totalSize = (UInt32)fileSize + prefixSize;
+
+    chunkSize = OSA_floor(gNetworkCtrl_obj.chunkSize, chunkAlign);
+    if(chunkSize == 0)
+        chunkSize = chunkAlign;
+
+    fd = fopen(fileName, "rb");
+    if(fd==NULL)
+    {
+        printf("# ERROR: Command %s: Unable to open file [%s]\n", command, fileName);
+        exit(0);
+    }
+
+    pBuf = malloc(sizeof(NetworkCtrl_ChunkHeader) + chunkSize);
+    if(pBuf==NULL)
+    {
+        printf("# ERROR: Command %s: Unable to allocate memory for chunk\n", command);
+        exit(0);
+    }
+
+    pReq = (NetworkCtrl_ChunkHeader*)pBuf;
+    pData = pBuf + sizeof(NetworkCtrl_ChunkHeader);
+
+    gNetworkCtrl_obj.isKeepConnection = TRUE;
+    gNetworkCtrl_obj.isQuiet = TRUE;
+
+    /* query offset of transfer in progress, this also finds if target
+     * supports chunked transfers
+     */
+    memset(&req, 0, sizeof(req));
+    req.addr = addr;
+    req.totalSize = totalSize;
+    req.flags = NETWORK_CTRL_CHUNK_FLAG_QUERY;
+
+    status = ChunkCommand(command, &req, sizeof(req), &rsp, &dataSize);
+
+    ReconnectIfClosed();
+
+    if(status != 0 || dataSize != 0)
+    {
+        gNetworkCtrl_obj.isKeepConnection = FALSE;
+        gNetworkCtrl_obj.isQuiet = FALSE;
+
+        fclose(fd);
+        free(pBuf);
+
+        return -1;
+    }
+
+    offset = 0;
+    if(gNetworkCtrl_obj.isResume && rsp.offset <= totalSize)
+    {
+        offset = rsp.offset;
+    }
+
+    ChunkProgressStart(&progress, command, offset, totalSize);
+
+    retry = 0;
+
+    while(offset < totalSize)
+    {
+        pReq->addr = addr;
+        pReq->totalSize = totalSize;
+        pReq->offset = offset;
+        pReq->size = totalSize - offset;
+        if(pReq->size > chunkSize)
+            pReq->size = chunkSize;
+        pReq->flags = gNetworkCtrl_obj.isChunkCrc ? NETWORK_CTRL_CHUNK_FLAG_CRC : 0;
+
+        /* chunk data, prefix first and then file */
+        dataSize = 0;
+        if(offset < prefixSize)
+        {
+            copySize = prefixSize - offset;
+            if(copySize > pReq->size)
+                copySize = pReq->size;
+
+            memcpy(pData, pPrefix + offset, copySize);
+            dataSize = copySize;
+        }
+
+        if(dataSize < pReq->size)
+        {
+            copySize = pReq->size - dataSize;
+
+            if(fseek(fd, offset + dataSize - prefixSize, SEEK_SET)!=0
+                ||
+               fread(pData + dataSize, 1, copySize, fd) != copySize)
+            {
+                printf("# ERROR: Command %s: Unable to read file [%s]\n", command, fileName);
+                exit(0);
+            }
+        }
+
+        pReq->crc = 0;
+        if(gNetworkCtrl_obj.isChunkCrc)
+        {
+            pReq->crc = OSA_crc32(pData, pReq->size);
+        }
+
+        status = ChunkCommand(command, pBuf, sizeof(*pReq) + pReq->size, &rsp, &dataSize);
+
+        ReconnectIfClosed();
+
+        if(status != 0 || rsp.offset != offset + pReq->size)
+        {
+            /* rejected, continue from where target expects */
+            printf("# WARNING: Command %s: Chunk @ %d of %d bytes not accepted, target expects offset %d\n",
+                command, pReq->offset, pReq->size, rsp.offset);
+
+            retry++;
+            if(retry > NETWORK_CTRL_CHUNK_MAX_RETRY || rsp.offset > totalSize)
+            {
+                printf("# ERROR: Command %s: Giving up after %d retries\n",
+                    command, retry);
+                exit(0);
+            }
+
+            offset = rsp.offset;
+            continue;
+        }
+
+        offset = rsp.offset;
+        retry = 0;
+
+        ChunkProgressUpdate(&progress, offset, FALSE);
+    }
+
+    gNetworkCtrl_obj.isKeepConnection = FALSE;
+    gNetworkCtrl_obj.isQuiet = FALSE;
+
+    fclose(fd);
+    free(pBuf);
+
+    ChunkProgressUpdate(&progress, offset, TRUE);
+
+    return 0;
+}
@@ -11,10 +11,14 @@
 
 
 void handleEcho()
+{
+    SendCommand(gNetworkCtrl_obj.command, gNetworkCtrl_obj.params[0], strlen(gNetworkCtrl_obj.params[0])+1);
+}
+
+void handleEchoResponse()
 {
     UInt32 prmSize;
 
-    SendCommand(gNetworkCtrl_obj.command, gNetworkCtrl_obj.params[0], strlen(gNetworkCtrl_obj.params[0])+1);
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 }
 
@@ -111,6 +111,22 @@ void handleIssSendDccFile()
     Int32 status;
     UInt32 size;
 
+    if(gNetworkCtrl_obj.chunkSize)
+    {
+        if(ChunkUpload(
+                "iss_send_dcc_file_chunk",
+                0,
+                NULL,
+                0,
+                gNetworkCtrl_obj.params[0],
+                1)==0)
+        {
+            return;
+        }
+
+        printf("# Command %s: Target does not support chunked transfer\n", gNetworkCtrl_obj.command);
+    }
+
     status = OSA_fileReadFile(
         gNetworkCtrl_obj.params[0],
         pDccDataBuf,
@@ -132,6 +148,33 @@ void handleIssSaveDccFile()
 
     pDccBuf = (UInt32 *)pDccDataBuf;
 
+    if(gNetworkCtrl_obj.chunkSize)
+    {
+        Uint64 fileSize;
+        UInt32 dccHeader[NETWORKCTRL_ISS_DCC_BIN_HEADER_SIZE/4];
+
+        /* header is same as below, it is sent ahead of file data */
+        OSA_fileGetSize(gNetworkCtrl_obj.params[1], &fileSize);
+
+        dccHeader[0] = NETWORKCTRL_ISS_DCC_BIN_TAG_ID;
+        dccHeader[1] = (UInt32)fileSize;
+        dccHeader[2] = (UInt32)atoi(gNetworkCtrl_obj.params[0]);
+        dccHeader[3] = 0U;
+
+        if(ChunkUpload(
+                "iss_save_dcc_file_chunk",
+                dccHeader[2],
+                (UInt8*)dccHeader,
+                sizeof(dccHeader),
+                gNetworkCtrl_obj.params[1],
+                1)==0)
+        {
+            return;
+        }
+
+        printf("# Command %s: Target does not support chunked transfer\n", gNetworkCtrl_obj.command);
+    }
+
     /* First four word contains header information, so actual
        buffer is stored after four words */
     status = OSA_fileReadFile(
@@ -186,18 +229,31 @@ void handleIssSensorRegWrite()
 
     SendCommand(gNetworkCtrl_obj.command, prms,
                 sizeof(prms));
+}
+
+void handleIssSensorRegWriteResponse()
+{
     RecvResponse(gNetworkCtrl_obj.command, NULL);
 }
 
 void handleIssSensorRegRead()
 {
-    UInt32 prms[2], prmSize, readValue;
+    UInt32 prms[2];
 
     prms[0] = atoi(gNetworkCtrl_obj.params[0]); /* Channel number */
     prms[1] = strtol(gNetworkCtrl_obj.params[1], NULL, 0); /* Register Address */
 
     SendCommand(gNetworkCtrl_obj.command, prms,
                 sizeof(prms));
+}
+
+void handleIssSensorRegReadResponse()
+{
+    UInt32 prms[2], prmSize, readValue;
+
+    prms[0] = atoi(gNetworkCtrl_obj.params[0]); /* Channel number */
+    prms[1] = strtol(gNetworkCtrl_obj.params[1], NULL, 0); /* Register Address */
+
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 
     if (prmSize)
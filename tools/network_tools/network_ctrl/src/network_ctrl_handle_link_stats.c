@@ -0,0 +1,165 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#include "network_ctrl_priv.h"
+#include <network_link_stats.h>
+
+/*
+ * link_stats <csv|prom|bin> <output file, - for console> <interval in msec> <count>
+ *
+ * csv  - snapshots are decoded and appended to the file
+ * prom - file is re-written with the latest snapshot in Prometheus text
+ *        format, for use with a textfile collector
+ * bin  - raw snapshots are appended back to back to the file, these can
+ *        be decoded later or given to the link stats analyzer
+ *
+ * count of 0 polls forever. Core load is refreshed on every poll, which
+ * takes up to 500 msecs and at most 1 sec on target, so the interval
+ * should be more than that.
+ */
+void handleLinkStats()
+{
+    UInt32 prm[1];
+    UInt32 prmSize = 0;
+    UInt8 *pBuf = NULL;
+    UInt32 bufSize = 0;
+    UInt32 interval, count, i, totalBytes, startTime, elapsed;
+    char *format, *fileName;
+    int isConsole, isBin, isProm;
+    FILE *fp = NULL;
+    NetworkLinkStats_Snapshot snap;
+
+    format   = gNetworkCtrl_obj.params[0];
+    fileName = gNetworkCtrl_obj.params[1];
+    interval = atoi(gNetworkCtrl_obj.params[2]);
+    count    = atoi(gNetworkCtrl_obj.params[3]);
+
+    isBin  = (strcmp(format, "bin")==0);
+    isProm = (strcmp(format, "prom")==0);
+    if(!isBin && !isProm && strcmp(format, "csv")!=0)
+    {
+        printf("# ERROR: Command %s: Unsupported format [%s], must be csv, prom or bin\n", gNetworkCtrl_obj.command, format);
+        exit(0);
+    }
+
+    isConsole = (strcmp(fileName, "-")==0);
+    if(isBin && isConsole)
+    {
+        printf("# ERROR: Command %s: bin format needs an output file\n", gNetworkCtrl_obj.command);
+        exit(0);
+    }
+
+    if(isConsole)
+    {
+        fp = stdout;
+        if(!isProm)
+        {
+            NetworkLinkStats_writeCsvHeader(fp);
+        }
+    }
+    else
+    if(!isProm)
+    {
+        fp = fopen(fileName, isBin ? "ab" : "a");
+        if(fp==NULL)
+        {
+            printf("# ERROR: Command %s: Unable to open file [%s]\n", gNetworkCtrl_obj.command, fileName);
+            exit(0);
+        }
+        fseek(fp, 0, SEEK_END);
+        if(!isBin && ftell(fp)==0)
+        {
+            NetworkLinkStats_writeCsvHeader(fp);
+        }
+    }
+
+    totalBytes = 0;
+    startTime = OSA_getCurTimeInMsec();
+
+    for(i=0; count==0 || i<count; i++)
+    {
+        if(i>0)
+        {
+            /* target closes the connection after each command */
+            CloseConnection();
+            OSA_waitMsecs(interval);
+            ConnectToServer();
+        }
+
+        prm[0] = 1; /* refresh core load */
+
+        SendCommand(gNetworkCtrl_obj.command, prm, sizeof(prm));
+        RecvResponse(gNetworkCtrl_obj.command, &prmSize);
+
+        if(prmSize==0)
+            continue;
+
+        if(prmSize > bufSize)
+        {
+            free(pBuf);
+            bufSize = prmSize;
+            pBuf = malloc(bufSize);
+            if(pBuf==NULL)
+            {
+                printf("# ERROR: Command %s: Unable to allocate memory for response parameters\n", gNetworkCtrl_obj.command);
+                exit(0);
+            }
+        }
+
+        RecvResponseParams(gNetworkCtrl_obj.command, pBuf, prmSize);
+
+        totalBytes += prmSize;
+
+        if(NetworkLinkStats_parse(&snap, pBuf, prmSize)!=OSA_SOK)
+            continue;
+
+        if(isBin)
+        {
+            fwrite(pBuf, 1, prmSize, fp);
+            fflush(fp);
+        }
+        else
+        if(isProm && !isConsole)
+        {
+            fp = fopen(fileName, "w");
+            if(fp==NULL)
+            {
+                printf("# ERROR: Command %s: Unable to open file [%s]\n", gNetworkCtrl_obj.command, fileName);
+                exit(0);
+            }
+            NetworkLinkStats_write(fp, &snap, NETWORK_LINK_STATS_FORMAT_PROM);
+            fclose(fp);
+            fp = NULL;
+        }
+        else
+        {
+            NetworkLinkStats_write(fp, &snap,
+                isProm ? NETWORK_LINK_STATS_FORMAT_PROM : NETWORK_LINK_STATS_FORMAT_CSV);
+        }
+
+        elapsed = OSA_getCurTimeInMsec() - startTime;
+        if(elapsed==0)
+            elapsed = 1;
+
+        printf("# Command %s: Snapshot %d: %d links, %d bytes, avg %d bytes/sec\n",
+            gNetworkCtrl_obj.command,
+            i,
+            snap.pHeader->numLinks,
+            prmSize,
+            (UInt32)(((UInt64)totalBytes*1000)/elapsed)
+            );
+    }
+
+    if(fp!=NULL && fp!=stdout)
+    {
+        fclose(fp);
+    }
+
+    free(pBuf);
+}
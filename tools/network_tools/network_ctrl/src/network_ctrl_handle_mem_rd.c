@@ -13,15 +13,20 @@
 void handleMemRd()
 {
     UInt32 prm[2];
-    UInt32 *pMem;
-    UInt32 addr;
-    int i;
-    UInt32 prmSize = 0;
 
     prm[0] = xstrtoi(gNetworkCtrl_obj.params[0]);
     prm[1] = atoi(gNetworkCtrl_obj.params[1])*sizeof(UInt32);
 
     SendCommand(gNetworkCtrl_obj.command, prm, sizeof(prm));
+}
+
+void handleMemRdResponse()
+{
+    UInt32 *pMem;
+    UInt32 addr;
+    int i;
+    UInt32 prmSize = 0;
+
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 
     if(prmSize)
@@ -35,7 +40,7 @@ void handleMemRd()
 
         RecvResponseParams(gNetworkCtrl_obj.command, (UInt8*)pMem, prmSize);
 
-        addr = prm[0];
+        addr = xstrtoi(gNetworkCtrl_obj.params[0]);
         printf("# \n");
         for(i=0; i<prmSize/sizeof(UInt32); i++)
         {
@@ -44,23 +49,30 @@ void handleMemRd()
             addr += sizeof(UInt32);
         }
         printf("# \n");
+
+        free(pMem);
     }
 }
 
 void handleMemWr()
 {
     UInt32 prm[2];
-    UInt32 prmSize = 0;
 
     prm[0] = xstrtoi(gNetworkCtrl_obj.params[0]);
     prm[1] = xstrtoi(gNetworkCtrl_obj.params[1]);
 
     SendCommand(gNetworkCtrl_obj.command, prm, sizeof(prm));
+}
+
+void handleMemWrResponse()
+{
+    UInt32 prmSize = 0;
+
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 
     if (0 == prmSize)
     {
         printf ("# Successfully writen Value 0x%x at address 0x%x #\n",
-            prm[1], prm[0]);
+            xstrtoi(gNetworkCtrl_obj.params[1]), xstrtoi(gNetworkCtrl_obj.params[0]));
     }
 }
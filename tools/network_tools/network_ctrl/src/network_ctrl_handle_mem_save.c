@@ -19,6 +19,16 @@ void handleMemSave()
     prm[0] = xstrtoi(gNetworkCtrl_obj.params[0]);
     prm[1] = atoi(gNetworkCtrl_obj.params[1]);
 
+    if(gNetworkCtrl_obj.chunkSize)
+    {
+        if(ChunkDownload("mem_save_chunk", prm[0], prm[1], gNetworkCtrl_obj.params[2])==0)
+        {
+            return;
+        }
+
+        printf("# Command %s: Target does not support chunked transfer\n", gNetworkCtrl_obj.command);
+    }
+
     SendCommand(gNetworkCtrl_obj.command, prm, sizeof(prm));
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 
@@ -34,6 +44,8 @@ void handleMemSave()
         RecvResponseParams(gNetworkCtrl_obj.command, (UInt8*)pMem, prmSize);
 
         OSA_fileWriteFile(gNetworkCtrl_obj.params[2], (UInt8*)pMem, prmSize);
+
+        free(pMem);
     }
 }
 
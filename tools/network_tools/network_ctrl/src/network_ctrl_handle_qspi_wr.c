@@ -12,6 +12,9 @@
 
 #define NETWORKCTRL_APP_IMAGE_FILE_SIZE   (32*1024*1024U)
 
+/* QSPI flash block size on target, chunks start at a block boundary */
+#define NETWORKCTRL_QSPI_FLASH_BLOCK_SIZE (64*1024U)
+
 UInt32   pDataBuf[NETWORKCTRL_APP_IMAGE_FILE_SIZE];
 
 void handleQspiSendFile()
@@ -19,6 +22,22 @@ void handleQspiSendFile()
     Int32 status;
     UInt32 size;
 
+    if(gNetworkCtrl_obj.chunkSize)
+    {
+        if(ChunkUpload(
+                "qspi_wr_chunk",
+                xstrtoi(gNetworkCtrl_obj.params[0]),
+                NULL,
+                0,
+                gNetworkCtrl_obj.params[1],
+                NETWORKCTRL_QSPI_FLASH_BLOCK_SIZE)==0)
+        {
+            return;
+        }
+
+        printf("# Command %s: Target does not support chunked transfer\n", gNetworkCtrl_obj.command);
+    }
+
     status = OSA_fileReadFile(
         gNetworkCtrl_obj.params[1],
         (UInt8 *)(pDataBuf + 1U),
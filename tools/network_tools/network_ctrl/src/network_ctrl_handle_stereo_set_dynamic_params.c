@@ -28,7 +28,6 @@ typedef struct
 void handleStereoSetDynamicParams()
 {
     Stereo_ConfigurableDynamicParams stereoParams;
-    unsigned int prmSize;
 
     stereoParams.postproc_cost_max_threshold
                                     = atoi(gNetworkCtrl_obj.params[0]);
@@ -48,6 +47,12 @@ void handleStereoSetDynamicParams()
                                     = atoi(gNetworkCtrl_obj.params[7]);
     SendCommand(gNetworkCtrl_obj.command, &stereoParams,
                                     sizeof(stereoParams));
+}
+
+void handleStereoSetDynamicParamsResponse()
+{
+    unsigned int prmSize;
+
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 }
 
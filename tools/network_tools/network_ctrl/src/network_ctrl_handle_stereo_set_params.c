@@ -31,7 +31,6 @@ typedef struct
 void handleStereoCalibSetParams()
 {
     Stereo_ConfigurableCreateParams stereoParams;
-    unsigned int prmSize;
 
     stereoParams.numDisparities
                                     = atoi(gNetworkCtrl_obj.params[0]);
@@ -58,6 +57,12 @@ void handleStereoCalibSetParams()
 
     SendCommand(gNetworkCtrl_obj.command, &stereoParams,
                                     sizeof(stereoParams));
+}
+
+void handleStereoCalibSetParamsResponse()
+{
+    unsigned int prmSize;
+
     RecvResponse(gNetworkCtrl_obj.command, &prmSize);
 }
 
@@ -16,32 +16,50 @@ void Init()
 {
     memset(&gNetworkCtrl_obj, 0, sizeof(gNetworkCtrl_obj));
 
-    RegisterHandler("echo", handleEcho, 1);
-    RegisterHandler("mem_rd", handleMemRd, 2);
-    RegisterHandler("mem_wr", handleMemWr, 2);
+    RegisterPipelinedHandler("echo", handleEcho, handleEchoResponse, 1);
+    RegisterPipelinedHandler("mem_rd", handleMemRd, handleMemRdResponse, 2);
+    RegisterPipelinedHandler("mem_wr", handleMemWr, handleMemWrResponse, 2);
     RegisterHandler("mem_save", handleMemSave, 3);
     RegisterHandler("iss_raw_save", handleIssRawSave, 1);
     RegisterHandler("iss_yuv_save", handleIssYuvSave, 1);
     RegisterHandler("iss_send_dcc_file", handleIssSendDccFile, 1);
     RegisterHandler("iss_save_dcc_file", handleIssSaveDccFile, 2);
-    RegisterHandler("iss_write_sensor_reg", handleIssSensorRegWrite, 3);
-    RegisterHandler("iss_read_sensor_reg", handleIssSensorRegRead, 2);
+    RegisterPipelinedHandler("iss_write_sensor_reg", handleIssSensorRegWrite, handleIssSensorRegWriteResponse, 3);
+    RegisterPipelinedHandler("iss_read_sensor_reg", handleIssSensorRegRead, handleIssSensorRegReadResponse, 2);
     RegisterHandler("iss_clear_dcc_qspi_mem", handleIssClearDccQspiMem, 1);
     RegisterHandler("iss_read_2a_params", handleIssRead2AParams, 0);
     RegisterHandler("iss_write_2a_params", handleIssWrite2AParams, 9);
     RegisterHandler("stereo_calib_image_save", handleStereoCalibImageSave, 1);
     RegisterHandler("stereo_calib_lut_to_qspi", handleStereoWriteCalibLUTDataToQSPI, 2);
-    RegisterHandler("stereo_set_params", handleStereoCalibSetParams, 11);
-    RegisterHandler("stereo_set_dynamic_params", handleStereoSetDynamicParams, 8);
+    RegisterPipelinedHandler("stereo_set_params", handleStereoCalibSetParams, handleStereoCalibSetParamsResponse, 11);
+    RegisterPipelinedHandler("stereo_set_dynamic_params", handleStereoSetDynamicParams, handleStereoSetDynamicParamsResponse, 8);
     RegisterHandler("qspi_wr", handleQspiSendFile, 2);
     RegisterHandler("sys_reset", handleSysReset, 0);
+    RegisterHandler("link_stats", handleLinkStats, 4);
 }
 
 void ShowUsage()
 {
     printf(" \n");
     printf("# \n");
-    printf("# network_ctrl --ipaddr <ipaddr> [--port <server port>] --cmd <command string> <command parameters>\n");
+    printf("# network_ctrl --ipaddr <ipaddr> [--port <server port>] [<transfer options>] --cmd <command string> <command parameters>\n");
+    printf("# network_ctrl --ipaddr <ipaddr> [--port <server port>] [<transfer options>] [--pipeline <depth>] --session [<script file>]\n");
+    printf("# \n");
+    printf("#   --session   Run commands from script file, or from stdin when no file or - is given,\n");
+    printf("#               one command with its parameters per line, over one connection.\n");
+    printf("#               Lines starting with # are ignored. Besides the commands below,\n");
+    printf("#               'sleep <msecs>' waits and 'quit' ends the session.\n");
+    printf("#   --pipeline  Max commands sent before their response is received, only for\n");
+    printf("#               echo, mem_rd, mem_wr, iss_write_sensor_reg, iss_read_sensor_reg,\n");
+    printf("#               stereo_set_params and stereo_set_dynamic_params (default 1)\n");
+    printf("# \n");
+    printf("# Transfer options:\n");
+    printf("#   --chunk-size  Chunk size in KB for mem_save, qspi_wr, iss_send_dcc_file and\n");
+    printf("#                 iss_save_dcc_file. Data is streamed in chunks to/from file with\n");
+    printf("#                 progress, 0 sends all data with one command (default %d)\n", NETWORK_CTRL_DEFAULT_CHUNK_SIZE/KB);
+    printf("#   --resume      Continue an interrupted chunked transfer, mem_save continues\n");
+    printf("#                 after the data already in the output file\n");
+    printf("#   --no-crc      Do not check CRC of every chunk\n");
     printf("# \n");
     printf("# (c) Texas Instruments 2014\n");
     printf("# \n");
@@ -74,6 +92,7 @@ void ShowUsage()
     printf("# qspi_wr <QSPI address in hex> <file name to be sent>\n");
     printf("# stereo_calib_lut_to_qspi <rectMapRight_int_converted.bin> <rectMapLeft_int_converted.bin>\n");
     printf("# sys_reset\n");
+    printf("# link_stats <csv|prom|bin> <output file, - for console> <interval in msecs> <number of snapshots, 0 for forever>\n");
     printf("# \n");
     exit(0);
 }
@@ -84,6 +103,12 @@ int main(int argc, char *argv[])
     Init();
     ParseCmdLineArgs(argc, argv);
 
+    if(gNetworkCtrl_obj.isSession)
+    {
+        RunSession();
+        return 0;
+    }
+
     ConnectToServer();
     CommandExecute();
     CloseConnection();
@@ -150,29 +175,49 @@ int isValidNumParams()
     return 0;
 }
 
-void CommandExecute()
+CommandHandler *FindHandler(char *command)
 {
     int i;
 
-    /* check if command is already registered */
     for(i=0; i<NETWORK_CTRL_MAX_CMDS; i++)
     {
         if(gNetworkCtrl_obj.cmdHandler[i].handler)
         {
            if(strncmp(
                 gNetworkCtrl_obj.cmdHandler[i].cmd,
-                gNetworkCtrl_obj.command,
+                command,
                 NETWORK_CTRL_CMD_STRLEN_MAX)
                 ==0)
             {
-               gNetworkCtrl_obj.cmdHandler[i].handler();
-               return;
+               return &gNetworkCtrl_obj.cmdHandler[i];
             }
         }
     }
+
+    return NULL;
+}
+
+void CommandExecute()
+{
+    CommandHandler *pHandler;
+
+    pHandler = FindHandler(gNetworkCtrl_obj.command);
+    if(pHandler)
+    {
+        pHandler->handler();
+        if(pHandler->responseHandler)
+        {
+            pHandler->responseHandler();
+        }
+    }
 }
 
 void RegisterHandler(char *command, void (*handler)(), int numParams)
+{
+    RegisterPipelinedHandler(command, handler, NULL, numParams);
+}
+
+void RegisterPipelinedHandler(char *command, void (*handler)(), void (*responseHandler)(), int numParams)
 {
     NetworkCtrl_Obj *pObj = &gNetworkCtrl_obj;
     int i;
@@ -214,6 +259,7 @@ void RegisterHandler(char *command, void (*handler)(), int numParams)
 
     /* command not registered, register it */
     pObj->cmdHandler[firstFreeIdx].handler = handler;
+    pObj->cmdHandler[firstFreeIdx].responseHandler = responseHandler;
     strcpy(pObj->cmdHandler[firstFreeIdx].cmd, command);
     pObj->cmdHandler[firstFreeIdx].numParams = numParams;
 }
@@ -229,6 +275,9 @@ void ConnectToServer()
     {
         exit(0);
     }
+
+    /* every command is sent with one call, see SendCommand() */
+    Network_setNoDelay(&gNetworkCtrl_obj.sockObj);
 }
 
 void CloseConnection()
@@ -238,6 +287,19 @@ void CloseConnection()
     Network_deInit();
 }
 
+/* Handlers which send more than one command call this before every command
+ * after the first one, since older targets close the connection after
+ * every command
+ */
+void ReconnectIfClosed()
+{
+    if(!gNetworkCtrl_obj.isConnectionKept)
+    {
+        CloseConnection();
+        ConnectToServer();
+    }
+}
+
 int RecvResponseParams(char *command, UInt8 *pPrm, UInt32 prmSize)
 {
     int status;
@@ -286,7 +348,13 @@ int RecvResponse(char *command, UInt32 *prmSize)
         *prmSize = cmdHeader.prmSize;
     }
 
-    printf("# Command %s: Received reponse (status = %d, prmSize = %d)\n", command, cmdHeader.returnValue, cmdHeader.prmSize);
+    gNetworkCtrl_obj.isConnectionKept
+        = (cmdHeader.flags & NETWORK_CTRL_FLAG_KEEP_CONNECTION) ? TRUE : FALSE;
+
+    if(!gNetworkCtrl_obj.isQuiet)
+    {
+        printf("# Command %s: Received reponse (status = %d, prmSize = %d)\n", command, cmdHeader.returnValue, cmdHeader.prmSize);
+    }
 
     return (int)cmdHeader.returnValue;
 }
@@ -294,6 +362,8 @@ int RecvResponse(char *command, UInt32 *prmSize)
 void SendCommand(char *command, void *params, int prmSize)
 {
     NetworkCtrl_CmdHeader cmdHeader;
+    UInt8 *bufAddr[2];
+    UInt32 bufSize[2];
     int status;
 
     memset(&cmdHeader, 0, sizeof(cmdHeader));
@@ -302,23 +372,29 @@ void SendCommand(char *command, void *params, int prmSize)
     strcpy(cmdHeader.cmd, command);
     cmdHeader.returnValue = 0;
     cmdHeader.flags = 0;
+    if(gNetworkCtrl_obj.isSession || gNetworkCtrl_obj.isKeepConnection)
+    {
+        cmdHeader.flags |= NETWORK_CTRL_FLAG_KEEP_CONNECTION;
+    }
     cmdHeader.prmSize = prmSize;
 
-    status = Network_write(&gNetworkCtrl_obj.sockObj, (UInt8*)&cmdHeader, sizeof(cmdHeader));
+    /* header and parameters in one call, so that they go in one packet */
+    bufAddr[0] = (UInt8*)&cmdHeader;
+    bufSize[0] = sizeof(cmdHeader);
+    bufAddr[1] = (UInt8*)params;
+    bufSize[1] = params ? prmSize : 0;
+
+    status = Network_writev(&gNetworkCtrl_obj.sockObj, bufAddr, bufSize, 2);
     if(status<0)
     {
-        printf("# ERROR: Could not write header for command (%s)\n", command);
+        printf("# ERROR: Could not write command (%s)\n", command);
         exit(0);
     }
 
-    status = Network_write(&gNetworkCtrl_obj.sockObj, (UInt8*)params, prmSize);
-    if(status<0)
+    if(!gNetworkCtrl_obj.isQuiet)
     {
-        printf("# ERROR: Could not write parameters for command (%s)\n", command);
-        exit(0);
+        printf("# Command %s: Sent %d bytes\n", command, prmSize);
     }
-
-    printf("# Command %s: Sent %d bytes\n", command, prmSize);
 }
 
 void ParseCmdLineArgs(int argc, char *argv[])
@@ -327,6 +403,9 @@ void ParseCmdLineArgs(int argc, char *argv[])
 
     gNetworkCtrl_obj.serverPort = NETWORK_CTRL_SERVER_PORT;
     gNetworkCtrl_obj.numParams = 0;
+    gNetworkCtrl_obj.pipelineDepth = 1;
+    gNetworkCtrl_obj.chunkSize = NETWORK_CTRL_DEFAULT_CHUNK_SIZE;
+    gNetworkCtrl_obj.isChunkCrc = TRUE;
 
     for(i=0; i<argc; i++)
     {
@@ -350,6 +429,46 @@ void ParseCmdLineArgs(int argc, char *argv[])
             gNetworkCtrl_obj.serverPort = atoi(argv[i]);
         }
         else
+        if(strcmp(argv[i], "--pipeline")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gNetworkCtrl_obj.pipelineDepth = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--chunk-size")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gNetworkCtrl_obj.chunkSize = atoi(argv[i])*KB;
+        }
+        else
+        if(strcmp(argv[i], "--resume")==0)
+        {
+            gNetworkCtrl_obj.isResume = TRUE;
+        }
+        else
+        if(strcmp(argv[i], "--no-crc")==0)
+        {
+            gNetworkCtrl_obj.isChunkCrc = FALSE;
+        }
+        else
+        if(strcmp(argv[i], "--session")==0)
+        {
+            gNetworkCtrl_obj.isSession = TRUE;
+            if(i+1<argc && strncmp(argv[i+1], "--", 2)!=0)
+            {
+                i++;
+                strcpy(gNetworkCtrl_obj.scriptFile, argv[i]);
+            }
+        }
+        else
         if(strcmp(argv[i], "--cmd")==0)
         {
             i++;
@@ -371,6 +490,23 @@ void ParseCmdLineArgs(int argc, char *argv[])
         }
     }
 
+    if(gNetworkCtrl_obj.pipelineDepth < 1)
+        gNetworkCtrl_obj.pipelineDepth = 1;
+    if(gNetworkCtrl_obj.pipelineDepth > NETWORK_CTRL_MAX_PIPELINE)
+        gNetworkCtrl_obj.pipelineDepth = NETWORK_CTRL_MAX_PIPELINE;
+    if(gNetworkCtrl_obj.chunkSize > NETWORK_CTRL_CHUNK_SIZE_MAX)
+        gNetworkCtrl_obj.chunkSize = NETWORK_CTRL_CHUNK_SIZE_MAX;
+
+    if(gNetworkCtrl_obj.isSession)
+    {
+        if(gNetworkCtrl_obj.ipAddr[0]==0)
+        {
+            printf("# ERROR: IP Address of server MUST be specified\n");
+            ShowUsage();
+        }
+        return;
+    }
+
     if(gNetworkCtrl_obj.ipAddr[0]==0
             ||
        gNetworkCtrl_obj.command[0]==0
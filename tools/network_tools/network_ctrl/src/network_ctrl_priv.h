@@ -40,14 +40,49 @@ extern "C" {
 
 #define NETWORK_CTRL_MAX_PARAMS     (32)
 
+/* Max commands sent ahead of their response in session mode */
+#define NETWORK_CTRL_MAX_PIPELINE   (32)
+
+/* Max length of one line of a session script */
+#define NETWORK_CTRL_MAX_LINE       (4096)
+
+/* Default chunk size of chunked transfers, see --chunk-size */
+#define NETWORK_CTRL_DEFAULT_CHUNK_SIZE (1*MB)
+
+/* Times a chunk is sent or requested again after a CRC mismatch */
+#define NETWORK_CTRL_CHUNK_MAX_RETRY    (3)
+
+/* Interval at which progress of chunked transfers is printed */
+#define NETWORK_CTRL_PROGRESS_INTERVAL_MSEC (1000)
+
 typedef struct {
 
     char cmd[NETWORK_CTRL_CMD_STRLEN_MAX];
     void (*handler)();
+    void (*responseHandler)();
+    /**< When set, 'handler' only sends the command and 'responseHandler'
+     *   receives and processes the response, such commands can be pipelined
+     *   in session mode */
     int numParams;
 
 } CommandHandler;
 
+/* Command and its parameters, as parsed from command line or script */
+typedef struct {
+
+    char command[NETWORK_CTRL_CMD_STRLEN_MAX];
+
+    char params[NETWORK_CTRL_MAX_PARAMS][NETWORK_CTRL_CMD_STRLEN_MAX];
+
+    int numParams;
+
+    int lineNum;
+    /**< Line in script, for messages */
+
+    Uint64 sendTime;
+
+} CommandInfo;
+
 typedef struct {
 
     UInt16 serverPort;
@@ -65,6 +100,48 @@ typedef struct {
 
     CommandHandler cmdHandler[NETWORK_CTRL_MAX_CMDS];
 
+    Bool isSession;
+    /**< Run commands from script or stdin over one connection */
+
+    char scriptFile[1024];
+    /**< Empty or "-" for stdin */
+
+    int pipelineDepth;
+    /**< Max commands waiting for response, 1: no pipelining */
+
+    Bool isConnected;
+
+    Bool isConnectionKept;
+    /**< Target ACK'ed last command with NETWORK_CTRL_FLAG_KEEP_CONNECTION */
+
+    CommandInfo pending[NETWORK_CTRL_MAX_PIPELINE];
+    /**< Commands sent and waiting for response, oldest at pendingRdIdx */
+
+    int pendingRdIdx;
+
+    int numPending;
+
+    int numCmds;
+
+    Uint64 totalCmdTime;
+
+    Uint64 maxCmdTime;
+
+    UInt32 chunkSize;
+    /**< Chunk size of chunked transfers, 0: single command transfers */
+
+    Bool isResume;
+    /**< Continue an interrupted chunked transfer */
+
+    Bool isChunkCrc;
+    /**< Check CRC of every chunk */
+
+    Bool isKeepConnection;
+    /**< Set by handlers which send a sequence of commands */
+
+    Bool isQuiet;
+    /**< No per command messages, used during chunked transfers */
+
 } NetworkCtrl_Obj;
 
 extern NetworkCtrl_Obj gNetworkCtrl_obj;
@@ -74,15 +151,26 @@ void ParseCmdLineArgs(int argc, char *argv[]);
 void ConnectToServer();
 void CloseConnection();
 void CommandExecute();
+CommandHandler *FindHandler(char *command);
+int isValidCommand();
+int isValidNumParams();
 
 void SendCommand(char *command, void *params, int size);
 int RecvResponse(char *command, UInt32 *prmSize);
 int RecvResponseParams(char *command, UInt8 *pPrm, UInt32 prmSize);
 void RegisterHandler(char *command, void (*handler)(), int numParams);
+void RegisterPipelinedHandler(char *command, void (*handler)(), void (*responseHandler)(), int numParams);
+void RunSession();
+void ReconnectIfClosed();
+int ChunkDownload(char *command, UInt32 addr, UInt32 totalSize, char *fileName);
+int ChunkUpload(char *command, UInt32 addr, UInt8 *pPrefix, UInt32 prefixSize, char *fileName, UInt32 chunkAlign);
 
 void handleEcho();
+void handleEchoResponse();
 void handleMemRd();
+void handleMemRdResponse();
 void handleMemWr();
+void handleMemWrResponse();
 void handleMemSave();
 void handleIssRawSave();
 void handleIssYuvSave();
@@ -90,15 +178,20 @@ void handleIssSendDccFile();
 void handleIssSaveDccFile();
 void handleIssClearDccQspiMem();
 void handleIssSensorRegWrite();
+void handleIssSensorRegWriteResponse();
 void handleIssSensorRegRead();
+void handleIssSensorRegReadResponse();
 void handleIssRead2AParams();
 void handleIssWrite2AParams();
 void handleStereoCalibImageSave();
 void handleStereoCalibSetParams();
+void handleStereoCalibSetParamsResponse();
 void handleStereoSetDynamicParams();
+void handleStereoSetDynamicParamsResponse();
 void handleStereoWriteCalibLUTDataToQSPI();
 void handleQspiSendFile();
 void handleSysReset();
+void handleLinkStats();
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,331 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Session mode, commands are read one per line from a script file or stdin
+ * and sent over one connection. Commands set NETWORK_CTRL_FLAG_KEEP_CONNECTION
+ * and the connection is reused as long as the target ACK's with the same
+ * flag. Older targets close the connection after every command, in that
+ * case a new connection is made for the next command.
+ *
+ * Commands registered with a response handler are pipelined, i.e upto
+ * --pipeline commands are sent before the response of the oldest is read.
+ * Other commands wait for all pending responses and are run one by one.
+ */
+
+#include "network_ctrl_priv.h"
+
+static void SaveCommandInfo(CommandInfo *pInfo)
+{
+    int i;
+
+    strcpy(pInfo->command, gNetworkCtrl_obj.command);
+    for(i=0; i<gNetworkCtrl_obj.numParams; i++)
+    {
+        strcpy(pInfo->params[i], gNetworkCtrl_obj.params[i]);
+    }
+    pInfo->numParams = gNetworkCtrl_obj.numParams;
+}
+
+static void LoadCommandInfo(CommandInfo *pInfo)
+{
+    int i;
+
+    strcpy(gNetworkCtrl_obj.command, pInfo->command);
+    for(i=0; i<pInfo->numParams; i++)
+    {
+        strcpy(gNetworkCtrl_obj.params[i], pInfo->params[i]);
+    }
+    gNetworkCtrl_obj.numParams = pInfo->numParams;
+}
+
+/* Split line into command and parameters, a parameter with spaces can be
+ * given in double quotes. Returns 1 if line has a command
+ */
+static int ParseLine(char *line, int lineNum)
+{
+    char *pCur, *pToken;
+    int numTokens;
+
+    gNetworkCtrl_obj.command[0] = 0;
+    gNetworkCtrl_obj.numParams = 0;
+
+    numTokens = 0;
+    pCur = line;
+
+    while(1)
+    {
+        while(*pCur==' ' || *pCur=='\t' || *pCur=='\r' || *pCur=='\n')
+            pCur++;
+
+        if(*pCur==0)
+            break;
+
+        if(numTokens==0 && *pCur=='#')
+            break;
+
+        if(*pCur=='"')
+        {
+            pCur++;
+            pToken = pCur;
+            while(*pCur && *pCur!='"')
+                pCur++;
+        }
+        else
+        {
+            pToken = pCur;
+            while(*pCur && *pCur!=' ' && *pCur!='\t' && *pCur!='\r' && *pCur!='\n')
+                pCur++;
+        }
+        if(*pCur)
+        {
+            *pCur = 0;
+            pCur++;
+        }
+
+        if(strlen(pToken) >= NETWORK_CTRL_CMD_STRLEN_MAX
+            ||
+           numTokens > NETWORK_CTRL_MAX_PARAMS)
+        {
+            printf("# ERROR: Line %d: Too many or too long parameters\n", lineNum);
+            gNetworkCtrl_obj.command[0] = 0;
+            return 0;
+        }
+
+        if(numTokens==0)
+        {
+            strcpy(gNetworkCtrl_obj.command, pToken);
+        }
+        else
+        {
+            strcpy(gNetworkCtrl_obj.params[numTokens-1], pToken);
+            gNetworkCtrl_obj.numParams = numTokens;
+        }
+        numTokens++;
+    }
+
+    return numTokens > 0;
+}
+
+static void UpdateCommandTime(CommandInfo *pInfo)
+{
+    Uint64 elapsed;
+
+    elapsed = OSA_getCurTimeInUsec() - pInfo->sendTime;
+
+    gNetworkCtrl_obj.numCmds++;
+    gNetworkCtrl_obj.totalCmdTime += elapsed;
+    if(elapsed > gNetworkCtrl_obj.maxCmdTime)
+        gNetworkCtrl_obj.maxCmdTime = elapsed;
+
+    printf("# Command %s: Line %d: Done in %8.3f ms\n",
+        pInfo->command,
+        pInfo->lineNum,
+        elapsed/1000.0);
+}
+
+static void CheckConnection()
+{
+    /* target closes connection after ACK without NETWORK_CTRL_FLAG_KEEP_CONNECTION */
+    if(gNetworkCtrl_obj.isConnected && !gNetworkCtrl_obj.isConnectionKept)
+    {
+        CloseConnection();
+        gNetworkCtrl_obj.isConnected = FALSE;
+    }
+}
+
+static void CompleteOldestCommand()
+{
+    CommandInfo *pInfo;
+    CommandHandler *pHandler;
+
+    pInfo = &gNetworkCtrl_obj.pending[gNetworkCtrl_obj.pendingRdIdx];
+
+    LoadCommandInfo(pInfo);
+
+    pHandler = FindHandler(gNetworkCtrl_obj.command);
+    pHandler->responseHandler();
+
+    UpdateCommandTime(pInfo);
+
+    gNetworkCtrl_obj.pendingRdIdx
+        = (gNetworkCtrl_obj.pendingRdIdx + 1) % NETWORK_CTRL_MAX_PIPELINE;
+    gNetworkCtrl_obj.numPending--;
+}
+
+static void DrainPipeline()
+{
+    while(gNetworkCtrl_obj.numPending)
+    {
+        CompleteOldestCommand();
+    }
+
+    CheckConnection();
+}
+
+static void RunCommand(int lineNum)
+{
+    CommandHandler *pHandler;
+    CommandInfo cmdInfo;
+    CommandInfo *pInfo;
+    int wrIdx;
+
+    pHandler = FindHandler(gNetworkCtrl_obj.command);
+
+    SaveCommandInfo(&cmdInfo);
+    cmdInfo.lineNum = lineNum;
+
+    /* pipeline only on a connection the target said it keeps open */
+    if(pHandler->responseHandler
+        &&
+       gNetworkCtrl_obj.pipelineDepth > 1
+        &&
+       gNetworkCtrl_obj.isConnected
+        &&
+       gNetworkCtrl_obj.isConnectionKept)
+    {
+        /* responses are read in order, make space for this command */
+        if(gNetworkCtrl_obj.numPending >= gNetworkCtrl_obj.pipelineDepth)
+        {
+            CompleteOldestCommand();
+            LoadCommandInfo(&cmdInfo);
+        }
+
+        wrIdx = (gNetworkCtrl_obj.pendingRdIdx + gNetworkCtrl_obj.numPending)
+                    % NETWORK_CTRL_MAX_PIPELINE;
+        pInfo = &gNetworkCtrl_obj.pending[wrIdx];
+
+        *pInfo = cmdInfo;
+        pInfo->sendTime = OSA_getCurTimeInUsec();
+
+        pHandler->handler();
+        gNetworkCtrl_obj.numPending++;
+        return;
+    }
+
+    DrainPipeline();
+    LoadCommandInfo(&cmdInfo);
+
+    if(!gNetworkCtrl_obj.isConnected)
+    {
+        ConnectToServer();
+        gNetworkCtrl_obj.isConnected = TRUE;
+    }
+
+    cmdInfo.sendTime = OSA_getCurTimeInUsec();
+
+    pHandler->handler();
+    if(pHandler->responseHandler)
+    {
+        pHandler->responseHandler();
+    }
+
+    UpdateCommandTime(&cmdInfo);
+
+    CheckConnection();
+}
+
+void RunSession()
+{
+    FILE *fd;
+    char line[NETWORK_CTRL_MAX_LINE];
+    int lineNum;
+    int sleepMsecs;
+    Uint64 startTime, elapsed;
+
+    if(gNetworkCtrl_obj.scriptFile[0]==0
+        ||
+       strcmp(gNetworkCtrl_obj.scriptFile, "-")==0)
+    {
+        fd = stdin;
+    }
+    else
+    {
+        fd = fopen(gNetworkCtrl_obj.scriptFile, "r");
+        if(fd==NULL)
+        {
+            printf("# ERROR: Unable to open script file [%s]\n", gNetworkCtrl_obj.scriptFile);
+            exit(0);
+        }
+    }
+
+    gNetworkCtrl_obj.numPending = 0;
+    gNetworkCtrl_obj.pendingRdIdx = 0;
+    gNetworkCtrl_obj.isConnected = FALSE;
+    gNetworkCtrl_obj.isConnectionKept = FALSE;
+
+    startTime = OSA_getCurTimeInUsec();
+
+    lineNum = 0;
+    while(fgets(line, sizeof(line), fd)!=NULL)
+    {
+        lineNum++;
+
+        if(!ParseLine(line, lineNum))
+            continue;
+
+        if(strcmp(gNetworkCtrl_obj.command, "quit")==0
+            ||
+           strcmp(gNetworkCtrl_obj.command, "exit")==0)
+        {
+            break;
+        }
+
+        if(strcmp(gNetworkCtrl_obj.command, "sleep")==0)
+        {
+            /* draining loads params of pending commands, read sleep time first */
+            sleepMsecs = 0;
+            if(gNetworkCtrl_obj.numParams > 0)
+            {
+                sleepMsecs = atoi(gNetworkCtrl_obj.params[0]);
+            }
+            DrainPipeline();
+            OSA_waitMsecs(sleepMsecs);
+            continue;
+        }
+
+        if(!isValidCommand())
+        {
+            printf("# ERROR: Line %d: Command [%s] NOT SUPPORTED\n", lineNum, gNetworkCtrl_obj.command);
+            continue;
+        }
+
+        if(!isValidNumParams())
+        {
+            printf("# ERROR: Line %d: Insufficient parameters (%d) specified for command [%s] \n",
+                lineNum, gNetworkCtrl_obj.numParams, gNetworkCtrl_obj.command);
+            continue;
+        }
+
+        RunCommand(lineNum);
+
+        fflush(stdout);
+    }
+
+    DrainPipeline();
+
+    if(gNetworkCtrl_obj.isConnected)
+    {
+        CloseConnection();
+        gNetworkCtrl_obj.isConnected = FALSE;
+    }
+
+    if(fd!=stdin)
+        fclose(fd);
+
+    elapsed = OSA_getCurTimeInUsec() - startTime;
+
+    printf("# \n");
+    printf("# Session: %d commands in %8.3f secs, avg %8.3f ms, max %8.3f ms per command\n",
+        gNetworkCtrl_obj.numCmds,
+        elapsed/1000000.0,
+        gNetworkCtrl_obj.numCmds ?
+            gNetworkCtrl_obj.totalCmdTime/1000.0/gNetworkCtrl_obj.numCmds : 0.0,
+        gNetworkCtrl_obj.maxCmdTime/1000.0);
+}
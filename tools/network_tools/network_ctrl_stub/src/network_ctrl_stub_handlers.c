@@ -0,0 +1,351 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Command handlers, same parameters and responses as the handlers on target
+ */
+
+#include "network_ctrl_stub_priv.h"
+
+/* Returns pointer in emulated memory, NULL if [addr, addr+size) is outside */
+static UInt8 *MemPtr(UInt32 addr, UInt32 size)
+{
+    if(addr < gNetworkCtrlStub_obj.memAddr
+        ||
+       size > gNetworkCtrlStub_obj.memSize
+        ||
+       addr - gNetworkCtrlStub_obj.memAddr > gNetworkCtrlStub_obj.memSize - size)
+    {
+        printf("# STUB: %s: Address range 0x%08x of %d bytes is outside emulated memory !!!\n",
+            gNetworkCtrlStub_obj.cmdBuf.cmd, addr, size);
+        return NULL;
+    }
+
+    return gNetworkCtrlStub_obj.pMem + (addr - gNetworkCtrlStub_obj.memAddr);
+}
+
+static UInt8 *ReadAllParams(UInt32 prmSize)
+{
+    UInt8 *pPrm;
+
+    pPrm = malloc(prmSize + sizeof(UInt32));
+    if(pPrm==NULL)
+    {
+        printf("# ERROR: Unable to allocate %d bytes for parameters\n", prmSize);
+        exit(0);
+    }
+
+    memset(pPrm, 0, prmSize + sizeof(UInt32));
+
+    ReadParams(pPrm, prmSize);
+
+    return pPrm;
+}
+
+static void SaveToFile(char *fileName, UInt8 *pData, UInt32 size)
+{
+    if(fileName[0])
+    {
+        OSA_fileWriteFile(fileName, pData, size);
+    }
+}
+
+void handleUnsupported(char *cmd, UInt32 prmSize)
+{
+    SkipParams(prmSize);
+
+    printf("# STUB: %s: UNSUPPORTED CMD (prmSize=%d) !!!\n", cmd, prmSize);
+
+    WriteParams(NULL, 0, (UInt32)-1);
+}
+
+void handleEcho(char *cmd, UInt32 prmSize)
+{
+    UInt8 *pPrm;
+
+    pPrm = ReadAllParams(prmSize);
+
+    printf("# STUB: %s: %s\n", cmd, (char*)pPrm);
+
+    free(pPrm);
+
+    WriteParams(NULL, 0, 0);
+}
+
+void handleMemRd(char *cmd, UInt32 prmSize)
+{
+    UInt32 prm[2];
+    UInt8 *pAddr;
+
+    if(prmSize != sizeof(prm))
+    {
+        handleUnsupported(cmd, prmSize);
+        return;
+    }
+
+    ReadParams((UInt8*)prm, sizeof(prm));
+
+    pAddr = MemPtr(prm[0], prm[1]);
+    if(pAddr==NULL)
+    {
+        WriteParams(NULL, 0, (UInt32)-1);
+        return;
+    }
+
+    WriteParams(pAddr, prm[1], 0);
+}
+
+void handleMemWr(char *cmd, UInt32 prmSize)
+{
+    UInt32 prm[2];
+    UInt8 *pAddr;
+
+    if(prmSize != sizeof(prm))
+    {
+        handleUnsupported(cmd, prmSize);
+        return;
+    }
+
+    ReadParams((UInt8*)prm, sizeof(prm));
+
+    pAddr = MemPtr(prm[0], sizeof(UInt32));
+    if(pAddr==NULL)
+    {
+        WriteParams(NULL, 0, (UInt32)-1);
+        return;
+    }
+
+    memcpy(pAddr, &prm[1], sizeof(UInt32));
+
+    WriteParams(NULL, 0, 0);
+}
+
+void handleMemSave(char *cmd, UInt32 prmSize)
+{
+    /* same parameters and response as mem_rd, size is in bytes */
+    handleMemRd(cmd, prmSize);
+}
+
+void handleMemSaveChunk(char *cmd, UInt32 prmSize)
+{
+    NetworkCtrl_ChunkHeader chunk;
+    UInt8 *pAddr;
+    Bool isCorrupt;
+
+    if(prmSize != sizeof(chunk))
+    {
+        handleUnsupported(cmd, prmSize);
+        return;
+    }
+
+    ReadParams((UInt8*)&chunk, sizeof(chunk));
+
+    pAddr = NULL;
+    if(chunk.size <= NETWORK_CTRL_CHUNK_SIZE_MAX
+        && chunk.size <= chunk.totalSize
+        && chunk.offset <= chunk.totalSize - chunk.size)
+    {
+        pAddr = MemPtr(chunk.addr + chunk.offset, chunk.size);
+    }
+
+    if(pAddr==NULL)
+    {
+        chunk.size = 0;
+        WriteChunk(&chunk, NULL, (UInt32)-1);
+        return;
+    }
+
+    if(chunk.flags & NETWORK_CTRL_CHUNK_FLAG_CRC)
+    {
+        chunk.crc = OSA_crc32(pAddr, chunk.size);
+    }
+
+    if(ChunkIsDrop())
+    {
+        /* header and part of the data, then connection is closed */
+        WriteAck(sizeof(chunk) + chunk.size, 0, (UInt8*)&chunk, sizeof(chunk), pAddr, chunk.size/2);
+        return;
+    }
+
+    /* flip a bit after CRC is computed, restored after sending */
+    isCorrupt = ChunkIsCorrupt() && chunk.size;
+    if(isCorrupt)
+        pAddr[chunk.size/2] ^= 0x01;
+
+    gNetworkCtrlStub_obj.totalChunkData += chunk.size;
+
+    WriteChunk(&chunk, pAddr, 0);
+
+    if(isCorrupt)
+        pAddr[chunk.size/2] ^= 0x01;
+}
+
+void handleQspiWrite(char *cmd, UInt32 prmSize)
+{
+    UInt8 *pPrm;
+    UInt32 qspiOffset, size;
+
+    /* first word is QSPI offset, then file data */
+    if(prmSize < sizeof(UInt32) || prmSize > STUB_QSPI_SIZE)
+    {
+        handleUnsupported(cmd, prmSize);
+        return;
+    }
+
+    pPrm = ReadAllParams(prmSize);
+
+    qspiOffset = *(UInt32*)pPrm;
+    size = prmSize - sizeof(UInt32);
+
+    WriteParams(NULL, 0, 0);
+
+    if(qspiOffset > STUB_QSPI_SIZE - size)
+    {
+        printf("# STUB: %s: QSPI offset 0x%08x of %d bytes is outside QSPI !!!\n", cmd, qspiOffset, size);
+    }
+    else
+    {
+        printf("# STUB: %s: Flashing %d B at offset 0x%08x\n", cmd, size, qspiOffset);
+
+        memcpy(gNetworkCtrlStub_obj.pQspi + qspiOffset, pPrm + sizeof(UInt32), size);
+
+        SaveToFile(gNetworkCtrlStub_obj.qspiFile, gNetworkCtrlStub_obj.pQspi + qspiOffset, size);
+    }
+
+    free(pPrm);
+}
+
+/* Reads upload chunk data to pDst + offset, with fault injection.
+ * Returns OSA_SOK if the chunk is accepted, connection is dropped when
+ * isDropConnection is set on return
+ */
+static int ChunkRxData(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk, UInt8 *pDst)
+{
+    ReadParams(pDst + pChunk->offset, pChunk->size);
+
+    if(ChunkIsDrop())
+    {
+        return OSA_EFAIL;
+    }
+
+    if(ChunkIsCorrupt())
+    {
+        pDst[pChunk->offset + pChunk->size/2] ^= 0x01;
+    }
+
+    return ChunkRxCheck(pRx, pChunk, pDst + pChunk->offset);
+}
+
+void handleQspiWriteChunk(char *cmd, UInt32 prmSize)
+{
+    NetworkCtrl_ChunkHeader chunk;
+    int status;
+
+    status = ChunkRxStart(&gNetworkCtrlStub_obj.qspiRx, &chunk, prmSize,
+                STUB_QSPI_SIZE, STUB_QSPI_BLOCK_SIZE);
+    if(status != OSA_SOK)
+        return;
+
+    if(chunk.addr > STUB_QSPI_SIZE - chunk.totalSize)
+    {
+        printf("# STUB: %s: QSPI offset 0x%08x of %d bytes is outside QSPI !!!\n", cmd, chunk.addr, chunk.totalSize);
+
+        SkipParams(chunk.size);
+        ChunkRxAck(&gNetworkCtrlStub_obj.qspiRx, &chunk, OSA_EFAIL);
+        return;
+    }
+
+    status = ChunkRxData(&gNetworkCtrlStub_obj.qspiRx, &chunk,
+                gNetworkCtrlStub_obj.pQspi + chunk.addr);
+
+    if(gNetworkCtrlStub_obj.isDropConnection)
+        return;
+
+    if(status == OSA_SOK
+        &&
+       gNetworkCtrlStub_obj.qspiRx.nextOffset == gNetworkCtrlStub_obj.qspiRx.totalSize)
+    {
+        printf("# STUB: %s: Flashed %d B at offset 0x%08x\n", cmd, chunk.totalSize, chunk.addr);
+
+        SaveToFile(gNetworkCtrlStub_obj.qspiFile,
+            gNetworkCtrlStub_obj.pQspi + chunk.addr, chunk.totalSize);
+    }
+
+    ChunkRxAck(&gNetworkCtrlStub_obj.qspiRx, &chunk, status);
+}
+
+static void handleDccFile(char *cmd, UInt32 prmSize)
+{
+    UInt8 *pPrm;
+
+    if(prmSize > STUB_DCC_FILE_SIZE)
+    {
+        printf("# STUB: %s: Insufficient DCC Buffer\n", cmd);
+        SkipParams(prmSize);
+    }
+    else
+    if(prmSize)
+    {
+        pPrm = ReadAllParams(prmSize);
+
+        memcpy(gNetworkCtrlStub_obj.pDcc, pPrm, prmSize);
+
+        printf("# STUB: %s: Received %d B of DCC file\n", cmd, prmSize);
+
+        SaveToFile(gNetworkCtrlStub_obj.dccFile, gNetworkCtrlStub_obj.pDcc, prmSize);
+
+        free(pPrm);
+    }
+
+    WriteParams(NULL, 0, 0);
+}
+
+void handleIssSendDccFile(char *cmd, UInt32 prmSize)
+{
+    handleDccFile(cmd, prmSize);
+}
+
+void handleIssSaveDccFile(char *cmd, UInt32 prmSize)
+{
+    handleDccFile(cmd, prmSize);
+}
+
+static void handleDccFileChunk(char *cmd, UInt32 prmSize, Stub_ChunkRxObj *pRx)
+{
+    NetworkCtrl_ChunkHeader chunk;
+    int status;
+
+    status = ChunkRxStart(pRx, &chunk, prmSize, STUB_DCC_FILE_SIZE, 1);
+    if(status != OSA_SOK)
+        return;
+
+    status = ChunkRxData(pRx, &chunk, gNetworkCtrlStub_obj.pDcc);
+
+    if(gNetworkCtrlStub_obj.isDropConnection)
+        return;
+
+    if(status == OSA_SOK && pRx->nextOffset == pRx->totalSize)
+    {
+        printf("# STUB: %s: Received %d B of DCC file\n", cmd, chunk.totalSize);
+
+        SaveToFile(gNetworkCtrlStub_obj.dccFile, gNetworkCtrlStub_obj.pDcc, chunk.totalSize);
+    }
+
+    ChunkRxAck(pRx, &chunk, status);
+}
+
+void handleIssSendDccFileChunk(char *cmd, UInt32 prmSize)
+{
+    handleDccFileChunk(cmd, prmSize, &gNetworkCtrlStub_obj.dccSendRx);
+}
+
+void handleIssSaveDccFileChunk(char *cmd, UInt32 prmSize)
+{
+    handleDccFileChunk(cmd, prmSize, &gNetworkCtrlStub_obj.dccSaveRx);
+}
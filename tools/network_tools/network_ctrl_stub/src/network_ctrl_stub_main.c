@@ -0,0 +1,518 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Loopback stub of the target network_ctrl server. It serves network_ctrl
+ * commands on the PC from emulated target memory, QSPI and DCC buffers, so
+ * that network_ctrl and the command protocol, including chunked transfers,
+ * can be tested without a board.
+ */
+
+#include "network_ctrl_stub_priv.h"
+
+NetworkCtrlStub_Obj gNetworkCtrlStub_obj;
+
+void ShowUsage()
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# network_ctrl_stub [--port <server port>] [--mem-addr <addr in hex>] [--mem-size <size in MB>]\n");
+    printf("#                   [--qspi-file <file>] [--dcc-file <file>] [--legacy] [--no-keep]\n");
+    printf("#                   [--corrupt-every <N>] [--drop-after <N>] [--verbose]\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2016\n");
+    printf("# \n");
+    printf("# Emulates the target network_ctrl server, connect with\n");
+    printf("#   network_ctrl --ipaddr 127.0.0.1 [--port <server port>] ...\n");
+    printf("# \n");
+    printf("#   --port          Port to listen on (default %d)\n", NETWORK_CTRL_SERVER_PORT);
+    printf("#   --mem-addr      Address of emulated memory, word at address A\n");
+    printf("#                   reads as A (default %08x)\n", STUB_DEFAULT_MEM_ADDR);
+    printf("#   --mem-size      Size of emulated memory (default %d MB)\n", STUB_DEFAULT_MEM_SIZE/MB);
+    printf("#   --qspi-file     Data of every completed qspi_wr is saved to this file\n");
+    printf("#   --dcc-file      Every received DCC file is saved to this file\n");
+    printf("#   --legacy        Emulate a target without \"_chunk\" commands\n");
+    printf("#   --no-keep       Emulate a target which closes the connection after\n");
+    printf("#                   every command\n");
+    printf("#   --corrupt-every Corrupt data of every Nth chunk, to test CRC retry\n");
+    printf("#   --drop-after    Close the connection in the middle of the Nth chunk,\n");
+    printf("#                   to test --resume\n");
+    printf("#   --verbose       Print every command\n");
+    printf("# \n");
+    exit(0);
+}
+
+void ParseCmdLineArgs(int argc, char *argv[])
+{
+    int i;
+
+    gNetworkCtrlStub_obj.serverPort = NETWORK_CTRL_SERVER_PORT;
+    gNetworkCtrlStub_obj.memAddr = STUB_DEFAULT_MEM_ADDR;
+    gNetworkCtrlStub_obj.memSize = STUB_DEFAULT_MEM_SIZE;
+
+    for(i=1; i<argc; i++)
+    {
+        if(strcmp(argv[i], "--port")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCtrlStub_obj.serverPort = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--mem-addr")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCtrlStub_obj.memAddr = (UInt32)strtoul(argv[i], NULL, 16);
+        }
+        else
+        if(strcmp(argv[i], "--mem-size")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCtrlStub_obj.memSize = atoi(argv[i])*MB;
+        }
+        else
+        if(strcmp(argv[i], "--qspi-file")==0 && i+1<argc)
+        {
+            i++;
+            strcpy(gNetworkCtrlStub_obj.qspiFile, argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--dcc-file")==0 && i+1<argc)
+        {
+            i++;
+            strcpy(gNetworkCtrlStub_obj.dccFile, argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--corrupt-every")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCtrlStub_obj.corruptEvery = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--drop-after")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkCtrlStub_obj.dropAfter = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--legacy")==0)
+        {
+            gNetworkCtrlStub_obj.isLegacy = TRUE;
+        }
+        else
+        if(strcmp(argv[i], "--no-keep")==0)
+        {
+            gNetworkCtrlStub_obj.isNoKeep = TRUE;
+        }
+        else
+        if(strcmp(argv[i], "--verbose")==0)
+        {
+            gNetworkCtrlStub_obj.isVerbose = TRUE;
+        }
+        else
+        {
+            ShowUsage();
+        }
+    }
+
+    if(gNetworkCtrlStub_obj.memSize==0
+        ||
+       (Uint64)gNetworkCtrlStub_obj.memAddr + gNetworkCtrlStub_obj.memSize > 0x100000000ULL)
+    {
+        printf("# ERROR: Invalid emulated memory range\n");
+        ShowUsage();
+    }
+}
+
+void RegisterHandler(char *cmd, StubCmdHandler handler)
+{
+    int i;
+
+    for(i=0; i<STUB_MAX_CMDS; i++)
+    {
+        if(gNetworkCtrlStub_obj.cmdHandler[i].handler==NULL)
+        {
+            strcpy(gNetworkCtrlStub_obj.cmdHandler[i].cmd, cmd);
+            gNetworkCtrlStub_obj.cmdHandler[i].handler = handler;
+            return;
+        }
+    }
+
+    printf("# ERROR: No space to register command [%s] !!!\n", cmd);
+    exit(0);
+}
+
+void Init()
+{
+    UInt32 i, *pWord;
+
+    gNetworkCtrlStub_obj.pMem  = malloc(gNetworkCtrlStub_obj.memSize);
+    gNetworkCtrlStub_obj.pQspi = malloc(STUB_QSPI_SIZE);
+    gNetworkCtrlStub_obj.pDcc  = malloc(STUB_DCC_FILE_SIZE);
+
+    if(gNetworkCtrlStub_obj.pMem==NULL
+        ||
+       gNetworkCtrlStub_obj.pQspi==NULL
+        ||
+       gNetworkCtrlStub_obj.pDcc==NULL)
+    {
+        printf("# ERROR: Unable to allocate emulated memory\n");
+        exit(0);
+    }
+
+    pWord = (UInt32*)gNetworkCtrlStub_obj.pMem;
+    for(i=0; i<gNetworkCtrlStub_obj.memSize/sizeof(UInt32); i++)
+    {
+        pWord[i] = gNetworkCtrlStub_obj.memAddr + i*sizeof(UInt32);
+    }
+
+    memset(gNetworkCtrlStub_obj.pQspi, 0xFF, STUB_QSPI_SIZE);
+
+    RegisterHandler("echo", handleEcho);
+    RegisterHandler("mem_rd", handleMemRd);
+    RegisterHandler("mem_wr", handleMemWr);
+    RegisterHandler("mem_save", handleMemSave);
+    RegisterHandler("qspi_wr", handleQspiWrite);
+    RegisterHandler("iss_send_dcc_file", handleIssSendDccFile);
+    RegisterHandler("iss_save_dcc_file", handleIssSaveDccFile);
+
+    if(!gNetworkCtrlStub_obj.isLegacy)
+    {
+        RegisterHandler("mem_save_chunk", handleMemSaveChunk);
+        RegisterHandler("qspi_wr_chunk", handleQspiWriteChunk);
+        RegisterHandler("iss_send_dcc_file_chunk", handleIssSendDccFileChunk);
+        RegisterHandler("iss_save_dcc_file_chunk", handleIssSaveDccFileChunk);
+    }
+}
+
+void DeInit()
+{
+    free(gNetworkCtrlStub_obj.pMem);
+    free(gNetworkCtrlStub_obj.pQspi);
+    free(gNetworkCtrlStub_obj.pDcc);
+}
+
+int ReadParams(UInt8 *pPrm, UInt32 prmSize)
+{
+    if(prmSize==0)
+        return 0;
+
+    return Network_read(&gNetworkCtrlStub_obj.sockObj, pPrm, &prmSize);
+}
+
+void SkipParams(UInt32 prmSize)
+{
+    UInt8 buf[256];
+    UInt32 readSize;
+
+    while(prmSize)
+    {
+        readSize = prmSize < sizeof(buf) ? prmSize : sizeof(buf);
+
+        if(ReadParams(buf, readSize) < 0)
+            break;
+
+        prmSize -= readSize;
+    }
+}
+
+int WriteAck(UInt32 prmSize, UInt32 returnStatus, UInt8 *pPrm0, UInt32 prmSize0, UInt8 *pPrm1, UInt32 prmSize1)
+{
+    UInt8 *bufAddr[3];
+    UInt32 bufSize[3];
+
+    gNetworkCtrlStub_obj.cmdBuf.prmSize = prmSize;
+    gNetworkCtrlStub_obj.cmdBuf.returnValue = returnStatus;
+    gNetworkCtrlStub_obj.cmdBuf.flags = NETWORK_CTRL_FLAG_ACK;
+    if(gNetworkCtrlStub_obj.keepConnection)
+    {
+        gNetworkCtrlStub_obj.cmdBuf.flags |= NETWORK_CTRL_FLAG_KEEP_CONNECTION;
+    }
+
+    bufAddr[0] = (UInt8*)&gNetworkCtrlStub_obj.cmdBuf;
+    bufSize[0] = sizeof(gNetworkCtrlStub_obj.cmdBuf);
+    bufAddr[1] = pPrm0;
+    bufSize[1] = prmSize0;
+    bufAddr[2] = pPrm1;
+    bufSize[2] = prmSize1;
+
+    return Network_writev(&gNetworkCtrlStub_obj.sockObj, bufAddr, bufSize, 3);
+}
+
+int WriteParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus)
+{
+    return WriteAck(prmSize, returnStatus, pPrm, prmSize, NULL, 0);
+}
+
+int WriteChunk(NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData, UInt32 returnStatus)
+{
+    UInt32 dataSize;
+
+    dataSize = pData ? pChunk->size : 0;
+
+    return WriteAck(sizeof(*pChunk) + dataSize, returnStatus,
+                (UInt8*)pChunk, sizeof(*pChunk), pData, dataSize);
+}
+
+/* Counts chunks for fault injection, returns TRUE when the connection should
+ * be dropped at this chunk
+ */
+Bool ChunkIsDrop()
+{
+    gNetworkCtrlStub_obj.numChunks++;
+
+    if(gNetworkCtrlStub_obj.dropAfter
+        &&
+       gNetworkCtrlStub_obj.numChunks == gNetworkCtrlStub_obj.dropAfter)
+    {
+        printf("# STUB: Dropping connection at chunk %d\n", gNetworkCtrlStub_obj.numChunks);
+        gNetworkCtrlStub_obj.isDropConnection = TRUE;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+Bool ChunkIsCorrupt()
+{
+    if(gNetworkCtrlStub_obj.corruptEvery
+        &&
+       (gNetworkCtrlStub_obj.numChunks % gNetworkCtrlStub_obj.corruptEvery)==0)
+    {
+        printf("# STUB: Corrupting chunk %d\n", gNetworkCtrlStub_obj.numChunks);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* Same as NetworkCtrl_chunkRxStart() on target */
+int ChunkRxStart(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk,
+                 UInt32 prmSize, UInt32 maxTotalSize, UInt32 offsetAlign)
+{
+    UInt32 dataSize;
+    Bool isValid;
+
+    if(prmSize < sizeof(*pChunk))
+    {
+        handleUnsupported(gNetworkCtrlStub_obj.cmdBuf.cmd, prmSize);
+        return OSA_EFAIL;
+    }
+
+    ReadParams((UInt8*)pChunk, sizeof(*pChunk));
+
+    dataSize = prmSize - sizeof(*pChunk);
+
+    if(pChunk->flags & NETWORK_CTRL_CHUNK_FLAG_QUERY)
+    {
+        SkipParams(dataSize);
+
+        if(pChunk->addr != pRx->addr || pChunk->totalSize != pRx->totalSize)
+        {
+            pRx->addr = pChunk->addr;
+            pRx->totalSize = pChunk->totalSize;
+            pRx->nextOffset = 0;
+        }
+
+        ChunkRxAck(pRx, pChunk, OSA_SOK);
+        return OSA_EFAIL;
+    }
+
+    isValid = TRUE;
+
+    if(pChunk->size != dataSize
+        || pChunk->size == 0
+        || pChunk->size > NETWORK_CTRL_CHUNK_SIZE_MAX
+        || pChunk->totalSize > maxTotalSize
+        || pChunk->size > pChunk->totalSize
+        || pChunk->offset > pChunk->totalSize - pChunk->size
+        || (pChunk->offset % offsetAlign) != 0
+        )
+    {
+        isValid = FALSE;
+    }
+    else
+    if(pChunk->offset == 0)
+    {
+        pRx->addr = pChunk->addr;
+        pRx->totalSize = pChunk->totalSize;
+        pRx->nextOffset = 0;
+    }
+    else
+    if(pChunk->addr != pRx->addr
+        || pChunk->totalSize != pRx->totalSize
+        || pChunk->offset != pRx->nextOffset)
+    {
+        isValid = FALSE;
+    }
+
+    if(!isValid)
+    {
+        printf("# STUB: %s: Chunk @ %d of %d bytes NOT accepted, expected offset is %d !!!\n",
+            gNetworkCtrlStub_obj.cmdBuf.cmd, pChunk->offset, pChunk->size, pRx->nextOffset);
+
+        SkipParams(dataSize);
+        ChunkRxAck(pRx, pChunk, OSA_EFAIL);
+        return OSA_EFAIL;
+    }
+
+    return OSA_SOK;
+}
+
+int ChunkRxCheck(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData)
+{
+    if(pChunk->flags & NETWORK_CTRL_CHUNK_FLAG_CRC)
+    {
+        if(OSA_crc32(pData, pChunk->size) != pChunk->crc)
+        {
+            printf("# STUB: Chunk @ %d of %d bytes, CRC mismatch !!!\n",
+                pChunk->offset, pChunk->size);
+
+            return OSA_EFAIL;
+        }
+    }
+
+    pRx->nextOffset = pChunk->offset + pChunk->size;
+
+    gNetworkCtrlStub_obj.totalChunkData += pChunk->size;
+
+    return OSA_SOK;
+}
+
+int ChunkRxAck(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk, int status)
+{
+    pChunk->offset = pRx->nextOffset;
+    pChunk->size = 0;
+
+    return WriteChunk(pChunk, NULL, status==OSA_SOK ? 0 : (UInt32)-1);
+}
+
+void ServeConnection()
+{
+    UInt32 dataSize;
+    int i, status, numCmds;
+    Bool isCmdHandled;
+
+    numCmds = 0;
+
+    do
+    {
+        gNetworkCtrlStub_obj.keepConnection = FALSE;
+        gNetworkCtrlStub_obj.isDropConnection = FALSE;
+
+        dataSize = sizeof(gNetworkCtrlStub_obj.cmdBuf);
+
+        status = Network_read(&gNetworkCtrlStub_obj.sockObj,
+                    (UInt8*)&gNetworkCtrlStub_obj.cmdBuf, &dataSize);
+        if(status < 0)
+        {
+            /* client closed connection */
+            break;
+        }
+
+        if(gNetworkCtrlStub_obj.cmdBuf.header != NETWORK_CTRL_HEADER)
+        {
+            printf("# STUB: Invalid header received !!!\n");
+            break;
+        }
+
+        gNetworkCtrlStub_obj.cmdBuf.cmd[NETWORK_CTRL_CMD_STRLEN_MAX-1] = 0;
+
+        if((gNetworkCtrlStub_obj.cmdBuf.flags & NETWORK_CTRL_FLAG_KEEP_CONNECTION)
+            &&
+           !gNetworkCtrlStub_obj.isNoKeep)
+        {
+            gNetworkCtrlStub_obj.keepConnection = TRUE;
+        }
+
+        if(gNetworkCtrlStub_obj.isVerbose)
+        {
+            printf("# STUB: Received command [%s], with %d bytes of parameters\n",
+                gNetworkCtrlStub_obj.cmdBuf.cmd,
+                gNetworkCtrlStub_obj.cmdBuf.prmSize);
+        }
+
+        isCmdHandled = FALSE;
+        for(i=0; i<STUB_MAX_CMDS; i++)
+        {
+            if(gNetworkCtrlStub_obj.cmdHandler[i].handler
+                &&
+               strcmp(gNetworkCtrlStub_obj.cmdHandler[i].cmd, gNetworkCtrlStub_obj.cmdBuf.cmd)==0)
+            {
+                gNetworkCtrlStub_obj.cmdHandler[i].handler(
+                    gNetworkCtrlStub_obj.cmdBuf.cmd,
+                    gNetworkCtrlStub_obj.cmdBuf.prmSize);
+
+                isCmdHandled = TRUE;
+                break;
+            }
+        }
+
+        if(!isCmdHandled)
+        {
+            handleUnsupported(gNetworkCtrlStub_obj.cmdBuf.cmd, gNetworkCtrlStub_obj.cmdBuf.prmSize);
+        }
+
+        numCmds++;
+        gNetworkCtrlStub_obj.numCmds++;
+
+    } while(gNetworkCtrlStub_obj.keepConnection && !gNetworkCtrlStub_obj.isDropConnection);
+
+    printf("# STUB: Connection closed after %d commands (total %d commands, %d chunks, %.2f MB chunk data)\n",
+        numCmds,
+        gNetworkCtrlStub_obj.numCmds,
+        gNetworkCtrlStub_obj.numChunks,
+        (double)gNetworkCtrlStub_obj.totalChunkData/MB);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int status;
+
+    memset(&gNetworkCtrlStub_obj, 0, sizeof(gNetworkCtrlStub_obj));
+
+    ParseCmdLineArgs(argc, argv);
+    Init();
+
+    Network_init();
+
+    status = Network_listen(&gNetworkCtrlStub_obj.listenObj, gNetworkCtrlStub_obj.serverPort);
+    if(status < 0)
+    {
+        exit(0);
+    }
+
+    printf("# STUB: Listening on port %d, memory @ 0x%08x of %d MB\n",
+        gNetworkCtrlStub_obj.serverPort,
+        gNetworkCtrlStub_obj.memAddr,
+        gNetworkCtrlStub_obj.memSize/MB);
+    fflush(stdout);
+
+    while(1)
+    {
+        status = Network_accept(&gNetworkCtrlStub_obj.listenObj, &gNetworkCtrlStub_obj.sockObj);
+        if(status < 0)
+            break;
+
+        Network_setNoDelay(&gNetworkCtrlStub_obj.sockObj);
+
+        gNetworkCtrlStub_obj.numConnections++;
+
+        ServeConnection();
+
+        Network_close(&gNetworkCtrlStub_obj.sockObj);
+    }
+
+    Network_close(&gNetworkCtrlStub_obj.listenObj);
+    Network_deInit();
+
+    DeInit();
+
+    return 0;
+}
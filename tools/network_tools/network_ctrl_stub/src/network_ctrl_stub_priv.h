@@ -0,0 +1,160 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#ifndef _NETWORK_CTRL_STUB_PRIV_H_
+#define _NETWORK_CTRL_STUB_PRIV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <osa.h>
+#include <osa_file.h>
+#include <networkCtrl_if.h>
+#include <network_api.h>
+
+#define STUB_MAX_CMDS               (32)
+
+/* Emulated target memory, word at address A has value A */
+#define STUB_DEFAULT_MEM_ADDR       (0x80000000)
+#define STUB_DEFAULT_MEM_SIZE       (64*MB)
+
+/* Same limits as on target */
+#define STUB_QSPI_SIZE              (32*MB)
+#define STUB_QSPI_BLOCK_SIZE        (64*KB)
+#define STUB_DCC_FILE_SIZE          (100*KB)
+
+typedef void (*StubCmdHandler)(char *cmd, UInt32 prmSize);
+
+typedef struct {
+
+    char cmd[NETWORK_CTRL_CMD_STRLEN_MAX];
+
+    StubCmdHandler handler;
+
+} Stub_CmdHandler;
+
+/* Same as NetworkCtrl_ChunkRxObj on target */
+typedef struct {
+
+    UInt32 addr;
+
+    UInt32 totalSize;
+
+    UInt32 nextOffset;
+
+} Stub_ChunkRxObj;
+
+typedef struct {
+
+    UInt16 serverPort;
+    /**< Port on which to listen, default same as target */
+
+    Network_SockObj listenObj;
+
+    Network_SockObj sockObj;
+    /**< Connection to network_ctrl */
+
+    NetworkCtrl_CmdHeader cmdBuf;
+
+    Bool keepConnection;
+
+    Stub_CmdHandler cmdHandler[STUB_MAX_CMDS];
+
+    UInt32 memAddr;
+
+    UInt32 memSize;
+
+    UInt8 *pMem;
+
+    UInt8 *pQspi;
+
+    UInt8 *pDcc;
+
+    char qspiFile[1024];
+    /**< When set, data of a completed QSPI write is saved here */
+
+    char dccFile[1024];
+    /**< When set, a received DCC file is saved here */
+
+    Stub_ChunkRxObj qspiRx;
+
+    Stub_ChunkRxObj dccSendRx;
+
+    Stub_ChunkRxObj dccSaveRx;
+
+    Bool isLegacy;
+    /**< Emulate a target without "_chunk" commands */
+
+    Bool isNoKeep;
+    /**< Emulate a target which closes the connection after every command */
+
+    int corruptEvery;
+    /**< Corrupt data of every Nth chunk, 0: never */
+
+    int dropAfter;
+    /**< Close the connection without ACK after N chunks, 0: never */
+
+    Bool isDropConnection;
+
+    Bool isVerbose;
+
+    int numChunks;
+
+    int numConnections;
+
+    int numCmds;
+
+    unsigned long long totalChunkData;
+
+} NetworkCtrlStub_Obj;
+
+extern NetworkCtrlStub_Obj gNetworkCtrlStub_obj;
+
+void ShowUsage();
+void ParseCmdLineArgs(int argc, char *argv[]);
+void Init();
+void DeInit();
+void RegisterHandler(char *cmd, StubCmdHandler handler);
+void ServeConnection();
+
+int  ReadParams(UInt8 *pPrm, UInt32 prmSize);
+void SkipParams(UInt32 prmSize);
+int  WriteAck(UInt32 prmSize, UInt32 returnStatus, UInt8 *pPrm0, UInt32 prmSize0, UInt8 *pPrm1, UInt32 prmSize1);
+int  WriteParams(UInt8 *pPrm, UInt32 prmSize, UInt32 returnStatus);
+int  WriteChunk(NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData, UInt32 returnStatus);
+
+int  ChunkRxStart(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk,
+                  UInt32 prmSize, UInt32 maxTotalSize, UInt32 offsetAlign);
+int  ChunkRxCheck(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk, UInt8 *pData);
+int  ChunkRxAck(Stub_ChunkRxObj *pRx, NetworkCtrl_ChunkHeader *pChunk, int status);
+Bool ChunkIsDrop();
+Bool ChunkIsCorrupt();
+
+void handleUnsupported(char *cmd, UInt32 prmSize);
+void handleEcho(char *cmd, UInt32 prmSize);
+void handleMemRd(char *cmd, UInt32 prmSize);
+void handleMemWr(char *cmd, UInt32 prmSize);
+void handleMemSave(char *cmd, UInt32 prmSize);
+void handleMemSaveChunk(char *cmd, UInt32 prmSize);
+void handleQspiWrite(char *cmd, UInt32 prmSize);
+void handleQspiWriteChunk(char *cmd, UInt32 prmSize);
+void handleIssSendDccFile(char *cmd, UInt32 prmSize);
+void handleIssSaveDccFile(char *cmd, UInt32 prmSize);
+void handleIssSendDccFileChunk(char *cmd, UInt32 prmSize);
+void handleIssSaveDccFileChunk(char *cmd, UInt32 prmSize);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
@@ -0,0 +1,161 @@
+#!/bin/bash
+#
+# (c) Texas Instruments 2016
+#
+# Throughput and latency benchmark of network_rx and network_tx on
+# localhost, against network_link_stub emulating the network links on target.
+#
+# network_bench.sh [-b <dir with network_rx, network_tx, network_link_stub>]
+#                  [-d <secs per case>] [-c "<channel counts>"] [-f "<fps values>"]
+#                  [-o <dir for network_rx output files, default: discard>] [-z]
+#
+# For every format/resolution, channel count and frame rate, both directions
+# are run and one line is printed per case:
+#   tx: network_link_stub --mode tx -> network_rx
+#   rx: network_tx -> network_link_stub --mode rx
+# fps 0 measures max throughput, other values the latency at that rate.
+# -z sends YUV frames losslessly compressed in both directions, ratio is
+# printed for every case.
+#
+
+BIN_DIR=$(dirname "$0")/../bin
+DURATION=5
+CH_LIST="1 4"
+FPS_LIST="0 30"
+OUT_DIR=
+COMPRESS=
+PORT_RX=16000
+PORT_TX=17000
+
+CASES="yuv420sp:1280:720 yuv420sp:1920:1080 yuv422i:1920:1080 mjpeg:1920:1080"
+
+while getopts "b:d:c:f:o:z" opt; do
+    case $opt in
+        b) BIN_DIR=$OPTARG ;;
+        d) DURATION=$OPTARG ;;
+        c) CH_LIST=$OPTARG ;;
+        f) FPS_LIST=$OPTARG ;;
+        o) OUT_DIR=$OPTARG ;;
+        z) COMPRESS=--compress ;;
+        *) sed -n '2,20p' "$0"; exit 1 ;;
+    esac
+done
+
+find_tool()
+{
+    for f in "$BIN_DIR/$1" "$BIN_DIR/$1.out" "$BIN_DIR/$1.exe"; do
+        if [ -x "$f" ]; then
+            echo "$f"
+            return
+        fi
+    done
+    echo "# ERROR: $1 not found in $BIN_DIR, use -b <dir>" >&2
+    exit 1
+}
+
+STUB=$(find_tool network_link_stub) || exit 1
+RX=$(find_tool network_rx) || exit 1
+TX=$(find_tool network_tx) || exit 1
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+# Input file of 8 frames for network_tx
+make_input()
+{
+    local format=$1 width=$2 height=$3 file=$4
+    local size i
+
+    if [ "$format" = "yuv422i" ]; then
+        head -c $((width*height*2*8)) /dev/urandom > "$file"
+    elif [ "$format" = "mjpeg" ]; then
+        # SOI, filler and EOI, same size as generated by the stub
+        size=$((width*height*3/2/10 - 4))
+        : > "$file"
+        for i in 1 2 3 4 5 6 7 8; do
+            printf '\xff\xd8' >> "$file"
+            head -c $size /dev/zero >> "$file"
+            printf '\xff\xd9' >> "$file"
+        done
+    else
+        head -c $((width*height*3/2*8)) /dev/urandom > "$file"
+    fi
+}
+
+# Prints "<MB/s> <fps> <dropped> <lat avg> <p50> <p99> <max> <ratio>" from BENCH line
+parse_bench()
+{
+    grep "^# BENCH:" "$1" | tr ' ' '\n' | awk -F= '
+        $1=="MBps"{m=$2} $1=="fpsActual"{f=$2} $1=="dropped"{d=$2}
+        $1=="latAvgMs"{a=$2} $1=="latP50Ms"{p=$2} $1=="latP99Ms"{q=$2} $1=="latMaxMs"{x=$2}
+        $1=="ratio"{r=$2}
+        END { if (m=="") print "FAILED"; else printf "%9s %8s %7s %8s %8s %8s %8s %6s", m, f, d, a, p, q, x, r }'
+}
+
+run_tx()
+{
+    local format=$1 width=$2 height=$3 ch=$4 fps=$5
+    local files="" i stubPid
+
+    for i in $(seq 0 $((ch-1))); do
+        if [ -n "$OUT_DIR" ]; then
+            files="$files $OUT_DIR/bench_ch$i.bin"
+        else
+            files="$files /dev/null"
+        fi
+    done
+
+    "$STUB" --mode tx --port $PORT_TX --ch $ch --format $format --width $width --height $height \
+        --fps $fps --duration $DURATION $COMPRESS > "$TMP_DIR/stub.log" 2>&1 &
+    stubPid=$!
+    sleep 0.5
+
+    "$RX" --ipaddr 127.0.0.1 --port $PORT_TX --files $files > "$TMP_DIR/rx.log" 2>&1
+    wait $stubPid
+
+    parse_bench "$TMP_DIR/stub.log"
+}
+
+run_rx()
+{
+    local format=$1 width=$2 height=$3 ch=$4 fps=$5
+    local files="" i stubPid txPid
+
+    for i in $(seq 0 $((ch-1))); do
+        files="$files $TMP_DIR/input.bin"
+    done
+
+    "$STUB" --mode rx --port $PORT_RX --ch $ch --format $format --width $width --height $height \
+        --fps $fps --duration $DURATION $COMPRESS > "$TMP_DIR/stub.log" 2>&1 &
+    stubPid=$!
+    sleep 0.5
+
+    "$TX" --ipaddr 127.0.0.1 --port $PORT_RX $COMPRESS --files $files > "$TMP_DIR/tx.log" 2>&1 &
+    txPid=$!
+
+    wait $stubPid
+    # network_tx reconnects forever, stop it once the stub is done
+    kill $txPid 2>/dev/null
+    wait $txPid 2>/dev/null
+
+    parse_bench "$TMP_DIR/stub.log"
+}
+
+printf "%-4s %-9s %-10s %3s %5s %9s %8s %7s %8s %8s %8s %8s %6s\n" \
+    dir format size ch fps "MB/s" "fps" drops "lat avg" "lat p50" "lat p99" "lat max" ratio
+
+for c in $CASES; do
+    IFS=: read format width height <<< "$c"
+
+    make_input $format $width $height "$TMP_DIR/input.bin"
+
+    for ch in $CH_LIST; do
+        for fps in $FPS_LIST; do
+            for dir in tx rx; do
+                printf "%-4s %-9s %-10s %3d %5s " $dir $format ${width}x${height} $ch $fps
+                run_$dir $format $width $height $ch $fps
+                echo
+            done
+        done
+    done
+done
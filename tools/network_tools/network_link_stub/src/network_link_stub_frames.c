@@ -0,0 +1,322 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Frame exchange of the emulated links, same header and payload layout as
+ * NullLink_networkTxSendData() and NullSrcLink_networkRxFillData() on target
+ */
+
+#include "network_link_stub_priv.h"
+
+/* Moving diagonal ramp, so that frames can be viewed and are not all same */
+static void GenerateYuvPattern(UInt8 *pBuf, UInt32 pattern)
+{
+    UInt32 x, y, shift;
+    UInt8 *pLine;
+
+    shift = pattern*(gNetworkLinkStub_obj.width/NUM_PATTERN_FRAMES);
+
+    for(y=0; y<gNetworkLinkStub_obj.height; y++)
+    {
+        pLine = pBuf + y*gNetworkLinkStub_obj.pitch[0];
+
+        if(gNetworkLinkStub_obj.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV)
+        {
+            for(x=0; x<gNetworkLinkStub_obj.width; x++)
+            {
+                pLine[2*x]   = (UInt8)(x + y + shift);
+                pLine[2*x+1] = 128;
+            }
+        }
+        else
+        {
+            for(x=0; x<gNetworkLinkStub_obj.width; x++)
+            {
+                pLine[x] = (UInt8)(x + y + shift);
+            }
+        }
+    }
+
+    if(gNetworkLinkStub_obj.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        memset(pBuf + gNetworkLinkStub_obj.pitch[0]*gNetworkLinkStub_obj.height,
+            128,
+            gNetworkLinkStub_obj.pitch[1]*gNetworkLinkStub_obj.height/2);
+    }
+}
+
+/* Not a decodable picture, only SOI/EOI markers so that tools which split
+ * the stream at markers see one frame
+ */
+static void GenerateMjpegPattern(UInt8 *pBuf, UInt32 pattern)
+{
+    UInt32 i, size;
+
+    size = gNetworkLinkStub_obj.frameSize;
+
+    for(i=2; i<size-2; i++)
+    {
+        pBuf[i] = (UInt8)((i + pattern) % 0xFF);
+    }
+
+    pBuf[0] = 0xFF;
+    pBuf[1] = 0xD8;
+    pBuf[size-2] = 0xFF;
+    pBuf[size-1] = 0xD9;
+}
+
+void GeneratePatterns()
+{
+    int i;
+
+    for(i=0; i<NUM_PATTERN_FRAMES; i++)
+    {
+        gNetworkLinkStub_obj.patternBuf[i] = malloc(gNetworkLinkStub_obj.frameSize);
+        if(gNetworkLinkStub_obj.patternBuf[i]==NULL)
+        {
+            printf("# ERROR: Unable to allocate memory for frames !!! \n");
+            exit(0);
+        }
+
+        if(gNetworkLinkStub_obj.payloadType==NETWORK_RX_TYPE_BITSTREAM_MJPEG)
+        {
+            GenerateMjpegPattern(gNetworkLinkStub_obj.patternBuf[i], i);
+        }
+        else
+        {
+            GenerateYuvPattern(gNetworkLinkStub_obj.patternBuf[i], i);
+        }
+    }
+}
+
+/* Compressed patterns are sent instead of the patterns when smaller, same
+ * as NullLink_networkTxCompress() on target
+ */
+void CompressPatterns()
+{
+    UInt8 *srcAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 maxSize, encSize;
+    Uint64 startTime;
+    int i, status;
+
+    maxSize = NetworkCodec_getMaxSize(gNetworkLinkStub_obj.payloadType,
+                gNetworkLinkStub_obj.width,
+                gNetworkLinkStub_obj.height);
+    if(maxSize==0)
+        return;
+
+    for(i=0; i<NUM_PATTERN_FRAMES; i++)
+    {
+        gNetworkLinkStub_obj.encPatternBuf[i] = malloc(maxSize);
+        if(gNetworkLinkStub_obj.encPatternBuf[i]==NULL)
+        {
+            printf("# ERROR: Unable to allocate memory for frames !!! \n");
+            exit(0);
+        }
+
+        srcAddr[0] = gNetworkLinkStub_obj.patternBuf[i];
+        srcAddr[1] = gNetworkLinkStub_obj.patternBuf[i]
+                        + gNetworkLinkStub_obj.pitch[0]*gNetworkLinkStub_obj.height;
+
+        startTime = OSA_getCurTimeInUsec();
+
+        status = NetworkCodec_encode(gNetworkLinkStub_obj.payloadType,
+                    gNetworkLinkStub_obj.width,
+                    gNetworkLinkStub_obj.height,
+                    srcAddr,
+                    gNetworkLinkStub_obj.pitch,
+                    gNetworkLinkStub_obj.encPatternBuf[i],
+                    maxSize,
+                    &encSize);
+
+        gNetworkLinkStub_obj.codecTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+        gNetworkLinkStub_obj.codecDataSize += gNetworkLinkStub_obj.frameSize;
+
+        if(status!=OSA_SOK || encSize >= gNetworkLinkStub_obj.frameSize)
+        {
+            free(gNetworkLinkStub_obj.encPatternBuf[i]);
+            gNetworkLinkStub_obj.encPatternBuf[i] = NULL;
+            continue;
+        }
+
+        gNetworkLinkStub_obj.encPatternSize[i] = encSize;
+    }
+}
+
+/* Decompress received frame from dataBuf to decBuf, same as
+ * NullSrcLink_networkRxReadCompressed() on target
+ */
+int DecompressFrame(NetworkLinkStub_ChObj *pChObj, NetworkRx_CmdHeader *pHeader)
+{
+    UInt8 *dstAddr[NETWORK_CODEC_MAX_PLANES];
+    Uint64 startTime;
+    int status;
+
+    dstAddr[0] = pChObj->decBuf;
+    dstAddr[1] = pChObj->decBuf
+                    + gNetworkLinkStub_obj.pitch[0]*gNetworkLinkStub_obj.height;
+
+    startTime = OSA_getCurTimeInUsec();
+
+    status = NetworkCodec_decode(pChObj->dataBuf,
+                pHeader->dataSize,
+                gNetworkLinkStub_obj.payloadType,
+                gNetworkLinkStub_obj.width,
+                gNetworkLinkStub_obj.height,
+                dstAddr,
+                gNetworkLinkStub_obj.pitch);
+
+    gNetworkLinkStub_obj.codecTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+    if(status!=OSA_SOK)
+    {
+        if(gNetworkLinkStub_obj.codecErrorCount==0)
+        {
+            printf("# ERROR: CH%d: Invalid compressed frame of %d bytes !!!\n",
+                pChObj->chId,
+                pHeader->dataSize);
+        }
+        gNetworkLinkStub_obj.codecErrorCount++;
+        return -1;
+    }
+
+    gNetworkLinkStub_obj.codecDataSize += gNetworkLinkStub_obj.frameSize;
+
+    return 0;
+}
+
+static void InitHeader(NetworkRx_CmdHeader *pHeader, UInt32 magic, int chId)
+{
+    memset(pHeader, 0, sizeof(*pHeader));
+
+    pHeader->header = magic;
+    pHeader->payloadType = gNetworkLinkStub_obj.payloadType;
+    pHeader->chNum = chId;
+    pHeader->dataSize = gNetworkLinkStub_obj.frameSize;
+
+    /* target sets frame info only for video frames */
+    if(gNetworkLinkStub_obj.payloadType!=NETWORK_RX_TYPE_BITSTREAM_MJPEG)
+    {
+        pHeader->width = gNetworkLinkStub_obj.width;
+        pHeader->height = gNetworkLinkStub_obj.height;
+        pHeader->pitch[0] = gNetworkLinkStub_obj.pitch[0];
+        pHeader->pitch[1] = gNetworkLinkStub_obj.pitch[1];
+    }
+}
+
+/* TX link: send header and payload of one frame, latency is from capture
+ * time of the frame till its last byte is accepted by the socket, so it
+ * includes the time the client took to drain previous frames
+ */
+int SendFrame(NetworkLinkStub_ChObj *pChObj, UInt32 frameNum, Uint64 captureTime)
+{
+    NetworkRx_CmdHeader cmdHeader;
+    UInt8 *bufAddr[2];
+    UInt32 bufSize[2];
+    UInt32 pattern;
+    Int32 status;
+
+    InitHeader(&cmdHeader, NETWORK_TX_HEADER, pChObj->chId);
+
+    pattern = frameNum % NUM_PATTERN_FRAMES;
+
+    bufAddr[0] = (UInt8*)&cmdHeader;
+    bufSize[0] = sizeof(cmdHeader);
+    bufAddr[1] = gNetworkLinkStub_obj.patternBuf[pattern];
+
+    if(gNetworkLinkStub_obj.encPatternBuf[pattern])
+    {
+        cmdHeader.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED;
+        cmdHeader.dataSize = gNetworkLinkStub_obj.encPatternSize[pattern];
+        bufAddr[1] = gNetworkLinkStub_obj.encPatternBuf[pattern];
+    }
+
+    bufSize[1] = cmdHeader.dataSize;
+
+    status = Network_writev(&gNetworkLinkStub_obj.sockObj, bufAddr, bufSize, 2);
+    if(status!=0)
+        return NETWORK_ERROR;
+
+    AddLatency(pChObj, OSA_getCurTimeInUsec() - captureTime);
+
+    pChObj->totalFrames++;
+    pChObj->totalDataSize += cmdHeader.dataSize;
+    gNetworkLinkStub_obj.rawDataSize += gNetworkLinkStub_obj.frameSize;
+
+    return 0;
+}
+
+/* RX link: request a frame and receive it, latency is from request till
+ * last byte of the frame is received
+ */
+int RecvFrame(NetworkLinkStub_ChObj *pChObj)
+{
+    NetworkRx_CmdHeader cmdHeader;
+    UInt32 dataSize, rawSize;
+    Uint64 requestTime;
+    Int32 status;
+
+    InitHeader(&cmdHeader, NETWORK_RX_HEADER, pChObj->chId);
+
+    requestTime = OSA_getCurTimeInUsec();
+
+    status = Network_write(&gNetworkLinkStub_obj.sockObj, (UInt8*)&cmdHeader, sizeof(cmdHeader));
+    if(status!=0)
+        return NETWORK_ERROR;
+
+    dataSize = sizeof(cmdHeader);
+    status = Network_read(&gNetworkLinkStub_obj.sockObj, (UInt8*)&cmdHeader, &dataSize);
+    if(status!=0)
+        return NETWORK_ERROR;
+
+    if(cmdHeader.header!=NETWORK_RX_HEADER
+        ||
+       cmdHeader.dataSize > gNetworkLinkStub_obj.frameSize
+        ||
+       (cmdHeader.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED
+            && pChObj->decBuf==NULL))
+    {
+        /* payload can not be skipped reliably, same as a failed read on target */
+        printf("# ERROR: CH%d: Invalid header received (header=0x%08x, dataSize=%d) !!!\n",
+            pChObj->chId,
+            cmdHeader.header,
+            cmdHeader.dataSize);
+        return NETWORK_INVALID_HEADER;
+    }
+
+    if(cmdHeader.dataSize==0)
+    {
+        /* client has no data for this CH, target requests again */
+        pChObj->emptyCount++;
+        return 0;
+    }
+
+    dataSize = cmdHeader.dataSize;
+    status = Network_read(&gNetworkLinkStub_obj.sockObj, pChObj->dataBuf, &dataSize);
+    if(status!=0)
+        return NETWORK_ERROR;
+
+    rawSize = cmdHeader.dataSize;
+    if(cmdHeader.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED)
+    {
+        /* frame is dropped on error, like on target */
+        if(DecompressFrame(pChObj, &cmdHeader)!=0)
+            return 0;
+
+        rawSize = gNetworkLinkStub_obj.frameSize;
+    }
+
+    AddLatency(pChObj, OSA_getCurTimeInUsec() - requestTime);
+
+    pChObj->totalFrames++;
+    pChObj->totalDataSize += cmdHeader.dataSize;
+    gNetworkLinkStub_obj.rawDataSize += rawSize;
+
+    return 0;
+}
@@ -0,0 +1,677 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Loopback stub of the network links on target. It listens like the
+ * network RX (NullSrc) or network TX (Null) link, exchanges synthetic frames
+ * of configurable format, resolution and rate with network_tx or network_rx
+ * and reports throughput and frame latency. Channels are served one frame
+ * at a time in order of their frame time, like the link serves its queue.
+ */
+
+#include "network_link_stub_priv.h"
+
+NetworkLinkStub_Obj gNetworkLinkStub_obj;
+
+void ShowUsage()
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# network_link_stub --mode <rx|tx> [--port <server port>] [--ch <num channels>]\n");
+    printf("#                   [--format <yuv420sp|yuv422i|mjpeg>] [--width <width>] [--height <height>]\n");
+    printf("#                   [--fps <fps>] [--bufs <frames>] [--duration <secs>] [--frames <frames>] [--compress] [--verbose]\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2016\n");
+    printf("# \n");
+    printf("#   --mode      rx: emulate network RX link, receive frames from network_tx (default port %d)\n", NETWORK_RX_SERVER_PORT);
+    printf("#               tx: emulate network TX link, send frames to network_rx (default port %d)\n", NETWORK_TX_SERVER_PORT);
+    printf("#   --ch        Number of channels, max %d (default 1)\n", MAX_CH);
+    printf("#   --format    Payload type (default yuv420sp). For mjpeg, tx sends frames of 1/%d\n", MJPEG_COMPRESSION_RATIO);
+    printf("#               of YUV420SP size, rx requests upto YUV420SP size\n");
+    printf("#   --width     Frame width (default %d)\n", DEFAULT_WIDTH);
+    printf("#   --height    Frame height (default %d)\n", DEFAULT_HEIGHT);
+    printf("#   --fps       Frame rate of every channel, 0: as fast as possible (default %d)\n", DEFAULT_FPS);
+    printf("#   --bufs      Frames a channel can fall behind before frames are dropped (default %d)\n", DEFAULT_NUM_BUF);
+    printf("#   --duration  Stop after this time, 0: when client disconnects (default %d)\n", DEFAULT_DURATION_SEC);
+    printf("#   --frames    Stop after this many frames per channel, 0: no limit (default 0)\n");
+    printf("#   --compress  tx: send YUV frames losslessly compressed, rx: accept compressed\n");
+    printf("#               YUV frames, i.e 'network_tx --compress'\n");
+    printf("# \n");
+    printf("# Latency in tx mode is from capture time of a frame till it is sent, in\n");
+    printf("# rx mode from request of a frame till it is received.\n");
+    printf("# \n");
+    exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    int status;
+
+    ParseCmdLineArgs(argc, argv);
+    Init();
+
+    status = Network_listen(&gNetworkLinkStub_obj.listenObj, gNetworkLinkStub_obj.serverPort);
+    if(status==0)
+    {
+        printf("# Waiting for %s on port %d ...\n",
+            gNetworkLinkStub_obj.mode==STUB_MODE_RX ? "network_tx" : "network_rx",
+            gNetworkLinkStub_obj.serverPort);
+
+        status = Network_accept(&gNetworkLinkStub_obj.listenObj, &gNetworkLinkStub_obj.sockObj);
+        if(status==0)
+        {
+            Network_setNoDelay(&gNetworkLinkStub_obj.sockObj);
+
+            RunLink();
+
+            Network_close(&gNetworkLinkStub_obj.sockObj);
+
+            PrintStatistics(TRUE);
+        }
+        Network_close(&gNetworkLinkStub_obj.listenObj);
+    }
+
+    DeInit();
+    return 0;
+}
+
+void Init()
+{
+    int i;
+    NetworkLinkStub_ChObj *pChObj;
+
+    Network_init();
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        pChObj = &gNetworkLinkStub_obj.chObj[i];
+
+        pChObj->chId = i;
+        pChObj->maxLatencySamples = LATENCY_INIT_SAMPLES;
+        pChObj->latency = malloc(pChObj->maxLatencySamples*sizeof(Uint32));
+
+        if(gNetworkLinkStub_obj.mode==STUB_MODE_RX)
+        {
+            pChObj->dataBuf = malloc(gNetworkLinkStub_obj.frameSize);
+
+            if(gNetworkLinkStub_obj.isCompress)
+            {
+                pChObj->decBuf = calloc(1, gNetworkLinkStub_obj.frameSize);
+            }
+        }
+
+        if(pChObj->latency==NULL
+            ||
+           (gNetworkLinkStub_obj.mode==STUB_MODE_RX && pChObj->dataBuf==NULL)
+            ||
+           (gNetworkLinkStub_obj.mode==STUB_MODE_RX
+                && gNetworkLinkStub_obj.isCompress && pChObj->decBuf==NULL))
+        {
+            printf("# ERROR: Unable to allocate memory for CH%d !!! \n", i);
+            exit(0);
+        }
+    }
+
+    if(gNetworkLinkStub_obj.mode==STUB_MODE_TX)
+    {
+        GeneratePatterns();
+
+        if(gNetworkLinkStub_obj.isCompress)
+        {
+            CompressPatterns();
+        }
+    }
+}
+
+void DeInit()
+{
+    int i;
+
+    Network_deInit();
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        free(gNetworkLinkStub_obj.chObj[i].latency);
+        if(gNetworkLinkStub_obj.chObj[i].dataBuf)
+            free(gNetworkLinkStub_obj.chObj[i].dataBuf);
+        if(gNetworkLinkStub_obj.chObj[i].decBuf)
+            free(gNetworkLinkStub_obj.chObj[i].decBuf);
+    }
+
+    for(i=0; i<NUM_PATTERN_FRAMES; i++)
+    {
+        if(gNetworkLinkStub_obj.patternBuf[i])
+            free(gNetworkLinkStub_obj.patternBuf[i]);
+        if(gNetworkLinkStub_obj.encPatternBuf[i])
+            free(gNetworkLinkStub_obj.encPatternBuf[i]);
+    }
+}
+
+void AddLatency(NetworkLinkStub_ChObj *pChObj, Uint64 latency)
+{
+    Uint32 *pLatency;
+    UInt32 numSamples;
+
+    numSamples = pChObj->totalFrames;
+
+    if(numSamples >= pChObj->maxLatencySamples)
+    {
+        pLatency = realloc(pChObj->latency, 2*pChObj->maxLatencySamples*sizeof(Uint32));
+        if(pLatency==NULL)
+        {
+            printf("# ERROR: Unable to allocate memory for latency samples !!! \n");
+            exit(0);
+        }
+
+        pChObj->latency = pLatency;
+        pChObj->maxLatencySamples *= 2;
+    }
+
+    pChObj->latency[numSamples] = latency > 0xFFFFFFFFu ? 0xFFFFFFFFu : (Uint32)latency;
+
+    if(gNetworkLinkStub_obj.isVerbose)
+    {
+        printf("# INFO: CH%d: Frame%d: latency %7.2f ms\n",
+            pChObj->chId,
+            pChObj->totalFrames,
+            latency/1000.0);
+    }
+}
+
+/* Channel whose next frame is due first, NULL when all are done */
+static NetworkLinkStub_ChObj *GetNextChannel()
+{
+    NetworkLinkStub_ChObj *pChObj, *pNextChObj;
+    int i;
+
+    pNextChObj = NULL;
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        pChObj = &gNetworkLinkStub_obj.chObj[i];
+
+        if(gNetworkLinkStub_obj.maxFrames
+            &&
+           pChObj->totalFrames >= gNetworkLinkStub_obj.maxFrames)
+        {
+            continue;
+        }
+
+        if(pNextChObj==NULL || pChObj->dueTime < pNextChObj->dueTime)
+        {
+            pNextChObj = pChObj;
+        }
+    }
+
+    return pNextChObj;
+}
+
+static void WaitTill(Uint64 waitTime)
+{
+    Uint64 curTime;
+
+    curTime = OSA_getCurTimeInUsec();
+
+    while(curTime < waitTime)
+    {
+        if(waitTime - curTime > PACING_POLL_USEC)
+            usleep(waitTime - curTime - PACING_POLL_USEC);
+        else
+            usleep(0);
+
+        curTime = OSA_getCurTimeInUsec();
+    }
+}
+
+int RunLink()
+{
+    NetworkLinkStub_ChObj *pChObj;
+    Uint64 curTime, endTime, interval, captureTime;
+    int i, status = 0;
+
+    gNetworkLinkStub_obj.startTime = OSA_getCurTimeInUsec();
+    gNetworkLinkStub_obj.lastPrintTime = gNetworkLinkStub_obj.startTime;
+
+    endTime = 0;
+    if(gNetworkLinkStub_obj.durationSec)
+    {
+        endTime = gNetworkLinkStub_obj.startTime + gNetworkLinkStub_obj.durationSec*1000000ULL;
+    }
+
+    interval = 0;
+    if(gNetworkLinkStub_obj.fps > 0)
+    {
+        interval = (Uint64)(1000000.0/gNetworkLinkStub_obj.fps);
+    }
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        gNetworkLinkStub_obj.chObj[i].dueTime = gNetworkLinkStub_obj.startTime;
+    }
+
+    while(1)
+    {
+        pChObj = GetNextChannel();
+        if(pChObj==NULL)
+            break;
+
+        if(endTime && pChObj->dueTime >= endTime)
+            break;
+
+        WaitTill(pChObj->dueTime);
+
+        curTime = OSA_getCurTimeInUsec();
+        if(endTime && curTime >= endTime)
+            break;
+
+        if(interval)
+        {
+            /* like a capture source, frames for which there is no free
+             * buffer are dropped
+             */
+            while(curTime - pChObj->dueTime > gNetworkLinkStub_obj.numBuf*interval)
+            {
+                pChObj->dueTime += interval;
+                pChObj->dropCount++;
+            }
+            captureTime = pChObj->dueTime;
+        }
+        else
+        {
+            captureTime = curTime;
+        }
+
+        if(gNetworkLinkStub_obj.mode==STUB_MODE_TX)
+        {
+            status = SendFrame(pChObj, pChObj->totalFrames + pChObj->dropCount, captureTime);
+        }
+        else
+        {
+            status = RecvFrame(pChObj);
+        }
+
+        if(status!=0)
+        {
+            printf("# INFO: Connection closed by client\n");
+            break;
+        }
+
+        if(interval)
+        {
+            pChObj->dueTime += interval;
+        }
+        else
+        {
+            /* served last, so that channels are served round robin */
+            pChObj->dueTime = OSA_getCurTimeInUsec();
+        }
+
+        PrintStatistics(FALSE);
+    }
+
+    return status;
+}
+
+static int CompareLatency(const void *a, const void *b)
+{
+    Uint32 x = *(const Uint32*)a;
+    Uint32 y = *(const Uint32*)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Latency percentile in msecs of sorted samples */
+static double GetPercentile(Uint32 *pLatency, UInt32 numSamples, UInt32 percent)
+{
+    UInt32 idx;
+
+    if(numSamples==0)
+        return 0.0;
+
+    idx = (UInt32)(((Uint64)numSamples*percent)/100);
+    if(idx >= numSamples)
+        idx = numSamples - 1;
+
+    return pLatency[idx]/1000.0;
+}
+
+/* Prints latency statistics and returns average in msecs, sorts samples */
+static double PrintLatency(char *name, Uint32 *pLatency, UInt32 numSamples)
+{
+    Uint64 sum;
+    UInt32 i;
+    double avg;
+
+    sum = 0;
+    for(i=0; i<numSamples; i++)
+    {
+        sum += pLatency[i];
+    }
+
+    avg = numSamples ? sum/1000.0/numSamples : 0.0;
+
+    qsort(pLatency, numSamples, sizeof(Uint32), CompareLatency);
+
+    printf("# INFO: %s: Latency avg %7.2f, min %7.2f, p50 %7.2f, p99 %7.2f, max %7.2f ms\n",
+        name,
+        avg,
+        GetPercentile(pLatency, numSamples, 0),
+        GetPercentile(pLatency, numSamples, 50),
+        GetPercentile(pLatency, numSamples, 99),
+        GetPercentile(pLatency, numSamples, 100)
+        );
+
+    return avg;
+}
+
+void PrintStatistics(Bool isFinal)
+{
+    Uint64 curTime;
+    double elapsedSec, intervalSec;
+    int i, frames, totalFrames, totalDrops;
+    unsigned long long totalDataSize;
+    Uint32 *pAllLatency;
+    UInt32 numSamples;
+    double avgLatency;
+    NetworkLinkStub_ChObj *pChObj;
+    char name[32];
+
+    curTime = OSA_getCurTimeInUsec();
+
+    if(!isFinal
+        &&
+       curTime - gNetworkLinkStub_obj.lastPrintTime < STATS_PRINT_INTERVAL_MSEC*1000ULL)
+    {
+        return;
+    }
+
+    elapsedSec  = (curTime - gNetworkLinkStub_obj.startTime)/1000000.0;
+    intervalSec = (curTime - gNetworkLinkStub_obj.lastPrintTime)/1000000.0;
+
+    if(isFinal)
+    {
+        printf("# \n");
+        printf("# INFO: Connection closed after %8.2f secs\n", elapsedSec);
+    }
+
+    totalFrames = 0;
+    totalDrops = 0;
+    totalDataSize = 0;
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        pChObj = &gNetworkLinkStub_obj.chObj[i];
+
+        frames = pChObj->totalFrames - pChObj->lastPrintFrames;
+
+        if(isFinal)
+        {
+            printf("# INFO: DATA: CH%d: %d frames, %10.2f MB, avg %8.2f fps, %8.2f MB/s, dropped %d frames, %d empty replies\n",
+                i,
+                pChObj->totalFrames,
+                pChObj->totalDataSize/(1024.0*1024),
+                elapsedSec > 0 ? pChObj->totalFrames/elapsedSec : 0.0,
+                elapsedSec > 0 ? pChObj->totalDataSize/(1024.0*1024)/elapsedSec : 0.0,
+                pChObj->dropCount,
+                pChObj->emptyCount
+                );
+        }
+        else
+        {
+            printf("# INFO: DATA: CH%d: %8.2f fps, %8.2f MB/s, last latency %7.2f ms, dropped %d frames\n",
+                i,
+                intervalSec > 0 ? frames/intervalSec : 0.0,
+                intervalSec > 0 ?
+                    (pChObj->totalDataSize - pChObj->lastPrintDataSize)/(1024.0*1024)/intervalSec
+                    : 0.0,
+                pChObj->totalFrames ? pChObj->latency[pChObj->totalFrames-1]/1000.0 : 0.0,
+                pChObj->dropCount
+                );
+        }
+
+        pChObj->lastPrintFrames = pChObj->totalFrames;
+        pChObj->lastPrintDataSize = pChObj->totalDataSize;
+
+        totalFrames += pChObj->totalFrames;
+        totalDrops += pChObj->dropCount;
+        totalDataSize += pChObj->totalDataSize;
+    }
+
+    gNetworkLinkStub_obj.lastPrintTime = curTime;
+
+    if(!isFinal)
+        return;
+
+    /* latency of all channels together, then of each channel */
+    pAllLatency = malloc((totalFrames + 1)*sizeof(Uint32));
+    numSamples = 0;
+
+    for(i=0; i<gNetworkLinkStub_obj.numCh; i++)
+    {
+        pChObj = &gNetworkLinkStub_obj.chObj[i];
+
+        if(pAllLatency)
+        {
+            memcpy(pAllLatency + numSamples, pChObj->latency, pChObj->totalFrames*sizeof(Uint32));
+            numSamples += pChObj->totalFrames;
+        }
+
+        snprintf(name, sizeof(name), "CH%d", i);
+        PrintLatency(name, pChObj->latency, pChObj->totalFrames);
+    }
+
+    avgLatency = 0.0;
+    if(pAllLatency)
+    {
+        avgLatency = PrintLatency("ALL", pAllLatency, numSamples);
+    }
+
+    if(gNetworkLinkStub_obj.isCompress)
+    {
+        printf("# INFO: CODEC: ratio %6.2f, %s %8.2f MB/s, invalid %d frames\n",
+            totalDataSize ? (double)gNetworkLinkStub_obj.rawDataSize/totalDataSize : 0.0,
+            gNetworkLinkStub_obj.mode==STUB_MODE_RX ? "decompression" : "compression",
+            gNetworkLinkStub_obj.codecTimeInUsec ?
+                gNetworkLinkStub_obj.codecDataSize/(1024.0*1024)/(gNetworkLinkStub_obj.codecTimeInUsec/1000000.0)
+                : 0.0,
+            gNetworkLinkStub_obj.codecErrorCount
+            );
+    }
+
+    /* one line summary, for benchmark scripts */
+    printf("# BENCH: mode=%s ch=%d size=%dx%d frameSize=%d fps=%.2f frames=%d dropped=%d secs=%.2f MBps=%.2f fpsActual=%.2f latAvgMs=%.2f latP50Ms=%.2f latP99Ms=%.2f latMaxMs=%.2f ratio=%.2f\n",
+        gNetworkLinkStub_obj.mode==STUB_MODE_RX ? "rx" : "tx",
+        gNetworkLinkStub_obj.numCh,
+        gNetworkLinkStub_obj.width,
+        gNetworkLinkStub_obj.height,
+        gNetworkLinkStub_obj.frameSize,
+        gNetworkLinkStub_obj.fps,
+        totalFrames,
+        totalDrops,
+        elapsedSec,
+        elapsedSec > 0 ? totalDataSize/(1024.0*1024)/elapsedSec : 0.0,
+        elapsedSec > 0 ? totalFrames/elapsedSec : 0.0,
+        avgLatency,
+        GetPercentile(pAllLatency, numSamples, 50),
+        GetPercentile(pAllLatency, numSamples, 99),
+        GetPercentile(pAllLatency, numSamples, 100),
+        totalDataSize ? (double)gNetworkLinkStub_obj.rawDataSize/totalDataSize : 0.0
+        );
+
+    if(pAllLatency)
+        free(pAllLatency);
+}
+
+void ParseCmdLineArgs(int argc, char *argv[])
+{
+    int i;
+    char *format;
+
+    memset(&gNetworkLinkStub_obj, 0, sizeof(gNetworkLinkStub_obj));
+
+    gNetworkLinkStub_obj.mode = -1;
+    gNetworkLinkStub_obj.numCh = 1;
+    gNetworkLinkStub_obj.width = DEFAULT_WIDTH;
+    gNetworkLinkStub_obj.height = DEFAULT_HEIGHT;
+    gNetworkLinkStub_obj.fps = DEFAULT_FPS;
+    gNetworkLinkStub_obj.numBuf = DEFAULT_NUM_BUF;
+    gNetworkLinkStub_obj.durationSec = DEFAULT_DURATION_SEC;
+
+    format = "yuv420sp";
+
+    for(i=1; i<argc; i++)
+    {
+        if(strcmp(argv[i], "--mode")==0 && i+1<argc)
+        {
+            i++;
+            if(strcmp(argv[i], "rx")==0)
+                gNetworkLinkStub_obj.mode = STUB_MODE_RX;
+            else
+            if(strcmp(argv[i], "tx")==0)
+                gNetworkLinkStub_obj.mode = STUB_MODE_TX;
+        }
+        else
+        if(strcmp(argv[i], "--port")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.serverPort = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--ch")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.numCh = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--format")==0 && i+1<argc)
+        {
+            i++;
+            format = argv[i];
+        }
+        else
+        if(strcmp(argv[i], "--width")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.width = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--height")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.height = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--fps")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.fps = atof(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--bufs")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.numBuf = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--duration")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.durationSec = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--frames")==0 && i+1<argc)
+        {
+            i++;
+            gNetworkLinkStub_obj.maxFrames = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--verbose")==0)
+        {
+            gNetworkLinkStub_obj.isVerbose = TRUE;
+        }
+        else
+        if(strcmp(argv[i], "--compress")==0)
+        {
+            gNetworkLinkStub_obj.isCompress = TRUE;
+        }
+        else
+        {
+            ShowUsage();
+        }
+    }
+
+    if(strcmp(format, "yuv420sp")==0)
+    {
+        gNetworkLinkStub_obj.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV;
+    }
+    else
+    if(strcmp(format, "yuv422i")==0)
+    {
+        gNetworkLinkStub_obj.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV;
+    }
+    else
+    if(strcmp(format, "mjpeg")==0)
+    {
+        gNetworkLinkStub_obj.payloadType = NETWORK_RX_TYPE_BITSTREAM_MJPEG;
+    }
+    else
+    {
+        printf("# ERROR: Unsupported format [%s]\n", format);
+        ShowUsage();
+    }
+
+    if(gNetworkLinkStub_obj.mode < 0
+        ||
+       gNetworkLinkStub_obj.numCh <= 0
+        ||
+       gNetworkLinkStub_obj.numCh > MAX_CH
+        ||
+       gNetworkLinkStub_obj.width < 16 || gNetworkLinkStub_obj.width > 8192
+        ||
+       gNetworkLinkStub_obj.height < 16 || gNetworkLinkStub_obj.height > 8192
+        ||
+       gNetworkLinkStub_obj.fps < 0
+        ||
+       gNetworkLinkStub_obj.numBuf <= 0
+        )
+    {
+        printf("# ERROR: Invalid or missing arguments\n");
+        ShowUsage();
+    }
+
+    if(gNetworkLinkStub_obj.serverPort==0)
+    {
+        gNetworkLinkStub_obj.serverPort =
+            gNetworkLinkStub_obj.mode==STUB_MODE_RX ?
+                NETWORK_RX_SERVER_PORT : NETWORK_TX_SERVER_PORT;
+    }
+
+    /* same layout as allocated by capture on target */
+    if(gNetworkLinkStub_obj.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV)
+    {
+        gNetworkLinkStub_obj.pitch[0] = gNetworkLinkStub_obj.width*2;
+        gNetworkLinkStub_obj.frameSize =
+            gNetworkLinkStub_obj.pitch[0]*gNetworkLinkStub_obj.height;
+    }
+    else
+    {
+        gNetworkLinkStub_obj.pitch[0] = gNetworkLinkStub_obj.width;
+        gNetworkLinkStub_obj.pitch[1] = gNetworkLinkStub_obj.width;
+        gNetworkLinkStub_obj.frameSize =
+            gNetworkLinkStub_obj.pitch[0]*gNetworkLinkStub_obj.height
+          + gNetworkLinkStub_obj.pitch[1]*gNetworkLinkStub_obj.height/2;
+    }
+
+    if(gNetworkLinkStub_obj.payloadType==NETWORK_RX_TYPE_BITSTREAM_MJPEG
+        &&
+       gNetworkLinkStub_obj.mode==STUB_MODE_TX)
+    {
+        gNetworkLinkStub_obj.frameSize /= MJPEG_COMPRESSION_RATIO;
+    }
+}
@@ -0,0 +1,190 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#ifndef _NETWORK_LINK_STUB_PRIV_H_
+#define _NETWORK_LINK_STUB_PRIV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <osa.h>
+#include <networkCtrl_if.h>
+#include <network_api.h>
+#include <network_codec.h>
+
+#define MAX_CH  (8)
+
+#define NETWORK_ERROR   (-1)
+#define NETWORK_INVALID_HEADER  (-2)
+
+/* Emulated link, same as on target */
+#define STUB_MODE_RX    (0)
+/**< Network RX link (NullSrc), network_tx connects and sends frames */
+#define STUB_MODE_TX    (1)
+/**< Network TX link (Null), network_rx connects and receives frames */
+
+#define DEFAULT_WIDTH               (1920)
+#define DEFAULT_HEIGHT              (1080)
+#define DEFAULT_FPS                 (30)
+#define DEFAULT_DURATION_SEC        (10)
+
+/* Frames a channel can fall behind its frame rate before frames are
+ * dropped, like a capture source with this many buffers
+ */
+#define DEFAULT_NUM_BUF             (4)
+
+/* Synthetic frames are generated once, frame N sends pattern N % this */
+#define NUM_PATTERN_FRAMES          (8)
+
+/* MJPEG frames generated by TX mode are this fraction of YUV420SP size */
+#define MJPEG_COMPRESSION_RATIO     (10)
+
+/* Interval at which throughput is printed */
+#define STATS_PRINT_INTERVAL_MSEC   (2000)
+
+/* When pacing, sleep till this much before the frame time and poll after
+ * that, since OS sleep is not precise
+ */
+#define PACING_POLL_USEC            (2000)
+
+/* Initial number of latency samples, grows as needed */
+#define LATENCY_INIT_SAMPLES        (4096)
+
+typedef struct {
+
+    int chId;
+
+    UInt8 *dataBuf;
+    /**< RX: buffer in which frames are received, TX: unused */
+
+    UInt8 *decBuf;
+    /**< RX: decompressed frame, allocated only with --compress */
+
+    Uint64 dueTime;
+    /**< Time at which next frame of the channel is captured/requested */
+
+    int totalFrames;
+
+    unsigned long long totalDataSize;
+
+    int dropCount;
+    /**< Frames skipped since channel fell behind by more than numBuf */
+
+    int emptyCount;
+    /**< RX: requests answered with no data */
+
+    Uint32 *latency;
+    /**< Latency of every frame in usecs */
+
+    UInt32 maxLatencySamples;
+
+    int lastPrintFrames;
+
+    unsigned long long lastPrintDataSize;
+
+} NetworkLinkStub_ChObj;
+
+typedef struct {
+
+    UInt16 serverPort;
+    /**< Port on which to listen, default same as target */
+
+    int mode;
+    /**< STUB_MODE_xxx */
+
+    Network_SockObj listenObj;
+
+    Network_SockObj sockObj;
+
+    UInt32 payloadType;
+    /**< NETWORK_RX_TYPE_xxx */
+
+    UInt32 width;
+
+    UInt32 height;
+
+    UInt32 pitch[2];
+
+    UInt32 frameSize;
+    /**< YUV: frame size, MJPEG: TX: size of generated frames
+     *   RX: max size of a frame, same as bitstream buffer size on target
+     */
+
+    float fps;
+    /**< Frame rate of every channel, 0: as fast as possible */
+
+    int numBuf;
+
+    int durationSec;
+    /**< Stop after this time, 0: when client disconnects */
+
+    int maxFrames;
+    /**< Stop after this many frames per channel, 0: no limit */
+
+    Bool isVerbose;
+
+    Bool isCompress;
+    /**< TX: send YUV frames compressed, RX: accept compressed YUV frames,
+     *   like the links with networkTxCompress/networkRxDecompress */
+
+    UInt8 *patternBuf[NUM_PATTERN_FRAMES];
+    /**< TX: synthetic frames */
+
+    UInt8 *encPatternBuf[NUM_PATTERN_FRAMES];
+    /**< TX: compressed synthetic frames, NULL if not smaller */
+
+    UInt32 encPatternSize[NUM_PATTERN_FRAMES];
+
+    unsigned long long rawDataSize;
+    /**< Size of exchanged frames before compression / after decompression */
+
+    unsigned long long codecTimeInUsec;
+    /**< TX: time to compress the patterns, RX: time to decompress frames */
+
+    unsigned long long codecDataSize;
+    /**< Size of frames compressed/decompressed in codecTimeInUsec */
+
+    int codecErrorCount;
+    /**< RX: compressed frames which could not be decompressed */
+
+    int numCh;
+
+    NetworkLinkStub_ChObj chObj[MAX_CH];
+
+    Uint64 startTime;
+
+    Uint64 lastPrintTime;
+
+} NetworkLinkStub_Obj;
+
+extern NetworkLinkStub_Obj gNetworkLinkStub_obj;
+
+void ShowUsage();
+void ParseCmdLineArgs(int argc, char *argv[]);
+void Init();
+void DeInit();
+
+void GeneratePatterns();
+void CompressPatterns();
+int  DecompressFrame(NetworkLinkStub_ChObj *pChObj, NetworkRx_CmdHeader *pHeader);
+int  RunLink();
+int  SendFrame(NetworkLinkStub_ChObj *pChObj, UInt32 frameNum, Uint64 captureTime);
+int  RecvFrame(NetworkLinkStub_ChObj *pChObj);
+void AddLatency(NetworkLinkStub_ChObj *pChObj, Uint64 latency);
+void PrintStatistics(Bool isFinal);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
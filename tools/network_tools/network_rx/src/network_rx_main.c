@@ -7,6 +7,14 @@
  *******************************************************************************
  */
 
+/*
+ * Main thread receives header and payload from the socket into a buffer
+ * taken from a shared pool and queues it to the writer thread of the
+ * channel. Writer threads write the payload to file and return the buffer
+ * to the pool. Socket receive hence never waits for file write, unless all
+ * buffers are waiting to be written.
+ */
+
 #include "network_rx_priv.h"
 
 
@@ -16,91 +24,218 @@ void ShowUsage()
 {
     printf(" \n");
     printf("# \n");
-    printf("# network_rx --ipaddr <ipaddr> [--port <server port>] --files <CH0 file> <CH1 file> \n");
+    printf("# network_rx --ipaddr <ipaddr> [--port <server port>] [--bufs <num buffers>] [--keep-compressed] --files <CH0 file> <CH1 file> ... \n");
+    printf("# \n");
+    printf("#   --bufs             Number of frame buffers shared by all channels (default %d) \n", DEFAULT_NUM_BUF);
+    printf("#   --keep-compressed  Write compressed YUV frames as received instead of decompressing them\n");
     printf("# \n");
     printf("# (c) Texas Instruments 2014\n");
     printf("# \n");
     exit(0);
 }
 
-int OpenDataFile(NetworkRx_CmdHeader *pHeader)
+int OpenDataFile(NetworkRx_ChObj *pChObj)
 {
-    int chId = pHeader->chNum;
+    if(pChObj->fd == NULL )
+    {
+        pChObj->frameCount = 0;
+        pChObj->fd = fopen(pChObj->fileName,  "wb");
+        if(pChObj->fd == NULL)
+        {
+            printf("# ERROR: Unable to open file [%s]\n", pChObj->fileName);
+            return -1;
+        }
+
+        /* payload is written in one call per frame from a large buffer,
+         * no need to copy it once more into a stdio buffer
+         */
+        setvbuf(pChObj->fd, NULL, _IONBF, 0);
+    }
 
-    if(pHeader->chNum >= gNetworkRx_obj.numCh)
+    return 0;
+}
+
+/* Decompress frame into decBuf of the channel, in the layout given by
+ * width, height and pitch of the header, same as uncompressed frames
+ */
+int DecodeData(NetworkRx_ChObj *pChObj, NetworkRx_Buf *pBuf,
+               UInt8 **pDataBuf, UInt32 *pDataSize)
+{
+    NetworkRx_CmdHeader *pHeader = &pBuf->header;
+    NetworkCodec_Header codecHeader;
+    UInt8 *dstAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 lineSize, frameSize;
+    Uint64 startTime;
+    int status;
+
+    if(pHeader->dataSize < sizeof(codecHeader))
+        return -1;
+
+    memcpy(&codecHeader, pBuf->dataBuf, sizeof(codecHeader));
+
+    if(codecHeader.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        lineSize = pHeader->width;
+        frameSize = pHeader->pitch[0]*pHeader->height
+                  + pHeader->pitch[1]*(pHeader->height/2);
+
+        if(lineSize > pHeader->pitch[1])
+            return -1;
+    }
+    else
+    if(codecHeader.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV)
+    {
+        lineSize = pHeader->width*2;
+        frameSize = pHeader->pitch[0]*pHeader->height;
+    }
+    else
     {
         return -1;
     }
 
-    if(gNetworkRx_obj.fd[chId] == NULL )
+    if(lineSize > pHeader->pitch[0] || frameSize > MAX_DATA_SIZE)
+        return -1;
+
+    if(pChObj->decBufSize < frameSize)
     {
-        gNetworkRx_obj.frameCount[chId] = 0;
-        gNetworkRx_obj.fd[chId] = fopen(gNetworkRx_obj.fileName[chId],  "wb");
-        if(gNetworkRx_obj.fd[chId] == NULL)
-        {
-            printf("# ERROR: Unable to open file [%s]\n", gNetworkRx_obj.fileName[chId]);
-            pHeader->dataSize = 0;
+        if(AllocDataBuf(&pChObj->decBuf, &pChObj->decBufSize, frameSize)!=0)
             return -1;
-        }
+
+        /* bytes beyond width in each line are not coded */
+        memset(pChObj->decBuf, 0, pChObj->decBufSize);
     }
 
+    dstAddr[0] = pChObj->decBuf;
+    dstAddr[1] = pChObj->decBuf + pHeader->pitch[0]*pHeader->height;
+
+    startTime = OSA_getCurTimeInUsec();
+
+    status = NetworkCodec_decode(
+                pBuf->dataBuf,
+                pHeader->dataSize,
+                codecHeader.payloadType,
+                pHeader->width,
+                pHeader->height,
+                dstAddr,
+                pHeader->pitch);
+
+    pChObj->decTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+    if(status!=OSA_SOK)
+        return -1;
+
+    pChObj->decFrameCount++;
+    pChObj->encDataSize += pHeader->dataSize;
+    pChObj->decDataSize += frameSize;
+
+    *pDataBuf = pChObj->decBuf;
+    *pDataSize = frameSize;
+
     return 0;
 }
 
-int WriteBytes(NetworkRx_CmdHeader *pHeader)
+int WriteData(NetworkRx_ChObj *pChObj, NetworkRx_Buf *pBuf)
 {
-    int chId = pHeader->chNum;
-    int bytesWr;
+    int status = 0;
+    UInt32 bytesWr, dataSize;
+    UInt8 *dataBuf;
+    Uint64 startTime;
+
+    status = OpenDataFile(pChObj);
+    if(status < 0)
+        return status;
+
+    if(pBuf->header.dataSize == 0)
+        return 0;
 
-    bytesWr = fwrite(gNetworkRx_obj.dataBuf, 1, pHeader->dataSize, gNetworkRx_obj.fd[chId]);
-    if(bytesWr != pHeader->dataSize)
+    dataBuf = pBuf->dataBuf;
+    dataSize = pBuf->header.dataSize;
+
+    if(pBuf->header.payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED
+        &&
+       !gNetworkRx_obj.keepCompressed)
     {
+        status = DecodeData(pChObj, pBuf, &dataBuf, &dataSize);
+        if(status!=0)
+        {
+            /* only this frame is lost, stream is still in sync */
+            if(pChObj->decErrorCount==0)
+            {
+                printf("# ERROR: CH%d: Invalid compressed frame of %d bytes, dropped !!!\n",
+                    pChObj->chId,
+                    pBuf->header.dataSize);
+            }
+            pChObj->decErrorCount++;
+            return 0;
+        }
+    }
 
-        /* reached end of file, restart from begining */
-        printf("# ERROR: CH%d: File [%s] write failed !!!\n",
-            chId,
-            gNetworkRx_obj.fileName[chId]);
-        fclose(gNetworkRx_obj.fd[chId]);
-        gNetworkRx_obj.fd[chId] = NULL;
-        gNetworkRx_obj.frameCount[chId] = 0;
+    startTime = OSA_getCurTimeInUsec();
+
+    bytesWr = fwrite(dataBuf, 1, dataSize, pChObj->fd);
+
+    pChObj->writeTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+    if(bytesWr != dataSize)
+    {
+        printf("# ERROR: CH%d: File [%s] write failed, further data of this CH is dropped !!!\n",
+            pChObj->chId,
+            pChObj->fileName);
+        fclose(pChObj->fd);
+        pChObj->fd = NULL;
         return -1;
     }
 
     #ifdef DEBUG_LOG
     printf("# INFO: DATA: CH%d: Frame%d: %d bytes\n",
-        pHeader->chNum,
-        gNetworkRx_obj.frameCount[chId],
-        pHeader->dataSize
+        pChObj->chId,
+        pChObj->frameCount,
+        pBuf->header.dataSize
        );
     #endif
-    gNetworkRx_obj.frameCount[chId]++;
-    gNetworkRx_obj.totalDataSize[chId] += pHeader->dataSize;
-
-    if(gNetworkRx_obj.frameCount[chId] &&
-        (gNetworkRx_obj.frameCount[chId] % 10)==0
-      )
-    {
-        printf("# INFO: DATA: CH%d: Recevied %d frames, %10.2f MB\n",
-            pHeader->chNum,
-            gNetworkRx_obj.frameCount[chId],
-            gNetworkRx_obj.totalDataSize[chId]/(1024.0*1024)
-        );
-    }
+    pChObj->frameCount++;
+    pChObj->totalDataSize += dataSize;
 
     return 0;
 }
 
-int WriteData(NetworkRx_CmdHeader *pHeader)
+void *WriterThreadMain(void *prm)
 {
-    int status = 0;
+    NetworkRx_ChObj *pChObj = (NetworkRx_ChObj *)prm;
+    NetworkRx_Buf *pBuf;
+    int status;
 
-    status = OpenDataFile(pHeader);
-    if(status < 0)
-        return status;
+    while(1)
+    {
+        OSA_queGet(&pChObj->fullQue, (void**)&pBuf, OSA_TIMEOUT_FOREVER);
 
-    status = WriteBytes(pHeader);
+        /* NULL is queued at exit, after all received buffers */
+        if(pBuf==NULL)
+            break;
 
-    return status;
+        if(!pChObj->writeError)
+        {
+            status = WriteData(pChObj, pBuf);
+            if(status!=0)
+                pChObj->writeError = TRUE;
+        }
+
+        OSA_quePut(&gNetworkRx_obj.freeQue, pBuf, OSA_TIMEOUT_FOREVER);
+    }
+
+    if(pChObj->fd)
+    {
+        fclose(pChObj->fd);
+        pChObj->fd = NULL;
+    }
+
+    if(pChObj->decBuf)
+    {
+        free(pChObj->decBuf);
+        pChObj->decBuf = NULL;
+    }
+
+    return NULL;
 }
 
 int main(int argc, char *argv[])
@@ -123,21 +258,73 @@ int main(int argc, char *argv[])
 
 void Init()
 {
+    int i;
+    NetworkRx_ChObj *pChObj;
+
     Network_init();
 
-    gNetworkRx_obj.dataBuf = malloc(MAX_BUF_SIZE);
-    if(gNetworkRx_obj.dataBuf==NULL)
+    gNetworkRx_obj.bufs = calloc(gNetworkRx_obj.numBuf, sizeof(NetworkRx_Buf));
+    if(gNetworkRx_obj.bufs==NULL)
     {
         printf("# ERROR: Unable to allocate memory for buffer !!! \n");
         exit(0);
     }
+
+    OSA_queCreate(&gNetworkRx_obj.freeQue, gNetworkRx_obj.numBuf);
+
+    /* payload memory is allocated when first frame is received, since
+     * size is known only from the header
+     */
+    for(i=0; i<gNetworkRx_obj.numBuf; i++)
+    {
+        OSA_quePut(&gNetworkRx_obj.freeQue, &gNetworkRx_obj.bufs[i], OSA_TIMEOUT_NONE);
+    }
+
+    for(i=0; i<gNetworkRx_obj.numCh; i++)
+    {
+        pChObj = &gNetworkRx_obj.chObj[i];
+
+        /* +1 for the exit marker */
+        OSA_queCreate(&pChObj->fullQue, gNetworkRx_obj.numBuf + 1);
+
+        if(OSA_thrCreate(&pChObj->thrHndl, WriterThreadMain, pChObj)!=OSA_SOK)
+        {
+            printf("# ERROR: Unable to create writer thread for CH%d !!! \n", i);
+            exit(0);
+        }
+    }
 }
 
 void DeInit()
 {
+    int i;
+    NetworkRx_ChObj *pChObj;
+
+    for(i=0; i<gNetworkRx_obj.numCh; i++)
+    {
+        pChObj = &gNetworkRx_obj.chObj[i];
+
+        OSA_quePut(&pChObj->fullQue, NULL, OSA_TIMEOUT_FOREVER);
+        OSA_thrJoin(&pChObj->thrHndl);
+        OSA_queDelete(&pChObj->fullQue);
+    }
+
+    PrintStatistics(TRUE);
+
     Network_deInit();
 
-    free(gNetworkRx_obj.dataBuf);
+    for(i=0; i<gNetworkRx_obj.numBuf; i++)
+    {
+        if(gNetworkRx_obj.bufs[i].dataBuf)
+            free(gNetworkRx_obj.bufs[i].dataBuf);
+    }
+
+    OSA_queDelete(&gNetworkRx_obj.freeQue);
+
+    free(gNetworkRx_obj.bufs);
+    free(gNetworkRx_obj.chObj);
+    if(gNetworkRx_obj.dropBuf)
+        free(gNetworkRx_obj.dropBuf);
 }
 
 int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
@@ -154,7 +341,7 @@ int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
 
     if(pHeader->header!=NETWORK_TX_HEADER
         ||
-        pHeader->dataSize > MAX_BUF_SIZE
+        pHeader->dataSize > MAX_DATA_SIZE
         )
     {
         return NETWORK_INVALID_HEADER;
@@ -163,50 +350,211 @@ int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
     return 0;
 }
 
-int ReadData(NetworkRx_CmdHeader *pHeader)
+/* Make sure buffer can hold dataSize bytes, contents are not preserved */
+int AllocDataBuf(UInt8 **pDataBuf, UInt32 *pBufSize, UInt32 dataSize)
+{
+    if(*pBufSize >= dataSize)
+        return 0;
+
+    if(*pDataBuf)
+        free(*pDataBuf);
+
+    *pBufSize = 0;
+    *pDataBuf = malloc(dataSize);
+    if(*pDataBuf==NULL)
+    {
+        printf("# ERROR: Unable to allocate memory for buffer of %d bytes !!! \n", dataSize);
+        return -1;
+    }
+
+    *pBufSize = dataSize;
+
+    return 0;
+}
+
+int ReadDataInto(UInt8 *dataBuf, UInt32 dataSize)
 {
     Int32 status;
-    UInt32 readDataSize;
+    Uint64 startTime;
 
-    if(pHeader->dataSize==0)
+    if(dataSize==0)
         return 0;
 
-    readDataSize = pHeader->dataSize;
+    startTime = OSA_getCurTimeInUsec();
+
+    status = Network_read(&gNetworkRx_obj.sockObj, dataBuf, &dataSize);
+
+    gNetworkRx_obj.recvTimeInUsec += OSA_getCurTimeInUsec() - startTime;
 
-    status = Network_read(&gNetworkRx_obj.sockObj, gNetworkRx_obj.dataBuf, &readDataSize);
     if(status!=0)
         return NETWORK_ERROR;
 
-    pHeader->dataSize = readDataSize;
+    gNetworkRx_obj.totalRecvSize += dataSize;
 
     return 0;
 }
 
+int ReadData(NetworkRx_Buf *pBuf)
+{
+    if(AllocDataBuf(&pBuf->dataBuf, &pBuf->bufSize, pBuf->header.dataSize)!=0)
+        return NETWORK_ERROR;
+
+    return ReadDataInto(pBuf->dataBuf, pBuf->header.dataSize);
+}
+
+int DropData(NetworkRx_CmdHeader *pHeader)
+{
+    if(gNetworkRx_obj.dropCount==0)
+    {
+        printf("# WARNING: CH%d: Data received for CH with no output file or after write failure, dropping it !!!\n",
+            pHeader->chNum);
+    }
+    gNetworkRx_obj.dropCount++;
+
+    if(AllocDataBuf(&gNetworkRx_obj.dropBuf, &gNetworkRx_obj.dropBufSize, pHeader->dataSize)!=0)
+        return NETWORK_ERROR;
+
+    return ReadDataInto(gNetworkRx_obj.dropBuf, pHeader->dataSize);
+}
+
 void RecvData()
 {
     Int32 status = 0;
     NetworkRx_CmdHeader cmdHeader;
+    NetworkRx_Buf *pBuf;
+    NetworkRx_ChObj *pChObj;
+    Uint64 startTime;
+
+    gNetworkRx_obj.startTime = OSA_getCurTimeInUsec();
+    gNetworkRx_obj.lastPrintTime = gNetworkRx_obj.startTime;
 
     while(status==0)
     {
         status = ReadCmdHeader(&cmdHeader);
-        if(status == 0)
+        if(status != 0)
+            break;
+
+        if(cmdHeader.chNum >= gNetworkRx_obj.numCh
+            ||
+           gNetworkRx_obj.chObj[cmdHeader.chNum].writeError
+            )
         {
-            status = ReadData(&cmdHeader);
+            status = DropData(&cmdHeader);
+            continue;
         }
+
+        pChObj = &gNetworkRx_obj.chObj[cmdHeader.chNum];
+
+        startTime = OSA_getCurTimeInUsec();
+
+        OSA_queGet(&gNetworkRx_obj.freeQue, (void**)&pBuf, OSA_TIMEOUT_FOREVER);
+
+        gNetworkRx_obj.waitBufTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+        pBuf->header = cmdHeader;
+
+        status = ReadData(pBuf);
         if(status==0)
         {
-            status = WriteData(&cmdHeader);
+            OSA_quePut(&pChObj->fullQue, pBuf, OSA_TIMEOUT_FOREVER);
+        }
+        else
+        {
+            OSA_quePut(&gNetworkRx_obj.freeQue, pBuf, OSA_TIMEOUT_FOREVER);
         }
+
+        PrintStatistics(FALSE);
     }
 }
 
+void PrintStatistics(Bool isFinal)
+{
+    Uint64 curTime;
+    double elapsedSec, intervalSec;
+    int i;
+    NetworkRx_ChObj *pChObj;
+
+    curTime = OSA_getCurTimeInUsec();
+
+    if(!isFinal
+        &&
+       curTime - gNetworkRx_obj.lastPrintTime < STATS_PRINT_INTERVAL_MSEC*1000ULL)
+    {
+        return;
+    }
+
+    elapsedSec  = (curTime - gNetworkRx_obj.startTime)/1000000.0;
+    intervalSec = (curTime - gNetworkRx_obj.lastPrintTime)/1000000.0;
+
+    if(isFinal)
+    {
+        printf("# \n");
+        printf("# INFO: Received %10.2f MB in %8.2f secs, sustained %8.2f MB/s\n",
+            gNetworkRx_obj.totalRecvSize/(1024.0*1024),
+            elapsedSec,
+            elapsedSec > 0 ? gNetworkRx_obj.totalRecvSize/(1024.0*1024)/elapsedSec : 0.0
+            );
+        printf("# INFO: Socket receive %8.2f secs, waiting for free buffer %8.2f secs, dropped %d frames\n",
+            gNetworkRx_obj.recvTimeInUsec/1000000.0,
+            gNetworkRx_obj.waitBufTimeInUsec/1000000.0,
+            gNetworkRx_obj.dropCount
+            );
+    }
+    else
+    {
+        printf("# INFO: RX: %8.2f MB/s (avg %8.2f MB/s), free buffers %d of %d\n",
+            intervalSec > 0 ?
+                (gNetworkRx_obj.totalRecvSize - gNetworkRx_obj.lastPrintRecvSize)/(1024.0*1024)/intervalSec
+                : 0.0,
+            elapsedSec > 0 ? gNetworkRx_obj.totalRecvSize/(1024.0*1024)/elapsedSec : 0.0,
+            OSA_queGetQueuedCount(&gNetworkRx_obj.freeQue),
+            gNetworkRx_obj.numBuf
+            );
+    }
+
+    for(i=0; i<gNetworkRx_obj.numCh; i++)
+    {
+        pChObj = &gNetworkRx_obj.chObj[i];
+
+        printf("# INFO: DATA: CH%d: Written %d frames, %10.2f MB, file write %8.2f MB/s\n",
+            i,
+            pChObj->frameCount,
+            pChObj->totalDataSize/(1024.0*1024),
+            pChObj->writeTimeInUsec ?
+                pChObj->totalDataSize/(1024.0*1024)/(pChObj->writeTimeInUsec/1000000.0)
+                : 0.0
+            );
+
+        if(pChObj->decFrameCount || pChObj->decErrorCount)
+        {
+            printf("# INFO: DATA: CH%d: Decompressed %d frames, ratio %6.2f, decompression %8.2f MB/s, invalid %d frames\n",
+                i,
+                pChObj->decFrameCount,
+                pChObj->encDataSize ?
+                    (double)pChObj->decDataSize/pChObj->encDataSize
+                    : 0.0,
+                pChObj->decTimeInUsec ?
+                    pChObj->decDataSize/(1024.0*1024)/(pChObj->decTimeInUsec/1000000.0)
+                    : 0.0,
+                pChObj->decErrorCount
+                );
+        }
+    }
+
+    gNetworkRx_obj.lastPrintTime = curTime;
+    gNetworkRx_obj.lastPrintRecvSize = gNetworkRx_obj.totalRecvSize;
+}
+
 int ConnectToServer()
 {
     int status;
 
     printf("# Connecting to server %s:%d ...\n", gNetworkRx_obj.ipAddr, gNetworkRx_obj.serverPort);
     status = Network_connect(&gNetworkRx_obj.sockObj, gNetworkRx_obj.ipAddr, gNetworkRx_obj.serverPort);
+    if(status==0)
+    {
+        Network_setRecvBufSize(&gNetworkRx_obj.sockObj, SOCKET_RECV_BUF_SIZE);
+    }
     return status;
 }
 
@@ -223,7 +571,7 @@ void ParseCmdLineArgs(int argc, char *argv[])
 
     gNetworkRx_obj.serverPort = NETWORK_TX_SERVER_PORT;
     gNetworkRx_obj.numCh = 0;
-    memset(gNetworkRx_obj.fileName, 0, sizeof(gNetworkRx_obj.fileName));
+    gNetworkRx_obj.numBuf = DEFAULT_NUM_BUF;
 
     for(i=0; i<argc; i++)
     {
@@ -247,23 +595,49 @@ void ParseCmdLineArgs(int argc, char *argv[])
             gNetworkRx_obj.serverPort = atoi(argv[i]);
         }
         else
+        if(strcmp(argv[i], "--bufs")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gNetworkRx_obj.numBuf = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--keep-compressed")==0)
+        {
+            gNetworkRx_obj.keepCompressed = TRUE;
+        }
+        else
         if(strcmp(argv[i], "--files")==0)
         {
             i++;
+
+            gNetworkRx_obj.numCh = argc - i;
+            gNetworkRx_obj.chObj = calloc(argc, sizeof(NetworkRx_ChObj));
+            if(gNetworkRx_obj.chObj==NULL)
+            {
+                printf("# ERROR: Unable to allocate memory for channels !!! \n");
+                exit(0);
+            }
+
             p=0;
             for( ;i<argc;i++)
             {
-                strcpy(gNetworkRx_obj.fileName[p], argv[i]);
+                gNetworkRx_obj.chObj[p].chId = p;
+                gNetworkRx_obj.chObj[p].fileName = argv[i];
+                gNetworkRx_obj.chObj[p].fd = NULL;
                 p++;
             }
-
-            gNetworkRx_obj.numCh = p;
         }
     }
 
     if(gNetworkRx_obj.ipAddr[0]==0
         ||
        gNetworkRx_obj.numCh==0
+        ||
+       gNetworkRx_obj.numBuf<=0
         )
     {
 
@@ -275,13 +649,12 @@ void ParseCmdLineArgs(int argc, char *argv[])
         {
             printf("# ERROR: Atleast one output file MUST be specified\n");
         }
+        if(gNetworkRx_obj.numBuf<=0)
+        {
+            printf("# ERROR: Atleast one buffer MUST be specified\n");
+        }
 
         ShowUsage();
         exit(0);
     }
-
-    for(p=0; p<gNetworkRx_obj.numCh; p++)
-    {
-        gNetworkRx_obj.fd[p] = NULL;
-    }
 }
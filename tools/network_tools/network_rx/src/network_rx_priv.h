@@ -16,18 +16,87 @@ extern "C" {
 
 
 #include <osa.h>
+#include <osa_que.h>
+#include <osa_thr.h>
 #include <networkCtrl_if.h>
 #include <network_api.h>
-
-#define MAX_CH  (8)
+#include <network_codec.h>
 
 #define NETWORK_ERROR   (-1)
 #define NETWORK_INVALID_HEADER  (-2)
 
-#define MAX_BUF_SIZE    (1920*1080*2)
+/* Buffers shared by all channels, receive blocks when all are waiting to be
+ * written
+ */
+#define DEFAULT_NUM_BUF         (16)
+
+/* Sanity limit on payload size, buffers are sized from the header */
+#define MAX_DATA_SIZE           (256*MB)
+
+/* Socket receive buffer size requested from the OS */
+#define SOCKET_RECV_BUF_SIZE    (4*MB)
+
+/* Interval at which throughput is printed */
+#define STATS_PRINT_INTERVAL_MSEC   (2000)
 
 //#define DEBUG_LOG
 
+/* One received frame, header and payload */
+typedef struct {
+
+    NetworkRx_CmdHeader header;
+
+    UInt8 *dataBuf;
+
+    UInt32 bufSize;
+    /**< Allocated size of dataBuf, grows to the largest payload seen */
+
+} NetworkRx_Buf;
+
+typedef struct {
+
+    int chId;
+
+    char *fileName;
+
+    FILE *fd;
+
+    OSA_QueHndl fullQue;
+    /**< Buffers received and waiting to be written */
+
+    OSA_ThrHndl thrHndl;
+    /**< Writer thread */
+
+    Bool writeError;
+    /**< Set on write failure, later frames of this channel are dropped */
+
+    int frameCount;
+
+    unsigned long long totalDataSize;
+
+    unsigned long long writeTimeInUsec;
+
+    UInt8 *decBuf;
+    /**< Decompressed frame, grows to the largest frame seen */
+
+    UInt32 decBufSize;
+
+    int decFrameCount;
+    /**< Frames decompressed */
+
+    int decErrorCount;
+    /**< Compressed frames which could not be decompressed, not written */
+
+    unsigned long long encDataSize;
+    /**< Size of decompressed frames as received */
+
+    unsigned long long decDataSize;
+    /**< Size of decompressed frames after decompression */
+
+    unsigned long long decTimeInUsec;
+
+} NetworkRx_ChObj;
+
 typedef struct {
 
     UInt16 serverPort;
@@ -39,17 +108,38 @@ typedef struct {
 
     int numCh;
 
-    char fileName[MAX_CH][1024];
+    NetworkRx_ChObj *chObj;
 
-    unsigned int payloadType;
+    int numBuf;
 
-    UInt8 *dataBuf;
+    Bool keepCompressed;
+    /**< --keep-compressed, write compressed frames as received */
+
+    NetworkRx_Buf *bufs;
+
+    OSA_QueHndl freeQue;
+    /**< Buffers which can be used to receive */
+
+    UInt8 *dropBuf;
+    /**< Payload of channels with no output file is read here and dropped */
+
+    UInt32 dropBufSize;
 
-    FILE *fd[MAX_CH];
+    int dropCount;
 
-    int frameCount[MAX_CH];
+    unsigned long long totalRecvSize;
 
-    unsigned long long totalDataSize[MAX_CH];
+    unsigned long long recvTimeInUsec;
+    /**< Time spent in socket receive */
+
+    unsigned long long waitBufTimeInUsec;
+    /**< Time receive was blocked since all buffers were waiting for writer */
+
+    Uint64 startTime;
+
+    Uint64 lastPrintTime;
+
+    unsigned long long lastPrintRecvSize;
 
 } NetworkRx_Obj;
 
@@ -63,9 +153,16 @@ void Init();
 void DeInit();
 
 int ReadCmdHeader(NetworkRx_CmdHeader *pHeader);
-int ReadData(NetworkRx_CmdHeader *pHeader);
+int AllocDataBuf(UInt8 **pDataBuf, UInt32 *pBufSize, UInt32 dataSize);
+int ReadDataInto(UInt8 *dataBuf, UInt32 dataSize);
+int ReadData(NetworkRx_Buf *pBuf);
+int DropData(NetworkRx_CmdHeader *pHeader);
 void RecvData();
-int WriteData(NetworkRx_CmdHeader *pHeader);
+int DecodeData(NetworkRx_ChObj *pChObj, NetworkRx_Buf *pBuf,
+               UInt8 **pDataBuf, UInt32 *pDataSize);
+int WriteData(NetworkRx_ChObj *pChObj, NetworkRx_Buf *pBuf);
+void *WriterThreadMain(void *prm);
+void PrintStatistics(Bool isFinal);
 
 #ifdef __cplusplus
 }
@@ -76,3 +173,4 @@ int WriteData(NetworkRx_CmdHeader *pHeader);
 /* @} */
 
 
+
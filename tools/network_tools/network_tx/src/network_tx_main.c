@@ -7,6 +7,15 @@
  *******************************************************************************
  */
 
+/*
+ * Target requests one frame at a time, for the channel of its choice. Each
+ * channel has a producer thread which prepares the next few frames of its
+ * file, i.e finds them in the mapped file and brings their pages into
+ * memory, so that disk read is not in the send path. Main thread replies to
+ * a request with the next prepared frame of the channel, after waiting for
+ * a pacing token of the channel when a rate is set for it.
+ */
+
 #include "network_tx_priv.h"
 
 
@@ -16,25 +25,33 @@ void ShowUsage()
 {
     printf(" \n");
     printf("# \n");
-    printf("# network_tx --ipaddr <ipaddr> [--port <server port>] --files <CH0 file> <CH1 file> ... \n");
+    printf("# network_tx --ipaddr <ipaddr> [--port <server port>] [--fps <CH0 fps> <CH1 fps> ...] [--burst <frames>] [--prefetch <frames>] [--compress] --files <CH0 file> <CH1 file> ... \n");
+    printf("# \n");
+    printf("#   --fps       Max rate at which frames of a channel are sent, last value applies to\n");
+    printf("#               remaining channels, 0: as fast as requested (default 0)\n");
+    printf("#   --burst     Frames a paced channel can send back to back to catch up (default %d)\n", DEFAULT_PACING_BURST);
+    printf("#   --prefetch  Frames prepared ahead per channel, max %d (default %d)\n", MAX_PREFETCH_FRAMES, DEFAULT_PREFETCH_FRAMES);
+    printf("#   --compress  Send YUV frames losslessly compressed, when smaller. Target MUST be\n");
+    printf("#               created with NullSrcLink_CreateParams.networkRxDecompress = TRUE\n");
     printf("# \n");
     printf("# (c) Texas Instruments 2014\n");
     printf("# \n");
     exit(0);
 }
 
-int OpenDataFile(NetworkRx_CmdHeader *pHeader)
+int OpenDataFile(NetworkTx_ChObj *pChObj)
 {
-    int chId = pHeader->chNum;
+    int status;
 
-    if(gNetworkTx_obj.fd[chId] == NULL )
+    if(pChObj->fileMap.addr == NULL )
     {
-        gNetworkTx_obj.frameCount[chId] = 0;
-        gNetworkTx_obj.fd[chId] = fopen(gNetworkTx_obj.fileName[chId],  "rb");
-        if(gNetworkTx_obj.fd[chId] == NULL)
+        pChObj->frameCount = 0;
+        pChObj->curOffset = 0;
+        pChObj->curFrame = 0;
+        status = OSA_fileMap(&pChObj->fileMap, pChObj->fileName);
+        if(status!=OSA_SOK)
         {
-            printf("# ERROR: Unable to open file [%s]\n", gNetworkTx_obj.fileName[chId]);
-            pHeader->dataSize = 0;
+            printf("# ERROR: Unable to open file [%s]\n", pChObj->fileName);
             return -1;
         }
     }
@@ -42,158 +59,417 @@ int OpenDataFile(NetworkRx_CmdHeader *pHeader)
     return 0;
 }
 
-int ReadBytes(NetworkRx_CmdHeader *pHeader)
+int ReadBytes(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame)
 {
-    int chId = pHeader->chNum;
-    int bytesRead;
-
-read_again:
-    bytesRead = fread(gNetworkTx_obj.dataBuf, 1, pHeader->dataSize, gNetworkTx_obj.fd[chId]);
-    if(bytesRead != pHeader->dataSize)
+    if(pChObj->curOffset + pChObj->rawFrameSize > pChObj->fileMap.size)
     {
-
         /* reached end of file, restart from begining */
         #ifdef DEBUG_LOG
         printf("# INFO: DATA: CH%d: Frames %d: Reached end of file [%s] !!!\n",
-            chId,
-            gNetworkTx_obj.frameCount[chId],
-            gNetworkTx_obj.fileName[chId]);
+            pChObj->chId,
+            pChObj->frameCount,
+            pChObj->fileName);
         #endif
-        fseek(gNetworkTx_obj.fd[chId], 0, SEEK_SET);
-        gNetworkTx_obj.frameCount[chId] = 0;
-        goto read_again;
+        pChObj->curOffset = 0;
+        pChObj->frameCount = 0;
     }
 
+    pFrame->dataBuf  = pChObj->fileMap.addr + pChObj->curOffset;
+    pFrame->dataSize = pChObj->rawFrameSize;
+    pChObj->curOffset += pChObj->rawFrameSize;
+
     #ifdef DEBUG_LOG
     printf("# INFO: DATA: CH%d: Frame%d: %d bytes\n",
-        pHeader->chNum,
-        gNetworkTx_obj.frameCount[chId],
-        pHeader->dataSize
+        pChObj->chId,
+        pChObj->frameCount,
+        pFrame->dataSize
        );
     #endif
-    gNetworkTx_obj.frameCount[chId]++;
+    pChObj->frameCount++;
 
     return 0;
 }
 
-#define FOUND_NONE      (0)
-#define FOUND_FF        (1)
-#define FOUND_FF_D8     (2)
-#define FOUND_FF_D9     (3)
+int BuildJpegIndex(NetworkTx_ChObj *pChObj)
+{
+    UInt8 *pCur, *pEnd, *pStart;
+    NetworkTx_FrameIndex *pIndex;
+    UInt32 maxFrames;
 
+    pCur = pChObj->fileMap.addr;
+    pEnd = pChObj->fileMap.addr + pChObj->fileMap.size;
 
-int ReadJpeg(NetworkRx_CmdHeader *pHeader)
-{
-    int chId = pHeader->chNum;
-    int bytesRead, i;
-    unsigned char dataByte;
-    int state, state1;
+    maxFrames = FRAME_INDEX_INIT_SIZE;
+    pChObj->frameIndex = OSA_memAlloc(maxFrames*sizeof(NetworkTx_FrameIndex));
+    pChObj->numFrames = 0;
 
-    state = FOUND_NONE;
-    state1 = FOUND_NONE;
-    i = 0;
+    if(pChObj->frameIndex==NULL)
+        return -1;
 
-    while(state!=FOUND_FF_D9)
+    while(1)
     {
-read_again:
-        bytesRead = fread(&dataByte, 1, 1, gNetworkTx_obj.fd[chId]);
-        if(bytesRead != 1)
+        /* find start of frame, FFD8 */
+        pCur = memchr(pCur, 0xFF, pEnd - pCur);
+        if(pCur==NULL || pCur + 1 >= pEnd)
+            break;
+        if(pCur[1]!=0xD8u)
         {
-            /* reached end of file, restart from begining */
-            #ifdef DEBUG_LOG
-            printf("# INFO: JPEG: CH%d: Frames %d: Reached end of file [%s] !!!\n",
-                chId,
-                gNetworkTx_obj.frameCount[chId],
-                gNetworkTx_obj.fileName[chId]);
-            #endif
-            fseek(gNetworkTx_obj.fd[chId], 0, SEEK_SET);
-            gNetworkTx_obj.frameCount[chId] = 0;
-
-            state = FOUND_NONE;
-            state1 = FOUND_NONE;
-            i = 0;
-            goto read_again;
+            pCur++;
+            continue;
         }
+        pStart = pCur;
+        pCur += 2;
 
-        if(state==FOUND_NONE)
+        /* find end of frame, FFD9 */
+        while(1)
         {
-            if(dataByte==0xFFu)
-            {
-                state = FOUND_FF;
-            }
+            pCur = memchr(pCur, 0xFF, pEnd - pCur);
+            if(pCur==NULL || pCur + 1 >= pEnd || pCur[1]==0xD9u)
+                break;
+            pCur++;
         }
-        else
-        if(state==FOUND_FF)
+        if(pCur==NULL || pCur + 1 >= pEnd)
+            break;
+        pCur += 2;
+
+        if(pCur - pStart > 0xFFFFFFFFu)
+            continue;
+
+        if(pChObj->numFrames >= maxFrames)
         {
-            if(dataByte==0xD8u)
-            {
-                state = FOUND_FF_D8;
-                i=0;
-                gNetworkTx_obj.dataBuf[i++] = 0xFF;
-                gNetworkTx_obj.dataBuf[i++] = 0xD8;
-            }
-            else
-            if(dataByte==0xFFu)
-            {
-                state = FOUND_FF;
-            }
-            else
-            {
-                state = FOUND_NONE;
-            }
+            maxFrames *= 2;
+            pIndex = realloc(pChObj->frameIndex, maxFrames*sizeof(NetworkTx_FrameIndex));
+            if(pIndex==NULL)
+                break;
+            pChObj->frameIndex = pIndex;
         }
-        else
-        if(state==FOUND_FF_D8)
-        {
-            gNetworkTx_obj.dataBuf[i++] = dataByte;
 
-            if(dataByte==0xFF)
-            {
-                state1 = FOUND_FF;
-            }
-            else
-            if(dataByte==0xD9)
-            {
-                if(state1 == FOUND_FF)
-                    state = FOUND_FF_D9;
-            }
-            else
-            {
-                state1 = FOUND_NONE;
-            }
-        }
+        pIndex = &pChObj->frameIndex[pChObj->numFrames];
+        pIndex->offset = pStart - pChObj->fileMap.addr;
+        pIndex->size   = pCur - pStart;
+        pChObj->numFrames++;
     }
-    pHeader->dataSize = i;
+
+    printf("# INFO: JPEG: Found %d frames in file [%s]\n",
+        pChObj->numFrames,
+        pChObj->fileName);
+
+    if(pChObj->numFrames==0)
+        return -1;
+
+    return 0;
+}
+
+int ReadJpeg(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame)
+{
+    NetworkTx_FrameIndex *pIndex;
+
+    if(pChObj->curFrame >= pChObj->numFrames)
+    {
+        /* reached end of file, restart from begining */
+        #ifdef DEBUG_LOG
+        printf("# INFO: JPEG: CH%d: Frames %d: Reached end of file [%s] !!!\n",
+            pChObj->chId,
+            pChObj->frameCount,
+            pChObj->fileName);
+        #endif
+        pChObj->curFrame = 0;
+        pChObj->frameCount = 0;
+    }
+
+    pIndex = &pChObj->frameIndex[pChObj->curFrame];
+    pChObj->curFrame++;
+
+    pFrame->dataBuf  = pChObj->fileMap.addr + pIndex->offset;
+    pFrame->dataSize = pIndex->size;
+
     #ifdef DEBUG_LOG
     printf("# INFO: JPEG: CH%d: Frame%d: %d bytes\n",
-        pHeader->chNum,
-        gNetworkTx_obj.frameCount[chId],
-        pHeader->dataSize
+        pChObj->chId,
+        pChObj->frameCount,
+        pFrame->dataSize
        );
     #endif
-    gNetworkTx_obj.frameCount[chId]++;
+    pChObj->frameCount++;
 
     return 0;
 }
 
-int ReadData(NetworkRx_CmdHeader *pHeader)
+/* Prepare next frame of the channel. The frame is not copied, it points
+ * into the mapped file. Its pages are read once here so that they are in
+ * memory by the time the frame is sent.
+ */
+int ReadData(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame)
 {
-    int status = 0;
+    volatile UInt8 touch;
+    UInt32 offset;
+    int status;
 
-    status = OpenDataFile(pHeader);
+    if(pChObj->payloadType==NETWORK_RX_TYPE_BITSTREAM_MJPEG)
+    {
+        status = ReadJpeg(pChObj, pFrame);
+    }
+    else
+    {
+        status = ReadBytes(pChObj, pFrame);
+    }
+
+    if(status==0)
+    {
+        for(offset=0; offset<pFrame->dataSize; offset+=PREFETCH_PAGE_SIZE)
+        {
+            touch = pFrame->dataBuf[offset];
+        }
+        touch = pFrame->dataBuf[pFrame->dataSize-1];
+        (void)touch;
+    }
+
+    return status;
+}
+
+/* Allocate encode buffer of every prefetch frame, compression is
+ * disabled for the channel when frame layout is not supported
+ */
+int CreateEncBufs(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader)
+{
+    UInt32 lineSize, frameSize;
+    int i;
+
+    pChObj->isCompress = FALSE;
+
+    if(!gNetworkTx_obj.compress)
+        return 0;
+
+    pChObj->width = pHeader->width;
+    pChObj->height = pHeader->height;
+    pChObj->pitch[0] = pHeader->pitch[0];
+    pChObj->pitch[1] = pHeader->pitch[1];
+
+    if(pChObj->payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV)
+    {
+        lineSize = pChObj->width;
+        frameSize = pChObj->pitch[0]*pChObj->height
+                  + pChObj->pitch[1]*(pChObj->height/2);
+    }
+    else
+    if(pChObj->payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV422I_YUYV)
+    {
+        lineSize = pChObj->width*2;
+        frameSize = pChObj->pitch[0]*pChObj->height;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if(lineSize > pChObj->pitch[0]
+        ||
+       (pChObj->payloadType==NETWORK_RX_TYPE_VIDEO_FRAME_YUV420SP_UV
+            && lineSize > pChObj->pitch[1])
+        ||
+       frameSize > pChObj->rawFrameSize)
+    {
+        printf("# WARNING: DATA: CH%d: Frame %dx%d, pitch %d/%d does not fit in %d bytes, sent uncompressed !!!\n",
+            pChObj->chId,
+            pChObj->width,
+            pChObj->height,
+            pChObj->pitch[0],
+            pChObj->pitch[1],
+            pChObj->rawFrameSize);
+        return 0;
+    }
+
+    pChObj->encBufSize = NetworkCodec_getMaxSize(pChObj->payloadType, pChObj->width, pChObj->height);
+
+    for(i=0; i<gNetworkTx_obj.numPrefetch; i++)
+    {
+        if(pChObj->frames[i].encBuf==NULL)
+        {
+            pChObj->frames[i].encBuf = OSA_memAlloc(pChObj->encBufSize);
+            if(pChObj->frames[i].encBuf==NULL)
+            {
+                printf("# ERROR: DATA: CH%d: Unable to allocate %d bytes for compression !!!\n",
+                    pChObj->chId,
+                    pChObj->encBufSize);
+                return -1;
+            }
+        }
+    }
+
+    memset(&pChObj->encBackoff, 0, sizeof(pChObj->encBackoff));
+    pChObj->isCompress = TRUE;
+
+    return 0;
+}
+
+/* Compress frame prepared by ReadData() into its encBuf, frame is left as
+ * is when compressed frame is not smaller. Encoding is skipped while the
+ * channel backs off after frames which were not made smaller.
+ */
+void CompressFrame(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame)
+{
+    UInt8 *srcAddr[NETWORK_CODEC_MAX_PLANES];
+    UInt32 encSize;
+    Uint64 startTime;
+    int status;
+
+    if(NetworkCodec_backoffIsSkip(&pChObj->encBackoff))
+    {
+        pFrame->isEncodeSkipped = TRUE;
+        return;
+    }
+
+    srcAddr[0] = pFrame->dataBuf;
+    srcAddr[1] = pFrame->dataBuf + pChObj->pitch[0]*pChObj->height;
+
+    startTime = OSA_getCurTimeInUsec();
+
+    status = NetworkCodec_encode(
+                pChObj->payloadType,
+                pChObj->width,
+                pChObj->height,
+                srcAddr,
+                pChObj->pitch,
+                pFrame->encBuf,
+                pChObj->encBufSize,
+                &encSize);
+
+    pFrame->encTimeInUsec = OSA_getCurTimeInUsec() - startTime;
+
+    if(status==OSA_SOK && encSize < pFrame->dataSize)
+    {
+        pFrame->dataBuf = pFrame->encBuf;
+        pFrame->dataSize = encSize;
+        pFrame->isCompressed = TRUE;
+    }
+
+    NetworkCodec_backoffUpdate(&pChObj->encBackoff, pFrame->isCompressed);
+}
+
+void *ProducerThreadMain(void *prm)
+{
+    NetworkTx_ChObj *pChObj = (NetworkTx_ChObj *)prm;
+    NetworkTx_Frame *pFrame;
+
+    while(1)
+    {
+        OSA_queGet(&pChObj->freeQue, (void**)&pFrame, OSA_TIMEOUT_FOREVER);
+
+        /* NULL is queued to stop the thread */
+        if(pFrame==NULL)
+            break;
+
+        pFrame->isCompressed = FALSE;
+        pFrame->isEncodeSkipped = FALSE;
+        pFrame->encTimeInUsec = 0;
+
+        ReadData(pChObj, pFrame);
+
+        pFrame->rawSize = pFrame->dataSize;
+
+        if(pChObj->isCompress)
+        {
+            CompressFrame(pChObj, pFrame);
+        }
+
+        OSA_quePut(&pChObj->fullQue, pFrame, OSA_TIMEOUT_FOREVER);
+    }
+
+    return NULL;
+}
+
+/* Called on first request of a channel. Payload type and, for raw frames,
+ * frame size of the first request are used for all frames of the channel.
+ */
+int StartChannel(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader)
+{
+    int i, status;
+
+    status = OpenDataFile(pChObj);
     if(status < 0)
         return status;
 
-    if(pHeader->payloadType==NETWORK_RX_TYPE_BITSTREAM_MJPEG)
+    pChObj->payloadType = pHeader->payloadType;
+    pChObj->rawFrameSize = pHeader->dataSize;
+
+    if(pChObj->payloadType==NETWORK_RX_TYPE_BITSTREAM_MJPEG)
     {
-        ReadJpeg(pHeader);
+        if(pChObj->frameIndex==NULL)
+        {
+            if(BuildJpegIndex(pChObj)!=0)
+            {
+                printf("# ERROR: JPEG: CH%d: No JPEG frames in file [%s] !!!\n",
+                    pChObj->chId,
+                    pChObj->fileName);
+                return -1;
+            }
+        }
     }
     else
     {
-        ReadBytes(pHeader);
+        if(pChObj->rawFrameSize==0
+            ||
+           pChObj->rawFrameSize > pChObj->fileMap.size)
+        {
+            printf("# ERROR: DATA: CH%d: Requested %d bytes, larger than file [%s] !!!\n",
+                pChObj->chId,
+                pChObj->rawFrameSize,
+                pChObj->fileName);
+            return -1;
+        }
     }
 
-    return status;
+    status = CreateEncBufs(pChObj, pHeader);
+    if(status < 0)
+        return status;
+
+    OSA_queCreate(&pChObj->freeQue, gNetworkTx_obj.numPrefetch+1);
+    OSA_queCreate(&pChObj->fullQue, gNetworkTx_obj.numPrefetch);
+
+    for(i=0; i<gNetworkTx_obj.numPrefetch; i++)
+    {
+        OSA_quePut(&pChObj->freeQue, &pChObj->frames[i], OSA_TIMEOUT_FOREVER);
+    }
+
+    status = OSA_thrCreate(&pChObj->thrHndl, ProducerThreadMain, pChObj);
+    if(status!=OSA_SOK)
+    {
+        OSA_queDelete(&pChObj->freeQue);
+        OSA_queDelete(&pChObj->fullQue);
+        return -1;
+    }
+
+    pChObj->isStarted = TRUE;
+
+    return 0;
+}
+
+void StopChannel(NetworkTx_ChObj *pChObj)
+{
+    int i;
+
+    if(pChObj->isStarted)
+    {
+        OSA_quePut(&pChObj->freeQue, NULL, OSA_TIMEOUT_FOREVER);
+        OSA_thrJoin(&pChObj->thrHndl);
+
+        OSA_queDelete(&pChObj->freeQue);
+        OSA_queDelete(&pChObj->fullQue);
+
+        pChObj->isStarted = FALSE;
+    }
+
+    OSA_fileUnmap(&pChObj->fileMap);
+    if(pChObj->frameIndex)
+        OSA_memFree(pChObj->frameIndex);
+    pChObj->frameIndex = NULL;
+
+    for(i=0; i<MAX_PREFETCH_FRAMES; i++)
+    {
+        if(pChObj->frames[i].encBuf)
+            OSA_memFree(pChObj->frames[i].encBuf);
+        pChObj->frames[i].encBuf = NULL;
+    }
 }
 
 int main(int argc, char *argv[])
@@ -209,6 +485,7 @@ int main(int argc, char *argv[])
         if(status==0)
         {
             SendData();
+            PrintStatistics(TRUE);
         }
         CloseConnection();
     }
@@ -220,20 +497,18 @@ int main(int argc, char *argv[])
 void Init()
 {
     Network_init();
-
-    gNetworkTx_obj.dataBuf = malloc(MAX_BUF_SIZE);
-    if(gNetworkTx_obj.dataBuf==NULL)
-    {
-        printf("# ERROR: Unable to allocate memory for buffer !!! \n");
-        exit(0);
-    }
 }
 
 void DeInit()
 {
+    int i;
+
     Network_deInit();
 
-    free(gNetworkTx_obj.dataBuf);
+    for(i=0; i<gNetworkTx_obj.numCh; i++)
+    {
+        StopChannel(&gNetworkTx_obj.chObj[i]);
+    }
 }
 
 int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
@@ -251,8 +526,6 @@ int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
     if(pHeader->header!=NETWORK_RX_HEADER
         ||
        pHeader->chNum >= gNetworkTx_obj.numCh
-        ||
-       pHeader->dataSize >= MAX_BUF_SIZE
         )
     {
         pHeader->dataSize = 0;
@@ -265,43 +538,164 @@ int ReadCmdHeader(NetworkRx_CmdHeader *pHeader)
     return 0;
 }
 
-int WriteCmdHeader(NetworkRx_CmdHeader *pHeader)
+/* Send header and payload with one call */
+int WriteFrame(NetworkRx_CmdHeader *pHeader, UInt8 *dataBuf)
 {
-    UInt32 dataSize;
+    UInt8 *bufAddr[2];
+    UInt32 bufSize[2];
     Int32 status;
 
     pHeader->header = NETWORK_RX_HEADER;
 
-    dataSize = sizeof(*pHeader);
+    bufAddr[0] = (UInt8*)pHeader;
+    bufSize[0] = sizeof(*pHeader);
+    bufAddr[1] = dataBuf;
+    bufSize[1] = dataBuf ? pHeader->dataSize : 0;
 
-    status = Network_write(&gNetworkTx_obj.sockObj, (UInt8*)pHeader, dataSize);
+    status = Network_writev(&gNetworkTx_obj.sockObj, bufAddr, bufSize, 2);
     if(status!=0)
         return NETWORK_ERROR;
 
     return 0;
 }
 
-int WriteData(NetworkRx_CmdHeader *pHeader)
+/* Token bucket, refilled at the rate of the channel upto the pacing burst.
+ * Sending a frame takes a token, when none is left wait till the next
+ * token is due.
+ */
+void WaitForToken(NetworkTx_ChObj *pChObj)
 {
-    Int32 status;
+    Uint64 curTime, sendTime;
 
-    if(pHeader->dataSize==0)
-        return 0;
+    if(pChObj->fps <= 0)
+        return;
 
-    status = Network_write(&gNetworkTx_obj.sockObj, gNetworkTx_obj.dataBuf, pHeader->dataSize);
-    if(status!=0)
-        return NETWORK_ERROR;
+    curTime = OSA_getCurTimeInUsec();
 
-    return 0;
+    if(pChObj->lastTokenTime==0)
+    {
+        pChObj->tokens = 1;
+    }
+    else
+    {
+        pChObj->tokens += (curTime - pChObj->lastTokenTime)*pChObj->fps/1000000.0;
+        if(pChObj->tokens > gNetworkTx_obj.pacingBurst)
+            pChObj->tokens = gNetworkTx_obj.pacingBurst;
+    }
+    pChObj->lastTokenTime = curTime;
+
+    if(pChObj->tokens < 1)
+    {
+        sendTime = curTime + (Uint64)((1 - pChObj->tokens)*1000000.0/pChObj->fps);
+
+        while(curTime < sendTime)
+        {
+            if(sendTime - curTime > PACING_POLL_USEC)
+                usleep(sendTime - curTime - PACING_POLL_USEC);
+            else
+                usleep(0);
+
+            curTime = OSA_getCurTimeInUsec();
+        }
+
+        pChObj->tokens += (curTime - pChObj->lastTokenTime)*pChObj->fps/1000000.0;
+        pChObj->lastTokenTime = curTime;
+    }
+
+    pChObj->tokens -= 1;
+}
+
+/* Reply to one request with next frame of the channel, returns the
+ * frame to be given back to the producer after send, or NULL
+ */
+NetworkTx_Frame *GetFrame(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader)
+{
+    NetworkTx_Frame *pFrame;
+    Uint64 startTime;
+
+    if(!pChObj->isStarted)
+    {
+        if(StartChannel(pChObj, pHeader)!=0)
+        {
+            StopChannel(pChObj);
+            return NULL;
+        }
+    }
+
+    if(pHeader->payloadType!=pChObj->payloadType
+        ||
+       (pChObj->payloadType!=NETWORK_RX_TYPE_BITSTREAM_MJPEG
+            && pHeader->dataSize!=pChObj->rawFrameSize)
+        )
+    {
+        printf("# ERROR: DATA: CH%d: Request (type %d, %d bytes) does not match first request (type %d, %d bytes) !!!\n",
+            pChObj->chId,
+            pHeader->payloadType,
+            pHeader->dataSize,
+            pChObj->payloadType,
+            pChObj->rawFrameSize);
+        return NULL;
+    }
+
+    startTime = OSA_getCurTimeInUsec();
+
+    OSA_queGet(&pChObj->fullQue, (void**)&pFrame, OSA_TIMEOUT_FOREVER);
+
+    pChObj->waitTimeInUsec += OSA_getCurTimeInUsec() - startTime;
+
+    /* for JPEG, request has the size of target buffer */
+    if(pFrame->dataSize > pHeader->dataSize)
+    {
+        #ifdef DEBUG_LOG
+        printf("# INFO: JPEG: CH%d: %d bytes frame does not fit in %d bytes buffer, dropped\n",
+            pChObj->chId,
+            pFrame->dataSize,
+            pHeader->dataSize);
+        #endif
+        pChObj->dropCount++;
+        OSA_quePut(&pChObj->freeQue, pFrame, OSA_TIMEOUT_FOREVER);
+        return NULL;
+    }
+
+    return pFrame;
 }
 
 void SendData()
 {
     Int32 status = 0;
     NetworkRx_CmdHeader cmdHeader;
+    NetworkTx_ChObj *pChObj;
+    NetworkTx_Frame *pFrame;
+    Uint64 curTime, interval;
+    int i;
+
+    gNetworkTx_obj.startTime = OSA_getCurTimeInUsec();
+    gNetworkTx_obj.lastPrintTime = gNetworkTx_obj.startTime;
+
+    for(i=0; i<gNetworkTx_obj.numCh; i++)
+    {
+        pChObj = &gNetworkTx_obj.chObj[i];
+
+        pChObj->lastTokenTime = 0;
+        pChObj->lastSendTime = 0;
+        pChObj->totalFrames = 0;
+        pChObj->totalDataSize = 0;
+        pChObj->dropCount = 0;
+        pChObj->lastPrintFrames = 0;
+        pChObj->lastPrintDataSize = 0;
+        pChObj->minInterval = (Uint64)-1;
+        pChObj->maxInterval = 0;
+        pChObj->waitTimeInUsec = 0;
+        pChObj->totalRawSize = 0;
+        pChObj->totalEncInSize = 0;
+        pChObj->encSkipCount = 0;
+        pChObj->encTimeInUsec = 0;
+    }
 
     while(1)
     {
+        pChObj = NULL;
+        pFrame = NULL;
 
         status = ReadCmdHeader(&cmdHeader);
         if(status==NETWORK_ERROR)
@@ -309,19 +703,141 @@ void SendData()
 
         if(status == 0)
         {
-            ReadData(&cmdHeader);
+            pChObj = &gNetworkTx_obj.chObj[cmdHeader.chNum];
+            pFrame = GetFrame(pChObj, &cmdHeader);
         }
 
+        if(pFrame)
+        {
+            WaitForToken(pChObj);
 
-        status = WriteCmdHeader(&cmdHeader);
-        if(status==NETWORK_ERROR)
-            break;
+            /* interval is measured at start of send, i.e what pacing controls */
+            curTime = OSA_getCurTimeInUsec();
 
-        status = WriteData(&cmdHeader);
-        if(status==NETWORK_ERROR)
-            break;
+            cmdHeader.dataSize = pFrame->dataSize;
+            if(pFrame->isCompressed)
+                cmdHeader.payloadType = NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED;
+
+            pChObj->totalRawSize += pFrame->rawSize;
+            pChObj->encTimeInUsec += pFrame->encTimeInUsec;
+            if(pFrame->isEncodeSkipped)
+                pChObj->encSkipCount++;
+            else
+            if(pChObj->isCompress)
+                pChObj->totalEncInSize += pFrame->rawSize;
+
+            status = WriteFrame(&cmdHeader, pFrame->dataBuf);
+
+            OSA_quePut(&pChObj->freeQue, pFrame, OSA_TIMEOUT_FOREVER);
+
+            if(status==NETWORK_ERROR)
+                break;
+
+            if(pChObj->lastSendTime)
+            {
+                interval = curTime - pChObj->lastSendTime;
+                if(interval < pChObj->minInterval)
+                    pChObj->minInterval = interval;
+                if(interval > pChObj->maxInterval)
+                    pChObj->maxInterval = interval;
+            }
+            pChObj->lastSendTime = curTime;
+
+            pChObj->totalFrames++;
+            pChObj->totalDataSize += cmdHeader.dataSize;
+        }
+        else
+        {
+            cmdHeader.dataSize = 0;
+
+            status = WriteFrame(&cmdHeader, NULL);
+            if(status==NETWORK_ERROR)
+                break;
+        }
+
+        PrintStatistics(FALSE);
+    }
+}
+
+void PrintStatistics(Bool isFinal)
+{
+    Uint64 curTime;
+    double elapsedSec, intervalSec;
+    int i, frames;
+    NetworkTx_ChObj *pChObj;
+
+    curTime = OSA_getCurTimeInUsec();
+
+    if(!isFinal
+        &&
+       curTime - gNetworkTx_obj.lastPrintTime < STATS_PRINT_INTERVAL_MSEC*1000ULL)
+    {
+        return;
+    }
+
+    elapsedSec  = (curTime - gNetworkTx_obj.startTime)/1000000.0;
+    intervalSec = (curTime - gNetworkTx_obj.lastPrintTime)/1000000.0;
+
+    if(isFinal)
+    {
+        printf("# \n");
+        printf("# INFO: Connection closed after %8.2f secs\n", elapsedSec);
+    }
+
+    for(i=0; i<gNetworkTx_obj.numCh; i++)
+    {
+        pChObj = &gNetworkTx_obj.chObj[i];
+
+        if(isFinal)
+        {
+            printf("# INFO: DATA: CH%d: Sent %d frames, %10.2f MB, avg %8.2f fps, %8.2f MB/s, dropped %d frames\n",
+                i,
+                pChObj->totalFrames,
+                pChObj->totalDataSize/(1024.0*1024),
+                elapsedSec > 0 ? pChObj->totalFrames/elapsedSec : 0.0,
+                elapsedSec > 0 ? pChObj->totalDataSize/(1024.0*1024)/elapsedSec : 0.0,
+                pChObj->dropCount
+                );
+
+            if(pChObj->isCompress && pChObj->totalDataSize)
+            {
+                printf("# INFO: DATA: CH%d: Compression ratio %6.2f, %10.2f MB before compression, compressed at %8.2f MB/s, %d frames not encoded (backoff)\n",
+                    i,
+                    (double)pChObj->totalRawSize/pChObj->totalDataSize,
+                    pChObj->totalRawSize/(1024.0*1024),
+                    pChObj->encTimeInUsec ?
+                        pChObj->totalEncInSize/(1024.0*1024)/(pChObj->encTimeInUsec/1000000.0)
+                        : 0.0,
+                    pChObj->encSkipCount
+                    );
+            }
+        }
+        else
+        {
+            frames = pChObj->totalFrames - pChObj->lastPrintFrames;
+
+            printf("# INFO: DATA: CH%d: %8.2f fps, %8.2f MB/s, interval min %7.2f max %7.2f ms, jitter %7.2f ms, waited %8.2f ms for producer\n",
+                i,
+                intervalSec > 0 ? frames/intervalSec : 0.0,
+                intervalSec > 0 ?
+                    (pChObj->totalDataSize - pChObj->lastPrintDataSize)/(1024.0*1024)/intervalSec
+                    : 0.0,
+                frames > 1 ? pChObj->minInterval/1000.0 : 0.0,
+                frames > 1 ? pChObj->maxInterval/1000.0 : 0.0,
+                frames > 1 ? (pChObj->maxInterval - pChObj->minInterval)/1000.0 : 0.0,
+                pChObj->waitTimeInUsec/1000.0
+                );
+
+            pChObj->minInterval = (Uint64)-1;
+            pChObj->maxInterval = 0;
+            pChObj->waitTimeInUsec = 0;
+        }
 
+        pChObj->lastPrintFrames = pChObj->totalFrames;
+        pChObj->lastPrintDataSize = pChObj->totalDataSize;
     }
+
+    gNetworkTx_obj.lastPrintTime = curTime;
 }
 
 int ConnectToServer()
@@ -330,6 +846,13 @@ int ConnectToServer()
 
     printf("# Connecting to server %s:%d ...\n", gNetworkTx_obj.ipAddr, gNetworkTx_obj.serverPort);
     status = Network_connect(&gNetworkTx_obj.sockObj, gNetworkTx_obj.ipAddr, gNetworkTx_obj.serverPort);
+    if(status==0)
+    {
+        /* header and payload are sent with one call, so send right away
+         * instead of waiting for ACK of previous frame
+         */
+        Network_setNoDelay(&gNetworkTx_obj.sockObj);
+    }
     return status;
 }
 
@@ -348,7 +871,9 @@ void ParseCmdLineArgs(int argc, char *argv[])
 
     gNetworkTx_obj.serverPort = NETWORK_RX_SERVER_PORT;
     gNetworkTx_obj.numCh = 0;
-    memset(gNetworkTx_obj.fileName, 0, sizeof(gNetworkTx_obj.fileName));
+    gNetworkTx_obj.numFps = 0;
+    gNetworkTx_obj.pacingBurst = DEFAULT_PACING_BURST;
+    gNetworkTx_obj.numPrefetch = DEFAULT_PREFETCH_FRAMES;
 
     for(i=0; i<argc; i++)
     {
@@ -372,13 +897,53 @@ void ParseCmdLineArgs(int argc, char *argv[])
             gNetworkTx_obj.serverPort = atoi(argv[i]);
         }
         else
+        if(strcmp(argv[i], "--fps")==0)
+        {
+            p=0;
+            for( ;i+1<argc && strncmp(argv[i+1], "--", 2)!=0 && p<MAX_CH;i++)
+            {
+                gNetworkTx_obj.fps[p] = atof(argv[i+1]);
+                p++;
+            }
+            if(p==0)
+            {
+                ShowUsage();
+            }
+            gNetworkTx_obj.numFps = p;
+        }
+        else
+        if(strcmp(argv[i], "--burst")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gNetworkTx_obj.pacingBurst = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--prefetch")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            gNetworkTx_obj.numPrefetch = atoi(argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--compress")==0)
+        {
+            gNetworkTx_obj.compress = TRUE;
+        }
+        else
         if(strcmp(argv[i], "--files")==0)
         {
             i++;
             p=0;
-            for( ;i<argc;i++)
+            for( ;i<argc && p<MAX_CH;i++)
             {
-                strcpy(gNetworkTx_obj.fileName[p], argv[i]);
+                strcpy(gNetworkTx_obj.chObj[p].fileName, argv[i]);
                 p++;
             }
 
@@ -405,15 +970,32 @@ void ParseCmdLineArgs(int argc, char *argv[])
         exit(0);
     }
 
+    if(gNetworkTx_obj.pacingBurst < 1)
+        gNetworkTx_obj.pacingBurst = 1;
+
+    if(gNetworkTx_obj.numPrefetch < 1)
+        gNetworkTx_obj.numPrefetch = 1;
+    if(gNetworkTx_obj.numPrefetch > MAX_PREFETCH_FRAMES)
+        gNetworkTx_obj.numPrefetch = MAX_PREFETCH_FRAMES;
+
     for(p=0; p<gNetworkTx_obj.numCh; p++)
     {
-        status = stat(gNetworkTx_obj.fileName[p], &fileStat);
+        status = stat(gNetworkTx_obj.chObj[p].fileName, &fileStat);
         if(status<0)
         {
-            printf("# ERROR: [%s] input file NOT found !!!\n", gNetworkTx_obj.fileName[p]);
+            printf("# ERROR: [%s] input file NOT found !!!\n", gNetworkTx_obj.chObj[p].fileName);
             ShowUsage();
             exit(0);
         }
-        gNetworkTx_obj.fd[p] = NULL;
+
+        gNetworkTx_obj.chObj[p].chId = p;
+
+        if(gNetworkTx_obj.numFps > 0)
+        {
+            if(p < gNetworkTx_obj.numFps)
+                gNetworkTx_obj.chObj[p].fps = gNetworkTx_obj.fps[p];
+            else
+                gNetworkTx_obj.chObj[p].fps = gNetworkTx_obj.fps[gNetworkTx_obj.numFps-1];
+        }
     }
 }
@@ -16,18 +16,177 @@ extern "C" {
 
 
 #include <osa.h>
+#include <osa_file.h>
+#include <osa_que.h>
+#include <osa_thr.h>
 #include <networkCtrl_if.h>
 #include <network_api.h>
+#include <network_codec.h>
 
 #define MAX_CH  (8)
 
 #define NETWORK_ERROR   (-1)
 #define NETWORK_INVALID_HEADER  (-2)
 
-#define MAX_BUF_SIZE    (1920*1080*2)
+/* Interval at which throughput is printed */
+#define STATS_PRINT_INTERVAL_MSEC   (2000)
+
+/* When pacing, sleep till this much before the send time and poll after
+ * that, since OS sleep is not precise
+ */
+#define PACING_POLL_USEC            (2000)
+
+/* Frames a paced channel can send back to back to catch up after the target
+ * requested late
+ */
+#define DEFAULT_PACING_BURST        (2)
+
+/* Frames prepared ahead of the request by producer thread of a channel */
+#define DEFAULT_PREFETCH_FRAMES     (4)
+#define MAX_PREFETCH_FRAMES         (64)
+
+/* Stride at which mapped file is touched to bring it into memory */
+#define PREFETCH_PAGE_SIZE          (4096)
+
+/* Initial number of entries in JPEG frame index, grows as needed */
+#define FRAME_INDEX_INIT_SIZE       (1024)
 
 //#define DEBUG_LOG
 
+/* Location of one JPEG frame in the input file */
+typedef struct {
+
+    Uint64 offset;
+
+    UInt32 size;
+
+} NetworkTx_FrameIndex;
+
+/* Frame prepared by producer thread, points into the mapped file or, when
+ * compressed, into encBuf
+ */
+typedef struct {
+
+    UInt8 *dataBuf;
+
+    UInt32 dataSize;
+
+    UInt8 *encBuf;
+    /**< Compressed frame, allocated only with --compress */
+
+    Bool isCompressed;
+
+    Bool isEncodeSkipped;
+    /**< Sent uncompressed without encoding, channel backs off */
+
+    UInt32 rawSize;
+    /**< Size before compression */
+
+    Uint64 encTimeInUsec;
+
+} NetworkTx_Frame;
+
+typedef struct {
+
+    int chId;
+
+    char fileName[1024];
+
+    OSA_FileMapHndl fileMap;
+    /**< Input file, mapped on first request for the channel */
+
+    Bool isStarted;
+    /**< Producer is running, set on first request for the channel */
+
+    UInt32 payloadType;
+    /**< Payload type of first request, NETWORK_RX_TYPE_xxx */
+
+    UInt32 rawFrameSize;
+    /**< Size of first request, for non-JPEG payloads */
+
+    UInt32 width;
+
+    UInt32 height;
+
+    UInt32 pitch[2];
+    /**< Frame layout of first request, for non-JPEG payloads */
+
+    Bool isCompress;
+    /**< Frames are compressed, --compress was given and format is
+     *   supported */
+
+    UInt32 encBufSize;
+
+    NetworkCodec_Backoff encBackoff;
+    /**< Encode backoff, used by producer thread */
+
+    NetworkTx_FrameIndex *frameIndex;
+    /**< JPEG frames in the file, built once on first MJPEG request */
+
+    UInt32 numFrames;
+
+    UInt32 curFrame;
+    /**< Next JPEG frame to prepare */
+
+    Uint64 curOffset;
+    /**< Offset of next raw frame to prepare */
+
+    int frameCount;
+    /**< Frames prepared since start of file */
+
+    NetworkTx_Frame frames[MAX_PREFETCH_FRAMES];
+
+    OSA_QueHndl freeQue;
+
+    OSA_QueHndl fullQue;
+    /**< Frames prepared and waiting to be sent */
+
+    OSA_ThrHndl thrHndl;
+    /**< Producer thread */
+
+    float fps;
+    /**< Max frames per second, 0: send as fast as requested */
+
+    double tokens;
+    /**< Frames that can be sent now, refilled at 'fps' upto pacing burst */
+
+    Uint64 lastTokenTime;
+
+    Uint64 lastSendTime;
+
+    int totalFrames;
+
+    unsigned long long totalDataSize;
+
+    int dropCount;
+    /**< JPEG frames larger than buffer of target, not sent */
+
+    int lastPrintFrames;
+
+    unsigned long long lastPrintDataSize;
+
+    Uint64 minInterval;
+    /**< Min time between frames since last print */
+
+    Uint64 maxInterval;
+    /**< Max time between frames since last print */
+
+    unsigned long long waitTimeInUsec;
+    /**< Time waited for next frame from producer */
+
+    unsigned long long totalRawSize;
+    /**< Size of sent frames before compression */
+
+    unsigned long long totalEncInSize;
+    /**< Size of sent frames which were encoded, for compression rate */
+
+    int encSkipCount;
+    /**< Frames sent without encoding, see NetworkCodec_Backoff */
+
+    unsigned long long encTimeInUsec;
+
+} NetworkTx_ChObj;
+
 typedef struct {
 
     UInt16 serverPort;
@@ -39,13 +198,23 @@ typedef struct {
 
     int numCh;
 
-    char fileName[MAX_CH][1024];
+    NetworkTx_ChObj chObj[MAX_CH];
 
-    UInt8 *dataBuf;
+    int numFps;
+
+    float fps[MAX_CH];
+    /**< --fps values, last value applies to remaining channels */
+
+    int pacingBurst;
+
+    int numPrefetch;
+
+    Bool compress;
+    /**< --compress, send YUV frames as NETWORK_RX_TYPE_VIDEO_FRAME_COMPRESSED */
 
-    FILE *fd[MAX_CH];
+    Uint64 startTime;
 
-    int frameCount[MAX_CH];
+    Uint64 lastPrintTime;
 
 } NetworkTx_Obj;
 
@@ -58,11 +227,19 @@ void CloseConnection();
 void Init();
 void DeInit();
 
-int WriteCmdHeader(NetworkRx_CmdHeader *pHeader);
 int ReadCmdHeader(NetworkRx_CmdHeader *pHeader);
-int WriteData(NetworkRx_CmdHeader *pHeader);
+int WriteFrame(NetworkRx_CmdHeader *pHeader, UInt8 *dataBuf);
 void SendData();
-int ReadData(NetworkRx_CmdHeader *pHeader);
+int StartChannel(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader);
+void StopChannel(NetworkTx_ChObj *pChObj);
+void *ProducerThreadMain(void *prm);
+NetworkTx_Frame *GetFrame(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader);
+int ReadData(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame);
+int BuildJpegIndex(NetworkTx_ChObj *pChObj);
+int CreateEncBufs(NetworkTx_ChObj *pChObj, NetworkRx_CmdHeader *pHeader);
+void CompressFrame(NetworkTx_ChObj *pChObj, NetworkTx_Frame *pFrame);
+void WaitForToken(NetworkTx_ChObj *pChObj);
+void PrintStatistics(Bool isFinal);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,327 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#include "remote_log_decoder_priv.h"
+
+RemoteLogDecoder_Obj gRemoteLogDecoder_obj;
+
+static char *gRemoteLogDecoder_procName[REMOTE_LOG_DECODER_MAX_CORES] =
+{
+    "IPU1_0", "IPU1_1", "A15_0", "DSP1", "DSP2", "EVE1", "EVE2", "EVE3", "EVE4"
+};
+
+void ShowUsage()
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# remote_log_decoder --file <remote log memory dump> [--all]\n");
+    printf("# \n");
+    printf("#   --file : binary dump of REMOTE_LOG_MEM section, for example saved from CCS\n");
+    printf("#            or with 'dd' from /dev/mem on Linux\n");
+    printf("#   --all  : also decode records which were already printed by the target,\n");
+    printf("#            by default only records not yet printed are decoded\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2016\n");
+    printf("# \n");
+    exit(0);
+}
+
+void ParseCmdLineArgs(int argc, char *argv[])
+{
+    int i;
+
+    memset(&gRemoteLogDecoder_obj, 0, sizeof(gRemoteLogDecoder_obj));
+
+    for(i=0; i<argc; i++)
+    {
+        if(strcmp(argv[i], "--file")==0)
+        {
+            i++;
+            if(i>=argc)
+            {
+                ShowUsage();
+            }
+            strcpy(gRemoteLogDecoder_obj.fileName, argv[i]);
+        }
+        else
+        if(strcmp(argv[i], "--all")==0)
+        {
+            gRemoteLogDecoder_obj.decodeAll = 1;
+        }
+    }
+
+    if(gRemoteLogDecoder_obj.fileName[0]==0)
+    {
+        printf("# ERROR: Remote log memory dump file MUST be specified\n");
+        ShowUsage();
+    }
+}
+
+int ReadDump()
+{
+    FILE *fp;
+    long size;
+    UInt32 hdrSize;
+
+    fp = fopen(gRemoteLogDecoder_obj.fileName, "rb");
+    if(fp==NULL)
+    {
+        printf("# ERROR: Unable to open file [%s]\n", gRemoteLogDecoder_obj.fileName);
+        return -1;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    hdrSize = sizeof(RemoteLogDecoder_MemInfo)*REMOTE_LOG_DECODER_MAX_CORES;
+
+    if(size <= (long)hdrSize)
+    {
+        printf("# ERROR: File [%s] is too small (%ld bytes) for a remote log memory dump\n",
+            gRemoteLogDecoder_obj.fileName, size);
+        fclose(fp);
+        return -1;
+    }
+
+    gRemoteLogDecoder_obj.pDump = malloc(size);
+    if(gRemoteLogDecoder_obj.pDump==NULL)
+    {
+        printf("# ERROR: Unable to allocate memory for file [%s]\n", gRemoteLogDecoder_obj.fileName);
+        exit(0);
+    }
+
+    if(fread(gRemoteLogDecoder_obj.pDump, 1, size, fp)!=(size_t)size)
+    {
+        printf("# ERROR: Unable to read file [%s]\n", gRemoteLogDecoder_obj.fileName);
+        fclose(fp);
+        return -1;
+    }
+
+    fclose(fp);
+
+    gRemoteLogDecoder_obj.dumpSize   = size;
+    gRemoteLogDecoder_obj.pMemInfo   = (RemoteLogDecoder_MemInfo*)gRemoteLogDecoder_obj.pDump;
+    gRemoteLogDecoder_obj.pLogBuf    = gRemoteLogDecoder_obj.pDump + hdrSize;
+    gRemoteLogDecoder_obj.logBufSize = size - hdrSize;
+
+    return 0;
+}
+
+/*
+ * Copy format string, arguments are 32-bit on target so %p is printed
+ * as 32-bit hex on PC
+ */
+static void ConvertFormat(char *pDst, char *pSrc, UInt32 maxSize)
+{
+    UInt32 i = 0;
+    int inConv = 0;
+
+    while(*pSrc && i < maxSize-1)
+    {
+        if(inConv)
+        {
+            if(*pSrc=='p')
+            {
+                pDst[i++] = 'x';
+                pSrc++;
+                inConv = 0;
+                continue;
+            }
+            if(strchr("diuxXoc%", *pSrc))
+                inConv = 0;
+        }
+        else
+        if(*pSrc=='%')
+        {
+            inConv = 1;
+        }
+
+        pDst[i++] = *pSrc++;
+    }
+
+    pDst[i] = 0;
+}
+
+/* Format record at 'slotIdx', returns number of slots in record, 0 if not a valid record */
+static UInt32 DecodeRecord(RemoteLog_BinInfo *pBinInfo, UInt8 *pRegion, UInt32 slotIdx, UInt32 maxSlots, char *pLine)
+{
+    UInt32 *pRing;
+    char *pStrTable;
+    UInt32 rec[REMOTE_LOG_BIN_MAX_REC_SLOTS*REMOTE_LOG_BIN_SLOT_WORDS];
+    char format[REMOTE_LOG_DECODER_LINE_SIZE];
+    UInt32 hdr, recSlots, wordIdx, wordMask, numArgs, fmtId, i, *pArgs;
+    int len;
+
+    pStrTable = (char*)pRegion;
+    pRing     = (UInt32*)(pRegion + pBinInfo->strTableSize);
+
+    wordIdx  = slotIdx*REMOTE_LOG_BIN_SLOT_WORDS;
+    wordMask = pBinInfo->numSlots*REMOTE_LOG_BIN_SLOT_WORDS - 1;
+
+    hdr      = pRing[wordIdx & wordMask];
+    recSlots = REMOTE_LOG_BIN_GET_NUM_SLOTS(hdr);
+
+    if(REMOTE_LOG_BIN_GET_SEQ(hdr) != (slotIdx & 0xFFFF)
+        || recSlots==0
+        || recSlots > REMOTE_LOG_BIN_MAX_REC_SLOTS
+        || recSlots > maxSlots)
+        return 0;
+
+    for(i=0; i<recSlots*REMOTE_LOG_BIN_SLOT_WORDS; i++)
+    {
+        rec[i] = pRing[(wordIdx + i) & wordMask];
+    }
+
+    if(REMOTE_LOG_BIN_GET_TYPE(hdr)==REMOTE_LOG_BIN_TYPE_FMT)
+    {
+        numArgs = REMOTE_LOG_BIN_GET_NUM_ARGS(hdr);
+        fmtId   = rec[2];
+        pArgs   = &rec[REMOTE_LOG_BIN_FMT_HDR_WORDS];
+
+        if(numArgs > REMOTE_LOG_BIN_MAX_ARGS
+            || REMOTE_LOG_BIN_FMT_HDR_WORDS + numArgs > recSlots*REMOTE_LOG_BIN_SLOT_WORDS
+            || fmtId >= pBinInfo->strTableUsed
+            || memchr(pStrTable + fmtId, 0, pBinInfo->strTableUsed - fmtId)==NULL)
+            return 0;
+
+        for(i=numArgs; i<REMOTE_LOG_BIN_MAX_ARGS; i++)
+            pArgs[i] = 0;
+
+        ConvertFormat(format, pStrTable + fmtId, sizeof(format));
+
+        len = snprintf(pLine, REMOTE_LOG_DECODER_LINE_SIZE, "%6d.%06u s: ",
+                rec[1]/1000000, rec[1]%1000000);
+
+        snprintf(pLine + len, REMOTE_LOG_DECODER_LINE_SIZE - len, format,
+            pArgs[0], pArgs[1], pArgs[2], pArgs[3], pArgs[4],
+            pArgs[5], pArgs[6], pArgs[7], pArgs[8], pArgs[9],
+            pArgs[10], pArgs[11], pArgs[12]);
+    }
+    else
+    if(REMOTE_LOG_BIN_GET_TYPE(hdr)==REMOTE_LOG_BIN_TYPE_TEXT)
+    {
+        len = recSlots*REMOTE_LOG_BIN_SLOT_SIZE - REMOTE_LOG_BIN_TEXT_HDR_WORDS*4;
+        memcpy(pLine, &rec[REMOTE_LOG_BIN_TEXT_HDR_WORDS], len);
+        pLine[len] = 0;
+    }
+    else
+    {
+        return 0;
+    }
+
+    len = strlen(pLine);
+    while(len > 0 && (pLine[len-1]=='\n' || pLine[len-1]=='\r'))
+        len--;
+    pLine[len] = 0;
+
+    return recSlots;
+}
+
+void DecodeCore(UInt32 coreId)
+{
+    RemoteLog_BinInfo *pBinInfo;
+    UInt8 *pRegion;
+    UInt32 slotIdx, endIdx, recSlots, numRecords, numSkipped;
+    char line[REMOTE_LOG_DECODER_LINE_SIZE];
+
+    pBinInfo = &gRemoteLogDecoder_obj.pMemInfo[coreId].binInfo;
+
+    if(pBinInfo->binMode != REMOTE_LOG_BIN_MODE_MAGIC)
+        return;
+
+    if(pBinInfo->numSlots==0
+        || (pBinInfo->numSlots & (pBinInfo->numSlots-1))!=0
+        || (UInt64)pBinInfo->regionOffset + pBinInfo->strTableSize
+                + (UInt64)pBinInfo->numSlots*REMOTE_LOG_BIN_SLOT_SIZE
+                    > gRemoteLogDecoder_obj.logBufSize
+        || pBinInfo->strTableUsed > pBinInfo->strTableSize)
+    {
+        printf("# ERROR: %s: Invalid binary log info, skipping\n", gRemoteLogDecoder_procName[coreId]);
+        return;
+    }
+
+    pRegion = gRemoteLogDecoder_obj.pLogBuf + pBinInfo->regionOffset;
+
+    endIdx  = pBinInfo->wrIdx;
+    slotIdx = pBinInfo->rdIdx;
+
+    if(gRemoteLogDecoder_obj.decodeAll)
+    {
+        /* oldest slot still in ring, may start in middle of a record */
+        slotIdx = endIdx - pBinInfo->numSlots;
+        if(endIdx < pBinInfo->numSlots)
+            slotIdx = 0;
+    }
+
+    printf("# \n");
+    printf("# %s: %d slots, %d of %d string table bytes used, %d records dropped\n",
+        gRemoteLogDecoder_procName[coreId],
+        pBinInfo->numSlots,
+        pBinInfo->strTableUsed,
+        pBinInfo->strTableSize,
+        pBinInfo->overflowCount);
+    printf("# \n");
+
+    numRecords = 0;
+    numSkipped = 0;
+
+    while(slotIdx != endIdx)
+    {
+        recSlots = DecodeRecord(pBinInfo, pRegion, slotIdx, endIdx - slotIdx, line);
+        if(recSlots==0)
+        {
+            /* not start of a record, or record was not completed */
+            slotIdx++;
+            numSkipped++;
+            continue;
+        }
+
+        printf("[%-6s] %s\n", gRemoteLogDecoder_procName[coreId], line);
+
+        slotIdx += recSlots;
+        numRecords++;
+    }
+
+    if(numSkipped)
+    {
+        printf("# %s: %d records decoded, %d slots skipped\n",
+            gRemoteLogDecoder_procName[coreId], numRecords, numSkipped);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    UInt32 coreId, numBinCores;
+
+    ParseCmdLineArgs(argc, argv);
+
+    if(ReadDump()!=0)
+        exit(0);
+
+    numBinCores = 0;
+
+    for(coreId=0; coreId<REMOTE_LOG_DECODER_MAX_CORES; coreId++)
+    {
+        if(gRemoteLogDecoder_obj.pMemInfo[coreId].binInfo.binMode == REMOTE_LOG_BIN_MODE_MAGIC)
+        {
+            DecodeCore(coreId);
+            numBinCores++;
+        }
+    }
+
+    if(numBinCores==0)
+    {
+        printf("# ERROR: No core is logging in binary mode in file [%s]\n", gRemoteLogDecoder_obj.fileName);
+    }
+
+    free(gRemoteLogDecoder_obj.pDump);
+
+    return 0;
+}
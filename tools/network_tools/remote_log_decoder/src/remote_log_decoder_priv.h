@@ -0,0 +1,67 @@
+ /*
+ *******************************************************************************
+ *
+ * Copyright (C) 2016 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+#ifndef _REMOTE_LOG_DECODER_PRIV_H_
+#define _REMOTE_LOG_DECODER_PRIV_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <osa.h>
+#include <remoteLogBin_if.h>
+
+/* Same as SYSTEM_PROC_MAX on target */
+#define REMOTE_LOG_DECODER_MAX_CORES    (9)
+
+#define REMOTE_LOG_DECODER_LINE_SIZE    (1024)
+
+/* Same as RemoteLog_MemInfo on target */
+typedef struct {
+
+    UInt32 headerTag;
+    UInt32 serverIdx;
+    UInt32 clientIdx;
+    UInt32 appInitState;
+    RemoteLog_BinInfo binInfo;
+
+} RemoteLogDecoder_MemInfo;
+
+typedef struct {
+
+    char fileName[1024];
+
+    int  decodeAll;
+    /* decode records already read by the target log client as well */
+
+    UInt8 *pDump;
+    UInt32 dumpSize;
+
+    RemoteLogDecoder_MemInfo *pMemInfo;
+    UInt8 *pLogBuf;
+    UInt32 logBufSize;
+
+} RemoteLogDecoder_Obj;
+
+extern RemoteLogDecoder_Obj gRemoteLogDecoder_obj;
+
+void ShowUsage();
+void ParseCmdLineArgs(int argc, char *argv[]);
+int  ReadDump();
+void DecodeCore(UInt32 coreId);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif
+
+/* @} */
+
@@ -0,0 +1,54 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host replacement of src/links_common/system/system_priv_common.h, so that
+ * link sources can be compiled as is. Has the utils and link APIs used by
+ * the links under test, the test implements the ones it calls. BSP and codec
+ * headers are not included.
+ */
+
+#ifndef _SYSTEM_PRIV_COMMON_H_
+#define _SYSTEM_PRIV_COMMON_H_
+
+typedef unsigned int Uint32;
+typedef long long    Int64;
+typedef struct FVID2_Frame_t  FVID2_Frame;
+typedef struct FVID2_Format_t FVID2_Format;
+
+#include <src/utils_common/include/utils.h>
+#include <src/utils_common/include/utils_prf.h>
+#include <src/utils_common/include/utils_tsk.h>
+#include <src/utils_common/include/utils_buf.h>
+#include <src/utils_common/include/utils_mem.h>
+
+#include <include/link_api/system.h>
+#include <include/link_api/system_common.h>
+#include <include/link_api/systemLink_common.h>
+
+#include <src/utils_common/src/utils_link_stats_collector.h>
+
+#define SYSTEM_LINK_STATE_IDLE          (0)
+#define SYSTEM_LINK_STATE_CREATED       (1)
+#define SYSTEM_LINK_STATE_RUNNING       (2)
+
+Int32 Vps_printf(const char * format, ... );
+
+typedef Void (*BspOsal_ClockFuncPtr)(UArg arg);
+typedef struct UtilsHostOsal_Clock *BspOsal_ClockHandle;
+
+BspOsal_ClockHandle BspOsal_clockCreate(BspOsal_ClockFuncPtr func,
+                                        UInt32 period,
+                                        Bool startFlag,
+                                        Ptr arg);
+void BspOsal_clockDelete(BspOsal_ClockHandle *pHndl);
+void BspOsal_clockStart(BspOsal_ClockHandle hndl);
+void BspOsal_clockStop(BspOsal_ClockHandle hndl);
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host replacement of src/utils_common/include/utils.h, found before the
+ * target header since ./inc is first in include path. Only has the BIOS and
+ * BSP OSAL APIs used by the utils sources under test, implemented with
+ * POSIX threads in utils_host_osal.c.
+ *
+ * Hwi_disable() and Task_disable() take one global lock. This gives the
+ * same mutual exclusion as on a single core, where only one context runs
+ * at a time, but unlike on target a thread holding it can be preempted.
+ */
+
+#ifndef _UTILS_H_
+#define _UTILS_H_
+
+#include <stdint.h>
+#include "utils_host_test.h"
+
+/* BIOS tick is 1 msec, timeouts are in msecs */
+#define BSP_OSAL_WAIT_FOREVER   (~((UInt32) 0U))
+#define BSP_OSAL_NO_WAIT        ((UInt32) 0U)
+
+typedef struct UtilsHostOsal_Sem  *BspOsal_SemHandle;
+typedef struct UtilsHostOsal_Task *BspOsal_TaskHandle;
+
+BspOsal_SemHandle BspOsal_semCreate(Int32 initValue, Bool isBinary);
+Int32 BspOsal_semDelete(BspOsal_SemHandle *pHndl);
+Bool  BspOsal_semWait(BspOsal_SemHandle hndl, UInt32 timeout);
+void  BspOsal_semPost(BspOsal_SemHandle hndl);
+
+UInt32 Hwi_disable(void);
+void   Hwi_restore(UInt32 key);
+
+UInt   Task_disable(void);
+void   Task_restore(UInt key);
+
+/* defined by the test which needs it */
+UInt64 Utils_getCurGlobalTimeInUsec(void);
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host replacement of src/utils_common/include/utils_mem_debug.h, the target
+ * header walks BIOS and IPC heaps. Nothing from it is used on host.
+ */
+
+#ifndef _UTILS_MEM_DEBUG_H_
+#define _UTILS_MEM_DEBUG_H_
+
+#endif
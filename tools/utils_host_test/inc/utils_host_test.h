@@ -0,0 +1,47 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Common header of host tests, utils sources are compiled as is with
+ * LINUX_BUILD types from linux/src/osa. OSA UTILS_assert() waits for a key
+ * press, for tests it is replaced by one which aborts.
+ */
+
+#ifndef _UTILS_HOST_TEST_H_
+#define _UTILS_HOST_TEST_H_
+
+#include <include/link_api/system.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#undef  UTILS_assert
+#define UTILS_assert(x)                                                       \
+    do {                                                                      \
+        if((x) == 0) {                                                        \
+            fprintf(stderr, " ASSERT (%s|%s|%d)\n",                           \
+                        __FILE__, __func__, __LINE__);                        \
+            abort();                                                          \
+        }                                                                     \
+    } while(0)
+
+#ifndef UTILS_ARRAYSIZE
+#define UTILS_ARRAYSIZE(array)             ((sizeof(array)/sizeof((array)[0])))
+#endif
+
+static inline UInt64 UtilsHostTest_getTimeInUsec(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return (UInt64)tv.tv_sec*1000000ULL + (UInt64)tv.tv_usec;
+}
+
+#endif
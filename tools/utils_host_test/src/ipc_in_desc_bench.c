@@ -0,0 +1,193 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host benchmark of IPC IN descriptor modes, IPC_LINK_DESC_MODE_COPY and
+ * IPC_LINK_DESC_MODE_ZERO_COPY
+ *
+ * ipcInLink_drv.c needs BIOS and IPC, so the per buffer work of
+ * IpcInLink_drvCopyIpcBufferToSystemBuffer() is done here on the target
+ * System_IpcBuffer and System_Buffer structures, followed by the next link
+ * reading the payload once. Time per buffer is printed for every payload
+ * type, with IPC elements,
+ *   - warm: a 8 element IPC queue which stays in cache
+ *   - cold: elements spread over a large area so every element read misses
+ *           cache, the nearest a host gets to non-cached shared memory
+ *
+ * On target the IPC shared memory is non-cached, so in ZERO_COPY every read
+ * the next link does on the payload goes to memory, while on host only the
+ * first read of a cold element misses. Host numbers hence show the saving
+ * of the memcpy, the cost moved to the next link is a lower bound. On
+ * target, IPC IN prints the average ns/buffer of the mode in use with
+ * its statistics.
+ */
+
+#include "utils_host_test.h"
+#include <include/link_api/ipcLink.h>
+#include <include/link_api/system_inter_link_api.h>
+
+#define BENCH_NUM_BUFFERS       (2000000U)
+#define BENCH_WARM_ELEMENTS     (8U)
+#define BENCH_COLD_SIZE         (64U*1024U*1024U)
+#define BENCH_COLD_STRIDE       (4096U + 64U)
+
+typedef struct {
+
+    char    *name;
+    UInt32   bufType;
+    UInt32   payloadSize;
+
+} Bench_PayloadType;
+
+static Bench_PayloadType gBench_payloadType[] = {
+    { "Video frame",           SYSTEM_BUFFER_TYPE_VIDEO_FRAME,
+                               sizeof(System_VideoFrameBuffer) },
+    { "Video frame composite", SYSTEM_BUFFER_TYPE_VIDEO_FRAME_CONTAINER,
+                               sizeof(System_VideoFrameCompositeBuffer) },
+    { "Bitstream",             SYSTEM_BUFFER_TYPE_BITSTREAM,
+                               sizeof(System_BitstreamBuffer) },
+    { "Meta data",             SYSTEM_BUFFER_TYPE_METADATA,
+                               sizeof(System_MetaDataBuffer) },
+};
+
+/* keeps the payload reads of the next link from being optimized out */
+static volatile UInt32 gBench_sink;
+
+/* same steps as IpcInLink_drvCopyIpcBufferToSystemBuffer() */
+static __attribute__((noinline))
+Void Bench_copyIpcBufferToSystemBuffer(UInt32 descMode,
+                                       System_Buffer *pBuffer,
+                                       System_IpcBuffer *pIpcBuffer,
+                                       UInt32 index)
+{
+    UInt32 flags = 0;
+
+    flags = pIpcBuffer->flags;
+
+    pBuffer->bufType            = (System_BufferType)SYSTEM_BUFFER_FLAG_GET_BUF_TYPE(flags);
+    pBuffer->chNum              = SYSTEM_BUFFER_FLAG_GET_CH_NUM(flags);
+    pBuffer->payloadSize        = SYSTEM_BUFFER_FLAG_GET_PAYLOAD_SIZE(flags);
+    pBuffer->srcTimestamp       = pIpcBuffer->srcTimestamp;
+    pBuffer->ipcInOrgQueElem    = (UInt32)index;
+
+    pBuffer->ipcPrfTimestamp64[0] = pIpcBuffer->ipcPrfTimestamp64[0];
+    pBuffer->ipcPrfTimestamp64[1] = pIpcBuffer->ipcPrfTimestamp64[1];
+
+    if(descMode == IPC_LINK_DESC_MODE_ZERO_COPY)
+    {
+        pBuffer->payload = pIpcBuffer->payload;
+    }
+    else
+    {
+        memcpy(pBuffer->payload, pIpcBuffer->payload, pBuffer->payloadSize);
+    }
+}
+
+/* next link reads every word of the payload once */
+static Void Bench_readPayload(const System_Buffer *pBuffer)
+{
+    const UInt32 *pWord = (const UInt32 *)pBuffer->payload;
+    UInt32 i, sum = 0;
+
+    for(i=0; i<pBuffer->payloadSize/sizeof(UInt32); i++)
+    {
+        sum += pWord[i];
+    }
+
+    gBench_sink += sum;
+}
+
+static double Bench_run(UInt32 descMode, const Bench_PayloadType *pType,
+                        UInt8 *pIpcMem, UInt32 numElements, UInt32 stride)
+{
+    System_Buffer sysBuf[BENCH_WARM_ELEMENTS];
+    UInt32 sysPayload[BENCH_WARM_ELEMENTS]
+                     [SYSTEM_MAX_PAYLOAD_SIZE/sizeof(UInt32)];
+    System_IpcBuffer *pIpcBuffer;
+    UInt64 startUs, elapsedUs;
+    UInt32 i, index;
+
+    memset(sysBuf, 0, sizeof(sysBuf));
+    memset(sysPayload, 0, sizeof(sysPayload));
+
+    for(i=0; i<numElements; i++)
+    {
+        pIpcBuffer = (System_IpcBuffer *)(pIpcMem + (UInt64)i*stride);
+
+        pIpcBuffer->flags = 0;
+        SYSTEM_BUFFER_FLAG_SET_BUF_TYPE(pIpcBuffer->flags, pType->bufType);
+        SYSTEM_BUFFER_FLAG_SET_CH_NUM(pIpcBuffer->flags, i%4U);
+        SYSTEM_BUFFER_FLAG_SET_PAYLOAD_SIZE(pIpcBuffer->flags,
+                                            pType->payloadSize);
+        memset(pIpcBuffer->payload, (int)i, sizeof(pIpcBuffer->payload));
+    }
+
+    startUs = UtilsHostTest_getTimeInUsec();
+
+    for(i=0; i<BENCH_NUM_BUFFERS; i++)
+    {
+        System_Buffer *pBuffer = &sysBuf[i%BENCH_WARM_ELEMENTS];
+
+        index      = i%numElements;
+        pIpcBuffer = (System_IpcBuffer *)(pIpcMem + (UInt64)index*stride);
+
+        /* link local System_Buffer payload, as set at IPC IN create */
+        pBuffer->payload = sysPayload[i%BENCH_WARM_ELEMENTS];
+
+        Bench_copyIpcBufferToSystemBuffer(descMode, pBuffer, pIpcBuffer,
+                                          index);
+        Bench_readPayload(pBuffer);
+    }
+
+    elapsedUs = UtilsHostTest_getTimeInUsec() - startUs;
+
+    return (double)elapsedUs*1000.0/BENCH_NUM_BUFFERS;
+}
+
+int main(int argc, char *argv[])
+{
+    UInt8 *pIpcMem;
+    UInt32 i, numCold;
+    double copyNs, zeroCopyNs;
+
+    pIpcMem = malloc(BENCH_COLD_SIZE);
+    UTILS_assert(pIpcMem != NULL);
+
+    numCold = BENCH_COLD_SIZE/BENCH_COLD_STRIDE;
+
+    printf(" %-22s %8s %-5s %12s %12s\n",
+           "Payload type", "bytes", "IPC", "COPY ns/buf", "ZERO ns/buf");
+
+    for(i=0; i<UTILS_ARRAYSIZE(gBench_payloadType); i++)
+    {
+        copyNs = Bench_run(IPC_LINK_DESC_MODE_COPY,
+                           &gBench_payloadType[i], pIpcMem,
+                           BENCH_WARM_ELEMENTS, sizeof(System_IpcBuffer));
+        zeroCopyNs = Bench_run(IPC_LINK_DESC_MODE_ZERO_COPY,
+                               &gBench_payloadType[i], pIpcMem,
+                               BENCH_WARM_ELEMENTS, sizeof(System_IpcBuffer));
+        printf(" %-22s %8u %-5s %12.1f %12.1f\n",
+               gBench_payloadType[i].name,
+               gBench_payloadType[i].payloadSize, "warm", copyNs, zeroCopyNs);
+
+        copyNs = Bench_run(IPC_LINK_DESC_MODE_COPY,
+                           &gBench_payloadType[i], pIpcMem,
+                           numCold, BENCH_COLD_STRIDE);
+        zeroCopyNs = Bench_run(IPC_LINK_DESC_MODE_ZERO_COPY,
+                               &gBench_payloadType[i], pIpcMem,
+                               numCold, BENCH_COLD_STRIDE);
+        printf(" %-22s %8u %-5s %12.1f %12.1f\n",
+               gBench_payloadType[i].name,
+               gBench_payloadType[i].payloadSize, "cold", copyNs, zeroCopyNs);
+    }
+
+    free(pIpcMem);
+
+    return 0;
+}
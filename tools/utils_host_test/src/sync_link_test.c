@@ -0,0 +1,856 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host test of src/links_common/sync/syncLink_tsk.c
+ *
+ * Sync link is compiled as is against the host system_priv_common.h in ./inc.
+ * The test is the previous link, the next link and the clock: commands are
+ * given to SyncLink_tskMain() directly, time is set by the test. Every set
+ * sent out is read with SyncLink_getFullBuffers() and released at once.
+ *
+ * For each policy, HEAD_AVERAGE, NEAREST_TO_MASTER, LATEST_COMPLETE_SET and
+ * PARTIAL_SET, a known sequence of buffers is sent and the sets and drops
+ * are checked against the expected ones. Aging of queued buffers beyond
+ * syncThreshold is checked on SYNC_LINK_CMD_TIMER_TICK.
+ *
+ * Every buffer given to the link must come back to the previous link once,
+ * either dropped or after its set is released, never more than
+ * SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST per call. This is checked for drops of
+ * inactive channels, full channel queues and more than a buffer list of
+ * aged buffers at once. Automatic master selection must not change when
+ * statistics are printed.
+ */
+
+#include "utils_host_test.h"
+#include <src/links_common/sync/syncLink_priv.h>
+
+#define TEST_PREV_LINK_ID       (0x10U)
+#define TEST_NEXT_LINK_ID       (0x20U)
+#define TEST_MAX_BUFS           (1024U)
+#define TEST_MAX_SETS           (256U)
+#define TEST_NO_BUF             (-1)
+#define TEST_DUMMY_BUF_SIZE     (16U)
+
+/* state of a buffer of the test */
+#define TEST_BUF_FREE           (0U)
+#define TEST_BUF_PENDING        (1U)
+#define TEST_BUF_IN_LINK        (2U)
+#define TEST_BUF_SENT           (3U)
+#define TEST_BUF_RELEASED       (4U)
+#define TEST_BUF_DROPPED        (5U)
+
+typedef struct {
+
+    Int32  tsMs[SYNC_LINK_MAX_CHANNELS];
+    /**< srcTimestamp in msecs of buffer of each channel, TEST_NO_BUF if
+     *   channel is missing */
+
+} Test_Set;
+
+Int32 SyncLink_getFullBuffers(Void * ptr, UInt16 queId,
+                              System_BufferList * pBufList);
+Int32 SyncLink_putEmptyBuffers(Void * ptr, UInt16 queId,
+                               System_BufferList * pBufList);
+
+static System_Buffer           gBuf[TEST_MAX_BUFS];
+static System_VideoFrameBuffer gVidBuf[TEST_MAX_BUFS];
+static UInt32                  gBufState[TEST_MAX_BUFS];
+static UInt32                  gNumBufs;
+
+static System_Buffer *gPendingBuf[TEST_MAX_BUFS];
+static UInt32         gNumPending;
+static UInt32         gPendingRdIdx;
+
+static Test_Set gSet[TEST_MAX_SETS];
+static UInt32   gNumSets;
+
+static UInt32 gNumChPrevLink;
+static UInt32 gDropCount;
+static UInt32 gMaxPutEmptyBufs;
+static Bool   gIsReleasing;
+static UInt64 gCurTimeInUsec;
+
+static System_LinkStatistics gLinkStats;
+static UInt8  gDummyBuf[3][TEST_DUMMY_BUF_SIZE];
+static UInt32 gNumDummyBufs;
+
+static UInt32 gErrorCount;
+
+static void Test_check(Bool cond, const char *msg, const char *testName)
+{
+    if(!cond)
+    {
+        if(gErrorCount < 20)
+        {
+            printf(" ERROR: %s: %s\n", testName, msg);
+        }
+        gErrorCount++;
+    }
+}
+
+/*
+ * Link and OS APIs used by sync link, test is the previous and next link
+ */
+
+UInt64 Utils_getCurGlobalTimeInUsec(void)
+{
+    return gCurTimeInUsec;
+}
+
+Int32 Vps_printf(const char * format, ... )
+{
+    return 0;
+}
+
+UInt32 System_getSelfProcId()
+{
+    return 0;
+}
+
+Int32 System_registerLink(UInt32 linkId, System_LinkObj * pTskObj)
+{
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 System_linkGetInfo(UInt32 linkId, System_LinkInfo *info)
+{
+    UTILS_assert(linkId == TEST_PREV_LINK_ID);
+
+    memset(info, 0, sizeof(*info));
+    info->numQue = 1;
+    info->queInfo[0].numCh = gNumChPrevLink;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 System_getLinksFullBuffers(UInt32 linkId, UInt16 queId,
+                                 System_BufferList *pBufList)
+{
+    UTILS_assert(linkId == TEST_PREV_LINK_ID);
+
+    pBufList->numBuf = 0;
+    while(gPendingRdIdx < gNumPending
+            && pBufList->numBuf < SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST)
+    {
+        pBufList->buffers[pBufList->numBuf] = gPendingBuf[gPendingRdIdx];
+        gBufState[gPendingBuf[gPendingRdIdx] - gBuf] = TEST_BUF_IN_LINK;
+        pBufList->numBuf++;
+        gPendingRdIdx++;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 System_putLinksEmptyBuffers(UInt32 linkId, UInt16 queId,
+                                  System_BufferList *pBufList)
+{
+    UInt32 bufId, idx;
+
+    UTILS_assert(linkId == TEST_PREV_LINK_ID);
+
+    if(pBufList->numBuf > gMaxPutEmptyBufs)
+        gMaxPutEmptyBufs = pBufList->numBuf;
+
+    for(bufId=0; bufId<pBufList->numBuf && bufId<SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST;
+        bufId++)
+    {
+        idx = pBufList->buffers[bufId] - gBuf;
+        UTILS_assert(idx < gNumBufs);
+
+        if(gIsReleasing)
+        {
+            Test_check(gBufState[idx]==TEST_BUF_SENT,
+                       "released buffer was not sent", "release");
+            gBufState[idx] = TEST_BUF_RELEASED;
+        }
+        else
+        {
+            Test_check(gBufState[idx]==TEST_BUF_IN_LINK,
+                       "dropped buffer not held by link", "drop");
+            gBufState[idx] = TEST_BUF_DROPPED;
+            gDropCount++;
+        }
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 System_sendLinkCmd(UInt32 linkId, UInt32 cmd, Void *payload)
+{
+    UTILS_assert(linkId == TEST_NEXT_LINK_ID);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 SyncLink_tskCreate(UInt32 instId)
+{
+    gSyncLink_obj[instId].tsk.appData = &gSyncLink_obj[instId];
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_tskDelete(Utils_TskHndl * pHndl)
+{
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_tskFlushMsg(Utils_TskHndl * pHndl, UInt32 *flushCmdId,
+                        UInt32 numCmds)
+{
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_mbxSendCmd(Utils_MbxHndl * pTo, UInt32 cmd, Void *payload)
+{
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_mbxAckOrFreeMsg(Utils_MsgHndl * pMsg, Int32 result)
+{
+    pMsg->result = result;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Ptr Utils_memAlloc(Utils_HeapId heapId, UInt32 size, UInt32 align)
+{
+    /* only used for blank frames of partial sets, address is enough */
+    return gDummyBuf[(gNumDummyBufs++) % 3];
+}
+
+System_LinkStatistics *Utils_linkStatsCollectorAllocInst(uint32_t linkId,
+                                                         char *linkName)
+{
+    memset(&gLinkStats, 0, sizeof(gLinkStats));
+
+    return &gLinkStats;
+}
+
+Int32 Utils_linkStatsCollectorDeAllocInst(System_LinkStatistics *linkStats)
+{
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Void Utils_linkStatsCollectorProcessCmd(System_LinkStatistics *linkStatsInfo)
+{
+}
+
+Void Utils_resetLinkStatistics(Utils_LinkStatistics *pPrm, uint32_t numCh,
+                               uint32_t numOut)
+{
+    memset(pPrm, 0, sizeof(*pPrm));
+}
+
+Void Utils_printLinkStatistics(Utils_LinkStatistics *pPrm, char *name,
+                               Bool resetStats)
+{
+}
+
+Void Utils_printLatency(char *name, Utils_LatencyStats *localLinkstats,
+                        Utils_LatencyStats *srcToLinkstats, Bool resetStats)
+{
+}
+
+BspOsal_ClockHandle BspOsal_clockCreate(BspOsal_ClockFuncPtr func,
+                                        UInt32 period,
+                                        Bool startFlag,
+                                        Ptr arg)
+{
+    /* ticks are sent by the test */
+    return (BspOsal_ClockHandle)gDummyBuf;
+}
+
+void BspOsal_clockDelete(BspOsal_ClockHandle *pHndl)
+{
+    *pHndl = NULL;
+}
+
+void BspOsal_clockStart(BspOsal_ClockHandle hndl)
+{
+}
+
+void BspOsal_clockStop(BspOsal_ClockHandle hndl)
+{
+}
+
+/* output queue of sync link, on top of utils_que */
+Int32 Utils_bufCreate(Utils_BufHndl * pHndl, Bool blockOnGet, Bool blockOnPut)
+{
+    Utils_queCreate(&pHndl->emptyQue, UTILS_BUF_MAX_QUE_SIZE,
+                    pHndl->emptyQueMem, UTILS_QUE_FLAG_NO_BLOCK_QUE);
+    Utils_queCreate(&pHndl->fullQue, UTILS_BUF_MAX_QUE_SIZE,
+                    pHndl->fullQueMem, UTILS_QUE_FLAG_NO_BLOCK_QUE);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_bufDelete(Utils_BufHndl * pHndl)
+{
+    Utils_queDelete(&pHndl->emptyQue);
+    Utils_queDelete(&pHndl->fullQue);
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Int32 Utils_bufGetEmptyBuffer(Utils_BufHndl * pHndl, System_Buffer ** pBuf,
+                              UInt32 timeout)
+{
+    return Utils_queGet(&pHndl->emptyQue, (Ptr *)pBuf, 1, timeout);
+}
+
+Int32 Utils_bufPutEmptyBuffer(Utils_BufHndl * pHndl, System_Buffer * pBuf)
+{
+    return Utils_quePut(&pHndl->emptyQue, pBuf, BSP_OSAL_NO_WAIT);
+}
+
+Int32 Utils_bufPutEmpty(Utils_BufHndl * pHndl, System_BufferList * pBufList)
+{
+    Int32 status = SYSTEM_LINK_STATUS_SOK;
+    UInt32 idx;
+
+    for(idx=0; idx<pBufList->numBuf && status==SYSTEM_LINK_STATUS_SOK; idx++)
+    {
+        status = Utils_bufPutEmptyBuffer(pHndl, pBufList->buffers[idx]);
+    }
+
+    return status;
+}
+
+Int32 Utils_bufPutFullBuffer(Utils_BufHndl * pHndl, System_Buffer * pBuf)
+{
+    return Utils_quePut(&pHndl->fullQue, pBuf, BSP_OSAL_NO_WAIT);
+}
+
+Int32 Utils_bufGetFull(Utils_BufHndl * pHndl, System_BufferList * pBufList,
+                       UInt32 timeout)
+{
+    pBufList->numBuf = 0;
+    while(pBufList->numBuf < SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST
+            && Utils_queGet(&pHndl->fullQue,
+                            (Ptr *)&pBufList->buffers[pBufList->numBuf],
+                            1, BSP_OSAL_NO_WAIT) == SYSTEM_LINK_STATUS_SOK)
+    {
+        pBufList->numBuf++;
+    }
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+/*
+ * Test helpers
+ */
+
+static SyncLink_Obj *Test_getObj(void)
+{
+    return &gSyncLink_obj[0];
+}
+
+static Int32 Test_sendCmd(UInt32 cmd, Void *pPrm)
+{
+    Utils_MsgHndl msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.cmd  = cmd;
+    msg.pPrm = pPrm;
+
+    SyncLink_tskMain(&Test_getObj()->tsk, &msg);
+
+    return msg.result;
+}
+
+static void Test_setTimeMs(UInt32 timeMs)
+{
+    gCurTimeInUsec = (UInt64)timeMs*1000U;
+}
+
+static void Test_create(SyncLink_CreateParams *pPrm, UInt32 numCh)
+{
+    gNumBufs      = 0;
+    gNumPending   = 0;
+    gPendingRdIdx = 0;
+    gNumSets      = 0;
+    gDropCount    = 0;
+    gNumChPrevLink = numCh;
+    memset(gBufState, 0, sizeof(gBufState));
+
+    pPrm->inQueParams.prevLinkId    = TEST_PREV_LINK_ID;
+    pPrm->inQueParams.prevLinkQueId = 0;
+    pPrm->outQueParams.nextLink     = TEST_NEXT_LINK_ID;
+
+    UTILS_assert(Test_sendCmd(SYSTEM_CMD_CREATE, pPrm)
+                    == SYSTEM_LINK_STATUS_SOK);
+    UTILS_assert(Test_sendCmd(SYSTEM_CMD_START, NULL)
+                    == SYSTEM_LINK_STATUS_SOK);
+}
+
+static void Test_delete(void)
+{
+    Test_sendCmd(SYSTEM_CMD_DELETE, NULL);
+}
+
+static SyncLink_CreateParams *Test_initPrm(SyncLink_CreateParams *pPrm,
+                                           UInt32 syncPolicy, UInt32 numCh)
+{
+    UInt32 chId;
+
+    SyncLink_CreateParams_Init(pPrm);
+
+    pPrm->syncPolicy = syncPolicy;
+    pPrm->masterCh   = 0;
+    pPrm->chParams.numCh         = numCh;
+    pPrm->chParams.syncDelta     = 10;
+    pPrm->chParams.syncThreshold = SYNC_DROP_THRESHOLD_MAX;
+    for(chId=0; chId<SYNC_LINK_MAX_CHANNELS; chId++)
+    {
+        pPrm->chParams.channelSyncList[chId] = (chId < numCh) ? TRUE : FALSE;
+    }
+
+    return pPrm;
+}
+
+/* queue a new buffer for the link, sent on next Test_newData() */
+static void Test_push(UInt32 chId, UInt32 tsMs)
+{
+    System_Buffer *pBuf;
+
+    UTILS_assert(gNumBufs < TEST_MAX_BUFS);
+
+    pBuf = &gBuf[gNumBufs];
+    memset(pBuf, 0, sizeof(*pBuf));
+    memset(&gVidBuf[gNumBufs], 0, sizeof(gVidBuf[gNumBufs]));
+
+    pBuf->bufType      = SYSTEM_BUFFER_TYPE_VIDEO_FRAME;
+    pBuf->chNum        = chId;
+    pBuf->payload      = &gVidBuf[gNumBufs];
+    pBuf->payloadSize  = sizeof(gVidBuf[gNumBufs]);
+    pBuf->srcTimestamp = (UInt64)tsMs*1000U;
+
+    gBufState[gNumBufs] = TEST_BUF_PENDING;
+    gPendingBuf[gNumPending++] = pBuf;
+    gNumBufs++;
+}
+
+/* read and release sets sent by the link */
+static void Test_collectSets(void)
+{
+    System_BufferList bufList;
+    SyncLink_OrigBufferPtr *pOrig;
+    UInt32 bufId, chId;
+
+    SyncLink_getFullBuffers(&Test_getObj()->tsk, 0, &bufList);
+
+    for(bufId=0; bufId<bufList.numBuf; bufId++)
+    {
+        pOrig = bufList.buffers[bufId]->pSyncLinkOrgBufferPtr;
+
+        UTILS_assert(gNumSets < TEST_MAX_SETS);
+
+        for(chId=0; chId<SYNC_LINK_MAX_CHANNELS; chId++)
+        {
+            gSet[gNumSets].tsMs[chId] = TEST_NO_BUF;
+
+            if(chId < pOrig->numChannels && pOrig->bufPtr[chId] != NULL)
+            {
+                gSet[gNumSets].tsMs[chId]
+                    = pOrig->bufPtr[chId]->srcTimestamp/1000U;
+                gBufState[pOrig->bufPtr[chId] - gBuf] = TEST_BUF_SENT;
+            }
+        }
+        gNumSets++;
+    }
+
+    gIsReleasing = TRUE;
+    SyncLink_putEmptyBuffers(&Test_getObj()->tsk, 0, &bufList);
+    gIsReleasing = FALSE;
+}
+
+static void Test_newData(void)
+{
+    while(gPendingRdIdx < gNumPending)
+    {
+        Test_sendCmd(SYSTEM_CMD_NEW_DATA, NULL);
+        Test_collectSets();
+    }
+}
+
+static void Test_tick(UInt32 timeMs)
+{
+    Test_setTimeMs(timeMs);
+    Test_sendCmd(SYNC_LINK_CMD_TIMER_TICK, NULL);
+    Test_collectSets();
+}
+
+static UInt32 Test_getBufState(UInt32 chId, UInt32 tsMs)
+{
+    UInt32 idx;
+
+    for(idx=0; idx<gNumBufs; idx++)
+    {
+        if(gBuf[idx].chNum==chId && gBuf[idx].srcTimestamp==(UInt64)tsMs*1000U)
+            return gBufState[idx];
+    }
+
+    return TEST_BUF_FREE;
+}
+
+static void Test_checkSets(const char *testName, const Test_Set *pExp,
+                           UInt32 numExp, UInt32 numCh)
+{
+    UInt32 setId, chId;
+    Bool isEqual = (Bool)(gNumSets == numExp);
+
+    for(setId=0; setId<numExp && isEqual; setId++)
+    {
+        for(chId=0; chId<numCh; chId++)
+        {
+            if(gSet[setId].tsMs[chId] != pExp[setId].tsMs[chId])
+                isEqual = FALSE;
+        }
+    }
+
+    if(!isEqual)
+    {
+        for(setId=0; setId<gNumSets; setId++)
+        {
+            printf(" %s: set %u:", testName, setId);
+            for(chId=0; chId<numCh; chId++)
+            {
+                printf(" %d", gSet[setId].tsMs[chId]);
+            }
+            printf("\n");
+        }
+    }
+
+    Test_check(isEqual, "sets sent", testName);
+}
+
+/* every buffer sent to link, and not held by it, came back once */
+static void Test_checkReturned(const char *testName, UInt32 numHeld)
+{
+    UInt32 idx, numReturned = 0;
+
+    for(idx=0; idx<gNumBufs; idx++)
+    {
+        if(gBufState[idx]==TEST_BUF_RELEASED || gBufState[idx]==TEST_BUF_DROPPED)
+            numReturned++;
+    }
+
+    Test_check(numReturned + numHeld == gNumBufs, "buffers returned",
+               testName);
+    Test_check(gDropCount == Test_getObj()->stats.totalDropCount,
+               "drop statistics", testName);
+}
+
+/*
+ * Policies
+ */
+
+static void Test_headAverage(void)
+{
+    const char *name = "HEAD_AVERAGE";
+    static const Test_Set expSet[] = {
+        { { 100, 102 } },
+        { { 133, 135 } },
+        { { 233, 230 } },
+    };
+    SyncLink_CreateParams prm;
+
+    Test_create(Test_initPrm(&prm, SYNC_LINK_POLICY_HEAD_AVERAGE, 2), 2);
+
+    Test_setTimeMs(300);
+
+    Test_push(0, 100); Test_push(1, 102);
+    Test_push(0, 133); Test_push(1, 135);
+    Test_newData();
+
+    /* average 215, ch0 below and ch1 above window, older one is dropped */
+    Test_push(0, 200); Test_push(1, 230);
+    Test_newData();
+    Test_push(0, 233);
+    Test_newData();
+
+    Test_checkSets(name, expSet, UTILS_ARRAYSIZE(expSet), 2);
+    Test_check(Test_getBufState(0, 200)==TEST_BUF_DROPPED, "out of sync drop",
+               name);
+    Test_checkReturned(name, 0);
+
+    Test_delete();
+}
+
+static void Test_nearestToMaster(void)
+{
+    const char *name = "NEAREST_TO_MASTER";
+    static const Test_Set expSet[] = {
+        { { 100, 103, 100 } },
+        { { 166, 169, 167 } },
+    };
+    SyncLink_CreateParams prm;
+
+    Test_create(Test_initPrm(&prm, SYNC_LINK_POLICY_NEAREST_TO_MASTER, 3), 3);
+
+    Test_setTimeMs(300);
+
+    /* ch2 at twice the rate, ch1 misses buffer of 133 */
+    Test_push(0, 100); Test_push(1, 103); Test_push(2, 100);
+    Test_push(2, 117);
+    Test_push(0, 133);                    Test_push(2, 133);
+    Test_push(2, 150);
+    Test_push(0, 166); Test_push(1, 169); Test_push(2, 167);
+    Test_newData();
+
+    Test_checkSets(name, expSet, UTILS_ARRAYSIZE(expSet), 3);
+    Test_check(Test_getBufState(2, 117)==TEST_BUF_DROPPED
+                && Test_getBufState(2, 150)==TEST_BUF_DROPPED,
+               "buffers farther from master dropped", name);
+    Test_check(Test_getBufState(0, 133)==TEST_BUF_DROPPED
+                && Test_getBufState(2, 133)==TEST_BUF_DROPPED,
+               "master without match dropped", name);
+    Test_checkReturned(name, 0);
+
+    Test_delete();
+}
+
+static void Test_latestCompleteSet(void)
+{
+    const char *name = "LATEST_COMPLETE_SET";
+    static const Test_Set expSet[] = {
+        { { 166, 167 } },
+    };
+    SyncLink_CreateParams prm;
+
+    Test_create(Test_initPrm(&prm, SYNC_LINK_POLICY_LATEST_COMPLETE_SET, 2), 2);
+
+    Test_setTimeMs(300);
+
+    /* backlog in one go, only the latest set is sent */
+    Test_push(0, 100); Test_push(0, 133); Test_push(0, 166); Test_push(0, 200);
+    Test_push(1, 101); Test_push(1, 134); Test_push(1, 167);
+    Test_newData();
+
+    Test_checkSets(name, expSet, UTILS_ARRAYSIZE(expSet), 2);
+    Test_check(Test_getBufState(0, 100)==TEST_BUF_DROPPED
+                && Test_getBufState(0, 133)==TEST_BUF_DROPPED
+                && Test_getBufState(1, 101)==TEST_BUF_DROPPED
+                && Test_getBufState(1, 134)==TEST_BUF_DROPPED,
+               "older buffers dropped", name);
+    Test_check(Test_getBufState(0, 200)==TEST_BUF_IN_LINK,
+               "newer buffer kept", name);
+    Test_checkReturned(name, 1);
+
+    Test_delete();
+}
+
+static void Test_partialSet(void)
+{
+    const char *name = "PARTIAL_SET";
+    static const Test_Set expSet[] = {
+        { { 100, TEST_NO_BUF } },
+        { { TEST_NO_BUF, 200 } },
+        { { 300, 301 } },
+    };
+    SyncLink_CreateParams prm;
+
+    Test_initPrm(&prm, SYNC_LINK_POLICY_PARTIAL_SET, 2);
+    prm.partialSetTimeout = 50;
+    Test_create(&prm, 2);
+
+    /* ch1 missing, set is sent once master buffer waited for timeout */
+    Test_setTimeMs(100);
+    Test_push(0, 100);
+    Test_newData();
+    Test_tick(140);
+    Test_check(gNumSets==0, "set sent before timeout", name);
+    Test_tick(150);
+
+    /* master missing, other channel is the reference */
+    Test_setTimeMs(200);
+    Test_push(1, 200);
+    Test_newData();
+    Test_tick(249);
+    Test_tick(250);
+
+    /* complete set is sent at once */
+    Test_setTimeMs(300);
+    Test_push(0, 300); Test_push(1, 301);
+    Test_newData();
+
+    Test_checkSets(name, expSet, UTILS_ARRAYSIZE(expSet), 2);
+    Test_check(Test_getObj()->stats.partialSetCount==2, "partial set count",
+               name);
+    Test_checkReturned(name, 0);
+
+    Test_delete();
+}
+
+/*
+ * Aging and drop routing
+ */
+
+static void Test_aging(void)
+{
+    const char *name = "TIMER_TICK aging";
+    SyncLink_CreateParams prm;
+    SyncLink_Obj *pObj;
+
+    Test_initPrm(&prm, SYNC_LINK_POLICY_NEAREST_TO_MASTER, 2);
+    prm.chParams.syncThreshold = 50;
+    Test_create(&prm, 2);
+    pObj = Test_getObj();
+
+    Test_setTimeMs(100);
+    Test_push(0, 100);
+    Test_push(0, 120);
+    Test_newData();
+
+    Test_tick(150);
+    Test_check(gDropCount==0, "dropped before threshold", name);
+
+    Test_tick(151);
+    Test_check(Test_getBufState(0, 100)==TEST_BUF_DROPPED
+                && Test_getBufState(0, 120)==TEST_BUF_IN_LINK,
+               "aged buffer dropped", name);
+    Test_check(pObj->stats.dropStats[0].masterTimestamp
+                    ==SYNC_LINK_INVALID_TIMESTAMP
+                && pObj->stats.dropStats[0].bufferTimestamp==100,
+               "aged drop statistics", name);
+
+    Test_tick(171);
+    Test_check(Test_getBufState(0, 120)==TEST_BUF_DROPPED, "second aged drop",
+               name);
+    Test_check(gNumSets==0, "set sent", name);
+    Test_checkReturned(name, 0);
+
+    Test_delete();
+}
+
+static void Test_dropRouting(void)
+{
+    const char *name = "drop routing";
+    SyncLink_CreateParams prm;
+    SyncLink_Obj *pObj;
+    UInt32 chId, frameId, numQueued;
+
+    /*
+     * 8 channels, ch7 not synced, ch6 never sends so that no set is made.
+     * ch0 to ch5 fill their queues, ch0 overflows.
+     */
+    Test_initPrm(&prm, SYNC_LINK_POLICY_NEAREST_TO_MASTER,
+                 SYNC_LINK_MAX_CHANNELS);
+    prm.queDepth = SYNC_LINK_LOCAL_QUE_MAX_DEPTH;
+    prm.chParams.syncThreshold = 2000;
+    prm.chParams.channelSyncList[SYNC_LINK_MAX_CHANNELS-1] = FALSE;
+    Test_create(&prm, SYNC_LINK_MAX_CHANNELS);
+    pObj = Test_getObj();
+
+    Test_setTimeMs(2000);
+    for(frameId=0; frameId<SYNC_LINK_LOCAL_QUE_MAX_DEPTH + 8; frameId++)
+    {
+        for(chId=0; chId<SYNC_LINK_MAX_CHANNELS; chId++)
+        {
+            if(chId==6 || (chId!=0 && frameId>=SYNC_LINK_LOCAL_QUE_MAX_DEPTH))
+                continue;
+            Test_push(chId, 1000 + frameId*33);
+        }
+    }
+    Test_newData();
+
+    /* buffers of ch1 to ch5 older than the master window are dropped too */
+    numQueued = 0;
+    for(chId=0; chId<SYNC_LINK_MAX_CHANNELS; chId++)
+    {
+        numQueued += pObj->chObj[chId].queCount;
+    }
+
+    Test_check(pObj->chObj[0].dropCountQueFull==8, "queue full drops", name);
+    Test_check(numQueued > SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST, "buffers queued",
+               name);
+    Test_check(gLinkStats.linkStats.chStats[7].inBufDropCount
+                    ==SYNC_LINK_LOCAL_QUE_MAX_DEPTH,
+               "inactive channel drops", name);
+    Test_check(gNumSets==0, "set sent", name);
+    Test_checkReturned(name, numQueued);
+
+    /* all queued buffers age in one tick, more than a buffer list */
+    gMaxPutEmptyBufs = 0;
+    Test_tick(1000 + (SYNC_LINK_LOCAL_QUE_MAX_DEPTH + 8)*33 + 2000);
+
+    for(chId=0; chId<6; chId++)
+    {
+        Test_check(pObj->chObj[chId].queCount==0, "queue not empty", name);
+    }
+    Test_check(gMaxPutEmptyBufs <= SYSTEM_MAX_BUFFERS_IN_BUFFER_LIST
+                && gMaxPutEmptyBufs > 0,
+               "buffer list overflow", name);
+    Test_checkReturned(name, 0);
+
+    Test_delete();
+}
+
+static void Test_autoMaster(void)
+{
+    const char *name = "auto master";
+    SyncLink_CreateParams prm;
+    SyncLink_Obj *pObj;
+    UInt32 frameId;
+
+    /* ch1 at half the rate of ch0 becomes master */
+    Test_initPrm(&prm, SYNC_LINK_POLICY_NEAREST_TO_MASTER, 2);
+    prm.masterCh = SYNC_LINK_MASTER_CH_AUTO;
+    prm.chParams.syncDelta = 20;
+    Test_create(&prm, 2);
+    pObj = Test_getObj();
+
+    Test_setTimeMs(10000);
+    for(frameId=0; frameId<60; frameId++)
+    {
+        Test_push(0, 1000 + frameId*33);
+        if(frameId & 1)
+            Test_push(1, 1000 + frameId*33);
+        Test_newData();
+    }
+    Test_check(pObj->masterCh==1, "slower channel not master", name);
+
+    Test_sendCmd(SYSTEM_CMD_PRINT_STATISTICS, NULL);
+    Test_check(pObj->chObj[0].recvCount==0 && pObj->chObj[1].recvCount==0,
+               "statistics not reset", name);
+
+    /* late burst of ch1, still fewer buffers than ch0 since create */
+    for(frameId=60; frameId<66; frameId++)
+    {
+        Test_push(1, 1000 + frameId*33);
+    }
+    Test_newData();
+    Test_push(0, 1000 + 60*33);
+    Test_newData();
+
+    Test_check(pObj->masterCh==1, "master changed by statistics print", name);
+
+    Test_delete();
+}
+
+int main(int argc, char *argv[])
+{
+    SyncLink_init();
+
+    Test_headAverage();
+    Test_nearestToMaster();
+    Test_latestCompleteSet();
+    Test_partialSet();
+    Test_aging();
+    Test_dropRouting();
+    Test_autoMaster();
+
+    SyncLink_deInit();
+
+    printf(" sync_link_test: %s (%u errors)\n",
+           gErrorCount ? "FAILED" : "PASSED", gErrorCount);
+
+    return gErrorCount ? 1 : 0;
+}
@@ -0,0 +1,590 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host test of src/utils_common/src/utils_dma_tile.c
+ *
+ * Built with UTILS_DMA_TILE_HOST_EMULATION, every step is done with the
+ * CPU model of the transfer list when it is submitted. A kernel with two
+ * input streams and one output stream, out = in0 - in1, is run over regions
+ * of every supported data format, with region sizes which are and which
+ * are not a multiple of the tile size.
+ *
+ * For every tile returned the test checks
+ *  - tiles come in raster order with the expected position and size,
+ *    including the narrower and shorter tiles of last column and row
+ *  - tile buffers are used as ping and pong, tile 'n' in buffer 'n%2'
+ *  - input of tile 'n' and, being emulated, of tile 'n+1' is in the buffers
+ *  - output of tiles before 'n', being emulated including 'n-1', is in the
+ *    frame, and nothing from tile 'n' onwards has been written yet
+ * Once Utils_dmaTileNext() returns FALSE, the output frame must match a
+ * reference, bytes around the region must not be touched. A second frame
+ * is then run on the same object after Utils_dmaTileSetFrame(). Invalid
+ * parameters must fail.
+ */
+
+#include "utils_host_test.h"
+#include <src/utils_common/include/utils_dma_tile.h>
+
+#define TEST_FRAME_W        (160U)
+#define TEST_FRAME_H        (96U)
+#define TEST_FRAME_PITCH    (TEST_FRAME_W*3U + 16U)
+#define TEST_FRAME_SIZE     (TEST_FRAME_PITCH*TEST_FRAME_H)
+#define TEST_TILE_PAD       (8U)
+#define TEST_TILE_BUF_SIZE  (2048U*3U)
+#define TEST_FILL_BYTE      (0xA5U)
+
+#define TEST_IN0            (0U)
+#define TEST_IN1            (1U)
+#define TEST_OUT            (2U)
+#define TEST_NUM_STREAMS    (3U)
+
+typedef struct {
+
+    UInt32 dataFormat;
+    UInt32 width;
+    UInt32 height;
+    UInt32 tileWidth;
+    UInt32 tileHeight;
+
+} Test_Case;
+
+/* all planes of a frame */
+typedef UInt8 Test_Frame[UTILS_DMA_MAX_PLANES][TEST_FRAME_SIZE];
+
+static const Test_Case gTestCase[] = {
+    /* region multiple of tile size */
+    { SYSTEM_DF_RAW08,       64, 32, 16,  8 },
+    { SYSTEM_DF_YUV420SP_UV, 64, 32, 32, 16 },
+    /* last column and last row are partial */
+    { SYSTEM_DF_RAW08,      100, 37, 32, 16 },
+    { SYSTEM_DF_RAW16,       70, 20, 64,  8 },
+    { SYSTEM_DF_RAW24,       33,  9,  8,  4 },
+    { SYSTEM_DF_YUV420SP_UV, 90, 46, 32, 16 },
+    /* single tile larger than region */
+    { SYSTEM_DF_YUV420SP_UV, 40,  6, 64, 16 },
+    /* one pixel tiles */
+    { SYSTEM_DF_RAW16,        5,  3,  1,  1 },
+};
+
+static Test_Frame gFrame[TEST_NUM_STREAMS];
+static Test_Frame gFrame2[TEST_NUM_STREAMS];
+static Test_Frame gRef;
+static UInt8 gTileBuf[TEST_NUM_STREAMS][UTILS_DMA_TILE_NUM_BUF]
+                     [UTILS_DMA_MAX_PLANES][TEST_TILE_BUF_SIZE];
+
+static UInt32 gErrorCount;
+
+static UInt32 Test_getBpp(UInt32 dataFormat)
+{
+    if(dataFormat==SYSTEM_DF_RAW24)
+        return 3;
+    if(dataFormat==SYSTEM_DF_RAW16)
+        return 2;
+    return 1;
+}
+
+static UInt32 Test_getNumPlanes(UInt32 dataFormat)
+{
+    return (dataFormat==SYSTEM_DF_YUV420SP_UV) ? 2 : 1;
+}
+
+static void Test_check(Bool cond, const char *msg, UInt32 caseId,
+                       UInt32 tileId)
+{
+    if(!cond)
+    {
+        if(gErrorCount < 10)
+        {
+            printf(" ERROR: %s (case %u, tile %u)\n", msg, caseId, tileId);
+        }
+        gErrorCount++;
+    }
+}
+
+/* chroma of YUV420SP is at half height, same width in bytes */
+static UInt32 Test_planeLines(UInt32 plane, UInt32 lines)
+{
+    return (plane==1) ? lines/2 : lines;
+}
+
+static UInt8 *Test_framePtr(UInt8 *pFrame, const Utils_DmaTileStreamPrm *pStream,
+                            UInt32 plane, UInt32 x, UInt32 y)
+{
+    UInt32 bpp = Test_getBpp(pStream->dataFormat);
+
+    return pFrame
+         + pStream->framePitch[plane]
+                *Test_planeLines(plane, pStream->frameStartY + y)
+         + (pStream->frameStartX + x)*bpp;
+}
+
+/* compare tile buffer against the frame window of a tile */
+static Bool Test_isTileEqual(const Utils_DmaTileStreamPrm *pStream,
+                             Test_Frame pFrame,
+                             UInt8 *pBuf[UTILS_DMA_MAX_PLANES],
+                             UInt32 startX, UInt32 startY,
+                             UInt32 width, UInt32 height)
+{
+    UInt32 bpp = Test_getBpp(pStream->dataFormat);
+    UInt32 plane, y;
+
+    for(plane=0; plane<Test_getNumPlanes(pStream->dataFormat); plane++)
+    {
+        for(y=0; y<Test_planeLines(plane, height); y++)
+        {
+            if(memcmp(pBuf[plane] + y*pStream->tileBufPitch[plane],
+                      Test_framePtr(pFrame[plane], pStream, plane,
+                                    startX, startY)
+                        + y*pStream->framePitch[plane],
+                      width*bpp) != 0)
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* compare output window of a tile against the reference frame */
+static Bool Test_isTileDone(const Utils_DmaTileStreamPrm *pStream,
+                            Test_Frame pFrame,
+                            UInt32 startX, UInt32 startY,
+                            UInt32 width, UInt32 height)
+{
+    UInt32 bpp = Test_getBpp(pStream->dataFormat);
+    UInt32 plane, y, offset;
+
+    for(plane=0; plane<Test_getNumPlanes(pStream->dataFormat); plane++)
+    {
+        for(y=0; y<Test_planeLines(plane, height); y++)
+        {
+            offset = Test_framePtr(pFrame[plane], pStream, plane,
+                                   startX, startY)
+                   - pFrame[plane]
+                   + y*pStream->framePitch[plane];
+
+            if(memcmp(pFrame[plane] + offset, gRef[plane] + offset,
+                      width*bpp) != 0)
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* TRUE if output window of a tile is still TEST_FILL_BYTE */
+static Bool Test_isTileUnwritten(const Utils_DmaTileStreamPrm *pStream,
+                                 Test_Frame pFrame,
+                                 UInt32 startX, UInt32 startY,
+                                 UInt32 width, UInt32 height)
+{
+    UInt32 bpp = Test_getBpp(pStream->dataFormat);
+    UInt32 plane, x, y;
+    UInt8 *pLine;
+
+    for(plane=0; plane<Test_getNumPlanes(pStream->dataFormat); plane++)
+    {
+        for(y=0; y<Test_planeLines(plane, height); y++)
+        {
+            pLine = Test_framePtr(pFrame[plane], pStream, plane, startX, startY)
+                  + y*pStream->framePitch[plane];
+
+            for(x=0; x<width*bpp; x++)
+            {
+                if(pLine[x] != TEST_FILL_BYTE)
+                    return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* expected position and size of a tile */
+static void Test_getTile(const Test_Case *pCase, UInt32 tileId,
+                         Utils_DmaTileInfo *pTile)
+{
+    UInt32 numTilesX = (pCase->width + pCase->tileWidth - 1)/pCase->tileWidth;
+
+    pTile->tileId = tileId;
+    pTile->startX = (tileId%numTilesX)*pCase->tileWidth;
+    pTile->startY = (tileId/numTilesX)*pCase->tileHeight;
+    pTile->width  = pCase->width - pTile->startX;
+    if(pTile->width > pCase->tileWidth)
+        pTile->width = pCase->tileWidth;
+    pTile->height = pCase->height - pTile->startY;
+    if(pTile->height > pCase->tileHeight)
+        pTile->height = pCase->tileHeight;
+}
+
+/* out = in0 - in1, on tile buffers */
+static void Test_kernel(const Utils_DmaTilePrm *pPrm,
+                        const Utils_DmaTileInfo *pTile)
+{
+    const Utils_DmaTileStreamPrm *pIn0 = &pPrm->stream[TEST_IN0];
+    const Utils_DmaTileStreamPrm *pIn1 = &pPrm->stream[TEST_IN1];
+    const Utils_DmaTileStreamPrm *pOut = &pPrm->stream[TEST_OUT];
+    UInt32 bpp = Test_getBpp(pOut->dataFormat);
+    UInt32 plane, x, y;
+    const UInt8 *pA, *pB;
+    UInt8 *pC;
+
+    for(plane=0; plane<Test_getNumPlanes(pOut->dataFormat); plane++)
+    {
+        for(y=0; y<Test_planeLines(plane, pTile->height); y++)
+        {
+            pA = (UInt8*)pTile->bufAddr[TEST_IN0][plane]
+                        + y*pIn0->tileBufPitch[plane];
+            pB = (UInt8*)pTile->bufAddr[TEST_IN1][plane]
+                        + y*pIn1->tileBufPitch[plane];
+            pC = (UInt8*)pTile->bufAddr[TEST_OUT][plane]
+                        + y*pOut->tileBufPitch[plane];
+
+            for(x=0; x<pTile->width*bpp; x++)
+            {
+                pC[x] = (UInt8)(pA[x] - pB[x]);
+            }
+        }
+    }
+}
+
+/* reference output frame, TEST_FILL_BYTE outside of region */
+static void Test_makeRef(const Utils_DmaTilePrm *pPrm,
+                         Test_Frame *pIn)
+{
+    const Utils_DmaTileStreamPrm *pOut = &pPrm->stream[TEST_OUT];
+    UInt32 bpp = Test_getBpp(pOut->dataFormat);
+    UInt32 plane, x, y;
+    UInt8 *pA, *pB, *pC;
+
+    for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+    {
+        memset(gRef[plane], TEST_FILL_BYTE, TEST_FRAME_SIZE);
+    }
+
+    for(plane=0; plane<Test_getNumPlanes(pOut->dataFormat); plane++)
+    {
+        for(y=0; y<Test_planeLines(plane, pPrm->height); y++)
+        {
+            pA = Test_framePtr(pIn[TEST_IN0][plane], &pPrm->stream[TEST_IN0],
+                               plane, 0, 0)
+               + y*pPrm->stream[TEST_IN0].framePitch[plane];
+            pB = Test_framePtr(pIn[TEST_IN1][plane], &pPrm->stream[TEST_IN1],
+                               plane, 0, 0)
+               + y*pPrm->stream[TEST_IN1].framePitch[plane];
+            pC = Test_framePtr(gRef[plane], pOut, plane, 0, 0)
+               + y*pOut->framePitch[plane];
+
+            for(x=0; x<pPrm->width*bpp; x++)
+            {
+                pC[x] = (UInt8)(pA[x] - pB[x]);
+            }
+        }
+    }
+}
+
+static void Test_setupPrm(Utils_DmaTilePrm *pPrm, const Test_Case *pCase)
+{
+    Utils_DmaTileStreamPrm *pStream;
+    UInt32 streamId, bufId, plane, bpp;
+
+    memset(pPrm, 0, sizeof(*pPrm));
+
+    bpp = Test_getBpp(pCase->dataFormat);
+
+    pPrm->hDmaCh     = NULL;
+    pPrm->width      = pCase->width;
+    pPrm->height     = pCase->height;
+    pPrm->tileWidth  = pCase->tileWidth;
+    pPrm->tileHeight = pCase->tileHeight;
+    pPrm->numStreams = TEST_NUM_STREAMS;
+
+    for(streamId=0; streamId<TEST_NUM_STREAMS; streamId++)
+    {
+        pStream = &pPrm->stream[streamId];
+
+        pStream->dir = (streamId==TEST_OUT) ? UTILS_DMA_TILE_DIR_OUT
+                                            : UTILS_DMA_TILE_DIR_IN;
+        pStream->dataFormat = pCase->dataFormat;
+
+        /* every stream at a different place in its frame, even for 420SP */
+        pStream->frameStartX = (TEST_FRAME_W - pCase->width)*streamId/4;
+        pStream->frameStartY = ((TEST_FRAME_H - pCase->height)*streamId/4)
+                                    & ~1U;
+
+        for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+        {
+            pStream->frameAddr[plane]    = gFrame[streamId][plane];
+            pStream->framePitch[plane]   = TEST_FRAME_PITCH - streamId*4U;
+            pStream->tileBufPitch[plane] = pCase->tileWidth*bpp
+                                         + TEST_TILE_PAD*streamId;
+            UTILS_assert(pStream->tileBufPitch[plane]*pCase->tileHeight
+                            <= TEST_TILE_BUF_SIZE);
+
+            for(bufId=0; bufId<UTILS_DMA_TILE_NUM_BUF; bufId++)
+            {
+                pStream->tileBufAddr[bufId][plane]
+                    = gTileBuf[streamId][bufId][plane];
+            }
+        }
+    }
+}
+
+static void Test_initFrames(Test_Frame *pFrame)
+{
+    UInt32 streamId, plane, i;
+
+    for(streamId=0; streamId<TEST_NUM_STREAMS; streamId++)
+    {
+        for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+        {
+            if(streamId==TEST_OUT)
+            {
+                memset(pFrame[streamId][plane], TEST_FILL_BYTE,
+                       TEST_FRAME_SIZE);
+            }
+            else
+            {
+                for(i=0; i<TEST_FRAME_SIZE; i++)
+                {
+                    pFrame[streamId][plane][i] = (UInt8)rand();
+                }
+            }
+        }
+    }
+}
+
+/* run all tiles of one frame and check every step */
+static void Test_runFrame(Utils_DmaTileObj *pObj, UInt32 caseId,
+                          Test_Frame *pFrame)
+{
+    const Test_Case *pCase = &gTestCase[caseId];
+    const Utils_DmaTilePrm *pPrm = &pObj->prm;
+    Utils_DmaTileInfo tile, expTile;
+    UInt8 *pBuf[UTILS_DMA_MAX_PLANES];
+    UInt32 numTiles, tileId, prevId, streamId, plane, bufId;
+    Int32 status;
+
+    numTiles = ((pCase->width + pCase->tileWidth - 1)/pCase->tileWidth)
+             * ((pCase->height + pCase->tileHeight - 1)/pCase->tileHeight);
+
+    Test_makeRef(pPrm, pFrame);
+
+    status = Utils_dmaTileStart(pObj);
+    Test_check(status==SYSTEM_LINK_STATUS_SOK, "start", caseId, 0);
+
+    tileId = 0;
+    while(Utils_dmaTileNext(pObj, &tile))
+    {
+        Test_getTile(pCase, tileId, &expTile);
+
+        Test_check(tile.tileId==tileId, "raster order", caseId, tileId);
+        Test_check(tile.startX==expTile.startX && tile.startY==expTile.startY,
+                   "tile position", caseId, tileId);
+        Test_check(tile.width==expTile.width && tile.height==expTile.height,
+                   "tile size", caseId, tileId);
+
+        bufId = tileId % UTILS_DMA_TILE_NUM_BUF;
+
+        for(streamId=0; streamId<UTILS_DMA_TILE_MAX_STREAMS; streamId++)
+        {
+            for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+            {
+                Test_check(tile.bufAddr[streamId][plane]
+                            == ((streamId<TEST_NUM_STREAMS)
+                                ? (Ptr)gTileBuf[streamId][bufId][plane]
+                                : NULL),
+                           "ping-pong buffer", caseId, tileId);
+            }
+        }
+
+        for(streamId=TEST_IN0; streamId<=TEST_IN1; streamId++)
+        {
+            for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+            {
+                pBuf[plane] = gTileBuf[streamId][bufId][plane];
+            }
+            Test_check(Test_isTileEqual(&pPrm->stream[streamId],
+                                        pFrame[streamId], pBuf,
+                                        tile.startX, tile.startY,
+                                        tile.width, tile.height),
+                       "input of current tile", caseId, tileId);
+
+            /* CPU model completes input of next tile on submit */
+            if(tileId + 1 < numTiles)
+            {
+                Test_getTile(pCase, tileId + 1, &expTile);
+
+                for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+                {
+                    pBuf[plane] = gTileBuf[streamId][1U-bufId][plane];
+                }
+                Test_check(Test_isTileEqual(&pPrm->stream[streamId],
+                                            pFrame[streamId], pBuf,
+                                            expTile.startX, expTile.startY,
+                                            expTile.width, expTile.height),
+                           "input of next tile", caseId, tileId);
+            }
+        }
+
+        /* tiles before current are written, current one onwards are not */
+        for(prevId=0; prevId<numTiles; prevId++)
+        {
+            Test_getTile(pCase, prevId, &expTile);
+
+            if(prevId < tileId)
+            {
+                Test_check(Test_isTileDone(&pPrm->stream[TEST_OUT],
+                                           pFrame[TEST_OUT],
+                                           expTile.startX, expTile.startY,
+                                           expTile.width, expTile.height),
+                           "output of previous tile", caseId, tileId);
+            }
+            else
+            {
+                Test_check(Test_isTileUnwritten(&pPrm->stream[TEST_OUT],
+                                           pFrame[TEST_OUT],
+                                           expTile.startX, expTile.startY,
+                                           expTile.width, expTile.height),
+                           "output written too early", caseId, tileId);
+            }
+        }
+
+        Test_kernel(pPrm, &tile);
+
+        tileId++;
+    }
+
+    Test_check(pObj->status==SYSTEM_LINK_STATUS_SOK, "status", caseId, tileId);
+    Test_check(tileId==numTiles, "number of tiles", caseId, tileId);
+
+    for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+    {
+        Test_check(memcmp(pFrame[TEST_OUT][plane], gRef[plane],
+                          TEST_FRAME_SIZE)==0,
+                   "output frame", caseId, tileId);
+    }
+
+    /* nothing more after last tile */
+    Test_check(!Utils_dmaTileNext(pObj, &tile), "next after last tile",
+               caseId, tileId);
+}
+
+static void Test_tiles(void)
+{
+    Utils_DmaTileObj tileObj;
+    Utils_DmaTilePrm prm;
+    Ptr frameAddr[UTILS_DMA_MAX_PLANES];
+    UInt32 caseId, streamId, plane;
+    Int32 status;
+
+    for(caseId=0; caseId<UTILS_ARRAYSIZE(gTestCase); caseId++)
+    {
+        Test_setupPrm(&prm, &gTestCase[caseId]);
+
+        status = Utils_dmaTileInit(&tileObj, &prm);
+        Test_check(status==SYSTEM_LINK_STATUS_SOK, "init", caseId, 0);
+        if(status!=SYSTEM_LINK_STATUS_SOK)
+            continue;
+
+        memset(gTileBuf, 0, sizeof(gTileBuf));
+        Test_initFrames(gFrame);
+        Test_runFrame(&tileObj, caseId, gFrame);
+
+        /* next frame on same object, with other buffers */
+        for(streamId=0; streamId<TEST_NUM_STREAMS; streamId++)
+        {
+            for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+            {
+                frameAddr[plane] = gFrame2[streamId][plane];
+            }
+            status = Utils_dmaTileSetFrame(&tileObj, streamId, frameAddr);
+            Test_check(status==SYSTEM_LINK_STATUS_SOK, "set frame", caseId, 0);
+        }
+
+        Test_initFrames(gFrame2);
+        Test_runFrame(&tileObj, caseId, gFrame2);
+    }
+}
+
+static void Test_invalid(void)
+{
+    Utils_DmaTileObj tileObj;
+    Utils_DmaTilePrm prm;
+    Utils_DmaTileInfo tile;
+    Ptr frameAddr[UTILS_DMA_MAX_PLANES] = { NULL, NULL };
+    Int32 status;
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status==SYSTEM_LINK_STATUS_SOK, "init", 0, 0);
+    Test_check(!Utils_dmaTileNext(&tileObj, &tile), "next before start",
+               0, 0);
+
+    status = Utils_dmaTileSetFrame(&tileObj, TEST_NUM_STREAMS, frameAddr);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "set frame of bad stream",
+               0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    prm.numStreams = 0;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with 0 streams", 0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    prm.numStreams = UTILS_DMA_TILE_MAX_STREAMS + 1;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with too many streams",
+               0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    prm.tileWidth = 0;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with tile width 0", 0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    prm.stream[TEST_IN1].tileBufAddr[1][0] = NULL;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with NULL pong buffer",
+               0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[0]);
+    prm.stream[TEST_OUT].tileBufPitch[0] = prm.tileWidth - 1;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with short tile pitch",
+               0, 0);
+
+    Test_setupPrm(&prm, &gTestCase[1]);
+    prm.tileHeight = 15;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init 420SP with odd tile height",
+               1, 0);
+
+    Test_setupPrm(&prm, &gTestCase[1]);
+    prm.stream[TEST_IN0].frameStartY = 1;
+    status = Utils_dmaTileInit(&tileObj, &prm);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init 420SP with odd start line",
+               1, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    srand(1);
+
+    Test_tiles();
+    Test_invalid();
+
+    printf(" utils_dma_tile_test: %s (%u errors)\n",
+           gErrorCount ? "FAILED" : "PASSED", gErrorCount);
+
+    return gErrorCount ? 1 : 0;
+}
@@ -0,0 +1,381 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host test of src/utils_common/src/utils_dma_txlist.c
+ *
+ * Transfer lists for 2D copy and fill of every supported data format are
+ * built with Utils_dmaTxListAdd2D() and run with the CPU model,
+ * Utils_dmaTxListCpuRun(). Destination is compared against a reference
+ * line by line copy, including the bytes around the window which must not
+ * be touched. Invalid parameters and a full list must fail and leave the
+ * list unchanged. With --bench, descriptor generation plus CPU model is
+ * timed against the reference copy for a 1080p mosaic like workload.
+ */
+
+#include "utils_host_test.h"
+#include <src/utils_common/include/utils_dma_txlist.h>
+
+#define TEST_MAX_W          (512U)
+#define TEST_MAX_H          (128U)
+#define TEST_MAX_PITCH      (TEST_MAX_W*3U + 64U)
+#define TEST_BUF_SIZE       (TEST_MAX_PITCH*TEST_MAX_H)
+#define TEST_ITERATIONS     (2000U)
+
+#define BENCH_WIDTH         (1920U)
+#define BENCH_HEIGHT        (1080U)
+#define BENCH_WIN_X         (4U)
+#define BENCH_WIN_Y         (4U)
+#define BENCH_ITERATIONS    (50U)
+
+static UInt8 gSrc[UTILS_DMA_MAX_PLANES][TEST_BUF_SIZE];
+static UInt8 gDst[UTILS_DMA_MAX_PLANES][TEST_BUF_SIZE];
+static UInt8 gRef[UTILS_DMA_MAX_PLANES][TEST_BUF_SIZE];
+
+static UInt32 gErrorCount;
+
+static UInt32 Test_getBpp(UInt32 dataFormat)
+{
+    if(dataFormat==SYSTEM_DF_RAW24)
+        return 3;
+    if(dataFormat==SYSTEM_DF_RAW16)
+        return 2;
+    return 1;
+}
+
+/* reference 2D copy/fill of one plane, one line at a time */
+static void Test_refCopyPlane(const Utils_DmaCopyFill2D *pInfo, UInt32 plane,
+                              UInt32 bpp, UInt32 startYDiv, UInt32 heightDiv,
+                              Bool fillData, UInt8 *pDst)
+{
+    UInt32 y;
+    UInt8 *pD;
+    const UInt8 *pS;
+
+    for(y=0; y<pInfo->height/heightDiv; y++)
+    {
+        pD = pDst
+           + pInfo->destPitch[plane]*(pInfo->destStartY/startYDiv + y)
+           + pInfo->destStartX*bpp;
+
+        if(fillData)
+        {
+            pS = (const UInt8*)pInfo->srcAddr[plane];
+        }
+        else
+        {
+            pS = (const UInt8*)pInfo->srcAddr[plane]
+               + pInfo->srcPitch[plane]*(pInfo->srcStartY/startYDiv + y)
+               + pInfo->srcStartX*bpp;
+        }
+
+        memcpy(pD, pS, pInfo->width*bpp);
+    }
+}
+
+static void Test_refCopyFill2D(const Utils_DmaCopyFill2D *pInfo,
+                               Bool fillData)
+{
+    UInt32 bpp = Test_getBpp(pInfo->dataFormat);
+
+    Test_refCopyPlane(pInfo, 0, bpp, 1, 1, fillData, gRef[0]);
+
+    if(pInfo->dataFormat==SYSTEM_DF_YUV420SP_UV)
+    {
+        Test_refCopyPlane(pInfo, 1, 1, 2, 2, fillData, gRef[1]);
+    }
+}
+
+static void Test_check(Bool cond, const char *msg, UInt32 iter)
+{
+    if(!cond)
+    {
+        if(gErrorCount < 10)
+        {
+            printf(" ERROR: %s (iteration %u)\n", msg, iter);
+        }
+        gErrorCount++;
+    }
+}
+
+/* random window that fits in TEST_MAX_W x TEST_MAX_H, even for YUV420SP */
+static void Test_randomPrm(Utils_DmaCopyFill2D *pInfo, UInt32 dataFormat)
+{
+    UInt32 bpp = Test_getBpp(dataFormat);
+    UInt32 align = (dataFormat==SYSTEM_DF_YUV420SP_UV) ? 2 : 1;
+    UInt32 plane;
+
+    memset(pInfo, 0, sizeof(*pInfo));
+
+    pInfo->dataFormat = dataFormat;
+    pInfo->width      = (1 + rand()%(TEST_MAX_W/2)) * align;
+    pInfo->height     = (1 + rand()%(TEST_MAX_H/4)) * align;
+    pInfo->destStartX = (rand()%(TEST_MAX_W - pInfo->width + 1)) & ~(align-1);
+    pInfo->destStartY = (rand()%(TEST_MAX_H - pInfo->height + 1)) & ~(align-1);
+    pInfo->srcStartX  = (rand()%(TEST_MAX_W - pInfo->width + 1)) & ~(align-1);
+    pInfo->srcStartY  = (rand()%(TEST_MAX_H - pInfo->height + 1)) & ~(align-1);
+
+    for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+    {
+        pInfo->destAddr[plane]  = gDst[plane];
+        pInfo->srcAddr[plane]   = gSrc[plane];
+        pInfo->destPitch[plane] = TEST_MAX_W*bpp
+                                + rand()%(TEST_MAX_PITCH - TEST_MAX_W*bpp + 1);
+        pInfo->srcPitch[plane]  = TEST_MAX_W*bpp
+                                + rand()%(TEST_MAX_PITCH - TEST_MAX_W*bpp + 1);
+    }
+}
+
+static void Test_copyFill(void)
+{
+    static const UInt32 dataFormat[] = {
+        SYSTEM_DF_RAW08, SYSTEM_DF_RAW16, SYSTEM_DF_RAW24,
+        SYSTEM_DF_YUV420SP_UV
+    };
+    Utils_DmaTxDesc txDesc[4*UTILS_DMA_TXLIST_DESC_PER_2D];
+    Utils_DmaTxList txList;
+    Utils_DmaCopyFill2D prm[4];
+    UInt32 iter, i, numTx, plane, bytes;
+    Bool fillData;
+    Int32 status;
+
+    for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+    {
+        for(i=0; i<TEST_BUF_SIZE; i++)
+        {
+            gSrc[plane][i] = (UInt8)rand();
+        }
+    }
+
+    for(iter=0; iter<TEST_ITERATIONS; iter++)
+    {
+        for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+        {
+            memset(gDst[plane], (UInt8)(iter*37U + plane + 1U), TEST_BUF_SIZE);
+            memcpy(gRef[plane], gDst[plane], TEST_BUF_SIZE);
+        }
+
+        fillData = (iter & 1) ? TRUE : FALSE;
+        numTx    = 1 + rand()%4;
+        bytes    = 0;
+
+        status = Utils_dmaTxListInit(&txList, txDesc,
+                                     UTILS_ARRAYSIZE(txDesc));
+        Test_check(status==SYSTEM_LINK_STATUS_SOK, "list init", iter);
+
+        /* windows may overlap, later transfer wins, like on EDMA */
+        for(i=0; i<numTx; i++)
+        {
+            Test_randomPrm(&prm[i], dataFormat[rand()%4]);
+
+            status = Utils_dmaTxListAdd2D(&txList, &prm[i], fillData);
+            Test_check(status==SYSTEM_LINK_STATUS_SOK, "add 2D", iter);
+
+            Test_refCopyFill2D(&prm[i], fillData);
+
+            bytes += prm[i].width*prm[i].height
+                            *Test_getBpp(prm[i].dataFormat);
+            if(prm[i].dataFormat==SYSTEM_DF_YUV420SP_UV)
+                bytes += prm[i].width*(prm[i].height/2);
+        }
+
+        Test_check(Utils_dmaTxListGetBytes(&txList)==bytes,
+                   "bytes in list", iter);
+
+        status = Utils_dmaTxListCpuRun(&txList);
+        Test_check(status==SYSTEM_LINK_STATUS_SOK, "CPU run", iter);
+
+        for(plane=0; plane<UTILS_DMA_MAX_PLANES; plane++)
+        {
+            Test_check(memcmp(gDst[plane], gRef[plane], TEST_BUF_SIZE)==0,
+                       fillData ? "fill result" : "copy result", iter);
+        }
+    }
+}
+
+static void Test_invalid(void)
+{
+    Utils_DmaTxDesc txDesc[UTILS_DMA_TXLIST_DESC_PER_2D];
+    Utils_DmaTxList txList;
+    Utils_DmaCopyFill2D prm;
+    Int32 status;
+
+    status = Utils_dmaTxListInit(&txList, NULL, 1);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with NULL desc", 0);
+
+    status = Utils_dmaTxListInit(&txList, txDesc, 0);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "init with 0 desc", 0);
+
+    Utils_dmaTxListInit(&txList, txDesc, UTILS_DMA_TXLIST_DESC_PER_2D);
+
+    Test_randomPrm(&prm, SYSTEM_DF_RAW08);
+    prm.width = 0;
+    status = Utils_dmaTxListAdd2D(&txList, &prm, FALSE);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "add with width 0", 0);
+
+    Test_randomPrm(&prm, SYSTEM_DF_RAW16);
+    prm.width = 0x10000U;
+    status = Utils_dmaTxListAdd2D(&txList, &prm, FALSE);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "add with ACNT > 16-bit", 0);
+
+    Test_randomPrm(&prm, SYSTEM_DF_YUV420SP_UV);
+    prm.height = 1;
+    status = Utils_dmaTxListAdd2D(&txList, &prm, FALSE);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "add with 0 chroma lines", 0);
+
+    Test_randomPrm(&prm, SYSTEM_DF_RAW08);
+    prm.srcAddr[0] = NULL;
+    status = Utils_dmaTxListAdd2D(&txList, &prm, TRUE);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "add with NULL src", 0);
+
+    Test_check(txList.numDesc==0, "list changed by failed add", 0);
+
+    /* one descriptor left, YUV420SP needs two */
+    Test_randomPrm(&prm, SYSTEM_DF_RAW08);
+    status = Utils_dmaTxListAdd2D(&txList, &prm, FALSE);
+    Test_check(status==SYSTEM_LINK_STATUS_SOK, "add to empty list", 0);
+
+    Test_randomPrm(&prm, SYSTEM_DF_YUV420SP_UV);
+    status = Utils_dmaTxListAdd2D(&txList, &prm, FALSE);
+    Test_check(status!=SYSTEM_LINK_STATUS_SOK, "add to full list", 0);
+    Test_check(txList.numDesc==1, "list changed by add to full list", 0);
+}
+
+/*
+ * One YUV420SP 1080p output frame: blank fill of the full frame followed
+ * by a copy of a 2x2 mosaic of windows, as done by DMA SW mosaic
+ */
+static void Test_bench(void)
+{
+    Utils_DmaTxDesc txDesc[5*UTILS_DMA_TXLIST_DESC_PER_2D];
+    Utils_DmaTxList txList;
+    Utils_DmaCopyFill2D prm[5];
+    UInt8 *pSrc[2], *pDst[2], *pFill[2], *pRef[2];
+    UInt32 iter, i, plane, winW, winH;
+    UInt64 startUs, listUs, refUs, bytes;
+
+    winW = (BENCH_WIDTH/2 - 2*BENCH_WIN_X) & ~1U;
+    winH = (BENCH_HEIGHT/2 - 2*BENCH_WIN_Y) & ~1U;
+
+    for(plane=0; plane<2; plane++)
+    {
+        pSrc[plane]  = malloc(BENCH_WIDTH*BENCH_HEIGHT);
+        pDst[plane]  = malloc(BENCH_WIDTH*BENCH_HEIGHT);
+        pRef[plane]  = malloc(BENCH_WIDTH*BENCH_HEIGHT);
+        pFill[plane] = malloc(BENCH_WIDTH);
+        UTILS_assert(pSrc[plane]!=NULL && pDst[plane]!=NULL
+                     && pRef[plane]!=NULL && pFill[plane]!=NULL);
+        memset(pSrc[plane], 0x40, BENCH_WIDTH*BENCH_HEIGHT);
+        memset(pFill[plane], 0x80, BENCH_WIDTH);
+    }
+
+    for(i=0; i<5; i++)
+    {
+        memset(&prm[i], 0, sizeof(prm[i]));
+        prm[i].dataFormat = SYSTEM_DF_YUV420SP_UV;
+        for(plane=0; plane<2; plane++)
+        {
+            prm[i].destAddr[plane]  = pDst[plane];
+            prm[i].destPitch[plane] = BENCH_WIDTH;
+            prm[i].srcAddr[plane]   = (i==0) ? pFill[plane] : pSrc[plane];
+            prm[i].srcPitch[plane]  = BENCH_WIDTH;
+        }
+        if(i==0)
+        {
+            prm[i].width  = BENCH_WIDTH;
+            prm[i].height = BENCH_HEIGHT;
+        }
+        else
+        {
+            prm[i].width      = winW;
+            prm[i].height     = winH;
+            prm[i].destStartX = ((i-1)%2)*(BENCH_WIDTH/2) + BENCH_WIN_X;
+            prm[i].destStartY = ((i-1)/2)*(BENCH_HEIGHT/2) + BENCH_WIN_Y;
+        }
+    }
+
+    startUs = UtilsHostTest_getTimeInUsec();
+    for(iter=0; iter<BENCH_ITERATIONS; iter++)
+    {
+        Utils_dmaTxListInit(&txList, txDesc, UTILS_ARRAYSIZE(txDesc));
+        for(i=0; i<5; i++)
+        {
+            Utils_dmaTxListAdd2D(&txList, &prm[i], (i==0) ? TRUE : FALSE);
+        }
+        Utils_dmaTxListCpuRun(&txList);
+    }
+    listUs = UtilsHostTest_getTimeInUsec() - startUs;
+    bytes  = Utils_dmaTxListGetBytes(&txList);
+
+    startUs = UtilsHostTest_getTimeInUsec();
+    for(iter=0; iter<BENCH_ITERATIONS; iter++)
+    {
+        for(i=0; i<5; i++)
+        {
+            for(plane=0; plane<2; plane++)
+            {
+                UInt32 y, lines = (plane==0) ? prm[i].height : prm[i].height/2;
+                UInt32 startY = (plane==0) ? prm[i].destStartY
+                                           : prm[i].destStartY/2;
+
+                for(y=0; y<lines; y++)
+                {
+                    memcpy(pRef[plane] + (startY+y)*BENCH_WIDTH
+                                + prm[i].destStartX,
+                           (i==0) ? pFill[plane]
+                                  : pSrc[plane] + y*BENCH_WIDTH,
+                           prm[i].width);
+                }
+            }
+        }
+    }
+    refUs = UtilsHostTest_getTimeInUsec() - startUs;
+
+    for(plane=0; plane<2; plane++)
+    {
+        Test_check(memcmp(pDst[plane], pRef[plane],
+                          BENCH_WIDTH*BENCH_HEIGHT)==0,
+                   "benchmark result", 0);
+    }
+
+    printf(" BENCH: %ux%u YUV420SP fill + 4 window copy, %u frames\n",
+           BENCH_WIDTH, BENCH_HEIGHT, BENCH_ITERATIONS);
+    printf(" BENCH: Transfer list + CPU model : %8.1f us/frame, %7.1f MB/s\n",
+           (double)listUs/BENCH_ITERATIONS,
+           (double)bytes*BENCH_ITERATIONS/listUs);
+    printf(" BENCH: Reference line copy       : %8.1f us/frame, %7.1f MB/s\n",
+           (double)refUs/BENCH_ITERATIONS,
+           (double)bytes*BENCH_ITERATIONS/refUs);
+
+    for(plane=0; plane<2; plane++)
+    {
+        free(pSrc[plane]);
+        free(pDst[plane]);
+        free(pRef[plane]);
+        free(pFill[plane]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    srand(1);
+
+    Test_copyFill();
+    Test_invalid();
+
+    if(argc > 1 && strcmp(argv[1], "--bench")==0)
+    {
+        Test_bench();
+    }
+
+    printf(" utils_dma_txlist_test: %s (%u errors)\n",
+           gErrorCount ? "FAILED" : "PASSED", gErrorCount);
+
+    return gErrorCount ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * POSIX implementation of the BIOS and BSP OSAL APIs declared in
+ * inc/src/utils_common/include/utils.h
+ */
+
+#include <src/utils_common/include/utils.h>
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+
+struct UtilsHostOsal_Sem {
+
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    Int32           count;
+    Bool            isBinary;
+};
+
+static pthread_mutex_t gUtilsHostOsal_intLock = PTHREAD_MUTEX_INITIALIZER;
+
+BspOsal_SemHandle BspOsal_semCreate(Int32 initValue, Bool isBinary)
+{
+    BspOsal_SemHandle hndl;
+
+    hndl = malloc(sizeof(*hndl));
+    if(hndl != NULL)
+    {
+        pthread_mutex_init(&hndl->lock, NULL);
+        pthread_cond_init(&hndl->cond, NULL);
+        hndl->count    = initValue;
+        hndl->isBinary = isBinary;
+    }
+
+    return hndl;
+}
+
+Int32 BspOsal_semDelete(BspOsal_SemHandle *pHndl)
+{
+    pthread_cond_destroy(&(*pHndl)->cond);
+    pthread_mutex_destroy(&(*pHndl)->lock);
+    free(*pHndl);
+    *pHndl = NULL;
+
+    return SYSTEM_LINK_STATUS_SOK;
+}
+
+Bool BspOsal_semWait(BspOsal_SemHandle hndl, UInt32 timeout)
+{
+    struct timespec absTime;
+    Bool status = TRUE;
+    int ret = 0;
+
+    if(timeout != BSP_OSAL_WAIT_FOREVER)
+    {
+        clock_gettime(CLOCK_REALTIME, &absTime);
+        absTime.tv_sec  += timeout/1000U;
+        absTime.tv_nsec += (long)(timeout%1000U)*1000000L;
+        if(absTime.tv_nsec >= 1000000000L)
+        {
+            absTime.tv_sec++;
+            absTime.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&hndl->lock);
+
+    while(hndl->count == 0 && ret != ETIMEDOUT)
+    {
+        if(timeout == BSP_OSAL_WAIT_FOREVER)
+        {
+            ret = pthread_cond_wait(&hndl->cond, &hndl->lock);
+        }
+        else
+        {
+            ret = pthread_cond_timedwait(&hndl->cond, &hndl->lock, &absTime);
+        }
+    }
+
+    if(hndl->count > 0)
+    {
+        hndl->count--;
+    }
+    else
+    {
+        status = FALSE;
+    }
+
+    pthread_mutex_unlock(&hndl->lock);
+
+    return status;
+}
+
+void BspOsal_semPost(BspOsal_SemHandle hndl)
+{
+    pthread_mutex_lock(&hndl->lock);
+
+    if(!hndl->isBinary || hndl->count == 0)
+    {
+        hndl->count++;
+    }
+
+    pthread_cond_signal(&hndl->cond);
+    pthread_mutex_unlock(&hndl->lock);
+}
+
+UInt32 Hwi_disable(void)
+{
+    pthread_mutex_lock(&gUtilsHostOsal_intLock);
+
+    return 0;
+}
+
+void Hwi_restore(UInt32 key)
+{
+    pthread_mutex_unlock(&gUtilsHostOsal_intLock);
+}
+
+UInt Task_disable(void)
+{
+    return Hwi_disable();
+}
+
+void Task_restore(UInt key)
+{
+    Hwi_restore(key);
+}
@@ -0,0 +1,61 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Utils_updateLatency() as it was before seqCount and native 64-bit update
+ * were added, reference for utils_prf_latency_test.c
+ *
+ * Kept in its own file so that, same as Utils_updateLatency(), it is not
+ * inlined in the benchmark loop and calls Utils_getCurGlobalTimeInUsec()
+ * in another file.
+ */
+
+#include <src/utils_common/include/utils_prf.h>
+
+Void Test_updateLatencyRef(Utils_LatencyStats *lStats,
+                           uint64_t linkLocalTime)
+{
+    uint64_t latency;
+    uint64_t curTime = Utils_getCurGlobalTimeInUsec();
+    uint64_t time64, temp;
+
+    latency = curTime - linkLocalTime;
+
+    time64 = lStats->minLatencyLo & 0xFFFFFFFFU;
+    temp = lStats->minLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    if (time64 > latency)
+    {
+        lStats->minLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
+        lStats->minLatencyLo = (latency) & 0xFFFFFFFFU;
+    }
+
+    time64 = lStats->maxLatencyLo & 0xFFFFFFFFU;
+    temp = lStats->maxLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    if (latency > time64)
+    {
+        lStats->maxLatencyHi = (latency >> 32) & 0xFFFFFFFFU;
+        lStats->maxLatencyLo = (latency) & 0xFFFFFFFFU;
+    }
+
+    time64 = lStats->accumulatedLatencyLo & 0xFFFFFFFFU;
+    temp = lStats->accumulatedLatencyHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    time64 += latency;
+    lStats->accumulatedLatencyHi = (time64 >> 32) & 0xFFFFFFFFU;
+    lStats->accumulatedLatencyLo = (time64) & 0xFFFFFFFFU;
+
+    time64 = lStats->countLo & 0xFFFFFFFFU;
+    temp = lStats->countHi & 0xFFFFFFFFU;
+    time64 |= (temp << 32);
+    time64 ++;
+    lStats->countHi = (time64 >> 32) & 0xFFFFFFFFU;
+    lStats->countLo = (time64) & 0xFFFFFFFFU;
+}
@@ -0,0 +1,246 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host test of src/utils_common/src/utils_prf_latency.c
+ *
+ * Utils_updateLatency() is checked against the previous implementation,
+ * for random latencies including ones of 2^32 usecs or more. Then a writer
+ * thread keeps updating stats with a known latency while a reader takes copies
+ * with Utils_getLatency(). A copy for which SYSTEM_LINK_STATUS_SOK is
+ * returned must be consistent, i.e sum must be count times the latency.
+ *
+ * With --bench, time per update of the previous implementation and of the
+ * current one, which updates Hi/Lo pairs as native 64-bit values and
+ * increments seqCount, is printed.
+ */
+
+#include <src/utils_common/include/utils_prf.h>
+#include <pthread.h>
+
+#define TEST_NUM_UPDATES        (1000000U)
+#define TEST_READER_COPIES      (200000U)
+#define TEST_WRITER_LATENCY     (33333U)
+#define BENCH_NUM_UPDATES       (1000000U)
+#define BENCH_NUM_ROUNDS        (100U)
+
+static volatile UInt64 gCurTimeInUsec;
+static volatile Bool   gWriterStop;
+
+static UInt32 gErrorCount;
+
+UInt64 Utils_getCurGlobalTimeInUsec(void)
+{
+    return gCurTimeInUsec;
+}
+
+Void Test_updateLatencyRef(Utils_LatencyStats *lStats,
+                           uint64_t linkLocalTime);
+
+static void Test_check(Bool cond, const char *msg, UInt32 iter)
+{
+    if(!cond)
+    {
+        if(gErrorCount < 10)
+        {
+            printf(" ERROR: %s (iteration %u)\n", msg, iter);
+        }
+        gErrorCount++;
+    }
+}
+
+static UInt64 Test_get64(uint32_t hi, uint32_t lo)
+{
+    return ((UInt64)hi << 32) | lo;
+}
+
+static Bool Test_isSame(const Utils_LatencyStats *pA,
+                        const Utils_LatencyStats *pB)
+{
+    return (pA->maxLatencyHi == pB->maxLatencyHi
+         && pA->maxLatencyLo == pB->maxLatencyLo
+         && pA->minLatencyHi == pB->minLatencyHi
+         && pA->minLatencyLo == pB->minLatencyLo
+         && pA->accumulatedLatencyHi == pB->accumulatedLatencyHi
+         && pA->accumulatedLatencyLo == pB->accumulatedLatencyLo
+         && pA->countHi == pB->countHi
+         && pA->countLo == pB->countLo) ? TRUE : FALSE;
+}
+
+static UInt64 Test_randomLatency(UInt32 i)
+{
+    UInt64 latency = (UInt64)(rand() % 100000);
+
+    /* rare large latencies, some above 2^32 usecs */
+    if((i % 1000U) == 999U)
+    {
+        latency = ((UInt64)rand() << 16) ^ (UInt64)rand();
+    }
+    if((i % 50000U) == 49999U)
+    {
+        latency = ((UInt64)(1 + rand() % 3) << 32) + (UInt64)rand();
+    }
+
+    return latency;
+}
+
+static void Test_update(void)
+{
+    Utils_LatencyStats stats, refStats;
+    UInt32 i;
+
+    Utils_resetLatency(&stats);
+    Utils_resetLatency(&refStats);
+
+    Test_check((stats.seqCount & 1U) == 0U, "seqCount odd after reset", 0);
+
+    gCurTimeInUsec = 1ULL << 40;
+
+    for(i=0; i<TEST_NUM_UPDATES; i++)
+    {
+        UInt64 linkLocalTime = gCurTimeInUsec - Test_randomLatency(i);
+
+        Utils_updateLatency(&stats, linkLocalTime);
+        Test_updateLatencyRef(&refStats, linkLocalTime);
+
+        Test_check(Test_isSame(&stats, &refStats), "stats differ", i);
+        Test_check((stats.seqCount & 1U) == 0U, "seqCount odd", i);
+    }
+
+    /* 32-bit sum and count wrap into the upper word */
+    Utils_resetLatency(&stats);
+    Utils_resetLatency(&refStats);
+    stats.accumulatedLatencyLo = refStats.accumulatedLatencyLo = 0xFFFFFFF0U;
+    stats.countLo = refStats.countLo = 0xFFFFFFFFU;
+    Utils_updateLatency(&stats, gCurTimeInUsec - 100U);
+    Test_updateLatencyRef(&refStats, gCurTimeInUsec - 100U);
+    Test_check(Test_isSame(&stats, &refStats), "stats differ on carry", 0);
+    Test_check(Test_get64(stats.countHi, stats.countLo) == (1ULL << 32),
+               "count carry", 0);
+}
+
+static void *Test_writer(void *arg)
+{
+    Utils_LatencyStats *pStats = arg;
+
+    while(!gWriterStop)
+    {
+        Utils_updateLatency(pStats, gCurTimeInUsec - TEST_WRITER_LATENCY);
+    }
+
+    return NULL;
+}
+
+static void Test_snapshot(void)
+{
+    Utils_LatencyStats stats, copy;
+    pthread_t writer;
+    UInt32 i, torn = 0, retried = 0;
+    UInt64 count, sum;
+    Int32 status;
+
+    Utils_resetLatency(&stats);
+    gWriterStop = FALSE;
+
+    pthread_create(&writer, NULL, Test_writer, &stats);
+
+    for(i=0; i<TEST_READER_COPIES; i++)
+    {
+        status = Utils_getLatency(&copy, &stats);
+
+        count = Test_get64(copy.countHi, copy.countLo);
+        sum   = Test_get64(copy.accumulatedLatencyHi,
+                           copy.accumulatedLatencyLo);
+
+        if(status != SYSTEM_LINK_STATUS_SOK)
+        {
+            /* retries ran out, caller is told by status */
+            retried++;
+            continue;
+        }
+
+        if(sum != count*TEST_WRITER_LATENCY
+            ||
+           (count != 0U && (copy.minLatencyLo != TEST_WRITER_LATENCY
+                            || copy.maxLatencyLo != TEST_WRITER_LATENCY)))
+        {
+            torn++;
+        }
+    }
+
+    gWriterStop = TRUE;
+    pthread_join(writer, NULL);
+
+    Test_check(torn == 0, "inconsistent copy returned with SOK", torn);
+
+    printf(" Snapshot: %u copies, %u inconsistent, %u gave up on retry\n",
+           TEST_READER_COPIES, torn, retried);
+}
+
+/* same loop for both, called through a pointer, so that code placement of
+ * the loop does not favour either */
+static UInt64 Test_benchRound(Void (*update)(Utils_LatencyStats *, uint64_t))
+{
+    Utils_LatencyStats stats;
+    UInt64 startUs;
+    UInt32 i;
+
+    Utils_resetLatency(&stats);
+    startUs = UtilsHostTest_getTimeInUsec();
+    for(i=0; i<BENCH_NUM_UPDATES; i++)
+    {
+        update(&stats, gCurTimeInUsec - (i & 0xFFFFU));
+    }
+
+    return UtilsHostTest_getTimeInUsec() - startUs;
+}
+
+static void Test_bench(void)
+{
+    UInt64 refUs, curUs, minRefUs = ~0ULL, minCurUs = ~0ULL;
+    UInt32 round;
+
+    gCurTimeInUsec = 1ULL << 40;
+
+    /* rounds alternate between the two, best round of each is printed so
+     * that other load on the host does not favour either */
+    for(round=0; round<BENCH_NUM_ROUNDS; round++)
+    {
+        refUs = Test_benchRound(Test_updateLatencyRef);
+        curUs = Test_benchRound(Utils_updateLatency);
+
+        minRefUs = (refUs < minRefUs) ? refUs : minRefUs;
+        minCurUs = (curUs < minCurUs) ? curUs : minCurUs;
+    }
+
+    printf(" BENCH: %u updates, best of %u rounds\n",
+           BENCH_NUM_UPDATES, BENCH_NUM_ROUNDS);
+    printf(" BENCH: Previous update                    : %5.2f ns/update\n",
+           (double)minRefUs*1000.0/BENCH_NUM_UPDATES);
+    printf(" BENCH: Native 64-bit update with seqCount : %5.2f ns/update\n",
+           (double)minCurUs*1000.0/BENCH_NUM_UPDATES);
+}
+
+int main(int argc, char *argv[])
+{
+    srand(1);
+
+    Test_update();
+    Test_snapshot();
+
+    if(argc > 1 && strcmp(argv[1], "--bench")==0)
+    {
+        Test_bench();
+    }
+
+    printf(" utils_prf_latency_test: %s (%u errors)\n",
+           gErrorCount ? "FAILED" : "PASSED", gErrorCount);
+
+    return gErrorCount ? 1 : 0;
+}
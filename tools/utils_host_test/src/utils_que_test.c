@@ -0,0 +1,185 @@
+/*
+ *******************************************************************************
+ *
+ * Copyright (C) 2015 Texas Instruments Incorporated - http://www.ti.com/
+ * ALL RIGHTS RESERVED
+ *
+ *******************************************************************************
+ */
+
+/*
+ * Host test of src/utils_common/src/utils_que.c
+ *
+ * A producer thread and a consumer thread move a sequence of elements
+ * through a small queue, consumer checks that every element arrives once
+ * and in order. This is done for UTILS_QUE_FLAG_SPSC and for the default
+ * locked queue, in non-blocking mode (retry on failure) and in blocking
+ * mode, with minCount of every get picked at random.
+ *
+ * Blocking put/get use a finite timeout. Producer and consumer may run on
+ * two host CPUs, while on target they are tasks of the same core. A store
+ * to blockedOnGet/blockedOnPut followed by a load of the other index is
+ * not ordered on a SMP host, so a wakeup may be missed. Such a put/get
+ * returns on timeout and is retried, the count is reported.
+ *
+ * With --bench, time per element is printed for every mode.
+ */
+
+#include <src/utils_common/include/utils_que.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define TEST_QUE_DEPTH          (7U)
+#define TEST_NUM_ELEMENTS       (300000U)
+#define TEST_TIMEOUT            (10U)
+
+typedef struct {
+
+    char            *name;
+    UInt32           flags;
+    Int32            timeout;
+    Utils_QueHandle  que;
+    Ptr              queMem[TEST_QUE_DEPTH];
+    UInt32           putRetry;
+    UInt32           getRetry;
+    UInt32           errorCount;
+
+} Test_QueObj;
+
+static Bool gBench;
+
+static void *Test_producer(void *arg)
+{
+    Test_QueObj *pObj = arg;
+    UInt32 i;
+
+    for(i=1; i<=TEST_NUM_ELEMENTS; i++)
+    {
+        while(Utils_quePut(&pObj->que, (Ptr)(uintptr_t)i, pObj->timeout)
+                != SYSTEM_LINK_STATUS_SOK)
+        {
+            pObj->putRetry++;
+            if(pObj->timeout == BSP_OSAL_NO_WAIT)
+            {
+                sched_yield();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void *Test_consumer(void *arg)
+{
+    Test_QueObj *pObj = arg;
+    UInt32 next, minCount, remain;
+    Ptr data;
+
+    for(next=1; next<=TEST_NUM_ELEMENTS; next++)
+    {
+        /* never ask for more than what producer still has to put */
+        remain   = TEST_NUM_ELEMENTS - next + 1;
+        minCount = 1 + (next*2654435761U >> 16) % TEST_QUE_DEPTH;
+        if(minCount > remain)
+        {
+            minCount = remain;
+        }
+
+        while(Utils_queGet(&pObj->que, &data, minCount, pObj->timeout)
+                != SYSTEM_LINK_STATUS_SOK)
+        {
+            pObj->getRetry++;
+            if(pObj->timeout == BSP_OSAL_NO_WAIT)
+            {
+                sched_yield();
+            }
+        }
+
+        if((UInt32)(uintptr_t)data != next)
+        {
+            if(pObj->errorCount < 10)
+            {
+                printf(" ERROR: %s: got %u, expected %u\n",
+                       pObj->name, (UInt32)(uintptr_t)data, next);
+            }
+            pObj->errorCount++;
+            next = (UInt32)(uintptr_t)data;
+        }
+    }
+
+    return NULL;
+}
+
+static UInt32 Test_run(char *name, UInt32 flags, Int32 timeout)
+{
+    Test_QueObj obj;
+    pthread_t producer, consumer;
+    UInt64 startUs, elapsedUs;
+    Int32 status;
+
+    memset(&obj, 0, sizeof(obj));
+    obj.name    = name;
+    obj.flags   = flags;
+    obj.timeout = timeout;
+
+    status = Utils_queCreate(&obj.que, TEST_QUE_DEPTH, obj.queMem, flags);
+    UTILS_assert(status == SYSTEM_LINK_STATUS_SOK);
+
+    startUs = UtilsHostTest_getTimeInUsec();
+
+    pthread_create(&consumer, NULL, Test_consumer, &obj);
+    pthread_create(&producer, NULL, Test_producer, &obj);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    elapsedUs = UtilsHostTest_getTimeInUsec() - startUs;
+
+    if(Utils_queIsEmpty(&obj.que) != TRUE)
+    {
+        printf(" ERROR: %s: queue not empty at end\n", name);
+        obj.errorCount++;
+    }
+
+    Utils_queDelete(&obj.que);
+
+    printf(" %-28s: %s, put retry %u, get retry %u",
+           name, obj.errorCount ? "FAILED" : "PASSED",
+           obj.putRetry, obj.getRetry);
+    if(gBench)
+    {
+        printf(", %6.1f ns/element",
+               (double)elapsedUs*1000.0/TEST_NUM_ELEMENTS);
+    }
+    printf("\n");
+
+    return obj.errorCount;
+}
+
+int main(int argc, char *argv[])
+{
+    UInt32 errorCount = 0;
+
+    if(argc > 1 && strcmp(argv[1], "--bench")==0)
+    {
+        gBench = TRUE;
+    }
+
+    errorCount += Test_run("SPSC, non-blocking",
+                           UTILS_QUE_FLAG_SPSC|UTILS_QUE_FLAG_NO_BLOCK_QUE,
+                           BSP_OSAL_NO_WAIT);
+    errorCount += Test_run("SPSC, blocking",
+                           UTILS_QUE_FLAG_SPSC|UTILS_QUE_FLAG_BLOCK_QUE,
+                           TEST_TIMEOUT);
+    errorCount += Test_run("Locked, non-blocking",
+                           UTILS_QUE_FLAG_NO_BLOCK_QUE,
+                           BSP_OSAL_NO_WAIT);
+    errorCount += Test_run("Locked, blocking",
+                           UTILS_QUE_FLAG_BLOCK_QUE,
+                           TEST_TIMEOUT);
+
+    printf(" utils_que_test: %s (%u errors)\n",
+           errorCount ? "FAILED" : "PASSED", errorCount);
+
+    return errorCount ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+#include "cost.h"
+#include "error.h"
+#include "support.h"
+
+CostTable costTable;
+
+CostTable::CostTable() {
+    fileName = "";
+}
+
+void CostTable::load(string name) {
+    ifstream fp(name.c_str());
+    string line;
+    int lineNum = 0;
+
+    CHECK_ERROR_ABORT(fp.is_open(), "Error: Cost table [" + name + "] could not be opened !!!");
+    fileName = name;
+
+    while (getline(fp, line)) {
+        lineNum++;
+
+        istringstream tokens(line);
+        Entry e;
+        string tok;
+
+        if (!(tokens >> e.link) || e.link.compare(0, 2, "//") == 0
+                || e.link.at(0) == '#')
+            continue;
+
+        tokens >> e.cpu;
+        CHECK_ERROR_ABORT(e.cpu.length() != 0,
+                "Error: Cost table [" + name + "] line " + toString(lineNum) + ": CPU not given !!!");
+
+        bool cpuFound = (e.cpu == "*");
+        for (int i = 0; i < NUMPROC; i++) {
+            if (e.cpu == procName[i] || e.cpu == procClassName[i])
+                cpuFound = true;
+        }
+        CHECK_ERROR_ABORT(cpuFound,
+                "Error: Cost table [" + name + "] line " + toString(lineNum) + ": Unknown CPU [" + e.cpu + "] !!!");
+
+        while (tokens >> tok) {
+            size_t eq = tok.find('=');
+            char* end = NULL;
+            double value = 0;
+
+            if (eq != string::npos && eq > 0 && eq + 1 < tok.length())
+                value = strtod(tok.c_str() + eq + 1, &end);
+            CHECK_ERROR_ABORT(end != NULL && *end == '\0',
+                    "Error: Cost table [" + name + "] line " + toString(lineNum) + ": [" + tok + "] is not <field>=<value> !!!");
+            e.field[tok.substr(0, eq)] = value;
+        }
+        entries.push_back(e);
+    }
+}
+
+bool CostTable::isLoaded() {
+    return fileName.length() != 0;
+}
+
+int CostTable::linkMatch(Entry &e, string name) {
+    if (e.link == name)
+        return 3;
+    if (e.link == getLinkType(name))
+        return 2;
+    if (e.link == "*")
+        return 1;
+    return 0;
+}
+
+int CostTable::cpuMatch(Entry &e, ProcType pType) {
+    if (e.cpu == procName[pType] || (pType == A15 && e.cpu == "A15"))
+        return 3;
+    if (e.cpu == procClassName[pType])
+        return 2;
+    if (e.cpu == "*")
+        return 1;
+    return 0;
+}
+
+bool CostTable::getCost(string name, ProcType pType, string field, double &value) {
+    int best = 0;
+    for (int i = 0; i < entries.size(); i++) {
+        Entry &e = entries.at(i);
+        int lm = linkMatch(e, name), cm = cpuMatch(e, pType);
+        if (lm == 0 || cm == 0 || e.field.find(field) == e.field.end())
+            continue;
+        if (lm * 4 + cm >= best) {
+            best = lm * 4 + cm;
+            value = e.field[field];
+        }
+    }
+    return best != 0;
+}
+
+double CostTable::getCost(string name, ProcType pType, string field) {
+    double value = 0;
+    getCost(name, pType, field, value);
+    return value;
+}
@@ -0,0 +1,61 @@
+#ifndef COST_H
+#define COST_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "processor.h"
+
+using namespace std;
+
+/* Cost table given with -cost option, one entry per line
+ *
+ *   <Link> <CPU> <field>=<value> [<field>=<value> ...]
+ *
+ * <Link> : Link name (Alg_EdgeDetect_0), Link type (Alg_EdgeDetect, Dup) or *
+ * <CPU>  : CPU (EVE1), CPU class (IPU1, A15, DSP, EVE) or *
+ * field  : load   - Load on CPU in % for one instance of the Link
+ *          cycles - CPU cycles per frame
+ *          cpp    - CPU cycles per pixel of input frame
+ *          rd, wr - DDR bytes read per pixel of input, written per pixel of
+ *                   output frame
+ *          lat    - Latency in usecs per frame apart from CPU time, e.g. IPC
+ *          width, height, fps - Output frame of Link, if not same as input
+ *          bpp    - Bytes per pixel of output buffers of Link, 1.5 if not given
+ *          mhz    - CPU clock, with <Link> as CPU
+ *
+ * -place uses load, -perf and -bufs use cycles and cpp if given, else load.
+ *
+ * Lines starting with '//' or '#' are comments. For a Link on a CPU, the
+ * entry with the most specific <Link> and then the most specific <CPU> which
+ * has the field is used, later entry if both are same.
+ */
+class CostTable {
+
+	struct Entry {
+		string link;
+		string cpu;
+		map<string, double> field;
+	};
+
+	string fileName;
+	vector<Entry> entries;
+
+	int linkMatch(Entry &e, string name);
+	int cpuMatch(Entry &e, ProcType pType);
+
+public:
+
+	CostTable();
+
+	void load(string name);
+	bool isLoaded();
+
+	//Returns false if no entry has the field for Link on CPU
+	bool getCost(string name, ProcType pType, string field, double &value);
+	double getCost(string name, ProcType pType, string field);
+};
+
+extern CostTable costTable;
+#endif
@@ -5,12 +5,14 @@
 #include "link.h"
 #include "error.h"
 #include "support.h"
+#include "options.h"
 
 Link::Link() {
     linkIDName = name + string("LinkID");
     prmName = name + string("Prm");
     execPos = -1;
     procID = -1;
+    procClass = "";
     matrixPos = -1;
     cType = cDefLink;
     pType = IPU1_0;
@@ -59,8 +61,19 @@ void Link::setProcType(string strproc) {
         proc = EVE3;
     else if (strproc == "EVE4")
         proc = EVE4;
+    else if (cmd_options.autoPlace()
+            && (strproc == "IPU1" || strproc == "DSP" || strproc == "EVE")) {
+        //CPU is selected by Usecase::placeCPU()
+        if (procID == -1)
+            procClass = strproc;
+        else if (procClassName[pType] != strproc)
+            CHECK_ERROR(SHOULD_NOT_REACH, "Error: Multiple CPU types [" + strproc + "] and [" + procName[pType] + "] assigned to same Link [" + name + "] !!!");
+        return;
+    }
     else
         CHECK_ERROR_ABORT(SHOULD_NOT_REACH, "Error: Unknown CPU ["+strproc+"] assigned to Link ["+name+"]. Use '-h' option to see list of supported CPUs !!!");
+    if (procClass.length() != 0 && procClassName[proc] != procClass)
+        CHECK_ERROR(SHOULD_NOT_REACH, "Error: Multiple CPU types [" + procName[proc] + "] and [" + procClass + "] assigned to same Link [" + name + "] !!!");
     if (procID == -1) //If ProcID not set already
     {
         pType = proc;
@@ -78,6 +91,10 @@ int Link::getProcID() {
     return procID;
 }
 
+string Link::getProcClass() {
+    return procClass;
+}
+
 string Link::getName() {
     return name;
 }
@@ -26,6 +26,7 @@ protected:
     int matrixPos; //Position in matrix of connections (Usecase class)
     int execPos; //Sequence num assigned to link
     int procID; //ID given by processor to link obj
+    string procClass; //CPU class to place link on (-place option), "" if none
 
     bool mulInQue; //True if multiple input
     bool mulOutQue; //True if multiple output
@@ -57,6 +58,7 @@ public:
 
     void setProcID();
     int getProcID();
+    string getProcClass();
 
     int getMatrixPos();
     void setMatrixPos(int pos);
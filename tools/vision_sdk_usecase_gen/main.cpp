@@ -8,6 +8,7 @@ using namespace std;
 #include "parse.tab.hh"
 #include "options.h"
 #include "usecase.h"
+#include "cost.h"
 #include "error.h"
 
 Usecase mainObj;
@@ -30,6 +31,10 @@ int main(int argc, char * argv[]) {
 	if(v == -1)
 		return 0;
 
+	//load cost table of Links, if given
+	if(cmd_options.get_cost_file_name().length() != 0)
+		costTable.load(cmd_options.get_cost_file_name());
+
 	// Create the parser object and parse the input program
 	vsdk_ctx ctx;
 	yy::vsdk parser(ctx);
@@ -20,6 +20,9 @@ Options::Options() {
     verbose_mode = false;
     log_mode = false;
     output_path = false;
+    auto_place = false;
+    perf_model = false;
+    buf_sizing = false;
 
     os_tokens = NULL;
     os_file = NULL;
@@ -66,6 +69,21 @@ bool Options::write_tologFile()
     return log_mode;
 }
 
+bool Options::autoPlace()
+{
+    return auto_place;
+}
+
+bool Options::perfModel()
+{
+    return perf_model;
+}
+
+bool Options::bufSizing()
+{
+    return buf_sizing;
+}
+
 ostream * Options::tokens_File() {
     return &ofs_tokens;
 }
@@ -106,10 +124,19 @@ int Options::process_Options(int argc, char * argv[]) {
             "   -debug           :  Prints file name and line no of tool source code in error statements (To be used by tool developers only)\n"
             "   -path [pathname] :  Output path where generated files are written. If not specified current directory is used\n"
             "   -v               :  Verbose output on console\n"
+            "   -place           :  Place Links given a CPU class on a CPU of that class, minimizing IPC links and balancing CPU load\n"
+            "   -perf            :  Estimate CPU load, fps, latency and DDR bandwidth of usecase using cost table\n"
+            "   -bufs            :  Recommend number of output buffers of Links using cost table, added as comments in _SetPrms\n"
+            "   -cost [filename] :  Cost table of Links, lines of '<Link> <CPU> <field>=<value> ...', used by -place and -perf\n"
+            "                       fields: load (% of CPU), cycles (per frame), cpp (cycles per pixel), rd, wr (DDR bytes per pixel),\n"
+            "                       lat (usecs per frame), width, height, fps, bpp (output frame of Link), mhz (for Link 'CPU')\n"
             " \n"
             " Supported CPUs: \n"
             "   IPU1_0, IPU1_1, A15, DSP1, DSP2, EVE1, EVE2, EVE3, EVE4 \n"
             " \n"
+            " Supported CPU classes (with -place): \n"
+            "   IPU1, DSP, EVE \n"
+            " \n"
             " Supported Links:  \n"
             "   AvbRx\n"
             "   Capture\n"
@@ -197,6 +224,21 @@ int Options::process_Options(int argc, char * argv[]) {
                 }
                 else
                     CHECK_ERROR_ABORT(SHOULD_NOT_REACH, "Error: Output path not provided !!!");
+            }else if (strcmp(option, "-place") == 0) {
+                auto_place = true;
+            }else if (strcmp(option, "-perf") == 0) {
+                perf_model = true;
+            }else if (strcmp(option, "-bufs") == 0) {
+                buf_sizing = true;
+            }else if (strcmp(option, "-cost") == 0) {
+                if(i+1 < argc)
+                {
+                    cost_file_name = string(argv[i+1]);
+                    i++;
+                    continue;
+                }
+                else
+                    CHECK_ERROR_ABORT(SHOULD_NOT_REACH, "Error: Cost table file not provided !!!");
             }else if ((strcmp(option, "--help") == 0)
                     || (strcmp(option, "-help") == 0)
                     || (strcmp(option, "-h") == 0)){
@@ -279,3 +321,8 @@ string Options::get_output_path_name()
 {
     return output_path_name;
 }
+
+string Options::get_cost_file_name()
+{
+    return cost_file_name;
+}
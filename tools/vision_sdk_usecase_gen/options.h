@@ -17,6 +17,9 @@ class Options {
 	bool verbose_mode;
 	bool log_mode;
 	bool output_path;
+	bool auto_place;
+	bool perf_model;
+	bool buf_sizing;
 	/* Output streams */
 
 	ostream* os_tokens;
@@ -37,6 +40,7 @@ class Options {
 	ofstream ofs_log;
 
 	string input_file_name;
+	string cost_file_name;
 
 public:
 	string output_path_name;
@@ -49,6 +53,9 @@ public:
 	bool write_toImage();
 	bool verboseMode();
 	bool write_tologFile();
+	bool autoPlace();
+	bool perfModel();
+	bool bufSizing();
 
 	int process_Options(int argc, char * argv[]);
 	void setFileNames(string filestr);
@@ -62,6 +69,7 @@ public:
 	ostream* log_File();
 
 	string get_output_path_name();
+	string get_cost_file_name();
 };
 
 extern Options cmd_options;
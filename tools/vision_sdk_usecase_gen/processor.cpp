@@ -2,6 +2,8 @@
 #include "error.h"
 #include "support.h"
 
+const double procMHz[NUMPROC] = { 212.8, 212.8, 1000, 750, 750, 650, 650, 650, 650 };
+
 Processor::Processor() {
     for (int i = 0; i < NUMPROC; i++)
         for (int j = 0; j < ClassCount; j++)
@@ -13,6 +13,11 @@ enum ProcType {
 };
 static string procName[] = { "IPU1_0", "IPU1_1", "A15_0", "DSP1", "DSP2",
         "EVE1", "EVE2", "EVE3", "EVE4" };
+//CPU class of each CPU, a Link can be given a class with -place option
+static string procClassName[] = { "IPU1", "IPU1", "A15", "DSP", "DSP",
+        "EVE", "EVE", "EVE", "EVE" };
+//Default clock of each CPU in MHz used by -perf option, cost table can change it
+extern const double procMHz[NUMPROC];
 
 enum ClassType {
     cAVBReceive,
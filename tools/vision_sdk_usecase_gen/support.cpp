@@ -33,3 +33,11 @@ string getSecRoot(string name) {
 	}
 	return root;
 }
+
+//Link type as used in cost table, Alg_EdgeDetect_0 -> Alg_EdgeDetect, Dup_sv -> Dup
+string getLinkType(string name) {
+	string root = getRoot(name);
+	if (root == "Alg" || root == "DefLink")
+		return root + "_" + getSecRoot(name);
+	return root;
+}
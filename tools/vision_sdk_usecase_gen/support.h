@@ -16,5 +16,6 @@ using namespace std;
 string toString(int num);
 string getRoot(string name);
 string getSecRoot(string name);
+string getLinkType(string name);
 
 #endif /* SUPPORT_H_ */
@@ -0,0 +1,64 @@
+#!/bin/sh
+#
+# (c) Texas Instruments 2016
+#
+# Timing test of the usecase generation tool on synthetic usecases of
+# thousands of links.
+#
+# synthetic_timing.sh [tool] [channel counts] [max secs per usecase]
+#
+# Every channel is
+#   NullSource -> Dup -> Merge -> Dup_fb -> Null
+#   Dup -> Alg_FrameCopy (A15) -> Merge
+#   Dup_fb -> Merge
+# i.e. 10 links with the IPC links on IPU1_0 <-> A15 and a loop back to Merge.
+# The tool is run with -file on each usecase, its time is printed and the
+# test fails if the tool fails or takes more than max secs.
+#
+
+VSDK=${1:-../bin/vsdk_linux.out}
+CH_LIST=${2:-"100 200 400 800"}
+MAX_SECS=${3:-10}
+
+case "$VSDK" in
+    /*) ;;
+    *) VSDK=$(pwd)/$VSDK ;;
+esac
+
+TMP_DIR=$(mktemp -d)
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+status=0
+
+for ch in $CH_LIST; do
+    file=$TMP_DIR/synthetic_$ch
+
+    echo "UseCase: chains_synthetic_$ch" > $file
+    c=0
+    while [ $c -lt $ch ]; do
+        echo "NullSource_$c (IPU1_0) -> Dup_$c -> Merge_$c -> Dup_fb_$c -> Null_$c" >> $file
+        echo "Dup_$c -> Alg_FrameCopy_$c (A15) -> Merge_$c" >> $file
+        echo "Dup_fb_$c -> Merge_$c" >> $file
+        c=$((c+1))
+    done
+
+    start=$(date +%s%N)
+    (cd $TMP_DIR && "$VSDK" -file $file > $file.log 2>&1)
+    rc=$?
+    end=$(date +%s%N)
+    msecs=$(( (end - start) / 1000000 ))
+
+    # Tool exits with 0 on errors too
+    if [ $rc -ne 0 ] || grep -q "^Error" $file.log; then
+        echo "# ERROR: $ch channels ($((ch*10)) links): tool failed"
+        tail -5 $file.log
+        status=1
+    elif [ $msecs -gt $((MAX_SECS*1000)) ]; then
+        echo "# ERROR: $ch channels ($((ch*10)) links): $msecs msecs, more than $MAX_SECS secs"
+        status=1
+    else
+        echo "# INFO: $ch channels ($((ch*10)) links): $msecs msecs"
+    fi
+done
+
+exit $status
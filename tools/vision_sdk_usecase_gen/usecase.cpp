@@ -1,16 +1,13 @@
 #include <iomanip>
 #include <ostream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
 
 #include "usecase.h"
 
 
 Usecase::Usecase() {
-    for (int i = 0; i < OBJ_MAX; i++) {
-        for (int j = 0; j < OBJ_MAX; j++) {
-            matrix[i][j] = false;
-            userMat[i][j] = false;
-        }
-    }
     numIpc = 0;
     fileName = "";
     structName = "";
@@ -22,13 +19,25 @@ void Usecase::initialize() {
         setFileName("out");
     cmd_options.setFileNames(fileName);
     logFile = cmd_options.log_File();
+    if (cmd_options.autoPlace())
+        placeCPU();
     assignCPU();
     createAllConn();
     setSequence();
     assignLinkID();
+    if (cmd_options.perfModel() || cmd_options.bufSizing())
+        estimatePerf();
+    if (cmd_options.bufSizing())
+        recommendBufs();
 }
 
 void Usecase::print() {
+    if(cmd_options.autoPlace())
+        printPlacement(&cout);
+    if(cmd_options.perfModel())
+        printPerf(&cout);
+    if(cmd_options.bufSizing())
+        printBufs(&cout);
     if(cmd_options.verboseMode())
     {
         //printFileName(&cout);
@@ -40,6 +49,12 @@ void Usecase::print() {
         printFileName(logFile);
         printExecSeq(logFile);
         printTable(logFile);
+        if(cmd_options.autoPlace())
+            printPlacement(logFile);
+        if(cmd_options.perfModel())
+            printPerf(logFile);
+        if(cmd_options.bufSizing())
+            printBufs(logFile);
     }
 }
 
@@ -85,6 +100,9 @@ Link* Usecase::createObject(string name) {
         temp_seq.push_back(obj);
         inst_object[name] = obj;
         obj->setMatrixPos(temp_seq.size() - 1);
+        outAdj.push_back(vector<int>());
+        inAdj.push_back(vector<int>());
+        userAdj.push_back(set<int>());
         return obj;
     }
 }
@@ -213,6 +231,169 @@ void Usecase::createNewObj(string name, Link* &obj) {
         CHECK_ERROR_ABORT(false, "Error: Link [" + name + "] name does not match supported links. Use '-h' option to see list of supported links !!!");
 }
 
+//Cost of a placement of Links on CPUs, see Usecase::placeCPU()
+struct PlaceCost {
+    double overLoad;
+    int numIpc;
+    double loadSq;
+    int countSq;
+
+    bool operator<(const PlaceCost &c) const {
+        if (overLoad < c.overLoad - 0.001 || overLoad > c.overLoad + 0.001)
+            return overLoad < c.overLoad;
+        if (numIpc != c.numIpc)
+            return numIpc < c.numIpc;
+        if (loadSq < c.loadSq - 0.001 || loadSq > c.loadSq + 0.001)
+            return loadSq < c.loadSq;
+        return countSq < c.countSq;
+    }
+};
+
+static PlaceCost getPlaceCost(vector<ProcType> &cpu,
+        vector<vector<double> > &load, vector<pair<int, int> > &conn,
+        double *ipcOutLoad, double *ipcInLoad) {
+    PlaceCost cost = { 0, 0, 0, 0 };
+    double cpuLoad[NUMPROC] = { 0 };
+    int cpuCount[NUMPROC] = { 0 };
+
+    for (int i = 0; i < cpu.size(); i++) {
+        cpuLoad[cpu[i]] += load[i][cpu[i]];
+        cpuCount[cpu[i]]++;
+    }
+    for (int i = 0; i < conn.size(); i++) {
+        ProcType p1 = cpu[conn[i].first], p2 = cpu[conn[i].second];
+        if (p1 != p2) {
+            cost.numIpc++;
+            cpuLoad[p1] += ipcOutLoad[p1];
+            cpuLoad[p2] += ipcInLoad[p2];
+        }
+    }
+    for (int p = 0; p < NUMPROC; p++) {
+        if (cpuLoad[p] > 100)
+            cost.overLoad += cpuLoad[p] - 100;
+        cost.loadSq += cpuLoad[p] * cpuLoad[p];
+        cost.countSq += cpuCount[p] * cpuCount[p];
+    }
+    return cost;
+}
+
+/* Links given a CPU class (-place option) are placed on a CPU of that class.
+ * Placements are compared by, in order,
+ *  1. Load over 100% summed over all CPUs
+ *  2. Number of IPCOut/IPCIn pairs, i.e. connections across CPUs
+ *  3. Sum of square of load of CPUs, least when load is balanced
+ *  4. Sum of square of number of Links on CPUs
+ * Load of a Link, including IPCOut/IPCIn, on a CPU is from cost table (-cost
+ * option), 0 if not given. All placements are tried if there are at most
+ * PLACE_MAX_SEARCH, else starting with each Link on first CPU of its class,
+ * Links are moved to another CPU as long as it gives a better placement.
+ */
+void Usecase::placeCPU() {
+    int N = temp_seq.size();
+    vector<ProcType> cpu(N);
+    vector<vector<ProcType> > choice(N); //CPUs of class of Link
+    vector<vector<double> > load(N, vector<double>(NUMPROC));
+    vector<int> movable; //Links to be placed
+    vector<pair<int, int> > conn; //Connections needing IPC links across CPUs
+    set<pair<int, int> > connFound;
+    double ipcOutLoad[NUMPROC], ipcInLoad[NUMPROC];
+    long long numPlace = 1;
+
+    for (int i = 0; i < N; i++) {
+        Link* obj = temp_seq.at(i);
+        cpu[i] = obj->getProcType();
+        for (int p = 0; p < NUMPROC; p++) {
+            load[i][p] = costTable.getCost(obj->getName(), (ProcType) p, "load");
+            if (obj->getProcID() == -1
+                    && obj->getProcClass() == procClassName[p])
+                choice[i].push_back((ProcType) p);
+        }
+        if (choice[i].size() != 0) {
+            movable.push_back(i);
+            cpu[i] = choice[i][0];
+            if (numPlace <= PLACE_MAX_SEARCH)
+                numPlace *= choice[i].size();
+        }
+    }
+    if (movable.size() == 0)
+        return;
+
+    for (int p = 0; p < NUMPROC; p++) {
+        ipcOutLoad[p] = costTable.getCost("IPCOut", (ProcType) p, "load");
+        ipcInLoad[p] = costTable.getCost("IPCIn", (ProcType) p, "load");
+    }
+
+    for (int i = 0; i < connections.size(); i++) {
+        vector<Link*> &vec = connections.at(i);
+        for (int j = vec.size() - 2; j >= 0; j--) {
+            Link* obj1 = vec.at(j + 1);
+            Link* obj2 = vec.at(j);
+            //As in connect(), these are connected without IPC links
+            if (obj2->getClassType() == cAlg_SubframeCopy
+                    || (obj1->getClassType() == cIPCOut
+                            && obj2->getClassType() == cIPCIn))
+                continue;
+            pair<int, int> c(obj1->getMatrixPos(), obj2->getMatrixPos());
+            if (connFound.insert(c).second)
+                conn.push_back(c);
+        }
+    }
+
+    PlaceCost bestCost = getPlaceCost(cpu, load, conn, ipcOutLoad, ipcInLoad);
+    vector<ProcType> best = cpu;
+
+    if (numPlace <= PLACE_MAX_SEARCH) {
+        //Count through placements, first Link changing fastest
+        vector<int> digit(movable.size(), 0);
+        while (true) {
+            int k = 0;
+            while (k < movable.size()
+                    && digit[k] == choice[movable[k]].size() - 1) {
+                digit[k] = 0;
+                cpu[movable[k]] = choice[movable[k]][0];
+                k++;
+            }
+            if (k == movable.size())
+                break;
+            digit[k]++;
+            cpu[movable[k]] = choice[movable[k]][digit[k]];
+
+            PlaceCost cost = getPlaceCost(cpu, load, conn, ipcOutLoad, ipcInLoad);
+            if (cost < bestCost) {
+                bestCost = cost;
+                best = cpu;
+            }
+        }
+    } else {
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            for (int k = 0; k < movable.size(); k++) {
+                int m = movable[k];
+                for (int c = 0; c < choice[m].size(); c++) {
+                    ProcType prev = cpu[m];
+                    if (choice[m][c] == prev)
+                        continue;
+                    cpu[m] = choice[m][c];
+                    PlaceCost cost = getPlaceCost(cpu, load, conn, ipcOutLoad, ipcInLoad);
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        moved = true;
+                    } else
+                        cpu[m] = prev;
+                }
+            }
+        }
+        best = cpu;
+    }
+
+    for (int k = 0; k < movable.size(); k++) {
+        Link* obj = temp_seq.at(movable[k]);
+        obj->setProcType(best[movable[k]]);
+        placed.push_back(obj);
+    }
+}
+
 void Usecase::assignCPU() {
     for (int i = 0; i < temp_seq.size(); i++)
         (temp_seq.at(i))->setProcType((temp_seq.at(i))->getProcType());
@@ -225,131 +406,147 @@ void Usecase::assignLinkID() {
 
 
 
-/**For each head:
- * //if no parent || all parents assigned/visited
-        //if not assigned,
-        1. assign itself -- set all false
-
-        2. find a child unassigned, call func assign on to child - child visited true
-        3. if all child assigned, move assign parent
-
-//if all parents not assigned
-1. find a parent unassigned, unvisited call assign func on it -- visited mark true
+/* Links are assigned sequence numbers walking down from each head (Link with
+ * no incoming link), last created outgoing link first. When a Link has
+ * incoming links not yet assigned, walk goes up the last created of them till
+ * a Link with all incoming links assigned is found. A Link reached again while
+ * walking up is in a loop, i.e. an output fed back to an earlier Link (e.g.
+ * Alg_PhotoAlign -> Alg_Synthesis), and is assigned first. A Link is done once
+ * all its outgoing links are assigned, walk then continues from its incoming
+ * links which are not done.
+ *
+ * Walk keeps its own stack and visited marks are reset by moving to a new
+ * walk number. Each Link keeps where its assigned incoming and outgoing links
+ * start from the end (links are taken last first and never unassigned), so
+ * outside loops every connection is skipped once and the walk is linear.
+ * A loop fed by no other Link can never be assigned and is an error.
  */
+void Usecase::setSequence() {
+    int N = temp_seq.size();
+    vector<vector<int> > parent(N); //inAdj in increasing order of matrixPos
+    vector<vector<int> > child(N); //outAdj in increasing order of matrixPos
+    vector<bool> asgn(N, false);
+    vector<bool> done(N, false);
+    vector<int> visited(N, -1); //Visited if equal to current walk
+    vector<int> parentEnd(N); //parent[i] from this index on are assigned
+    vector<int> childEnd(N); //child[i] from this index on are assigned
+    vector<pair<int, int> > doneStack; //Link done, next incoming link to walk
+    int walk = 0;
 
-void Usecase::assignSeq(int curr, bool* asgn, bool* visited, bool* done) {
+    for (int i = 0; i < N; i++) {
+        for (int k = 0; k < inAdj[i].size(); k++)
+            child[inAdj[i][k]].push_back(i);
+        for (int k = 0; k < outAdj[i].size(); k++)
+            parent[outAdj[i][k]].push_back(i);
+    }
 
-    int N = temp_seq.size(), parv = -1, parAsgn=-1, child = -1, par = -1;
-    bool allAsgn = true;
+    vector<int> start; //Links to walk from
     for (int i = 0; i < N; i++) {
-        if(matrix[i][curr] == true && !(asgn[i]||visited[i])) //if parent
-        {
-            parAsgn = i;
-            allAsgn = false;
-        }
-        else if(matrix[i][curr] == true && visited[i] && !asgn[i])
-            parv = i;
+        parentEnd[i] = parent[i].size();
+        childEnd[i] = child[i].size();
+        if (parent[i].size() == 0)
+            start.push_back(i);
     }
 
+    while (!start.empty()) {
+        for (int s = 0; s < start.size(); s++) {
+            int curr = start[s];
+            while (curr != -1) {
+                //Last incoming link not assigned and not visited, else last
+                //one visited. Assigned links at the end are not looked at again
+                int par = -1, parVisited = -1;
+                while (parentEnd[curr] > 0
+                        && asgn[parent[curr][parentEnd[curr] - 1]])
+                    parentEnd[curr]--;
+                for (int k = parentEnd[curr] - 1; k >= 0 && par == -1; k--) {
+                    int p = parent[curr][k];
+                    if (asgn[p])
+                        continue;
+                    if (visited[p] != walk)
+                        par = p;
+                    else if (parVisited == -1)
+                        parVisited = p;
+                }
 
-    if(allAsgn == true)
-    {
-        //if not visited yet
-        if(visited[curr] == false)
-        {
-            if(parv == -1) //all parent assigned
-            {
-                //assign itself
-                if(asgn[curr] == false)
-                {
+                //Walk up to an incoming link not assigned
+                if (par != -1
+                        || (parVisited != -1 && visited[curr] != walk)) {
+                    visited[curr] = walk;
+                    curr = (par != -1) ? par : parVisited;
+                    continue;
+                }
+
+                if (asgn[curr] == false) {
                     exec_seq.push_back(temp_seq.at(curr));
                     (temp_seq.at(curr))->setExecPos(exec_seq.size() - 1);
                     asgn[curr] = true;
-                    for (int k = 0; k < N; k++)
-                        visited[k] = false;
+                    walk++;
                 }
-                //find a child unassigned
-                for (int i = 0; i < N; i++)
-                    if(matrix[curr][i] == true && asgn[i] == false)
-                        child = i;
-
-                if(child != -1)
-                    assignSeq(child, asgn, visited, done);
-                else //if all child assign visit all parents again
-                {
-                    done[curr] = true;
-                    for (int i = 0; i < N; i++) {
-                        if(matrix[i][curr] == true && done[i] == false)
-                            assignSeq(i, asgn, visited, done);
-                    }
+
+                //Walk down to an outgoing link not assigned
+                while (childEnd[curr] > 0
+                        && asgn[child[curr][childEnd[curr] - 1]])
+                    childEnd[curr]--;
+                int next = -1;
+                if (childEnd[curr] > 0)
+                    next = child[curr][childEnd[curr] - 1];
+                if (next != -1) {
+                    curr = next;
+                    continue;
+                }
+
+                //All outgoing links assigned, continue from an incoming link
+                done[curr] = true;
+                doneStack.push_back(make_pair(curr, 0));
+                curr = -1;
+                while (curr == -1 && !doneStack.empty()) {
+                    int link = doneStack.back().first;
+                    int k = doneStack.back().second;
+                    while (k < parent[link].size() && done[parent[link][k]])
+                        k++;
+                    if (k < parent[link].size()) {
+                        curr = parent[link][k];
+                        doneStack.back().second = k + 1;
+                    } else
+                        doneStack.pop_back();
                 }
-            }
-            else
-            {
-                visited[curr] = true;
-                assignSeq(parv, asgn, visited, done);
             }
         }
-        else
-        {
-            if(asgn[curr] == false)
-            {
-                //assign itself
-                exec_seq.push_back(temp_seq.at(curr));
-                (temp_seq.at(curr))->setExecPos(exec_seq.size() - 1);
-                asgn[curr] = true;
-                for (int k = 0; k < N; k++)
-                    visited[k] = false;
-            }
 
-            //find a child unassigned
-            for (int i = 0; i < N; i++)
-                if(matrix[curr][i] == true && asgn[i] == false)
-                    child = i;
-
-            if(child != -1)
-                assignSeq(child, asgn, visited, done);
-            else //if all child assign visit all parents again
-            {
-                done[curr] = true;
-                for (int i = 0; i < N; i++) {
-                    if(matrix[i][curr] == true && done[i] == false)
-                        assignSeq(i, asgn, visited, done);
+        //Walk can leave Links behind a loop, walk again from Links left
+        //which have an incoming link assigned
+        start.clear();
+        for (int i = 0; i < N; i++) {
+            if (asgn[i])
+                continue;
+            for (int k = 0; k < parent[i].size(); k++) {
+                if (asgn[parent[i][k]]) {
+                    start.push_back(i);
+                    break;
                 }
             }
         }
     }
-    else
-    {
-        visited[curr] = true;
-        assignSeq(parAsgn, asgn, visited, done);
-    }
-}
 
-void Usecase::setSequence() {
-    //All links with no incoming link is assigned sequence number
-    int N = temp_seq.size();
-    bool asgn[N], visited[N], done[N];
-    bool head = true;
+    if (exec_seq.size() < N) {
+        //Links left are fed only by each other, walk up incoming links till
+        //a Link repeats to find the loop
+        vector<int> step(N, -1);
+        vector<int> path;
+        int curr = 0;
+        while (asgn[curr])
+            curr++;
+        while (step[curr] == -1) {
+            step[curr] = path.size();
+            path.push_back(curr);
+            curr = parent[curr][0];
+        }
 
-    for (int i = 0; i < N; i++) {
-        asgn[i] = false;
-        visited[i] = false;
-        done[i] = false;
-    }
+        string loop = (temp_seq.at(curr))->getName();
+        for (int k = path.size() - 1; k >= step[curr]; k--)
+            loop += " -> " + (temp_seq.at(path[k]))->getName();
 
-    for (int i = 0; i < N; i++) {
-        head = true;
-        //checks if any incoming link i.e any link with seq num not assigned
-        for (int j = 0; j < N; j++) {
-            if (matrix[j][i] == true) {
-                head = false;
-                break;
-            }
-        }
-        if (head == true) { //For each head
-            assignSeq(i, asgn, visited, done);
-        }
+        CHECK_ERROR_ABORT(false, "Error: Links [" + loop + "] are connected in a loop with no input from rest of usecase !!!");
     }
 }
 
@@ -357,25 +554,12 @@ void Usecase::printFileName(ostream* out) {
     (*out) << "UseCase Name: " << fileName << endl;
 }
 
-void Usecase::printMatrix(ostream* out) {
-    (*out) << "*******" << endl;
-    for (int i = 0; i < temp_seq.size(); i++)
-        (*out) << (temp_seq.at(i))->getName() << " "
-                << (temp_seq.at(i))->getMatrixPos() << endl;
-
-    for (int i = 0; i < temp_seq.size(); i++) {
-        for (int j = 0; j < temp_seq.size(); j++)
-            (*out) << matrix[i][j] << " ";
-        (*out) << endl;
-    }
-}
-
 void Usecase::connect(Link* obj1, Link* obj2) {
     if (obj2 != NULL) {
         int pos1 = obj1->getMatrixPos();
         int pos2 = obj2->getMatrixPos();
 
-        if (userMat[pos1][pos2] == false) // Not already connected
+        if (userAdj[pos1].count(pos2) == 0) // Not already connected
         {
             //cout<<obj1->getProcType()<<" "<<obj2->getProcType()<<endl;
             if ((obj1->getProcType() == obj2->getProcType()) ||
@@ -391,22 +575,14 @@ void Usecase::connect(Link* obj1, Link* obj2) {
                     *logFile << obj1->getName() << " is connected to "
                         << obj2->getName() << endl;
 
-                int i = 0, pos1 = -1, pos2 = -1;
-                while ((pos1 == -1 || pos2 == -1) && i < temp_seq.size()) {
-                    if (temp_seq.at(i) == obj1)
-                        pos1 = i;
-                    else if (temp_seq.at(i) == obj2)
-                        pos2 = i;
-                    i++;
-                }
-
                 int q1 = obj1->setOutLink(obj2);
                 int q2 = obj2->setInLink(obj1);
                 obj1->setOutQueueID(q1, q2);
                 obj2->setInQueueID(q2, q1);
 
-                matrix[pos1][pos2] = true;
-                userMat[pos1][pos2] = true;
+                outAdj[pos1].push_back(pos2);
+                inAdj[pos2].push_back(pos1);
+                userAdj[pos1].insert(pos2);
 
                 if ((obj1->getClassType() == cIPCOut)
                         && (obj2->getClassType() == cIPCIn)) {
@@ -430,7 +606,7 @@ void Usecase::connect(Link* obj1, Link* obj2) {
                         << endl;
 
 
-                userMat[pos1][pos2] = true; //Mark link as connected(user sees them as connected, even though intermediate IPC's are needed)
+                userAdj[pos1].insert(pos2); //Mark link as connected(user sees them as connected, even though intermediate IPC's are needed)
 
                 //Create to ipc links
                 if (getRoot(obj1->getName()) != "IPCOut"
@@ -560,31 +736,30 @@ void Usecase::genImgFile() {
     fp << BLOCK_SPACE
             << "/************** CONNECTIONS ************************/\n";
     for (int i = 0; i < temp_seq.size(); i++) {
-        for (int j = 0; j < temp_seq.size(); j++) {
-            if (matrix[i][j] == true) {
-                //[taillabel=Q0, headlabel=Q0, minlen=2, labeldistance=2]
-                if ((temp_seq.at(i))->getOutLinkSize() > 1
-                        && (temp_seq.at(j))->getInLinkSize() > 1)
-                    fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
-                            << (temp_seq.at(j))->getName() << "[headlabel=Q"
-                            << (temp_seq.at(j))->getInQueueID(temp_seq.at(i))
-                            << ", taillabel=Q"
-                            << (temp_seq.at(i))->getOutQueueID(temp_seq.at(j))
-                            << ", minlen=2, labeldistance=3]" << endl;
-                else if ((temp_seq.at(i))->getOutLinkSize() > 1)
-                    fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
-                            << (temp_seq.at(j))->getName() << "[taillabel=Q"
-                            << (temp_seq.at(i))->getOutQueueID(temp_seq.at(j))
-                            << ", minlen=2, labeldistance=3]" << endl;
-                else if ((temp_seq.at(j))->getInLinkSize() > 1)
-                    fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
-                            << (temp_seq.at(j))->getName() << "[headlabel=Q"
-                            << (temp_seq.at(j))->getInQueueID(temp_seq.at(i))
-                            << " minlen=2, labeldistance=3]" << endl;
-                else
-                    fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
-                            << (temp_seq.at(j))->getName() << endl;
-            }
+        for (int k = 0; k < outAdj[i].size(); k++) {
+            int j = outAdj[i][k];
+            //[taillabel=Q0, headlabel=Q0, minlen=2, labeldistance=2]
+            if ((temp_seq.at(i))->getOutLinkSize() > 1
+                    && (temp_seq.at(j))->getInLinkSize() > 1)
+                fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
+                        << (temp_seq.at(j))->getName() << "[headlabel=Q"
+                        << (temp_seq.at(j))->getInQueueID(temp_seq.at(i))
+                        << ", taillabel=Q"
+                        << (temp_seq.at(i))->getOutQueueID(temp_seq.at(j))
+                        << ", minlen=2, labeldistance=3]" << endl;
+            else if ((temp_seq.at(i))->getOutLinkSize() > 1)
+                fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
+                        << (temp_seq.at(j))->getName() << "[taillabel=Q"
+                        << (temp_seq.at(i))->getOutQueueID(temp_seq.at(j))
+                        << ", minlen=2, labeldistance=3]" << endl;
+            else if ((temp_seq.at(j))->getInLinkSize() > 1)
+                fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
+                        << (temp_seq.at(j))->getName() << "[headlabel=Q"
+                        << (temp_seq.at(j))->getInQueueID(temp_seq.at(i))
+                        << " minlen=2, labeldistance=3]" << endl;
+            else
+                fp << BLOCK_SPACE << (temp_seq.at(i))->getName() << " -> "
+                        << (temp_seq.at(j))->getName() << endl;
         }
     }
 
@@ -708,8 +883,18 @@ void Usecase::genSetLinkPrms(ostream& fp, ostream& fph)
             << ");\n" << endl; //header line
     fp << "Void " << fileName << "_SetPrms(" << structName << " *" << obj
             << "){" << endl;
-    for (int i = 0; i < exec_seq.size(); i++)
+    for (int i = 0; i < exec_seq.size(); i++) {
+        if (cmd_options.bufSizing()) {
+            LinkBufs &b = bufs[(exec_seq.at(i))->getMatrixPos()];
+            ostringstream mbytes;
+            mbytes << fixed << setprecision(1) << b.mbytes;
+            if (b.num != 0)
+                fp << BLOCK_SPACE << "/* " << (exec_seq.at(i))->getName()
+                        << ": " << b.num << " output buffers recommended ("
+                        << mbytes.str() << " MB) */" << endl;
+        }
         (exec_seq.at(i))->genSetLinkPrms(fp, obj);
+    }
     fp << "}\n" << endl;
 }
 
@@ -887,6 +1072,438 @@ void Usecase::createAllConn() {
     }
 }
 
+void Usecase::printPlacement(ostream* out)
+{
+    double cpuLoad[NUMPROC] = { 0 };
+    int cpuCount[NUMPROC] = { 0 };
+
+    (*out) << "\n********" << endl;
+    (*out) << "CPU Placement: " << endl;
+    for (int i = 0; i < placed.size(); i++)
+        (*out) << setw(30) << left << (placed.at(i))->getName() << "  "
+                << setw(6) << left << (placed.at(i))->getProcClass() << " -> "
+                << procName[(placed.at(i))->getProcType()] << endl;
+
+    (*out) << "\nIPC Links: " << endl;
+    for (int i = 0; i < exec_seq.size(); i++) {
+        int pos = (exec_seq.at(i))->getMatrixPos();
+        if ((exec_seq.at(i))->getClassType() != cIPCOut
+                || inAdj[pos].size() == 0 || outAdj[pos].size() == 0)
+            continue;
+        int ipcIn = outAdj[pos][0];
+        Link* src = temp_seq.at(inAdj[pos][0]);
+        (*out) << src->getName() << " (" << procName[src->getProcType()]
+                << ") -> " << (exec_seq.at(i))->getName() << " -> "
+                << (temp_seq.at(ipcIn))->getName();
+        if (outAdj[ipcIn].size() != 0) {
+            Link* dst = temp_seq.at(outAdj[ipcIn][0]);
+            (*out) << " -> " << dst->getName() << " ("
+                    << procName[dst->getProcType()] << ")";
+        }
+        (*out) << endl;
+    }
+
+    for (int i = 0; i < temp_seq.size(); i++) {
+        ProcType pType = (temp_seq.at(i))->getProcType();
+        cpuLoad[pType] += costTable.getCost((temp_seq.at(i))->getName(), pType, "load");
+        cpuCount[pType]++;
+    }
+    (*out) << "\nCPU Load (%): " << endl;
+    for (int p = 0; p < NUMPROC; p++) {
+        if (cpuCount[p] == 0)
+            continue;
+        (*out) << setw(10) << left << procName[p] << "  " << setw(8) << left
+                << cpuLoad[p] << "(" << cpuCount[p] << " Links)";
+        if (cpuLoad[p] > 100)
+            (*out) << "  Warning: CPU overloaded !!!";
+        (*out) << endl;
+    }
+    if (!costTable.isLoaded())
+        (*out) << "Warning: No cost table given (-cost), load of Links taken as 0 !!!" << endl;
+}
+
+/* Frame size and rate are passed from source Links down the usecase, Merge
+ * adds frame rates of its inputs, other Links take the highest. A Link in a
+ * loop is done once any of its inputs is done, ignoring inputs fed back.
+ * CPU time of a Link is (cycles + cpp * input pixels) / mhz, or taken from
+ * load if neither is in cost table. Latency of a Link is the latency of its
+ * slowest input plus its CPU time and lat.
+ */
+void Usecase::estimatePerf() {
+    int N = temp_seq.size();
+    vector<int> pending(N);
+    vector<bool> done(N, false);
+    vector<int> ready, order;
+    int numDone = 0;
+
+    perf.assign(N, LinkPerf());
+    for (int i = 0; i < N; i++)
+        pending[i] = inAdj[i].size();
+    for (int i = exec_seq.size() - 1; i >= 0; i--) {
+        int pos = (exec_seq.at(i))->getMatrixPos();
+        if (pending[pos] == 0)
+            ready.push_back(pos);
+    }
+
+    while (numDone < N) {
+        if (ready.size() == 0) {
+            //Only loops left, start with first Link fed by a done Link
+            int first = -1;
+            for (int i = 0; i < exec_seq.size() && first == -1; i++) {
+                int pos = (exec_seq.at(i))->getMatrixPos();
+                if (done[pos])
+                    continue;
+                for (int j = 0; j < inAdj[pos].size(); j++)
+                    if (done[inAdj[pos][j]])
+                        first = pos;
+            }
+            for (int i = 0; i < exec_seq.size() && first == -1; i++)
+                if (!done[(exec_seq.at(i))->getMatrixPos()])
+                    first = (exec_seq.at(i))->getMatrixPos();
+            ready.push_back(first);
+        }
+
+        int pos = ready.back();
+        ready.pop_back();
+        if (done[pos])
+            continue;
+
+        Link* obj = temp_seq.at(pos);
+        string name = obj->getName();
+        ProcType pType = obj->getProcType();
+        LinkPerf &p = perf[pos];
+        double inPixels = 0, cycles = 0, cpp = 0, load = 0, rd = 0, wr = 0;
+        double mhz = procMHz[pType], value;
+        bool input = false;
+
+        p.width = PERF_DEFAULT_WIDTH;
+        p.height = PERF_DEFAULT_HEIGHT;
+        p.fps = 0;
+        p.latency = 0;
+        p.prev = -1;
+        for (int j = 0; j < inAdj[pos].size(); j++) {
+            LinkPerf &in = perf[inAdj[pos][j]];
+            if (!done[inAdj[pos][j]])
+                continue;
+            if (!input || (double) in.width * in.height > inPixels) {
+                p.width = in.width;
+                p.height = in.height;
+                inPixels = (double) in.width * in.height;
+            }
+            if (obj->getClassType() == cMerge)
+                p.fps += in.fps;
+            else if (in.fps > p.fps)
+                p.fps = in.fps;
+            if (!input || in.latency > p.latency) {
+                p.latency = in.latency;
+                p.prev = inAdj[pos][j];
+            }
+            input = true;
+        }
+        if (!input) {
+            p.fps = PERF_DEFAULT_FPS;
+            inPixels = (double) p.width * p.height;
+        }
+
+        if (costTable.getCost(name, pType, "width", value))
+            p.width = (int) value;
+        if (costTable.getCost(name, pType, "height", value))
+            p.height = (int) value;
+        if (costTable.getCost(name, pType, "fps", value))
+            p.fps = value;
+        costTable.getCost("CPU", pType, "mhz", mhz);
+
+        bool hasCycles = costTable.getCost(name, pType, "cycles", cycles);
+        hasCycles = costTable.getCost(name, pType, "cpp", cpp) || hasCycles;
+        if (hasCycles)
+            p.usec = (cycles + cpp * inPixels) / mhz;
+        else if (costTable.getCost(name, pType, "load", load) && p.fps > 0)
+            p.usec = load * 10000 / p.fps;
+        else
+            p.usec = 0;
+        p.load = p.usec * p.fps / 10000;
+
+        costTable.getCost(name, pType, "rd", rd);
+        costTable.getCost(name, pType, "wr", wr);
+        p.mbps = (rd * inPixels + wr * p.width * p.height) * p.fps / 1000000;
+        p.latency += p.usec + costTable.getCost(name, pType, "lat");
+
+        done[pos] = true;
+        numDone++;
+        order.push_back(pos);
+        for (int j = outAdj[pos].size() - 1; j >= 0; j--)
+            if (--pending[outAdj[pos][j]] == 0)
+                ready.push_back(outAdj[pos][j]);
+    }
+
+    scalePerf(order);
+}
+
+/* An overloaded CPU drops frames, so its Links run at 100/load of their input
+ * rate and so do Links after them. Frames are dropped once per CPU on a path,
+ * however many Links of the path run on it. Load of a CPU is taken at the rate
+ * its Links really get, slowed down by other CPUs before them but not by
+ * itself, so a CPU after an overloaded one may no longer be overloaded. Done
+ * in the order estimatePerf() went through the Links, repeated till CPU
+ * scales settle.
+ */
+void Usecase::scalePerf(const vector<int> &order) {
+    int N = order.size();
+    vector<int> rank(N), applied(N, 0); //applied: mask of CPUs on paths to Link
+    //Scale of each Link if a CPU did not drop frames, last one with all CPUs
+    vector<vector<double> > scaleWithout(N, vector<double>(NUMPROC + 1, 1));
+    bool changed = true;
+
+    for (int i = 0; i < N; i++)
+        rank[order[i]] = i;
+    for (int c = 0; c < NUMPROC; c++)
+        cpuScale[c] = 1;
+
+    for (int iter = 0; changed && iter <= 2 * NUMPROC; iter++) {
+        double cpuLoad[NUMPROC] = { 0 };
+
+        for (int i = 0; i < N; i++) {
+            int pos = order[i];
+            ProcType pType = (temp_seq.at(pos))->getProcType();
+            bool input = false;
+
+            applied[pos] = 1 << pType;
+            for (int c = 0; c <= NUMPROC; c++) {
+                double fps = 0, scaledFps = 0, drop;
+
+                //Inputs fed back in a loop are left out, as in estimatePerf()
+                for (int j = 0; j < inAdj[pos].size(); j++) {
+                    int in = inAdj[pos][j];
+                    if (rank[in] > i)
+                        continue;
+                    drop = (c != pType && (applied[in] & (1 << pType)) == 0) ? cpuScale[pType] : 1;
+                    if ((temp_seq.at(pos))->getClassType() == cMerge) {
+                        fps += perf[in].fps;
+                        scaledFps += perf[in].fps * scaleWithout[in][c] * drop;
+                    } else {
+                        fps = max(fps, perf[in].fps);
+                        scaledFps = max(scaledFps, perf[in].fps * scaleWithout[in][c] * drop);
+                    }
+                    applied[pos] |= applied[in];
+                    input = true;
+                }
+                if (!input)
+                    scaleWithout[pos][c] = (c != pType) ? cpuScale[pType] : 1;
+                else
+                    scaleWithout[pos][c] = (fps > 0) ? scaledFps / fps : 1;
+            }
+            cpuLoad[pType] += perf[pos].load * scaleWithout[pos][pType];
+            perf[pos].scale = scaleWithout[pos][NUMPROC];
+        }
+
+        changed = false;
+        for (int c = 0; c < NUMPROC; c++) {
+            double scale = (cpuLoad[c] > 100) ? 100 / cpuLoad[c] : 1;
+            if (fabs(scale - cpuScale[c]) > 1e-9)
+                changed = true;
+            cpuScale[c] = scale;
+        }
+    }
+}
+
+void Usecase::printPerf(ostream* out)
+{
+    double cpuLoad[NUMPROC] = { 0 };
+    int bottleneck = -1, last = -1;
+    double maxLoad = 0, mbps = 0;
+    ios_base::fmtflags flags = out->flags();
+    streamsize precision = out->precision();
+
+    (*out) << "\n********" << endl;
+    (*out) << "Performance Estimate: " << endl;
+    (*out) << setw(30) << left << "Link" << "  " << setw(8) << left << "CPU"
+            << setw(11) << left << "Frame" << setw(8) << left << "fps"
+            << setw(12) << left << "usecs/frame" << setw(8) << left << "Load %"
+            << setw(10) << left << "DDR MB/s" << "Latency ms" << endl;
+    (*out) << fixed << setprecision(1);
+    for (int i = 0; i < exec_seq.size(); i++) {
+        Link* obj = exec_seq.at(i);
+        LinkPerf &p = perf[obj->getMatrixPos()];
+        (*out) << setw(30) << left << obj->getName() << "  " << setw(8)
+                << left << procName[obj->getProcType()] << setw(11) << left
+                << (toString(p.width) + "x" + toString(p.height)) << setw(8)
+                << left << p.fps << setw(12) << left << p.usec << setw(8)
+                << left << p.load << setw(10) << left << p.mbps
+                << p.latency / 1000 << endl;
+        cpuLoad[obj->getProcType()] += p.load;
+        mbps += p.mbps * p.scale;
+    }
+
+    (*out) << "\nCPU Load (%): " << endl;
+    for (int c = 0; c < NUMPROC; c++) {
+        if (cpuLoad[c] == 0)
+            continue;
+        (*out) << setw(10) << left << procName[c] << "  " << cpuLoad[c] << endl;
+        if (cpuLoad[c] > maxLoad) {
+            maxLoad = cpuLoad[c];
+            bottleneck = -1;
+            for (int i = 0; i < temp_seq.size(); i++)
+                if ((temp_seq.at(i))->getProcType() == c
+                        && (bottleneck == -1 || perf[i].load > perf[bottleneck].load))
+                    bottleneck = i;
+        }
+    }
+
+    if (bottleneck != -1)
+        (*out) << "\nBottleneck: " << procName[(temp_seq.at(bottleneck))->getProcType()]
+                << " at " << maxLoad << "%, Link " << (temp_seq.at(bottleneck))->getName()
+                << " at " << perf[bottleneck].load << "%" << endl;
+
+    //Frames are dropped by overloaded CPUs, outputs after them slow down
+    (*out) << "\nSteady-state fps: " << endl;
+    for (int i = 0; i < exec_seq.size(); i++) {
+        int pos = (exec_seq.at(i))->getMatrixPos();
+        if (outAdj[pos].size() != 0)
+            continue;
+        (*out) << setw(30) << left << (exec_seq.at(i))->getName() << "  "
+                << perf[pos].fps * perf[pos].scale << endl;
+        if (last == -1 || perf[pos].latency > perf[last].latency)
+            last = pos;
+    }
+
+    if (last != -1) {
+        string path = temp_seq.at(last)->getName();
+        for (int pos = perf[last].prev; pos != -1; pos = perf[pos].prev)
+            path = temp_seq.at(pos)->getName() + " -> " + path;
+        (*out) << "\nCritical path latency: " << perf[last].latency / 1000
+                << " ms" << endl;
+        (*out) << path << endl;
+    }
+
+    (*out) << "\nDDR (EMIF) bandwidth: " << mbps << " MB/s" << endl;
+    for (int c = 0; c < NUMPROC; c++)
+        if (cpuScale[c] < 1)
+            (*out) << "Warning: " << procName[c]
+                    << " overloaded, its Links keep up with " << cpuScale[c] * 100
+                    << "% of input fps, Links after them slow down too !!!" << endl;
+    if (!costTable.isLoaded())
+        (*out) << "Warning: No cost table given (-cost), CPU time and bandwidth of Links taken as 0 !!!" << endl;
+
+    out->flags(flags);
+    out->precision(precision);
+}
+
+//Links which pass on buffers of their input and have no output buffers
+static bool passesBufs(ClassType cType) {
+    return cType == cDup || cType == cSplit || cType == cGate
+            || cType == cIPCOut || cType == cIPCIn || cType == cMerge
+            || cType == cSelect || cType == cSync;
+}
+
+//Walk from a Link down to the Links using its output buffers
+struct BufWalk {
+    int pos;
+    int from;
+    int ipc;
+    int sync;
+    double skew; //Time waited by Sync for other inputs of Merge
+};
+
+/* Output buffers of a Link are in use while being filled (1), while held by
+ * the Links using them (latency from cost table times fps, at least 1), by
+ * other outputs of each Dup (outputs - 1), in each IPC hop (1) and in Sync
+ * while it waits for slower inputs of the Merge before it (1 + skew times
+ * fps). Dup, Merge, IPC etc. pass on buffers and need none of their own.
+ */
+void Usecase::recommendBufs() {
+    int N = temp_seq.size();
+
+    bufs.assign(N, LinkBufs());
+    for (int i = 0; i < N; i++) {
+        Link* obj = temp_seq.at(i);
+        LinkBufs &b = bufs[i];
+        vector<BufWalk> stack;
+        set<int> visited;
+        double hold = 0, fps = perf[i].fps;
+        double bpp = BUFS_DEFAULT_BPP;
+        BufWalk start = { i, -1, 0, 0, 0 };
+
+        if (outAdj[i].size() == 0 || passesBufs(obj->getClassType()))
+            continue;
+
+        stack.push_back(start);
+        while (stack.size() != 0) {
+            BufWalk w = stack.back();
+            stack.pop_back();
+            ClassType cType = (temp_seq.at(w.pos))->getClassType();
+
+            if (w.pos != i && !passesBufs(cType)) {
+                hold = max(hold, perf[w.pos].latency - perf[i].latency);
+                b.ipc = max(b.ipc, w.ipc);
+                b.sync = max(b.sync, w.sync);
+                continue;
+            }
+            if (w.pos != i) {
+                if (!visited.insert(w.pos).second)
+                    continue;
+                if (cType == cIPCOut)
+                    w.ipc++;
+                else if (cType == cDup)
+                    b.dup += outAdj[w.pos].size() - 1;
+                else if (cType == cMerge) {
+                    w.skew = 0;
+                    for (int j = 0; j < inAdj[w.pos].size(); j++)
+                        w.skew = max(w.skew, perf[inAdj[w.pos][j]].latency
+                                - perf[w.from].latency);
+                } else if (cType == cSync) {
+                    w.sync += 1 + (int) ceil(w.skew * fps / 1000000);
+                    w.skew = 0;
+                }
+            }
+            for (int j = 0; j < outAdj[w.pos].size(); j++) {
+                BufWalk next = { outAdj[w.pos][j], w.pos, w.ipc, w.sync, w.skew };
+                stack.push_back(next);
+            }
+        }
+
+        b.latency = max(1, (int) ceil(hold * fps / 1000000));
+        b.num = 1 + b.latency + b.dup + b.ipc + b.sync;
+        costTable.getCost(obj->getName(), obj->getProcType(), "bpp", bpp);
+        b.mbytes = b.num * perf[i].width * perf[i].height * bpp / (1024 * 1024);
+    }
+}
+
+void Usecase::printBufs(ostream* out)
+{
+    double mbytes = 0;
+    ios_base::fmtflags flags = out->flags();
+    streamsize precision = out->precision();
+
+    (*out) << "\n********" << endl;
+    (*out) << "Output Buffers Recommended: " << endl;
+    (*out) << setw(30) << left << "Link" << "  " << setw(11) << left << "Frame"
+            << setw(9) << left << "Buffers" << setw(9) << left << "Latency"
+            << setw(5) << left << "Dup" << setw(5) << left << "IPC"
+            << setw(6) << left << "Sync" << "MB" << endl;
+    (*out) << fixed << setprecision(1);
+    for (int i = 0; i < exec_seq.size(); i++) {
+        int pos = (exec_seq.at(i))->getMatrixPos();
+        LinkBufs &b = bufs[pos];
+        if (b.num == 0)
+            continue;
+        (*out) << setw(30) << left << (exec_seq.at(i))->getName() << "  "
+                << setw(11) << left
+                << (toString(perf[pos].width) + "x" + toString(perf[pos].height))
+                << setw(9) << left << b.num << setw(9) << left << b.latency
+                << setw(5) << left << b.dup << setw(5) << left << b.ipc
+                << setw(6) << left << b.sync << b.mbytes << endl;
+        mbytes += b.mbytes;
+    }
+    (*out) << "\nTotal frame buffer memory: " << mbytes << " MB" << endl;
+    if (!costTable.isLoaded())
+        (*out) << "Warning: No cost table given (-cost), frame size taken as "
+                << PERF_DEFAULT_WIDTH << "x" << PERF_DEFAULT_HEIGHT
+                << " and latency as 0 !!!" << endl;
+
+    out->flags(flags);
+    out->precision(precision);
+}
+
 void Usecase::printExecSeq(ostream* out)
 {
     (*out) << "\n********" << endl;
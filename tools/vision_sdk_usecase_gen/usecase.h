@@ -5,13 +5,41 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 
 #include "link.h"
 #include "options.h"
 #include "error.h"
 #include "support.h"
+#include "cost.h"
+
+#define PLACE_MAX_SEARCH 65536 //Max placements tried one by one by placeCPU()
+#define PERF_DEFAULT_WIDTH 1920 //Frame size and rate of source Links, if not in cost table
+#define PERF_DEFAULT_HEIGHT 1080
+#define PERF_DEFAULT_FPS 30
+#define BUFS_DEFAULT_BPP 1.5 //Bytes per pixel of output buffers (YUV420SP), if not in cost table
+
+//Performance estimate of a Link, see Usecase::estimatePerf()
+struct LinkPerf {
+	int width, height; //Output frame
+	double fps;        //Output frame rate, assuming no CPU is overloaded
+	double usec;       //CPU time per frame
+	double load;       //Load on CPU in %
+	double mbps;       //DDR bandwidth in MB/s
+	double latency;    //Time in usecs from source to output of Link
+	int prev;          //Input on longest path from source, -1 if none
+	double scale;      //Share of fps reached with overloaded CPUs, see scalePerf()
+};
 
-#define OBJ_MAX 128 //Changeable TODO: put this in documentation
+//Output buffers recommended for a Link, see Usecase::recommendBufs()
+struct LinkBufs {
+	int num;           //0 if Link has no output buffers of its own
+	int latency;       //Frames held by Links down the usecase, as per latency
+	int dup;           //Frames held by other outputs of Dup
+	int ipc;           //Frames queued in IPC
+	int sync;          //Frames waiting in Sync for other inputs
+	double mbytes;     //Memory of all buffers in MB
+};
 
 extern Processor proc;
 extern Options cmd_options;
@@ -25,26 +53,36 @@ class Usecase {
 	map<string, Link*> inst_object; //Map of link name and Link object
 	vector<Link*> exec_seq;
 	vector<Link*> temp_seq;
-	bool matrix[OBJ_MAX][OBJ_MAX]; //Matrix of connections
-	bool userMat[OBJ_MAX][OBJ_MAX]; //Matrix of connections according to user, i.e as mentioned in testcase
+	vector<vector<int> > outAdj; //Connections from each Link, indexed by matrixPos
+	vector<vector<int> > inAdj; //Connections to each Link, indexed by matrixPos
+	vector<set<int> > userAdj; //Connections according to user, i.e as mentioned in testcase
 	int numIpc;	//Number of ipc Links generated, used to name ipc Link uniquely
 	vector<vector<Link*> > connections;
+	vector<Link*> placed; //Links placed on a CPU by placeCPU()
+	vector<LinkPerf> perf; //Indexed by matrixPos, filled by estimatePerf()
+	double cpuScale[NUMPROC]; //Share of input fps each CPU keeps up with, filled by scalePerf()
+	vector<LinkBufs> bufs; //Indexed by matrixPos, filled by recommendBufs()
 
 	void createNewObj(string name, Link* &obj);
 
 	//initialize Links
+	void placeCPU();
 	void assignCPU();
 	void assignLinkID();
-	void assignSeq(int curr, bool* asgn, bool* visited, bool* done);
 	void setSequence();
 	void connect(Link* obj1, Link* obj2); //insert the object in map
 	void createAllConn();
+	void estimatePerf();
+	void scalePerf(const vector<int> &order);
+	void recommendBufs();
 
 	//print Link summary
 	void printFileName(ostream* out);
-	void printMatrix(ostream* out);
 	void printExecSeq(ostream* out);
 	void printTable(ostream* out);
+	void printPlacement(ostream* out);
+	void printPerf(ostream* out);
+	void printBufs(ostream* out);
 
 	//Generate files
 	void genFile();